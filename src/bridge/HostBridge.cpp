@@ -27,6 +27,7 @@
 #include "bridge/ActivityLog.h"
 #include "HostBridge.h"
 #include "BridgeMain.h"
+#include "PCMConvert.h"
 #include "SampleTimeConversion.h"
 
 using namespace network;
@@ -59,7 +60,6 @@ const int NUMBER_OF_BUFFERS = 32;
 //  Static Class Members
 // ---------------------------------------------------------------------------
 
-std::mutex HostBridge::m_audioMutex;
 std::mutex HostBridge::m_networkMutex;
 
 // ---------------------------------------------------------------------------
@@ -74,35 +74,26 @@ void audioCallback(ma_device* device, void* output, const void* input, ma_uint32
     if (!bridge->m_running)
         return;
 
-    ma_uint32 pcmBytes = frameCount * ma_get_bytes_per_frame(device->capture.format, device->capture.channels);
+    // capture input audio, resampled to 8kHz if the device runs at a different rate
+    const uint8_t* pcm = (const uint8_t*)input;
+    for (uint32_t offset = 0U; offset < frameCount; offset += MAX_AUDIO_FRAME_SAMPLES) {
+        uint32_t count = std::min<uint32_t>(frameCount - offset, MAX_AUDIO_FRAME_SAMPLES);
 
-    // capture input audio
-    if (frameCount > 0U) {
-        std::lock_guard<std::mutex> lock(HostBridge::m_audioMutex);
+        short samples[MAX_AUDIO_FRAME_SAMPLES];
+        PCMConvert::toSamples(pcm + (offset * 2U), samples, count);
 
-        int smpIdx = 0;
-        short samples[MBE_SAMPLES_LENGTH];
-        const uint8_t* pcm = (const uint8_t*)input;
-        for (uint32_t pcmIdx = 0; pcmIdx < pcmBytes; pcmIdx += 2) {
-            samples[smpIdx] = (short)((pcm[pcmIdx + 1] << 8) + pcm[pcmIdx + 0]);
-            smpIdx++;
+        if (bridge->m_captureResampler != nullptr) {
+            short resampled[MAX_AUDIO_FRAME_SAMPLES + 1U];
+            uint32_t written = bridge->m_captureResampler->process(samples, count, resampled);
+            bridge->writeInputAudio(resampled, written);
+        }
+        else {
+            bridge->writeInputAudio(samples, count);
         }
-
-        bridge->m_inputAudio.addData(samples, MBE_SAMPLES_LENGTH);
     }
 
     // playback output audio
-    if (bridge->m_outputAudio.dataSize() >= MBE_SAMPLES_LENGTH) {
-        short samples[MBE_SAMPLES_LENGTH];
-        bridge->m_outputAudio.get(samples, MBE_SAMPLES_LENGTH);
-        uint8_t* pcm = (uint8_t*)output;
-        int pcmIdx = 0;
-        for (uint32_t smpIdx = 0; smpIdx < MBE_SAMPLES_LENGTH; smpIdx++) {
-            pcm[pcmIdx + 0] = (uint8_t)(samples[smpIdx] & 0xFF);
-            pcm[pcmIdx + 1] = (uint8_t)((samples[smpIdx] >> 8) & 0xFF);
-            pcmIdx += 2;
-        }
-    }
+    bridge->readOutputAudio((uint8_t*)output, frameCount);
 }
 
 /* Helper callback, called when MDC packets are detected. */
@@ -148,6 +139,7 @@ HostBridge::HostBridge(const std::string& confFile) :
     m_udpAudioSocket(nullptr),
     m_udpAudio(false),
     m_udpMetadata(false),
+    m_udpSampleRate(SAMPLE_RATE),
     m_udpSendPort(34001),
     m_udpSendAddress("127.0.0.1"),
     m_udpReceivePort(32001),
@@ -174,15 +166,33 @@ HostBridge::HostBridge(const std::string& confFile) :
     m_preambleLength(200U),
     m_grantDemand(false),
     m_localAudio(false),
+    m_localAudioSampleRate(SAMPLE_RATE),
     m_maContext(),
     m_maPlaybackDevices(nullptr),
     m_maCaptureDevices(nullptr),
     m_maDeviceConfig(),
     m_maDevice(),
-    m_inputAudio(MBE_SAMPLES_LENGTH * NUMBER_OF_BUFFERS, "Input Audio Buffer"),
-    m_outputAudio(MBE_SAMPLES_LENGTH * NUMBER_OF_BUFFERS, "Output Audio Buffer"),
+    m_captureResampler(nullptr),
+    m_playbackResampler(nullptr),
+    m_udpRxResampler(nullptr),
+    m_udpTxResampler(nullptr),
+    m_inputAudio(NUMBER_OF_BUFFERS, "Input Audio Buffer"),
+    m_outputAudio(NUMBER_OF_BUFFERS, "Output Audio Buffer"),
+    m_captureSamples(),
+    m_captureLength(0U),
+    m_playbackSamples(),
+    m_playbackLength(0U),
+    m_playbackOffset(0U),
+    m_udpInputAudio(NUMBER_OF_BUFFERS, "UDP Input Audio Buffer"),
+    m_udpSendAddr(),
+    m_udpSendAddrLen(0U),
+    m_udpOutputAudio(),
+    m_udpOutputDatagrams(),
+    m_udpOutputQueue(),
     m_decoder(nullptr),
     m_encoder(nullptr),
+    m_vocoder(nullptr),
+    m_vocoderStream(-1),
     m_mdcDecoder(nullptr),
     m_dmrEmbeddedData(),
     m_rxDMRLC(),
@@ -239,12 +249,26 @@ HostBridge::HostBridge(const std::string& confFile) :
 
     ::memset(m_netLDU1, 0x00U, 9U * 25U);
     ::memset(m_netLDU2, 0x00U, 9U * 25U);
+
+    // UDP audio datagrams are built in place, and sent in batches
+    for (uint32_t i = 0U; i < UDP_AUDIO_BATCH_COUNT; i++)
+        m_udpOutputDatagrams[i].buffer = m_udpOutputAudio[i].data;
+    m_udpOutputQueue.reserve(UDP_AUDIO_BATCH_COUNT);
 }
 
 /* Finalizes a instance of the HostBridge class. */
 
 HostBridge::~HostBridge()
 {
+    if (m_captureResampler != nullptr)
+        delete m_captureResampler;
+    if (m_playbackResampler != nullptr)
+        delete m_playbackResampler;
+    if (m_udpRxResampler != nullptr)
+        delete m_udpRxResampler;
+    if (m_udpTxResampler != nullptr)
+        delete m_udpTxResampler;
+
     delete[] m_ambeBuffer;
     delete[] m_netLDU1;
     delete[] m_netLDU2;
@@ -373,7 +397,7 @@ int HostBridge::run()
 
         // configure audio devices
         m_maDeviceConfig = ma_device_config_init(ma_device_type_duplex);
-        m_maDeviceConfig.sampleRate = SAMPLE_RATE;
+        m_maDeviceConfig.sampleRate = m_localAudioSampleRate;
 
         m_maDeviceConfig.capture.pDeviceID = &m_maCaptureDevices[g_inputDevice].id;
         m_maDeviceConfig.capture.format = ma_format_s16;
@@ -385,7 +409,7 @@ int HostBridge::run()
         m_maDeviceConfig.playback.channels = 1;
         m_maDeviceConfig.playback.shareMode = ma_share_mode_shared;
 
-        m_maDeviceConfig.periodSizeInFrames = MBE_SAMPLES_LENGTH;
+        m_maDeviceConfig.periodSizeInFrames = SampleTimeConvert::ToSamples(m_localAudioSampleRate, 1, 20);
         m_maDeviceConfig.dataCallback = audioCallback;
         m_maDeviceConfig.pUserData = this;
 
@@ -395,8 +419,15 @@ int HostBridge::run()
             return EXIT_FAILURE;
         }
 
-        // configure tone generator for preamble
-        m_maSineWaveConfig = ma_waveform_config_init(m_maDevice.playback.format, m_maDevice.playback.channels, m_maDevice.sampleRate, ma_waveform_type_sine, 0.2, m_preambleTone);
+        // the local audio is resampled to and from 8kHz, if the device runs at a different rate
+        if (m_localAudioSampleRate != SAMPLE_RATE) {
+            m_captureResampler = new Resampler(m_localAudioSampleRate, SAMPLE_RATE);
+            m_playbackResampler = new Resampler(SAMPLE_RATE, m_localAudioSampleRate);
+            LogInfo("    Local Audio Resampling: %uHz, %.1fms delay", m_localAudioSampleRate, m_captureResampler->getDelay());
+        }
+
+        // configure tone generator for preamble (the tone is generated into 8kHz output frames)
+        m_maSineWaveConfig = ma_waveform_config_init(m_maDevice.playback.format, m_maDevice.playback.channels, SAMPLE_RATE, ma_waveform_type_sine, 0.2, m_preambleTone);
         result = ma_waveform_init(&m_maSineWaveConfig, &m_maSineWaveform);
         if (result != MA_SUCCESS) {
             ma_context_uninit(&m_maContext);
@@ -423,6 +454,14 @@ int HostBridge::run()
     m_decoder->setAutoGain(m_vocoderDecoderAutoGain);
     m_encoder->setGainAdjust(m_vocoderEncoderAudioGain);
 
+    // network audio is decoded off the network thread, by the vocoder pool
+    m_vocoder = new vocoder::VocoderPool(1U, 1U, NUMBER_OF_BUFFERS);
+    m_vocoderStream = m_vocoder->open((m_txMode == TX_MODE_DMR) ? vocoder::DECODE_DMR_AMBE : vocoder::DECODE_88BIT_IMBE,
+        (m_txMode == TX_MODE_DMR) ? vocoder::ENCODE_DMR_AMBE : vocoder::ENCODE_88BIT_IMBE,
+        m_vocoderDecoderAudioGain, m_vocoderDecoderAutoGain, m_vocoderEncoderAudioGain);
+    if (!m_vocoder->start())
+        return EXIT_FAILURE;
+
 #if defined(_WIN32)
     initializeAMBEDLL();
     if (m_useExternalVocoder) {
@@ -460,10 +499,13 @@ int HostBridge::run()
     if (!Thread::runAsThread(this, threadCallWatchdog))
         return EXIT_FAILURE;
 
-    if (m_localAudio) {
+    // the audio processing thread is the sole encoder of transmitted audio, local or UDP
+    if (m_localAudio || m_udpAudio) {
         if (!Thread::runAsThread(this, threadAudioProcess))
             return EXIT_FAILURE;
+    }
 
+    if (m_localAudio) {
         // start audio device
         result = ma_device_start(&m_maDevice);
         if (result != MA_SUCCESS) {
@@ -535,6 +577,11 @@ int HostBridge::run()
         delete m_udpAudioSocket;
     }
 
+    if (m_vocoder != nullptr) {
+        m_vocoder->stop();
+        delete m_vocoder;
+    }
+
     if (m_decoder != nullptr)
         delete m_decoder;
     if (m_encoder != nullptr)
@@ -822,6 +869,9 @@ bool HostBridge::readParams()
     m_grantDemand = systemConf["grantDemand"].as<bool>(false);
 
     m_localAudio = systemConf["localAudio"].as<bool>(true);
+    m_localAudioSampleRate = systemConf["localAudioSampleRate"].as<uint32_t>(SAMPLE_RATE);
+    if (!checkSampleRate("local audio", m_localAudioSampleRate))
+        return false;
 
     yaml::Node networkConf = m_conf["network"];
     m_udpAudio = networkConf["udpAudio"].as<bool>(false);
@@ -842,6 +892,7 @@ bool HostBridge::readParams()
     LogInfo("    Dump Sample Levels: %s", m_dumpSampleLevel ? "yes" : "no");
     LogInfo("    Grant Demands: %s", m_grantDemand ? "yes" : "no");
     LogInfo("    Local Audio: %s", m_localAudio ? "yes" : "no");
+    LogInfo("    Local Audio Sample Rate: %uHz", m_localAudioSampleRate);
     LogInfo("    UDP Audio: %s", m_udpAudio ? "yes" : "no");
 
     return true;
@@ -863,6 +914,9 @@ bool HostBridge::createNetwork()
 
     m_udpAudio = networkConf["udpAudio"].as<bool>(false);
     m_udpMetadata = networkConf["udpMetadata"].as<bool>(false);
+    m_udpSampleRate = networkConf["udpSampleRate"].as<uint32_t>(SAMPLE_RATE);
+    if (!checkSampleRate("UDP audio", m_udpSampleRate))
+        return false;
     m_udpSendPort = (uint16_t)networkConf["udpSendPort"].as<uint32_t>(34001);
     m_udpSendAddress = networkConf["udpSendAddress"].as<std::string>();
     m_udpReceivePort = (uint16_t)networkConf["udpReceivePort"].as<uint32_t>(34001);
@@ -925,6 +979,7 @@ bool HostBridge::createNetwork()
     LogInfo("    PCM over UDP Audio: %s", m_udpAudio ? "yes" : "no");
     if (m_udpAudio) {
         LogInfo("    UDP Audio Metadata: %s", m_udpMetadata ? "yes" : "no");
+        LogInfo("    UDP Audio Sample Rate: %uHz", m_udpSampleRate);
         LogInfo("    UDP Audio end Address: %s", m_udpSendAddress.c_str());
         LogInfo("    UDP Audio Send Port: %u", m_udpSendPort);
         LogInfo("    UDP Audio Receive Address: %s", m_udpReceiveAddress.c_str());
@@ -975,12 +1030,25 @@ bool HostBridge::createNetwork()
     if (m_udpAudio) {
         m_udpAudioSocket = new Socket(m_udpReceiveAddress, m_udpReceivePort);
         m_udpAudioSocket->open();
+
+        // UDP audio is resampled to and from 8kHz, if the endpoint runs at a different rate
+        if (m_udpSampleRate != SAMPLE_RATE) {
+            m_udpRxResampler = new Resampler(m_udpSampleRate, SAMPLE_RATE);
+            m_udpTxResampler = new Resampler(SAMPLE_RATE, m_udpSampleRate);
+            LogInfo("    UDP Audio Resampling: %uHz, %.1fms delay", m_udpSampleRate, m_udpRxResampler->getDelay());
+        }
+
+        // the send address is resolved once, rather than for every datagram
+        if (udp::Socket::lookup(m_udpSendAddress, m_udpSendPort, m_udpSendAddr, m_udpSendAddrLen) != 0) {
+            LogError(LOG_HOST, "failed to resolve UDP audio send address, %s:%u", m_udpSendAddress.c_str(), m_udpSendPort);
+            m_udpSendAddrLen = 0U;
+        }
     }
 
     return true;
 }
 
-/* Helper to process UDP audio. */
+/* Helper to read UDP audio datagrams into the UDP audio queue. */
 
 void HostBridge::processUDPAudio()
 {
@@ -989,99 +1057,319 @@ void HostBridge::processUDPAudio()
     if (m_udpAudioSocket == nullptr)
         return;
 
-    sockaddr_storage addr;
-    uint32_t addrLen;
+    // datagrams are read directly into the free frames of the UDP audio queue
+    UDPDatagram datagrams[UDP_AUDIO_BATCH_COUNT];
+    uint32_t count = 0U;
+    for (; count < UDP_AUDIO_BATCH_COUNT; count++) {
+        UDPAudioFrame* frame = m_udpInputAudio.reserve(count);
+        if (frame == nullptr)
+            break;
 
-    // read message from socket
-    uint8_t buffer[DATA_PACKET_LENGTH];
-    ::memset(buffer, 0x00U, DATA_PACKET_LENGTH);
-    int length = m_udpAudioSocket->read(buffer, DATA_PACKET_LENGTH, addr, addrLen);
-    if (length < 0) {
-        return;
+        datagrams[count].buffer = frame->data;
+        datagrams[count].length = UDP_AUDIO_FRAME_LENGTH;
     }
 
-    if (length > 0) {
-        if (m_debug)
-            Utils::dump(1U, "UDP Audio Network Packet", buffer, length);
+    if (count == 0U)
+        return; // the audio thread has fallen behind, leave the datagrams queued on the socket
 
-        uint32_t pcmLength = __GET_UINT32(buffer, 0U);
+    int received = m_udpAudioSocket->read(datagrams, count);
+    if (received <= 0)
+        return;
 
-        UInt8Array __pcm = std::make_unique<uint8_t[]>(pcmLength);
-        uint8_t* pcm = __pcm.get();
+    for (int i = 0; i < received; i++)
+        m_udpInputAudio.reserve(i)->length = datagrams[i].length;
+    m_udpInputAudio.commit(received);
+}
 
-        ::memcpy(pcm, buffer + 4U, pcmLength);
+/* Helper to process a UDP audio datagram. */
 
-        // Utils::dump(1U, "PCM RECV BYTE BUFFER", pcm, pcmLength);
+void HostBridge::processUDPAudioFrame(UDPAudioFrame& frame)
+{
+    uint8_t* buffer = frame.data;
+    uint32_t length = frame.length;
+    if (length < 4U)
+        return;
+
+    if (m_debug)
+        Utils::dump(1U, "UDP Audio Network Packet", buffer, length);
+
+    uint32_t frameSamples = SampleTimeConvert::ToSamples(m_udpSampleRate, 1, 20);
+    uint32_t pcmLength = __GET_UINT32(buffer, 0U);
+    uint32_t expectedLength = (m_udpMetadata) ? pcmLength + 12U : pcmLength + 4U;
+    if (pcmLength != (frameSamples * 2U) || length < expectedLength) {
+        LogWarning(LOG_HOST, "%s, invalid UDP audio datagram, len = %u, pcmLength = %u", UDP_CALL, length, pcmLength);
+        return;
+    }
+
+    // Utils::dump(1U, "PCM RECV BYTE BUFFER", buffer + 4U, pcmLength);
 
-        m_udpSrcId = m_srcId;
-        if (m_udpMetadata) {
-            if (m_overrideSrcIdFromUDP)
-                m_udpSrcId = __GET_UINT32(buffer, pcmLength + 8U);
+    m_udpSrcId = m_srcId;
+    if (m_udpMetadata) {
+        if (m_overrideSrcIdFromUDP)
+            m_udpSrcId = __GET_UINT32(buffer, pcmLength + 8U);
+    }
+
+    m_udpDstId = m_dstId;
+
+    short samples[MBE_SAMPLES_LENGTH];
+    if (m_udpRxResampler != nullptr) {
+        short pcm[MAX_AUDIO_FRAME_SAMPLES];
+        PCMConvert::toSamples(buffer + 4U, pcm, frameSamples);
+
+        // a 20ms frame resamples to exactly one 8kHz frame
+        short resampled[MAX_AUDIO_FRAME_SAMPLES + 1U];
+        uint32_t written = m_udpRxResampler->process(pcm, frameSamples, resampled);
+        ::memset(samples, 0x00U, sizeof(samples));
+        ::memcpy(samples, resampled, std::min<uint32_t>(written, MBE_SAMPLES_LENGTH) * sizeof(short));
+    }
+    else {
+        PCMConvert::toSamples(buffer + 4U, samples, MBE_SAMPLES_LENGTH);
+    }
+
+    m_trafficFromUDP = true;
+
+    // force start a call if one isn't already in progress
+    if (!m_audioDetect && !m_callInProgress) {
+        m_audioDetect = true;
+        if (m_txStreamId == 0U) {
+            m_txStreamId = 1U; // prevent further false starts -- this isn't the right way to handle this...
+            LogMessage(LOG_HOST, "%s, call start, srcId = %u, dstId = %u", UDP_CALL, m_udpSrcId, m_udpDstId);
+            if (m_grantDemand) {
+                switch (m_txMode)
+                {
+                case TX_MODE_P25:
+                {
+                    p25::lc::LC lc = p25::lc::LC();
+                    lc.setLCO(p25::defines::LCO::GROUP);
+                    lc.setDstId(m_udpDstId);
+                    lc.setSrcId(m_udpSrcId);
+
+                    p25::data::LowSpeedData lsd = p25::data::LowSpeedData();
+
+                    uint8_t controlByte = 0x80U;
+                    m_network->writeP25TDU(lc, lsd, controlByte);
+                }
+                break;
+                }
+            }
         }
 
-        m_udpDstId = m_dstId;
+        m_dropTime.stop();
 
-        std::lock_guard<std::mutex> lock(m_audioMutex);
+        if (!m_dropTime.isRunning())
+            m_dropTime.start();
+    }
 
-        int smpIdx = 0;
-        short samples[MBE_SAMPLES_LENGTH];
-        for (uint32_t pcmIdx = 0; pcmIdx < pcmLength; pcmIdx += 2) {
-            samples[smpIdx] = (short)((pcm[pcmIdx + 1] << 8) + pcm[pcmIdx + 0]);
-            smpIdx++;
+    // If audio detection is active and no call is in progress, encode and transmit the audio
+    if (m_audioDetect && !m_callInProgress) {
+        m_dropTime.start();
+
+        switch (m_txMode) {
+        case TX_MODE_DMR:
+            encodeDMRAudioFrame(samples, m_udpSrcId);
+            break;
+        case TX_MODE_P25:
+            encodeP25AudioFrame(samples, m_udpSrcId);
+            break;
         }
+    }
+}
 
-        m_inputAudio.addData(samples, MBE_SAMPLES_LENGTH);
+/* Helper to queue a frame of decoded audio for transmission as a UDP audio datagram. */
 
-        m_trafficFromUDP = true;
+void HostBridge::writeUDPAudio(const short* samples, uint32_t srcId, uint32_t dstId)
+{
+    if (m_udpAudioSocket == nullptr || m_udpSendAddrLen == 0U)
+        return;
 
-        // force start a call if one isn't already in progress
-        if (!m_audioDetect && !m_callInProgress) {
-            m_audioDetect = true;
-            if (m_txStreamId == 0U) {
-                m_txStreamId = 1U; // prevent further false starts -- this isn't the right way to handle this...
-                LogMessage(LOG_HOST, "%s, call start, srcId = %u, dstId = %u", UDP_CALL, m_udpSrcId, m_udpDstId);
-                if (m_grantDemand) {
-                    switch (m_txMode)
-                    {
-                    case TX_MODE_P25:
-                    {
-                        p25::lc::LC lc = p25::lc::LC();
-                        lc.setLCO(p25::defines::LCO::GROUP);
-                        lc.setDstId(m_udpDstId);
-                        lc.setSrcId(m_udpSrcId);
+    if (m_udpOutputQueue.size() == UDP_AUDIO_BATCH_COUNT)
+        flushUDPAudio();
 
-                        p25::data::LowSpeedData lsd = p25::data::LowSpeedData();
+    UDPDatagram* datagram = &m_udpOutputDatagrams[m_udpOutputQueue.size()];
+    uint8_t* audioData = datagram->buffer;
 
-                        uint8_t controlByte = 0x80U;
-                        m_network->writeP25TDU(lc, lsd, controlByte);
-                    }
-                    break;
-                    }
-                }
-            }
+    // PCM + 4 bytes (PCM length) [+ 4 bytes (dstId) + 4 bytes (srcId)]
+    uint32_t pcmLength = MBE_SAMPLES_LENGTH * 2U;
+    if (m_udpTxResampler != nullptr) {
+        short resampled[MAX_AUDIO_FRAME_SAMPLES + 1U];
+        uint32_t written = m_udpTxResampler->process(samples, MBE_SAMPLES_LENGTH, resampled);
+        PCMConvert::toPCM(resampled, audioData + 4U, written);
+        pcmLength = written * 2U;
+    }
+    else {
+        PCMConvert::toPCM(samples, audioData + 4U, MBE_SAMPLES_LENGTH);
+    }
 
-            m_dropTime.stop();
+    __SET_UINT32(pcmLength, audioData, 0U);
+    datagram->length = pcmLength + 4U;
 
-            if (!m_dropTime.isRunning())
-                m_dropTime.start();
-        }
+    if (m_udpMetadata) {
+        // embed destination and source IDs
+        __SET_UINT32(dstId, audioData, (pcmLength + 4U));
+        __SET_UINT32(srcId, audioData, (pcmLength + 8U));
+        datagram->length = pcmLength + 12U;
+    }
 
-        // If audio detection is active and no call is in progress, encode and transmit the audio
-        if (m_audioDetect && !m_callInProgress) {
-            m_dropTime.start();
+    datagram->address = m_udpSendAddr;
+    datagram->addrLen = m_udpSendAddrLen;
+    m_udpOutputQueue.push_back(datagram);
+}
 
-            switch (m_txMode) {
-            case TX_MODE_DMR:
-                encodeDMRAudioFrame(pcm, m_udpSrcId);
-                break;
-            case TX_MODE_P25:
-                encodeP25AudioFrame(pcm, m_udpSrcId);
-                break;
+/* Helper to transmit the queued UDP audio datagrams. */
+
+void HostBridge::flushUDPAudio()
+{
+    if (m_udpOutputQueue.empty())
+        return;
+
+    // the datagrams of a decoded burst or LDU go out with a single system call (sendmmsg)
+    if (!m_udpAudioSocket->write(m_udpOutputQueue)) {
+        LogError(LOG_HOST, "%s, failed to write UDP audio", UDP_CALL);
+    }
+
+    m_udpOutputQueue.clear();
+}
+
+/* Helper to queue a frame of decoded audio for local playback. */
+
+void HostBridge::writeOutputAudio(const short* samples)
+{
+    AudioFrame* frame = m_outputAudio.reserve();
+    if (frame == nullptr) {
+        LogError(LOG_HOST, "**** Overflow in %s, dropping audio frame", m_outputAudio.name());
+        return;
+    }
+
+    ::memcpy(frame->samples, samples, sizeof(frame->samples));
+    m_outputAudio.commit();
+}
+
+/* Helper to fill a device period with decoded audio for local playback. */
+
+void HostBridge::readOutputAudio(uint8_t* output, uint32_t count)
+{
+    // the device period need not be a single frame; a frame is played across as many periods as it
+    // takes, resampled from 8kHz if the device runs at a different rate
+    uint32_t offset = 0U;
+    while (offset < count) {
+        if (m_playbackOffset == m_playbackLength) {
+            AudioFrame* frame = m_outputAudio.front();
+            if (frame == nullptr)
+                return; // nothing to play, the rest of the period is silence
+
+            if (m_playbackResampler != nullptr) {
+                m_playbackLength = m_playbackResampler->process(frame->samples, MBE_SAMPLES_LENGTH, m_playbackSamples);
             }
+            else {
+                ::memcpy(m_playbackSamples, frame->samples, sizeof(frame->samples));
+                m_playbackLength = MBE_SAMPLES_LENGTH;
+            }
+
+            m_playbackOffset = 0U;
+            m_outputAudio.pop();
         }
+
+        uint32_t length = std::min<uint32_t>(m_playbackLength - m_playbackOffset, count - offset);
+        PCMConvert::toPCM(m_playbackSamples + m_playbackOffset, output + (offset * 2U), length);
+        m_playbackOffset += length;
+        offset += length;
+    }
+}
+
+/* Helper to queue captured local audio, collected into whole frames, for the audio thread. */
+
+void HostBridge::writeInputAudio(const short* samples, uint32_t count)
+{
+    // the device period need not be a single frame; samples are held until they fill a frame
+    uint32_t offset = 0U;
+    while (offset < count) {
+        uint32_t length = std::min<uint32_t>(count - offset, MBE_SAMPLES_LENGTH - m_captureLength);
+        ::memcpy(m_captureSamples + m_captureLength, samples + offset, length * sizeof(short));
+        m_captureLength += length;
+        offset += length;
+
+        if (m_captureLength < MBE_SAMPLES_LENGTH)
+            return;
+
+        m_captureLength = 0U;
+
+        AudioFrame* frame = m_inputAudio.reserve();
+        if (frame == nullptr)
+            continue; // the audio thread has fallen behind, drop the captured audio
+
+        ::memcpy(frame->samples, m_captureSamples, sizeof(frame->samples));
+        m_inputAudio.commit();
     }
 }
 
+/* Helper to queue a codeword, as part of a batch, for decoding by the vocoder pool. */
+
+bool HostBridge::queueDecodeFrame(const uint8_t* codeword, uint32_t length, uint32_t srcId, uint32_t dstId, uint32_t n)
+{
+    vocoder::VocoderFrame* frame = m_vocoder->reserve(m_vocoderStream, n);
+    if (frame == nullptr) {
+        LogError(LOG_HOST, "**** Overflow in vocoder queue, dropping audio frame");
+        return false;
+    }
+
+    frame->op = vocoder::VOCODER_DECODE;
+    frame->tag = ((uint64_t)srcId << 32) | dstId;
+    ::memcpy(frame->codeword, codeword, length);
+    return true;
+}
+
+/* Helper to write the audio frames decoded by the vocoder pool to the audio endpoints. */
+
+void HostBridge::processDecodedAudio()
+{
+    if (m_vocoder == nullptr)
+        return;
+
+    vocoder::VocoderFrame* frame = nullptr;
+    while ((frame = m_vocoder->front(m_vocoderStream)) != nullptr) {
+        uint32_t srcId = (uint32_t)(frame->tag >> 32);
+        uint32_t dstId = (uint32_t)(frame->tag & 0xFFFFFFFFU);
+
+        if (m_debug && frame->errs > 0)
+            LogDebug(LOG_HOST, "Vocoder, decoded frame, srcId = %u, dstId = %u, errs = %d", srcId, dstId, frame->errs);
+
+        writeDecodedAudio(frame->samples, srcId, dstId);
+        m_vocoder->pop(m_vocoderStream);
+    }
+
+    flushUDPAudio();
+}
+
+/* Helper to write a frame of decoded audio to the audio endpoints. */
+
+void HostBridge::writeDecodedAudio(short* samples, uint32_t srcId, uint32_t dstId)
+{
+    // post-process: apply gain to decoded audio frames
+    PCMConvert::applyGain(samples, MBE_SAMPLES_LENGTH, m_rxAudioGain);
+
+    if (m_localAudio) {
+        writeOutputAudio(samples);
+    }
+
+    if (m_udpAudio) {
+        writeUDPAudio(samples, srcId, dstId);
+    }
+}
+
+/* Helper to validate the configured sample rate of an audio endpoint. */
+
+bool HostBridge::checkSampleRate(const char* name, uint32_t sampleRate)
+{
+    // audio is framed in 20ms frames, so the rate must be a multiple of 50Hz
+    if (sampleRate < SAMPLE_RATE || sampleRate > MAX_AUDIO_SAMPLE_RATE || (sampleRate % 50U) != 0U) {
+        ::LogError(LOG_HOST, "Unsupported %s sample rate, %uHz; must be between %uHz and %uHz, and a multiple of 50Hz.",
+            name, sampleRate, SAMPLE_RATE, MAX_AUDIO_SAMPLE_RATE);
+        return false;
+    }
+
+    return true;
+}
+
 /* Helper to process DMR network traffic. */
 
 void HostBridge::processDMRNetwork(uint8_t* buffer, uint32_t length)
@@ -1261,94 +1549,40 @@ void HostBridge::decodeDMRAudioFrame(uint8_t* ambe, uint32_t srcId, uint32_t dst
     using namespace dmr;
     using namespace dmr::defines;
 
+    uint32_t queued = 0U;
     for (uint32_t n = 0; n < AMBE_PER_SLOT; n++) {
         uint8_t ambePartial[RAW_AMBE_LENGTH_BYTES];
         for (uint32_t i = 0; i < RAW_AMBE_LENGTH_BYTES; i++)
             ambePartial[i] = ambe[i + (n * 9)];
 
-        short samples[MBE_SAMPLES_LENGTH];
-        int errs = 0;
+        if (m_debug)
+            LogMessage(LOG_HOST, DMR_DT_VOICE ", Frame, VC%u.%u, srcId = %u, dstId = %u", dmrN, n, srcId, dstId);
+
 #if defined(_WIN32)
         if (m_useExternalVocoder) {
+            short samples[MBE_SAMPLES_LENGTH];
             ambeDecode(ambePartial, RAW_AMBE_LENGTH_BYTES, samples);
+            writeDecodedAudio(samples, srcId, dstId);
+            continue;
         }
-        else {
 #endif // defined(_WIN32)
-            m_decoder->decode(ambePartial, samples);
-#if defined(_WIN32)
-        }
-#endif // defined(_WIN32)
-
-        if (m_debug)
-            LogMessage(LOG_HOST, DMR_DT_VOICE ", Frame, VC%u.%u, srcId = %u, dstId = %u, errs = %u", dmrN, n, srcId, dstId, errs);
-
-        // post-process: apply gain to decoded audio frames
-        if (m_rxAudioGain != 1.0f) {
-            for (int n = 0; n < MBE_SAMPLES_LENGTH; n++) {
-                short sample = samples[n];
-                float newSample = sample * m_rxAudioGain;
-                sample = (short)newSample;
-
-                // clip if necessary
-                if (m_rxAudioGain > 1.0f) {
-                    if (newSample > 32767)
-                        sample = 32767;
-                    else if (newSample < -32767)
-                        sample = -32767;
-                }
-
-                samples[n] = sample;
-            }
-        }
-
-        if (m_localAudio) {
-            m_outputAudio.addData(samples, MBE_SAMPLES_LENGTH);
-        }
-
-        if (m_udpAudio) {
-            int pcmIdx = 0;
-            uint8_t pcm[MBE_SAMPLES_LENGTH * 2U];
-            for (uint32_t smpIdx = 0; smpIdx < MBE_SAMPLES_LENGTH; smpIdx++) {
-                pcm[pcmIdx + 0] = (uint8_t)(samples[smpIdx] & 0xFF);
-                pcm[pcmIdx + 1] = (uint8_t)((samples[smpIdx] >> 8) & 0xFF);
-                pcmIdx += 2;
-            }
 
-            uint32_t length = (MBE_SAMPLES_LENGTH * 2U) + 4U;
-            uint8_t* audioData = nullptr;
-            if (!m_udpMetadata) {
-                audioData = new uint8_t[(MBE_SAMPLES_LENGTH * 2U) + 4U]; // PCM + 4 bytes (PCM length)
-                __SET_UINT32((MBE_SAMPLES_LENGTH * 2U), audioData, 0U);
-                ::memcpy(audioData + 4U, pcm, MBE_SAMPLES_LENGTH * 2U);
-            }
-            else {
-                length = (MBE_SAMPLES_LENGTH * 2U) + 12U;
-                audioData = new uint8_t[(MBE_SAMPLES_LENGTH * 2U) + 12U]; // PCM + (4 bytes (PCM length) + 4 bytes (srcId) + 4 bytes (dstId))
-                __SET_UINT32((MBE_SAMPLES_LENGTH * 2U), audioData, 0U);
-                ::memcpy(audioData + 4U, pcm, MBE_SAMPLES_LENGTH * 2U);
-
-                // embed destination and source IDs
-                __SET_UINT32(dstId, audioData, ((MBE_SAMPLES_LENGTH * 2U) + 4U));
-                __SET_UINT32(srcId, audioData, ((MBE_SAMPLES_LENGTH * 2U) + 8U));
-            }
-
-            sockaddr_storage addr;
-            uint32_t addrLen;
+        if (queueDecodeFrame(ambePartial, RAW_AMBE_LENGTH_BYTES, srcId, dstId, queued))
+            queued++;
+    }
 
-            if (udp::Socket::lookup(m_udpSendAddress, m_udpSendPort, addr, addrLen) == 0) {
-                m_udpAudioSocket->write(audioData, length, addr, addrLen);
-            }
+    // the frames of the burst are handed to the vocoder pool as a single batch
+    if (queued > 0U)
+        m_vocoder->submit(m_vocoderStream, queued);
 
-            delete[] audioData;
-        }
-    }
+    flushUDPAudio();
 }
 
 /* Helper to encode DMR network traffic audio frames. */
 
-void HostBridge::encodeDMRAudioFrame(uint8_t* pcm, uint32_t forcedSrcId, uint32_t forcedDstId)
+void HostBridge::encodeDMRAudioFrame(short* samples, uint32_t forcedSrcId, uint32_t forcedDstId)
 {
-    assert(pcm != nullptr);
+    assert(samples != nullptr);
     using namespace dmr;
     using namespace dmr::defines;
 
@@ -1454,31 +1688,8 @@ void HostBridge::encodeDMRAudioFrame(uint8_t* pcm, uint32_t forcedSrcId, uint32_
         m_ambeCount = 0U;
     }
 
-    int smpIdx = 0;
-    short samples[MBE_SAMPLES_LENGTH];
-    for (uint32_t pcmIdx = 0; pcmIdx < (MBE_SAMPLES_LENGTH * 2U); pcmIdx += 2) {
-        samples[smpIdx] = (short)((pcm[pcmIdx + 1] << 8) + pcm[pcmIdx + 0]);
-        smpIdx++;
-    }
-
     // pre-process: apply gain to PCM audio frames
-    if (m_txAudioGain != 1.0f) {
-        for (int n = 0; n < MBE_SAMPLES_LENGTH; n++) {
-            short sample = samples[n];
-            float newSample = sample * m_txAudioGain;
-            sample = (short)newSample;
-
-            // clip if necessary
-            if (m_txAudioGain > 1.0f) {
-                if (newSample > 32767)
-                    sample = 32767;
-                else if (newSample < -32767)
-                    sample = -32767;
-            }
-
-            samples[n] = sample;
-        }
-    }
+    PCMConvert::applyGain(samples, MBE_SAMPLES_LENGTH, m_txAudioGain);
 
     // encode PCM samples into AMBE codewords
     uint8_t ambe[RAW_AMBE_LENGTH_BYTES];
@@ -1779,6 +1990,7 @@ void HostBridge::decodeP25AudioFrame(uint8_t* ldu, uint32_t srcId, uint32_t dstI
     using namespace p25::defines;
 
     // decode 9 IMBE codewords into PCM samples
+    uint32_t queued = 0U;
     for (int n = 0; n < 9; n++) {
         uint8_t imbe[RAW_IMBE_LENGTH_BYTES];
         switch (n) {
@@ -1813,89 +2025,34 @@ void HostBridge::decodeP25AudioFrame(uint8_t* ldu, uint32_t srcId, uint32_t dstI
 
         // Utils::dump(1U, "IMBE", imbe, RAW_IMBE_LENGTH_BYTES);
 
-        short samples[MBE_SAMPLES_LENGTH];
-        int errs = 0;
+        if (m_debug)
+            LogDebug(LOG_HOST, "P25, LDU (Logical Link Data Unit), Frame, VC%u.%u, srcId = %u, dstId = %u", p25N, n, srcId, dstId);
+
 #if defined(_WIN32)
         if (m_useExternalVocoder) {
+            short samples[MBE_SAMPLES_LENGTH];
             ambeDecode(imbe, RAW_IMBE_LENGTH_BYTES, samples);
-        }
-        else {
-#endif // defined(_WIN32)
-            m_decoder->decode(imbe, samples);
-#if defined(_WIN32)
+            writeDecodedAudio(samples, srcId, dstId);
+            continue;
         }
 #endif // defined(_WIN32)
 
-        if (m_debug)
-            LogDebug(LOG_HOST, "P25, LDU (Logical Link Data Unit), Frame, VC%u.%u, srcId = %u, dstId = %u, errs = %u", p25N, n, srcId, dstId, errs);
-
-        // post-process: apply gain to decoded audio frames
-        if (m_rxAudioGain != 1.0f) {
-            for (int n = 0; n < MBE_SAMPLES_LENGTH; n++) {
-                short sample = samples[n];
-                float newSample = sample * m_rxAudioGain;
-                sample = (short)newSample;
-
-                // clip if necessary
-                if (m_rxAudioGain > 1.0f) {
-                    if (newSample > 32767)
-                        sample = 32767;
-                    else if (newSample < -32767)
-                        sample = -32767;
-                }
-
-                samples[n] = sample;
-            }
-        }
-
-        if (m_localAudio) {
-            m_outputAudio.addData(samples, MBE_SAMPLES_LENGTH);
-        }
-
-        if (m_udpAudio) {
-            int pcmIdx = 0;
-            uint8_t pcm[MBE_SAMPLES_LENGTH * 2U];
-            for (uint32_t smpIdx = 0; smpIdx < MBE_SAMPLES_LENGTH; smpIdx++) {
-                pcm[pcmIdx + 0] = (uint8_t)(samples[smpIdx] & 0xFF);
-                pcm[pcmIdx + 1] = (uint8_t)((samples[smpIdx] >> 8) & 0xFF);
-                pcmIdx += 2;
-            }
-
-            uint32_t length = (MBE_SAMPLES_LENGTH * 2U) + 4U;
-            uint8_t* audioData = nullptr;
-            if (!m_udpMetadata) {
-                audioData = new uint8_t[(MBE_SAMPLES_LENGTH * 2U) + 4U]; // PCM + 4 bytes (PCM length)
-                __SET_UINT32((MBE_SAMPLES_LENGTH * 2U), audioData, 0U);
-                ::memcpy(audioData + 4U, pcm, MBE_SAMPLES_LENGTH * 2U);
-            }
-            else {
-                length = (MBE_SAMPLES_LENGTH * 2U) + 12U;
-                audioData = new uint8_t[(MBE_SAMPLES_LENGTH * 2U) + 12U]; // PCM + (4 bytes (PCM length) + 4 bytes (srcId) + 4 bytes (dstId))
-                __SET_UINT32((MBE_SAMPLES_LENGTH * 2U), audioData, 0U);
-                ::memcpy(audioData + 4U, pcm, MBE_SAMPLES_LENGTH * 2U);
-
-                // embed destination and source IDs
-                __SET_UINT32(dstId, audioData, ((MBE_SAMPLES_LENGTH * 2U) + 4U));
-                __SET_UINT32(srcId, audioData, ((MBE_SAMPLES_LENGTH * 2U) + 8U));
-            }
-
-            sockaddr_storage addr;
-            uint32_t addrLen;
+        if (queueDecodeFrame(imbe, RAW_IMBE_LENGTH_BYTES, srcId, dstId, queued))
+            queued++;
+    }
 
-            if (udp::Socket::lookup(m_udpSendAddress, m_udpSendPort, addr, addrLen) == 0) {
-                m_udpAudioSocket->write(audioData, length, addr, addrLen);
-            }
+    // the frames of the LDU are handed to the vocoder pool as a single batch
+    if (queued > 0U)
+        m_vocoder->submit(m_vocoderStream, queued);
 
-            delete[] audioData;
-        }
-    }
+    flushUDPAudio();
 }
 
 /* Helper to encode P25 network traffic audio frames. */
 
-void HostBridge::encodeP25AudioFrame(uint8_t* pcm, uint32_t forcedSrcId, uint32_t forcedDstId)
+void HostBridge::encodeP25AudioFrame(short* samples, uint32_t forcedSrcId, uint32_t forcedDstId)
 {
-    assert(pcm != nullptr);
+    assert(samples != nullptr);
     using namespace p25;
     using namespace p25::defines;
 
@@ -1906,31 +2063,8 @@ void HostBridge::encodeP25AudioFrame(uint8_t* pcm, uint32_t forcedSrcId, uint32_
     if (m_p25N == 9)
         ::memset(m_netLDU2, 0x00U, 9U * 25U);
 
-    int smpIdx = 0;
-    short samples[MBE_SAMPLES_LENGTH];
-    for (uint32_t pcmIdx = 0; pcmIdx < (MBE_SAMPLES_LENGTH * 2U); pcmIdx += 2) {
-        samples[smpIdx] = (short)((pcm[pcmIdx + 1] << 8) + pcm[pcmIdx + 0]);
-        smpIdx++;
-    }
-
     // pre-process: apply gain to PCM audio frames
-    if (m_txAudioGain != 1.0f) {
-        for (int n = 0; n < MBE_SAMPLES_LENGTH; n++) {
-            short sample = samples[n];
-            float newSample = sample * m_txAudioGain;
-            sample = (short)newSample;
-
-            // clip if necessary
-            if (m_txAudioGain > 1.0f) {
-                if (newSample > 32767)
-                    sample = 32767;
-                else if (newSample < -32767)
-                    sample = -32767;
-            }
-
-            samples[n] = sample;
-        }
-    }
+    PCMConvert::applyGain(samples, MBE_SAMPLES_LENGTH, m_txAudioGain);
 
     // encode PCM samples into IMBE codewords
     uint8_t imbe[RAW_IMBE_LENGTH_BYTES];
@@ -2050,30 +2184,23 @@ void HostBridge::encodeP25AudioFrame(uint8_t* pcm, uint32_t forcedSrcId, uint32_
 
 void HostBridge::generatePreambleTone()
 {
-    std::lock_guard<std::mutex> lock(m_audioMutex);
-
     uint64_t frameCount = SampleTimeConvert::ToSamples(SAMPLE_RATE, 1, m_preambleLength);
-    if (frameCount > m_outputAudio.freeSpace()) {
+    uint32_t frames = (uint32_t)((frameCount + MBE_SAMPLES_LENGTH - 1U) / MBE_SAMPLES_LENGTH);
+    if (frames > m_outputAudio.capacity() - m_outputAudio.size()) {
         ::LogError(LOG_HOST, "failed to generate preamble tone");
         return;
     }
 
-    ma_uint32 pcmBytes = frameCount * ma_get_bytes_per_frame(m_maDevice.capture.format, m_maDevice.capture.channels);
-    UInt8Array __sine = std::make_unique<uint8_t[]>(pcmBytes);
-    uint8_t* sine = __sine.get();
-
-    ma_waveform_read_pcm_frames(&m_maSineWaveform, sine, frameCount, NULL);
+    // the tone is written directly into the output audio frames, with the last frame zero padded
+    for (uint32_t n = 0U; n < frames; n++) {
+        AudioFrame* frame = m_outputAudio.reserve(n);
+        ::memset(frame->samples, 0x00U, sizeof(frame->samples));
 
-    int smpIdx = 0;
-    std::unique_ptr<short[]> __UNIQUE_sineSamples = std::make_unique<short[]>(frameCount);
-    short* sineSamples = __UNIQUE_sineSamples.get();
-    const uint8_t* pcm = (const uint8_t*)sine;
-    for (uint32_t pcmIdx = 0; pcmIdx < pcmBytes; pcmIdx += 2) {
-        sineSamples[smpIdx] = (short)((pcm[pcmIdx + 1] << 8) + pcm[pcmIdx + 0]);
-        smpIdx++;
+        uint32_t count = std::min<uint32_t>((uint32_t)(frameCount - (n * MBE_SAMPLES_LENGTH)), MBE_SAMPLES_LENGTH);
+        ma_waveform_read_pcm_frames(&m_maSineWaveform, frame->samples, count, NULL);
     }
 
-    m_outputAudio.addData(sineSamples, frameCount);
+    m_outputAudio.commit(frames);
 }
 
 /* Helper to end a local or UDP call. */
@@ -2173,13 +2300,18 @@ void* HostBridge::threadAudioProcess(void* arg)
             uint32_t ms = stopWatch.elapsed();
             stopWatch.start();
 
-            // scope is intentional
-            {
-                std::lock_guard<std::mutex> lock(m_audioMutex);
+            // process UDP audio
+            UDPAudioFrame* udpFrame = nullptr;
+            while ((udpFrame = bridge->m_udpInputAudio.front()) != nullptr) {
+                bridge->processUDPAudioFrame(*udpFrame);
+                bridge->m_udpInputAudio.pop();
+            }
 
-                if (bridge->m_inputAudio.dataSize() >= MBE_SAMPLES_LENGTH) {
-                    short samples[MBE_SAMPLES_LENGTH];
-                    bridge->m_inputAudio.get(samples, MBE_SAMPLES_LENGTH);
+            // process local audio
+            {
+                AudioFrame* frame = bridge->m_inputAudio.front();
+                if (frame != nullptr) {
+                    short* samples = frame->samples;
 
                     // process MDC, if necessary
                     if (bridge->m_overrideSrcIdFromMDC)
@@ -2256,27 +2388,18 @@ void* HostBridge::threadAudioProcess(void* arg)
                     }
 
                     if (bridge->m_audioDetect && !bridge->m_callInProgress) {
-                        ma_uint32 pcmBytes = MBE_SAMPLES_LENGTH * ma_get_bytes_per_frame(bridge->m_maDevice.capture.format, bridge->m_maDevice.capture.channels);
-                        UInt8Array __pcm = std::make_unique<uint8_t[]>(pcmBytes);
-                        uint8_t* pcm = __pcm.get();
-
-                        int pcmIdx = 0;
-                        for (uint32_t smpIdx = 0; smpIdx < MBE_SAMPLES_LENGTH; smpIdx++) {
-                            pcm[pcmIdx + 0] = (uint8_t)(samples[smpIdx] & 0xFF);
-                            pcm[pcmIdx + 1] = (uint8_t)((samples[smpIdx] >> 8) & 0xFF);
-                            pcmIdx += 2;
-                        }
-
                         switch (bridge->m_txMode)
                         {
                         case TX_MODE_DMR:
-                            bridge->encodeDMRAudioFrame(pcm);
+                            bridge->encodeDMRAudioFrame(samples);
                             break;
                         case TX_MODE_P25:
-                            bridge->encodeP25AudioFrame(pcm);
+                            bridge->encodeP25AudioFrame(samples);
                             break;
                         }
                     }
+
+                    bridge->m_inputAudio.pop();
                 }
             }
 
@@ -2349,6 +2472,9 @@ void* HostBridge::threadNetworkProcess(void* arg)
                 }
             }
 
+            // write out network audio decoded by the vocoder pool
+            bridge->processDecodedAudio();
+
             Thread::sleep(1U);
         }
 
@@ -22,10 +22,12 @@
 #include "common/dmr/lc/PrivacyLC.h"
 #include "common/network/udp/Socket.h"
 #include "common/yaml/Yaml.h"
-#include "common/RingBuffer.h"
+#include "common/Resampler.h"
+#include "common/SPSCQueue.h"
 #include "common/Timer.h"
 #include "vocoder/MBEDecoder.h"
 #include "vocoder/MBEEncoder.h"
+#include "vocoder/VocoderPool.h"
 #define MINIAUDIO_IMPLEMENTATION
 #include "audio/miniaudio.h"
 #include "mdc/mdc_decode.h"
@@ -62,6 +64,33 @@ const uint8_t HALF_RATE_MODE = 0x01U;
 const uint8_t TX_MODE_DMR = 1U;
 const uint8_t TX_MODE_P25 = 2U;
 
+#define MAX_AUDIO_SAMPLE_RATE 48000U
+#define MAX_AUDIO_FRAME_SAMPLES (MAX_AUDIO_SAMPLE_RATE / 50U) // 20ms
+
+#define UDP_AUDIO_FRAME_LENGTH 2048U
+#define UDP_AUDIO_BATCH_COUNT 16U
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Represents a frame of PCM audio samples.
+ * @ingroup bridge
+ */
+struct AudioFrame {
+    short samples[MBE_SAMPLES_LENGTH];      //! PCM Samples
+};
+
+/**
+ * @brief Represents a UDP audio datagram (4 bytes PCM length, PCM and optional metadata).
+ * @ingroup bridge
+ */
+struct UDPAudioFrame {
+    uint8_t data[UDP_AUDIO_FRAME_LENGTH];   //! Datagram
+    uint32_t length;                        //! Length of Datagram
+};
+
 
 // ---------------------------------------------------------------------------
 //  Global Functions
@@ -130,6 +159,7 @@ private:
 
     bool m_udpAudio;
     bool m_udpMetadata;
+    uint32_t m_udpSampleRate;
     uint16_t m_udpSendPort;
     std::string m_udpSendAddress;
     uint16_t m_udpReceivePort;
@@ -164,6 +194,7 @@ private:
     bool m_grantDemand;
 
     bool m_localAudio;
+    uint32_t m_localAudioSampleRate;
 
     ma_context m_maContext;
     ma_device_info* m_maPlaybackDevices;
@@ -174,12 +205,32 @@ private:
     ma_waveform m_maSineWaveform;
     ma_waveform_config m_maSineWaveConfig;
 
-    RingBuffer<short> m_inputAudio;
-    RingBuffer<short> m_outputAudio;
+    Resampler* m_captureResampler;
+    Resampler* m_playbackResampler;
+    Resampler* m_udpRxResampler;
+    Resampler* m_udpTxResampler;
+
+    SPSCQueue<AudioFrame> m_inputAudio;
+    SPSCQueue<AudioFrame> m_outputAudio;
+    short m_captureSamples[MBE_SAMPLES_LENGTH];
+    uint32_t m_captureLength;
+    short m_playbackSamples[MAX_AUDIO_FRAME_SAMPLES + 1U];
+    uint32_t m_playbackLength;
+    uint32_t m_playbackOffset;
+    SPSCQueue<UDPAudioFrame> m_udpInputAudio;
+
+    sockaddr_storage m_udpSendAddr;
+    uint32_t m_udpSendAddrLen;
+    UDPAudioFrame m_udpOutputAudio[UDP_AUDIO_BATCH_COUNT];
+    network::udp::UDPDatagram m_udpOutputDatagrams[UDP_AUDIO_BATCH_COUNT];
+    network::udp::BufferVector m_udpOutputQueue;
 
     vocoder::MBEDecoder* m_decoder;
     vocoder::MBEEncoder* m_encoder;
 
+    vocoder::VocoderPool* m_vocoder;
+    int32_t m_vocoderStream;
+
     mdc_decoder_t* m_mdcDecoder;
 
     dmr::data::EmbeddedData m_dmrEmbeddedData;
@@ -213,7 +264,6 @@ private:
     bool m_running;
     bool m_debug;
 
-    static std::mutex m_audioMutex;
     static std::mutex m_networkMutex;
 
 #if defined(_WIN32)
@@ -358,9 +408,70 @@ private:
     bool createNetwork();
 
     /**
-     * @brief Helper to process UDP audio.
+     * @brief Helper to read UDP audio datagrams into the UDP audio queue.
      */
     void processUDPAudio();
+    /**
+     * @brief Helper to process a UDP audio datagram.
+     * @param frame UDP audio datagram.
+     */
+    void processUDPAudioFrame(UDPAudioFrame& frame);
+    /**
+     * @brief Helper to queue a frame of decoded audio for transmission as a UDP audio datagram.
+     * @param samples PCM samples.
+     * @param srcId Source ID.
+     * @param dstId Destination ID.
+     */
+    void writeUDPAudio(const short* samples, uint32_t srcId, uint32_t dstId);
+    /**
+     * @brief Helper to transmit the queued UDP audio datagrams.
+     */
+    void flushUDPAudio();
+    /**
+     * @brief Helper to queue a frame of decoded audio for local playback.
+     * @param samples PCM samples.
+     */
+    void writeOutputAudio(const short* samples);
+    /**
+     * @brief Helper to fill a device period with decoded audio for local playback.
+     * @param[out] output Device PCM buffer.
+     * @param count Number of samples in the device period.
+     */
+    void readOutputAudio(uint8_t* output, uint32_t count);
+    /**
+     * @brief Helper to queue captured local audio, collected into whole frames, for the audio thread.
+     * @param samples PCM samples.
+     * @param count Number of samples.
+     */
+    void writeInputAudio(const short* samples, uint32_t count);
+    /**
+     * @brief Helper to queue a codeword, as part of a batch, for decoding by the vocoder pool.
+     * @param codeword MBE codeword.
+     * @param length Length of the codeword.
+     * @param srcId Source ID.
+     * @param dstId Destination ID.
+     * @param n Offset of the codeword within the batch.
+     * @returns bool True, if the codeword was queued, otherwise false.
+     */
+    bool queueDecodeFrame(const uint8_t* codeword, uint32_t length, uint32_t srcId, uint32_t dstId, uint32_t n);
+    /**
+     * @brief Helper to write the audio frames decoded by the vocoder pool to the audio endpoints.
+     */
+    void processDecodedAudio();
+    /**
+     * @brief Helper to write a frame of decoded audio to the audio endpoints.
+     * @param samples PCM samples (the receive gain is applied in place).
+     * @param srcId Source ID.
+     * @param dstId Destination ID.
+     */
+    void writeDecodedAudio(short* samples, uint32_t srcId, uint32_t dstId);
+    /**
+     * @brief Helper to validate the configured sample rate of an audio endpoint.
+     * @param name Name of the audio endpoint.
+     * @param sampleRate Sample rate (Hz).
+     * @returns bool True, if the sample rate is supported, otherwise false.
+     */
+    bool checkSampleRate(const char* name, uint32_t sampleRate);
 
     /**
      * @brief Helper to process DMR network traffic.
@@ -378,11 +489,11 @@ private:
     void decodeDMRAudioFrame(uint8_t* ambe, uint32_t srcId, uint32_t dstId, uint8_t dmrN);
     /**
      * @brief Helper to encode DMR network traffic audio frames.
-     * @param pcm 
+     * @param samples PCM samples (the transmit gain is applied in place).
      * @param forcedSrcId 
      * @param forcedDstId 
      */
-    void encodeDMRAudioFrame(uint8_t* pcm, uint32_t forcedSrcId = 0U, uint32_t forcedDstId = 0U);
+    void encodeDMRAudioFrame(short* samples, uint32_t forcedSrcId = 0U, uint32_t forcedDstId = 0U);
 
     /**
      * @brief Helper to process P25 network traffic.
@@ -400,11 +511,11 @@ private:
     void decodeP25AudioFrame(uint8_t* ldu, uint32_t srcId, uint32_t dstId, uint8_t p25N);
     /**
      * @brief Helper to encode P25 network traffic audio frames.
-     * @param pcm 
+     * @param samples PCM samples (the transmit gain is applied in place).
      * @param forcedSrcId 
      * @param forcedDstId 
      */
-    void encodeP25AudioFrame(uint8_t* pcm, uint32_t forcedSrcId = 0U, uint32_t forcedDstId = 0U);
+    void encodeP25AudioFrame(short* samples, uint32_t forcedSrcId = 0U, uint32_t forcedDstId = 0U);
 
     /**
      * @brief Helper to generate the preamble tone.
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Bridge
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file PCMConvert.h
+ * @ingroup bridge
+ */
+#if !defined(__PCM_CONVERT_H__)
+#define __PCM_CONVERT_H__
+
+#include "Defines.h"
+
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helpers to convert and scale blocks of 16-bit little endian PCM audio.
+ * @ingroup bridge
+ *
+ *  These operate on whole blocks of samples, with loops simple enough for the compiler to
+ *  vectorize; on little endian hosts the byte order conversion is a plain copy.
+ */
+class HOST_SW_API PCMConvert {
+public:
+    /**
+     * @brief Converts 16-bit little endian PCM bytes to samples.
+     * @param[in] pcm Buffer containing PCM bytes (2 bytes per sample).
+     * @param[out] samples Buffer to write samples to.
+     * @param count Number of samples.
+     */
+    static void toSamples(const uint8_t* pcm, short* samples, uint32_t count)
+    {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        for (uint32_t i = 0U; i < count; i++)
+            samples[i] = (short)((pcm[(i * 2U) + 1U] << 8) | pcm[i * 2U]);
+#else
+        ::memcpy(samples, pcm, count * sizeof(short));
+#endif
+    }
+
+    /**
+     * @brief Converts samples to 16-bit little endian PCM bytes.
+     * @param[in] samples Buffer containing samples.
+     * @param[out] pcm Buffer to write PCM bytes to (2 bytes per sample).
+     * @param count Number of samples.
+     */
+    static void toPCM(const short* samples, uint8_t* pcm, uint32_t count)
+    {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        for (uint32_t i = 0U; i < count; i++) {
+            pcm[i * 2U] = (uint8_t)(samples[i] & 0xFF);
+            pcm[(i * 2U) + 1U] = (uint8_t)((samples[i] >> 8) & 0xFF);
+        }
+#else
+        ::memcpy(pcm, samples, count * sizeof(short));
+#endif
+    }
+
+    /**
+     * @brief Applies gain to samples, clipping to the sample range.
+     * @param samples Buffer containing samples.
+     * @param count Number of samples.
+     * @param gain Gain to apply.
+     */
+    static void applyGain(short* samples, uint32_t count, float gain)
+    {
+        if (gain == 1.0f)
+            return;
+
+        for (uint32_t i = 0U; i < count; i++) {
+            float sample = samples[i] * gain;
+
+            // clip if necessary (this is branchless, so the loop vectorizes)
+            sample = (sample > 32767.0f) ? 32767.0f : sample;
+            sample = (sample < -32767.0f) ? -32767.0f : sample;
+            samples[i] = (short)sample;
+        }
+    }
+};
+
+#endif // __PCM_CONVERT_H__
@@ -145,15 +145,10 @@ void PeerNetwork::writeDMRTerminator(dmr::data::NetData& data, uint32_t* seqNo,
 //  Protected Class Members
 // ---------------------------------------------------------------------------
 
-/* Writes configuration to the network. */
+/* Helper to create the configuration sent to the network. */
 
-bool PeerNetwork::writeConfig()
+json::object PeerNetwork::createConfig()
 {
-    if (m_loginStreamId == 0U) {
-        LogWarning(LOG_NET, "BUGBUG: tried to write network authorisation with no stream ID?");
-        return false;
-    }
-
     const char* software = __NETVER__;
 
     json::object config = json::object();
@@ -189,20 +184,7 @@ bool PeerNetwork::writeConfig()
 
     config["software"].set<std::string>(std::string(software));                 // Software ID
 
-    json::value v = json::value(config);
-    std::string json = v.serialize();
-
-    CharArray __buffer = std::make_unique<char[]>(json.length() + 9U);
-    char* buffer = __buffer.get();
-
-    ::memcpy(buffer + 0U, TAG_REPEATER_CONFIG, 4U);
-    ::sprintf(buffer + 8U, "%s", json.c_str());
-
-    if (m_debug) {
-        Utils::dump(1U, "Network Message, Configuration", (uint8_t*)buffer, json.length() + 8U);
-    }
-
-    return writeMaster({ NET_FUNC::RPTC, NET_SUBFUNC::NOP }, (uint8_t*)buffer, json.length() + 8U, pktSeq(), m_loginStreamId);
+    return config;
 }
 
 // ---------------------------------------------------------------------------
@@ -87,10 +87,10 @@ namespace network
 
     protected:
         /**
-         * @brief Writes configuration to the network.
-         * @returns bool True, if configuration was sent, otherwise false.
+         * @brief Helper to create the configuration sent to the network.
+         * @returns json::object Configuration.
          */
-        bool writeConfig() override;
+        json::object createConfig() override;
 
     private:
         /**
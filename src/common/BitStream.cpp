@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "BitStream.h"
+
+#include <cassert>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+// whole bytes are moved per step, so that any input bit alignment still fits in a 64-bit word
+const uint32_t COPY_CHUNK_BITS = 56U;
+
+// ---------------------------------------------------------------------------
+//  Static Class Members
+// ---------------------------------------------------------------------------
+
+/* Copies an arbitrary length of bits between buffers. */
+
+void BitStream::copy(const uint8_t* in, uint32_t inOffset, uint8_t* out, uint32_t outOffset, uint32_t length)
+{
+    assert(in != nullptr);
+    assert(out != nullptr);
+
+    // identically aligned buffers only need the partial leading byte handled before whole bytes
+    // can be copied directly
+    if ((inOffset & 7U) == (outOffset & 7U)) {
+        uint32_t lead = (8U - (inOffset & 7U)) & 7U;
+        if (lead > length)
+            lead = length;
+
+        write(out, outOffset, read(in, inOffset, lead), lead);
+        inOffset += lead;
+        outOffset += lead;
+        length -= lead;
+
+        uint32_t bytes = length >> 3;
+        ::memcpy(out + (outOffset >> 3), in + (inOffset >> 3), bytes);
+        inOffset += bytes * 8U;
+        outOffset += bytes * 8U;
+        length -= bytes * 8U;
+    }
+
+    while (length >= COPY_CHUNK_BITS) {
+        write(out, outOffset, read(in, inOffset, COPY_CHUNK_BITS), COPY_CHUNK_BITS);
+        inOffset += COPY_CHUNK_BITS;
+        outOffset += COPY_CHUNK_BITS;
+        length -= COPY_CHUNK_BITS;
+    }
+
+    write(out, outOffset, read(in, inOffset, length), length);
+}
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file BitStream.h
+ * @ingroup utils
+ * @file BitStream.cpp
+ * @ingroup utils
+ */
+#if !defined(__BIT_STREAM_H__)
+#define __BIT_STREAM_H__
+
+#include "common/Defines.h"
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements word-level bit field access to MSB first bit buffers.
+ * @ingroup utils
+ *
+ *  Bit offsets follow the READ_BIT/WRITE_BIT convention, bit 0 is the most significant bit of
+ *  the first byte. Fields are moved up to 57 bits at a time through a 64-bit word, and only the
+ *  bytes covering the field are ever read or written.
+ */
+class HOST_SW_API BitStream {
+public:
+    /**
+     * @brief Maximum number of bits that can be read or written as a single value.
+     */
+    static const uint32_t MAX_FIELD_BITS = 57U;
+
+    /**
+     * @brief Reads a bit field.
+     * @param[in] in Input buffer.
+     * @param offset Bit offset in the input buffer.
+     * @param length Number of bits to read (maximum of MAX_FIELD_BITS).
+     * @returns uint64_t Bit field value (right aligned).
+     */
+    static uint64_t read(const uint8_t* in, uint32_t offset, uint32_t length)
+    {
+        if (length == 0U)
+            return 0U;
+
+        const uint8_t* p = in + (offset >> 3);
+        uint32_t bytes = ((offset & 7U) + length + 7U) >> 3;
+
+        uint64_t value = 0U;
+        for (uint32_t i = 0U; i < bytes; i++)
+            value = (value << 8) | p[i];
+
+        value >>= (bytes * 8U) - (offset & 7U) - length;
+        return value & ((1ULL << length) - 1U);
+    }
+
+    /**
+     * @brief Writes a bit field.
+     * @param[out] out Output buffer.
+     * @param offset Bit offset in the output buffer.
+     * @param value Bit field value (right aligned).
+     * @param length Number of bits to write (maximum of MAX_FIELD_BITS).
+     */
+    static void write(uint8_t* out, uint32_t offset, uint64_t value, uint32_t length)
+    {
+        if (length == 0U)
+            return;
+
+        uint8_t* p = out + (offset >> 3);
+        uint32_t bytes = ((offset & 7U) + length + 7U) >> 3;
+        uint32_t tail = (bytes * 8U) - (offset & 7U) - length;
+
+        uint64_t mask = ((1ULL << length) - 1U) << tail;
+        value = (value << tail) & mask;
+        for (int i = (int)bytes - 1; i >= 0; i--) {
+            p[i] = (uint8_t)((p[i] & ~(uint8_t)mask) | (uint8_t)value);
+            mask >>= 8;
+            value >>= 8;
+        }
+    }
+
+    /**
+     * @brief Reads a bit field at a fixed offset.
+     * @tparam OFFSET Bit offset in the input buffer.
+     * @tparam LENGTH Number of bits to read (maximum of MAX_FIELD_BITS).
+     * @param[in] in Input buffer.
+     * @returns uint64_t Bit field value (right aligned).
+     */
+    template <uint32_t OFFSET, uint32_t LENGTH>
+    static uint64_t extract(const uint8_t* in)
+    {
+        static_assert(LENGTH > 0U && LENGTH <= MAX_FIELD_BITS, "bit field length out of range");
+
+        const uint32_t bytes = ((OFFSET & 7U) + LENGTH + 7U) >> 3;
+        const uint8_t* p = in + (OFFSET >> 3);
+
+        uint64_t value = 0U;
+        for (uint32_t i = 0U; i < bytes; i++)
+            value = (value << 8) | p[i];
+
+        return (value >> ((bytes * 8U) - (OFFSET & 7U) - LENGTH)) & ((1ULL << LENGTH) - 1U);
+    }
+
+    /**
+     * @brief Writes a bit field at a fixed offset.
+     * @tparam OFFSET Bit offset in the output buffer.
+     * @tparam LENGTH Number of bits to write (maximum of MAX_FIELD_BITS).
+     * @param[out] out Output buffer.
+     * @param value Bit field value (right aligned).
+     */
+    template <uint32_t OFFSET, uint32_t LENGTH>
+    static void insert(uint8_t* out, uint64_t value)
+    {
+        static_assert(LENGTH > 0U && LENGTH <= MAX_FIELD_BITS, "bit field length out of range");
+
+        const uint32_t bytes = ((OFFSET & 7U) + LENGTH + 7U) >> 3;
+        const uint32_t tail = (bytes * 8U) - (OFFSET & 7U) - LENGTH;
+        uint8_t* p = out + (OFFSET >> 3);
+
+        uint64_t mask = ((1ULL << LENGTH) - 1U) << tail;
+        value = (value << tail) & mask;
+        for (uint32_t i = bytes; i > 0U; i--) {
+            p[i - 1U] = (uint8_t)((p[i - 1U] & ~(uint8_t)mask) | (uint8_t)value);
+            mask >>= 8;
+            value >>= 8;
+        }
+    }
+
+    /**
+     * @brief Copies an arbitrary length of bits between buffers. The buffers must not overlap.
+     * @param[in] in Input buffer.
+     * @param inOffset Bit offset in the input buffer.
+     * @param[out] out Output buffer.
+     * @param outOffset Bit offset in the output buffer.
+     * @param length Number of bits to copy.
+     */
+    static void copy(const uint8_t* in, uint32_t inOffset, uint8_t* out, uint32_t outOffset, uint32_t length);
+};
+
+#endif // __BIT_STREAM_H__
@@ -0,0 +1,405 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "CaptureFile.h"
+#include "Log.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint8_t CAPTURE_ADDR_NONE = 0x00U;
+const uint8_t CAPTURE_ADDR_IPV4 = 0x04U;
+const uint8_t CAPTURE_ADDR_IPV6 = 0x06U;
+
+const ulong64_t CAPTURE_FLUSH_INTERVAL_US = 1000000U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to get the current monotonic time in microseconds. */
+
+static ulong64_t captureTime()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* Helper to encode a variable length (7 bits per byte) value. */
+
+static uint32_t encodeVarint(ulong64_t value, uint8_t* buffer)
+{
+    uint32_t n = 0U;
+    while (value >= 0x80U) {
+        buffer[n++] = (uint8_t)(value & 0x7FU) | 0x80U;
+        value >>= 7;
+    }
+
+    buffer[n++] = (uint8_t)value;
+    return n;
+}
+
+/* Helper to decode a variable length (7 bits per byte) value. */
+
+static bool decodeVarint(FILE* fp, ulong64_t& value)
+{
+    value = 0U;
+    for (uint32_t shift = 0U; shift < 64U; shift += 7U) {
+        int c = ::fgetc(fp);
+        if (c == EOF)
+            return false;
+
+        value |= (ulong64_t)(c & 0x7F) << shift;
+        if ((c & 0x80) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the CaptureWriter class. */
+
+CaptureWriter::CaptureWriter() :
+    m_fp(nullptr),
+    m_mutex(),
+    m_lastTime(0U),
+    m_lastFlush(0U),
+    m_count(0U)
+{
+    /* stub */
+}
+
+/* Finalizes a instance of the CaptureWriter class. */
+
+CaptureWriter::~CaptureWriter()
+{
+    close();
+}
+
+/* Opens (and truncates) the capture file. */
+
+bool CaptureWriter::open(const std::string& file)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_fp != nullptr)
+        return true;
+
+    m_fp = ::fopen(file.c_str(), "wb");
+    if (m_fp == nullptr) {
+        LogError(LOG_HOST, "Failed to open the capture file, %s", file.c_str());
+        return false;
+    }
+
+    uint8_t header[CAPTURE_FILE_HEADER_LENGTH_BYTES];
+    ::memset(header, 0x00U, CAPTURE_FILE_HEADER_LENGTH_BYTES);
+    ::memcpy(header, CAPTURE_FILE_MAGIC, sizeof(CAPTURE_FILE_MAGIC));
+    header[6U] = CAPTURE_FILE_VERSION;
+
+    ulong64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    for (uint32_t i = 0U; i < 8U; i++)
+        header[8U + i] = (uint8_t)(now >> (56U - (i * 8U)));
+
+    if (::fwrite(header, 1U, CAPTURE_FILE_HEADER_LENGTH_BYTES, m_fp) != CAPTURE_FILE_HEADER_LENGTH_BYTES) {
+        LogError(LOG_HOST, "Failed to write the capture file, %s", file.c_str());
+        ::fclose(m_fp);
+        m_fp = nullptr;
+        return false;
+    }
+
+    m_lastTime = captureTime();
+    m_lastFlush = m_lastTime;
+    m_count = 0U;
+    return true;
+}
+
+/* Closes the capture file. */
+
+void CaptureWriter::close()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_fp == nullptr)
+        return;
+
+    ::fclose(m_fp);
+    m_fp = nullptr;
+
+    LogMessage(LOG_HOST, "Capture closed, %u records", m_count);
+}
+
+/* Writes a modem frame to the capture file. */
+
+void CaptureWriter::writeModem(const uint8_t* data, uint32_t length)
+{
+    writeRecord(CaptureRecordType::MODEM, data, length, nullptr);
+}
+
+/* Writes a network frame to the capture file. */
+
+void CaptureWriter::writeNetwork(const uint8_t* data, uint32_t length, const sockaddr_storage& address, uint32_t addrLen)
+{
+    writeRecord(CaptureRecordType::NETWORK, data, length, (addrLen > 0U) ? &address : nullptr);
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to write a record to the capture file. */
+
+void CaptureWriter::writeRecord(CaptureRecordType::E type, const uint8_t* data, uint32_t length, const sockaddr_storage* address)
+{
+    assert(data != nullptr);
+    if (length == 0U || length > CAPTURE_MAX_RECORD_LENGTH)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_fp == nullptr)
+        return;
+
+    ulong64_t now = captureTime();
+
+    // type, time since the previous record, length and source address
+    uint8_t header[48U];
+    uint32_t n = 0U;
+    header[n++] = type;
+    n += encodeVarint(now - m_lastTime, header + n);
+    n += encodeVarint(length, header + n);
+    m_lastTime = now;
+
+    if (type == CaptureRecordType::NETWORK) {
+        if (address != nullptr && address->ss_family == AF_INET) {
+            const struct sockaddr_in* in = (const struct sockaddr_in*)address;
+            header[n++] = CAPTURE_ADDR_IPV4;
+            ::memcpy(header + n, &in->sin_port, 2U);
+            ::memcpy(header + n + 2U, &in->sin_addr, 4U);
+            n += 6U;
+        }
+        else if (address != nullptr && address->ss_family == AF_INET6) {
+            const struct sockaddr_in6* in6 = (const struct sockaddr_in6*)address;
+            header[n++] = CAPTURE_ADDR_IPV6;
+            ::memcpy(header + n, &in6->sin6_port, 2U);
+            ::memcpy(header + n + 2U, &in6->sin6_addr, 16U);
+            n += 18U;
+        }
+        else {
+            header[n++] = CAPTURE_ADDR_NONE;
+        }
+    }
+
+    if (::fwrite(header, 1U, n, m_fp) != n || ::fwrite(data, 1U, length, m_fp) != length) {
+        failed();
+        return;
+    }
+
+    m_count++;
+
+    // flush periodically, so the capture of a run that ends abnormally is still usable
+    if (now - m_lastFlush >= CAPTURE_FLUSH_INTERVAL_US) {
+        m_lastFlush = now;
+        if (::fflush(m_fp) != 0) {
+            failed();
+        }
+    }
+}
+
+/* Helper to stop capturing after a failed write. */
+
+void CaptureWriter::failed()
+{
+    LogError(LOG_HOST, "Failed to write the capture file, capture stopped after %u records", m_count);
+    ::fclose(m_fp);
+    m_fp = nullptr;
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the CaptureReader class. */
+
+CaptureReader::CaptureReader(CaptureRecordType::E type, bool realtime) :
+    m_type(type),
+    m_realtime(realtime),
+    m_fp(nullptr),
+    m_start(0U),
+    m_pending(false),
+    m_recordTime(0U),
+    m_record(nullptr),
+    m_recordLen(0U),
+    m_recordAddr(),
+    m_recordAddrLen(0U),
+    m_eof(false),
+    m_count(0U)
+{
+    m_record = new uint8_t[CAPTURE_MAX_RECORD_LENGTH];
+    ::memset(&m_recordAddr, 0x00U, sizeof(sockaddr_storage));
+}
+
+/* Finalizes a instance of the CaptureReader class. */
+
+CaptureReader::~CaptureReader()
+{
+    close();
+    delete[] m_record;
+}
+
+/* Opens the capture file. */
+
+bool CaptureReader::open(const std::string& file)
+{
+    if (m_fp != nullptr)
+        return true;
+
+    m_fp = ::fopen(file.c_str(), "rb");
+    if (m_fp == nullptr) {
+        LogError(LOG_HOST, "Failed to open the capture file, %s", file.c_str());
+        return false;
+    }
+
+    uint8_t header[CAPTURE_FILE_HEADER_LENGTH_BYTES];
+    if (::fread(header, 1U, CAPTURE_FILE_HEADER_LENGTH_BYTES, m_fp) != CAPTURE_FILE_HEADER_LENGTH_BYTES ||
+        ::memcmp(header, CAPTURE_FILE_MAGIC, sizeof(CAPTURE_FILE_MAGIC)) != 0) {
+        LogError(LOG_HOST, "%s is not a capture file", file.c_str());
+        close();
+        return false;
+    }
+
+    if (header[6U] != CAPTURE_FILE_VERSION) {
+        LogError(LOG_HOST, "Unsupported capture file version, %u", header[6U]);
+        close();
+        return false;
+    }
+
+    m_start = captureTime();
+    m_recordTime = 0U;
+    m_pending = false;
+    m_eof = false;
+    m_count = 0U;
+    return true;
+}
+
+/* Closes the capture file. */
+
+void CaptureReader::close()
+{
+    if (m_fp == nullptr)
+        return;
+
+    ::fclose(m_fp);
+    m_fp = nullptr;
+}
+
+/* Reads the next record, if it is due. */
+
+uint32_t CaptureReader::read(uint8_t* buffer, sockaddr_storage* address, uint32_t* addrLen)
+{
+    assert(buffer != nullptr);
+    if (m_fp == nullptr || m_eof)
+        return 0U;
+
+    if (!m_pending) {
+        if (!readRecord()) {
+            m_eof = true;
+            LogMessage(LOG_HOST, "Capture replay complete, %u %s records in %.3fs", m_count,
+                (m_type == CaptureRecordType::MODEM) ? "modem" : "network", (captureTime() - m_start) / 1000000.0);
+            return 0U;
+        }
+
+        m_pending = true;
+    }
+
+    if (m_realtime && (captureTime() - m_start) < m_recordTime)
+        return 0U;
+
+    ::memcpy(buffer, m_record, m_recordLen);
+    if (address != nullptr)
+        *address = m_recordAddr;
+    if (addrLen != nullptr)
+        *addrLen = m_recordAddrLen;
+
+    m_pending = false;
+    m_count++;
+    return m_recordLen;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to read the next record of the replayed type from the capture file. */
+
+bool CaptureReader::readRecord()
+{
+    while (true) {
+        int type = ::fgetc(m_fp);
+        if (type == EOF)
+            return false;
+
+        ulong64_t delta = 0U, length = 0U;
+        if (!decodeVarint(m_fp, delta) || !decodeVarint(m_fp, length))
+            return false;
+
+        m_recordTime += delta;
+        if (length == 0U || length > CAPTURE_MAX_RECORD_LENGTH) {
+            LogError(LOG_HOST, "Capture file is corrupt, record length %llu", length);
+            return false;
+        }
+
+        ::memset(&m_recordAddr, 0x00U, sizeof(sockaddr_storage));
+        m_recordAddrLen = 0U;
+        if (type == CaptureRecordType::NETWORK) {
+            int family = ::fgetc(m_fp);
+            uint8_t addr[18U];
+            if (family == CAPTURE_ADDR_IPV4) {
+                if (::fread(addr, 1U, 6U, m_fp) != 6U)
+                    return false;
+
+                struct sockaddr_in* in = (struct sockaddr_in*)&m_recordAddr;
+                in->sin_family = AF_INET;
+                ::memcpy(&in->sin_port, addr, 2U);
+                ::memcpy(&in->sin_addr, addr + 2U, 4U);
+                m_recordAddrLen = sizeof(struct sockaddr_in);
+            }
+            else if (family == CAPTURE_ADDR_IPV6) {
+                if (::fread(addr, 1U, 18U, m_fp) != 18U)
+                    return false;
+
+                struct sockaddr_in6* in6 = (struct sockaddr_in6*)&m_recordAddr;
+                in6->sin6_family = AF_INET6;
+                ::memcpy(&in6->sin6_port, addr, 2U);
+                ::memcpy(&in6->sin6_addr, addr + 2U, 16U);
+                m_recordAddrLen = sizeof(struct sockaddr_in6);
+            }
+            else if (family != CAPTURE_ADDR_NONE) {
+                return false;
+            }
+        }
+
+        // records of other types are skipped
+        if (type != m_type) {
+            if (::fseek(m_fp, (long)length, SEEK_CUR) != 0)
+                return false;
+            continue;
+        }
+
+        if (::fread(m_record, 1U, (size_t)length, m_fp) != (size_t)length)
+            return false;
+
+        m_recordLen = (uint32_t)length;
+        return true;
+    }
+}
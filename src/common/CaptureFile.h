@@ -0,0 +1,218 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @defgroup capture Traffic Capture
+ * @brief Defines and implements the capture, and replay, of modem and network traffic.
+ * @ingroup common
+ *
+ * @file CaptureFile.h
+ * @ingroup capture
+ * @file CaptureFile.cpp
+ * @ingroup capture
+ */
+#if !defined(__CAPTURE_FILE_H__)
+#define __CAPTURE_FILE_H__
+
+#include "common/Defines.h"
+#include "common/network/udp/Socket.h"
+
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/**
+ * @addtogroup capture
+ * @{
+ */
+
+const uint8_t   CAPTURE_FILE_MAGIC[] = { 0x44U, 0x56U, 0x4DU, 0x43U, 0x41U, 0x50U }; // "DVMCAP"
+const uint8_t   CAPTURE_FILE_VERSION = 0x01U;
+const uint32_t  CAPTURE_FILE_HEADER_LENGTH_BYTES = 16U;
+
+const uint32_t  CAPTURE_MAX_RECORD_LENGTH = 8192U;
+
+/**
+ * @brief Capture Record Type
+ */
+namespace CaptureRecordType {
+    /** @brief Capture Record Type */
+    enum E : uint8_t {
+        MODEM = 0x01U,                      //! Modem Frame (as returned by the modem)
+        NETWORK = 0x02U,                    //! Network Frame (as read from the network)
+    };
+}
+
+/** @} */
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements a writer for a traffic capture file.
+ *
+ *  A capture file is a 16 byte header (magic, version and the wall clock start time of the
+ *  capture) followed by records; each record is its type, the time (in microseconds) since the
+ *  previous record and the length of the frame (both variable length encoded), the source address
+ *  (for network frames) and the frame itself.
+ *
+ * @ingroup capture
+ */
+class HOST_SW_API CaptureWriter {
+public:
+    /**
+     * @brief Initializes a new instance of the CaptureWriter class.
+     */
+    CaptureWriter();
+    /**
+     * @brief Finalizes a instance of the CaptureWriter class.
+     */
+    ~CaptureWriter();
+
+    /**
+     * @brief Opens (and truncates) the capture file.
+     * @param file Full path to the capture file.
+     * @returns bool True, if the capture file was opened, otherwise false.
+     */
+    bool open(const std::string& file);
+    /**
+     * @brief Closes the capture file.
+     */
+    void close();
+
+    /**
+     * @brief Writes a modem frame to the capture file.
+     * @param[in] data Buffer containing the modem frame.
+     * @param length Length of the modem frame.
+     */
+    void writeModem(const uint8_t* data, uint32_t length);
+    /**
+     * @brief Writes a network frame to the capture file.
+     * @param[in] data Buffer containing the network frame.
+     * @param length Length of the network frame.
+     * @param address IP address the frame was read from.
+     * @param addrLen
+     */
+    void writeNetwork(const uint8_t* data, uint32_t length, const sockaddr_storage& address, uint32_t addrLen);
+
+    /**
+     * @brief Gets the number of records written.
+     * @returns uint32_t Number of records written.
+     */
+    uint32_t getCount() const { return m_count; }
+
+private:
+    FILE* m_fp;
+    std::mutex m_mutex;
+
+    ulong64_t m_lastTime;
+    ulong64_t m_lastFlush;
+    uint32_t m_count;
+
+    /**
+     * @brief Helper to write a record to the capture file.
+     * @param type Record type.
+     * @param[in] data Buffer containing the frame.
+     * @param length Length of the frame.
+     * @param[in] address IP address the frame was read from.
+     */
+    void writeRecord(CaptureRecordType::E type, const uint8_t* data, uint32_t length, const sockaddr_storage* address);
+    /**
+     * @brief Helper to stop capturing after a failed write; the failure is only logged once, and
+     *  later records are discarded.
+     */
+    void failed();
+};
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements a reader that replays the records of one type from a traffic capture file.
+ *
+ *  In real-time mode, records become due at the same offset from the opening of the reader as
+ *  they were captured from the start of the capture; otherwise every read returns the next record.
+ *
+ * @ingroup capture
+ */
+class HOST_SW_API CaptureReader {
+public:
+    /**
+     * @brief Initializes a new instance of the CaptureReader class.
+     * @param type Type of the records to replay.
+     * @param realtime Flag indicating records are replayed at their captured times.
+     */
+    CaptureReader(CaptureRecordType::E type, bool realtime);
+    /**
+     * @brief Finalizes a instance of the CaptureReader class.
+     */
+    ~CaptureReader();
+
+    /**
+     * @brief Opens the capture file.
+     * @param file Full path to the capture file.
+     * @returns bool True, if the capture file was opened, otherwise false.
+     */
+    bool open(const std::string& file);
+    /**
+     * @brief Closes the capture file.
+     */
+    void close();
+
+    /**
+     * @brief Reads the next record, if it is due.
+     * @param[out] buffer Buffer to read the frame to (at least CAPTURE_MAX_RECORD_LENGTH bytes).
+     * @param[out] address IP address the frame was read from (network records only).
+     * @param[out] addrLen
+     * @returns uint32_t Length of the frame read, or zero if no record is due.
+     */
+    uint32_t read(uint8_t* buffer, sockaddr_storage* address = nullptr, uint32_t* addrLen = nullptr);
+
+    /**
+     * @brief Flag indicating whether all records have been replayed.
+     * @returns bool True, if all records have been replayed, otherwise false.
+     */
+    bool isEOF() const { return m_eof; }
+    /**
+     * @brief Gets the number of records replayed.
+     * @returns uint32_t Number of records replayed.
+     */
+    uint32_t getCount() const { return m_count; }
+
+private:
+    CaptureRecordType::E m_type;
+    bool m_realtime;
+
+    FILE* m_fp;
+    ulong64_t m_start;
+
+    bool m_pending;
+    ulong64_t m_recordTime;
+    uint8_t* m_record;
+    uint32_t m_recordLen;
+    sockaddr_storage m_recordAddr;
+    uint32_t m_recordAddrLen;
+
+    bool m_eof;
+    uint32_t m_count;
+
+    /**
+     * @brief Helper to read the next record of the replayed type from the capture file.
+     * @returns bool True, if a record was read, otherwise false.
+     */
+    bool readRecord();
+};
+
+#endif // __CAPTURE_FILE_H__
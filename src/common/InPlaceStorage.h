@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file InPlaceStorage.h
+ * @ingroup common
+ */
+#if !defined(__IN_PLACE_STORAGE_H__)
+#define __IN_PLACE_STORAGE_H__
+
+#include "common/Defines.h"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Fixed size storage holding a single instance of any class derived from T, constructed
+ *  in place without a heap allocation. Constructing a new instance destroys the previously held one.
+ * @ingroup common
+ * @tparam T Base type of the held instance (must have a virtual destructor).
+ * @tparam SIZE Size of the storage, in bytes.
+ */
+template<class T, size_t SIZE>
+class HOST_SW_API InPlaceStorage {
+public:
+    static_assert(std::has_virtual_destructor<T>::value, "InPlaceStorage requires a virtual destructor");
+
+    /**
+     * @brief Initializes a new instance of the InPlaceStorage class.
+     */
+    InPlaceStorage() :
+        m_object(nullptr)
+    {
+        /* stub */
+    }
+    /**
+     * @brief Finalizes a instance of the InPlaceStorage class.
+     */
+    ~InPlaceStorage()
+    {
+        reset();
+    }
+
+    /**
+     * @brief Constructs a new instance of U in the storage, destroying the previously held instance.
+     * @tparam U Derived type to construct.
+     * @returns U* Instance of U held by the storage.
+     */
+    template<class U>
+    U* emplace()
+    {
+        static_assert(std::is_base_of<T, U>::value, "InPlaceStorage type must derive from the base type");
+        static_assert(sizeof(U) <= SIZE, "InPlaceStorage is too small for the type");
+        static_assert(alignof(U) <= alignof(std::max_align_t), "InPlaceStorage type is over-aligned");
+
+        reset();
+        U* object = new (&m_storage) U();
+        m_object = object;
+        return object;
+    }
+
+    /**
+     * @brief Destroys the held instance.
+     */
+    void reset()
+    {
+        if (m_object != nullptr) {
+            m_object->~T();
+            m_object = nullptr;
+        }
+    }
+
+    /**
+     * @brief Gets the held instance.
+     * @returns T* Held instance, or nullptr if the storage is empty.
+     */
+    T* get() const { return m_object; }
+
+private:
+    typename std::aligned_storage<SIZE, alignof(std::max_align_t)>::type m_storage;
+    T* m_object;
+
+    InPlaceStorage(const InPlaceStorage&) = delete;
+    InPlaceStorage& operator=(const InPlaceStorage&) = delete;
+};
+
+#endif // __IN_PLACE_STORAGE_H__
@@ -0,0 +1,238 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "Resampler.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define RESAMPLER_SIMD 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define RESAMPLER_SIMD 1
+#endif
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const double RESAMPLER_PI = 3.14159265358979323846;
+const double KAISER_BETA = 6.0;
+const double CUTOFF_RATIO = 0.475; // of the lower sample rate
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helper to calculate the greatest common divisor.
+ * @param a
+ * @param b
+ * @returns uint32_t Greatest common divisor of a and b.
+ */
+static uint32_t gcd(uint32_t a, uint32_t b)
+{
+    while (b != 0U) {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+
+    return a;
+}
+
+/**
+ * @brief Helper to calculate the zeroth order modified Bessel function of the first kind.
+ * @param x
+ * @returns double
+ */
+static double besselI0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    for (uint32_t k = 1U; k < 32U; k++) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+        if (term < sum * 1e-12)
+            break;
+    }
+
+    return sum;
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the Resampler class. */
+
+Resampler::Resampler(uint32_t inputRate, uint32_t outputRate) :
+    m_inputRate(inputRate),
+    m_outputRate(outputRate),
+    m_interp(1U),
+    m_decim(1U),
+    m_taps(0U),
+    m_coeffs(nullptr),
+    m_history(nullptr),
+    m_historyPos(0U),
+    m_phase(0U)
+{
+    assert(inputRate > 0U);
+    assert(outputRate > 0U);
+
+    uint32_t div = gcd(inputRate, outputRate);
+    m_interp = outputRate / div;
+    m_decim = inputRate / div;
+
+    // identical rates are passed straight through
+    if (m_interp == 1U && m_decim == 1U)
+        return;
+
+    /*
+    ** the prototype filter runs at the intermediate rate (inputRate * L); it spans the given number
+    ** of zero crossings either side of center, at the lower of the two rates
+    */
+    uint32_t length = (2U * RESAMPLER_ZERO_CROSSINGS * std::max(m_interp, m_decim)) + 1U;
+    double intermediateRate = (double)inputRate * m_interp;
+    double cutoff = (CUTOFF_RATIO * std::min(inputRate, outputRate)) / intermediateRate;
+    double center = (length - 1U) / 2.0;
+    double i0Beta = besselI0(KAISER_BETA);
+
+    // taps per phase are padded to a multiple of 4, for the vectorized dot product
+    m_taps = (length + m_interp - 1U) / m_interp;
+    m_taps = (m_taps + 3U) & ~3U;
+
+    m_coeffs = new float[m_interp * m_taps];
+    ::memset(m_coeffs, 0x00U, m_interp * m_taps * sizeof(float));
+    for (uint32_t k = 0U; k < length; k++) {
+        double x = k - center;
+        double sinc = (x == 0.0) ? 1.0 : ::sin(2.0 * RESAMPLER_PI * cutoff * x) / (2.0 * RESAMPLER_PI * cutoff * x);
+
+        double r = (2.0 * k) / (length - 1U) - 1.0;
+        double window = besselI0(KAISER_BETA * ::sqrt(std::max(0.0, 1.0 - (r * r)))) / i0Beta;
+
+        // the interpolation gain (L) is folded into the coefficients
+        double h = 2.0 * cutoff * sinc * window * m_interp;
+
+        // phase p holds taps p, p + L, p + 2L, ...
+        m_coeffs[((k % m_interp) * m_taps) + (k / m_interp)] = (float)h;
+    }
+
+    // the history is stored twice over, so the newest m_taps samples are always contiguous
+    m_history = new float[m_taps * 2U];
+    reset();
+}
+
+/* Finalizes a instance of the Resampler class. */
+
+Resampler::~Resampler()
+{
+    if (m_coeffs != nullptr)
+        delete[] m_coeffs;
+    if (m_history != nullptr)
+        delete[] m_history;
+}
+
+/* Resamples a block of samples. */
+
+uint32_t Resampler::process(const short* input, uint32_t count, short* output)
+{
+    assert(input != nullptr);
+    assert(output != nullptr);
+
+    if (m_taps == 0U) {
+        ::memcpy(output, input, count * sizeof(short));
+        return count;
+    }
+
+    uint32_t written = 0U;
+    for (uint32_t i = 0U; i < count; i++) {
+        m_historyPos = (m_historyPos == 0U) ? m_taps - 1U : m_historyPos - 1U;
+        m_history[m_historyPos] = m_history[m_historyPos + m_taps] = (float)input[i];
+
+        // every output sample whose time falls within this input sample uses it as the newest sample
+        const float* history = m_history + m_historyPos;
+        while (m_phase < m_interp) {
+            float sample = dotProduct(m_coeffs + (m_phase * m_taps), history);
+
+            sample = (sample > 32767.0f) ? 32767.0f : sample;
+            sample = (sample < -32768.0f) ? -32768.0f : sample;
+            output[written++] = (short)::lrintf(sample);
+
+            m_phase += m_decim;
+        }
+
+        m_phase -= m_interp;
+    }
+
+    return written;
+}
+
+/* Resets the resampler, discarding the filter history. */
+
+void Resampler::reset()
+{
+    if (m_history != nullptr)
+        ::memset(m_history, 0x00U, m_taps * 2U * sizeof(float));
+
+    m_historyPos = 0U;
+    m_phase = 0U;
+}
+
+/* Gets the delay added by the resampler. */
+
+float Resampler::getDelay() const
+{
+    if (m_taps == 0U)
+        return 0.0f;
+
+    return (RESAMPLER_ZERO_CROSSINGS * 1000.0f) / std::min(m_inputRate, m_outputRate);
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to calculate the dot product of a filter phase and the input history. */
+
+float Resampler::dotProduct(const float* coeffs, const float* history) const
+{
+#if defined(RESAMPLER_SIMD)
+#if defined(__SSE2__)
+    __m128 acc = _mm_setzero_ps();
+    for (uint32_t j = 0U; j < m_taps; j += 4U)
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(coeffs + j), _mm_loadu_ps(history + j)));
+
+    float lanes[4];
+    _mm_storeu_ps(lanes, acc);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(__ARM_NEON)
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    for (uint32_t j = 0U; j < m_taps; j += 4U)
+        acc = vmlaq_f32(acc, vld1q_f32(coeffs + j), vld1q_f32(history + j));
+
+    return (vgetq_lane_f32(acc, 0) + vgetq_lane_f32(acc, 1)) + (vgetq_lane_f32(acc, 2) + vgetq_lane_f32(acc, 3));
+#endif
+#else
+    float acc[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for (uint32_t j = 0U; j < m_taps; j += 4U) {
+        acc[0] += coeffs[j + 0U] * history[j + 0U];
+        acc[1] += coeffs[j + 1U] * history[j + 1U];
+        acc[2] += coeffs[j + 2U] * history[j + 2U];
+        acc[3] += coeffs[j + 3U] * history[j + 3U];
+    }
+
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+#endif // defined(RESAMPLER_SIMD)
+}
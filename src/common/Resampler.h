@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file Resampler.h
+ * @ingroup common
+ * @file Resampler.cpp
+ * @ingroup common
+ */
+#if !defined(__RESAMPLER_H__)
+#define __RESAMPLER_H__
+
+#include "common/Defines.h"
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Number of zero crossings, on either side of the center tap, of the prototype filter.
+ *  The group delay of the resampler is this many samples at the lower of the two sample rates.
+ */
+#define RESAMPLER_ZERO_CROSSINGS 16U
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements a rational (L/M) polyphase FIR sample rate converter for 16-bit PCM audio.
+ * @ingroup common
+ *
+ *  The prototype low-pass filter is a Kaiser windowed sinc, cut off just under the Nyquist
+ *  frequency of the lower sample rate, and split into L phases so only the taps that land on
+ *  input samples are computed. The added delay is fixed at RESAMPLER_ZERO_CROSSINGS samples of the
+ *  lower sample rate (2ms at 8kHz).
+ */
+class HOST_SW_API Resampler {
+public:
+    /**
+     * @brief Initializes a new instance of the Resampler class.
+     * @param inputRate Input sample rate (Hz).
+     * @param outputRate Output sample rate (Hz).
+     */
+    Resampler(uint32_t inputRate, uint32_t outputRate);
+    /**
+     * @brief Finalizes a instance of the Resampler class.
+     */
+    ~Resampler();
+
+    /**
+     * @brief Resamples a block of samples.
+     * @param[in] input Input samples.
+     * @param count Number of input samples.
+     * @param[out] output Buffer to write output samples to (must hold at least maxOutput(count) samples).
+     * @returns uint32_t Number of output samples.
+     */
+    uint32_t process(const short* input, uint32_t count, short* output);
+    /**
+     * @brief Resets the resampler, discarding the filter history.
+     */
+    void reset();
+
+    /**
+     * @brief Gets the maximum number of output samples for the given number of input samples.
+     * @param count Number of input samples.
+     * @returns uint32_t Maximum number of output samples.
+     */
+    uint32_t maxOutput(uint32_t count) const { return (uint32_t)(((uint64_t)count * m_interp) / m_decim) + 1U; }
+
+    /**
+     * @brief Gets the input sample rate.
+     * @returns uint32_t Input sample rate (Hz).
+     */
+    uint32_t getInputRate() const { return m_inputRate; }
+    /**
+     * @brief Gets the output sample rate.
+     * @returns uint32_t Output sample rate (Hz).
+     */
+    uint32_t getOutputRate() const { return m_outputRate; }
+    /**
+     * @brief Gets the delay added by the resampler.
+     * @returns float Delay (ms).
+     */
+    float getDelay() const;
+
+private:
+    uint32_t m_inputRate;
+    uint32_t m_outputRate;
+
+    uint32_t m_interp;
+    uint32_t m_decim;
+
+    uint32_t m_taps;
+    float* m_coeffs;
+
+    float* m_history;
+    uint32_t m_historyPos;
+    uint32_t m_phase;
+
+    /**
+     * @brief Helper to calculate the dot product of a filter phase and the input history.
+     * @param coeffs Filter phase coefficients.
+     * @param history Input history (newest sample first).
+     * @returns float Filter output.
+     */
+    float dotProduct(const float* coeffs, const float* history) const;
+};
+
+#endif // __RESAMPLER_H__
@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file SPSCQueue.h
+ * @ingroup common
+ */
+#if !defined(__SPSC_QUEUE_H__)
+#define __SPSC_QUEUE_H__
+
+#include "common/Defines.h"
+
+#include <atomic>
+#include <cassert>
+#include <utility>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define SPSC_CACHE_LINE_SIZE 64U
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Bounded lock-free queue, for handing items from a single producer thread to a single
+ *  consumer thread.
+ * @ingroup common
+ * @tparam T Type of item to store in the queue (must be default constructible and movable).
+ *
+ *  push(), reserve() and commit() may only be called from the producer thread; front(), pop() and
+ *  clear() may only be called from the consumer thread. The remaining members may be called from either thread.
+ */
+template<class T>
+class HOST_SW_API SPSCQueue {
+public:
+    /**
+     * @brief Initializes a new instance of the SPSCQueue class.
+     * @param capacity Maximum number of items in the queue (rounded up to a power of 2).
+     * @param name Name of queue.
+     */
+    SPSCQueue(uint32_t capacity, const char* name) :
+        m_capacity(1U),
+        m_name(name),
+        m_buffer(nullptr),
+        m_head(0U),
+        m_tail(0U)
+    {
+        assert(capacity > 0U);
+
+        while (m_capacity < capacity)
+            m_capacity <<= 1;
+
+        m_buffer = new T[m_capacity];
+    }
+
+    /**
+     * @brief Finalizes a instance of the SPSCQueue class.
+     */
+    ~SPSCQueue()
+    {
+        delete[] m_buffer;
+    }
+
+    /**
+     * @brief Adds an item to the end of the queue. (Producer thread only.)
+     * @param item Item to add.
+     * @return bool True, if the item was added to the queue, otherwise false (queue is full).
+     */
+    bool push(T item)
+    {
+        uint32_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) >= m_capacity)
+            return false;
+
+        m_buffer[tail & (m_capacity - 1U)] = std::move(item);
+        m_tail.store(tail + 1U, std::memory_order_release);
+        return true;
+    }
+    /**
+     * @brief Gets a free slot at the end of the queue, to be filled in place. The slot isn't visible
+     *  to the consumer until it is committed. (Producer thread only.)
+     * @param n Index of the free slot (0 is the slot the next committed item occupies).
+     * @returns T* Free slot, or nullptr if the queue doesn't have n + 1 free slots.
+     */
+    T* reserve(uint32_t n = 0U)
+    {
+        uint32_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail + n - m_head.load(std::memory_order_acquire) >= m_capacity)
+            return nullptr;
+
+        return &m_buffer[(tail + n) & (m_capacity - 1U)];
+    }
+    /**
+     * @brief Adds previously reserved slots to the end of the queue. (Producer thread only.)
+     * @param count Number of reserved slots to add.
+     */
+    void commit(uint32_t count = 1U)
+    {
+        uint32_t tail = m_tail.load(std::memory_order_relaxed);
+        assert(tail + count - m_head.load(std::memory_order_acquire) <= m_capacity);
+        m_tail.store(tail + count, std::memory_order_release);
+    }
+
+    /**
+     * @brief Gets the item at the front of the queue, leaving it in the queue. (Consumer thread only.)
+     * @returns T* Item at the front of the queue, or nullptr if the queue is empty.
+     */
+    T* front()
+    {
+        uint32_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+            return nullptr;
+
+        return &m_buffer[head & (m_capacity - 1U)];
+    }
+    /**
+     * @brief Removes the item at the front of the queue. (Consumer thread only.)
+     * @param[out] item Item removed from the queue.
+     * @return bool True, if an item was removed, otherwise false (queue is empty).
+     */
+    bool pop(T& item)
+    {
+        T* next = front();
+        if (next == nullptr)
+            return false;
+
+        item = std::move(*next);
+        pop();
+        return true;
+    }
+    /**
+     * @brief Removes the item at the front of the queue, discarding it. (Consumer thread only.)
+     */
+    void pop()
+    {
+        uint32_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+            return;
+
+        m_buffer[head & (m_capacity - 1U)] = T();
+        m_head.store(head + 1U, std::memory_order_release);
+    }
+
+    /**
+     * @brief Clears the queue. (Consumer thread only.)
+     */
+    void clear()
+    {
+        while (front() != nullptr)
+            pop();
+    }
+
+    /**
+     * @brief Gets the number of items in the queue.
+     * @returns uint32_t Number of items in the queue.
+     */
+    uint32_t size() const
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+    /**
+     * @brief Helper to test if the queue is empty.
+     * @returns bool True, if the queue is empty, otherwise false.
+     */
+    bool isEmpty() const { return size() == 0U; }
+    /**
+     * @brief Gets the maximum number of items in the queue.
+     * @returns uint32_t Maximum number of items in the queue.
+     */
+    uint32_t capacity() const { return m_capacity; }
+    /**
+     * @brief Gets the name of the queue.
+     * @returns const char* Name of the queue.
+     */
+    const char* name() const { return m_name; }
+
+private:
+    uint32_t m_capacity;
+    const char* m_name;
+
+    T* m_buffer;
+
+    // the consumer and producer indexes are kept on separate cache lines
+    uint8_t m_pad0[SPSC_CACHE_LINE_SIZE];
+    std::atomic<uint32_t> m_head;
+    uint8_t m_pad1[SPSC_CACHE_LINE_SIZE - sizeof(std::atomic<uint32_t>)];
+    std::atomic<uint32_t> m_tail;
+    uint8_t m_pad2[SPSC_CACHE_LINE_SIZE - sizeof(std::atomic<uint32_t>)];
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+};
+
+#endif // __SPSC_QUEUE_H__
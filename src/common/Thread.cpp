@@ -109,8 +109,11 @@ void Thread::detach()
 
 bool Thread::runAsThread(void* obj, void *(*startRoutine)(void *), thread_t* thread)
 {
-    if (thread == nullptr)
+    bool allocated = false;
+    if (thread == nullptr) {
         thread = new thread_t();
+        allocated = true;
+    }
 
     thread->obj = obj;
 
@@ -126,7 +129,8 @@ bool Thread::runAsThread(void* obj, void *(*startRoutine)(void *), thread_t* thr
 #else
     if (::pthread_create(&thread->thread, NULL, startRoutine, thread) != 0) {
         LogError(LOG_NET, "Error returned from pthread_create, err: %d", errno);
-        delete thread;
+        if (allocated)
+            delete thread;
         return false;
     }
 #endif // defined(_WIN32)
@@ -9,6 +9,7 @@
  *
  */
 #include "Utils.h"
+#include "BitStream.h"
 #include "Log.h"
 
 #include <cstdio>
@@ -293,13 +294,11 @@ uint32_t Utils::getBits(const uint8_t* in, uint8_t* out, uint32_t start, uint32_
     assert(in != nullptr);
     assert(out != nullptr);
 
-    uint32_t n = 0U;
-    for (uint32_t i = start; i < stop; i++, n++) {
-        bool b = READ_BIT(in, i);
-        WRITE_BIT(out, n, b);
-    }
+    if (stop <= start)
+        return 0U;
 
-    return n;
+    BitStream::copy(in, start, out, 0U, stop - start);
+    return stop - start;
 }
 
 /* Helper to retreive arbitrary length of bits from an input buffer. */
@@ -316,13 +315,11 @@ uint32_t Utils::setBits(const uint8_t* in, uint8_t* out, uint32_t start, uint32_
     assert(in != nullptr);
     assert(out != nullptr);
 
-    uint32_t n = 0U;
-    for (uint32_t i = start; i < stop; i++, n++) {
-        bool b = READ_BIT(in, n);
-        WRITE_BIT(out, i, b);
-    }
+    if (stop <= start)
+        return 0U;
 
-    return n;
+    BitStream::copy(in, 0U, out, start, stop - start);
+    return stop - start;
 }
 
 /* Helper to set an arbitrary length of bits from an input buffer. */
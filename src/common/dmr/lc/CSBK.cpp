@@ -67,18 +67,15 @@ CSBK::CSBK() :
     m_logicalCh2(DMR_CHNULL),
     m_slotNo(0U),
     m_siteIdenEntry(::lookups::IdenTable()),
-    m_raw(nullptr)
+    m_raw(),
+    m_rawDecoded(false)
 {
     /* stub */
 }
 
 /* Finalizes a instance of the CSBK class. */
 
-CSBK::~CSBK()
-{
-    if (m_raw != nullptr)
-        delete[] m_raw;
-}
+CSBK::~CSBK() = default;
 
 /* Returns a string that represents the current CSBK. */
 
@@ -91,7 +88,10 @@ std::string CSBK::toString()
 
 uint8_t* CSBK::getDecodedRaw() const
 {
-    return m_raw;
+    if (!m_rawDecoded)
+        return nullptr;
+
+    return const_cast<uint8_t*>(m_raw);
 }
 
 /* Regenerate a DMR CSBK without decoding. */
@@ -275,8 +275,8 @@ bool CSBK::decode(const uint8_t* data, uint8_t* payload)
         Utils::dump(2U, "Decoded CSBK", csbk, DMR_CSBK_LENGTH_BYTES);
     }
 
-    m_raw = new uint8_t[DMR_CSBK_LENGTH_BYTES];
     ::memcpy(m_raw, csbk, DMR_CSBK_LENGTH_BYTES);
+    m_rawDecoded = true;
 
     m_CSBKO = csbk[0U] & 0x3FU;                                                     // CSBKO
     m_lastBlock = (csbk[0U] & 0x80U) == 0x80U;                                      // Last Block Marker
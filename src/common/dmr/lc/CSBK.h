@@ -75,7 +75,7 @@ namespace dmr
             /**
              * @brief Returns a copy of the raw decoded CSBK bytes.
              * This will only return data for a *decoded* CSBK, not a created or copied CSBK.
-             * @returns uint8_t* Raw decoded CSBK bytes.
+             * @returns uint8_t* Raw decoded CSBK bytes, or nullptr if the CSBK was not decoded.
              */
             uint8_t* getDecodedRaw() const;
 
@@ -264,7 +264,8 @@ namespace dmr
             __PROTECTED_COPY(CSBK);
 
         private:
-            uint8_t* m_raw;
+            uint8_t m_raw[defines::DMR_CSBK_LENGTH_BYTES];
+            bool m_rawDecoded;
         };
     } // namespace lc
 } // namespace dmr
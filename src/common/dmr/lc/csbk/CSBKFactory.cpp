@@ -36,6 +36,44 @@ CSBKFactory::~CSBKFactory() = default;
 /* Create an instance of a CSBK. */
 
 std::unique_ptr<CSBK> CSBKFactory::createCSBK(const uint8_t* data, DataType::E dataType)
+{
+    return std::unique_ptr<CSBK>(create(data, dataType, nullptr));
+}
+
+/* Decode a CSBK into caller provided storage, without allocating. */
+
+CSBK* CSBKFactory::decodeCSBK(const uint8_t* data, DataType::E dataType, CSBKStorage& storage)
+{
+    storage.reset();
+    return create(data, dataType, &storage);
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Decode a CSBK. */
+
+template<class T>
+CSBK* CSBKFactory::decode(const uint8_t* data, CSBKStorage* storage)
+{
+    assert(data != nullptr);
+
+    T* csbk = (storage != nullptr) ? storage->emplace<T>() : new T();
+    if (!csbk->decode(data)) {
+        if (storage != nullptr)
+            storage->reset();
+        else
+            delete csbk;
+        return nullptr;
+    }
+
+    return csbk;
+}
+
+/* Decode a CSBK, into the given storage or a new heap instance. */
+
+CSBK* CSBKFactory::create(const uint8_t* data, DataType::E dataType, CSBKStorage* storage)
 {
     assert(data != nullptr);
 
@@ -86,34 +124,34 @@ std::unique_ptr<CSBK> CSBKFactory::createCSBK(const uint8_t* data, DataType::E d
 
     switch (CSBKO) {
     case CSBKO::BSDWNACT:
-        return decode(new CSBK_BSDWNACT(), data);
+        return decode<CSBK_BSDWNACT>(data, storage);
     case CSBKO::UU_V_REQ:
-        return decode(new CSBK_UU_V_REQ(), data);
+        return decode<CSBK_UU_V_REQ>(data, storage);
     case CSBKO::UU_ANS_RSP:
-        return decode(new CSBK_UU_ANS_RSP(), data);
+        return decode<CSBK_UU_ANS_RSP>(data, storage);
     case CSBKO::PRECCSBK:
-        return decode(new CSBK_PRECCSBK(), data);
+        return decode<CSBK_PRECCSBK>(data, storage);
     case CSBKO::RAND: // CSBKO::CALL_ALRT when FID == FID_DMRA
         switch (FID)
         {
         case FID_DMRA:
-            return decode(new CSBK_CALL_ALRT(), data);
+            return decode<CSBK_CALL_ALRT>(data, storage);
         case FID_ETSI:
         default:
-            return decode(new CSBK_RAND(), data);
+            return decode<CSBK_RAND>(data, storage);
         }
     case CSBKO::EXT_FNCT:
-        return decode(new CSBK_EXT_FNCT(), data);
+        return decode<CSBK_EXT_FNCT>(data, storage);
     case CSBKO::NACK_RSP:
-        return decode(new CSBK_NACK_RSP(), data);
+        return decode<CSBK_NACK_RSP>(data, storage);
 
     /** Tier 3 */
     case CSBKO::ACK_RSP:
-        return decode(new CSBK_ACK_RSP(), data);
+        return decode<CSBK_ACK_RSP>(data, storage);
     case CSBKO::BROADCAST:
-        return decode(new CSBK_BROADCAST(), data);
+        return decode<CSBK_BROADCAST>(data, storage);
     case CSBKO::MAINT:
-        return decode(new CSBK_MAINT(), data);
+        return decode<CSBK_MAINT>(data, storage);
 
     default:
         LogError(LOG_DMR, "CSBKFactory::create(), unknown CSBK type, csbko = $%02X", CSBKO);
@@ -122,21 +160,3 @@ std::unique_ptr<CSBK> CSBKFactory::createCSBK(const uint8_t* data, DataType::E d
 
     return nullptr;
 }
-
-// ---------------------------------------------------------------------------
-//  Private Class Members
-// ---------------------------------------------------------------------------
-
-/* Decode a CSBK. */
-
-std::unique_ptr<CSBK> CSBKFactory::decode(CSBK* csbk, const uint8_t* data)
-{
-    assert(csbk != nullptr);
-    assert(data != nullptr);
-
-    if (!csbk->decode(data)) {
-        return nullptr;
-    }
-
-    return std::unique_ptr<CSBK>(csbk);
-}
@@ -24,6 +24,7 @@
 #define  __DMR_LC__CSBK_FACTORY_H__
 
 #include "common/Defines.h"
+#include "common/InPlaceStorage.h"
 
 #include "common/dmr/DMRDefines.h"
 #include "common/dmr/lc/CSBK.h"
@@ -53,6 +54,21 @@ namespace dmr
     {
         namespace csbk
         {
+            // ---------------------------------------------------------------------------
+            //  Constants
+            // ---------------------------------------------------------------------------
+
+            /**
+             * @brief Size of the storage required to hold any CSBK created by the CSBKFactory.
+             */
+            const size_t CSBK_STORAGE_SIZE = 128U;
+
+            /**
+             * @brief Caller provided storage for a CSBK decoded by CSBKFactory::decodeCSBK().
+             * @ingroup dmr_csbk
+             */
+            typedef InPlaceStorage<CSBK, CSBK_STORAGE_SIZE> CSBKStorage;
+
             // ---------------------------------------------------------------------------
             //  Class Declaration
             // ---------------------------------------------------------------------------
@@ -79,15 +95,34 @@ namespace dmr
                  * @returns CSBK* Instance of a CSBK representing the decoded data.
                  */
                 static std::unique_ptr<CSBK> createCSBK(const uint8_t* data, defines::DataType::E dataType);
+                /**
+                 * @brief Decode a CSBK into caller provided storage, without allocating.
+                 *  The returned CSBK is owned by the storage, and is valid until the storage is reused or destroyed.
+                 * @param[in] data Buffer containing CSBK packet data to decode.
+                 * @param dataType Data Type.
+                 * @param storage Storage to decode the CSBK into.
+                 * @returns CSBK* Instance of a CSBK representing the decoded data, or nullptr if the CSBK failed to decode.
+                 */
+                static CSBK* decodeCSBK(const uint8_t* data, defines::DataType::E dataType, CSBKStorage& storage);
 
             private:
+                /**
+                 * @brief Decode a CSBK, into the given storage or a new heap instance.
+                 * @param[in] data Buffer containing CSBK packet data to decode.
+                 * @param dataType Data Type.
+                 * @param storage Storage to decode the CSBK into, or nullptr to allocate the CSBK.
+                 * @returns CSBK* Instance of a CSBK representing the decoded data.
+                 */
+                static CSBK* create(const uint8_t* data, defines::DataType::E dataType, CSBKStorage* storage);
                 /**
                  * @brief Decode a CSBK.
-                 * @param csbk Instance of a CSBK.
+                 * @tparam T Type of CSBK to decode.
                  * @param[in] data Buffer containing CSBK packet data to decode.
+                 * @param storage Storage to decode the CSBK into, or nullptr to allocate the CSBK.
                  * @returns CSBK* Instance of a CSBK representing the decoded data.
                  */
-                static std::unique_ptr<CSBK> decode(CSBK* csbk, const uint8_t* data);
+                template<class T>
+                static CSBK* decode(const uint8_t* data, CSBKStorage* storage);
             };
         } // namespace csbk
     } // namespace lc
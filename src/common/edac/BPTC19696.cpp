@@ -6,16 +6,75 @@
  *
  *  Copyright (C) 2012 Ian Wraith
  *  Copyright (C) 2015 Jonathan Naylor, G4KLX
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
  *
  */
 #include "Defines.h"
 #include "edac/BPTC19696.h"
-#include "edac/Hamming.h"
+#include "BitStream.h"
 #include "Utils.h"
 
 using namespace edac;
 
 #include <cassert>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/*
+** Bit position, in the 33 byte DMR burst, of each bit of the deinterleaved code block; i.e.
+** the interleave sequence (a * 181) % 196 skipping the 68 bits of sync/embedded signalling
+** (the first bit is R(3) which is not used).
+*/
+const uint16_t BIT_TABLE[] = {
+      0U, 249U, 234U, 219U, 204U, 189U, 174U,  91U,  76U,  61U,  46U,  31U,  16U,   1U,
+    250U, 235U, 220U, 205U, 190U, 175U,  92U,  77U,  62U,  47U,  32U,  17U,   2U, 251U,
+    236U, 221U, 206U, 191U, 176U,  93U,  78U,  63U,  48U,  33U,  18U,   3U, 252U, 237U,
+    222U, 207U, 192U, 177U,  94U,  79U,  64U,  49U,  34U,  19U,   4U, 253U, 238U, 223U,
+    208U, 193U, 178U,  95U,  80U,  65U,  50U,  35U,  20U,   5U, 254U, 239U, 224U, 209U,
+    194U, 179U,  96U,  81U,  66U,  51U,  36U,  21U,   6U, 255U, 240U, 225U, 210U, 195U,
+    180U,  97U,  82U,  67U,  52U,  37U,  22U,   7U, 256U, 241U, 226U, 211U, 196U, 181U,
+    166U,  83U,  68U,  53U,  38U,  23U,   8U, 257U, 242U, 227U, 212U, 197U, 182U, 167U,
+     84U,  69U,  54U,  39U,  24U,   9U, 258U, 243U, 228U, 213U, 198U, 183U, 168U,  85U,
+     70U,  55U,  40U,  25U,  10U, 259U, 244U, 229U, 214U, 199U, 184U, 169U,  86U,  71U,
+     56U,  41U,  26U,  11U, 260U, 245U, 230U, 215U, 200U, 185U, 170U,  87U,  72U,  57U,
+     42U,  27U,  12U, 261U, 246U, 231U, 216U, 201U, 186U, 171U,  88U,  73U,  58U,  43U,
+     28U,  13U, 262U, 247U, 232U, 217U, 202U, 187U, 172U,  89U,  74U,  59U,  44U,  29U,
+     14U, 263U, 248U, 233U, 218U, 203U, 188U, 173U,  90U,  75U,  60U,  45U,  30U,  15U
+};
+
+const uint32_t ROW_COUNT = 13U;
+const uint32_t DATA_ROW_COUNT = 9U;
+const uint32_t COL_COUNT = 15U;
+
+const uint32_t MAX_PASSES = 5U;
+
+// Hamming (15,11,3) row parity check masks (one per syndrome bit)
+const uint16_t ROW_CHECK_MASK[] = { 0x7AC8U, 0x3D64U, 0x1EB2U, 0x7591U };
+
+// Hamming (15,11,3) row syndrome to the row bit to correct (0 for no correctable error)
+const uint16_t ROW_SYNDROME_FIX[] = {
+    0x0000U, 0x0008U, 0x0004U, 0x0040U, 0x0002U, 0x0200U, 0x0020U, 0x0800U,
+    0x0001U, 0x4000U, 0x0100U, 0x2000U, 0x0010U, 0x0080U, 0x0400U, 0x1000U };
+
+// Hamming (13,9,3) column syndrome to the row to correct (0xFF for no correctable error)
+const uint8_t COL_SYNDROME_FIX[] = {
+    0xFFU, 9U, 10U, 6U, 11U, 3U, 7U, 1U, 12U, 0xFFU, 4U, 0xFFU, 8U, 5U, 2U, 0U };
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to calculate the parity of a 16-bit word. */
+
+static inline uint16_t parity16(uint16_t x)
+{
+    x ^= x >> 8;
+    x ^= x >> 4;
+    return (0x6996U >> (x & 0x0FU)) & 1U;
+}
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -24,20 +83,14 @@ using namespace edac;
 /* Initializes a new instance of the BPTC19696 class. */
 
 BPTC19696::BPTC19696() :
-    m_rawData(nullptr),
-    m_deInterData(nullptr)
+    m_rows()
 {
-    m_rawData = new bool[196];
-    m_deInterData = new bool[196];
+    /* stub */
 }
 
 /* Finalizes a instance of the BPTC19696 class. */
 
-BPTC19696::~BPTC19696()
-{
-    delete[] m_rawData;
-    delete[] m_deInterData;
-}
+BPTC19696::~BPTC19696() = default;
 
 /* Decode BPTC (196,96) FEC. */
 
@@ -46,12 +99,9 @@ void BPTC19696::decode(const uint8_t* in, uint8_t* out)
     assert(in != nullptr);
     assert(out != nullptr);
 
-    // get the raw binary
+    // get the raw binary and deinterleave
     decodeExtractBinary(in);
 
-    // deinterleave
-    decodeDeInterleave();
-
     // error check
     decodeErrorCheck();
 
@@ -72,10 +122,7 @@ void BPTC19696::encode(const uint8_t* in, uint8_t* out)
     // error check
     encodeErrorCheck();
 
-    // interleave
-    encodeInterleave();
-
-    // get the raw binary
+    // interleave and get the raw binary
     encodeExtractBinary(out);
 }
 
@@ -83,279 +130,130 @@ void BPTC19696::encode(const uint8_t* in, uint8_t* out)
 //  Private Class Members
 // ---------------------------------------------------------------------------
 
-/* */
+/* Deinterleaves the raw code block bits into the packed rows. */
 
 void BPTC19696::decodeExtractBinary(const uint8_t* in)
 {
-    // first block
-    Utils::byteToBitsBE(in[0U], m_rawData + 0U);
-    Utils::byteToBitsBE(in[1U], m_rawData + 8U);
-    Utils::byteToBitsBE(in[2U], m_rawData + 16U);
-    Utils::byteToBitsBE(in[3U], m_rawData + 24U);
-    Utils::byteToBitsBE(in[4U], m_rawData + 32U);
-    Utils::byteToBitsBE(in[5U], m_rawData + 40U);
-    Utils::byteToBitsBE(in[6U], m_rawData + 48U);
-    Utils::byteToBitsBE(in[7U], m_rawData + 56U);
-    Utils::byteToBitsBE(in[8U], m_rawData + 64U);
-    Utils::byteToBitsBE(in[9U], m_rawData + 72U);
-    Utils::byteToBitsBE(in[10U], m_rawData + 80U);
-    Utils::byteToBitsBE(in[11U], m_rawData + 88U);
-    Utils::byteToBitsBE(in[12U], m_rawData + 96U);
-
-    // handle the two bits
-    bool bits[8U];
-    Utils::byteToBitsBE(in[20U], bits);
-    m_rawData[98U] = bits[6U];
-    m_rawData[99U] = bits[7U];
-
-    // second block
-    Utils::byteToBitsBE(in[21U], m_rawData + 100U);
-    Utils::byteToBitsBE(in[22U], m_rawData + 108U);
-    Utils::byteToBitsBE(in[23U], m_rawData + 116U);
-    Utils::byteToBitsBE(in[24U], m_rawData + 124U);
-    Utils::byteToBitsBE(in[25U], m_rawData + 132U);
-    Utils::byteToBitsBE(in[26U], m_rawData + 140U);
-    Utils::byteToBitsBE(in[27U], m_rawData + 148U);
-    Utils::byteToBitsBE(in[28U], m_rawData + 156U);
-    Utils::byteToBitsBE(in[29U], m_rawData + 164U);
-    Utils::byteToBitsBE(in[30U], m_rawData + 172U);
-    Utils::byteToBitsBE(in[31U], m_rawData + 180U);
-    Utils::byteToBitsBE(in[32U], m_rawData + 188U);
-}
-
-/* */
+    uint32_t pos = 1U;
+    for (uint32_t r = 0U; r < ROW_COUNT; r++) {
+        uint16_t row = 0U;
+        for (uint32_t c = 0U; c < COL_COUNT; c++, pos++)
+            row = (row << 1) | (READ_BIT(in, BIT_TABLE[pos]) ? 1U : 0U);
 
-void BPTC19696::decodeDeInterleave()
-{
-    for (uint32_t i = 0U; i < 196U; i++)
-        m_deInterData[i] = false;
-
-    // the first bit is R(3) which is not used so can be ignored
-    for (uint32_t a = 0U; a < 196U; a++) {
-        // calculate the interleave sequence
-        uint32_t interleaveSequence = (a * 181U) % 196U;
-        // shuffle the data
-        m_deInterData[a] = m_rawData[interleaveSequence];
+        m_rows[r] = row;
     }
 }
 
-/* */
+/* Corrects errors in the packed rows, alternating column and row passes. */
 
 void BPTC19696::decodeErrorCheck()
 {
+    const uint16_t* r = m_rows;
+
     bool fixing;
     uint32_t count = 0U;
     do {
         fixing = false;
 
-        // run through each of the 15 columns
-        bool col[13U];
-        for (uint32_t c = 0U; c < 15U; c++) {
-            uint32_t pos = c + 1U;
-            for (uint32_t a = 0U; a < 13U; a++) {
-                col[a] = m_deInterData[pos];
-                pos = pos + 15U;
-            }
-
-            if (Hamming::decode1393(col)) {
-                uint32_t pos = c + 1U;
-                for (uint32_t a = 0U; a < 13U; a++) {
-                    m_deInterData[pos] = col[a];
-                    pos = pos + 15U;
-                }
-
+        // calculate the syndrome of all 15 columns at once, a bit per column
+        uint16_t s0 = r[0U] ^ r[1U] ^ r[3U] ^ r[5U] ^ r[6U] ^ r[9U];
+        uint16_t s1 = r[0U] ^ r[1U] ^ r[2U] ^ r[4U] ^ r[6U] ^ r[7U] ^ r[10U];
+        uint16_t s2 = r[0U] ^ r[1U] ^ r[2U] ^ r[3U] ^ r[5U] ^ r[7U] ^ r[8U] ^ r[11U];
+        uint16_t s3 = r[0U] ^ r[2U] ^ r[4U] ^ r[5U] ^ r[8U] ^ r[12U];
+
+        uint16_t errs = s0 | s1 | s2 | s3;
+        while (errs != 0U) {
+            uint16_t bit = errs & (uint16_t)(~errs + 1U);
+            errs &= ~bit;
+
+            uint32_t n = ((s0 & bit) ? 0x01U : 0x00U) | ((s1 & bit) ? 0x02U : 0x00U) |
+                ((s2 & bit) ? 0x04U : 0x00U) | ((s3 & bit) ? 0x08U : 0x00U);
+            uint8_t row = COL_SYNDROME_FIX[n];
+            if (row != 0xFFU) {
+                m_rows[row] ^= bit;
                 fixing = true;
             }
         }
 
         // run through each of the 9 rows containing data
-        for (uint32_t r = 0U; r < 9U; r++) {
-            uint32_t pos = (r * 15U) + 1U;
-            if (Hamming::decode15113_2(m_deInterData + pos))
+        for (uint32_t i = 0U; i < DATA_ROW_COUNT; i++) {
+            uint16_t row = m_rows[i];
+            uint32_t n = parity16(row & ROW_CHECK_MASK[0U]) | (parity16(row & ROW_CHECK_MASK[1U]) << 1) |
+                (parity16(row & ROW_CHECK_MASK[2U]) << 2) | (parity16(row & ROW_CHECK_MASK[3U]) << 3);
+            if (ROW_SYNDROME_FIX[n] != 0U) {
+                m_rows[i] = row ^ ROW_SYNDROME_FIX[n];
                 fixing = true;
+            }
         }
 
         count++;
-    } while (fixing && count < 5U);
+    } while (fixing && count < MAX_PASSES);
 }
 
-/* */
+/* Extracts the 96 data bits from the packed rows. */
 
 void BPTC19696::decodeExtractData(uint8_t* data) const
 {
-    bool bData[96U];
-    uint32_t pos = 0U;
-    for (uint32_t a = 4U; a <= 11U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 16U; a <= 26U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 31U; a <= 41U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 46U; a <= 56U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 61U; a <= 71U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 76U; a <= 86U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 91U; a <= 101U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 106U; a <= 116U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 121U; a <= 131U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    Utils::bitsToByteBE(bData + 0U, data[0U]);
-    Utils::bitsToByteBE(bData + 8U, data[1U]);
-    Utils::bitsToByteBE(bData + 16U, data[2U]);
-    Utils::bitsToByteBE(bData + 24U, data[3U]);
-    Utils::bitsToByteBE(bData + 32U, data[4U]);
-    Utils::bitsToByteBE(bData + 40U, data[5U]);
-    Utils::bitsToByteBE(bData + 48U, data[6U]);
-    Utils::bitsToByteBE(bData + 56U, data[7U]);
-    Utils::bitsToByteBE(bData + 64U, data[8U]);
-    Utils::bitsToByteBE(bData + 72U, data[9U]);
-    Utils::bitsToByteBE(bData + 80U, data[10U]);
-    Utils::bitsToByteBE(bData + 88U, data[11U]);
+    // the first row carries 8 data bits (columns 3 - 10), the others carry 11 (columns 0 - 10)
+    data[0U] = (uint8_t)((m_rows[0U] >> 4) & 0xFFU);
+    for (uint32_t i = 1U; i < DATA_ROW_COUNT; i++)
+        BitStream::write(data, 8U + 11U * (i - 1U), m_rows[i] >> 4, 11U);
 }
 
-/* */
+/* Places the 96 data bits into the packed rows. */
 
-void BPTC19696::encodeExtractData(const uint8_t* in) const
+void BPTC19696::encodeExtractData(const uint8_t* in)
 {
-    bool bData[96U];
-    Utils::byteToBitsBE(in[0U], bData + 0U);
-    Utils::byteToBitsBE(in[1U], bData + 8U);
-    Utils::byteToBitsBE(in[2U], bData + 16U);
-    Utils::byteToBitsBE(in[3U], bData + 24U);
-    Utils::byteToBitsBE(in[4U], bData + 32U);
-    Utils::byteToBitsBE(in[5U], bData + 40U);
-    Utils::byteToBitsBE(in[6U], bData + 48U);
-    Utils::byteToBitsBE(in[7U], bData + 56U);
-    Utils::byteToBitsBE(in[8U], bData + 64U);
-    Utils::byteToBitsBE(in[9U], bData + 72U);
-    Utils::byteToBitsBE(in[10U], bData + 80U);
-    Utils::byteToBitsBE(in[11U], bData + 88U);
-
-    for (uint32_t i = 0U; i < 196U; i++)
-        m_deInterData[i] = false;
-
-    uint32_t pos = 0U;
-    for (uint32_t a = 4U; a <= 11U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 16U; a <= 26U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 31U; a <= 41U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 46U; a <= 56U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 61U; a <= 71U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 76U; a <= 86U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 91U; a <= 101U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 106U; a <= 116U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 121U; a <= 131U; a++, pos++)
-        m_deInterData[a] = bData[pos];
+    m_rows[0U] = (uint16_t)(in[0U] << 4);
+    for (uint32_t i = 1U; i < DATA_ROW_COUNT; i++)
+        m_rows[i] = (uint16_t)(BitStream::read(in, 8U + 11U * (i - 1U), 11U) << 4);
+
+    for (uint32_t i = DATA_ROW_COUNT; i < ROW_COUNT; i++)
+        m_rows[i] = 0U;
 }
 
-/* */
+/* Generates the row and column parity of the packed rows. */
 
 void BPTC19696::encodeErrorCheck()
 {
     // run through each of the 9 rows containing data
-    for (uint32_t r = 0U; r < 9U; r++) {
-        uint32_t pos = (r * 15U) + 1U;
-        Hamming::encode15113_2(m_deInterData + pos);
+    for (uint32_t i = 0U; i < DATA_ROW_COUNT; i++) {
+        uint16_t row = m_rows[i];
+        m_rows[i] = row | (parity16(row & ROW_CHECK_MASK[0U]) << 3) | (parity16(row & ROW_CHECK_MASK[1U]) << 2) |
+            (parity16(row & ROW_CHECK_MASK[2U]) << 1) | parity16(row & ROW_CHECK_MASK[3U]);
     }
 
-    // run through each of the 15 columns
-    bool col[13U];
-    for (uint32_t c = 0U; c < 15U; c++) {
-        uint32_t pos = c + 1U;
-        for (uint32_t a = 0U; a < 13U; a++) {
-            col[a] = m_deInterData[pos];
-            pos = pos + 15U;
-        }
-
-        Hamming::encode1393(col);
-
-        pos = c + 1U;
-        for (uint32_t a = 0U; a < 13U; a++) {
-            m_deInterData[pos] = col[a];
-            pos = pos + 15U;
-        }
-    }
+    // generate the parity rows, for all 15 columns at once
+    const uint16_t* r = m_rows;
+    m_rows[9U] = r[0U] ^ r[1U] ^ r[3U] ^ r[5U] ^ r[6U];
+    m_rows[10U] = r[0U] ^ r[1U] ^ r[2U] ^ r[4U] ^ r[6U] ^ r[7U];
+    m_rows[11U] = r[0U] ^ r[1U] ^ r[2U] ^ r[3U] ^ r[5U] ^ r[7U] ^ r[8U];
+    m_rows[12U] = r[0U] ^ r[2U] ^ r[4U] ^ r[5U] ^ r[8U];
 }
 
-/* */
+/* Interleaves the packed rows into the raw code block bits. */
 
-void BPTC19696::encodeInterleave()
+void BPTC19696::encodeExtractBinary(uint8_t* data) const
 {
-    for (uint32_t i = 0U; i < 196U; i++)
-        m_rawData[i] = false;
-
-    // the first bit is R(3) which is not used so can be ignored
-    for (uint32_t a = 0U; a < 196U; a++) {
-        // calculate the interleave sequence
-        uint32_t interleaveSequence = (a * 181U) % 196U;
-        // unshuffle the data
-        m_rawData[interleaveSequence] = m_deInterData[a];
+    uint8_t raw[33U];
+    ::memset(raw, 0x00U, 33U);
+
+    uint32_t pos = 1U;
+    for (uint32_t r = 0U; r < ROW_COUNT; r++) {
+        uint16_t row = m_rows[r];
+        for (uint32_t c = 0U; c < COL_COUNT; c++, pos++) {
+            if ((row << c) & 0x4000U)
+                raw[BIT_TABLE[pos] >> 3] |= BIT_MASK_TABLE[BIT_TABLE[pos] & 7U];
+        }
     }
-}
-
-/* */
 
-void BPTC19696::encodeExtractBinary(uint8_t* data)
-{
     // first block
-    Utils::bitsToByteBE(m_rawData + 0U, data[0U]);
-    Utils::bitsToByteBE(m_rawData + 8U, data[1U]);
-    Utils::bitsToByteBE(m_rawData + 16U, data[2U]);
-    Utils::bitsToByteBE(m_rawData + 24U, data[3U]);
-    Utils::bitsToByteBE(m_rawData + 32U, data[4U]);
-    Utils::bitsToByteBE(m_rawData + 40U, data[5U]);
-    Utils::bitsToByteBE(m_rawData + 48U, data[6U]);
-    Utils::bitsToByteBE(m_rawData + 56U, data[7U]);
-    Utils::bitsToByteBE(m_rawData + 64U, data[8U]);
-    Utils::bitsToByteBE(m_rawData + 72U, data[9U]);
-    Utils::bitsToByteBE(m_rawData + 80U, data[10U]);
-    Utils::bitsToByteBE(m_rawData + 88U, data[11U]);
-
-    // handle the two bits
-    uint8_t byte;
-    Utils::bitsToByteBE(m_rawData + 96U, byte);
-    data[12U] = (data[12U] & 0x3FU) | ((byte >> 0) & 0xC0U);
-    data[20U] = (data[20U] & 0xFCU) | ((byte >> 4) & 0x03U);
+    ::memcpy(data, raw, 12U);
+
+    // handle the two bits either side of the sync/embedded signalling
+    data[12U] = (data[12U] & 0x3FU) | (raw[12U] & 0xC0U);
+    data[20U] = (data[20U] & 0xFCU) | (raw[20U] & 0x03U);
 
     // second block
-    Utils::bitsToByteBE(m_rawData + 100U, data[21U]);
-    Utils::bitsToByteBE(m_rawData + 108U, data[22U]);
-    Utils::bitsToByteBE(m_rawData + 116U, data[23U]);
-    Utils::bitsToByteBE(m_rawData + 124U, data[24U]);
-    Utils::bitsToByteBE(m_rawData + 132U, data[25U]);
-    Utils::bitsToByteBE(m_rawData + 140U, data[26U]);
-    Utils::bitsToByteBE(m_rawData + 148U, data[27U]);
-    Utils::bitsToByteBE(m_rawData + 156U, data[28U]);
-    Utils::bitsToByteBE(m_rawData + 164U, data[29U]);
-    Utils::bitsToByteBE(m_rawData + 172U, data[30U]);
-    Utils::bitsToByteBE(m_rawData + 180U, data[31U]);
-    Utils::bitsToByteBE(m_rawData + 188U, data[32U]);
+    ::memcpy(data + 21U, raw + 21U, 12U);
 }
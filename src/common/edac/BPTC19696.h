@@ -5,6 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2015 Jonathan Naylor, G4KLX
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -27,6 +28,11 @@ namespace edac
     /**
      * @brief Implements Block Product Turbo Code (196,96) FEC.
      * @ingroup edac
+     *
+     *  The deinterleaved code block is held as 13 packed rows of 15 bits (column 0 is the most
+     *  significant bit of each row). Rows are checked with table lookups of the Hamming (15,11,3)
+     *  syndrome, and all 15 columns are checked at once by XORing rows together to build the
+     *  Hamming (13,9,3) syndromes a bit per column.
      */
     class HOST_SW_API BPTC19696 {
     public:
@@ -53,45 +59,37 @@ namespace edac
         void encode(const uint8_t* in, uint8_t* out);
 
     private:
-        bool* m_rawData;
-        bool* m_deInterData;
+        uint16_t m_rows[13U];
 
         /**
-         * @brief 
-         * @param in
+         * @brief Deinterleaves the raw code block bits into the packed rows.
+         * @param[in] in Input data to decode.
          */
         void decodeExtractBinary(const uint8_t* in);
         /**
-         * @brief 
+         * @brief Corrects errors in the packed rows, alternating column and row passes.
          */
         void decodeErrorCheck();
         /**
-         * @brief 
-         */
-        void decodeDeInterleave();
-        /**
-         * @brief 
-         * @param data 
+         * @brief Extracts the 96 data bits from the packed rows.
+         * @param[out] data Decoded data.
          */
         void decodeExtractData(uint8_t* data) const;
 
         /**
-         * @brief 
-         */
-        void encodeExtractData(const uint8_t* in) const;
-        /**
-         * @brief 
+         * @brief Places the 96 data bits into the packed rows.
+         * @param[in] in Input data to encode.
          */
-        void encodeInterleave();
+        void encodeExtractData(const uint8_t* in);
         /**
-         * @brief 
+         * @brief Generates the row and column parity of the packed rows.
          */
         void encodeErrorCheck();
         /**
-         * @brief 
-         * @param data 
+         * @brief Interleaves the packed rows into the raw code block bits.
+         * @param[out] data Encoded data.
          */
-        void encodeExtractBinary(uint8_t* data);
+        void encodeExtractBinary(uint8_t* data) const;
     };
 } // namespace edac
 
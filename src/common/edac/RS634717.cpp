@@ -5,19 +5,18 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2016 Jonathan Naylor, G4KLX
- *  Copyright (C) 2017,2023 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2017,2023,2024 Bryan Biedenkapp, N2PLL
  *
  */
 #include "Defines.h"
 #include "edac/RS634717.h"
-#include "edac/rs/RS.h"
 #include "Log.h"
 #include "Utils.h"
 
 using namespace edac;
 
 #include <cassert>
-#include <vector>
+#include <cstring>
 
 // ---------------------------------------------------------------------------
 //  Constants
@@ -77,57 +76,74 @@ const uint8_t ENCODE_MATRIX_362017[20U][36U] = {
     { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 002, 001, 053, 074, 002, 014, 052, 074, 012, 057, 024, 063, 015, 042, 052, 033 },
     { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 034, 035, 002, 023, 021, 027, 022, 033, 064, 042, 005, 073, 051, 046, 073, 060 } };
 
-/**
- * @brief Define a reed-solomon codec.
- * @param TYPE Data type primitive
- * @param SYMBOLS Total number of symbols; must be a power of 2 minus 1, eg 2^8-1 == 255
- * @param PAYLOAD The maximum number of non-parity symbols, eg 253 ==> 2 parity symbols
- * @param POLY A primitive polynomial appropriate to the SYMBOLS size
- * @param FCR The first consecutive root of the Reed-Solomon generator polynomial
- * @param PRIM The primitive root of the generator polynomial
- */
-#define __RS(TYPE, SYMBOLS, PAYLOAD, POLY, FCR, PRIM)                           \
-            edac::rs::reed_solomon<TYPE,                                        \
-            edac::rs::log_<(SYMBOLS) + 1>::value,                               \
-            (SYMBOLS) - (PAYLOAD), FCR, PRIM,                                   \
-            edac::rs::gfpoly<edac::rs::log_<(SYMBOLS) + 1>::value, POLY>>
+const uint32_t GF6_NN = 63U;
 
 /**
- * @brief Define a 63-symbol reed-solomon codec.
- * @param PAYLOAD The maximum number of non-parity symbols, eg 253 ==> 2 parity symbols
+ * @brief GF(2 ^ 6) arithmetic tables (primitive polynomial : x ^ 6 + x + 1).
  */
-#define __RS_63(PAYLOAD) __RS(uint8_t, 63, PAYLOAD, 0x43, 1, 1)
+struct GF6Tables {
+    uint8_t alphaTo[GF6_NN * 2U];   // antilog, doubled so the sum of two logs needs no modulo
+    uint8_t indexOf[GF6_NN + 1U];   // log (indexOf[0] is unused)
+    uint8_t mult[GF6_NN + 1U][GF6_NN + 1U];
+    uint8_t inv[GF6_NN + 1U];       // multiplicative inverse (inv[0] is unused)
+
+    /**
+     * @brief Initializes a new instance of the GF6Tables struct.
+     */
+    constexpr GF6Tables() :
+        alphaTo(),
+        indexOf(),
+        mult(),
+        inv()
+    {
+        uint32_t sr = 1U;
+        for (uint32_t i = 0U; i < GF6_NN; i++) {
+            alphaTo[i] = (uint8_t)sr;
+            alphaTo[i + GF6_NN] = (uint8_t)sr;
+            indexOf[sr] = (uint8_t)i;
+
+            sr <<= 1;
+            if ((sr & 0x40U) == 0x40U)
+                sr ^= 0x43U;
+        }
+
+        for (uint32_t a = 1U; a <= GF6_NN; a++) {
+            for (uint32_t b = 1U; b <= GF6_NN; b++)
+                mult[a][b] = alphaTo[indexOf[a] + indexOf[b]];
+
+            inv[a] = alphaTo[GF6_NN - indexOf[a]];
+        }
+    }
+};
+
+constexpr GF6Tables GF6 = GF6Tables();
 
 // ---------------------------------------------------------------------------
-//  Global Variables
+//  Global Functions
 // ---------------------------------------------------------------------------
 
-/**
- * @brief Implements Reed-Solomon (63,47,17)
- */
-class RS6347 : public __RS_63(47) {
-public:
-    RS6347() : __RS_63(47)() { /* stub */ }
-};
-RS6347 rs634717;    // 16 bit / 8 bit corrections max / 5 bytes total
+/* Helper to unpack 6-bit symbols (hexbits), four symbols per three bytes. */
 
-/**
- * @brief Implements Reed-Solomon (24,12,13)
- */
-class RS6351 : public __RS_63(51) {
-public:
-    RS6351() : __RS_63(51)() { /* stub */ }
-};
-RS6351 rs241213;    // 12 bit / 6 bit corrections max / 3 bytes total
+static inline void unpackHexbits(const uint8_t* in, uint8_t* out, uint32_t count)
+{
+    for (uint32_t i = 0U; i < count; i += 4U, in += 3U, out += 4U) {
+        out[0U] = in[0U] >> 2;
+        out[1U] = ((in[0U] & 0x03U) << 4) | (in[1U] >> 4);
+        out[2U] = ((in[1U] & 0x0FU) << 2) | (in[2U] >> 6);
+        out[3U] = in[2U] & 0x3FU;
+    }
+}
 
-/**
- * @brief Implements Reed-Solomon (24,16,9)
- */
-class RS6355 : public __RS_63(55) {
-public:
-    RS6355() : __RS_63(55)() { /* stub */ }
-};
-RS6355 rs24169;     // 8 bit / 4 bit corrections max / 2 bytes total
+/* Helper to pack 6-bit symbols (hexbits), four symbols per three bytes. */
+
+static inline void packHexbits(const uint8_t* in, uint8_t* out, uint32_t count)
+{
+    for (uint32_t i = 0U; i < count; i += 4U, in += 4U, out += 3U) {
+        out[0U] = (uint8_t)((in[0U] << 2) | (in[1U] >> 4));
+        out[1U] = (uint8_t)((in[1U] << 4) | (in[2U] >> 2));
+        out[2U] = (uint8_t)((in[2U] << 6) | in[3U]);
+    }
+}
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -147,19 +163,17 @@ bool RS634717::decode241213(uint8_t* data)
 {
     assert(data != nullptr);
 
-    std::vector<uint8_t> codeword(63, 0);
+    uint8_t codeword[24U];
 
-    uint32_t offset = 0U;
-    for (uint32_t i = 0U; i < 24U; i++, offset += 6)
-        codeword[39 + i] = Utils::bin2Hex(data, offset);
+    unpackHexbits(data, codeword, 24U);
 
-    int ec = rs241213.decode(codeword);
+    int ec = decode<12U>(codeword, 24U);
 #if DEBUG_RS
     LogDebug(LOG_HOST, "RS634717::decode241213(), errors = %d", ec);
 #endif
-    offset = 0U;
-    for (uint32_t i = 0U; i < 12U; i++, offset += 6)
-        Utils::hex2Bin(codeword[39 + i], data, offset);
+    if (ec > 0) {
+        packHexbits(codeword, data, 12U);
+    }
 
     if ((ec == -1) || (ec >= 6)) {
         return false;
@@ -176,19 +190,18 @@ void RS634717::encode241213(uint8_t* data)
 
     uint8_t codeword[24U];
 
-    for (uint32_t i = 0U; i < 24U; i++) {
-        codeword[i] = 0x00U;
+    unpackHexbits(data, codeword, 12U);
 
-        uint32_t offset = 0U;
-        for (uint32_t j = 0U; j < 12U; j++, offset += 6U) {
-            uint8_t hexbit = Utils::bin2Hex(data, offset);
-            codeword[i] ^= gf6Mult(hexbit, ENCODE_MATRIX[j][i]);
-        }
+    // the encode matrix is systematic, only the parity symbols need to be calculated
+    for (uint32_t i = 12U; i < 24U; i++) {
+        uint8_t parity = 0x00U;
+        for (uint32_t j = 0U; j < 12U; j++)
+            parity ^= GF6.mult[codeword[j]][ENCODE_MATRIX[j][i]];
+
+        codeword[i] = parity;
     }
 
-    uint32_t offset = 0U;
-    for (uint32_t i = 0U; i < 24U; i++, offset += 6U)
-        Utils::hex2Bin(codeword[i], data, offset);
+    packHexbits(codeword, data, 24U);
 }
 
 /* Decode RS (24,16,9) FEC. */
@@ -197,19 +210,17 @@ bool RS634717::decode24169(uint8_t* data)
 {
     assert(data != nullptr);
 
-    std::vector<uint8_t> codeword(63, 0);
+    uint8_t codeword[24U];
 
-    uint32_t offset = 0U;
-    for (uint32_t i = 0U; i < 24U; i++, offset += 6)
-        codeword[39 + i] = Utils::bin2Hex(data, offset);
+    unpackHexbits(data, codeword, 24U);
 
-    int ec = rs24169.decode(codeword);
+    int ec = decode<8U>(codeword, 24U);
 #if DEBUG_RS
     LogDebug(LOG_HOST, "RS634717::decode24169(), errors = %d\n", ec);
 #endif
-    offset = 0U;
-    for (uint32_t i = 0U; i < 16U; i++, offset += 6)
-        Utils::hex2Bin(codeword[39 + i], data, offset);
+    if (ec > 0) {
+        packHexbits(codeword, data, 16U);
+    }
 
     if ((ec == -1) || (ec >= 4)) {
         return false;
@@ -226,19 +237,18 @@ void RS634717::encode24169(uint8_t* data)
 
     uint8_t codeword[24U];
 
-    for (uint32_t i = 0U; i < 24U; i++) {
-        codeword[i] = 0x00U;
+    unpackHexbits(data, codeword, 16U);
 
-        uint32_t offset = 0U;
-        for (uint32_t j = 0U; j < 16U; j++, offset += 6U) {
-            uint8_t hexbit = Utils::bin2Hex(data, offset);
-            codeword[i] ^= gf6Mult(hexbit, ENCODE_MATRIX_24169[j][i]);
-        }
+    // the encode matrix is systematic, only the parity symbols need to be calculated
+    for (uint32_t i = 16U; i < 24U; i++) {
+        uint8_t parity = 0x00U;
+        for (uint32_t j = 0U; j < 16U; j++)
+            parity ^= GF6.mult[codeword[j]][ENCODE_MATRIX_24169[j][i]];
+
+        codeword[i] = parity;
     }
 
-    uint32_t offset = 0U;
-    for (uint32_t i = 0U; i < 24U; i++, offset += 6U)
-        Utils::hex2Bin(codeword[i], data, offset);
+    packHexbits(codeword, data, 24U);
 }
 
 /* Decode RS (36,20,17) FEC. */
@@ -247,19 +257,17 @@ bool RS634717::decode362017(uint8_t* data)
 {
     assert(data != nullptr);
 
-    std::vector<uint8_t> codeword(63, 0);
+    uint8_t codeword[36U];
 
-    uint32_t offset = 0U;
-    for (uint32_t i = 0U; i < 36U; i++, offset += 6)
-        codeword[27 + i] = Utils::bin2Hex(data, offset);
+    unpackHexbits(data, codeword, 36U);
 
-    int ec = rs634717.decode(codeword);
+    int ec = decode<16U>(codeword, 36U);
 #if DEBUG_RS
     LogDebug(LOG_HOST, "RS634717::decode362017(), errors = %d\n", ec);
 #endif
-    offset = 0U;
-    for (uint32_t i = 0U; i < 20U; i++, offset += 6)
-        Utils::hex2Bin(codeword[27 + i], data, offset);
+    if (ec > 0) {
+        packHexbits(codeword, data, 20U);
+    }
 
     if ((ec == -1) || (ec >= 8)) {
         return false;
@@ -276,42 +284,163 @@ void RS634717::encode362017(uint8_t* data)
 
     uint8_t codeword[36U];
 
-    for (uint32_t i = 0U; i < 36U; i++) {
-        codeword[i] = 0x00U;
+    unpackHexbits(data, codeword, 20U);
 
-        uint32_t offset = 0U;
-        for (uint32_t j = 0U; j < 20U; j++, offset += 6U) {
-            uint8_t hexbit = Utils::bin2Hex(data, offset);
-            codeword[i] ^= gf6Mult(hexbit, ENCODE_MATRIX_362017[j][i]);
-        }
+    // the encode matrix is systematic, only the parity symbols need to be calculated
+    for (uint32_t i = 20U; i < 36U; i++) {
+        uint8_t parity = 0x00U;
+        for (uint32_t j = 0U; j < 20U; j++)
+            parity ^= GF6.mult[codeword[j]][ENCODE_MATRIX_362017[j][i]];
+
+        codeword[i] = parity;
     }
 
-    uint32_t offset = 0U;
-    for (uint32_t i = 0U; i < 36U; i++, offset += 6U)
-        Utils::hex2Bin(codeword[i], data, offset);
+    packHexbits(codeword, data, 36U);
 }
 
 // ---------------------------------------------------------------------------
 //  Private Class Members
 // ---------------------------------------------------------------------------
 
-/* GF(2 ^ 6) multiply (for Reed-Solomon encoder). */
+/* Helper to decode a shortened RS (63,63 - NROOTS) codeword. */
 
-uint8_t RS634717::gf6Mult(uint8_t a, uint8_t b) const
+template <uint32_t NROOTS>
+int RS634717::decode(uint8_t* codeword, uint32_t length) const
 {
-    uint8_t p = 0x00U;
+    // form the syndromes; i.e. evaluate the codeword at the roots of g(x) (alpha ^ 1 .. alpha ^ NROOTS), the
+    // shortened symbols of the block are zero and do not contribute
+    // (symbol outer, root inner, so the syndromes are independent chains of table lookups)
+    uint8_t syn[NROOTS];
+    ::memset(syn, 0x00U, NROOTS);
+    for (uint32_t j = 0U; j < length; j++) {
+        for (uint32_t i = 0U; i < NROOTS; i++)
+            syn[i] = GF6.mult[GF6.alphaTo[i + 1U]][syn[i]] ^ codeword[j];
+    }
 
-    for (uint32_t i = 0U; i < 6U; i++) {
-        if ((b & 0x01U) == 0x01U)
-            p ^= a;
+    uint8_t synError = 0U;
+    for (uint32_t i = 0U; i < NROOTS; i++)
+        synError |= syn[i];
+
+    // if the syndrome is zero the codeword is valid and there are no errors to correct
+    if (synError == 0U)
+        return 0;
+
+    // Berlekamp-Massey algorithm to determine the error locator polynomial
+    uint8_t lambda[NROOTS + 1U], b[NROOTS + 1U], t[NROOTS + 1U];
+    ::memset(lambda, 0x00U, NROOTS + 1U);
+    lambda[0U] = 1U;
+    ::memcpy(b, lambda, NROOTS + 1U);
+
+    uint32_t el = 0U;
+    for (uint32_t r = 1U; r <= NROOTS; r++) {
+        // compute discrepancy at the r-th step
+        uint8_t discr = 0U;
+        for (uint32_t i = 0U; i < r; i++)
+            discr ^= GF6.mult[lambda[i]][syn[r - i - 1U]];
+
+        if (discr == 0U) {
+            // B(x) <-- x * B(x)
+            ::memmove(b + 1U, b, NROOTS);
+            b[0U] = 0U;
+            continue;
+        }
+
+        // T(x) <-- lambda(x) - discr * x * B(x)
+        t[0U] = lambda[0U];
+        for (uint32_t i = 0U; i < NROOTS; i++)
+            t[i + 1U] = lambda[i + 1U] ^ GF6.mult[discr][b[i]];
 
-        a <<= 1;
+        if (2U * el <= r - 1U) {
+            el = r - el;
+
+            // B(x) <-- inv(discr) * lambda(x)
+            const uint8_t* mult = GF6.mult[GF6.inv[discr]];
+            for (uint32_t i = 0U; i <= NROOTS; i++)
+                b[i] = mult[lambda[i]];
+        }
+        else {
+            // B(x) <-- x * B(x)
+            ::memmove(b + 1U, b, NROOTS);
+            b[0U] = 0U;
+        }
+
+        ::memcpy(lambda, t, NROOTS + 1U);
+    }
+
+    uint32_t degLambda = 0U;
+    for (uint32_t i = 0U; i <= NROOTS; i++) {
+        if (lambda[i] != 0U)
+            degLambda = i;
+    }
+
+    // find the roots of the error locator polynomial by Chien search; the transmitted symbols are
+    // searched first, the shortened symbols are only searched if roots are still missing (roots there
+    // are still counted, an uncorrectable codeword may decode to one with errors in the shortened symbols)
+    uint32_t loc[NROOTS];
+    uint32_t count = 0U;
+    uint32_t first = GF6_NN + 1U - length;
+    for (uint32_t pass = 0U; pass < 2U && count < degLambda; pass++) {
+        uint32_t start = (pass == 0U) ? first : 1U;
+        uint32_t end = (pass == 0U) ? GF6_NN : first - 1U;
+
+        // terms of lambda(alpha ^ start)
+        uint8_t term[NROOTS + 1U];
+        for (uint32_t j = 1U; j <= degLambda; j++)
+            term[j] = GF6.mult[lambda[j]][GF6.alphaTo[(start * j) % GF6_NN]];
+
+        for (uint32_t i = start; i <= end && count < degLambda; i++) {
+            uint8_t q = 1U;
+            for (uint32_t j = 1U; j <= degLambda; j++) {
+                q ^= term[j];
+                term[j] = GF6.mult[term[j]][GF6.alphaTo[j]];
+            }
+
+            // store the error location (an index into the 63 symbol block)
+            if (q == 0U)
+                loc[count++] = i - 1U;
+        }
+    }
+
+    // deg(lambda) unequal to number of roots => uncorrectable error detected
+    if (count != degLambda)
+        return -1;
+
+    // compute the error evaluator polynomial omega(x) = s(x) * lambda(x) (modulo x ^ NROOTS)
+    uint8_t omega[NROOTS];
+    for (uint32_t i = 0U; i < degLambda; i++) {
+        uint8_t tmp = 0U;
+        for (uint32_t j = 0U; j <= i; j++)
+            tmp ^= GF6.mult[syn[i - j]][lambda[j]];
+
+        omega[i] = tmp;
+    }
+
+    // compute the error values by Forney's algorithm, the first consecutive root is 1 so the error
+    // value is omega(inv(X(l))) / lambda_pr(inv(X(l)))
+    uint32_t pad = GF6_NN - length;
+    for (uint32_t j = 0U; j < count; j++) {
+        const uint8_t* mult = GF6.mult[GF6.alphaTo[loc[j] + 1U]];
+
+        uint8_t num = 0U, den = 0U, x = 1U;
+        for (uint32_t i = 0U; i < degLambda; i++) {
+            num ^= GF6.mult[omega[i]][x];
+
+            // lambda[i + 1] for i even is the formal derivative lambda_pr of lambda[i]
+            if ((i & 1U) == 0U)
+                den ^= GF6.mult[lambda[i + 1U]][x];
+
+            x = mult[x];
+        }
 
-        if ((a & 0x40U) == 0x40U)
-            a ^= 0x43U;            // primitive polynomial : x ^ 6 + x + 1
+        if (num == 0U)
+            continue;
+        if (den == 0U)
+            return -1;
 
-        b >>= 1;
+        // errors in the shortened symbols are counted but there is nothing to correct
+        if (loc[j] >= pad)
+            codeword[loc[j] - pad] ^= GF6.mult[num][GF6.inv[den]];
     }
 
-    return p;
+    return (int)count;
 }
@@ -5,7 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2016 Jonathan Naylor, G4KLX
- *  Copyright (C) 2017,2023 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2017,2023,2024 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -30,6 +30,10 @@ namespace edac
      *  Reed-Solomon (24,12,13), (24,16,9) and (36,20,17) forward
      *  error correction.
      * @ingroup edac
+     *
+     *  The three codes are shortened RS (63,51), (63,55) and (63,47) codes. Decoding only
+     *  evaluates the transmitted symbols of the shortened block, and GF(2 ^ 6) arithmetic is
+     *  done with precomputed log/antilog, multiplication and inverse tables.
      */
     class HOST_SW_API RS634717 {
     public:
@@ -80,12 +84,14 @@ namespace edac
 
     private:
         /**
-         * @brief GF(2 ^ 6) multiply (for Reed-Solomon encoder).
-         * @param a 
-         * @param b 
-         * @returns uint8_t 
+         * @brief Helper to decode a shortened RS (63,63 - NROOTS) codeword.
+         * @tparam NROOTS Number of parity symbols.
+         * @param codeword Codeword symbols to decode (the last symbols of the 63 symbol block).
+         * @param length Number of codeword symbols.
+         * @returns int Number of symbols corrected, or -1 if the codeword is uncorrectable.
          */
-        uint8_t gf6Mult(uint8_t a, uint8_t b) const;
+        template <uint32_t NROOTS>
+        int decode(uint8_t* codeword, uint32_t length) const;
     };
 } // namespace edac
 
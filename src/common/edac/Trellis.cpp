@@ -43,6 +43,36 @@ const uint8_t ENCODE_TABLE_12[] = {
     13U,  2U,  1U, 14U,
     9U,   6U,  5U, 10U };
 
+/** @brief Dibit pair for each constellation point. */
+const int8_t POINT_DIBITS[16U][2U] = {
+    { +1, -1 }, { -1, -1 }, { +3, -3 }, { -3, -3 },
+    { -3, -1 }, { +3, -1 }, { -1, -3 }, { +1, -3 },
+    { -3, +3 }, { +3, +3 }, { -1, +1 }, { +1, +1 },
+    { +1, +3 }, { -1, +3 }, { +3, +1 }, { -3, +1 } };
+
+/** @brief Constellation point for each dibit pair (indexed by (dibit + 3) / 2). */
+const uint8_t DIBITS_POINT[4U][4U] = {
+    { 3U, 4U, 15U,  8U },
+    { 6U, 1U, 10U, 13U },
+    { 7U, 0U, 11U, 12U },
+    { 2U, 5U, 14U,  9U } };
+
+/** @brief Count of differing bits between two dibits (indexed by (dibit + 3) / 2). */
+const uint8_t DIBIT_BIT_DISTANCE[4U][4U] = {
+    { 0U, 1U, 2U, 1U },
+    { 1U, 0U, 1U, 2U },
+    { 2U, 1U, 0U, 1U },
+    { 1U, 2U, 1U, 0U } };
+
+/** @brief Branch metric of a single bit error. */
+const uint32_t METRIC_SCALE = 4U;
+/** @brief Soft decision branch metric per unit of squared deviation distance. */
+const float SOFT_METRIC_SCALE = 16.0F;
+/** @brief Maximum path metric of a decodable 3/4 rate codeword. */
+const uint32_t MAX_PATH_METRIC_34 = 8U * METRIC_SCALE;
+/** @brief Maximum path metric of a decodable 1/2 rate codeword. */
+const uint32_t MAX_PATH_METRIC_12 = 16U * METRIC_SCALE;
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -65,30 +95,50 @@ bool Trellis::decode34(const uint8_t* data, uint8_t* payload, bool skipSymbols)
     int8_t dibits[98U];
     deinterleave(data, dibits, skipSymbols);
 
-    uint8_t points[49U];
-    dibitsToPoints(dibits, points);
-
-    // Check the original code
+    // an error free codeword is simply traced through the Trellis, only run the full
+    // decoder when that fails
     uint8_t tribits[49U];
-    uint32_t failPos = checkCode34(points, tribits);
-    if (failPos == 999U) {
-        tribitsToBits(tribits, payload);
-        return true;
+    if (!trace(dibits, ENCODE_TABLE_34, 8U, tribits)) {
+        uint16_t metrics[49U * 16U];
+        hardMetrics(dibits, metrics);
+
+        uint32_t metric = viterbi(metrics, ENCODE_TABLE_34, 8U, tribits);
+#if DEBUG_TRELLIS
+        ::LogDebug(LOG_HOST, "Trellis::decode34() metric = %u", metric);
+#endif
+        if (metric > MAX_PATH_METRIC_34)
+            return false;
     }
 
-    uint8_t savePoints[49U];
-    for (uint32_t i = 0U; i < 49U; i++)
-        savePoints[i] = points[i];
+    tribitsToBits(tribits, payload);
+    return true;
+}
 
-    bool ret = fixCode34(points, failPos, payload);
-    if (ret)
-        return true;
+/* Decodes 3/4 rate Trellis using soft symbol values. */
 
-    if (failPos == 0U)
+bool Trellis::decode34(const float* symbols, uint8_t* payload)
+{
+    assert(symbols != nullptr);
+    assert(payload != nullptr);
+
+    int8_t dibits[98U];
+    uint16_t metrics[49U * 16U];
+    softMetrics(symbols, metrics, dibits);
+
+    uint8_t tribits[49U];
+    viterbi(metrics, ENCODE_TABLE_34, 8U, tribits);
+
+    // the soft path metric includes the noise on every symbol, so the decoded path is validated
+    // against the hard decision symbols instead
+    uint32_t metric = pathMetric(dibits, ENCODE_TABLE_34, 8U, tribits);
+#if DEBUG_TRELLIS
+    ::LogDebug(LOG_HOST, "Trellis::decode34() soft metric = %u", metric);
+#endif
+    if (metric > MAX_PATH_METRIC_34)
         return false;
 
-    // Backtrack one place for a last go
-    return fixCode34(savePoints, failPos - 1U, payload);
+    tribitsToBits(tribits, payload);
+    return true;
 }
 
 /* Encodes 3/4 rate Trellis. */
@@ -128,30 +178,50 @@ bool Trellis::decode12(const uint8_t* data, uint8_t* payload)
     int8_t dibits[98U];
     deinterleave(data, dibits);
 
-    uint8_t points[49U];
-    dibitsToPoints(dibits, points);
-
-    // Check the original code
+    // an error free codeword is simply traced through the Trellis, only run the full
+    // decoder when that fails
     uint8_t bits[49U];
-    uint32_t failPos = checkCode12(points, bits);
-    if (failPos == 999U) {
-        dibitsToBits(bits, payload);
-        return true;
+    if (!trace(dibits, ENCODE_TABLE_12, 4U, bits)) {
+        uint16_t metrics[49U * 16U];
+        hardMetrics(dibits, metrics);
+
+        uint32_t metric = viterbi(metrics, ENCODE_TABLE_12, 4U, bits);
+#if DEBUG_TRELLIS
+        ::LogDebug(LOG_HOST, "Trellis::decode12() metric = %u", metric);
+#endif
+        if (metric > MAX_PATH_METRIC_12)
+            return false;
     }
 
-    uint8_t savePoints[49U];
-    for (uint32_t i = 0U; i < 49U; i++)
-        savePoints[i] = points[i];
+    dibitsToBits(bits, payload);
+    return true;
+}
+
+/* Decodes 1/2 rate Trellis using soft symbol values. */
+
+bool Trellis::decode12(const float* symbols, uint8_t* payload)
+{
+    assert(symbols != nullptr);
+    assert(payload != nullptr);
 
-    bool ret = fixCode12(points, failPos, payload);
-    if (ret)
-        return true;
+    int8_t dibits[98U];
+    uint16_t metrics[49U * 16U];
+    softMetrics(symbols, metrics, dibits);
 
-    if (failPos == 0U)
+    uint8_t bits[49U];
+    viterbi(metrics, ENCODE_TABLE_12, 4U, bits);
+
+    // the soft path metric includes the noise on every symbol, so the decoded path is validated
+    // against the hard decision symbols instead
+    uint32_t metric = pathMetric(dibits, ENCODE_TABLE_12, 4U, bits);
+#if DEBUG_TRELLIS
+    ::LogDebug(LOG_HOST, "Trellis::decode12() soft metric = %u", metric);
+#endif
+    if (metric > MAX_PATH_METRIC_12)
         return false;
 
-    // Backtrack one place for a last go
-    return fixCode12(savePoints, failPos - 1U, payload);
+    dibitsToBits(bits, payload);
+    return true;
 }
 
 /* Encodes 1/2 rate Trellis. */
@@ -250,46 +320,6 @@ void Trellis::interleave(const int8_t* dibits, uint8_t* data, bool skipSymbols)
     }
 }
 
-/* Helper to map dibits to 4FSK constellation points. */
-
-void Trellis::dibitsToPoints(const int8_t* dibits, uint8_t* points) const
-{
-    for (uint32_t i = 0U; i < 49U; i++) {
-        if (dibits[i * 2U + 0U] == +1 && dibits[i * 2U + 1U] == -1)
-            points[i] = 0U;
-        else if (dibits[i * 2U + 0U] == -1 && dibits[i * 2U + 1U] == -1)
-            points[i] = 1U;
-        else if (dibits[i * 2U + 0U] == +3 && dibits[i * 2U + 1U] == -3)
-            points[i] = 2U;
-        else if (dibits[i * 2U + 0U] == -3 && dibits[i * 2U + 1U] == -3)
-            points[i] = 3U;
-        else if (dibits[i * 2U + 0U] == -3 && dibits[i * 2U + 1U] == -1)
-            points[i] = 4U;
-        else if (dibits[i * 2U + 0U] == +3 && dibits[i * 2U + 1U] == -1)
-            points[i] = 5U;
-        else if (dibits[i * 2U + 0U] == -1 && dibits[i * 2U + 1U] == -3)
-            points[i] = 6U;
-        else if (dibits[i * 2U + 0U] == +1 && dibits[i * 2U + 1U] == -3)
-            points[i] = 7U;
-        else if (dibits[i * 2U + 0U] == -3 && dibits[i * 2U + 1U] == +3)
-            points[i] = 8U;
-        else if (dibits[i * 2U + 0U] == +3 && dibits[i * 2U + 1U] == +3)
-            points[i] = 9U;
-        else if (dibits[i * 2U + 0U] == -1 && dibits[i * 2U + 1U] == +1)
-            points[i] = 10U;
-        else if (dibits[i * 2U + 0U] == +1 && dibits[i * 2U + 1U] == +1)
-            points[i] = 11U;
-        else if (dibits[i * 2U + 0U] == +1 && dibits[i * 2U + 1U] == +3)
-            points[i] = 12U;
-        else if (dibits[i * 2U + 0U] == -1 && dibits[i * 2U + 1U] == +3)
-            points[i] = 13U;
-        else if (dibits[i * 2U + 0U] == +3 && dibits[i * 2U + 1U] == +1)
-            points[i] = 14U;
-        else if (dibits[i * 2U + 0U] == -3 && dibits[i * 2U + 1U] == +1)
-            points[i] = 15U;
-    }
-}
-
 /* Helper to map 4FSK constellation points to dibits. */
 
 void Trellis::pointsToDibits(const uint8_t* points, int8_t* dibits) const
@@ -448,133 +478,143 @@ void Trellis::dibitsToBits(const uint8_t* dibits, uint8_t* payload) const
     }
 }
 
-/* Helper to fix errors in Trellis coding. */
+/* Helper to trace an error free path through the Trellis. */
 
-bool Trellis::fixCode34(uint8_t* points, uint32_t failPos, uint8_t* payload) const
+bool Trellis::trace(const int8_t* dibits, const uint8_t* encodeTable, uint32_t states, uint8_t* inputs) const
 {
-#if DEBUG_TRELLIS
-    ::LogDebug(LOG_HOST, "Trellis::fixCode34() failPos = %u, val = %01X", failPos, points[failPos]);
-#endif
-    for (unsigned j = 0U; j < 20U; j++) {
-        uint32_t bestPos = 0U;
-        uint32_t bestVal = 0U;
-
-        for (uint32_t i = 0U; i < 16U; i++) {
-            points[failPos] = i;
-
-            uint8_t tribits[49U];
-            uint32_t pos = checkCode34(points, tribits);
-            if (pos == 999U) {
-#if DEBUG_TRELLIS
-                ::LogDebug(LOG_HOST, "Trellis::fixCode34() fixed, failPos = %u, pos = %u, val = %01X", failPos, bestPos, bestVal);
-#endif
-                tribitsToBits(tribits, payload);
-                return true;
-            }
-
-            if (pos > bestPos) {
-                bestPos = pos;
-                bestVal = i;
-            }
-        }
-
-        points[failPos] = bestVal;
-        failPos = bestPos;
+    uint8_t state = 0U;
+    for (uint32_t i = 0U; i < 49U; i++) {
+        uint8_t point = DIBITS_POINT[(dibits[i * 2U + 0U] + 3) / 2][(dibits[i * 2U + 1U] + 3) / 2];
+        const uint8_t* transitions = encodeTable + (state * states);
+
+        uint32_t j = 0U;
+        while (j < states && transitions[j] != point)
+            j++;
+        if (j == states)
+            return false;
+
+        // the next state is the input value
+        state = (uint8_t)j;
+        inputs[i] = state;
     }
 
-    return false;
+    return state == 0U;
 }
 
-/* Helper to detect errors in Trellis coding. */
+/* Helper to calculate the branch metrics for hard decision dibits. */
 
-uint32_t Trellis::checkCode34(const uint8_t* points, uint8_t* tribits) const
+void Trellis::hardMetrics(const int8_t* dibits, uint16_t* metrics) const
 {
-    uint8_t state = 0U;
-
     for (uint32_t i = 0U; i < 49U; i++) {
-        tribits[i] = 9U;
+        const uint8_t* rx0 = DIBIT_BIT_DISTANCE[(dibits[i * 2U + 0U] + 3) / 2];
+        const uint8_t* rx1 = DIBIT_BIT_DISTANCE[(dibits[i * 2U + 1U] + 3) / 2];
 
-        for (uint32_t j = 0U; j < 8U; j++) {
-            if (points[i] == ENCODE_TABLE_34[state * 8U + j]) {
-                tribits[i] = j;
-                break;
-            }
+        for (uint32_t p = 0U; p < 16U; p++) {
+            uint32_t bits = rx0[(POINT_DIBITS[p][0U] + 3) / 2] + rx1[(POINT_DIBITS[p][1U] + 3) / 2];
+            metrics[i * 16U + p] = (uint16_t)(bits * METRIC_SCALE);
         }
-
-        if (tribits[i] == 9U)
-            return i;
-
-        state = tribits[i];
     }
-
-    if (tribits[48U] != 0U)
-        return 48U;
-
-    return 999U;
 }
 
+/* Helper to calculate the branch metrics for soft symbol values. */
 
-/* Helper to fix errors in Trellis coding. */
-
-bool Trellis::fixCode12(uint8_t* points, uint32_t failPos, uint8_t* payload) const
+void Trellis::softMetrics(const float* symbols, uint16_t* metrics, int8_t* dibits) const
 {
-#if DEBUG_TRELLIS
-    ::LogDebug(LOG_HOST, "Trellis::fixCode12() failPos = %u, val = %01X", failPos, points[failPos]);
-#endif
-    for (unsigned j = 0U; j < 20U; j++) {
-        uint32_t bestPos = 0U;
-        uint32_t bestVal = 0U;
+    float soft[98U];
+    for (uint32_t i = 0U; i < 98U; i++) {
+        uint32_t n = INTERLEAVE_TABLE[i];
+        soft[n] = symbols[i];
+
+        // slice to the nearest deviation level
+        if (symbols[i] >= 2.0F)
+            dibits[n] = +3;
+        else if (symbols[i] >= 0.0F)
+            dibits[n] = +1;
+        else if (symbols[i] >= -2.0F)
+            dibits[n] = -1;
+        else
+            dibits[n] = -3;
+    }
 
-        for (uint32_t i = 0U; i < 16U; i++) {
-            points[failPos] = i;
+    for (uint32_t i = 0U; i < 49U; i++) {
+        float rx0 = soft[i * 2U + 0U];
+        float rx1 = soft[i * 2U + 1U];
 
-            uint8_t dibits[49U];
-            uint32_t pos = checkCode12(points, dibits);
-            if (pos == 999U) {
-#if DEBUG_TRELLIS
-                ::LogDebug(LOG_HOST, "Trellis::fixCode12() fixed, failPos = %u, pos = %u, val = %01X", failPos, bestPos, bestVal);
-#endif
-                dibitsToBits(dibits, payload);
-                return true;
-            }
+        for (uint32_t p = 0U; p < 16U; p++) {
+            float d0 = rx0 - POINT_DIBITS[p][0U];
+            float d1 = rx1 - POINT_DIBITS[p][1U];
 
-            if (pos > bestPos) {
-                bestPos = pos;
-                bestVal = i;
-            }
+            float metric = ((d0 * d0) + (d1 * d1)) * SOFT_METRIC_SCALE + 0.5F;
+            metrics[i * 16U + p] = (metric > 65535.0F) ? 65535U : (uint16_t)metric;
         }
+    }
+}
 
-        points[failPos] = bestVal;
-        failPos = bestPos;
+/* Helper to calculate the hard decision metric of a decoded path. */
+
+uint32_t Trellis::pathMetric(const int8_t* dibits, const uint8_t* encodeTable, uint32_t states, const uint8_t* inputs) const
+{
+    uint32_t metric = 0U;
+    uint8_t state = 0U;
+    for (uint32_t i = 0U; i < 49U; i++) {
+        uint8_t point = encodeTable[state * states + inputs[i]];
+        state = inputs[i];
+
+        const uint8_t* rx0 = DIBIT_BIT_DISTANCE[(dibits[i * 2U + 0U] + 3) / 2];
+        const uint8_t* rx1 = DIBIT_BIT_DISTANCE[(dibits[i * 2U + 1U] + 3) / 2];
+        metric += (rx0[(POINT_DIBITS[point][0U] + 3) / 2] + rx1[(POINT_DIBITS[point][1U] + 3) / 2]) * METRIC_SCALE;
     }
 
-    return false;
+    return metric;
 }
 
-/* Helper to detect errors in Trellis coding. */
+/* Helper to find the most likely path through the Trellis. */
 
-uint32_t Trellis::checkCode12(const uint8_t* points, uint8_t* dibits) const
+uint32_t Trellis::viterbi(const uint16_t* metrics, const uint8_t* encodeTable, uint32_t states, uint8_t* inputs) const
 {
-    uint8_t state = 0U;
+    // large enough that an unreachable state never wins, small enough that it cannot overflow
+    const uint32_t INVALID_METRIC = 0x00FFFFFFU;
 
-    for (uint32_t i = 0U; i < 49U; i++) {
-        dibits[i] = 5U;
+    // the encoder starts in state 0, and because the next state is the input value the survivor
+    // for each state is simply the previous state
+    uint32_t pathMetric[8U];
+    uint8_t survivor[49U][8U];
+    for (uint32_t s = 0U; s < 8U; s++)
+        pathMetric[s] = INVALID_METRIC;
+    pathMetric[0U] = 0U;
 
-        for (uint32_t j = 0U; j < 4U; j++) {
-            if (points[i] == ENCODE_TABLE_12[state * 4U + j]) {
-                dibits[i] = j;
-                break;
+    for (uint32_t i = 0U; i < 49U; i++) {
+        const uint16_t* branch = metrics + (i * 16U);
+
+        // the last symbol is always encoded from a zero input, flushing the encoder back to state 0
+        uint32_t next = (i == 48U) ? 1U : states;
+
+        uint32_t newMetric[8U];
+        for (uint32_t j = 0U; j < states; j++) {
+            newMetric[j] = INVALID_METRIC;
+            survivor[i][j] = 0U;
+            if (j >= next)
+                continue;
+
+            for (uint32_t s = 0U; s < states; s++) {
+                uint32_t metric = pathMetric[s] + branch[encodeTable[s * states + j]];
+                if (metric < newMetric[j]) {
+                    newMetric[j] = metric;
+                    survivor[i][j] = s;
+                }
             }
         }
 
-        if (dibits[i] == 5U)
-            return i;
-
-        state = dibits[i];
+        for (uint32_t j = 0U; j < states; j++)
+            pathMetric[j] = newMetric[j];
     }
 
-    if (dibits[48U] != 0U)
-        return 48U;
+    // trace back from the final state
+    uint8_t state = 0U;
+    for (int i = 48; i >= 0; i--) {
+        inputs[i] = state;
+        state = survivor[i][state];
+    }
 
-    return 999U;
+    return pathMetric[0U];
 }
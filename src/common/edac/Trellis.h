@@ -48,6 +48,13 @@ namespace edac
          * @returns bool True, if Trellis decoded, otherwise false.
          */
         bool decode34(const uint8_t* data, uint8_t* payload, bool skipSymbols = false);
+        /**
+         * @brief Decodes 3/4 rate Trellis using soft symbol values.
+         * @param[in] symbols Soft symbol values (98 symbols, in transmitted order, nominally +3, +1, -1 or -3).
+         * @param[out] payload Output bytes.
+         * @returns bool True, if Trellis decoded, otherwise false.
+         */
+        bool decode34(const float* symbols, uint8_t* payload);
         /**
          * @brief Encodes 3/4 rate Trellis.
          * @param[in] payload Input bytes.
@@ -63,6 +70,13 @@ namespace edac
          * @returns bool True, if Trellis decoded, otherwise false.
          */
         bool decode12(const uint8_t* data, uint8_t* payload);
+        /**
+         * @brief Decodes 1/2 rate Trellis using soft symbol values.
+         * @param[in] symbols Soft symbol values (98 symbols, in transmitted order, nominally +3, +1, -1 or -3).
+         * @param[out] payload Output bytes.
+         * @returns bool True, if Trellis decoded, otherwise false.
+         */
+        bool decode12(const float* symbols, uint8_t* payload);
         /**
          * @brief Encodes 1/2 rate Trellis.
          * @param[in] payload Input bytes.
@@ -85,12 +99,6 @@ namespace edac
          * @param skipSymbols Flag indicating symbols should be skipped (this is used for DMR).
          */
         void interleave(const int8_t* dibits, uint8_t* out, bool skipSymbols = false) const;
-        /**
-         * @brief Helper to map dibits to trellis constellation points.
-         * @param[in] dibits Dibits.
-         * @param[out] points Trellis constellation points.
-         */
-        void dibitsToPoints(const int8_t* dibits, uint8_t* points) const;
         /**
          * @brief Helper to map trellis constellation points to dibits.
          * @param[in] points Trellis Constellation points.
@@ -123,36 +131,45 @@ namespace edac
         void dibitsToBits(const uint8_t* dibits, uint8_t* payload) const;
 
         /**
-         * @brief Helper to fix errors in Trellis coding.
-         * @param points Trellis constellation points.
-         * @param failPos Failure position.
-         * @param payload Byte payload.
-         * @returns bool True, if error corrected, otherwise false.
+         * @brief Helper to trace an error free path through the Trellis.
+         * @param[in] dibits Deinterleaved dibits.
+         * @param[in] encodeTable Trellis encoder state transition table.
+         * @param states Number of encoder states (8 for 3/4 rate, 4 for 1/2 rate).
+         * @param[out] inputs Decoded encoder inputs (tribits or dibits).
+         * @returns bool True, if the dibits are a valid codeword, otherwise false.
          */
-        bool fixCode34(uint8_t* points, uint32_t failPos, uint8_t* payload) const;
+        bool trace(const int8_t* dibits, const uint8_t* encodeTable, uint32_t states, uint8_t* inputs) const;
         /**
-         * @brief Helper to detect errors in Trellis coding.
-         * @param points Trellis constellation points.
-         * @param tribits Tribits.
-         * @returns uint32_t Position.
+         * @brief Helper to calculate the branch metrics for hard decision dibits.
+         * @param[in] dibits Deinterleaved dibits.
+         * @param[out] metrics Branch metrics (16 constellation points for each of the 49 symbols).
          */
-        uint32_t checkCode34(const uint8_t* points, uint8_t* tribits) const;
-
+        void hardMetrics(const int8_t* dibits, uint16_t* metrics) const;
+        /**
+         * @brief Helper to calculate the branch metrics for soft symbol values.
+         * @param[in] symbols Soft symbol values (98 symbols, in transmitted order).
+         * @param[out] metrics Branch metrics (16 constellation points for each of the 49 symbols).
+         * @param[out] dibits Deinterleaved hard decision dibits.
+         */
+        void softMetrics(const float* symbols, uint16_t* metrics, int8_t* dibits) const;
         /**
-         * @brief Helper to fix errors in Trellis coding.
-         * @param points Trelli constellation points.
-         * @param failPos Failure position.
-         * @param payload Byte payload.
-         * @returns bool True, if error corrected, otherwise false.
+         * @brief Helper to calculate the hard decision metric of a decoded path.
+         * @param[in] dibits Deinterleaved dibits.
+         * @param[in] encodeTable Trellis encoder state transition table.
+         * @param states Number of encoder states (8 for 3/4 rate, 4 for 1/2 rate).
+         * @param[in] inputs Decoded encoder inputs (tribits or dibits).
+         * @returns uint32_t Path metric of the decoded path.
          */
-        bool fixCode12(uint8_t* points, uint32_t failPos, uint8_t* payload) const;
+        uint32_t pathMetric(const int8_t* dibits, const uint8_t* encodeTable, uint32_t states, const uint8_t* inputs) const;
         /**
-         * @brief Helper to detect errors in Trellis coding.
-         * @param points Trelli constellation points.
-         * @param dibits Dibits.
-         * @returns uint32_t Position.
+         * @brief Helper to find the most likely path through the Trellis.
+         * @param[in] metrics Branch metrics.
+         * @param[in] encodeTable Trellis encoder state transition table.
+         * @param states Number of encoder states (8 for 3/4 rate, 4 for 1/2 rate).
+         * @param[out] inputs Decoded encoder inputs (tribits or dibits).
+         * @returns uint32_t Path metric of the decoded path.
          */
-        uint32_t checkCode12(const uint8_t* points, uint8_t* dibits) const;
+        uint32_t viterbi(const uint16_t* metrics, const uint8_t* encodeTable, uint32_t states, uint8_t* inputs) const;
     };
 } // namespace edac
 
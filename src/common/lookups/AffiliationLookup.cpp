@@ -37,6 +37,8 @@ AffiliationLookup::AffiliationLookup(const std::string name, ChannelLookup* chan
     m_netGrantedTable(),
     m_grantTimers(),
     m_releaseGrant(nullptr),
+    m_unitDereg(nullptr),
+    m_change(nullptr),
     m_name(),
     m_chLookup(channelLookup),
     m_disableUnitRegTimeout(false),
@@ -76,6 +78,10 @@ void AffiliationLookup::unitReg(uint32_t srcId)
         LogMessage(LOG_HOST, "%s, unit registration, srcId = %u",
             m_name.c_str(), srcId);
     }
+
+    if (m_change != nullptr) {
+        m_change(AFF_CHANGE::UNIT_REG, srcId, 0U, 0U);
+    }
 }
 
 /* Helper to group unaffiliate a source ID. */
@@ -108,6 +114,10 @@ bool AffiliationLookup::unitDereg(uint32_t srcId, bool automatic)
         if (m_unitDereg != nullptr) {
             m_unitDereg(srcId, automatic);
         }
+
+        if (m_change != nullptr) {
+            m_change(AFF_CHANGE::UNIT_DEREG, srcId, 0U, 0U);
+        }
     }
 
     return ret;
@@ -190,6 +200,10 @@ void AffiliationLookup::groupAff(uint32_t srcId, uint32_t dstId)
             LogMessage(LOG_HOST, "%s, group affiliation, srcId = %u, dstId = %u",
                 m_name.c_str(), srcId, dstId);
         }
+
+        if (m_change != nullptr) {
+            m_change(AFF_CHANGE::GROUP_AFF, srcId, dstId, 0U);
+        }
     }
 }
 
@@ -210,9 +224,13 @@ bool AffiliationLookup::groupUnaff(uint32_t srcId)
 
     // remove dynamic affiliation table entry
     try {
-        uint32_t entry = m_grpAffTable.at(srcId); // this value will get discarded
-        (void)entry;                              // but some variants of C++ mark the unordered_map<>::at as nodiscard
+        uint32_t dstId = m_grpAffTable.at(srcId);
         m_grpAffTable.erase(srcId);
+
+        if (m_change != nullptr) {
+            m_change(AFF_CHANGE::GROUP_UNAFF, srcId, dstId, 0U);
+        }
+
         return true;
     }
     catch (...) {
@@ -315,6 +333,10 @@ bool AffiliationLookup::grantCh(uint32_t dstId, uint32_t srcId, uint32_t grantTi
             m_name.c_str(), chNo, dstId, srcId, grp);
     }
 
+    if (m_change != nullptr) {
+        m_change(AFF_CHANGE::GRANT, srcId, dstId, chNo);
+    }
+
     return true;
 }
 
@@ -369,6 +391,10 @@ bool AffiliationLookup::releaseGrant(uint32_t dstId, bool releaseAll)
             m_releaseGrant(chNo, dstId, 0U);
         }
 
+        if (m_change != nullptr) {
+            m_change(AFF_CHANGE::RELEASE, m_grantSrcIdTable[dstId], dstId, chNo);
+        }
+
         m_grantChTable.erase(dstId);
         m_grantSrcIdTable.erase(dstId);
         m_uuGrantedTable.erase(dstId);
@@ -547,3 +573,29 @@ void AffiliationLookup::clock(uint32_t ms)
         }
     }
 }
+
+// ---------------------------------------------------------------------------
+//  Static Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to convert a change type to a string. */
+
+const char* AffiliationLookup::changeToString(AFF_CHANGE::ENUM change)
+{
+    switch (change) {
+    case AFF_CHANGE::UNIT_REG:
+        return "unit-reg";
+    case AFF_CHANGE::UNIT_DEREG:
+        return "unit-dereg";
+    case AFF_CHANGE::GROUP_AFF:
+        return "group-aff";
+    case AFF_CHANGE::GROUP_UNAFF:
+        return "group-unaff";
+    case AFF_CHANGE::GRANT:
+        return "grant";
+    case AFF_CHANGE::RELEASE:
+        return "release";
+    default:
+        return "unknown";
+    }
+}
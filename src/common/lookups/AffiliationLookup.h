@@ -32,6 +32,25 @@
 
 namespace lookups
 {
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Unit Registration, Affiliation and Grant Changes
+     * @ingroup lookups_aff
+     */
+    namespace AFF_CHANGE {
+        enum ENUM : uint8_t {
+            UNIT_REG = 0x00U,                       //! Unit Registration
+            UNIT_DEREG = 0x01U,                     //! Unit Deregistration
+            GROUP_AFF = 0x02U,                      //! Group Affiliation
+            GROUP_UNAFF = 0x03U,                    //! Group Unaffiliation
+            GRANT = 0x04U,                          //! Channel Grant
+            RELEASE = 0x05U                         //! Channel Grant Release
+        };
+    };
+
     // ---------------------------------------------------------------------------
     //  Class Declaration
     // ---------------------------------------------------------------------------
@@ -267,6 +286,19 @@ namespace lookups
          * @param callback Unit deregistration function callback.
          */
         void setUnitDeregCallback(std::function<void(uint32_t, bool)>&& callback) { m_unitDereg = callback; }
+        /**
+         * @brief Helper to set the change callback. This is invoked for every unit registration, affiliation
+         *  and grant change, and is intended for reporting (i.e. REST API event streams).
+         * @param callback Change function callback.
+         */
+        void setChangeCallback(std::function<void(AFF_CHANGE::ENUM, uint32_t, uint32_t, uint32_t)>&& callback) { m_change = callback; }
+
+        /**
+         * @brief Helper to convert a change type to a string.
+         * @param change Change type.
+         * @returns const char* String representation of the change type.
+         */
+        static const char* changeToString(AFF_CHANGE::ENUM change);
 
     protected:
         uint8_t m_rfGrantChCnt;
@@ -285,6 +317,8 @@ namespace lookups
         std::function<void(uint32_t, uint32_t, uint8_t)> m_releaseGrant;
         //                 srcId     auto
         std::function<void(uint32_t, bool)> m_unitDereg;
+        //                 change           srcId     dstId     chNo
+        std::function<void(AFF_CHANGE::ENUM, uint32_t, uint32_t, uint32_t)> m_change;
 
         std::string m_name;
         ChannelLookup* m_chLookup;
@@ -30,7 +30,8 @@ std::mutex IdenTableLookup::m_mutex;
 
 /* Initializes a new instance of the IdenTableLookup class. */
 
-IdenTableLookup::IdenTableLookup(const std::string& filename, uint32_t reloadTime) : LookupTable(filename, reloadTime)
+IdenTableLookup::IdenTableLookup(const std::string& filename, uint32_t reloadTime) : LookupTable(filename, reloadTime),
+    m_generation(0U)
 {
     /* stub */
 }
@@ -41,6 +42,7 @@ void IdenTableLookup::clear()
 {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_table.clear();
+    m_generation++;
 }
 
 /* Finds a table entry in this lookup table. */
@@ -155,6 +157,8 @@ bool IdenTableLookup::load()
 
     file.close();
 
+    m_generation++;
+
     size_t size = m_table.size();
     if (size == 0U)
         return false;
@@ -24,6 +24,7 @@
 #include "common/Defines.h"
 #include "common/lookups/LookupTable.h"
 
+#include <atomic>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -145,6 +146,12 @@ namespace lookups
          */
         std::vector<IdenTable> list();
 
+        /**
+         * @brief Gets the generation of the lookup table, incremented every time the table is cleared or (re)loaded.
+         * @returns uint32_t Lookup table generation.
+         */
+        uint32_t generation() const { return m_generation.load(); }
+
     protected:
         /**
          * @brief Loads the table from the passed lookup table file.
@@ -160,6 +167,8 @@ namespace lookups
 
     private:
         static std::mutex m_mutex;
+
+        std::atomic<uint32_t> m_generation;
     };
 } // namespace lookups
 
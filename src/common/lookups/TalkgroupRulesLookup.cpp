@@ -18,6 +18,163 @@ using namespace lookups;
 #include <string>
 #include <vector>
 
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Event-driven YAML handler that loads the "groupVoice" rules list directly into
+ *  group voice blocks; only a single rule is held as a YAML node tree at any time.
+ */
+class GroupVoiceRulesHandler : public yaml::EventHandler {
+public:
+    /**
+     * @brief Initializes a new instance of the GroupVoiceRulesHandler class.
+     * @param groupVoice List of group voice blocks to populate.
+     */
+    GroupVoiceRulesHandler(std::vector<TalkgroupRuleGroupVoice>& groupVoice) :
+        m_groupVoice(groupVoice),
+        m_entry(),
+        m_builder(m_entry),
+        m_depth(0U),
+        m_entryDepth(0U),
+        m_groupVoiceKey(false),
+        m_inGroupVoice(false)
+    {
+        /* stub */
+    }
+
+    /**
+     * @brief Called at the start of a map.
+     */
+    void mapStart() override
+    {
+        if (m_entryDepth == 0U && isEntryStart()) {
+            m_entryDepth = m_depth + 1U;
+        }
+
+        start();
+        if (m_entryDepth > 0U)
+            m_builder.mapStart();
+    }
+    /**
+     * @brief Called at the end of a map.
+     */
+    void mapEnd() override
+    {
+        if (m_entryDepth > 0U)
+            m_builder.mapEnd();
+        end();
+    }
+    /**
+     * @brief Called for each map key.
+     * @param key Key name.
+     */
+    void key(const std::string& key) override
+    {
+        if (m_entryDepth > 0U) {
+            m_builder.key(key);
+            return;
+        }
+
+        m_groupVoiceKey = (m_depth == 1U && key == "groupVoice");
+    }
+
+    /**
+     * @brief Called at the start of a sequence.
+     */
+    void sequenceStart() override
+    {
+        if (m_entryDepth == 0U && m_depth == 1U && m_groupVoiceKey) {
+            m_inGroupVoice = true;
+        }
+
+        start();
+        if (m_entryDepth > 0U)
+            m_builder.sequenceStart();
+    }
+    /**
+     * @brief Called at the end of a sequence.
+     */
+    void sequenceEnd() override
+    {
+        if (m_entryDepth > 0U)
+            m_builder.sequenceEnd();
+        else if (m_depth == 2U)
+            m_inGroupVoice = false;
+        end();
+    }
+
+    /**
+     * @brief Called for each scalar value.
+     * @param value Scalar value.
+     */
+    void scalar(const std::string& value) override
+    {
+        if (m_entryDepth > 0U) {
+            m_builder.scalar(value);
+            return;
+        }
+
+        // a scalar entry in the list is an invalid rule; but is still added
+        if (isEntryStart()) {
+            m_entry.clear();
+            m_groupVoice.push_back(TalkgroupRuleGroupVoice(m_entry));
+        }
+    }
+    /**
+     * @brief Called for a value that has no data.
+     */
+    void none() override
+    {
+        if (m_entryDepth > 0U) {
+            m_builder.none();
+            return;
+        }
+
+        // an empty entry in the list is an invalid rule; but is still added
+        if (isEntryStart()) {
+            m_entry.clear();
+            m_groupVoice.push_back(TalkgroupRuleGroupVoice(m_entry));
+        }
+    }
+
+private:
+    std::vector<TalkgroupRuleGroupVoice>& m_groupVoice;
+
+    yaml::Node m_entry;
+    yaml::NodeBuilder m_builder;
+
+    uint32_t m_depth;
+    uint32_t m_entryDepth;
+    bool m_groupVoiceKey;
+    bool m_inGroupVoice;
+
+    /**
+     * @brief Helper to determine if the next value is a "groupVoice" list entry.
+     * @returns bool True, if the next value is a list entry, otherwise false.
+     */
+    bool isEntryStart() const { return m_inGroupVoice && m_depth == 2U; }
+
+    /**
+     * @brief Helper to enter a map or sequence.
+     */
+    void start() { m_depth++; }
+    /**
+     * @brief Helper to leave a map or sequence.
+     */
+    void end()
+    {
+        if (m_entryDepth > 0U && m_depth == m_entryDepth) {
+            m_groupVoice.push_back(TalkgroupRuleGroupVoice(m_entry));
+            m_entry.clear();
+            m_entryDepth = 0U;
+        }
+
+        m_depth--;
+    }
+};
+
 // ---------------------------------------------------------------------------
 //  Static Class Members
 // ---------------------------------------------------------------------------
@@ -33,7 +190,6 @@ std::mutex TalkgroupRulesLookup::m_mutex;
 TalkgroupRulesLookup::TalkgroupRulesLookup(const std::string& filename, uint32_t reloadTime, bool acl) : Thread(),
     m_rulesFile(filename),
     m_reloadTime(reloadTime),
-    m_rules(),
     m_acl(acl),
     m_groupHangTime(5U),
     m_sendTalkgroups(false),
@@ -276,8 +432,10 @@ bool TalkgroupRulesLookup::load()
         return false;
     }
 
+    std::vector<TalkgroupRuleGroupVoice> groupVoiceList;
     try {
-        bool ret = yaml::Parse(m_rules, m_rulesFile.c_str());
+        GroupVoiceRulesHandler handler(groupVoiceList);
+        bool ret = yaml::Parse(handler, m_rulesFile.c_str());
         if (!ret) {
             LogError(LOG_HOST, "Cannot open the talkgroup rules lookup file - %s - error parsing YML", m_rulesFile.c_str());
             return false;
@@ -288,33 +446,27 @@ bool TalkgroupRulesLookup::load()
         return false;
     }
 
-    // clear table
-    clear();
-
-    std::lock_guard<std::mutex> lock(m_mutex);
-    yaml::Node& groupVoiceList = m_rules["groupVoice"];
-
     if (groupVoiceList.size() == 0U) {
         ::LogError(LOG_HOST, "No group voice rules list defined!");
+        clear();
         return false;
     }
 
-    for (size_t i = 0; i < groupVoiceList.size(); i++) {
-        TalkgroupRuleGroupVoice groupVoice = TalkgroupRuleGroupVoice(groupVoiceList[i]);
-        m_groupVoice.push_back(groupVoice);
+    for (const TalkgroupRuleGroupVoice& groupVoice : groupVoiceList) {
+        const TalkgroupRuleConfig& config = groupVoice.config();
 
         std::string groupName = groupVoice.name();
         uint32_t tgId = groupVoice.source().tgId();
         uint8_t tgSlot = groupVoice.source().tgSlot();
-        bool active = groupVoice.config().active();
-        bool parrot = groupVoice.config().parrot();
-        bool affil = groupVoice.config().affiliated();
+        bool active = config.active();
+        bool parrot = config.parrot();
+        bool affil = config.affiliated();
 
-        uint32_t incCount = groupVoice.config().inclusion().size();
-        uint32_t excCount = groupVoice.config().exclusion().size();
-        uint32_t rewrCount = groupVoice.config().rewrite().size();
-        uint32_t alwyCount = groupVoice.config().alwaysSend().size();
-        uint32_t prefCount = groupVoice.config().preferred().size();
+        uint32_t incCount = config.inclusion().size();
+        uint32_t excCount = config.exclusion().size();
+        uint32_t rewrCount = config.rewrite().size();
+        uint32_t alwyCount = config.alwaysSend().size();
+        uint32_t prefCount = config.preferred().size();
 
         if (incCount > 0 && excCount > 0) {
             ::LogWarning(LOG_HOST, "Talkgroup (%s) defines both inclusions and exclusions! Inclusion rules take precedence and exclusion rules will be ignored.", groupName.c_str());
@@ -327,6 +479,10 @@ bool TalkgroupRulesLookup::load()
         ::LogInfoEx(LOG_HOST, "Talkgroup NAME: %s SRC_TGID: %u SRC_TS: %u ACTIVE: %u PARROT: %u AFFILIATED: %u INCLUSIONS: %u EXCLUSIONS: %u REWRITES: %u ALWAYS: %u PREFERRED: %u", groupName.c_str(), tgId, tgSlot, active, parrot, affil, incCount, excCount, rewrCount, alwyCount, prefCount);
     }
 
+    // swap in the new table
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_groupVoice.swap(groupVoiceList);
+
     size_t size = m_groupVoice.size();
     if (size == 0U)
         return false;
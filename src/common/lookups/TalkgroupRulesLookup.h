@@ -582,7 +582,6 @@ namespace lookups
     private:
         const std::string m_rulesFile;
         uint32_t m_reloadTime;
-        yaml::Node m_rules;
 
         bool m_acl;
 
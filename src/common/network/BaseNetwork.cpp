@@ -15,6 +15,7 @@
 #include "common/nxdn/NXDNDefines.h"
 #include "common/p25/dfsi/DFSIDefines.h"
 #include "common/p25/dfsi/LC.h"
+#include "common/edac/SHA256.h"
 #include "network/BaseNetwork.h"
 #include "Utils.h"
 
@@ -700,6 +701,19 @@ uint16_t BaseNetwork::pktSeq(bool reset)
     return curr;
 }
 
+/* Helper to generate the hash of the configuration data sent by a peer during login. */
+
+uint32_t BaseNetwork::configHash(const uint8_t* data, uint32_t length)
+{
+    assert(data != nullptr);
+
+    uint8_t out[32U];
+    edac::SHA256 sha256;
+    sha256.buffer(data, length, out);
+
+    return __GET_UINT32(out, 0U);
+}
+
 /* Creates an DMR frame message. */
 
 UInt8Array BaseNetwork::createDMR_Message(uint32_t& length, const uint32_t streamId, const dmr::data::NetData& data)
@@ -1027,12 +1041,26 @@ UInt8Array BaseNetwork::createP25_TSDUMessage(uint32_t& length, const p25::lc::L
 UInt8Array BaseNetwork::createP25_PDUMessage(uint32_t& length, const p25::data::DataHeader& header,
     const uint8_t currentBlock, const uint8_t* data, const uint32_t len)
 {
-    using namespace p25::defines;
     assert(data != nullptr);
 
     uint8_t* buffer = new uint8_t[DATA_PACKET_LENGTH];
     ::memset(buffer, 0x00U, DATA_PACKET_LENGTH);
 
+    length = createP25_PDUMessage(buffer, header, currentBlock, data, len);
+    return UInt8Array(buffer);
+}
+
+/* Creates an P25 PDU frame message in the given buffer. */
+
+uint32_t BaseNetwork::createP25_PDUMessage(uint8_t* buffer, const p25::data::DataHeader& header,
+    const uint8_t currentBlock, const uint8_t* data, const uint32_t len)
+{
+    using namespace p25::defines;
+    assert(buffer != nullptr);
+    assert(data != nullptr);
+
+    ::memset(buffer, 0x00U, MSG_HDR_SIZE + len + PACKET_PAD);
+
     /*
     ** PDU packs different bytes into the P25 message header space from the rest of the
     ** P25 DUIDs
@@ -1066,8 +1094,7 @@ UInt8Array BaseNetwork::createP25_PDUMessage(uint32_t& length, const p25::data::
     if (m_debug)
         Utils::dump(1U, "Network Message, P25 PDU", buffer, (count + PACKET_PAD));
 
-    length = (count + PACKET_PAD);
-    return UInt8Array(buffer);
+    return (count + PACKET_PAD);
 }
 
 /* Writes NXDN frame data to the network. */
@@ -122,6 +122,7 @@ namespace network
         NET_CONN_NAK_PEER_ACL,                      //! Peer ACL
 
         NET_CONN_NAK_FNE_MAX_CONN,                  //! FNE Maximum Connections
+        NET_CONN_NAK_FNE_BUSY,                      //! FNE Login Rate Exceeded
 
         NET_CONN_NAK_INVALID = 0xFFFF               //! Invalid
     };
@@ -488,6 +489,15 @@ namespace network
          */
         uint32_t createStreamId() { std::uniform_int_distribution<uint32_t> dist(DVM_RAND_MIN, DVM_RAND_MAX); return dist(m_random); }
 
+        /**
+         * @brief Helper to generate the hash of the configuration data sent by a peer during login.
+         *  (Used to bind a login session ticket to the configuration the peer logged in with.)
+         * @param[in] data Buffer containing the configuration data.
+         * @param length Length of buffer.
+         * @returns uint32_t Configuration hash.
+         */
+        static uint32_t configHash(const uint8_t* data, uint32_t length);
+
         /**
          * @brief Creates an DMR frame message.
          * \code{.unparsed}
@@ -666,6 +676,18 @@ namespace network
          */
         UInt8Array createP25_PDUMessage(uint32_t& length, const p25::data::DataHeader& header, const uint8_t currentBlock,
             const uint8_t* data, const uint32_t len);
+        /**
+         * @brief Creates an P25 PDU frame message in the given buffer.
+         * @param[out] buffer Buffer to build the network message in; this must be at least
+         *  (MSG_HDR_SIZE + len + PACKET_PAD) bytes in length.
+         * @param[in] header Instance of p25::data::DataHeader containing PDU header data.
+         * @param currentBlock Current block index being sent.
+         * @param[in] data Buffer containing P25 PDU block data to send.
+         * @param len Length of P25 PDU block data.
+         * @returns uint32_t Length of the built network message.
+         */
+        uint32_t createP25_PDUMessage(uint8_t* buffer, const p25::data::DataHeader& header, const uint8_t currentBlock,
+            const uint8_t* data, const uint32_t len);
         
         /**
          * @brief Creates an NXDN frame message.
@@ -31,7 +31,9 @@ using namespace network::frame;
 
 FrameQueue::FrameQueue(udp::Socket* socket, uint32_t peerId, bool debug) : RawFrameQueue(socket, debug),
     m_peerId(peerId),
-    m_streamTimestamps()
+    m_streamTimestamps(),
+    m_capture(nullptr),
+    m_replay(nullptr)
 {
     assert(peerId < 999999999U);
 }
@@ -49,10 +51,20 @@ UInt8Array FrameQueue::read(int& messageLength, sockaddr_storage& address, uint3
     // read message from socket
     uint8_t buffer[DATA_PACKET_LENGTH];
     ::memset(buffer, 0x00U, DATA_PACKET_LENGTH);
-    int length = m_socket->read(buffer, DATA_PACKET_LENGTH, address, addrLen);
-    if (length < 0) {
-        LogError(LOG_NET, "Failed reading data from the network");
-        return nullptr;
+    int length = 0;
+    if (m_replay != nullptr) {
+        // replayed frames take the place of the socket entirely
+        length = (int)m_replay->read(buffer, &address, &addrLen);
+    }
+    else {
+        length = m_socket->read(buffer, DATA_PACKET_LENGTH, address, addrLen);
+        if (length < 0) {
+            LogError(LOG_NET, "Failed reading data from the network");
+            return nullptr;
+        }
+
+        if (length > 0 && m_capture != nullptr)
+            m_capture->writeNetwork(buffer, length, address, addrLen);
     }
 
     if (length > 0) {
@@ -129,7 +141,7 @@ bool FrameQueue::write(const uint8_t* message, uint32_t length, uint32_t streamI
     uint8_t* buffer = generateMessage(message, length, streamId, peerId, ssrc, opcode, rtpSeq, &bufferLen);
 
     bool ret = true;
-    if (!m_socket->write(buffer, bufferLen, addr, addrLen)) {
+    if (!m_sink && !m_socket->write(buffer, bufferLen, addr, addrLen)) {
         // LogError(LOG_NET, "Failed writing data to the network");
         ret = false;
     }
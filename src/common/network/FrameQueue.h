@@ -20,6 +20,7 @@
 #include "common/network/RTPHeader.h"
 #include "common/network/RTPFNEHeader.h"
 #include "common/network/RawFrameQueue.h"
+#include "common/CaptureFile.h"
 
 #include <unordered_map>
 
@@ -113,10 +114,30 @@ namespace network
          */
         void clearTimestamps();
 
+        /**
+         * @brief Sets the capture file that received frames are written to.
+         * @param capture Capture file writer (or nullptr to stop capturing).
+         */
+        void setCapture(CaptureWriter* capture) { m_capture = capture; }
+        /**
+         * @brief Sets the capture file that received frames are replayed from, instead of the socket;
+         *  while replaying, written frames are discarded instead of being written to the socket.
+         * @param replay Capture file reader (or nullptr to read from the socket).
+         */
+        void setReplay(CaptureReader* replay) { m_replay = replay; setSink(replay != nullptr); }
+        /**
+         * @brief Gets the flag indicating received frames are replayed from a capture file.
+         * @returns bool True, if received frames are replayed, otherwise false.
+         */
+        bool isReplaying() const { return m_replay != nullptr; }
+
     private:
         uint32_t m_peerId;
         std::unordered_map<uint32_t, uint32_t> m_streamTimestamps;
 
+        CaptureWriter* m_capture;
+        CaptureReader* m_replay;
+
         /**
          * @brief Generate RTP message for the frame queue.
          * @param[in] message Message buffer to frame and queue.
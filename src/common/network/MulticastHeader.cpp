@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "network/MulticastHeader.h"
+#include "Utils.h"
+
+using namespace network::frame;
+
+#include <cassert>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the MulticastHeader class. */
+
+MulticastHeader::MulticastHeader() :
+    m_groupId(0U),
+    m_groupSeq(0U),
+    m_srcPeerId(0U)
+{
+    /* stub */
+}
+
+/* Finalizes a instance of the MulticastHeader class. */
+
+MulticastHeader::~MulticastHeader() = default;
+
+/* Decode a multicast group header. */
+
+bool MulticastHeader::decode(const uint8_t* data)
+{
+    assert(data != nullptr);
+
+    if (data[0U] != DVM_MCAST_MAGIC) {
+        return false;
+    }
+
+    if (data[1U] != DVM_MCAST_VERSION) {
+        return false;
+    }
+
+    m_groupId = __GET_UINT32(data, 4U);                                         // Group ID
+    m_groupSeq = __GET_UINT32(data, 8U);                                        // Group Sequence
+    m_srcPeerId = __GET_UINT32(data, 12U);                                      // Source Peer ID
+
+    return true;
+}
+
+/* Encode a multicast group header. */
+
+void MulticastHeader::encode(uint8_t* data)
+{
+    assert(data != nullptr);
+
+    data[0U] = DVM_MCAST_MAGIC;                                                 // Magic
+    data[1U] = DVM_MCAST_VERSION;                                               // Version
+    data[2U] = 0x00U;                                                           // Reserved
+    data[3U] = 0x00U;                                                           // Reserved
+
+    __SET_UINT32(m_groupId, data, 4U);                                          // Group ID
+    __SET_UINT32(m_groupSeq, data, 8U);                                         // Group Sequence
+    __SET_UINT32(m_srcPeerId, data, 12U);                                       // Source Peer ID
+}
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file MulticastHeader.h
+ * @ingroup network_core
+ * @file MulticastHeader.cpp
+ * @ingroup network_core
+ */
+#if !defined(__MULTICAST_HEADER_H__)
+#define __MULTICAST_HEADER_H__
+
+#include "common/Defines.h"
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define MULTICAST_HEADER_LENGTH_BYTES 16
+
+namespace network
+{
+    namespace frame
+    {
+        // ---------------------------------------------------------------------------
+        //  Constants
+        // ---------------------------------------------------------------------------
+
+        const uint8_t DVM_MCAST_MAGIC = 0xDCU;
+        const uint8_t DVM_MCAST_VERSION = 0x01U;
+
+        // ---------------------------------------------------------------------------
+        //  Class Declaration
+        // ---------------------------------------------------------------------------
+
+        /**
+         * @brief Represents the multicast group header.
+         *  This header prefixes a standard RTP/FNE framed message written once to a multicast
+         *  group, and replaces the per-peer fields of the unicast framing (the RTP FNE header
+         *  peer ID is zero for group messages).
+         * \code{.unparsed}
+         * Byte 0               1               2               3
+         * Bit  7 6 5 4 3 2 1 0 7 6 5 4 3 2 1 0 7 6 5 4 3 2 1 0 7 6 5 4 3 2 1 0 
+         *     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+         *     | Magic         | Version       | Reserved                      |
+         *     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+         *     | Group ID                                                      |
+         *     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+         *     | Group Sequence                                                |
+         *     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+         *     | Source Peer ID                                                |
+         *     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+         * 16 bytes
+         * \endcode
+         * @ingroup network_core
+         */
+        class HOST_SW_API MulticastHeader {
+        public:
+            /**
+             * @brief Initializes a new instance of the MulticastHeader class.
+             */
+            MulticastHeader();
+            /**
+             * @brief Finalizes a instance of the MulticastHeader class.
+             */
+            ~MulticastHeader();
+
+            /**
+             * @brief Decode a multicast group header.
+             * @param[in] data Buffer containing multicast group header to decode.
+             * @returns bool True, if header was decoded, otherwise false.
+             */
+            bool decode(const uint8_t* data);
+            /**
+             * @brief Encode a multicast group header.
+             * @param[out] data Buffer to encode a multicast group header.
+             */
+            void encode(uint8_t* data);
+
+        public:
+            /**
+             * @brief Multicast Group ID.
+             */
+            __PROPERTY(uint32_t, groupId, GroupId);
+            /**
+             * @brief Multicast Group Sequence.
+             */
+            __PROPERTY(uint32_t, groupSeq, GroupSequence);
+            /**
+             * @brief Peer ID the message was originally received from.
+             */
+            __PROPERTY(uint32_t, srcPeerId, SrcPeerId);
+        };
+    } // namespace frame
+} // namespace network
+
+#endif // __MULTICAST_HEADER_H__
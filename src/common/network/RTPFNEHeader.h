@@ -62,6 +62,8 @@ namespace network
 
             GRANT_REQ = 0x7AU,                      //! Grant Request
 
+            MCAST_NAK = 0x7CU,                      //! Multicast Group Negative Acknowledge (Retransmit Request)
+
             ACK = 0x7EU,                            //! Packet Acknowledge
             NAK = 0x7FU,                            //! Packet Negative Acknowledge
 
@@ -33,7 +33,8 @@ std::mutex RawFrameQueue::m_flushMutex;
 RawFrameQueue::RawFrameQueue(udp::Socket* socket, bool debug) :
     m_socket(socket),
     m_buffers(),
-    m_debug(debug)
+    m_debug(debug),
+    m_sink(false)
 {
     /* stub */
 }
@@ -89,6 +90,11 @@ bool RawFrameQueue::write(const uint8_t* message, uint32_t length, sockaddr_stor
     if (m_debug)
         Utils::dump(1U, "RawFrameQueue::write() Message", buffer, length);
 
+    if (m_sink) {
+        delete[] buffer;
+        return true;
+    }
+
     bool ret = true;
     if (!m_socket->write(buffer, length, addr, addrLen)) {
         // LogError(LOG_NET, "Failed writing data to the network");
@@ -141,6 +147,11 @@ bool RawFrameQueue::flushQueue()
     // LogDebug(LOG_NET, "m_buffers len = %u", m_buffers.size());
 
     ret = true;
+    if (m_sink) {
+        deleteBuffers();
+        return ret;
+    }
+
     if (!m_socket->write(m_buffers)) {
         // LogError(LOG_NET, "Failed writing data to the network");
         ret = false;
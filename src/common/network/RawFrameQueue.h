@@ -87,6 +87,18 @@ namespace network
          */
         bool flushQueue();
 
+        /**
+         * @brief Sets the flag indicating written (and flushed) messages are discarded, instead of
+         *  being written to the socket.
+         * @param sink Flag indicating written messages are discarded.
+         */
+        void setSink(bool sink) { m_sink = sink; }
+        /**
+         * @brief Gets the flag indicating written messages are discarded.
+         * @returns bool True, if written messages are discarded, otherwise false.
+         */
+        bool isSink() const { return m_sink; }
+
     protected:
         sockaddr_storage m_addr;
         uint32_t m_addrLen;
@@ -96,6 +108,7 @@ namespace network
         udp::BufferVector m_buffers;
 
         bool m_debug;
+        bool m_sink;
 
     private:
         /**
@@ -0,0 +1,256 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "network/rest/EventStream.h"
+
+using namespace network::rest;
+
+#include <algorithm>
+#include <sstream>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const std::string RESYNC_EVENT_KEY = "resync";
+const std::string KEEP_ALIVE_KEY = "keep-alive";
+const std::string KEEP_ALIVE_FRAME = ": keep-alive\n\n";
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the EventStreamSubscriber class. */
+
+EventStreamSubscriber::EventStreamSubscriber(const std::string& types, size_t maxQueued) :
+    m_lock(),
+    m_queue(),
+    m_keyed(),
+    m_nextSeq(0U),
+    m_maxQueued(maxQueued),
+    m_types(),
+    m_notify(nullptr),
+    m_closed(false),
+    m_dropped(0U)
+{
+    std::stringstream ss(types);
+    std::string type;
+    while (std::getline(ss, type, ',')) {
+        if (!type.empty())
+            m_types.push_back(type);
+    }
+}
+
+/* Helper to determine if the subscriber wants the given event type. */
+
+bool EventStreamSubscriber::accepts(const std::string& type) const
+{
+    if (m_types.empty() || type.empty())
+        return true;
+
+    return std::find(m_types.begin(), m_types.end(), type) != m_types.end();
+}
+
+/* Queues an event frame. */
+
+void EventStreamSubscriber::push(const std::string& frame, const std::string& key)
+{
+    std::function<void()> notify = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (m_closed)
+            return;
+
+        // replace the queued event with the same key, the position in the queue is kept
+        if (!key.empty()) {
+            auto it = m_keyed.find(key);
+            if (it != m_keyed.end()) {
+                m_queue[it->second - m_queue.front().seq].frame = frame;
+                return;
+            }
+        }
+
+        bool wasEmpty = m_queue.empty();
+        if (m_queue.size() >= m_maxQueued) {
+            m_dropped += m_queue.size();
+            m_queue.clear();
+            m_keyed.clear();
+
+            std::string resync = "event: resync\ndata: {\"dropped\":" + std::to_string(m_dropped) + "}\n\n";
+            m_keyed[RESYNC_EVENT_KEY] = m_nextSeq;
+            m_queue.push_back({ m_nextSeq++, RESYNC_EVENT_KEY, resync });
+        }
+
+        if (!key.empty())
+            m_keyed[key] = m_nextSeq;
+        m_queue.push_back({ m_nextSeq++, key, frame });
+
+        if (wasEmpty)
+            notify = m_notify;
+    }
+
+    // notify outside the lock, the callback may immediately take the queued events
+    if (notify != nullptr)
+        notify();
+}
+
+/* Takes all queued event frames. */
+
+bool EventStreamSubscriber::take(std::string& frames)
+{
+    frames.clear();
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (m_closed)
+        return false;
+
+    for (const QueuedEvent& event : m_queue)
+        frames.append(event.frame);
+
+    m_queue.clear();
+    m_keyed.clear();
+    return !frames.empty();
+}
+
+/* Helper to set the callback invoked when an event is queued to an empty queue. */
+
+void EventStreamSubscriber::setNotifyCallback(std::function<void()>&& callback)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_notify = callback;
+}
+
+/* Closes the subscriber. */
+
+void EventStreamSubscriber::close()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_closed = true;
+    m_notify = nullptr;
+    m_queue.clear();
+    m_keyed.clear();
+}
+
+/* Helper to determine if the subscriber is closed. */
+
+bool EventStreamSubscriber::isClosed() const
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    return m_closed;
+}
+
+/* Gets the count of events discarded due to queue overflow. */
+
+uint32_t EventStreamSubscriber::dropped() const
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    return m_dropped;
+}
+
+/* Initializes a new instance of the EventStream class. */
+
+EventStream::EventStream(size_t maxQueued, size_t maxSubscribers) :
+    m_lock(),
+    m_subscribers(),
+    m_subscriberCnt(0U),
+    m_maxQueued(maxQueued),
+    m_maxSubscribers(maxSubscribers)
+{
+    /* stub */
+}
+
+/* Finalizes a instance of the EventStream class. */
+
+EventStream::~EventStream()
+{
+    closeAll();
+}
+
+/* Adds a new subscriber. */
+
+std::shared_ptr<EventStreamSubscriber> EventStream::subscribe(const std::string& types)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_subscribers.erase(std::remove_if(m_subscribers.begin(), m_subscribers.end(),
+        [](const std::shared_ptr<EventStreamSubscriber>& s) { return s->isClosed(); }), m_subscribers.end());
+
+    if (m_subscribers.size() >= m_maxSubscribers) {
+        m_subscriberCnt = m_subscribers.size();
+        return nullptr;
+    }
+
+    std::shared_ptr<EventStreamSubscriber> subscriber = std::make_shared<EventStreamSubscriber>(types, m_maxQueued);
+    m_subscribers.push_back(subscriber);
+    m_subscriberCnt = m_subscribers.size();
+    return subscriber;
+}
+
+/* Publishes an event to all subscribers. */
+
+void EventStream::publish(const std::string& type, json::object& data, const std::string& key)
+{
+    if (!hasSubscribers())
+        return;
+
+    json::value v = json::value(data);
+    std::string frame = "event: " + type + "\ndata: " + v.serialize() + "\n\n";
+    dispatch(type, frame, key.empty() ? key : type + ":" + key);
+}
+
+/* Publishes a keep-alive comment to all subscribers. */
+
+void EventStream::keepAlive()
+{
+    if (!hasSubscribers())
+        return;
+
+    dispatch("", KEEP_ALIVE_FRAME, KEEP_ALIVE_KEY);
+}
+
+/* Closes all subscribers. */
+
+void EventStream::closeAll()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    for (auto& subscriber : m_subscribers)
+        subscriber->close();
+
+    m_subscribers.clear();
+    m_subscriberCnt = 0U;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to queue an event frame to all subscribers accepting the event type. */
+
+void EventStream::dispatch(const std::string& type, const std::string& frame, const std::string& key)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    bool closed = false;
+    for (auto& subscriber : m_subscribers) {
+        if (subscriber->isClosed()) {
+            closed = true;
+            continue;
+        }
+
+        if (subscriber->accepts(type))
+            subscriber->push(frame, key);
+    }
+
+    // subscribers are closed by their connection, prune them here rather than on the connection thread
+    if (closed) {
+        m_subscribers.erase(std::remove_if(m_subscribers.begin(), m_subscribers.end(),
+            [](const std::shared_ptr<EventStreamSubscriber>& s) { return s->isClosed(); }), m_subscribers.end());
+        m_subscriberCnt = m_subscribers.size();
+    }
+}
@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file EventStream.h
+ * @ingroup rest
+ * @file EventStream.cpp
+ * @ingroup rest
+ */
+#if !defined(__REST__EVENT_STREAM_H__)
+#define __REST__EVENT_STREAM_H__
+
+#include "common/Defines.h"
+#include "common/network/json/json.h"
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace network
+{
+    namespace rest
+    {
+        // ---------------------------------------------------------------------------
+        //  Constants
+        // ---------------------------------------------------------------------------
+
+        const size_t EVENT_STREAM_MAX_QUEUED = 256U;
+        const size_t EVENT_STREAM_MAX_SUBSCRIBERS = 16U;
+
+        // ---------------------------------------------------------------------------
+        //  Class Declaration
+        // ---------------------------------------------------------------------------
+
+        /**
+         * @brief Implements a single subscriber of an event stream.
+         * @ingroup rest
+         *
+         *  Events are queued as preformatted server-sent event frames, up to a fixed maximum.
+         *  An event published with a key replaces the queued event with the same key (i.e. periodic
+         *  samples only deliver the latest value to a slow client). If the queue overflows, the
+         *  queued events are discarded and replaced with a single "resync" event, the client is
+         *  expected to refetch the full state from the REST API.
+         */
+        class HOST_SW_API EventStreamSubscriber {
+        public:
+            auto operator=(EventStreamSubscriber&) -> EventStreamSubscriber& = delete;
+            auto operator=(EventStreamSubscriber&&) -> EventStreamSubscriber& = delete;
+            EventStreamSubscriber(EventStreamSubscriber&) = delete;
+
+            /**
+             * @brief Initializes a new instance of the EventStreamSubscriber class.
+             * @param types Comma separated list of event types to deliver (empty for all event types).
+             * @param maxQueued Maximum number of queued events.
+             */
+            EventStreamSubscriber(const std::string& types, size_t maxQueued);
+
+            /**
+             * @brief Helper to determine if the subscriber wants the given event type.
+             * @param type Event type.
+             * @returns bool True, if the event type should be delivered, otherwise false.
+             */
+            bool accepts(const std::string& type) const;
+
+            /**
+             * @brief Queues an event frame.
+             * @param frame Server-sent event frame.
+             * @param key Coalescing key (empty if the event should not be coalesced).
+             */
+            void push(const std::string& frame, const std::string& key);
+            /**
+             * @brief Takes all queued event frames.
+             * @param[out] frames Buffer to fill with the queued event frames.
+             * @returns bool True, if any event frames were taken, otherwise false.
+             */
+            bool take(std::string& frames);
+
+            /**
+             * @brief Helper to set the callback invoked when an event is queued to an empty queue.
+             *  The callback is invoked on the publishing thread.
+             * @param callback Notification callback.
+             */
+            void setNotifyCallback(std::function<void()>&& callback);
+            /**
+             * @brief Closes the subscriber; queued events are discarded and no further events are queued.
+             */
+            void close();
+            /**
+             * @brief Helper to determine if the subscriber is closed.
+             * @returns bool True, if the subscriber is closed, otherwise false.
+             */
+            bool isClosed() const;
+
+            /**
+             * @brief Gets the count of events discarded due to queue overflow.
+             * @returns uint32_t Count of discarded events.
+             */
+            uint32_t dropped() const;
+
+        private:
+            /**
+             * @brief Represents a queued event frame.
+             */
+            struct QueuedEvent {
+                uint64_t seq;
+                std::string key;
+                std::string frame;
+            };
+
+            mutable std::mutex m_lock;
+            std::deque<QueuedEvent> m_queue;
+            std::unordered_map<std::string, uint64_t> m_keyed;
+            uint64_t m_nextSeq;
+            size_t m_maxQueued;
+
+            std::vector<std::string> m_types;
+
+            std::function<void()> m_notify;
+            bool m_closed;
+            uint32_t m_dropped;
+        };
+
+        // ---------------------------------------------------------------------------
+        //  Class Declaration
+        // ---------------------------------------------------------------------------
+
+        /**
+         * @brief Implements a publisher of server-sent events to a set of subscribers.
+         * @ingroup rest
+         *
+         *  Events are serialized once per publish and queued to every subscriber that accepts
+         *  the event type. Publishing is thread-safe, and only checks an atomic counter when
+         *  there are no subscribers.
+         */
+        class HOST_SW_API EventStream {
+        public:
+            auto operator=(EventStream&) -> EventStream& = delete;
+            auto operator=(EventStream&&) -> EventStream& = delete;
+            EventStream(EventStream&) = delete;
+
+            /**
+             * @brief Initializes a new instance of the EventStream class.
+             * @param maxQueued Maximum number of queued events per subscriber.
+             * @param maxSubscribers Maximum number of subscribers.
+             */
+            EventStream(size_t maxQueued = EVENT_STREAM_MAX_QUEUED, size_t maxSubscribers = EVENT_STREAM_MAX_SUBSCRIBERS);
+            /**
+             * @brief Finalizes a instance of the EventStream class.
+             */
+            ~EventStream();
+
+            /**
+             * @brief Adds a new subscriber.
+             * @param types Comma separated list of event types to deliver (empty for all event types).
+             * @returns std::shared_ptr<EventStreamSubscriber> Subscriber, or nullptr if the maximum number
+             *  of subscribers has been reached.
+             */
+            std::shared_ptr<EventStreamSubscriber> subscribe(const std::string& types = "");
+
+            /**
+             * @brief Publishes an event to all subscribers.
+             * @param type Event type.
+             * @param data Event data.
+             * @param key Coalescing key (empty if the event should not be coalesced).
+             */
+            void publish(const std::string& type, json::object& data, const std::string& key = "");
+            /**
+             * @brief Publishes a keep-alive comment to all subscribers. This lets clients (and any
+             *  proxies in between) detect a dead connection while no events are published.
+             */
+            void keepAlive();
+
+            /**
+             * @brief Helper to determine if there are any subscribers.
+             * @returns bool True, if there are subscribers, otherwise false.
+             */
+            bool hasSubscribers() const { return m_subscriberCnt.load() > 0U; }
+            /**
+             * @brief Closes all subscribers.
+             */
+            void closeAll();
+
+        private:
+            std::mutex m_lock;
+            std::vector<std::shared_ptr<EventStreamSubscriber>> m_subscribers;
+            std::atomic<size_t> m_subscriberCnt;
+
+            size_t m_maxQueued;
+            size_t m_maxSubscribers;
+
+            /**
+             * @brief Helper to queue an event frame to all subscribers accepting the event type.
+             * @param type Event type.
+             * @param frame Server-sent event frame.
+             * @param key Coalescing key.
+             */
+            void dispatch(const std::string& type, const std::string& frame, const std::string& key);
+        };
+    } // namespace rest
+} // namespace network
+
+#endif // __REST__EVENT_STREAM_H__
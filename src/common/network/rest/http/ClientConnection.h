@@ -19,7 +19,9 @@
 #include "common/network/rest/http/HTTPPayload.h"
 #include "common/Log.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <memory>
 #include <utility>
 #include <iterator>
@@ -56,7 +58,9 @@ namespace network
                 explicit ClientConnection(asio::ip::tcp::socket socket, RequestHandlerType& handler) :
                     m_socket(std::move(socket)),
                     m_requestHandler(handler),
-                    m_lexer(HTTPLexer(true))
+                    m_lexer(HTTPLexer(true)),
+                    m_contentRemaining(0U),
+                    m_open(true)
                 {
                     /* stub */
                 }
@@ -70,6 +74,9 @@ namespace network
                  */
                 void stop()
                 {
+                    if (!m_open.exchange(false)) {
+                        return;
+                    }
                     try
                     {
                         ensureNoLinger();
@@ -80,6 +87,12 @@ namespace network
                     catch(const std::exception&) { /* ignore */ }
                 }
 
+                /**
+                 * @brief Helper to determine if the connection is still open.
+                 * @returns bool True, if the connection is open, otherwise false.
+                 */
+                bool isOpen() const { return m_open; }
+
                 /**
                  * @brief Helper to enable the SO_LINGER socket option during shutdown.
                  */
@@ -117,35 +130,53 @@ namespace network
                 {
                     m_socket.async_read_some(asio::buffer(m_buffer), [=](asio::error_code ec, std::size_t bytes_transferred) {
                         if (!ec) {
-                            HTTPLexer::ResultType result;
-                            char* content;
-
                             try
                             {
-                                std::tie(result, content) = m_lexer.parse(m_request, m_buffer.data(), m_buffer.data() + bytes_transferred);
-
-                                std::string contentLength = m_request.headers.find("Content-Length");
-                                if (contentLength != "") {
-                                    size_t length = (size_t)::strtoul(contentLength.c_str(), NULL, 10);
-                                    m_request.content = std::string(content, length);
+                                if (m_contentRemaining > 0U) {
+                                    // remainder of a response body that did not arrive with the headers
+                                    size_t length = std::min(m_contentRemaining, bytes_transferred);
+                                    m_request.content.append(m_buffer.data(), length);
+                                    m_contentRemaining -= length;
+                                }
+                                else {
+                                    HTTPLexer::ResultType result;
+                                    char* content;
+
+                                    std::tie(result, content) = m_lexer.parse(m_request, m_buffer.data(), m_buffer.data() + bytes_transferred);
+                                    if (result == HTTPLexer::BAD) {
+                                        return;
+                                    }
+
+                                    if (result != HTTPLexer::GOOD) {
+                                        read();
+                                        return;
+                                    }
+
+                                    m_request.content = std::string();
+                                    std::string contentLength = m_request.headers.find("Content-Length");
+                                    if (contentLength != "") {
+                                        size_t length = (size_t)::strtoul(contentLength.c_str(), NULL, 10);
+                                        size_t available = (size_t)((m_buffer.data() + bytes_transferred) - content);
+                                        m_request.content = std::string(content, std::min(length, available));
+                                        m_contentRemaining = length - m_request.content.length();
+                                    }
                                 }
 
-                                m_request.headers.add("RemoteHost", m_socket.remote_endpoint().address().to_string());
-
-                                if (result == HTTPLexer::GOOD) {
+                                if (m_contentRemaining == 0U) {
+                                    m_request.headers.add("RemoteHost", m_socket.remote_endpoint().address().to_string());
                                     m_requestHandler.handleRequest(m_request, m_reply);
+
+                                    // reset for the next response on a persistent connection
+                                    m_lexer.reset();
+                                    m_request = HTTPPayload();
                                 }
-                                else if (result == HTTPLexer::BAD) {
-                                    return;
-                                }
-                                else {
-                                    read();
-                                }
+
+                                read();
                             }
-                            catch(const std::exception& e) { ::LogError(LOG_REST, "ClientConnection::read(), %s", ec.message().c_str()); }
+                            catch(const std::exception& e) { ::LogError(LOG_REST, "ClientConnection::read(), %s", e.what()); }
                         }
                         else if (ec != asio::error::operation_aborted) {
-                            if (ec) {
+                            if (ec && ec != asio::error::eof) {
                                 ::LogError(LOG_REST, "ClientConnection::read(), %s, code = %u", ec.message().c_str(), ec.value());
                             }
                             stop();
@@ -192,6 +223,9 @@ namespace network
                 HTTPPayload m_request;
                 HTTPLexer m_lexer;
                 HTTPPayload m_reply;
+
+                size_t m_contentRemaining;
+                std::atomic<bool> m_open;
             };
         } // namespace http
     } // namespace rest
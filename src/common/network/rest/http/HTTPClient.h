@@ -123,6 +123,20 @@ namespace network
                     return run();
                 }
 
+                /**
+                 * @brief Helper to determine if the connection to the network is open.
+                 * @returns bool True, if the connection is open, otherwise false.
+                 */
+                bool isOpen()
+                {
+                    if (m_completed) {
+                        return false;
+                    }
+
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    return m_connection != nullptr && m_connection->isOpen();
+                }
+
                 /**
                  * @brief Closes connection to the network.
                  */
@@ -148,10 +162,10 @@ namespace network
                         return;
                     }
 
-                    asio::ip::tcp::resolver resolver(m_ioContext);
-                    auto endpoints = resolver.resolve(m_address, std::to_string(m_port));
-
                     try {
+                        asio::ip::tcp::resolver resolver(m_ioContext);
+                        auto endpoints = resolver.resolve(m_address, std::to_string(m_port));
+
                         connect(endpoints);
 
                         // the entry() call will block until all asynchronous operations
@@ -160,6 +174,7 @@ namespace network
                     }
                     catch (std::exception&) { /* stub */ }
 
+                    std::lock_guard<std::mutex> guard(m_lock);
                     if (m_connection != nullptr) {
                         m_connection->stop();
                     }
@@ -173,6 +188,11 @@ namespace network
                 {
                     asio::connect(m_socket, endpoints);
 
+                    // requests are written whole, don't let Nagle hold them on persistent connections
+                    asio::error_code ignored_ec;
+                    m_socket.set_option(asio::ip::tcp::no_delay(true), ignored_ec);
+
+                    std::lock_guard<std::mutex> guard(m_lock);
                     m_connection = std::make_unique<ConnectionType>(std::move(m_socket), m_requestHandler);
                     m_connection->start();
                 }
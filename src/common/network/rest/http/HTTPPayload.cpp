@@ -335,6 +335,20 @@ void HTTPPayload::payload(std::string& c, HTTPPayload::StatusType s, const std::
     ensureDefaultHeaders(contentType);
 }
 
+/* Prepares payload as a server-sent event stream. */
+
+void HTTPPayload::stream(std::shared_ptr<EventStreamSubscriber> subscriber)
+{
+    content = "";
+    status = OK;
+    eventStream = subscriber;
+
+    // the stream is delimited by the connection closing, there is no content length
+    headers.add("Content-Type", "text/event-stream");
+    headers.add("Cache-Control", "no-cache");
+    headers.add("Server", std::string(("DVM/" __VER__)));
+}
+
 // ---------------------------------------------------------------------------
 //  Static Members
 // ---------------------------------------------------------------------------
@@ -21,6 +21,7 @@
 #include "common/network/json/json.h"
 #include "common/network/rest/http/HTTPHeaders.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -30,6 +31,12 @@ namespace network
 {
     namespace rest
     {
+        // ---------------------------------------------------------------------------
+        //  Class Prototypes
+        // ---------------------------------------------------------------------------
+
+        class HOST_SW_API EventStreamSubscriber;
+
         namespace http
         {
 
@@ -90,6 +97,8 @@ namespace network
 
                 bool isClientPayload = false;
 
+                std::shared_ptr<EventStreamSubscriber> eventStream;
+
                 /**
                  * @brief Convert the payload into a vector of buffers. The buffers do not own the
                  *  underlying memory blocks, therefore the payload object must remain valid and
@@ -111,6 +120,12 @@ namespace network
                  * @param contentType HTTP content type.
                  */
                 void payload(std::string& content, StatusType status = OK, const std::string& contentType = "text/html");
+                /**
+                 * @brief Prepares payload as a server-sent event stream. Only the headers are sent as the reply,
+                 *  the connection then stays open and writes the events queued to the subscriber.
+                 * @param subscriber Event stream subscriber.
+                 */
+                void stream(std::shared_ptr<EventStreamSubscriber> subscriber);
 
                 /**
                  * @brief Get a request payload.
@@ -116,9 +116,12 @@ namespace network
                 {
                     // the server is stopped by cancelling all outstanding asynchronous
                     // operations; once all operations have finished the m_ioService::run()
-                    // call will exit
-                    m_acceptor.close();
-                    m_connectionManager.stopAll();
+                    // call will exit (this is done on the IO thread, persistent connections may still
+                    // have reads outstanding)
+                    asio::post(m_ioService, [this]() {
+                        m_acceptor.close();
+                        m_connectionManager.stopAll();
+                    });
                 }
 
             private:
@@ -135,6 +138,10 @@ namespace network
                         }
 
                         if (!ec) {
+                            // responses are written whole, don't let Nagle hold them on persistent connections
+                            asio::error_code ignored_ec;
+                            m_socket.set_option(asio::ip::tcp::no_delay(true), ignored_ec);
+
                             m_connectionManager.start(std::make_shared<ConnectionType>(std::move(m_socket), m_connectionManager, m_requestHandler, false, m_debug));
                         }
 
@@ -24,7 +24,9 @@
 #include "common/network/rest/http/HTTPPayload.h"
 #include "common/Log.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <memory>
 #include <utility>
 #include <iterator>
@@ -63,7 +65,9 @@ namespace network
                 explicit SecureClientConnection(asio::ip::tcp::socket socket, asio::ssl::context& context, RequestHandlerType& handler) :
                     m_socket(std::move(socket), context),
                     m_requestHandler(handler),
-                    m_lexer(HTTPLexer(true))
+                    m_lexer(HTTPLexer(true)),
+                    m_contentRemaining(0U),
+                    m_open(true)
                 {
                     m_socket.set_verify_mode(asio::ssl::verify_none);
                     m_socket.set_verify_callback(std::bind(&SecureClientConnection::verify_certificate, this, std::placeholders::_1, std::placeholders::_2));
@@ -71,17 +75,42 @@ namespace network
 
                 /**
                  * @brief Start the first asynchronous operation for the connection.
+                 * @param session TLS session to attempt to resume (or nullptr for a full handshake).
                  */
-                void start() 
-                { 
-                    m_socket.handshake(asio::ssl::stream_base::client);                    
-                    read(); 
+                void start(SSL_SESSION* session = nullptr)
+                {
+                    if (session != nullptr) {
+                        SSL_set_session(m_socket.native_handle(), session);
+                    }
+
+                    m_socket.handshake(asio::ssl::stream_base::client);
+                    read();
                 }
+
+                /**
+                 * @brief Gets the TLS session negotiated for the connection.
+                 * @returns SSL_SESSION* TLS session, the caller must release it with SSL_SESSION_free().
+                 */
+                SSL_SESSION* session() { return SSL_get1_session(m_socket.native_handle()); }
+                /**
+                 * @brief Helper to determine if the connection resumed a previous TLS session.
+                 * @returns bool True, if the TLS session was resumed, otherwise false.
+                 */
+                bool sessionReused() { return SSL_session_reused(m_socket.native_handle()) == 1; }
                 /**
                  * @brief Stop all asynchronous operations associated with the connection.
                  */
                 void stop()
                 {
+                    if (!m_open.exchange(false)) {
+                        return;
+                    }
+
+                    // mark the TLS session as cleanly shut down (without waiting on the peer), otherwise
+                    // OpenSSL drops it and later connections cannot resume it
+                    SSL_set_quiet_shutdown(m_socket.native_handle(), 1);
+                    SSL_shutdown(m_socket.native_handle());
+
                     try
                     {
                         ensureNoLinger();
@@ -92,6 +121,12 @@ namespace network
                     catch(const std::exception&) { /* ignore */ }
                 }
 
+                /**
+                 * @brief Helper to determine if the connection is still open.
+                 * @returns bool True, if the connection is open, otherwise false.
+                 */
+                bool isOpen() const { return m_open; }
+
                 /**
                  * @brief Helper to enable the SO_LINGER socket option during shutdown.
                  */
@@ -140,35 +175,53 @@ namespace network
                 {
                     m_socket.async_read_some(asio::buffer(m_buffer), [=](asio::error_code ec, std::size_t bytes_transferred) {
                         if (!ec) {
-                            HTTPLexer::ResultType result;
-                            char* content;
-
                             try
                             {
-                                std::tie(result, content) = m_lexer.parse(m_request, m_buffer.data(), m_buffer.data() + bytes_transferred);
-
-                                std::string contentLength = m_request.headers.find("Content-Length");
-                                if (contentLength != "") {
-                                    size_t length = (size_t)::strtoul(contentLength.c_str(), NULL, 10);
-                                    m_request.content = std::string(content, length);
+                                if (m_contentRemaining > 0U) {
+                                    // remainder of a response body that did not arrive with the headers
+                                    size_t length = std::min(m_contentRemaining, bytes_transferred);
+                                    m_request.content.append(m_buffer.data(), length);
+                                    m_contentRemaining -= length;
                                 }
+                                else {
+                                    HTTPLexer::ResultType result;
+                                    char* content;
 
-                                m_request.headers.add("RemoteHost", m_socket.lowest_layer().remote_endpoint().address().to_string());
+                                    std::tie(result, content) = m_lexer.parse(m_request, m_buffer.data(), m_buffer.data() + bytes_transferred);
+                                    if (result == HTTPLexer::BAD) {
+                                        return;
+                                    }
 
-                                if (result == HTTPLexer::GOOD) {
-                                    m_requestHandler.handleRequest(m_request, m_reply);
-                                }
-                                else if (result == HTTPLexer::BAD) {
-                                    return;
+                                    if (result != HTTPLexer::GOOD) {
+                                        read();
+                                        return;
+                                    }
+
+                                    m_request.content = std::string();
+                                    std::string contentLength = m_request.headers.find("Content-Length");
+                                    if (contentLength != "") {
+                                        size_t length = (size_t)::strtoul(contentLength.c_str(), NULL, 10);
+                                        size_t available = (size_t)((m_buffer.data() + bytes_transferred) - content);
+                                        m_request.content = std::string(content, std::min(length, available));
+                                        m_contentRemaining = length - m_request.content.length();
+                                    }
                                 }
-                                else {
-                                    read();
+
+                                if (m_contentRemaining == 0U) {
+                                    m_request.headers.add("RemoteHost", m_socket.lowest_layer().remote_endpoint().address().to_string());
+                                    m_requestHandler.handleRequest(m_request, m_reply);
+
+                                    // reset for the next response on a persistent connection
+                                    m_lexer.reset();
+                                    m_request = HTTPPayload();
                                 }
+
+                                read();
                             }
-                            catch(const std::exception& e) { ::LogError(LOG_REST, "SecureClientConnection::read(), %s", ec.message().c_str()); }
+                            catch(const std::exception& e) { ::LogError(LOG_REST, "SecureClientConnection::read(), %s", e.what()); }
                         }
                         else if (ec != asio::error::operation_aborted) {
-                            if (ec) {
+                            if (ec && ec != asio::error::eof) {
                                 ::LogError(LOG_REST, "SecureClientConnection::read(), %s, code = %u", ec.message().c_str(), ec.value());
                             }
                             stop();
@@ -184,8 +237,8 @@ namespace network
                 {
                     try
                     {
-                        m_socket.handshake(asio::ssl::stream_base::client);
-
+                        // the handshake is completed once in start(), requests on a persistent connection
+                        // reuse the established TLS session
                         auto buffers = request.toBuffers();
                         asio::write(m_socket, buffers);
                     }
@@ -217,6 +270,9 @@ namespace network
                 HTTPPayload m_request;
                 HTTPLexer m_lexer;
                 HTTPPayload m_reply;
+
+                size_t m_contentRemaining;
+                std::atomic<bool> m_open;
             };
         } // namespace http
     } // namespace rest
@@ -70,7 +70,8 @@ namespace network
                     m_ioContext(),
                     m_context(asio::ssl::context::tlsv12),
                     m_socket(m_ioContext),
-                    m_requestHandler()
+                    m_requestHandler(),
+                    m_session(nullptr)
                 {
                     /* stub */
                 }
@@ -82,6 +83,11 @@ namespace network
                     if (m_connection != nullptr) {
                         close();
                     }
+
+                    if (m_session != nullptr) {
+                        SSL_SESSION_free(m_session);
+                        m_session = nullptr;
+                    }
                 }
 
                 /**
@@ -130,6 +136,61 @@ namespace network
                     return run();
                 }
 
+                /**
+                 * @brief Sets the TLS session to resume when the connection is opened.
+                 * @param session TLS session (a reference is taken, the caller retains ownership).
+                 */
+                void setSession(SSL_SESSION* session)
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    if (m_session != nullptr) {
+                        SSL_SESSION_free(m_session);
+                        m_session = nullptr;
+                    }
+
+                    if (session != nullptr && SSL_SESSION_up_ref(session) == 1) {
+                        m_session = session;
+                    }
+                }
+
+                /**
+                 * @brief Gets the TLS session negotiated (or resumed) by the connection.
+                 * @returns SSL_SESSION* TLS session, the caller must release it with SSL_SESSION_free().
+                 */
+                SSL_SESSION* getSession()
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    if (m_session != nullptr && SSL_SESSION_up_ref(m_session) == 1) {
+                        return m_session;
+                    }
+
+                    return nullptr;
+                }
+
+                /**
+                 * @brief Helper to determine if the connection resumed a previous TLS session.
+                 * @returns bool True, if the TLS session was resumed, otherwise false.
+                 */
+                bool sessionReused()
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    return m_connection != nullptr && m_connection->sessionReused();
+                }
+
+                /**
+                 * @brief Helper to determine if the connection to the network is open.
+                 * @returns bool True, if the connection is open, otherwise false.
+                 */
+                bool isOpen()
+                {
+                    if (m_completed) {
+                        return false;
+                    }
+
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    return m_connection != nullptr && m_connection->isOpen();
+                }
+
                 /**
                  * @brief Closes connection to the network.
                  */
@@ -155,10 +216,10 @@ namespace network
                         return;
                     }
 
-                    asio::ip::tcp::resolver resolver(m_ioContext);
-                    auto endpoints = resolver.resolve(m_address, std::to_string(m_port));
-
                     try {
+                        asio::ip::tcp::resolver resolver(m_ioContext);
+                        auto endpoints = resolver.resolve(m_address, std::to_string(m_port));
+
                         connect(endpoints);
 
                         // the entry() call will block until all asynchronous operations
@@ -167,6 +228,7 @@ namespace network
                     }
                     catch (std::exception&) { /* stub */ }
 
+                    std::lock_guard<std::mutex> guard(m_lock);
                     if (m_connection != nullptr) {
                         m_connection->stop();
                     }
@@ -180,8 +242,19 @@ namespace network
                 {
                     asio::connect(m_socket, endpoints);
 
+                    // requests are written whole, don't let Nagle hold them on persistent connections
+                    asio::error_code ignored_ec;
+                    m_socket.set_option(asio::ip::tcp::no_delay(true), ignored_ec);
+
+                    std::lock_guard<std::mutex> guard(m_lock);
                     m_connection = std::make_unique<ConnectionType>(std::move(m_socket), m_context, m_requestHandler);
-                    m_connection->start();
+                    m_connection->start(m_session);
+
+                    // hold onto the negotiated session so later connections to this server can resume it
+                    if (m_session != nullptr) {
+                        SSL_SESSION_free(m_session);
+                    }
+                    m_session = m_connection->session();
                 }
 
                 std::string m_address;
@@ -200,6 +273,8 @@ namespace network
                 RequestHandlerType m_requestHandler;
 
                 std::mutex m_lock;
+
+                SSL_SESSION* m_session;
             };
         } // namespace http
     } // namespace rest
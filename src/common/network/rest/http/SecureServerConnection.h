@@ -18,12 +18,16 @@
 #if defined(ENABLE_TCP_SSL)
 
 #include "common/Defines.h"
+#include "common/network/rest/EventStream.h"
 #include "common/network/rest/http/HTTPLexer.h"
 #include "common/network/rest/http/HTTPPayload.h"
+#include "common/network/rest/http/ServerConnectionManager.h"
 #include "common/Log.h"
 
 #include <array>
+#include <chrono>
 #include <memory>
+#include <string>
 #include <utility>
 #include <iterator>
 
@@ -36,12 +40,6 @@ namespace network
     {
         namespace http
         {
-            // ---------------------------------------------------------------------------
-            //  Class Prototypes
-            // ---------------------------------------------------------------------------
-
-            template<class> class ServerConnectionManager;
-
             // ---------------------------------------------------------------------------
             //  Class Declaration
             // ---------------------------------------------------------------------------
@@ -73,12 +71,16 @@ namespace network
                 explicit SecureServerConnection(asio::ip::tcp::socket socket, asio::ssl::context& context, ConnectionManagerType& manager, RequestHandlerType& handler,
                     bool persistent = false, bool debug = false) :
                     m_socket(std::move(socket), context),
+                    m_idleTimer(m_socket.get_executor()),
                     m_connectionManager(manager),
                     m_requestHandler(handler),
                     m_lexer(HTTPLexer(false)),
                     m_continue(false),
                     m_contResult(HTTPLexer::INDETERMINATE),
                     m_persistent(persistent),
+                    m_subscriber(nullptr),
+                    m_streamBuffer(),
+                    m_streamWriting(false),
                     m_debug(debug)
                 {
                     /* stub */
@@ -93,8 +95,13 @@ namespace network
                  */
                 void stop()
                 {
+                    if (m_subscriber != nullptr) {
+                        m_subscriber->close();
+                    }
+
                     try
                     {
+                        m_idleTimer.cancel();
                         if (m_socket.lowest_layer().is_open()) {
                             m_socket.lowest_layer().close();
                         }
@@ -108,14 +115,20 @@ namespace network
                  */
                 void handshake()
                 {
-                    if (!m_persistent) {
-                        auto self(this->shared_from_this());
-                    }
+                    // hold a reference until the operation completes, the connection manager may have
+                    // already released a persistent connection by then (i.e. on shutdown)
+                    auto self(this->shared_from_this());
+
+                    waitIdle();
+                    m_socket.async_handshake(asio::ssl::stream_base::server, [this, self](asio::error_code ec) {
+                        m_idleTimer.expires_at(asio::steady_timer::time_point::max());
 
-                    m_socket.async_handshake(asio::ssl::stream_base::server, [this](asio::error_code ec) {
                         if (!ec) {
                             read();
                         }
+                        else if (ec != asio::error::operation_aborted) {
+                            m_connectionManager.stop(self);
+                        }
                     });
                 }
 
@@ -124,11 +137,16 @@ namespace network
                  */
                 void read()
                 {
-                    if (!m_persistent) {
-                        auto self(this->shared_from_this());
-                    }
+                    // hold a reference until the operation completes, the connection manager may have
+                    // already released a persistent connection by then (i.e. on shutdown)
+                    auto self(this->shared_from_this());
+
+                    waitIdle();
+                    m_socket.async_read_some(asio::buffer(m_buffer), [this, self](asio::error_code ec, std::size_t recvLength) {
+                        // park the idle timer while the request is handled (a wait that already expired
+                        // checks the expiry before closing the connection)
+                        m_idleTimer.expires_at(asio::steady_timer::time_point::max());
 
-                    m_socket.async_read_some(asio::buffer(m_buffer), [=](asio::error_code ec, std::size_t recvLength) {
                         if (!ec) {
                             HTTPLexer::ResultType result = HTTPLexer::GOOD;
                             char* content;
@@ -183,6 +201,11 @@ namespace network
                                         Utils::dump(1U, "HTTPS Request Content", (uint8_t*)m_request.content.c_str(), m_request.content.length());
                                     }
 
+                                    // clients that pool connections ask for them to be kept open, this is
+                                    // decided again for every request
+                                    bool keepAlive = ::strtolower(m_request.headers.find("Connection")) == "keep-alive";
+                                    m_persistent = m_connectionManager.persistent(self, keepAlive);
+
                                     m_continue = false;
                                     m_contResult = HTTPLexer::INDETERMINATE;
                                     m_requestHandler.handleRequest(m_request, m_reply);
@@ -191,7 +214,12 @@ namespace network
                                         Utils::dump(1U, "HTTP Reply Content", (uint8_t*)m_reply.content.c_str(), m_reply.content.length());
                                     }
 
-                                    write();
+                                    if (m_reply.eventStream != nullptr) {
+                                        startStream();
+                                    }
+                                    else {
+                                        write();
+                                    }
                                 }
                                 else if (result == HTTPLexer::BAD) {
                                     m_continue = false;
@@ -210,35 +238,63 @@ namespace network
                             }
                         }
                         else if (ec != asio::error::operation_aborted) {
-                            if (ec) {
+                            // a persistent connection being closed by the client is not an error
+                            if (ec && ec != asio::error::eof && ec != asio::error::connection_reset) {
                                 ::LogError(LOG_REST, "SecureServerConnection::read(), %s, code = %u", ec.message().c_str(), ec.value());
                             }
-                            m_connectionManager.stop(this->shared_from_this());
+                            m_connectionManager.stop(self);
                             m_continue = false;
                         }
                     });
                 }
 
+                /**
+                 * @brief Start (or restart) the idle timer, closing the connection if nothing is read
+                 *  before it expires.
+                 */
+                void waitIdle()
+                {
+                    auto self(this->shared_from_this());
+
+                    m_idleTimer.expires_after(std::chrono::milliseconds(HTTP_SERVER_IDLE_TIMEOUT_MS));
+                    m_idleTimer.async_wait([this, self](asio::error_code ec) {
+                        // the timer may have been restarted or parked after this wait already expired
+                        if (ec == asio::error::operation_aborted || m_idleTimer.expiry() > asio::steady_timer::clock_type::now()) {
+                            return;
+                        }
+
+                        if (m_debug) {
+                            LogDebug(LOG_REST, "SecureServerConnection::waitIdle(), idle connection timed out");
+                        }
+                        m_connectionManager.stop(self);
+                    });
+                }
+
                 /**
                  * @brief Perform an asynchronous write operation.
                  */
                 void write()
                 {
-                    if (!m_persistent) {
-                        auto self(this->shared_from_this());
-                    } else {
+                    // hold a reference until the operation completes, the connection manager may have
+                    // already released a persistent connection by then (i.e. on shutdown)
+                    auto self(this->shared_from_this());
+                    if (m_persistent) {
                         m_reply.headers.add("Connection", "keep-alive");
                     }
 
                     auto buffers = m_reply.toBuffers();
-                    asio::async_write(m_socket, buffers, [=](asio::error_code ec, std::size_t) {
-                        if (m_persistent) {
+                    asio::async_write(m_socket, buffers, [this, self](asio::error_code ec, std::size_t) {
+                        if (m_persistent && !ec) {
                             m_lexer.reset();
                             m_reply.headers = HTTPHeaders();
                             m_reply.status = HTTPPayload::OK;
                             m_reply.content = "";
                             m_request = HTTPPayload();
-                            read();
+
+                            // the connection may have been stopped while the reply was being written
+                            if (m_socket.lowest_layer().is_open()) {
+                                read();
+                            }
                         }
                         else {
                             if (!ec) {
@@ -255,13 +311,101 @@ namespace network
                                 if (ec) {
                                     ::LogError(LOG_REST, "SecureServerConnection::write(), %s, code = %u", ec.message().c_str(), ec.value());
                                 }
-                                m_connectionManager.stop(this->shared_from_this());
+                                m_connectionManager.stop(self);
                             }
                         }
                     });
                 }
 
+                /**
+                 * @brief Start writing an event stream. The reply headers are written first, and then the events
+                 *  queued to the subscriber as they are published.
+                 */
+                void startStream()
+                {
+                    auto self(this->shared_from_this());
+
+                    m_subscriber = m_reply.eventStream;
+                    m_reply.eventStream = nullptr;
+
+                    // events are published on other threads, hand them over to the IO thread
+                    std::weak_ptr<selfType> weak = self;
+                    auto executor = m_socket.get_executor();
+                    m_subscriber->setNotifyCallback([weak, executor]() {
+                        asio::post(executor, [weak]() {
+                            selfTypePtr connection = weak.lock();
+                            if (connection != nullptr) {
+                                connection->writeStream();
+                            }
+                        });
+                    });
+
+                    m_streamWriting = true;
+                    auto buffers = m_reply.toBuffers();
+                    asio::async_write(m_socket, buffers, [this, self](asio::error_code ec, std::size_t) {
+                        m_streamWriting = false;
+                        if (ec) {
+                            if (ec != asio::error::operation_aborted) {
+                                m_connectionManager.stop(self);
+                            }
+                            return;
+                        }
+
+                        writeStream();
+                    });
+
+                    readStream();
+                }
+
+                /**
+                 * @brief Write any queued events to the event stream.
+                 */
+                void writeStream()
+                {
+                    if (m_streamWriting || !m_socket.lowest_layer().is_open()) {
+                        return;
+                    }
+
+                    if (!m_subscriber->take(m_streamBuffer)) {
+                        return;
+                    }
+
+                    auto self(this->shared_from_this());
+                    m_streamWriting = true;
+                    asio::async_write(m_socket, asio::buffer(m_streamBuffer), [this, self](asio::error_code ec, std::size_t) {
+                        m_streamWriting = false;
+                        if (ec) {
+                            if (ec != asio::error::operation_aborted) {
+                                m_connectionManager.stop(self);
+                            }
+                            return;
+                        }
+
+                        // anything published while this write was outstanding
+                        writeStream();
+                    });
+                }
+
+                /**
+                 * @brief Perform an asynchronous read operation on an event stream. The client does not send
+                 *  anything after the request, this only detects the client closing the connection.
+                 */
+                void readStream()
+                {
+                    auto self(this->shared_from_this());
+
+                    m_socket.async_read_some(asio::buffer(m_buffer), [this, self](asio::error_code ec, std::size_t) {
+                        if (!ec) {
+                            readStream();
+                        }
+                        else if (ec != asio::error::operation_aborted) {
+                            m_connectionManager.stop(self);
+                        }
+                    });
+                }
+
                 asio::ssl::stream<asio::ip::tcp::socket> m_socket;
+                asio::steady_timer m_idleTimer;
 
                 ConnectionManagerType& m_connectionManager;
                 RequestHandlerType& m_requestHandler;
@@ -276,6 +420,11 @@ namespace network
                 HTTPLexer::ResultType m_contResult;
 
                 bool m_persistent;
+
+                std::shared_ptr<EventStreamSubscriber> m_subscriber;
+                std::string m_streamBuffer;
+                bool m_streamWriting;
+
                 bool m_debug;
             };
         } // namespace http
@@ -26,6 +26,15 @@ namespace network
     {
         namespace http
         {
+            // ---------------------------------------------------------------------------
+            //  Constants
+            // ---------------------------------------------------------------------------
+
+            // connections left idle longer than this are closed (matches the idle timeout of pooled
+            // client connections)
+            const uint32_t HTTP_SERVER_IDLE_TIMEOUT_MS = 30000U;
+            // maximum number of connections kept open at once for clients asking for keep-alive
+            const size_t HTTP_SERVER_MAX_PERSISTENT = 32U;
 
             // ---------------------------------------------------------------------------
             //  Class Declaration
@@ -71,24 +80,56 @@ namespace network
                     std::lock_guard<std::mutex> guard(m_lock);
                     {
                         m_connections.erase(c);
+                        m_persistent.erase(c);
                     }
                     c->stop();
                 }
 
+                /**
+                 * @brief Sets whether or not the specified connection is kept open after its reply. A
+                 *  connection is only made persistent while fewer than HTTP_SERVER_MAX_PERSISTENT are.
+                 * @param c 
+                 * @param persistent Flag indicating whether or not the client asked for the connection to be kept open.
+                 * @returns bool True, if the connection is persistent, otherwise false.
+                 */
+                bool persistent(ConnectionPtr c, bool persistent)
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    if (!persistent) {
+                        m_persistent.erase(c);
+                        return false;
+                    }
+
+                    if (m_persistent.find(c) != m_persistent.end())
+                        return true;
+                    if (m_persistent.size() >= HTTP_SERVER_MAX_PERSISTENT)
+                        return false;
+
+                    m_persistent.insert(c);
+                    return true;
+                }
+
                 /**
                  * @brief Stop all connections.
                  */
                 void stopAll()
                 {
-                    for (auto c : m_connections)
-                        c->stop();
+                    // connections stop themselves (and erase themselves from the set) when their operations
+                    // fail, so take the set before stopping them
+                    std::set<ConnectionPtr> connections;
+                    {
+                        std::lock_guard<std::mutex> guard(m_lock);
+                        connections.swap(m_connections);
+                        m_persistent.clear();
+                    }
 
-                    std::lock_guard<std::mutex> guard(m_lock);
-                    m_connections.clear();
+                    for (auto c : connections)
+                        c->stop();
                 }
 
             private:
                 std::set<ConnectionPtr> m_connections;
+                std::set<ConnectionPtr> m_persistent;
                 std::mutex m_lock;
             };
         } // namespace http
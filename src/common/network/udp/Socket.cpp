@@ -11,6 +11,7 @@
 #include "Defines.h"
 #include "network/udp/Socket.h"
 #include "Log.h"
+#include "Thread.h"
 #include "Utils.h"
 
 using namespace network;
@@ -48,7 +49,8 @@ Socket::Socket(const std::string& address, uint16_t port) :
     m_aes(nullptr),
     m_isCryptoWrapped(false),
     m_presharedKey(nullptr),
-    m_counter(0U)
+    m_counter(0U),
+    m_reusePort(false)
 {
     m_aes = new crypto::AES(crypto::AESKeyLength::AES_256);
     m_presharedKey = new uint8_t[AES_WRAPPED_PCKT_KEY_LEN];
@@ -76,7 +78,8 @@ Socket::Socket(uint16_t port) :
     m_aes(nullptr),
     m_isCryptoWrapped(false),
     m_presharedKey(nullptr),
-    m_counter(0U)
+    m_counter(0U),
+    m_reusePort(false)
 {
     m_aes = new crypto::AES(crypto::AESKeyLength::AES_256);
     m_presharedKey = new uint8_t[AES_WRAPPED_PCKT_KEY_LEN];
@@ -149,6 +152,15 @@ bool Socket::open(const uint32_t af, const std::string& address, const uint16_t
             return false;
         }
 
+#if defined(SO_REUSEPORT)
+        if (m_reusePort) {
+            if (::setsockopt(m_fd, SOL_SOCKET, SO_REUSEPORT, (char*)& reuse, sizeof(reuse)) == -1) {
+                LogError(LOG_NET, "Cannot set the UDP socket option, err: %d", errno);
+                return false;
+            }
+        }
+#endif // defined(SO_REUSEPORT)
+
         if (!bind(address, port)) {
             return false;
         }
@@ -286,6 +298,75 @@ ssize_t Socket::read(uint8_t* buffer, uint32_t length, sockaddr_storage& address
     return len;
 }
 
+/* Read multiple datagrams from the UDP socket. */
+
+int Socket::read(UDPDatagram* datagrams, uint32_t count) noexcept
+{
+    assert(datagrams != nullptr);
+    assert(count > 0U);
+
+#if defined(__linux__)
+    if (m_fd < 0)
+        return -1;
+
+    // crypto wrapped datagrams are unwrapped one at a time
+    if (!m_isCryptoWrapped) {
+        if (count > MAX_BUFFER_COUNT)
+            count = MAX_BUFFER_COUNT;
+
+        struct mmsghdr headers[MAX_BUFFER_COUNT];
+        struct iovec chunks[MAX_BUFFER_COUNT];
+        for (uint32_t i = 0U; i < count; i++) {
+            assert(datagrams[i].buffer != nullptr);
+
+            chunks[i].iov_base = datagrams[i].buffer;
+            chunks[i].iov_len = datagrams[i].length;
+
+            ::memset(&headers[i], 0x00U, sizeof(struct mmsghdr));
+            headers[i].msg_hdr.msg_name = &datagrams[i].address;
+            headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+            headers[i].msg_hdr.msg_iov = &chunks[i];
+            headers[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int ret = ::recvmmsg(m_fd, headers, count, MSG_DONTWAIT, nullptr);
+        if (ret < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+                return 0;
+
+            LogError(LOG_NET, "Error returned from recvmmsg, err: %d", errno);
+            return -1;
+        }
+
+        for (int i = 0; i < ret; i++) {
+            datagrams[i].length = headers[i].msg_len;
+            datagrams[i].addrLen = headers[i].msg_hdr.msg_namelen;
+
+            // truncated datagrams are returned empty
+            if ((headers[i].msg_hdr.msg_flags & MSG_TRUNC) != 0)
+                datagrams[i].length = 0U;
+        }
+
+        m_counter += ret;
+        return ret;
+    }
+#endif // defined(__linux__)
+
+    int received = 0;
+    for (uint32_t i = 0U; i < count; i++) {
+        ssize_t len = read(datagrams[i].buffer, datagrams[i].length, datagrams[i].address, datagrams[i].addrLen);
+        if (len < 0)
+            return (received > 0) ? received : -1;
+        if (len == 0)
+            break;
+
+        datagrams[i].length = len;
+        received++;
+    }
+
+    return received;
+}
+
 /* Write data to the UDP socket. */
 
 bool Socket::write(const uint8_t* buffer, uint32_t length, const sockaddr_storage& address, uint32_t addrLen, ssize_t* lenWritten) noexcept
@@ -586,6 +667,134 @@ void Socket::setPresharedKey(const uint8_t* presharedKey)
     }
 }
 
+/* Helper to join an IPv4 multicast group on the UDP socket. */
+
+bool Socket::joinMulticastGroup(const std::string& group, const std::string& iface)
+{
+#if defined(_WIN32)
+    if (m_fd == INVALID_SOCKET)
+        return false;
+#else
+    if (m_fd < 0)
+        return false;
+#endif // defined(_WIN32)
+
+    struct ip_mreq mreq;
+    ::memset(&mreq, 0x00U, sizeof(mreq));
+    if (::inet_pton(AF_INET, group.c_str(), &mreq.imr_multiaddr) <= 0) {
+        LogError(LOG_NET, "Invalid multicast group address - %s", group.c_str());
+        return false;
+    }
+
+    mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+    if (!iface.empty() && iface != "0.0.0.0") {
+        if (::inet_pton(AF_INET, iface.c_str(), &mreq.imr_interface) <= 0) {
+            LogError(LOG_NET, "Invalid multicast interface address - %s", iface.c_str());
+            return false;
+        }
+    }
+
+    if (::setsockopt(m_fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, (char*)&mreq, sizeof(mreq)) == -1) {
+#if defined(_WIN32)
+        LogError(LOG_NET, "Cannot join the UDP multicast group %s, err: %lu", group.c_str(), ::GetLastError());
+#else
+        LogError(LOG_NET, "Cannot join the UDP multicast group %s, err: %d", group.c_str(), errno);
+#endif // defined(_WIN32)
+        return false;
+    }
+
+    return true;
+}
+
+/* Helper to set the outbound IPv4 multicast options of the UDP socket. */
+
+bool Socket::setMulticastOptions(const std::string& iface, uint8_t ttl, bool loopback)
+{
+#if defined(_WIN32)
+    if (m_fd == INVALID_SOCKET)
+        return false;
+#else
+    if (m_fd < 0)
+        return false;
+#endif // defined(_WIN32)
+
+    int mcastTTL = ttl;
+    if (::setsockopt(m_fd, IPPROTO_IP, IP_MULTICAST_TTL, (char*)&mcastTTL, sizeof(mcastTTL)) == -1) {
+        LogError(LOG_NET, "Cannot set the UDP multicast TTL, err: %d", errno);
+        return false;
+    }
+
+    int mcastLoop = loopback ? 1 : 0;
+    if (::setsockopt(m_fd, IPPROTO_IP, IP_MULTICAST_LOOP, (char*)&mcastLoop, sizeof(mcastLoop)) == -1) {
+        LogError(LOG_NET, "Cannot set the UDP multicast loopback, err: %d", errno);
+        return false;
+    }
+
+    if (!iface.empty() && iface != "0.0.0.0") {
+        struct in_addr addr;
+        if (::inet_pton(AF_INET, iface.c_str(), &addr) <= 0) {
+            LogError(LOG_NET, "Invalid multicast interface address - %s", iface.c_str());
+            return false;
+        }
+
+        if (::setsockopt(m_fd, IPPROTO_IP, IP_MULTICAST_IF, (char*)&addr, sizeof(addr)) == -1) {
+            LogError(LOG_NET, "Cannot set the UDP multicast interface, err: %d", errno);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Helper to block until any of the given UDP sockets has data to read. */
+
+bool Socket::wait(const std::vector<Socket*>& sockets, int timeout)
+{
+    std::vector<struct pollfd> pfds;
+    for (Socket* socket : sockets) {
+        if (socket == nullptr)
+            continue;
+#if defined(_WIN32)
+        if (socket->m_fd == INVALID_SOCKET)
+            continue;
+#else
+        if (socket->m_fd < 0)
+            continue;
+#endif // defined(_WIN32)
+
+        struct pollfd pfd;
+        pfd.fd = socket->m_fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        pfds.push_back(pfd);
+    }
+
+    // nothing open to wait on, just wait out the timeout
+    if (pfds.empty()) {
+        if (timeout > 0)
+            Thread::sleep((uint32_t)timeout);
+        return false;
+    }
+
+#if defined(_WIN32)
+    int ret = WSAPoll(pfds.data(), (ULONG)pfds.size(), timeout);
+#else
+    int ret = ::poll(pfds.data(), (nfds_t)pfds.size(), timeout);
+#endif // defined(_WIN32)
+    if (ret < 0) {
+#if defined(_WIN32)
+        LogError(LOG_NET, "Error returned from UDP poll, err: %lu", ::GetLastError());
+#else
+        if (errno == EINTR)
+            return false;
+        LogError(LOG_NET, "Error returned from UDP poll, err: %d", errno);
+#endif // defined(_WIN32)
+        return false;
+    }
+
+    return ret > 0;
+}
+
 /* Helper to lookup a hostname and resolve it to an IP address. */
 
 int Socket::lookup(const std::string& hostname, uint16_t port, sockaddr_storage& address, uint32_t& addrLen)
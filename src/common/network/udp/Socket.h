@@ -236,6 +236,15 @@ namespace network
              * @returns ssize_t Actual length of data read from remote UDP socket.
              */
             virtual ssize_t read(uint8_t* buffer, uint32_t length, sockaddr_storage& address, uint32_t& addrLen) noexcept;
+            /**
+             * @brief Read multiple datagrams from the UDP socket, with a single system call where
+             *  supported (recvmmsg).
+             * @param[in,out] datagrams Datagrams to read into; on entry, the buffer and length of each datagram
+             *  are the preallocated buffer and its size, on return, the length is the length of data read.
+             * @param count Number of datagrams.
+             * @returns int Number of datagrams read, or -1 on error.
+             */
+            virtual int read(UDPDatagram* datagrams, uint32_t count) noexcept;
             /**
              * @brief Write data to the UDP socket.
              * @param[in] buffer Buffer containing data to write to socket.
@@ -260,6 +269,37 @@ namespace network
              */
             void setPresharedKey(const uint8_t* presharedKey);
 
+            /**
+             * @brief Helper to join an IPv4 multicast group on the UDP socket.
+             * @param group Multicast group address.
+             * @param iface Address of the local interface to join the group on (blank for any).
+             * @returns bool True, if the multicast group was joined, otherwise false.
+             */
+            bool joinMulticastGroup(const std::string& group, const std::string& iface = "");
+            /**
+             * @brief Helper to set the outbound IPv4 multicast options of the UDP socket.
+             * @param iface Address of the local interface to send multicast from (blank for default).
+             * @param ttl Multicast time-to-live.
+             * @param loopback Flag indicating whether multicast is looped back to the local host.
+             * @returns bool True, if the multicast options were set, otherwise false.
+             */
+            bool setMulticastOptions(const std::string& iface, uint8_t ttl, bool loopback);
+            /**
+             * @brief Helper to set whether the UDP socket binds with SO_REUSEPORT. This allows several
+             *  sockets to share the same local port, with the kernel distributing received datagrams
+             *  between them by flow hash. Must be set before the socket is opened.
+             * @param reusePort Flag indicating whether SO_REUSEPORT is set.
+             */
+            void setReusePort(bool reusePort) { m_reusePort = reusePort; }
+
+            /**
+             * @brief Helper to block until any of the given UDP sockets has data to read.
+             * @param sockets List of sockets to wait on (closed sockets are ignored).
+             * @param timeout Maximum time to wait (in ms).
+             * @returns bool True, if data is available to read, otherwise false.
+             */
+            static bool wait(const std::vector<Socket*>& sockets, int timeout);
+
             /**
              * @brief Helper to lookup a hostname and resolve it to an IP address.
              * @param hostname String containing hostname to resolve.
@@ -332,6 +372,8 @@ namespace network
 
             uint32_t m_counter;
 
+            bool m_reusePort;
+
             /**
              * @brief Internal helper to initialize the socket.
              * @param domain Address family type.
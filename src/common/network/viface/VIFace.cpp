@@ -89,7 +89,7 @@ void hookVirtualInterface(std::string name, struct viface_queues* queues)
     int i = 0;
     for (i = 0; i < 2; i++) {
         // creates the socket
-        fd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+        fd = socket(AF_PACKET, SOCK_RAW | SOCK_NONBLOCK, htons(ETH_P_ALL));
         if (fd < 0) {
             LogError(LOG_NET, "Unable to create the Tx/Rx socket channel %s, queue: %d, err: %d, error: %s", name.c_str(), i, errno, strerror(errno));
             goto hookErr; // bryanb: no good very bad way to handle this -- but if its good enough for the Linux kernel its good enough for us right? this is easiset way to clean up quickly...
@@ -350,6 +350,9 @@ VIFace::~VIFace()
     close(m_queues.rxFd);
     close(m_queues.txFd);
     close(m_ksFd);
+    if (m_epollFd != -1) {
+        close(m_epollFd);
+    }
 }
 
 /* Bring up the virtual interface. */
@@ -499,6 +502,51 @@ ssize_t VIFace::read(uint8_t* buffer)
     return -1;
 }
 
+/* Read multiple packets from the virtual interface. */
+
+int VIFace::read(uint8_t* buffers, uint32_t stride, ssize_t* lengths, uint32_t count, int timeout)
+{
+    assert(buffers != nullptr);
+    assert(lengths != nullptr);
+    assert(stride > 0U);
+
+    struct epoll_event events[2U];
+
+    int ret = epoll_wait(m_epollFd, events, 2, timeout);
+    if (ret < 0) {
+        if (errno == EINTR) {
+            return 0;
+        }
+
+        LogError(LOG_NET, "Error returned from epoll_wait, err: %d, error: %s", errno, strerror(errno));
+        return -1;
+    }
+
+    // the queue descriptors are non-blocking, drain each ready queue until it would block
+    uint32_t n = 0U;
+    for (int i = 0; i < ret && n < count; i++) {
+        while (n < count) {
+            ssize_t len = ::read(events[i].data.fd, buffers + (n * stride), stride);
+            if (len < 0) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    LogError(LOG_NET, "Error returned from read, err: %d, error: %s", errno, strerror(errno));
+                }
+
+                break;
+            }
+
+            if (len == 0) {
+                break;
+            }
+
+            lengths[n] = len;
+            n++;
+        }
+    }
+
+    return (int)n;
+}
+
 /* Write a packet to this virtual interface. */
 
 bool VIFace::write(const uint8_t* buffer, uint32_t length, ssize_t* lenWritten)
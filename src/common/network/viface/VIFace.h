@@ -106,6 +106,22 @@ namespace network
              * @returns ssize_t Actual length of data read from remote UDP socket.
              */
             ssize_t read(uint8_t* buffer);
+            /**
+             * @brief Read multiple packets from the virtual interface.
+             *
+             * Note: This waits up to the given timeout for the virtual interface to
+             * become readable, and then drains up to count packets from both of the
+             * interface queues without waiting again. Packet n is written to
+             * buffers + (n * stride).
+             *
+             * @param[out] buffers Buffer of at least count * stride bytes to read packets into.
+             * @param stride Size of each packet buffer.
+             * @param[out] lengths Lengths of the packets read.
+             * @param count Maximum number of packets to read.
+             * @param timeout Time (in ms) to wait for a packet, 0 to return immediately, -1 to wait indefinitely.
+             * @returns int Number of packets read, or -1 on error.
+             */
+            int read(uint8_t* buffers, uint32_t stride, ssize_t* lengths, uint32_t count, int timeout);
             /**
              * @brief Write a packet to this virtual interface.
              *
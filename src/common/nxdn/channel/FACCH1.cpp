@@ -121,21 +121,11 @@ bool FACCH1::decode(const uint8_t* data, uint32_t offset)
 
     // decode convolution
     edac::Convolution conv;
-    conv.start();
-
-    n = 0U;
-    for (uint32_t i = 0U; i < (NXDN_FACCH1_CRC_LENGTH_BITS + 4U); i++) {
-        uint8_t s0 = puncture[n++];
-        uint8_t s1 = puncture[n++];
-
-        if (!conv.decode(s0, s1)) {
-            LogError(LOG_NXDN, "FACCH1::decode(), failed to decode convolution, i = %u, n = %u", i);
-            return false;
-        }
+    if (!conv.decode(puncture, m_data, NXDN_FACCH1_CRC_LENGTH_BITS)) {
+        LogError(LOG_NXDN, "FACCH1::decode(), failed to decode convolution");
+        return false;
     }
 
-    conv.chainback(m_data, NXDN_FACCH1_CRC_LENGTH_BITS);
-
 #if DEBUG_NXDN_FACCH1
     Utils::dump(2U, "Decoded FACCH1", m_data, NXDN_FACCH1_CRC_LENGTH_BYTES);
 #endif
@@ -5,7 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2015,2016,2018,2021 Jonathan Naylor, G4KLX
- *  Copyright (C) 2022 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2022,2024 Bryan Biedenkapp, N2PLL
  *
  */
 #include "nxdn/edac/Convolution.h"
@@ -17,6 +17,14 @@ using namespace nxdn::edac;
 #include <cstring>
 #include <cstdlib>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define CONVOLUTION_SIMD 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CONVOLUTION_SIMD 1
+#endif
+
 // ---------------------------------------------------------------------------
 //  Constants
 // ---------------------------------------------------------------------------
@@ -29,6 +37,8 @@ const uint32_t NUM_OF_STATES = 16U;
 const uint32_t M = 4U;
 const uint32_t K = 5U;
 
+const uint32_t MAX_DECISIONS = 300U;
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -36,26 +46,19 @@ const uint32_t K = 5U;
 /* Initializes a new instance of the Convolution class. */
 
 Convolution::Convolution() :
-    m_metrics1(nullptr),
-    m_metrics2(nullptr),
-    m_oldMetrics(nullptr),
-    m_newMetrics(nullptr),
-    m_decisions(nullptr),
-    m_dp(nullptr)
+    m_metrics1(),
+    m_metrics2(),
+    m_oldMetrics(m_metrics1),
+    m_newMetrics(m_metrics2),
+    m_decisions(),
+    m_dp(m_decisions)
 {
-    m_metrics1  = new uint16_t[20U];
-    m_metrics2  = new uint16_t[20U];
-    m_decisions = new uint64_t[300U];
+    /* stub */
 }
 
 /* Finalizes a instance of the Convolution class. */
 
-Convolution::~Convolution()
-{
-    delete[] m_metrics1;
-    delete[] m_metrics2;
-    delete[] m_decisions;
-}
+Convolution::~Convolution() = default;
 
 /* Starts convolution processing. */
 
@@ -101,6 +104,10 @@ uint32_t Convolution::chainback(uint8_t* out, uint32_t nBits)
 
 bool Convolution::decode(uint8_t s0, uint8_t s1)
 {
+    if ((uint32_t)(m_dp - m_decisions) >= MAX_DECISIONS) {
+        return false;
+    }
+
     *m_dp = 0U;
 
     for (uint8_t i = 0U; i < NUM_OF_STATES_D2; i++) {
@@ -118,15 +125,11 @@ bool Convolution::decode(uint8_t s0, uint8_t s1)
         uint8_t decision1 = (m0 >= m1) ? 1U : 0U;
         m_newMetrics[j + 1U] = decision1 != 0U ? m1 : m0;
 
-        *m_dp |= (uint64_t(decision1) << (j + 1U)) | (uint64_t(decision0) << (j + 0U));
+        *m_dp |= (uint16_t(decision1) << (j + 1U)) | (uint16_t(decision0) << (j + 0U));
     }
 
     ++m_dp;
 
-    if ((m_dp - m_decisions) > 300) {
-        return false;
-    }
-
     uint16_t* tmp = m_oldMetrics;
     m_oldMetrics = m_newMetrics;
     m_newMetrics = tmp;
@@ -134,6 +137,110 @@ bool Convolution::decode(uint8_t s0, uint8_t s1)
     return true;
 }
 
+/* Decodes a whole convolution coded block. */
+
+bool Convolution::decode(const uint8_t* in, uint8_t* out, uint32_t nBits)
+{
+    assert(in != nullptr);
+    assert(out != nullptr);
+
+    uint32_t nSymbols = nBits + (K - 1U);
+    if (nSymbols > MAX_DECISIONS) {
+        return false;
+    }
+
+    start();
+
+#if defined(CONVOLUTION_SIMD)
+    /*
+    ** each step is 8 butterflies; states i and i + 8 feed new states 2i and 2i + 1, so the low
+    ** and high halves of the metrics are one vector each, and the even and odd results are
+    ** interleaved back into place
+    */
+#if defined(__SSE2__)
+    const __m128i table1 = _mm_setr_epi16(0, 0, 0, 0, 2, 2, 2, 2);
+    const __m128i table2 = _mm_setr_epi16(0, 2, 2, 0, 0, 2, 2, 0);
+    const __m128i maxMetric = _mm_set1_epi16(M);
+    const __m128i zero = _mm_setzero_si128();
+
+    // metrics stay well below 32768 for a block of MAX_DECISIONS, so signed compares are safe
+    __m128i lo = zero;
+    __m128i hi = zero;
+    for (uint32_t i = 0U; i < nSymbols; i++) {
+        __m128i d0 = _mm_sub_epi16(table1, _mm_set1_epi16(in[i * 2U + 0U]));
+        __m128i d1 = _mm_sub_epi16(table2, _mm_set1_epi16(in[i * 2U + 1U]));
+        __m128i metric = _mm_add_epi16(_mm_max_epi16(d0, _mm_sub_epi16(zero, d0)), _mm_max_epi16(d1, _mm_sub_epi16(zero, d1)));
+        __m128i inverse = _mm_sub_epi16(maxMetric, metric);
+
+        __m128i m0 = _mm_add_epi16(lo, metric);
+        __m128i m1 = _mm_add_epi16(hi, inverse);
+        __m128i even = _mm_min_epi16(m0, m1);
+        __m128i evenDecision = _mm_cmpeq_epi16(even, m1);
+
+        m0 = _mm_add_epi16(lo, inverse);
+        m1 = _mm_add_epi16(hi, metric);
+        __m128i odd = _mm_min_epi16(m0, m1);
+        __m128i oddDecision = _mm_cmpeq_epi16(odd, m1);
+
+        lo = _mm_unpacklo_epi16(even, odd);
+        hi = _mm_unpackhi_epi16(even, odd);
+
+        __m128i decisions = _mm_packs_epi16(_mm_unpacklo_epi16(evenDecision, oddDecision), _mm_unpackhi_epi16(evenDecision, oddDecision));
+        *m_dp++ = (uint16_t)_mm_movemask_epi8(decisions);
+    }
+
+    _mm_storeu_si128((__m128i*)(m_oldMetrics + 0U), lo);
+    _mm_storeu_si128((__m128i*)(m_oldMetrics + NUM_OF_STATES_D2), hi);
+#else
+    const int16_t table1Values[] = { 0, 0, 0, 0, 2, 2, 2, 2 };
+    const int16_t table2Values[] = { 0, 2, 2, 0, 0, 2, 2, 0 };
+    const uint16_t weightValues[] = { 0x01U, 0x02U, 0x04U, 0x08U, 0x10U, 0x20U, 0x40U, 0x80U };
+
+    const int16x8_t table1 = vld1q_s16(table1Values);
+    const int16x8_t table2 = vld1q_s16(table2Values);
+    const uint16x8_t weights = vld1q_u16(weightValues);
+    const int16x8_t maxMetric = vdupq_n_s16(M);
+
+    int16x8_t lo = vdupq_n_s16(0);
+    int16x8_t hi = vdupq_n_s16(0);
+    for (uint32_t i = 0U; i < nSymbols; i++) {
+        int16x8_t metric = vaddq_s16(vabdq_s16(table1, vdupq_n_s16(in[i * 2U + 0U])), vabdq_s16(table2, vdupq_n_s16(in[i * 2U + 1U])));
+        int16x8_t inverse = vsubq_s16(maxMetric, metric);
+
+        int16x8_t m0 = vaddq_s16(lo, metric);
+        int16x8_t m1 = vaddq_s16(hi, inverse);
+        int16x8_t even = vminq_s16(m0, m1);
+        uint16x8_t evenDecision = vcgeq_s16(m0, m1);
+
+        m0 = vaddq_s16(lo, inverse);
+        m1 = vaddq_s16(hi, metric);
+        int16x8_t odd = vminq_s16(m0, m1);
+        uint16x8_t oddDecision = vcgeq_s16(m0, m1);
+
+        int16x8x2_t metrics = vzipq_s16(even, odd);
+        lo = metrics.val[0];
+        hi = metrics.val[1];
+
+        uint16x8x2_t decisions = vzipq_u16(evenDecision, oddDecision);
+        uint64x2_t bitsLo = vpaddlq_u32(vpaddlq_u16(vandq_u16(decisions.val[0], weights)));
+        uint64x2_t bitsHi = vpaddlq_u32(vpaddlq_u16(vandq_u16(decisions.val[1], weights)));
+        *m_dp++ = (uint16_t)((vgetq_lane_u64(bitsLo, 0) + vgetq_lane_u64(bitsLo, 1)) |
+            ((vgetq_lane_u64(bitsHi, 0) + vgetq_lane_u64(bitsHi, 1)) << 8));
+    }
+
+    vst1q_s16((int16_t*)(m_oldMetrics + 0U), lo);
+    vst1q_s16((int16_t*)(m_oldMetrics + NUM_OF_STATES_D2), hi);
+#endif // defined(__SSE2__)
+#else
+    for (uint32_t i = 0U; i < nSymbols; i++) {
+        decode(in[i * 2U + 0U], in[i * 2U + 1U]);
+    }
+#endif // defined(CONVOLUTION_SIMD)
+
+    chainback(out, nBits);
+    return true;
+}
+
 /* */
 
 void Convolution::encode(const uint8_t* in, uint8_t* out, uint32_t nBits) const
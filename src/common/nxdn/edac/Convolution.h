@@ -5,7 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2015,2016,2018,2021 Jonathan Naylor, G4KLX
- *  Copyright (C) 2022 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2022,2024 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -36,6 +36,10 @@ namespace nxdn
         /**
          * @brief Implements NXDN frame convolution processing.
          * @ingroup nxdn_edac
+         *
+         *  The block decoder keeps all 16 path metrics in vector registers for the whole
+         *  frame (SSE2 or NEON where available), and falls back to the per-symbol decoder
+         *  otherwise.
          */
         class HOST_SW_API Convolution {
         public:
@@ -67,6 +71,16 @@ namespace nxdn
              * @returns bool
              */
             bool decode(uint8_t s0, uint8_t s1);
+            /**
+             * @brief Decodes a whole convolution coded block; this starts convolution processing,
+             *  runs the trellis over all symbol pairs and chains back the decoded bits.
+             * @param[in] in Depunctured soft symbols (0, 1 for a punctured symbol, or 2), 2 per
+             *  decoded bit plus the 4 flush bits.
+             * @param[out] out Decoded bits.
+             * @param nBits Number of decoded bits (excluding the 4 flush bits).
+             * @returns bool True, if the block was decoded, otherwise false.
+             */
+            bool decode(const uint8_t* in, uint8_t* out, uint32_t nBits);
             /**
              * @brief 
              * @param[in] in 
@@ -76,15 +90,15 @@ namespace nxdn
             void encode(const uint8_t* in, uint8_t* out, uint32_t nBits) const;
 
         private:
-            uint16_t* m_metrics1;
-            uint16_t* m_metrics2;
+            uint16_t m_metrics1[16U];
+            uint16_t m_metrics2[16U];
 
             uint16_t* m_oldMetrics;
             uint16_t* m_newMetrics;
 
-            uint64_t* m_decisions;
+            uint16_t m_decisions[300U];
 
-            uint64_t* m_dp;
+            uint16_t* m_dp;
         };
     } // namespace edac
 } // namespace nxdn
@@ -34,6 +34,37 @@ RCCHFactory::~RCCHFactory() = default;
 /* Create an instance of a RCCH. */
 
 std::unique_ptr<RCCH> RCCHFactory::createRCCH(const uint8_t* data, uint32_t length, uint32_t offset)
+{
+    return std::unique_ptr<RCCH>(create(data, length, offset, nullptr));
+}
+
+/* Decode a RCCH into caller provided storage, without allocating. */
+
+RCCH* RCCHFactory::decodeRCCH(const uint8_t* data, uint32_t length, RCCHStorage& storage, uint32_t offset)
+{
+    storage.reset();
+    return create(data, length, offset, &storage);
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Internal helper to decode a RCCH link control message. */
+
+template<class T>
+RCCH* RCCHFactory::decode(const uint8_t* data, uint32_t length, uint32_t offset, RCCHStorage* storage)
+{
+    assert(data != nullptr);
+
+    T* rcch = (storage != nullptr) ? storage->emplace<T>() : new T();
+    rcch->decode(data, length, offset);
+    return rcch;
+}
+
+/* Decode a RCCH, into the given storage or a new heap instance. */
+
+RCCH* RCCHFactory::create(const uint8_t* data, uint32_t length, uint32_t offset, RCCHStorage* storage)
 {
     assert(data != nullptr);
 
@@ -43,17 +74,17 @@ std::unique_ptr<RCCH> RCCHFactory::createRCCH(const uint8_t* data, uint32_t leng
     switch (messageType) {
     case MessageType::RTCH_VCALL:
     case MessageType::RCCH_VCALL_CONN:
-        return decode(new MESSAGE_TYPE_VCALL_CONN(), data, length, offset);
+        return decode<MESSAGE_TYPE_VCALL_CONN>(data, length, offset, storage);
     case MessageType::RTCH_DCALL_HDR:
-        return decode(new MESSAGE_TYPE_DCALL_HDR(), data, length, offset);
+        return decode<MESSAGE_TYPE_DCALL_HDR>(data, length, offset, storage);
     case MessageType::IDLE:
-        return decode(new MESSAGE_TYPE_IDLE(), data, length, offset);
+        return decode<MESSAGE_TYPE_IDLE>(data, length, offset, storage);
     case MessageType::RCCH_REG:
-        return decode(new MESSAGE_TYPE_REG(), data, length, offset);
+        return decode<MESSAGE_TYPE_REG>(data, length, offset, storage);
     case MessageType::RCCH_REG_C:
-        return decode(new MESSAGE_TYPE_REG_C(), data, length, offset);
+        return decode<MESSAGE_TYPE_REG_C>(data, length, offset, storage);
     case MessageType::RCCH_GRP_REG:
-        return decode(new MESSAGE_TYPE_GRP_REG(), data, length, offset);
+        return decode<MESSAGE_TYPE_GRP_REG>(data, length, offset, storage);
     default:
         LogError(LOG_NXDN, "RCCH::decodeRCCH(), unknown RCCH value, messageType = $%02X", messageType);
         return nullptr;
@@ -61,18 +92,3 @@ std::unique_ptr<RCCH> RCCHFactory::createRCCH(const uint8_t* data, uint32_t leng
 
     return nullptr;
 }
-
-// ---------------------------------------------------------------------------
-//  Private Class Members
-// ---------------------------------------------------------------------------
-
-/* Internal helper to decode a RCCH link control message. */
-
-std::unique_ptr<RCCH> RCCHFactory::decode(RCCH* rcch, const uint8_t* data, uint32_t length, uint32_t offset)
-{
-    assert(rcch != nullptr);
-    assert(data != nullptr);
-
-    rcch->decode(data, length, offset);
-    return std::unique_ptr<RCCH>(rcch);
-}
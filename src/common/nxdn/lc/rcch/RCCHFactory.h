@@ -4,7 +4,7 @@
  * GPLv2 Open Source. Use is subject to license terms.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
- *  Copyright (C) 2022 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2022,2024 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -21,6 +21,7 @@
 #define  __NXDN_LC__RCCH_FACTORY_H__
 
 #include "common/Defines.h"
+#include "common/InPlaceStorage.h"
 
 #include "common/nxdn/lc/RCCH.h"
 #include "common/nxdn/lc/rcch/MESSAGE_TYPE_DCALL_HDR.h"
@@ -41,6 +42,21 @@ namespace nxdn
     {
         namespace rcch
         {
+            // ---------------------------------------------------------------------------
+            //  Constants
+            // ---------------------------------------------------------------------------
+
+            /**
+             * @brief Size of the storage required to hold any RCCH created by the RCCHFactory.
+             */
+            const size_t RCCH_STORAGE_SIZE = 96U;
+
+            /**
+             * @brief Caller provided storage for a RCCH decoded by RCCHFactory::decodeRCCH().
+             * @ingroup nxdn_rcch
+             */
+            typedef InPlaceStorage<RCCH, RCCH_STORAGE_SIZE> RCCHStorage;
+
             // ---------------------------------------------------------------------------
             //  Class Declaration
             // ---------------------------------------------------------------------------
@@ -67,16 +83,38 @@ namespace nxdn
                  * @param offset Offset for RCCH in data buffer.
                  */
                 static std::unique_ptr<RCCH> createRCCH(const uint8_t* data, uint32_t length, uint32_t offset = 0U);
+                /**
+                 * @brief Decode a RCCH into caller provided storage, without allocating.
+                 *  The returned RCCH is owned by the storage, and is valid until the storage is reused or destroyed.
+                 * @param[in] data Buffer containing a RCCH to decode.
+                 * @param length Length of data buffer.
+                 * @param storage Storage to decode the RCCH into.
+                 * @param offset Offset for RCCH in data buffer.
+                 * @returns RCCH* Instance of a RCCH representing the decoded data, or nullptr for an unknown message type.
+                 */
+                static RCCH* decodeRCCH(const uint8_t* data, uint32_t length, RCCHStorage& storage, uint32_t offset = 0U);
 
             private:
+                /**
+                 * @brief Decode a RCCH, into the given storage or a new heap instance.
+                 * @param[in] data Buffer containing a RCCH to decode.
+                 * @param length Length of data buffer.
+                 * @param offset Offset for RCCH in data buffer.
+                 * @param storage Storage to decode the RCCH into, or nullptr to allocate the RCCH.
+                 * @returns RCCH* Instance of a RCCH representing the decoded data.
+                 */
+                static RCCH* create(const uint8_t* data, uint32_t length, uint32_t offset, RCCHStorage* storage);
                 /**
                  * @brief Internal helper to decode a RCCH link control message.
-                 * @param[out] rcch
+                 * @tparam T Type of RCCH to decode.
                  * @param[in] data Buffer containing a RCCH to decode.
                  * @param length Length of data buffer.
                  * @param offset Offset for RCCH in data buffer.
+                 * @param storage Storage to decode the RCCH into, or nullptr to allocate the RCCH.
+                 * @returns RCCH* Instance of a RCCH representing the decoded data.
                  */
-                static std::unique_ptr<RCCH> decode(RCCH* rcch, const uint8_t* data, uint32_t length, uint32_t offset = 0U);
+                template<class T>
+                static RCCH* decode(const uint8_t* data, uint32_t length, uint32_t offset, RCCHStorage* storage);
             };
         } // namespace rcch
     } // namespace lc
@@ -10,6 +10,7 @@
 #include "Defines.h"
 #include "p25/P25Defines.h"
 #include "p25/P25Utils.h"
+#include "BitStream.h"
 #include "Utils.h"
 
 using namespace p25;
@@ -17,6 +18,23 @@ using namespace p25::defines;
 
 #include <cassert>
 
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helper to find the first status symbol at or after the given bit offset.
+ * @param start Bit offset.
+ * @returns uint32_t Bit offset of the first status symbol (SS0) bit.
+ */
+static inline uint32_t firstStatusSymbol(uint32_t start)
+{
+    if (start <= P25_SS0_START)
+        return P25_SS0_START;
+
+    return P25_SS0_START + (((start - P25_SS0_START) + (P25_SS_INCREMENT - 1U)) / P25_SS_INCREMENT) * P25_SS_INCREMENT;
+}
+
 // ---------------------------------------------------------------------------
 //  Static Class Members
 // ---------------------------------------------------------------------------
@@ -95,28 +113,18 @@ uint32_t P25Utils::decode(const uint8_t* in, uint8_t* out, uint32_t start, uint3
     assert(in != nullptr);
     assert(out != nullptr);
 
-    // Move the SSx positions to the range needed
-    uint32_t ss0Pos = P25_SS0_START;
-    uint32_t ss1Pos = P25_SS1_START;
-
-    while (ss0Pos < start) {
-        ss0Pos += P25_SS_INCREMENT;
-        ss1Pos += P25_SS_INCREMENT;
-    }
+    // status symbols are at fixed intervals, so the data between them is copied as whole runs
+    uint32_t ssPos = firstStatusSymbol(start);
 
     uint32_t n = 0U;
-    for (uint32_t i = start; i < stop; i++) {
-        if (i == ss0Pos) {
-            ss0Pos += P25_SS_INCREMENT;
-        }
-        else if (i == ss1Pos) {
-            ss1Pos += P25_SS_INCREMENT;
-        }
-        else {
-            bool b = READ_BIT(in, i);
-            WRITE_BIT(out, n, b);
-            n++;
-        }
+    uint32_t i = start;
+    while (i < stop) {
+        uint32_t runEnd = (ssPos < stop) ? ssPos : stop;
+        BitStream::copy(in, i, out, n, runEnd - i);
+        n += runEnd - i;
+
+        i = ssPos + 2U;
+        ssPos += P25_SS_INCREMENT;
     }
 
     return n;
@@ -129,28 +137,18 @@ uint32_t P25Utils::encode(const uint8_t* in, uint8_t* out, uint32_t start, uint3
     assert(in != nullptr);
     assert(out != nullptr);
 
-    // Move the SSx positions to the range needed
-    uint32_t ss0Pos = P25_SS0_START;
-    uint32_t ss1Pos = P25_SS1_START;
-
-    while (ss0Pos < start) {
-        ss0Pos += P25_SS_INCREMENT;
-        ss1Pos += P25_SS_INCREMENT;
-    }
+    // status symbols are at fixed intervals, so the data between them is copied as whole runs
+    uint32_t ssPos = firstStatusSymbol(start);
 
     uint32_t n = 0U;
-    for (uint32_t i = start; i < stop; i++) {
-        if (i == ss0Pos) {
-            ss0Pos += P25_SS_INCREMENT;
-        }
-        else if (i == ss1Pos) {
-            ss1Pos += P25_SS_INCREMENT;
-        }
-        else {
-            bool b = READ_BIT(in, n);
-            WRITE_BIT(out, i, b);
-            n++;
-        }
+    uint32_t i = start;
+    while (i < stop) {
+        uint32_t runEnd = (ssPos < stop) ? ssPos : stop;
+        BitStream::copy(in, n, out, i, runEnd - i);
+        n += runEnd - i;
+
+        i = ssPos + 2U;
+        ssPos += P25_SS_INCREMENT;
     }
 
     return n;
@@ -163,29 +161,20 @@ uint32_t P25Utils::encode(const uint8_t* in, uint8_t* out, uint32_t length)
     assert(in != nullptr);
     assert(out != nullptr);
 
-    // Move the SSx positions to the range needed
-    uint32_t ss0Pos = P25_SS0_START;
-    uint32_t ss1Pos = P25_SS1_START;
-
     uint32_t n = 0U;
     uint32_t pos = 0U;
     while (n < length) {
-        if (pos == ss0Pos) {
-            ss0Pos += P25_SS_INCREMENT;
-
-        }
-        else if (pos == ss1Pos) {
-            ss1Pos += P25_SS_INCREMENT;
+        uint32_t run = P25_SS0_START - (pos % P25_SS_INCREMENT);
+        if (run > length - n)
+            run = length - n;
 
-        }
-        else {
-            bool b = READ_BIT(in, n);
-            WRITE_BIT(out, pos, b);
-            n++;
-
-        }
-        pos++;
+        BitStream::copy(in, n, out, pos, run);
+        n += run;
+        pos += run;
 
+        // skip over the status symbol, if there is more data to follow
+        if (n < length)
+            pos += 2U;
     }
 
     return pos;
@@ -88,7 +88,8 @@ TSBK::TSBK() :
     m_siteIdenEntry(lookups::IdenTable()),
     m_rs(),
     m_trellis(),
-    m_raw(nullptr)
+    m_raw(),
+    m_rawDecoded(false)
 {
     if (m_siteCallsign == nullptr) {
         m_siteCallsign = new uint8_t[MOT_CALLSIGN_LENGTH_BYTES];
@@ -102,11 +103,7 @@ TSBK::TSBK() :
 
 /* Finalizes a instance of TSBK class. */
 
-TSBK::~TSBK()
-{
-    if (m_raw != nullptr)
-        delete[] m_raw;
-}
+TSBK::~TSBK() = default;
 
 /* Returns a string that represents the current TSBK. */
 
@@ -119,7 +116,10 @@ std::string TSBK::toString(bool isp)
 
 uint8_t* TSBK::getDecodedRaw() const
 {
-    return m_raw;
+    if (!m_rawDecoded)
+        return nullptr;
+
+    return const_cast<uint8_t*>(m_raw);
 }
 
 /* Sets the callsign. */
@@ -252,8 +252,8 @@ bool TSBK::decode(const uint8_t* data, uint8_t* payload, bool rawTSBK)
         Utils::dump(2U, "TSBK::decode(), TSBK Value", tsbk, P25_TSBK_LENGTH_BYTES);
     }
 
-    m_raw = new uint8_t[P25_TSBK_LENGTH_BYTES];
     ::memcpy(m_raw, tsbk, P25_TSBK_LENGTH_BYTES);
+    m_rawDecoded = true;
 
     m_lco = tsbk[0U] & 0x3F;                                                        // LCO
     m_lastBlock = (tsbk[0U] & 0x80U) == 0x80U;                                      // Last Block Marker
@@ -4,7 +4,7 @@
  * GPLv2 Open Source. Use is subject to license terms.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
- *  Copyright (C) 2022 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2022,2024 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -100,7 +100,7 @@ namespace p25
             /**
              * @brief Returns a copy of the raw decoded TSBK bytes.
              * This will only return data for a *decoded* TSBK, not a created or copied TSBK.
-             * @returns uint8_t* Raw decoded TSBK bytes.
+             * @returns uint8_t* Raw decoded TSBK bytes, or nullptr if the TSBK was not decoded.
              */
             uint8_t* getDecodedRaw() const;
 
@@ -277,7 +277,8 @@ namespace p25
             __PROTECTED_COPY(TSBK);
 
         private:
-            uint8_t* m_raw;
+            uint8_t m_raw[defines::P25_TSBK_LENGTH_BYTES];
+            bool m_rawDecoded;
         };
     } // namespace lc
 } // namespace p25
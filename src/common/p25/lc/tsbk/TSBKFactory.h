@@ -4,7 +4,7 @@
  * GPLv2 Open Source. Use is subject to license terms.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
- *  Copyright (C) 2022 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2022,2024 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -25,6 +25,7 @@
 #define  __P25_LC__TSBK_FACTORY_H__
 
 #include "common/Defines.h"
+#include "common/InPlaceStorage.h"
 
 #include "common/edac/Trellis.h"
 
@@ -104,6 +105,21 @@ namespace p25
     {
         namespace tsbk
         {
+            // ---------------------------------------------------------------------------
+            //  Constants
+            // ---------------------------------------------------------------------------
+
+            /**
+             * @brief Size of the storage required to hold any TSBK created by the TSBKFactory.
+             */
+            const size_t TSBK_STORAGE_SIZE = 160U;
+
+            /**
+             * @brief Caller provided storage for a TSBK decoded by TSBKFactory::decodeTSBK().
+             * @ingroup p25_tsbk
+             */
+            typedef InPlaceStorage<TSBK, TSBK_STORAGE_SIZE> TSBKStorage;
+
             // ---------------------------------------------------------------------------
             //  Class Declaration
             // ---------------------------------------------------------------------------
@@ -130,6 +146,15 @@ namespace p25
                  * @returns TSBK* Instance of a TSBK representing the decoded data.
                  */
                 static std::unique_ptr<TSBK> createTSBK(const uint8_t* data, bool rawTSBK = false);
+                /**
+                 * @brief Decode a TSBK into caller provided storage, without allocating.
+                 *  The returned TSBK is owned by the storage, and is valid until the storage is reused or destroyed.
+                 * @param[in] data Buffer containing TSBK packet data to decode.
+                 * @param storage Storage to decode the TSBK into.
+                 * @param rawTSBK Flag indicating whether or not the passed buffer is raw.
+                 * @returns TSBK* Instance of a TSBK representing the decoded data, or nullptr if the TSBK failed to decode.
+                 */
+                static TSBK* decodeTSBK(const uint8_t* data, TSBKStorage& storage, bool rawTSBK = false);
                 /**
                  * @brief Create an instance of a AMBT.
                  * @param[in] dataHeader P25 PDU data header
@@ -147,14 +172,24 @@ namespace p25
             private:
                 static bool m_warnCRC;
 
+                /**
+                 * @brief Decode a TSBK, into the given storage or a new heap instance.
+                 * @param[in] data Buffer containing TSBK packet data to decode.
+                 * @param rawTSBK Flag indicating whether or not the passed buffer is raw.
+                 * @param storage Storage to decode the TSBK into, or nullptr to allocate the TSBK.
+                 * @returns TSBK* Instance of a TSBK representing the decoded data.
+                 */
+                static TSBK* create(const uint8_t* data, bool rawTSBK, TSBKStorage* storage);
                 /**
                  * @brief Decode a TSBK.
-                 * @param tsbk Instance of a TSBK.
+                 * @tparam T Type of TSBK to decode.
                  * @param[in] data Buffer containing TSBK packet data to decode.
                  * @param rawTSBK Flag indicating whether or not the passed buffer is raw.
+                 * @param storage Storage to decode the TSBK into, or nullptr to allocate the TSBK.
                  * @returns TSBK* Instance of a TSBK representing the decoded data.
                  */
-                static std::unique_ptr<TSBK> decode(TSBK* tsbk, const uint8_t* data, bool rawTSBK = false);
+                template<class T>
+                static TSBK* decode(const uint8_t* data, bool rawTSBK, TSBKStorage* storage);
                 /**
                  * @brief Decode an AMBT.
                  * @param tsbk Instance of a TSBK.
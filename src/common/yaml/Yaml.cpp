@@ -1246,6 +1246,90 @@ namespace yaml
         return TYPE_IMP->getData();
     }
 
+    // ---------------------------------------------------------------------------
+    //  Public Class Members
+    // ---------------------------------------------------------------------------
+
+    /* Initializes a new instance of the NodeBuilder class. */
+
+    NodeBuilder::NodeBuilder(Node& root) :
+        m_root(root),
+        m_pending(&root),
+        m_stack()
+    {
+        /* stub */
+    }
+
+    /* Called at the start of a map. */
+
+    void NodeBuilder::mapStart()
+    {
+        m_stack.push_back({ &next(), false });
+    }
+
+    /* Called at the end of a map. */
+
+    void NodeBuilder::mapEnd()
+    {
+        m_stack.pop_back();
+    }
+
+    /* Called for each map key. */
+
+    void NodeBuilder::key(const std::string& key)
+    {
+        m_pending = &(*m_stack.back().first)[key];
+    }
+
+    /* Called at the start of a sequence. */
+
+    void NodeBuilder::sequenceStart()
+    {
+        m_stack.push_back({ &next(), true });
+    }
+
+    /* Called at the end of a sequence. */
+
+    void NodeBuilder::sequenceEnd()
+    {
+        m_stack.pop_back();
+    }
+
+    /* Called for each scalar value. */
+
+    void NodeBuilder::scalar(const std::string& value)
+    {
+        next() = value;
+    }
+
+    /* Called for a value that has no data. */
+
+    void NodeBuilder::none()
+    {
+        // the node is created, and left as None
+        next();
+    }
+
+    // ---------------------------------------------------------------------------
+    //  Private Class Members
+    // ---------------------------------------------------------------------------
+
+    /* Helper to get the node the next value event applies to. */
+
+    Node& NodeBuilder::next()
+    {
+        if (m_stack.empty()) {
+            return m_root;
+        }
+
+        // sequence entries are appended, map values were created by the preceding key
+        if (m_stack.back().second) {
+            return m_stack.back().first->push_back();
+        }
+
+        return *m_pending;
+    }
+
     /*
     ** Reader implementations
     */
@@ -1336,9 +1420,9 @@ namespace yaml
             try
             {
                 root.clear();
-                readLines(stream);
-                postProcessLines();
-                parseRoot(root);
+
+                NodeBuilder builder(root);
+                parse(builder, stream);
             }
             catch (Exception const& e)
             {
@@ -1347,6 +1431,14 @@ namespace yaml
             }
         }
 
+        /* Run full parsing procedure, invoking the event handler for each element. */
+        void parse(EventHandler& handler, std::iostream& stream)
+        {
+            readLines(stream);
+            postProcessLines();
+            parseRoot(handler);
+        }
+
     private:
         /* Copies a instance of the ParseImp class to new instance of the ParseImp class. */
         ParseImp(const ParseImp& copy) { /* stub */ }
@@ -1617,7 +1709,7 @@ namespace yaml
         }
 
         /* Process root node and start of document. */
-        void parseRoot(Node& root)
+        void parseRoot(EventHandler& handler)
         {
             // get first line and start type
             auto it = m_Lines.begin();
@@ -1631,13 +1723,13 @@ namespace yaml
             // handle next line
             switch (type) {
             case Node::SequenceType:
-                parseSequence(root, it);
+                parseSequence(handler, it);
                 break;
             case Node::MapType:
-                parseMap(root, it);
+                parseMap(handler, it);
                 break;
             case Node::ScalarType:
-                parseScalar(root, it);
+                parseScalar(handler, it);
                 break;
             default:
                 break;
@@ -1650,12 +1742,13 @@ namespace yaml
         }
 
         /* Process sequence node. */
-        void parseSequence(Node& node, std::list<ReaderLine*>::iterator & it)
+        void parseSequence(EventHandler& handler, std::list<ReaderLine*>::iterator & it)
         {
+            handler.sequenceStart();
+
             ReaderLine* pNextLine = nullptr;
             while (it != m_Lines.end()) {
                 ReaderLine* pLine = *it;
-                Node& childNode = node.push_back();
 
                 // move to next line, error check
                 ++it;
@@ -1667,13 +1760,13 @@ namespace yaml
                 Node::eType valueType = (*it)->Type;
                 switch (valueType) {
                 case Node::SequenceType:
-                    parseSequence(childNode, it);
+                    parseSequence(handler, it);
                     break;
                 case Node::MapType:
-                    parseMap(childNode, it);
+                    parseMap(handler, it);
                     break;
                 case Node::ScalarType:
-                    parseScalar(childNode, it);
+                    parseScalar(handler, it);
                     break;
                 default:
                     break;
@@ -1693,15 +1786,19 @@ namespace yaml
                     throw InternalException(ExceptionMessage(g_ErrorDiffEntryNotAllowed, *pNextLine));
                 }
             }
+
+            handler.sequenceEnd();
         }
 
         /* Process map node. */
-        void parseMap(Node& node, std::list<ReaderLine*>::iterator & it)
+        void parseMap(EventHandler& handler, std::list<ReaderLine*>::iterator & it)
         {
+            handler.mapStart();
+
             ReaderLine* pNextLine = nullptr;
             while (it != m_Lines.end()) {
                 ReaderLine* pLine = *it;
-                Node& childNode = node[pLine->Data];
+                handler.key(pLine->Data);
 
                 // move to next line, error check
                 ++it;
@@ -1713,13 +1810,13 @@ namespace yaml
                 Node::eType valueType = (*it)->Type;
                 switch (valueType) {
                 case Node::SequenceType:
-                    parseSequence(childNode, it);
+                    parseSequence(handler, it);
                     break;
                 case Node::MapType:
-                    parseMap(childNode, it);
+                    parseMap(handler, it);
                     break;
                 case Node::ScalarType:
-                    parseScalar(childNode, it);
+                    parseScalar(handler, it);
                     break;
                 default:
                     break;
@@ -1739,10 +1836,12 @@ namespace yaml
                     throw InternalException(ExceptionMessage(g_ErrorDiffEntryNotAllowed, *pNextLine));
                 }
             }
+
+            handler.mapEnd();
         }
 
         /* Process scalar node. */
-        void parseScalar(Node & node, std::list<ReaderLine*>::iterator & it)
+        void parseScalar(EventHandler& handler, std::list<ReaderLine*>::iterator & it)
         {
             std::string data = "";
             ReaderLine* pFirstLine = *it;
@@ -1767,6 +1866,7 @@ namespace yaml
             if (blockScalar) {
                 ++it;
                 if (it == m_Lines.end() || (pLine = *it)->Type != Node::ScalarType) {
+                    handler.none();
                     return;
                 }
             }
@@ -1867,7 +1967,7 @@ namespace yaml
                 data = data.substr(1, data.size() - 2);
             }
 
-            node = data;
+            handler.scalar(data);
         }
 
         /*  */
@@ -1957,6 +2057,57 @@ namespace yaml
     /* Populate given root node with deserialized data. */
     
     bool Parse(Node& root, const char* filename)
+    {
+        root.clear();
+
+        NodeBuilder builder(root);
+        if (!Parse(builder, filename)) {
+            root.clear();
+            return false;
+        }
+
+        return true;
+    }
+    
+    /* Populate given root node with deserialized data. */
+
+    bool Parse(Node& root, std::iostream& stream)
+    {
+        ParseImp* pImp = nullptr;
+
+        try
+        {
+            pImp = new ParseImp;
+            pImp->parse(root, stream);
+            delete pImp;
+            return true;
+        }
+        catch (Exception const& e)
+        {
+            delete pImp;
+            return false;
+        }
+    }
+    
+    /* Populate given root node with deserialized data. */
+
+    bool Parse(Node& root, const std::string& string)
+    {
+        std::stringstream ss(string);
+        return Parse(root, ss);
+    }
+    
+    /* Populate given root node with deserialized data. */
+
+    bool Parse(Node& root, const char* buffer, const size_t size)
+    {
+        std::stringstream ss(std::string(buffer, size));
+        return Parse(root, ss);
+    }
+
+    /* Parse the given file, invoking the event handler for deserialized data. */
+
+    bool Parse(EventHandler& handler, const char* filename)
     {
         std::ifstream f(filename, std::ifstream::binary);
         if (!f.is_open()) {
@@ -1971,19 +2122,19 @@ namespace yaml
         f.read(data.get(), fileSize);
         f.close();
 
-        return Parse(root, data.get(), fileSize);
+        return Parse(handler, data.get(), fileSize);
     }
     
-    /* Populate given root node with deserialized data. */
+    /* Parse the given stream, invoking the event handler for deserialized data. */
 
-    bool Parse(Node& root, std::iostream& stream)
+    bool Parse(EventHandler& handler, std::iostream& stream)
     {
         ParseImp* pImp = nullptr;
 
         try
         {
             pImp = new ParseImp;
-            pImp->parse(root, stream);
+            pImp->parse(handler, stream);
             delete pImp;
             return true;
         }
@@ -1994,20 +2145,20 @@ namespace yaml
         }
     }
     
-    /* Populate given root node with deserialized data. */
+    /* Parse the given string, invoking the event handler for deserialized data. */
 
-    bool Parse(Node& root, const std::string& string)
+    bool Parse(EventHandler& handler, const std::string& string)
     {
         std::stringstream ss(string);
-        return Parse(root, ss);
+        return Parse(handler, ss);
     }
     
-    /* Populate given root node with deserialized data. */
+    /* Parse the given buffer, invoking the event handler for deserialized data. */
 
-    bool Parse(Node& root, const char* buffer, const size_t size)
+    bool Parse(EventHandler& handler, const char* buffer, const size_t size)
     {
         std::stringstream ss(std::string(buffer, size));
-        return Parse(root, ss);
+        return Parse(handler, ss);
     }
 
     // ---------------------------------------------------------------------------
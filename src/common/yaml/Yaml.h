@@ -30,12 +30,19 @@
 #include "common/Defines.h"
 
 #include <exception>
+#include <limits>
 #include <string>
+#include <type_traits>
+#include <vector>
 #include <iostream>
 #include <sstream>
 #include <algorithm>
 #include <map>
 
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+
 namespace yaml
 {
     // ---------------------------------------------------------------------------
@@ -96,6 +103,108 @@ namespace yaml
         //  Class Declaration
         // ---------------------------------------------------------------------------
 
+        /**
+         * @brief NumberConverter Helper to convert a string to a numeric type without the overhead
+         *  of constructing a std::stringstream for every conversion. (Leading whitespace is skipped and
+         *  trailing characters are ignored, the same as operator>> would.)
+         * @tparam T Numeric type to convert.
+         * @tparam P Intermediate type used for parsing.
+         */
+        template<typename T, typename P>
+        struct NumberConverter {
+            /**
+             * @brief Return numeric type for given string.
+             * @param data String to convert to numeric type.
+             * @return T Numeric type value.
+             */
+            static T get(const std::string& data)
+            {
+                return get(data, T());
+            }
+
+            /**
+             * @brief Return numeric type for a given string, with a fallback default.
+             * @param data String to convert to numeric type.
+             * @param defaultValue Default numeric type value.
+             * @return T Numeric type value.
+             */
+            static T get(const std::string& data, const T& defaultValue)
+            {
+                if (data.size() == 0) {
+                    return defaultValue;
+                }
+
+                const char* start = data.c_str();
+                char* end = nullptr;
+
+                errno = 0;
+                P value = parse(start, &end);
+                if (end == start || errno == ERANGE) {
+                    return defaultValue;
+                }
+
+                if (std::is_integral<T>::value) {
+                    // negative values are wrapped for unsigned types, as operator>> does
+                    if (std::is_unsigned<T>::value) {
+                        if (value > (P)std::numeric_limits<T>::max() && 
+                            (P)(-value) > (P)std::numeric_limits<T>::max()) {
+                            return defaultValue;
+                        }
+                    }
+                    else {
+                        if (value > (P)std::numeric_limits<T>::max() || value < (P)std::numeric_limits<T>::min()) {
+                            return defaultValue;
+                        }
+                    }
+                }
+
+                return static_cast<T>(value);
+            }
+
+        private:
+            static long long parse(const char* str, char** end, long long*) { return ::strtoll(str, end, 10); }
+            static unsigned long long parse(const char* str, char** end, unsigned long long*) { return ::strtoull(str, end, 10); }
+            static double parse(const char* str, char** end, double*)
+            {
+                // strtod would accept a hexadecimal value, which operator>> reads as the leading zero
+                const char* p = str;
+                while (::isspace((unsigned char)*p))
+                    p++;
+                bool negative = (*p == '-');
+                if (*p == '+' || *p == '-')
+                    p++;
+                if (p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+                    *end = const_cast<char*>(p + 1);
+                    return negative ? -0.0 : 0.0;
+                }
+
+                return ::strtod(str, end);
+            }
+
+            static P parse(const char* str, char** end) { return parse(str, end, (P*)nullptr); }
+        };
+
+        /** @brief StringConverter<int16_t> Helper to convert a string to a int16_t. */
+        template<> struct StringConverter<int16_t> : public NumberConverter<int16_t, long long> { };
+        /** @brief StringConverter<uint16_t> Helper to convert a string to a uint16_t. */
+        template<> struct StringConverter<uint16_t> : public NumberConverter<uint16_t, unsigned long long> { };
+        /** @brief StringConverter<int32_t> Helper to convert a string to a int32_t. */
+        template<> struct StringConverter<int32_t> : public NumberConverter<int32_t, long long> { };
+        /** @brief StringConverter<uint32_t> Helper to convert a string to a uint32_t. */
+        template<> struct StringConverter<uint32_t> : public NumberConverter<uint32_t, unsigned long long> { };
+        /** @brief StringConverter<int64_t> Helper to convert a string to a int64_t. */
+        template<> struct StringConverter<int64_t> : public NumberConverter<int64_t, long long> { };
+        /** @brief StringConverter<uint64_t> Helper to convert a string to a uint64_t. */
+        template<> struct StringConverter<uint64_t> : public NumberConverter<uint64_t, unsigned long long> { };
+        /** @brief StringConverter<float> Helper to convert a string to a float. */
+        template<> struct StringConverter<float> : public NumberConverter<float, double> { };
+        /** @brief StringConverter<double> Helper to convert a string to a double. */
+        template<> struct StringConverter<double> : public NumberConverter<double, double> { };
+
+        // ---------------------------------------------------------------------------
+        //  Class Declaration
+        // ---------------------------------------------------------------------------
+
         /**
          * @brief StringConverter<std::string> Helper to convert a string to a string.
          * (This is just a default converter.)
@@ -596,6 +705,119 @@ namespace yaml
         void* m_pImp;
     };
 
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief EventHandler Interface for event-driven YAML parsing. Instead of populating a
+     *  Node tree, the parser invokes these callbacks in document order, this allows large
+     *  documents to be loaded directly into application structures.
+     * @ingroup yaml
+     */
+    class HOST_SW_API EventHandler {
+    public:
+        /**
+         * @brief Finalizes a instance of the EventHandler class.
+         */
+        virtual ~EventHandler() = default;
+
+        /**
+         * @brief Called at the start of a map.
+         */
+        virtual void mapStart() = 0;
+        /**
+         * @brief Called at the end of a map.
+         */
+        virtual void mapEnd() = 0;
+        /**
+         * @brief Called for each map key; the key is followed by the events for its value.
+         * @param key Key name.
+         */
+        virtual void key(const std::string& key) = 0;
+
+        /**
+         * @brief Called at the start of a sequence.
+         */
+        virtual void sequenceStart() = 0;
+        /**
+         * @brief Called at the end of a sequence.
+         */
+        virtual void sequenceEnd() = 0;
+
+        /**
+         * @brief Called for each scalar value.
+         * @param value Scalar value.
+         */
+        virtual void scalar(const std::string& value) = 0;
+        /**
+         * @brief Called for a value that has no data (i.e. an empty block scalar); such a
+         *  value is a None node, and not an empty scalar.
+         */
+        virtual void none() = 0;
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief NodeBuilder Event handler that populates a Node tree from parser events.
+     * @ingroup yaml
+     */
+    class HOST_SW_API NodeBuilder : public EventHandler {
+    public:
+        /**
+         * @brief Initializes a new instance of the NodeBuilder class.
+         * @param root Root node to populate.
+         */
+        NodeBuilder(Node& root);
+
+        /**
+         * @brief Called at the start of a map.
+         */
+        void mapStart() override;
+        /**
+         * @brief Called at the end of a map.
+         */
+        void mapEnd() override;
+        /**
+         * @brief Called for each map key.
+         * @param key Key name.
+         */
+        void key(const std::string& key) override;
+
+        /**
+         * @brief Called at the start of a sequence.
+         */
+        void sequenceStart() override;
+        /**
+         * @brief Called at the end of a sequence.
+         */
+        void sequenceEnd() override;
+
+        /**
+         * @brief Called for each scalar value.
+         * @param value Scalar value.
+         */
+        void scalar(const std::string& value) override;
+        /**
+         * @brief Called for a value that has no data.
+         */
+        void none() override;
+
+    private:
+        Node& m_root;
+        Node* m_pending;
+        std::vector<std::pair<Node*, bool>> m_stack;
+
+        /**
+         * @brief Helper to get the node the next value event applies to.
+         * @returns Node Node for the next value.
+         */
+        Node& next();
+    };
+
     /**
      * @brief Populate given root node with deserialized data.
      * @ingroup yaml
@@ -625,6 +847,36 @@ namespace yaml
      */
     bool Parse(Node& root, const char* buffer, const size_t size);
 
+    /**
+     * @brief Parse the given file, invoking the event handler for deserialized data.
+     * @ingroup yaml
+     * @param handler Event handler.
+     * @param filename Path of input file.
+     */
+    bool Parse(EventHandler& handler, const char* filename);
+    /**
+     * @brief Parse the given stream, invoking the event handler for deserialized data.
+     * @ingroup yaml
+     * @param handler Event handler.
+     * @param stream Input stream.
+     */
+    bool Parse(EventHandler& handler, std::iostream& stream);
+    /**
+     * @brief Parse the given string, invoking the event handler for deserialized data.
+     * @ingroup yaml
+     * @param handler Event handler.
+     * @param string String of input data.
+     */
+    bool Parse(EventHandler& handler, const std::string& string);
+    /**
+     * @brief Parse the given buffer, invoking the event handler for deserialized data.
+     * @ingroup yaml
+     * @param handler Event handler.
+     * @param buffer Character array of input data.
+     * @param size Buffer size.
+     */
+    bool Parse(EventHandler& handler, const char* buffer, const size_t size);
+
     // ---------------------------------------------------------------------------
     //  Structure Declaration
     // ---------------------------------------------------------------------------
@@ -27,7 +27,10 @@ using namespace lookups;
 
 #include <cstdio>
 #include <algorithm>
+#include <chrono>
 #include <functional>
+#include <sstream>
+#include <thread>
 
 #if !defined(_WIN32)
 #include <sys/utsname.h>
@@ -41,6 +44,9 @@ using namespace lookups;
 
 #define IDLE_WARMUP_MS 5U
 #define DEFAULT_MTU_SIZE 496
+#define VTUN_READ_BATCH 32U
+#define VTUN_IDLE_WAIT 20
+#define PEER_NETWORK_IDLE_WAIT 5U
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -71,7 +77,9 @@ HostFNE::HostFNE(const std::string& confFile) :
     m_useAlternatePortForDiagnostics(false),
     m_allowActivityTransfer(false),
     m_allowDiagnosticTransfer(false),
-    m_RESTAPI(nullptr)
+    m_RESTAPI(nullptr),
+    m_networkThreads(),
+    m_networkThreadsStop(false)
 {
     /* stub */
 }
@@ -199,13 +207,39 @@ int HostFNE::run()
     ** Initialize Threads
     */
 
-    if (!Thread::runAsThread(this, threadMasterNetwork))
+    if (!startNetworkThread(threadMasterNetwork, new thread_t())) {
+        stopNetworkThreads();
         return EXIT_FAILURE;
-    if (!Thread::runAsThread(this, threadDiagNetwork))
+    }
+    for (uint32_t i = 1U; i < m_network->socketShards(); i++) {
+        network::SocketShardRequest* req = new network::SocketShardRequest();
+        req->shardNo = i;
+        if (!startNetworkThread(threadMasterNetworkShard, req)) {
+            stopNetworkThreads();
+            return EXIT_FAILURE;
+        }
+    }
+    if (!startNetworkThread(threadDiagNetwork, new thread_t())) {
+        stopNetworkThreads();
         return EXIT_FAILURE;
+    }
+    for (auto network : m_peerNetworks) {
+        if (network.second == nullptr)
+            continue;
+
+        network::PeerNetworkRequest* req = new network::PeerNetworkRequest();
+        req->identity = network.first;
+        req->network = network.second;
+        if (!startNetworkThread(threadPeerNetwork, req)) {
+            stopNetworkThreads();
+            return EXIT_FAILURE;
+        }
+    }
 #if !defined(_WIN32)
-    if (!Thread::runAsThread(this, threadVirtualNetworking))
+    if (!startNetworkThread(threadVirtualNetworking, new thread_t())) {
+        stopNetworkThreads();
         return EXIT_FAILURE;
+    }
 #endif // !defined(_WIN32)
     /*
     ** Main execution loop
@@ -235,27 +269,16 @@ int HostFNE::run()
         if (m_diagNetwork != nullptr)
             m_diagNetwork->clock(ms);
 
-        // clock peers
-        for (auto network : m_peerNetworks) {
-            network::PeerNetwork* peerNetwork = network.second;
-            if (peerNetwork != nullptr) {
-                peerNetwork->clock(ms);
-
-                // skip peer if it isn't enabled
-                if (!peerNetwork->isEnabled()) {
-                    continue;
-                }
-
-                // process peer network traffic
-                processPeer(peerNetwork);
-            }
-        }
+        if (m_RESTAPI != nullptr)
+            m_RESTAPI->clock(ms);
 
         if (ms < 2U)
             Thread::sleep(1U);
     }
 
-    // shutdown threads
+    // shutdown threads (the network threads are stopped before the networks they service are released)
+    stopNetworkThreads();
+
     if (m_network != nullptr) {
         m_network->close();
         delete m_network;
@@ -267,9 +290,11 @@ int HostFNE::run()
     }
 
     for (auto network : m_peerNetworks) {
-        network::Network* peerNetwork = network.second;
-        if (peerNetwork != nullptr)
+        network::PeerNetwork* peerNetwork = network.second;
+        if (peerNetwork != nullptr) {
             peerNetwork->close();
+            delete peerNetwork;
+        }
     }
     m_peerNetworks.clear();
 
@@ -590,18 +615,51 @@ bool HostFNE::createMasterNetwork()
     return true;
 }
 
-/* Entry point to master FNE network thread. */
+/* Helper to start a (joinable) network thread. */
 
-void* HostFNE::threadMasterNetwork(void* arg)
+bool HostFNE::startNetworkThread(void *(*startRoutine)(void *), thread_t* thread)
 {
-    thread_t* th = (thread_t*)arg;
-    if (th != nullptr) {
+    if (!Thread::runAsThread(this, startRoutine, thread)) {
+        delete thread;
+        return false;
+    }
+
+    m_networkThreads.push_back(thread);
+    return true;
+}
+
+/* Helper to signal the network threads to stop, and wait for them to terminate. */
+
+void HostFNE::stopNetworkThreads()
+{
+    m_networkThreadsStop = true;
+    for (thread_t* th : m_networkThreads) {
 #if defined(_WIN32)
+        ::WaitForSingleObject(th->thread, INFINITE);
         ::CloseHandle(th->thread);
 #else
-        ::pthread_detach(th->thread);
+        ::pthread_join(th->thread, NULL);
 #endif // defined(_WIN32)
+        delete th;
+    }
 
+    m_networkThreads.clear();
+}
+
+/* Helper to determine whether network threads should continue running. */
+
+bool HostFNE::networkThreadsRunning() const
+{
+    return !g_killed && !m_networkThreadsStop;
+}
+
+/* Entry point to master FNE network thread. */
+
+void* HostFNE::threadMasterNetwork(void* arg)
+{
+    thread_t* th = (thread_t*)arg;
+    if (th != nullptr) {
+        // network threads are joined (and released) by HostFNE::stopNetworkThreads()
         std::string threadName("fne:network-loop");
         HostFNE* fne = static_cast<HostFNE*>(th->obj);
         if (fne == nullptr) {
@@ -610,7 +668,6 @@ void* HostFNE::threadMasterNetwork(void* arg)
         }
 
         if (g_killed) {
-            delete th;
             return nullptr;
         }
 
@@ -620,14 +677,67 @@ void* HostFNE::threadMasterNetwork(void* arg)
 #endif // _GNU_SOURCE
 
         if (fne->m_network != nullptr) {
-            while (!g_killed) {
-                fne->m_network->processNetwork();
-                Thread::sleep(5U);
+            while (fne->networkThreadsRunning()) {
+                // drain the socket before sleeping
+                while (fne->m_network->processNetwork(0U))
+                    ;
+                Thread::sleep(1U);
             }
         }
 
         LogDebug(LOG_HOST, "[STOP] %s", threadName.c_str());
-        delete th;
+    }
+
+    return nullptr;
+}
+
+/* Entry point to master FNE network socket shard thread. */
+
+void* HostFNE::threadMasterNetworkShard(void* arg)
+{
+    network::SocketShardRequest* th = (network::SocketShardRequest*)arg;
+    if (th != nullptr) {
+        // network threads are joined (and released) by HostFNE::stopNetworkThreads()
+        std::stringstream threadName;
+        threadName << "fne:network-" << th->shardNo;
+        HostFNE* fne = static_cast<HostFNE*>(th->obj);
+        if (fne == nullptr) {
+            g_killed = true;
+            LogDebug(LOG_HOST, "[FAIL] %s", threadName.str().c_str());
+        }
+
+        if (g_killed) {
+            return nullptr;
+        }
+
+        LogDebug(LOG_HOST, "[ OK ] %s", threadName.str().c_str());
+#ifdef _GNU_SOURCE
+        ::pthread_setname_np(th->thread, threadName.str().c_str());
+#endif // _GNU_SOURCE
+
+#if defined(__linux__)
+        // pin shard N to core N (modulo core count); the master network loop reading shard 0 is left unpinned
+        if (fne->m_network->socketShardAffinity()) {
+            uint32_t cpus = std::thread::hardware_concurrency();
+            if (cpus > 1U) {
+                cpu_set_t cpuSet;
+                CPU_ZERO(&cpuSet);
+                CPU_SET(th->shardNo % cpus, &cpuSet);
+                if (::pthread_setaffinity_np(th->thread, sizeof(cpu_set_t), &cpuSet) != 0) {
+                    LogWarning(LOG_HOST, "Failed to set CPU affinity for %s", threadName.str().c_str());
+                }
+            }
+        }
+#endif // defined(__linux__)
+
+        while (fne->networkThreadsRunning()) {
+            // drain the socket before sleeping
+            while (fne->m_network->processNetwork(th->shardNo))
+                ;
+            Thread::sleep(1U);
+        }
+
+        LogDebug(LOG_HOST, "[STOP] %s", threadName.str().c_str());
     }
 
     return nullptr;
@@ -639,12 +749,7 @@ void* HostFNE::threadDiagNetwork(void* arg)
 {
     thread_t* th = (thread_t*)arg;
     if (th != nullptr) {
-#if defined(_WIN32)
-        ::CloseHandle(th->thread);
-#else
-        ::pthread_detach(th->thread);
-#endif // defined(_WIN32)
-
+        // network threads are joined (and released) by HostFNE::stopNetworkThreads()
         std::string threadName("fne:diag-network-loop");
         HostFNE* fne = static_cast<HostFNE*>(th->obj);
         if (fne == nullptr) {
@@ -653,12 +758,10 @@ void* HostFNE::threadDiagNetwork(void* arg)
         }
 
         if (g_killed) {
-            delete th;
             return nullptr;
         }
 
         if (!fne->m_useAlternatePortForDiagnostics) {
-            delete th;
             return nullptr;
         }
 
@@ -668,14 +771,65 @@ void* HostFNE::threadDiagNetwork(void* arg)
 #endif // _GNU_SOURCE
 
         if (fne->m_diagNetwork != nullptr) {
-            while (!g_killed) {
+            while (fne->networkThreadsRunning()) {
                 fne->m_diagNetwork->processNetwork();
                 Thread::sleep(5U);
             }
         }
 
         LogDebug(LOG_HOST, "[STOP] %s", threadName.c_str());
-        delete th;
+    }
+
+    return nullptr;
+}
+
+/* Entry point to peer FNE network thread. */
+
+void* HostFNE::threadPeerNetwork(void* arg)
+{
+    network::PeerNetworkRequest* th = (network::PeerNetworkRequest*)arg;
+    if (th != nullptr) {
+        // network threads are joined (and released) by HostFNE::stopNetworkThreads()
+        std::stringstream threadName;
+        threadName << "fne:peer-" << th->identity;
+        HostFNE* fne = static_cast<HostFNE*>(th->obj);
+        if (fne == nullptr) {
+            g_killed = true;
+            LogDebug(LOG_HOST, "[FAIL] %s", threadName.str().c_str());
+        }
+
+        if (g_killed) {
+            return nullptr;
+        }
+
+        LogDebug(LOG_HOST, "[ OK ] %s", threadName.str().c_str());
+#ifdef _GNU_SOURCE
+        // thread names are limited to 16 characters (including the terminator)
+        ::pthread_setname_np(th->thread, threadName.str().substr(0U, 15U).c_str());
+#endif // _GNU_SOURCE
+
+        network::PeerNetwork* peerNetwork = th->network;
+
+        StopWatch stopWatch;
+        stopWatch.start();
+
+        while (fne->networkThreadsRunning()) {
+            uint32_t ms = stopWatch.elapsed();
+            stopWatch.start();
+
+            // clock the peer, this reads a single message from the master
+            peerNetwork->clock(ms);
+
+            // process peer network traffic
+            if (peerNetwork->isEnabled()) {
+                fne->processPeer(peerNetwork);
+            }
+
+            // block until the master sends more (the timeout keeps the peer timers running)
+            peerNetwork->wait(PEER_NETWORK_IDLE_WAIT);
+        }
+
+        LogDebug(LOG_HOST, "[STOP] %s", threadName.str().c_str());
     }
 
     return nullptr;
@@ -768,8 +922,8 @@ bool HostFNE::createPeerNetworks()
             if (enabled) {
                 bool ret = network->open();
                 if (!ret) {
-                    delete m_network;
-                    m_network = nullptr;
+                    delete network;
+                    network = nullptr;
                     LogError(LOG_HOST, "failed to initialize traffic networking for PEER %u", id);
                 }
             }
@@ -832,8 +986,7 @@ void* HostFNE::threadVirtualNetworking(void* arg)
 {
     thread_t* th = (thread_t*)arg;
     if (th != nullptr) {
-        ::pthread_detach(th->thread);
-
+        // network threads are joined (and released) by HostFNE::stopNetworkThreads()
         std::string threadName("fne:vtun-loop");
         HostFNE* fne = static_cast<HostFNE*>(th->obj);
         if (fne == nullptr) {
@@ -842,12 +995,10 @@ void* HostFNE::threadVirtualNetworking(void* arg)
         }
 
         if (g_killed) {
-            delete th;
             return nullptr;
         }
 
         if (!fne->m_vtunEnabled) {
-            delete th;
             return nullptr;
         }
 
@@ -860,26 +1011,37 @@ void* HostFNE::threadVirtualNetworking(void* arg)
             StopWatch stopWatch;
             stopWatch.start();
 
-            while (!g_killed) {
-                uint32_t ms = stopWatch.elapsed();
-                stopWatch.start();
+            uint8_t* packets = new uint8_t[VTUN_READ_BATCH * DEFAULT_MTU_SIZE];
+            ssize_t lengths[VTUN_READ_BATCH];
+
+            while (fne->networkThreadsRunning()) {
+                // block until the VTUN has packets; while data frames are queued for SUs wake up often enough
+                // to service them
+                int timeout = VTUN_IDLE_WAIT;
+                if (fne->m_packetDataMode == PacketDataMode::PROJECT25 && fne->m_network->p25TrafficHandler()->packetData()->hasQueuedFrames())
+                    timeout = 1;
 
-                uint8_t packet[DEFAULT_MTU_SIZE];
-                ::memset(packet, 0x00U, DEFAULT_MTU_SIZE);
+                int count = fne->m_tun->read(packets, DEFAULT_MTU_SIZE, lengths, VTUN_READ_BATCH, timeout);
+                if (count < 0) {
+                    Thread::sleep(5U);
+                }
 
-                ssize_t len = fne->m_tun->read(packet);
-                if (len > 0) {
+                for (int i = 0; i < count; i++) {
+                    uint8_t* packet = packets + (i * DEFAULT_MTU_SIZE);
                     switch (fne->m_packetDataMode) {
                     case PacketDataMode::DMR:
                         // TODO: not supported yet
                         break;
 
                     case PacketDataMode::PROJECT25:
-                        fne->m_network->p25TrafficHandler()->packetData()->processPacketFrame(packet, DEFAULT_MTU_SIZE);
+                        fne->m_network->p25TrafficHandler()->packetData()->processPacketFrame(packet, (uint32_t)lengths[i]);
                         break;
                     }
                 }
 
+                uint32_t ms = stopWatch.elapsed();
+                stopWatch.start();
+
                 // clock traffic handler
                 switch (fne->m_packetDataMode) {
                 case PacketDataMode::DMR:
@@ -890,13 +1052,12 @@ void* HostFNE::threadVirtualNetworking(void* arg)
                     fne->m_network->p25TrafficHandler()->packetData()->clock(ms);
                     break;
                 }
-
-                Thread::sleep(5U);
             }
+
+            delete[] packets;
         }
 
         LogDebug(LOG_HOST, "[STOP] %s", threadName.c_str());
-        delete th;
     }
 
     return nullptr;
@@ -912,8 +1073,10 @@ void HostFNE::processPeer(network::PeerNetwork* peerNetwork)
     if (peerNetwork->getStatus() != NET_STAT_RUNNING)
         return;
 
+    peerNetwork->updateBacklog();
+
     // process DMR data
-    if (peerNetwork->hasDMRData()) {
+    while (peerNetwork->hasDMRData()) {
         uint32_t length = 100U;
         bool ret = false;
         UInt8Array data = peerNetwork->readDMR(ret, length);
@@ -922,12 +1085,14 @@ void HostFNE::processPeer(network::PeerNetwork* peerNetwork)
             uint32_t slotNo = (data[15U] & 0x80U) == 0x80U ? 2U : 1U;
             uint32_t streamId = peerNetwork->getDMRStreamId(slotNo);
 
+            auto start = std::chrono::steady_clock::now();
             m_network->dmrTrafficHandler()->processFrame(data.get(), length, peerId, peerNetwork->pktLastSeq(), streamId, true);
+            peerNetwork->updateRxStats(length, (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
         }
     }
 
     // process P25 data
-    if (peerNetwork->hasP25Data()) {
+    while (peerNetwork->hasP25Data()) {
         uint32_t length = 100U;
         bool ret = false;
         UInt8Array data = peerNetwork->readP25(ret, length);
@@ -935,12 +1100,14 @@ void HostFNE::processPeer(network::PeerNetwork* peerNetwork)
             uint32_t peerId = peerNetwork->getPeerId();
             uint32_t streamId = peerNetwork->getP25StreamId();
 
+            auto start = std::chrono::steady_clock::now();
             m_network->p25TrafficHandler()->processFrame(data.get(), length, peerId, peerNetwork->pktLastSeq(), streamId, true);
+            peerNetwork->updateRxStats(length, (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
         }
     }
 
     // process NXDN data
-    if (peerNetwork->hasNXDNData()) {
+    while (peerNetwork->hasNXDNData()) {
         uint32_t length = 100U;
         bool ret = false;
         UInt8Array data = peerNetwork->readNXDN(ret, length);
@@ -948,7 +1115,9 @@ void HostFNE::processPeer(network::PeerNetwork* peerNetwork)
             uint32_t peerId = peerNetwork->getPeerId();
             uint32_t streamId = peerNetwork->getNXDNStreamId();
 
+            auto start = std::chrono::steady_clock::now();
             m_network->nxdnTrafficHandler()->processFrame(data.get(), length, peerId, peerNetwork->pktLastSeq(), streamId, true);
+            peerNetwork->updateRxStats(length, (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
         }
     }
 }
\ No newline at end of file
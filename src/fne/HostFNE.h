@@ -4,7 +4,7 @@
  * GPLv2 Open Source. Use is subject to license terms.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
- *  Copyright (C) 2023 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2023,2024 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -28,6 +28,7 @@
 #include "network/PeerNetwork.h"
 #include "network/RESTAPI.h"
 
+#include <atomic>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -117,6 +118,9 @@ private:
     friend class RESTAPI;
     RESTAPI* m_RESTAPI;
 
+    std::vector<thread_t*> m_networkThreads;
+    std::atomic<bool> m_networkThreadsStop;
+
     /**
      * @brief Reads basic configuration parameters from the INI.
      * @returns bool True, if configuration was read successfully, otherwise false.
@@ -132,18 +136,48 @@ private:
      * @returns bool True, if network connectivity was initialized, otherwise false.
      */
     bool createMasterNetwork();
+    /**
+     * @brief Helper to start a (joinable) network thread; network threads are owned by the host, and
+     *  are stopped and joined by stopNetworkThreads() before the networks they service are released.
+     * @param startRoutine Represents the function that executes on a thread.
+     * @param thread Instance of the thread data.
+     * @returns bool True, if the thread was started, otherwise false.
+     */
+    bool startNetworkThread(void *(*startRoutine)(void *), thread_t* thread);
+    /**
+     * @brief Helper to signal the network threads to stop, and wait for them to terminate.
+     */
+    void stopNetworkThreads();
+    /**
+     * @brief Helper to determine whether network threads should continue running.
+     * @returns bool True, if network threads should continue running, otherwise false.
+     */
+    bool networkThreadsRunning() const;
+
     /**
      * @brief Entry point to master FNE network thread.
      * @param arg Instance of the thread_t structure.
      * @returns void* (Ignore)
      */
     static void* threadMasterNetwork(void* arg);
+    /**
+     * @brief Entry point to master FNE network socket shard thread.
+     * @param arg Instance of the SocketShardRequest structure.
+     * @returns void* (Ignore)
+     */
+    static void* threadMasterNetworkShard(void* arg);
     /**
      * @brief Entry point to master FNE diagnostics network thread.
      * @param arg Instance of the thread_t structure.
      * @returns void* (Ignore)
      */
     static void* threadDiagNetwork(void* arg);
+    /**
+     * @brief Entry point to peer FNE network thread.
+     * @param arg Instance of the PeerNetworkRequest structure.
+     * @returns void* (Ignore)
+     */
+    static void* threadPeerNetwork(void* arg);
     /**
      * @brief Initializes peer FNE network connectivity.
      * @returns bool True, if network connectivity was initialized, otherwise false.
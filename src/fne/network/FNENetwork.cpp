@@ -13,9 +13,12 @@
 #include "common/Log.h"
 #include "common/Utils.h"
 #include "network/FNENetwork.h"
+#include "fne/network/RESTDefines.h"
+#include "network/MulticastGroup.h"
 #include "network/callhandler/TagDMRData.h"
 #include "network/callhandler/TagP25Data.h"
 #include "network/callhandler/TagNXDNData.h"
+#include "network/callhandler/CrossModeTranscoder.h"
 #include "fne/ActivityLog.h"
 #include "HostFNE.h"
 
@@ -33,6 +36,9 @@ using namespace network::callhandler;
 const uint32_t MAX_HARD_CONN_CAP = 250U;
 const uint8_t MAX_PEER_LIST_BEFORE_FLUSH = 10U;
 const uint32_t MAX_RID_LIST_CHUNK = 50U;
+const uint32_t MAX_MCAST_RETRANSMIT = 32U;
+const uint32_t MAX_SOCKET_SHARDS = 64U;
+const uint32_t RESUME_ACL_UPDATE_JITTER = 30000U;
 
 // ---------------------------------------------------------------------------
 //  Static Class Members
@@ -53,6 +59,7 @@ FNENetwork::FNENetwork(HostFNE* host, const std::string& address, uint16_t port,
     m_tagDMR(nullptr),
     m_tagP25(nullptr),
     m_tagNXDN(nullptr),
+    m_transcoder(nullptr),
     m_host(host),
     m_address(address),
     m_port(port),
@@ -74,6 +81,13 @@ FNENetwork::FNENetwork(HostFNE* host, const std::string& address, uint16_t port,
     m_maintainenceTimer(1000U, pingTime),
     m_updateLookupTime(updateLookupTime * 60U),
     m_softConnLimit(0U),
+    m_sessionMutex(),
+    m_sessions(),
+    m_sessionTTL(30U * 60U),
+    m_loginRateLimit(0U),
+    m_loginBurst(10U),
+    m_loginTokens(10.0),
+    m_loginTokenTime(0U),
     m_callInProgress(false),
     m_disallowAdjStsBcast(false),
     m_disallowExtAdjStsBcast(true),
@@ -91,6 +105,19 @@ FNENetwork::FNENetwork(HostFNE* host, const std::string& address, uint16_t port,
     m_influxLogRawData(false),
     m_disablePacketData(false),
     m_dumpDataPacket(false),
+    m_multicastEnabled(false),
+    m_multicastAddress("239.255.62.31"),
+    m_multicastPort(62032U),
+    m_multicastInterface(),
+    m_multicastTTL(1U),
+    m_multicastGroupId(1U),
+    m_multicastMinPeers(2U),
+    m_multicastRetransmitFrames(256U),
+    m_multicast(nullptr),
+    m_socketShards(1U),
+    m_socketShardAffinity(false),
+    m_shards(),
+    m_eventStream(nullptr),
     m_reportPeerPing(reportPeerPing),
     m_verbose(verbose)
 {
@@ -108,9 +135,19 @@ FNENetwork::FNENetwork(HostFNE* host, const std::string& address, uint16_t port,
 
 FNENetwork::~FNENetwork()
 {
+    if (m_transcoder != nullptr) {
+        delete m_transcoder;
+    }
+
     delete m_tagDMR;
     delete m_tagP25;
     delete m_tagNXDN;
+
+    if (m_multicast != nullptr) {
+        delete m_multicast;
+    }
+
+    closeShards();
 }
 
 /* Helper to set configuration options. */
@@ -126,6 +163,15 @@ void FNENetwork::setOptions(yaml::Node& conf, bool printOptions)
         m_softConnLimit = MAX_HARD_CONN_CAP;
     }
 
+    m_sessionTTL = conf["sessionTicketTTL"].as<uint32_t>(30U) * 60U;
+    m_loginRateLimit = conf["loginRateLimit"].as<uint32_t>(0U);
+    m_loginBurst = conf["loginBurst"].as<uint32_t>(10U);
+    if (m_loginBurst == 0U) {
+        m_loginBurst = 1U;
+    }
+
+    m_loginTokens = (double)m_loginBurst;
+
     // always force disable ADJ_STS_BCAST to external peers if the all option
     // is enabled
     if (m_disallowAdjStsBcast) {
@@ -151,6 +197,88 @@ void FNENetwork::setOptions(yaml::Node& conf, bool printOptions)
     m_disablePacketData = conf["disablePacketData"].as<bool>(false);
     m_dumpDataPacket = conf["dumpDataPacket"].as<bool>(false);
 
+    /*
+    ** Multicast Group
+    */
+
+    yaml::Node& multicastConf = conf["multicast"];
+    m_multicastEnabled = multicastConf["enable"].as<bool>(false);
+    m_multicastAddress = multicastConf["address"].as<std::string>("239.255.62.31");
+    m_multicastPort = (uint16_t)multicastConf["port"].as<uint32_t>(62032U);
+    m_multicastInterface = multicastConf["interface"].as<std::string>();
+    m_multicastTTL = (uint8_t)multicastConf["ttl"].as<uint32_t>(1U);
+    m_multicastGroupId = multicastConf["groupId"].as<uint32_t>(1U);
+    m_multicastMinPeers = multicastConf["minPeers"].as<uint32_t>(2U);
+    m_multicastRetransmitFrames = multicastConf["retransmitFrames"].as<uint32_t>(256U);
+
+    if (m_multicastGroupId == 0U) {
+        LogWarning(LOG_NET, "Multicast group ID cannot be 0, multicast disabled.");
+        m_multicastEnabled = false;
+    }
+
+    if (m_multicastRetransmitFrames == 0U) {
+        m_multicastRetransmitFrames = 1U;
+    }
+
+    m_socketShards = conf["socketShards"].as<uint32_t>(1U);
+    m_socketShardAffinity = conf["socketShardAffinity"].as<bool>(false);
+    if (m_socketShards == 0U) {
+        m_socketShards = 1U;
+    }
+
+    if (m_socketShards > MAX_SOCKET_SHARDS) {
+        m_socketShards = MAX_SOCKET_SHARDS;
+    }
+
+#if defined(_WIN32) || !defined(SO_REUSEPORT)
+    if (m_socketShards > 1U) {
+        LogWarning(LOG_NET, "SO_REUSEPORT is not supported on this platform, master socket sharding disabled.");
+        m_socketShards = 1U;
+    }
+#endif // defined(_WIN32) || !defined(SO_REUSEPORT)
+
+    /*
+    ** Cross-Mode Transcoding
+    */
+
+    yaml::Node& transcodeConf = conf["transcode"];
+    bool transcodeEnabled = transcodeConf["enable"].as<bool>(false);
+    uint32_t transcodeWorkers = transcodeConf["workers"].as<uint32_t>(2U);
+    uint32_t transcodeMaxCalls = transcodeConf["maxCalls"].as<uint32_t>(32U);
+    bool transcodeParametric = transcodeConf["parametric"].as<bool>(true);
+    if (transcodeWorkers == 0U) {
+        transcodeWorkers = 1U;
+    }
+
+    if (transcodeMaxCalls == 0U) {
+        transcodeMaxCalls = 1U;
+    }
+
+    if (m_transcoder != nullptr) {
+        delete m_transcoder;
+        m_transcoder = nullptr;
+    }
+
+    if (transcodeEnabled) {
+        m_transcoder = new CrossModeTranscoder(this, transcodeWorkers, transcodeMaxCalls, transcodeParametric, m_debug);
+
+        yaml::Node& patches = transcodeConf["patches"];
+        for (size_t i = 0; i < patches.size(); i++) {
+            uint32_t dmrTgId = patches[i]["dmrTgId"].as<uint32_t>(0U);
+            uint8_t dmrSlot = (uint8_t)patches[i]["dmrSlot"].as<uint32_t>(1U);
+            uint32_t p25TgId = patches[i]["p25TgId"].as<uint32_t>(0U);
+            if (!m_transcoder->addPatch(dmrTgId, dmrSlot, p25TgId)) {
+                LogWarning(LOG_NET, "Invalid or duplicate cross-mode patch, dmrTgId = %u, dmrSlot = %u, p25TgId = %u", dmrTgId, dmrSlot, p25TgId);
+            }
+        }
+
+        if (m_transcoder->patches() == 0U) {
+            LogWarning(LOG_NET, "No cross-mode patches are configured, cross-mode transcoding disabled.");
+            delete m_transcoder;
+            m_transcoder = nullptr;
+        }
+    }
+
     /*
     ** Drop Unit to Unit Peers
     */
@@ -167,6 +295,12 @@ void FNENetwork::setOptions(yaml::Node& conf, bool printOptions)
 
     if (printOptions) {
         LogInfo("    Maximum Permitted Connections: %u", m_softConnLimit);
+        LogInfo("    Login Session Ticket Lifetime: %u mins", m_sessionTTL / 60U);
+        if (m_loginRateLimit > 0U) {
+            LogInfo("    Login Rate Limit: %u logins/sec (burst %u)", m_loginRateLimit, m_loginBurst);
+        } else {
+            LogInfo("    Login Rate Limit: disabled");
+        }
         LogInfo("    Disable adjacent site broadcasts to any peers: %s", m_disallowAdjStsBcast ? "yes" : "no");
         if (m_disallowAdjStsBcast) {
             LogWarning(LOG_NET, "NOTICE: All P25 ADJ_STS_BCAST messages will be blocked and dropped!");
@@ -187,6 +321,26 @@ void FNENetwork::setOptions(yaml::Node& conf, bool printOptions)
             LogInfo("    InfluxDB Log Raw TSBK/CSBK/RCCH: %s", m_influxLogRawData ? "yes" : "no");
         }
         LogInfo("    Parrot Repeat to Only Originating Peer: %s", m_parrotOnlyOriginating ? "yes" : "no");
+        LogInfo("    Master Socket Shards: %u", m_socketShards);
+        if (m_socketShards > 1U) {
+            LogInfo("    Master Socket Shard CPU Affinity: %s", m_socketShardAffinity ? "yes" : "no");
+        }
+        LogInfo("    Multicast Group Enabled: %s", m_multicastEnabled ? "yes" : "no");
+        if (m_multicastEnabled) {
+            LogInfo("    Multicast Group ID: %u", m_multicastGroupId);
+            LogInfo("    Multicast Group Address: %s:%u", m_multicastAddress.c_str(), m_multicastPort);
+            LogInfo("    Multicast Group Interface: %s", m_multicastInterface.empty() ? "default" : m_multicastInterface.c_str());
+            LogInfo("    Multicast Group TTL: %u", m_multicastTTL);
+            LogInfo("    Multicast Group Minimum Peers: %u", m_multicastMinPeers);
+            LogInfo("    Multicast Group Retransmit Frames: %u", m_multicastRetransmitFrames);
+        }
+        LogInfo("    Cross-Mode Transcoding Enabled: %s", (m_transcoder != nullptr) ? "yes" : "no");
+        if (m_transcoder != nullptr) {
+            LogInfo("    Cross-Mode Transcoding Workers: %u", transcodeWorkers);
+            LogInfo("    Cross-Mode Transcoding Maximum Calls: %u", transcodeMaxCalls);
+            LogInfo("    Cross-Mode Transcoding Parametric: %s", transcodeParametric ? "yes" : "no");
+            LogInfo("    Cross-Mode Patches: %u", m_transcoder->patches());
+        }
     }
 }
 
@@ -204,16 +358,29 @@ void FNENetwork::setLookups(lookups::RadioIdLookup* ridLookup, lookups::Talkgrou
 void FNENetwork::setPresharedKey(const uint8_t* presharedKey)
 {
     m_socket->setPresharedKey(presharedKey);
+    for (uint32_t i = 1U; i < m_shards.size(); i++) {
+        m_shards[i]->socket->setPresharedKey(presharedKey);
+    }
+
+    if (m_multicast != nullptr) {
+        m_multicast->setPresharedKey(presharedKey);
+    }
 }
 
-/* Process a data frames from the network. */
+/* Process a data frame from the network. */
 
-void FNENetwork::processNetwork()
+bool FNENetwork::processNetwork(uint32_t shardNo)
 {
     if (m_status != NET_STAT_MST_RUNNING) {
-        return;
+        return false;
+    }
+
+    if (shardNo >= m_shards.size()) {
+        return false;
     }
 
+    FNESocketShard* shard = m_shards[shardNo];
+
     sockaddr_storage address;
     uint32_t addrLen;
     frame::RTPHeader rtpHeader;
@@ -221,11 +388,16 @@ void FNENetwork::processNetwork()
     int length = 0U;
 
     // read message
-    UInt8Array buffer = m_frameQueue->read(length, address, addrLen, &rtpHeader, &fneHeader);
+    UInt8Array buffer = shard->frameQueue->read(length, address, addrLen, &rtpHeader, &fneHeader);
     if (length > 0) {
         if (m_debug)
             Utils::dump(1U, "Network Message", buffer.get(), length);
 
+        uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        shard->rxFrames++;
+        shard->rxBytes += (uint64_t)length;
+        shard->lastRx = now;
+
         uint32_t peerId = fneHeader.getPeerId();
 
         NetPacketRequest* req = new NetPacketRequest();
@@ -240,12 +412,19 @@ void FNENetwork::processNetwork()
         req->buffer = new uint8_t[length];
         ::memcpy(req->buffer, buffer.get(), length);
 
+        req->shardNo = shardNo;
+
         if (!Thread::runAsThread(this, threadedNetworkRx, req)) {
+            shard->rxDropped++;
             delete[] req->buffer;
             delete req;
-            return;
+            return true;
         }
+
+        return true;
     }
+
+    return false;
 }
 
 /* Updates the timer by the passed number of milliseconds. */
@@ -262,6 +441,15 @@ void FNENetwork::clock(uint32_t ms)
         for (auto peer : m_peers) {
             peerACLUpdate(peer.first);
         }
+
+        // peers disconnected at the time of a forced update must be sent the ACL lists when they resume
+        {
+            std::lock_guard<std::mutex> lock(m_sessionMutex);
+            for (auto& session : m_sessions) {
+                session.second.lastACLUpdate = (m_peers.find(session.first) != m_peers.end()) ? now : 0U;
+            }
+        }
+
         m_forceListUpdate = false;
     }
 
@@ -295,6 +483,17 @@ void FNENetwork::clock(uint32_t ms)
             erasePeerAffiliations(peerId);
         }
 
+        // remove any expired login sessions
+        {
+            std::lock_guard<std::mutex> lock(m_sessionMutex);
+            for (auto it = m_sessions.begin(); it != m_sessions.end();) {
+                if (it->second.expires < now)
+                    it = m_sessions.erase(it);
+                else
+                    ++it;
+            }
+        }
+
         // roll the RTP timestamp if no call is in progress
         if (!m_callInProgress) {
             frame::RTPHeader::resetStartTime();
@@ -326,6 +525,11 @@ void FNENetwork::clock(uint32_t ms)
         m_parrotDelayTimer.isRunning() && m_parrotDelayTimer.hasExpired()) {
         m_parrotDelayTimer.stop();
     }
+
+    // route transcoded cross-mode traffic
+    if (m_transcoder != nullptr) {
+        m_transcoder->clock(ms);
+    }
 }
 
 /* Opens connection to the network. */
@@ -339,6 +543,7 @@ bool FNENetwork::open()
     m_maintainenceTimer.start();
 
     m_socket = new udp::Socket(m_address, m_port);
+    m_socket->setReusePort(m_socketShards > 1U);
 
     // reinitialize the frame queue
     if (m_frameQueue != nullptr) {
@@ -349,6 +554,50 @@ bool FNENetwork::open()
     bool ret = m_socket->open();
     if (!ret) {
         m_status = NET_STAT_INVALID;
+        return ret;
+    }
+
+    // shard 0 is always the primary socket; all outbound traffic is written through it, the
+    // additional shards share its port and are only used to receive
+    closeShards();
+    m_shards.push_back(new FNESocketShard(m_socket, m_frameQueue));
+    for (uint32_t i = 1U; i < m_socketShards; i++) {
+        udp::Socket* socket = new udp::Socket(m_address, m_port);
+        socket->setReusePort(true);
+        if (!socket->open()) {
+            LogError(LOG_NET, "Failed to open master socket shard %u, continuing with %u shards", i, i);
+            delete socket;
+            break;
+        }
+
+        m_shards.push_back(new FNESocketShard(socket, new FrameQueue(socket, m_peerId, m_debug)));
+    }
+
+    if (m_shards.size() > 1U) {
+        LogInfoEx(LOG_NET, "Master listener sharded across %u sockets", m_shards.size());
+    }
+
+    // open the multicast group (peers fall back to unicast if this fails)
+    if (m_multicastEnabled) {
+        if (m_multicast == nullptr) {
+            m_multicast = new MulticastGroup(m_peerId, m_multicastGroupId, m_multicastAddress, m_multicastPort, m_multicastInterface,
+                m_multicastTTL, m_multicastRetransmitFrames, m_debug);
+        }
+
+        if (!m_multicast->open()) {
+            LogError(LOG_NET, "Failed to open multicast group, traffic will be sent to all peers by unicast");
+            delete m_multicast;
+            m_multicast = nullptr;
+        }
+    }
+
+    // start the cross-mode transcoder (patched calls are not transcoded if this fails)
+    if (m_transcoder != nullptr) {
+        if (!m_transcoder->start()) {
+            LogError(LOG_NET, "Failed to start cross-mode transcoder, patched talkgroups will not be transcoded");
+            delete m_transcoder;
+            m_transcoder = nullptr;
+        }
     }
 
     return ret;
@@ -371,6 +620,17 @@ void FNENetwork::close()
     }
 
     m_socket->close();
+    for (uint32_t i = 1U; i < m_shards.size(); i++) {
+        m_shards[i]->socket->close();
+    }
+
+    if (m_multicast != nullptr) {
+        m_multicast->close();
+    }
+
+    if (m_transcoder != nullptr) {
+        m_transcoder->stop();
+    }
 
     m_maintainenceTimer.stop();
 
@@ -548,6 +808,12 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                             break;
                         }
 
+                        if (!network->admitPeerLogin(peerId, now)) {
+                            LogWarning(LOG_NET, "PEER %u attempted to connect while the login rate limit is exceeded, loginRateLimit = %u", peerId, network->m_loginRateLimit);
+                            network->writePeerNAK(peerId, TAG_REPEATER_LOGIN, NET_CONN_NAK_FNE_BUSY, req->address, req->addrLen);
+                            break;
+                        }
+
                         FNEPeerConnection* connection = new FNEPeerConnection(peerId, req->address, req->addrLen);
                         connection->lastPing(now);
                         connection->currStreamId(streamId);
@@ -577,6 +843,13 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                             FNEPeerConnection* connection = network->m_peers[peerId];
                             if (connection != nullptr) {
                                 if (connection->connectionState() == NET_STAT_RUNNING) {
+                                    if (!network->admitPeerLogin(peerId, now)) {
+                                        LogWarning(LOG_NET, "PEER %u (%s) attempted to reconnect while the login rate limit is exceeded, loginRateLimit = %u", peerId, connection->identity().c_str(),
+                                            network->m_loginRateLimit);
+                                        network->writePeerNAK(peerId, TAG_REPEATER_LOGIN, NET_CONN_NAK_FNE_BUSY, req->address, req->addrLen);
+                                        break;
+                                    }
+
                                     LogMessage(LOG_NET, "PEER %u (%s) resetting peer connection, connectionState = %u", peerId, connection->identity().c_str(),
                                         connection->connectionState());
                                     delete connection;
@@ -680,9 +953,9 @@ void* FNENetwork::threadedNetworkRx(void* arg)
 
                                     delete[] in;
 
-                                    // validate hash
+                                    // validate hash (the hash may be followed by a session ticket and configuration hash)
                                     bool validHash = false;
-                                    if (req->length - 8U == 32U) {
+                                    if (req->length - 8U >= 32U) {
                                         validHash = true;
                                         for (uint8_t i = 0; i < 32U; i++) {
                                             if (hash[i] != out[i]) {
@@ -692,7 +965,36 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                         }
                                     }
 
-                                    if (validHash) {
+                                    // did the peer present a session ticket to resume its previous login session?
+                                    FNEPeerSession session;
+                                    bool resumed = false;
+                                    if (validHash && req->length - 8U >= 44U) {
+                                        uint32_t ticketHi = __GET_UINT32(hash, 32U);
+                                        uint32_t ticketLo = __GET_UINT32(hash, 36U);
+                                        uint64_t ticket = ((uint64_t)ticketHi << 32) | ticketLo;
+                                        uint32_t configHash = __GET_UINT32(hash, 40U);
+                                        resumed = network->resumePeerSession(peerId, ticket, configHash, now, session);
+                                    }
+
+                                    if (validHash && resumed) {
+                                        // the configuration is unchanged from the previous login, skip the configuration exchange
+                                        connection->config(session.config);
+                                        connection->pktLastSeq(RTP_END_OF_CALL_SEQ);
+
+                                        // the peer already holds the ACL lists sent during the session, if they are due for an
+                                        // update stagger the update rather than sending every resuming peer the lists at once
+                                        uint64_t aclUpdateTime = network->m_updateLookupTime * 1000ULL;
+                                        uint64_t lastACLUpdate = session.lastACLUpdate;
+                                        if (lastACLUpdate + aclUpdateTime < now) {
+                                            std::lock_guard<std::mutex> lock(network->m_sessionMutex);
+                                            std::uniform_int_distribution<uint32_t> dist(0U, RESUME_ACL_UPDATE_JITTER);
+                                            lastACLUpdate = now - aclUpdateTime + dist(network->m_random);
+                                        }
+
+                                        network->completePeerLogin(peerId, connection, session.configHash, lastACLUpdate, now);
+                                        LogInfoEx(LOG_NET, "PEER %u RPTK ACK, resumed login session, completed the login exchange", peerId);
+                                    }
+                                    else if (validHash) {
                                         connection->connectionState(NET_STAT_WAITING_CONFIG);
                                         network->writePeerACK(peerId);
                                         LogInfoEx(LOG_NET, "PEER %u RPTK ACK, completed the login exchange", peerId);
@@ -752,57 +1054,9 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                     }
                                     else {
                                         connection->config(v.get<json::object>());
-                                        connection->connectionState(NET_STAT_RUNNING);
-                                        connection->connected(true);
-                                        connection->pingsReceived(0U);
-                                        connection->lastPing(now);
-                                        connection->lastACLUpdate(now);
-                                        network->m_peers[peerId] = connection;
-
-                                        // attach extra notification data to the RPTC ACK to notify the peer of 
-                                        // the use of the alternate diagnostic port
-                                        uint8_t buffer[1U];
-                                        buffer[0U] = 0x00U;
-                                        if (network->m_host->m_useAlternatePortForDiagnostics) {
-                                            buffer[0U] = 0x80U;
-                                        }
-
-                                        network->writePeerACK(peerId, buffer, 1U);
+                                        network->completePeerLogin(peerId, connection, configHash(rawPayload, req->length - 8U), now, now);
                                         LogInfoEx(LOG_NET, "PEER %u RPTC ACK, completed the configuration exchange", peerId);
 
-                                        json::object peerConfig = connection->config();
-                                        if (peerConfig["identity"].is<std::string>()) {
-                                            std::string identity = peerConfig["identity"].get<std::string>();
-                                            connection->identity(identity);
-                                            LogInfoEx(LOG_NET, "PEER %u reports identity [%8s]", peerId, identity.c_str());
-                                        }
-
-                                        if (peerConfig["externalPeer"].is<bool>()) {
-                                            bool external = peerConfig["externalPeer"].get<bool>();
-                                            connection->isExternalPeer(external);
-                                            if (external)
-                                                LogInfoEx(LOG_NET, "PEER %u reports external peer", peerId);
-                                        }
-
-                                        if (peerConfig["conventionalPeer"].is<bool>()) {
-                                            if (network->m_allowConvSiteAffOverride) {
-                                                bool convPeer = peerConfig["conventionalPeer"].get<bool>();
-                                                connection->isConventionalPeer(convPeer);
-                                                if (convPeer)
-                                                    LogInfoEx(LOG_NET, "PEER %u reports conventional peer", peerId);
-                                            }
-                                        }
-
-                                        if (peerConfig["software"].is<std::string>()) {
-                                            std::string software = peerConfig["software"].get<std::string>();
-                                            LogInfoEx(LOG_NET, "PEER %u reports software %s", peerId, software.c_str());
-                                        }
-
-                                        // setup the affiliations list for this peer
-                                        std::stringstream peerName;
-                                        peerName << "PEER " << peerId;
-                                        network->createPeerAffiliations(peerId, peerName.str());
-
                                         // spin up a thread and send ACL list over to peer
                                         network->peerACLUpdate(peerId);
                                     }
@@ -833,6 +1087,7 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                             // validate peer (simple validation really)
                             if (connection->connected() && connection->address() == ip) {
                                 LogInfoEx(LOG_NET, "PEER %u (%s) is closing down", peerId, connection->identity().c_str());
+                                network->erasePeerSession(peerId);
                                 if (network->erasePeer(peerId)) {
                                     network->erasePeerAffiliations(peerId);
                                     delete connection;
@@ -857,6 +1112,7 @@ void* FNENetwork::threadedNetworkRx(void* arg)
 
                                 connection->pingsReceived(pingsRx);
                                 connection->lastPing(now);
+                                connection->socketShard(req->shardNo);
 
                                 // does this peer need an ACL update?
                                 uint64_t dt = connection->lastACLUpdate() + (network->m_updateLookupTime * 1000);
@@ -865,6 +1121,7 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                         dt, now);
                                     if (connection->pktLastSeq() == RTP_END_OF_CALL_SEQ) {
                                         network->peerACLUpdate(peerId);
+                                        network->updatePeerSessionACL(peerId, now);
                                     }
                                     connection->lastACLUpdate(now);
                                 }
@@ -898,6 +1155,57 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                 }
                 break;
 
+            case NET_FUNC::MCAST_NAK:                                                                   // Multicast Group Retransmit Request
+                {
+                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                        FNEPeerConnection* connection = network->m_peers[peerId];
+                        if (connection != nullptr) {
+                            std::string ip = udp::Socket::address(req->address);
+
+                            // validate peer (simple validation really)
+                            if (connection->connected() && connection->address() == ip && network->isGroupPeer(connection) &&
+                                req->length >= 10) {
+                                uint32_t groupId = __GET_UINT32(req->buffer, 0U);
+                                uint32_t groupSeq = __GET_UINT32(req->buffer, 4U);
+                                uint32_t count = __GET_UINT16B(req->buffer, 8U);
+                                if (groupId == network->m_multicast->groupId()) {
+                                    if (count > MAX_MCAST_RETRANSMIT) {
+                                        count = MAX_MCAST_RETRANSMIT;
+                                    }
+
+                                    // retransmit the missed group messages to the peer by unicast
+                                    uint32_t retransmitted = 0U;
+                                    for (uint32_t i = 0U; i < count; i++) {
+                                        MulticastGroupFrame frame;
+                                        if (!network->m_multicast->find(groupSeq + i, frame)) {
+                                            continue;
+                                        }
+
+                                        // peers never receive their own traffic
+                                        if (frame.srcPeerId == peerId) {
+                                            continue;
+                                        }
+
+                                        network->writePeer(peerId, { frame.func, frame.subFunc }, frame.data.data(), (uint32_t)frame.data.size(),
+                                            frame.pktSeq, frame.streamId, true);
+                                        retransmitted++;
+                                    }
+
+                                    network->m_frameQueue->flushQueue();
+                                    if (network->m_verbose) {
+                                        LogInfoEx(LOG_NET, "PEER %u (%s) multicast retransmit request, groupSeq = %u, count = %u, retransmitted = %u", peerId, connection->identity().c_str(),
+                                            groupSeq, count, retransmitted);
+                                    }
+                                }
+                                else {
+                                    LogWarning(LOG_NET, "PEER %u (%s) multicast retransmit request for unknown group %u", peerId, connection->identity().c_str(), groupId);
+                                }
+                            }
+                        }
+                    }
+                }
+                break;
+
             case NET_FUNC::GRANT_REQ:                                                                   // Repeater Grant Request
                 {
                     if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
@@ -1225,6 +1533,25 @@ void* FNENetwork::threadedNetworkRx(void* arg)
     return nullptr;
 }
 
+/* Helper to release the master socket shards. */
+
+void FNENetwork::closeShards()
+{
+    // shard 0 is the primary socket and frame queue, which are owned by BaseNetwork
+    for (uint32_t i = 1U; i < m_shards.size(); i++) {
+        FNESocketShard* shard = m_shards[i];
+        shard->socket->close();
+        delete shard->frameQueue;
+        delete shard->socket;
+    }
+
+    for (FNESocketShard* shard : m_shards) {
+        delete shard;
+    }
+
+    m_shards.clear();
+}
+
 /* Checks if the passed peer ID is blocked from unit-to-unit traffic. */
 
 bool FNENetwork::checkU2UDroppedPeer(uint32_t peerId)
@@ -1249,6 +1576,22 @@ void FNENetwork::createPeerAffiliations(uint32_t peerId, std::string peerName)
     lookups::ChannelLookup* chLookup = new lookups::ChannelLookup();
     m_peerAffiliations[peerId] = new lookups::AffiliationLookup(peerName, chLookup, m_verbose);
     m_peerAffiliations[peerId]->setDisableUnitRegTimeout(true); // FNE doesn't allow unit registration timeouts (notification must come from the peers)
+    m_peerAffiliations[peerId]->setChangeCallback([=](lookups::AFF_CHANGE::ENUM change, uint32_t srcId, uint32_t dstId, uint32_t chNo) {
+        if (m_eventStream == nullptr || !m_eventStream->hasSubscribers())
+            return;
+
+        json::object event = json::object();
+        uint32_t peer = peerId;
+        event["peerId"].set<uint32_t>(peer);
+        event["srcId"].set<uint32_t>(srcId);
+        if (dstId != 0U) {
+            event["dstId"].set<uint32_t>(dstId);
+        }
+        if (chNo != 0U) {
+            event["chNo"].set<uint32_t>(chNo);
+        }
+        m_eventStream->publish(lookups::AffiliationLookup::changeToString(change), event);
+    });
 }
 
 /* Helper to erase the peer from the peers affiliations list. */
@@ -1267,12 +1610,40 @@ bool FNENetwork::erasePeerAffiliations(uint32_t peerId)
         }
         m_peerAffiliations.erase(peerId);
 
+        if (m_eventStream != nullptr && m_eventStream->hasSubscribers()) {
+            json::object event = json::object();
+            event["peerId"].set<uint32_t>(peerId);
+            m_eventStream->publish(EVENT_PEER_DISCONNECT, event);
+        }
+
         return true;
     }
 
     return false;
 }
 
+/* Helper to publish a call start or end event to the REST API event stream. */
+
+void FNENetwork::publishCallEvent(bool start, const char* mode, uint32_t peerId, uint32_t srcId, uint32_t dstId, uint32_t slotNo, uint64_t duration)
+{
+    if (m_eventStream == nullptr || !m_eventStream->hasSubscribers())
+        return;
+
+    json::object event = json::object();
+    event["mode"].set<std::string>(std::string(mode));
+    event["peerId"].set<uint32_t>(peerId);
+    if (slotNo > 0U) {
+        event["slot"].set<uint32_t>(slotNo);
+    }
+    event["srcId"].set<uint32_t>(srcId);
+    event["dstId"].set<uint32_t>(dstId);
+    if (!start) {
+        event["duration"].set<uint64_t>(duration);
+    }
+
+    m_eventStream->publish(start ? EVENT_CALL_START : EVENT_CALL_END, event);
+}
+
 /* Helper to erase the peer from the peers list. */
 
 bool FNENetwork::erasePeer(uint32_t peerId)
@@ -1312,6 +1683,7 @@ bool FNENetwork::resetPeer(uint32_t peerId)
 
             writePeerNAK(peerId, TAG_REPEATER_LOGIN, NET_CONN_NAK_PEER_RESET, addr, addrLen);
 
+            erasePeerSession(peerId);
             delete connection;
             erasePeer(peerId);
 
@@ -1343,8 +1715,12 @@ std::string FNENetwork::resolvePeerIdentity(uint32_t peerId)
 
 void FNENetwork::setupRepeaterLogin(uint32_t peerId, FNEPeerConnection* connection)
 {
-    std::uniform_int_distribution<uint32_t> dist(DVM_RAND_MIN, DVM_RAND_MAX);
-    connection->salt(dist(m_random));
+    {
+        // the random engine is shared by the network threads
+        std::lock_guard<std::mutex> lock(m_sessionMutex);
+        std::uniform_int_distribution<uint32_t> dist(DVM_RAND_MIN, DVM_RAND_MAX);
+        connection->salt(dist(m_random));
+    }
 
     LogInfoEx(LOG_NET, "PEER %u started login from, %s:%u", peerId, connection->address().c_str(), connection->port());
 
@@ -1360,6 +1736,178 @@ void FNENetwork::setupRepeaterLogin(uint32_t peerId, FNEPeerConnection* connecti
     LogInfoEx(LOG_NET, "PEER %u RPTL ACK, challenge response sent for login", peerId);
 }
 
+/* Helper to complete a peer login, once the configuration is known. */
+
+void FNENetwork::completePeerLogin(uint32_t peerId, FNEPeerConnection* connection, uint32_t configHash, uint64_t lastACLUpdate, uint64_t now)
+{
+    connection->connectionState(NET_STAT_RUNNING);
+    connection->connected(true);
+    connection->pingsReceived(0U);
+    connection->lastPing(now);
+    connection->lastACLUpdate(lastACLUpdate);
+    m_peers[peerId] = connection;
+
+    json::object peerConfig = connection->config();
+
+    // does the peer receive traffic from the multicast group?
+    connection->isMulticastPeer(false);
+    if (peerConfig["multicast"].is<bool>() && m_multicast != nullptr) {
+        connection->isMulticastPeer(peerConfig["multicast"].get<bool>());
+    }
+
+    // issue a new session ticket, replacing any previous session of the peer
+    uint64_t ticket = 0U;
+    if (m_sessionTTL > 0U) {
+        std::lock_guard<std::mutex> lock(m_sessionMutex);
+        std::uniform_int_distribution<uint64_t> dist(1U, UINT64_MAX);
+
+        FNEPeerSession session;
+        session.ticket = ticket = dist(m_random);
+        session.configHash = configHash;
+        session.config = peerConfig;
+        session.lastACLUpdate = lastACLUpdate;
+        session.expires = now + (m_sessionTTL * 1000ULL);
+        m_sessions[peerId] = session;
+    }
+
+    // attach extra notification data to the login ACK to notify the peer of the use of the
+    // alternate diagnostic port, of the multicast group, and of the session ticket
+    uint8_t buffer[13U];
+    ::memset(buffer, 0x00U, 13U);
+    if (m_host->m_useAlternatePortForDiagnostics) {
+        buffer[0U] |= 0x80U;
+    }
+
+    if (connection->isMulticastPeer()) {
+        buffer[0U] |= 0x40U;
+        __SET_UINT32(m_multicast->groupId(), buffer, 1U);
+    }
+
+    if (ticket != 0U) {
+        buffer[0U] |= 0x20U;
+        __SET_UINT32((uint32_t)(ticket >> 32), buffer, 5U);
+        __SET_UINT32((uint32_t)(ticket & 0xFFFFFFFFU), buffer, 9U);
+    }
+
+    writePeerACK(peerId, buffer, (ticket != 0U) ? 13U : 5U);
+    if (connection->isMulticastPeer()) {
+        LogInfoEx(LOG_NET, "PEER %u receives traffic from multicast group %u", peerId, m_multicast->groupId());
+    }
+
+    if (peerConfig["identity"].is<std::string>()) {
+        std::string identity = peerConfig["identity"].get<std::string>();
+        connection->identity(identity);
+        LogInfoEx(LOG_NET, "PEER %u reports identity [%8s]", peerId, identity.c_str());
+    }
+
+    if (peerConfig["externalPeer"].is<bool>()) {
+        bool external = peerConfig["externalPeer"].get<bool>();
+        connection->isExternalPeer(external);
+        if (external)
+            LogInfoEx(LOG_NET, "PEER %u reports external peer", peerId);
+    }
+
+    if (peerConfig["conventionalPeer"].is<bool>()) {
+        if (m_allowConvSiteAffOverride) {
+            bool convPeer = peerConfig["conventionalPeer"].get<bool>();
+            connection->isConventionalPeer(convPeer);
+            if (convPeer)
+                LogInfoEx(LOG_NET, "PEER %u reports conventional peer", peerId);
+        }
+    }
+
+    if (peerConfig["software"].is<std::string>()) {
+        std::string software = peerConfig["software"].get<std::string>();
+        LogInfoEx(LOG_NET, "PEER %u reports software %s", peerId, software.c_str());
+    }
+
+    // setup the affiliations list for this peer
+    std::stringstream peerName;
+    peerName << "PEER " << peerId;
+    createPeerAffiliations(peerId, peerName.str());
+
+    if (m_eventStream != nullptr && m_eventStream->hasSubscribers()) {
+        json::object event = json::object();
+        event["peerId"].set<uint32_t>(peerId);
+        std::string identity = connection->identity();
+        event["identity"].set<std::string>(identity);
+        std::string address = connection->address();
+        event["address"].set<std::string>(address);
+        m_eventStream->publish(EVENT_PEER_CONNECT, event);
+    }
+}
+
+/* Helper to determine if a login from the specified peer is admitted by the login rate limit. */
+
+bool FNENetwork::admitPeerLogin(uint32_t peerId, uint64_t now)
+{
+    if (m_loginRateLimit == 0U)
+        return true;
+
+    std::lock_guard<std::mutex> lock(m_sessionMutex);
+
+    // peers holding a login session resume without the configuration exchange or the ACL update, and
+    // are always admitted
+    auto it = m_sessions.find(peerId);
+    if (it != m_sessions.end() && it->second.expires >= now)
+        return true;
+
+    // refill the token bucket for the time elapsed since the last login
+    if (m_loginTokenTime != 0U && now > m_loginTokenTime) {
+        m_loginTokens += ((double)(now - m_loginTokenTime) * m_loginRateLimit) / 1000.0;
+        if (m_loginTokens > (double)m_loginBurst)
+            m_loginTokens = (double)m_loginBurst;
+    }
+    m_loginTokenTime = now;
+
+    if (m_loginTokens < 1.0)
+        return false;
+
+    m_loginTokens -= 1.0;
+    return true;
+}
+
+/* Helper to resume the login session of the specified peer. */
+
+bool FNENetwork::resumePeerSession(uint32_t peerId, uint64_t ticket, uint32_t configHash, uint64_t now, FNEPeerSession& session)
+{
+    std::lock_guard<std::mutex> lock(m_sessionMutex);
+    auto it = m_sessions.find(peerId);
+    if (it == m_sessions.end())
+        return false;
+
+    // a ticket is only ever presented once, a mismatched or expired session is discarded
+    bool valid = it->second.ticket == ticket && it->second.configHash == configHash && it->second.expires >= now;
+    if (valid) {
+        session = it->second;
+    }
+    else {
+        LogWarning(LOG_NET, "PEER %u presented an invalid or expired login session, performing configuration exchange", peerId);
+    }
+
+    m_sessions.erase(it);
+    return valid;
+}
+
+/* Helper to update the time the ACL lists were last sent to the specified peer in its login session. */
+
+void FNENetwork::updatePeerSessionACL(uint32_t peerId, uint64_t lastACLUpdate)
+{
+    std::lock_guard<std::mutex> lock(m_sessionMutex);
+    auto it = m_sessions.find(peerId);
+    if (it != m_sessions.end()) {
+        it->second.lastACLUpdate = lastACLUpdate;
+    }
+}
+
+/* Helper to erase the login session of the specified peer. */
+
+void FNENetwork::erasePeerSession(uint32_t peerId)
+{
+    std::lock_guard<std::mutex> lock(m_sessionMutex);
+    m_sessions.erase(peerId);
+}
+
 /* Helper to send the ACL lists to the specified peer in a separate thread. */
 
 void FNENetwork::peerACLUpdate(uint32_t peerId)
@@ -1756,6 +2304,44 @@ bool FNENetwork::writePeer(uint32_t peerId, FrameQueue::OpcodePair opcode, const
     return false;
 }
 
+/* Helper to send a data message to the given multicast group peers. */
+
+void FNENetwork::writeGroup(uint32_t srcPeerId, const std::vector<uint32_t>& peers, FrameQueue::OpcodePair opcode, const uint8_t* data,
+    uint32_t length, uint16_t pktSeq, uint32_t streamId) const
+{
+    if (peers.empty()) {
+        return;
+    }
+
+    if (m_multicast != nullptr && peers.size() >= m_multicastMinPeers) {
+        // every group peer receives the group message, so the group can only be used if the recipients are
+        // the connected group peers other than the source (the source peer, if it is a group peer, also
+        // receives the message, and drops it as its own)
+        bool allGroupPeers = true;
+        for (auto peer : m_peers) {
+            if (peer.first == srcPeerId || !isGroupPeer(peer.second) || !peer.second->connected()) {
+                continue;
+            }
+
+            if (std::find(peers.begin(), peers.end(), peer.first) == peers.end()) {
+                allGroupPeers = false;
+                break;
+            }
+        }
+
+        if (allGroupPeers) {
+            if (m_multicast->write(srcPeerId, opcode, data, length, pktSeq, streamId)) {
+                return;
+            }
+        }
+    }
+
+    // fallback to unicast
+    for (uint32_t peerId : peers) {
+        writePeer(peerId, opcode, data, length, pktSeq, streamId, true);
+    }
+}
+
 /* Helper to send a command message to the specified peer. */
 
 bool FNENetwork::writePeerCommand(uint32_t peerId, FrameQueue::OpcodePair opcode,
@@ -1813,6 +2399,9 @@ void FNENetwork::logPeerNAKReason(uint32_t peerId, const char* tag, NET_CONN_NAK
     case NET_CONN_NAK_FNE_MAX_CONN:
         LogWarning(LOG_NET, "PEER %u NAK %s, reason = %u; FNE has reached maximum permitted connections", peerId, tag, (uint16_t)reason);
         break;
+    case NET_CONN_NAK_FNE_BUSY:
+        LogWarning(LOG_NET, "PEER %u NAK %s, reason = %u; FNE login rate limit exceeded", peerId, tag, (uint16_t)reason);
+        break;
     case NET_CONN_NAK_PEER_RESET:
         LogWarning(LOG_NET, "PEER %u NAK %s, reason = %u; FNE demanded connection reset", peerId, tag, (uint16_t)reason);
         break;
@@ -27,6 +27,7 @@
 #include "fne/Defines.h"
 #include "common/network/BaseNetwork.h"
 #include "common/network/json/json.h"
+#include "common/network/rest/EventStream.h"
 #include "common/lookups/AffiliationLookup.h"
 #include "common/lookups/RadioIdLookup.h"
 #include "common/lookups/TalkgroupRulesLookup.h"
@@ -38,6 +39,8 @@
 #include <cstdint>
 #include <unordered_map>
 #include <mutex>
+#include <atomic>
+#include <vector>
 
 // ---------------------------------------------------------------------------
 //  Class Prototypes
@@ -50,6 +53,7 @@ namespace network { namespace callhandler { namespace packetdata { class HOST_SW
 namespace network { namespace callhandler { class HOST_SW_API TagP25Data; } }
 namespace network { namespace callhandler { namespace packetdata { class HOST_SW_API P25PacketData; } } }
 namespace network { namespace callhandler { class HOST_SW_API TagNXDNData; } }
+namespace network { namespace callhandler { class HOST_SW_API CrossModeTranscoder; } }
 
 namespace network
 {
@@ -82,6 +86,7 @@ namespace network
 
     class HOST_SW_API DiagNetwork;
     class HOST_SW_API FNENetwork;
+    class HOST_SW_API MulticastGroup;
 
     // ---------------------------------------------------------------------------
     //  Class Declaration
@@ -115,6 +120,8 @@ namespace network
             m_lastPing(0U),
             m_lastACLUpdate(0U),
             m_isExternalPeer(false),
+            m_isMulticastPeer(false),
+            m_socketShard(0U),
             m_config(),
             m_pktLastSeq(RTP_END_OF_CALL_SEQ),
             m_pktNextSeq(1U)
@@ -142,6 +149,8 @@ namespace network
             m_lastPing(0U),
             m_lastACLUpdate(0U),
             m_isExternalPeer(false),
+            m_isMulticastPeer(false),
+            m_socketShard(0U),
             m_config(),
             m_pktLastSeq(RTP_END_OF_CALL_SEQ),
             m_pktNextSeq(1U)
@@ -227,6 +236,14 @@ namespace network
          * 
          */
         __PROPERTY_PLAIN(bool, isConventionalPeer);
+        /**
+         * @brief Flag indicating this connection is from a peer receiving traffic from the multicast group.
+         */
+        __PROPERTY_PLAIN(bool, isMulticastPeer);
+        /**
+         * @brief Master socket shard this peer was last received on.
+         */
+        __PROPERTY_PLAIN(uint32_t, socketShard);
 
         /**
          * @brief JSON objecting containing peer configuration information.
@@ -272,6 +289,91 @@ namespace network
         frame::RTPFNEHeader fneHeader;      //! RTP FNE Header
         int length = 0U;                    //! Length of raw data buffer
         uint8_t *buffer;                    //! Raw data buffer
+
+        uint32_t shardNo = 0U;              //! Master socket shard the packet was received on.
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents the data required for a master socket shard reader thread.
+     * @ingroup fne_network
+     */
+    struct SocketShardRequest : thread_t {
+        uint32_t shardNo;                   //! Master socket shard to read.
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents one socket of the master listener.
+     * @ingroup fne_network
+     * 
+     *  When the master listener is sharded, each shard is a separate UDP socket bound to the
+     *  master port with SO_REUSEPORT; the kernel hashes each peer flow to a single shard.
+     */
+    class HOST_SW_API FNESocketShard {
+    public:
+        /**
+         * @brief Initializes a new instance of the FNESocketShard class.
+         * @param socket Instance of the udp::Socket class.
+         * @param frameQueue Instance of the FrameQueue class reading from the socket.
+         */
+        FNESocketShard(udp::Socket* socket, FrameQueue* frameQueue) :
+            socket(socket),
+            frameQueue(frameQueue),
+            rxFrames(0U),
+            rxBytes(0U),
+            rxDropped(0U),
+            lastRx(0U)
+        {
+            /* stub */
+        }
+
+        udp::Socket* socket;                //! Socket bound to the master port.
+        FrameQueue* frameQueue;             //! Frame queue reading from the socket.
+
+        std::atomic<uint64_t> rxFrames;     //! Count of frames received on this shard.
+        std::atomic<uint64_t> rxBytes;      //! Count of bytes received on this shard.
+        std::atomic<uint64_t> rxDropped;    //! Count of frames dropped because a handler thread could not be started.
+        std::atomic<uint64_t> lastRx;       //! Time (in ms) the last frame was received on this shard.
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents a login session of a peer, retained after the peer disconnects.
+     * @ingroup fne_network
+     * 
+     *  A peer presenting the session ticket (and an unchanged configuration hash) with its authorisation
+     *  resumes the login session; the configuration exchange and the initial ACL update are skipped.
+     */
+    class HOST_SW_API FNEPeerSession {
+    public:
+        /**
+         * @brief Initializes a new instance of the FNEPeerSession class.
+         */
+        FNEPeerSession() :
+            ticket(0U),
+            configHash(0U),
+            config(),
+            lastACLUpdate(0U),
+            expires(0U)
+        {
+            /* stub */
+        }
+
+        uint64_t ticket;                    //! Session ticket issued to the peer.
+        uint32_t configHash;                //! Hash of the configuration data the peer logged in with.
+        json::object config;                //! Configuration data the peer logged in with.
+        uint64_t lastACLUpdate;             //! Time (in ms) the ACL lists were last sent to the peer.
+        uint64_t expires;                   //! Time (in ms) the session expires.
     };
 
     // ---------------------------------------------------------------------------
@@ -340,6 +442,12 @@ namespace network
          * @returns callhandler::TagNXDNData* Instance of the TagNXDNData call handler.
          */
         callhandler::TagNXDNData* nxdnTrafficHandler() const { return m_tagNXDN; }
+        /**
+         * @brief Gets the instance of the cross-mode transcoder.
+         * @returns callhandler::CrossModeTranscoder* Instance of the CrossModeTranscoder class (or nullptr if
+         *  cross-mode transcoding is disabled).
+         */
+        callhandler::CrossModeTranscoder* transcoder() const { return m_transcoder; }
 
         /**
          * @brief Sets the instances of the Radio ID, Talkgroup ID and Peer List lookup tables.
@@ -353,11 +461,29 @@ namespace network
          * @param presharedKey Encryption preshared key for networking.
          */
         void setPresharedKey(const uint8_t* presharedKey);
+        /**
+         * @brief Sets the REST API event stream to publish peer, affiliation and call events to.
+         * @param eventStream Instance of the EventStream class.
+         */
+        void setEventStream(network::rest::EventStream* eventStream) { m_eventStream = eventStream; }
+
+        /**
+         * @brief Process a data frame from the network.
+         * @param shardNo Master socket shard to read from.
+         * @returns bool True, if a data frame was read, otherwise false.
+         */
+        bool processNetwork(uint32_t shardNo = 0U);
 
         /**
-         * @brief Process data frames from the network.
+         * @brief Gets the number of opened master socket shards.
+         * @returns uint32_t Number of opened master socket shards.
          */
-        void processNetwork();
+        uint32_t socketShards() const { return (uint32_t)m_shards.size(); }
+        /**
+         * @brief Gets the flag indicating whether master socket shard reader threads are pinned to a CPU core.
+         * @returns bool True, if shard reader threads are pinned, otherwise false.
+         */
+        bool socketShardAffinity() const { return m_socketShardAffinity; }
 
         /**
          * @brief Updates the timer by the passed number of milliseconds.
@@ -393,6 +519,8 @@ namespace network
         callhandler::TagP25Data* m_tagP25;
         friend class callhandler::TagNXDNData;
         callhandler::TagNXDNData* m_tagNXDN;
+        friend class callhandler::CrossModeTranscoder;
+        callhandler::CrossModeTranscoder* m_transcoder;
         
         friend class ::RESTAPI;
         HostFNE* m_host;
@@ -429,6 +557,15 @@ namespace network
         uint32_t m_updateLookupTime;
         uint32_t m_softConnLimit;
 
+        std::mutex m_sessionMutex;
+        std::unordered_map<uint32_t, FNEPeerSession> m_sessions;
+        uint32_t m_sessionTTL;
+
+        uint32_t m_loginRateLimit;
+        uint32_t m_loginBurst;
+        double m_loginTokens;
+        uint64_t m_loginTokenTime;
+
         bool m_callInProgress;
 
         bool m_disallowAdjStsBcast;
@@ -455,6 +592,22 @@ namespace network
         bool m_disablePacketData;
         bool m_dumpDataPacket;
 
+        bool m_multicastEnabled;
+        std::string m_multicastAddress;
+        uint16_t m_multicastPort;
+        std::string m_multicastInterface;
+        uint8_t m_multicastTTL;
+        uint32_t m_multicastGroupId;
+        uint32_t m_multicastMinPeers;
+        uint32_t m_multicastRetransmitFrames;
+        MulticastGroup* m_multicast;
+
+        uint32_t m_socketShards;
+        bool m_socketShardAffinity;
+        std::vector<FNESocketShard*> m_shards;
+
+        network::rest::EventStream* m_eventStream;
+
         bool m_reportPeerPing;
         bool m_verbose;
 
@@ -464,6 +617,14 @@ namespace network
          * @returns void* (Ignore)
          */
         static void* threadedNetworkRx(void* arg);
+        /**
+         * @brief Helper to release the master socket shards.
+         * 
+         *  The shards are read without locking by the shard reader threads; they are only created
+         *  by open() (before the reader threads are started) and released by open() and the
+         *  destructor (after the reader threads have been joined), and are otherwise immutable.
+         */
+        void closeShards();
 
         /**
          * @brief Checks if the passed peer ID is blocked from unit-to-unit traffic.
@@ -484,6 +645,17 @@ namespace network
          * @returns bool True, if the peer affiliations were deleted, otherwise false.
          */
         bool erasePeerAffiliations(uint32_t peerId);
+        /**
+         * @brief Helper to publish a call start or end event to the REST API event stream.
+         * @param start Flag indicating the call started (otherwise the call ended).
+         * @param mode Digital mode.
+         * @param peerId Peer ID.
+         * @param srcId Source Radio ID.
+         * @param dstId Destination ID.
+         * @param slotNo DMR slot number (0 for modes without slots).
+         * @param duration Call duration in milliseconds (call end only).
+         */
+        void publishCallEvent(bool start, const char* mode, uint32_t peerId, uint32_t srcId, uint32_t dstId, uint32_t slotNo = 0U, uint64_t duration = 0U);
         /**
          * @brief Helper to erase the peer from the peers list.
          * @param peerId Peer ID.
@@ -505,6 +677,46 @@ namespace network
          */
         void setupRepeaterLogin(uint32_t peerId, FNEPeerConnection* connection);
 
+        /**
+         * @brief Helper to complete a peer login, once the configuration is known.
+         *  (This sends the login ACK and sets up the peer, the ACL lists are not sent.)
+         * @param peerId Peer ID.
+         * @param connection Instance of the FNEPeerConnection class.
+         * @param configHash Hash of the configuration data the peer logged in with.
+         * @param lastACLUpdate Time (in ms) the ACL lists were last sent to the peer.
+         * @param now Current time (in ms).
+         */
+        void completePeerLogin(uint32_t peerId, FNEPeerConnection* connection, uint32_t configHash, uint64_t lastACLUpdate, uint64_t now);
+        /**
+         * @brief Helper to determine if a login from the specified peer is admitted by the login rate limit.
+         * @param peerId Peer ID.
+         * @param now Current time (in ms).
+         * @returns bool True, if the login is admitted, otherwise false.
+         */
+        bool admitPeerLogin(uint32_t peerId, uint64_t now);
+        /**
+         * @brief Helper to resume the login session of the specified peer.
+         *  (The session is consumed, a resumed login is issued a new session ticket.)
+         * @param peerId Peer ID.
+         * @param ticket Session ticket presented by the peer.
+         * @param configHash Configuration hash presented by the peer.
+         * @param now Current time (in ms).
+         * @param[out] session Resumed login session.
+         * @returns bool True, if the login session was resumed, otherwise false.
+         */
+        bool resumePeerSession(uint32_t peerId, uint64_t ticket, uint32_t configHash, uint64_t now, FNEPeerSession& session);
+        /**
+         * @brief Helper to update the time the ACL lists were last sent to the specified peer in its login session.
+         * @param peerId Peer ID.
+         * @param lastACLUpdate Time (in ms) the ACL lists were last sent to the peer.
+         */
+        void updatePeerSessionACL(uint32_t peerId, uint64_t lastACLUpdate);
+        /**
+         * @brief Helper to erase the login session of the specified peer.
+         * @param peerId Peer ID.
+         */
+        void erasePeerSession(uint32_t peerId);
+
         /**
          * @brief Helper to send the ACL lists to the specified peer in a separate thread.
          * @param peerId Peer ID.
@@ -565,6 +777,27 @@ namespace network
         bool writePeer(uint32_t peerId, FrameQueue::OpcodePair opcode, const uint8_t* data, uint32_t length, 
             uint32_t streamId, bool queueOnly = false, bool incPktSeq = false, bool directWrite = false) const;
 
+        /**
+         * @brief Helper to determine if the given peer receives traffic from the multicast group.
+         * @param connection Instance of the FNEPeerConnection class.
+         * @returns bool True, if the peer receives traffic from the multicast group, otherwise false.
+         */
+        bool isGroupPeer(const FNEPeerConnection* connection) const { return m_multicast != nullptr && connection != nullptr && connection->isMulticastPeer(); }
+        /**
+         * @brief Helper to send a data message to the given multicast group peers.
+         *  The message is written once to the multicast group if every connected group peer (other than
+         *  the source peer) is a recipient, otherwise the message is queued to each peer by unicast.
+         * @param srcPeerId Peer ID the message was received from.
+         * @param peers List of multicast group peers permitted to receive the unmodified message.
+         * @param opcode FNE network opcode pair.
+         * @param[in] data Buffer containing message to send to the peers.
+         * @param length Length of buffer.
+         * @param pktSeq RTP packet sequence for this message.
+         * @param streamId Stream ID for this message.
+         */
+        void writeGroup(uint32_t srcPeerId, const std::vector<uint32_t>& peers, FrameQueue::OpcodePair opcode, const uint8_t* data,
+            uint32_t length, uint16_t pktSeq, uint32_t streamId) const;
+
         /**
          * @brief Helper to send a command message to the specified peer.
          * @param peerId Peer ID.
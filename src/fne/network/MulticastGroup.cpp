@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "fne/Defines.h"
+#include "common/edac/CRC.h"
+#include "common/network/MulticastHeader.h"
+#include "common/network/RTPHeader.h"
+#include "common/network/RTPFNEHeader.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+#include "network/MulticastGroup.h"
+
+using namespace network;
+using namespace network::frame;
+
+#include <cassert>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the MulticastGroup class. */
+
+MulticastGroup::MulticastGroup(uint32_t peerId, uint32_t groupId, const std::string& address, uint16_t port, const std::string& iface,
+    uint8_t ttl, uint32_t retransmitFrames, bool debug) :
+    m_peerId(peerId),
+    m_groupId(groupId),
+    m_address(address),
+    m_port(port),
+    m_iface(iface),
+    m_ttl(ttl),
+    m_socket(nullptr),
+    m_addr(),
+    m_addrLen(0U),
+    m_lock(),
+    m_groupSeq(0U),
+    m_frames(),
+    m_debug(debug)
+{
+    assert(groupId > 0U);
+    assert(!address.empty());
+    assert(port > 0U);
+    assert(retransmitFrames > 0U);
+
+    m_frames.resize(retransmitFrames);
+    for (auto& frame : m_frames) {
+        frame.groupSeq = 0U;
+    }
+
+    m_socket = new udp::Socket();
+}
+
+/* Finalizes a instance of the MulticastGroup class. */
+
+MulticastGroup::~MulticastGroup()
+{
+    delete m_socket;
+}
+
+/* Opens the multicast group socket. */
+
+bool MulticastGroup::open()
+{
+    if (udp::Socket::lookup(m_address, m_port, m_addr, m_addrLen) != 0) {
+        LogError(LOG_NET, "Could not lookup the address of the multicast group");
+        return false;
+    }
+
+    if (m_addr.ss_family != AF_INET) {
+        LogError(LOG_NET, "Multicast group address must be an IPv4 address, %s", m_address.c_str());
+        return false;
+    }
+
+    if (!m_socket->open(m_addr)) {
+        return false;
+    }
+
+    if (!m_socket->setMulticastOptions(m_iface, m_ttl, true)) {
+        m_socket->close();
+        return false;
+    }
+
+    LogInfoEx(LOG_NET, "Opening multicast group %u on %s:%u", m_groupId, m_address.c_str(), m_port);
+    return true;
+}
+
+/* Closes the multicast group socket. */
+
+void MulticastGroup::close()
+{
+    m_socket->close();
+}
+
+/* Sets endpoint preshared encryption key. */
+
+void MulticastGroup::setPresharedKey(const uint8_t* presharedKey)
+{
+    m_socket->setPresharedKey(presharedKey);
+}
+
+/* Writes a message to the multicast group. */
+
+bool MulticastGroup::write(uint32_t srcPeerId, FrameQueue::OpcodePair opcode, const uint8_t* data, uint32_t length,
+    uint16_t pktSeq, uint32_t streamId)
+{
+    assert(data != nullptr);
+    assert(length > 0U);
+
+    const uint32_t headerLen = MULTICAST_HEADER_LENGTH_BYTES + RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES;
+    if (length + headerLen > DATA_PACKET_LENGTH) {
+        LogError(LOG_NET, "Multicast group %u, message oversized? this shouldn't happen, len = %u", m_groupId, length);
+        return false;
+    }
+
+    uint8_t buffer[DATA_PACKET_LENGTH];
+    ::memset(buffer, 0x00U, headerLen);
+
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    m_groupSeq++;
+    if (m_groupSeq == 0U) {
+        m_groupSeq = 1U; // group sequence zero is reserved for "no sequence"
+    }
+
+    MulticastHeader groupHeader = MulticastHeader();
+    groupHeader.setGroupId(m_groupId);
+    groupHeader.setGroupSequence(m_groupSeq);
+    groupHeader.setSrcPeerId(srcPeerId);
+    groupHeader.encode(buffer);
+
+    RTPHeader header = RTPHeader();
+    header.setExtension(true);
+
+    header.setPayloadType(DVM_RTP_PAYLOAD_TYPE);
+    header.setSequence(pktSeq);
+    header.setSSRC(m_peerId);
+
+    header.encode(buffer + MULTICAST_HEADER_LENGTH_BYTES);
+
+    RTPFNEHeader fneHeader = RTPFNEHeader();
+    fneHeader.setCRC(edac::CRC::createCRC16(data, length * 8U));
+    fneHeader.setStreamId(streamId);
+    fneHeader.setPeerId(0U); // group messages are not destined for a single peer
+    fneHeader.setMessageLength(length);
+
+    fneHeader.setFunction(opcode.first);
+    fneHeader.setSubFunction(opcode.second);
+
+    fneHeader.encode(buffer + MULTICAST_HEADER_LENGTH_BYTES + RTP_HEADER_LENGTH_BYTES);
+
+    ::memcpy(buffer + headerLen, data, length);
+
+    if (m_debug)
+        Utils::dump(1U, "MulticastGroup::write() Message", buffer, length + headerLen);
+
+    // retain the message for retransmission
+    MulticastGroupFrame& frame = m_frames[m_groupSeq % m_frames.size()];
+    frame.groupSeq = m_groupSeq;
+    frame.srcPeerId = srcPeerId;
+    frame.func = opcode.first;
+    frame.subFunc = opcode.second;
+    frame.pktSeq = pktSeq;
+    frame.streamId = streamId;
+    frame.data.assign(data, data + length);
+
+    return m_socket->write(buffer, length + headerLen, m_addr, m_addrLen);
+}
+
+/* Finds a message previously written to the multicast group. */
+
+bool MulticastGroup::find(uint32_t groupSeq, MulticastGroupFrame& frame) const
+{
+    if (groupSeq == 0U) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    const MulticastGroupFrame& entry = m_frames[groupSeq % m_frames.size()];
+    if (entry.groupSeq != groupSeq) {
+        return false;
+    }
+
+    frame = entry;
+    return true;
+}
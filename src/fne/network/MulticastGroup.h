@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file MulticastGroup.h
+ * @ingroup fne_network
+ * @file MulticastGroup.cpp
+ * @ingroup fne_network
+ */
+#if !defined(__MULTICAST_GROUP_H__)
+#define __MULTICAST_GROUP_H__
+
+#include "fne/Defines.h"
+#include "common/network/FrameQueue.h"
+#include "common/network/udp/Socket.h"
+
+#include <string>
+#include <vector>
+#include <mutex>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents a message previously written to the multicast group.
+     * @ingroup fne_network
+     */
+    struct MulticastGroupFrame {
+        uint32_t groupSeq;                  //! Multicast Group Sequence
+        uint32_t srcPeerId;                 //! Peer ID the message was originally received from
+        NET_FUNC::ENUM func;                //! Function
+        NET_SUBFUNC::ENUM subFunc;          //! Sub-Function
+        uint16_t pktSeq;                    //! RTP Packet Sequence
+        uint32_t streamId;                  //! Stream ID
+        std::vector<uint8_t> data;          //! Message Buffer
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements the multicast group fan-out for co-located peers.
+     * @ingroup fne_network
+     *
+     *  A message written to the group is framed once (multicast group header, RTP header and
+     *  FNE header) and sent as a single datagram to the group address, instead of once per
+     *  peer. The most recent messages are retained so peers that miss a group sequence can
+     *  request a unicast retransmission.
+     */
+    class HOST_SW_API MulticastGroup {
+    public:
+        auto operator=(MulticastGroup&) -> MulticastGroup& = delete;
+        auto operator=(MulticastGroup&&) -> MulticastGroup& = delete;
+        MulticastGroup(MulticastGroup&) = delete;
+
+        /**
+         * @brief Initializes a new instance of the MulticastGroup class.
+         * @param peerId Unique ID of the FNE on the network.
+         * @param groupId Multicast Group ID.
+         * @param address Multicast group address.
+         * @param port Multicast group port number.
+         * @param iface Address of the local interface to send multicast from (blank for default).
+         * @param ttl Multicast time-to-live.
+         * @param retransmitFrames Number of messages retained for retransmission.
+         * @param debug Flag indicating whether network debug is enabled.
+         */
+        MulticastGroup(uint32_t peerId, uint32_t groupId, const std::string& address, uint16_t port, const std::string& iface,
+            uint8_t ttl, uint32_t retransmitFrames, bool debug);
+        /**
+         * @brief Finalizes a instance of the MulticastGroup class.
+         */
+        ~MulticastGroup();
+
+        /**
+         * @brief Opens the multicast group socket.
+         * @returns bool True, if the multicast group socket is opened, otherwise false.
+         */
+        bool open();
+        /**
+         * @brief Closes the multicast group socket.
+         */
+        void close();
+
+        /**
+         * @brief Sets endpoint preshared encryption key.
+         * @param presharedKey Encryption preshared key for networking.
+         */
+        void setPresharedKey(const uint8_t* presharedKey);
+
+        /**
+         * @brief Writes a message to the multicast group.
+         * @param srcPeerId Peer ID the message was originally received from.
+         * @param opcode FNE network opcode pair.
+         * @param[in] data Buffer containing message to send to the group.
+         * @param length Length of buffer.
+         * @param pktSeq RTP packet sequence for this message.
+         * @param streamId Stream ID for this message.
+         * @returns bool True, if message was written, otherwise false.
+         */
+        bool write(uint32_t srcPeerId, FrameQueue::OpcodePair opcode, const uint8_t* data, uint32_t length,
+            uint16_t pktSeq, uint32_t streamId);
+
+        /**
+         * @brief Finds a message previously written to the multicast group.
+         * @param groupSeq Multicast Group Sequence.
+         * @param[out] frame Message written to the multicast group.
+         * @returns bool True, if the message is still retained, otherwise false.
+         */
+        bool find(uint32_t groupSeq, MulticastGroupFrame& frame) const;
+
+        /**
+         * @brief Gets the multicast group ID.
+         * @returns uint32_t Multicast Group ID.
+         */
+        uint32_t groupId() const { return m_groupId; }
+
+    private:
+        uint32_t m_peerId;
+        uint32_t m_groupId;
+
+        std::string m_address;
+        uint16_t m_port;
+        std::string m_iface;
+        uint8_t m_ttl;
+
+        udp::Socket* m_socket;
+        sockaddr_storage m_addr;
+        uint32_t m_addrLen;
+
+        mutable std::mutex m_lock;
+        uint32_t m_groupSeq;
+        std::vector<MulticastGroupFrame> m_frames;
+
+        bool m_debug;
+    };
+} // namespace network
+
+#endif // __MULTICAST_GROUP_H__
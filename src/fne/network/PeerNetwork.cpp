@@ -17,6 +17,7 @@ using namespace network;
 #include <cstdio>
 #include <cassert>
 #include <algorithm>
+#include <chrono>
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -27,7 +28,8 @@ using namespace network;
 PeerNetwork::PeerNetwork(const std::string& address, uint16_t port, uint16_t localPort, uint32_t peerId, const std::string& password,
     bool duplex, bool debug, bool dmr, bool p25, bool nxdn, bool slot1, bool slot2, bool allowActivityTransfer, bool allowDiagnosticTransfer, bool updateLookup, bool saveLookup) :
     Network(address, port, localPort, peerId, password, duplex, debug, dmr, p25, nxdn, slot1, slot2, allowActivityTransfer, allowDiagnosticTransfer, updateLookup, saveLookup),
-    m_blockTrafficToTable()
+    m_blockTrafficToTable(),
+    m_stats()
 {
     assert(!address.empty());
     assert(port > 0U);
@@ -48,19 +50,37 @@ bool PeerNetwork::checkBlockedPeer(uint32_t peerId)
     return false;
 }
 
+/* Helper to sample the number of bytes queued in the receive buffers. */
+
+void PeerNetwork::updateBacklog()
+{
+    uint32_t backlog = m_rxDMRData.dataSize() + m_rxP25Data.dataSize() + m_rxNXDNData.dataSize();
+    m_stats.rxBacklog = backlog;
+    if (backlog > m_stats.rxMaxBacklog)
+        m_stats.rxMaxBacklog = backlog;
+}
+
+/* Helper to record a traffic frame processed from this peer network. */
+
+void PeerNetwork::updateRxStats(uint32_t length, uint32_t procTime)
+{
+    m_stats.rxFrames++;
+    m_stats.rxBytes += length;
+    m_stats.procTimeTotal += procTime;
+    m_stats.procTimeLast = procTime;
+    if (procTime > m_stats.procTimeMax)
+        m_stats.procTimeMax = procTime;
+    m_stats.lastRx = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
 // ---------------------------------------------------------------------------
 //  Protected Class Members
 // ---------------------------------------------------------------------------
 
-/* Writes configuration to the network. */
+/* Helper to create the configuration sent to the network. */
 
-bool PeerNetwork::writeConfig()
+json::object PeerNetwork::createConfig()
 {
-    if (m_loginStreamId == 0U) {
-        LogWarning(LOG_NET, "BUGBUG: tried to write network authorisation with no stream ID?");
-        return false;
-    }
-
     const char* software = __NETVER__;
 
     json::object config = json::object();
@@ -98,18 +118,5 @@ bool PeerNetwork::writeConfig()
     config["externalPeer"].set<bool>(external);                                     // External Peer Marker
     config["software"].set<std::string>(std::string(software));                     // Software ID
 
-    json::value v = json::value(config);
-    std::string json = v.serialize();
-
-    CharArray __buffer = std::make_unique<char[]>(json.length() + 9U);
-    char* buffer = __buffer.get();
-
-    ::memcpy(buffer + 0U, TAG_REPEATER_CONFIG, 4U);
-    ::snprintf(buffer + 8U, json.length() + 1U, "%s", json.c_str());
-
-    if (m_debug) {
-        Utils::dump(1U, "Network Message, Configuration", (uint8_t*)buffer, json.length() + 8U);
-    }
-
-    return writeMaster({ NET_FUNC::RPTC, NET_SUBFUNC::NOP }, (uint8_t*)buffer, json.length() + 8U, pktSeq(), m_loginStreamId);
+    return config;
 }
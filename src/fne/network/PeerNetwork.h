@@ -17,14 +17,71 @@
 #define __PEER_NETWORK_H__
 
 #include "Defines.h"
+#include "common/Thread.h"
 #include "host/network/Network.h"
 
+#include <atomic>
 #include <string>
 #include <cstdint>
 #include <vector>
 
 namespace network
 {
+    // ---------------------------------------------------------------------------
+    //  Class Prototypes
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API PeerNetwork;
+
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents the data required for a peer network reader thread.
+     * @ingroup fne_network
+     */
+    struct PeerNetworkRequest : thread_t {
+        std::string identity;               //! Identity of the peer network.
+        PeerNetwork* network;               //! Instance of the PeerNetwork class to service.
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents the traffic statistics of a peer network link.
+     * @ingroup fne_network
+     */
+    class HOST_SW_API PeerNetworkStats {
+    public:
+        /**
+         * @brief Initializes a new instance of the PeerNetworkStats class.
+         */
+        PeerNetworkStats() :
+            rxFrames(0U),
+            rxBytes(0U),
+            rxBacklog(0U),
+            rxMaxBacklog(0U),
+            procTimeTotal(0U),
+            procTimeLast(0U),
+            procTimeMax(0U),
+            lastRx(0U)
+        {
+            /* stub */
+        }
+
+        std::atomic<uint64_t> rxFrames;     //! Count of traffic frames received from the peer network.
+        std::atomic<uint64_t> rxBytes;      //! Count of traffic bytes received from the peer network.
+        std::atomic<uint32_t> rxBacklog;    //! Bytes queued in the receive buffers when the link was last serviced.
+        std::atomic<uint32_t> rxMaxBacklog; //! Largest number of bytes queued in the receive buffers.
+        std::atomic<uint64_t> procTimeTotal;//! Total time (in us) spent processing traffic frames.
+        std::atomic<uint32_t> procTimeLast; //! Time (in us) spent processing the last traffic frame.
+        std::atomic<uint32_t> procTimeMax;  //! Longest time (in us) spent processing a traffic frame.
+        std::atomic<uint64_t> lastRx;       //! Time (in ms) the last traffic frame was received.
+    };
+
     // ---------------------------------------------------------------------------
     //  Class Declaration
     // ---------------------------------------------------------------------------
@@ -72,14 +129,32 @@ namespace network
          */
         bool checkBlockedPeer(uint32_t peerId);
 
+        /**
+         * @brief Gets the traffic statistics of this peer network.
+         * @returns PeerNetworkStats& Traffic statistics.
+         */
+        PeerNetworkStats& stats() { return m_stats; }
+        /**
+         * @brief Helper to sample the number of bytes queued in the receive buffers.
+         */
+        void updateBacklog();
+        /**
+         * @brief Helper to record a traffic frame processed from this peer network.
+         * @param length Length of the frame.
+         * @param procTime Time (in us) spent processing the frame.
+         */
+        void updateRxStats(uint32_t length, uint32_t procTime);
+
     protected:
         std::vector<uint32_t> m_blockTrafficToTable;
 
+        PeerNetworkStats m_stats;
+
         /**
-         * @brief Writes configuration to the network.
-         * @returns bool True, if configuration was sent, otherwise false.
+         * @brief Helper to create the configuration sent to the network.
+         * @returns json::object Configuration.
          */
-        bool writeConfig() override;
+        json::object createConfig() override;
     };
 } // namespace network
 
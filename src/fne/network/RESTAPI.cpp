@@ -16,6 +16,7 @@
 #include "common/Utils.h"
 #include "fne/network/callhandler/TagDMRData.h"
 #include "fne/network/callhandler/TagP25Data.h"
+#include "fne/network/callhandler/TagNXDNData.h"
 #include "fne/network/RESTAPI.h"
 #include "HostFNE.h"
 
@@ -40,6 +41,12 @@ using namespace lookups;
 
 #define REST_API_BIND(funcAddr, classInstance) std::bind(&funcAddr, classInstance, std::placeholders::_1,  std::placeholders::_2, std::placeholders::_3)
 
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t EVENT_KEEP_ALIVE_INTERVAL = 15U;
+
 // ---------------------------------------------------------------------------
 //  Global Functions
 // ---------------------------------------------------------------------------
@@ -464,7 +471,9 @@ RESTAPI::RESTAPI(const std::string& address, uint16_t port, const std::string& p
     m_ridLookup(nullptr),
     m_tidLookup(nullptr),
     m_peerListLookup(nullptr),
-    m_authTokens()
+    m_authTokens(),
+    m_events(),
+    m_keepAliveTimer(1000U, EVENT_KEEP_ALIVE_INTERVAL)
 {
     assert(!address.empty());
     assert(port > 0U);
@@ -520,6 +529,9 @@ void RESTAPI::setLookups(lookups::RadioIdLookup* ridLookup, lookups::TalkgroupRu
 void RESTAPI::setNetwork(network::FNENetwork* network)
 {
     m_network = network;
+    if (m_network != nullptr) {
+        m_network->setEventStream(&m_events);
+    }
 }
 
 /* Opens connection to the network. */
@@ -539,6 +551,7 @@ bool RESTAPI::open()
     }
 #endif // ENABLE_TCP_SSL
 
+    m_keepAliveTimer.start();
     return run();
 }
 
@@ -556,6 +569,19 @@ void RESTAPI::close()
     }
 #endif // ENABLE_TCP_SSL
     wait();
+
+    m_events.closeAll();
+}
+
+/* Updates the timer by the passed number of milliseconds. */
+
+void RESTAPI::clock(uint32_t ms)
+{
+    m_keepAliveTimer.clock(ms);
+    if (m_keepAliveTimer.isRunning() && m_keepAliveTimer.hasExpired()) {
+        m_keepAliveTimer.start();
+        m_events.keepAlive();
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -612,6 +638,10 @@ void RESTAPI::initializeEndpoints()
     m_dispatcher.match(FNE_GET_RELOAD_RIDS).get(REST_API_BIND(RESTAPI::restAPI_GetReloadRIDs, this));
 
     m_dispatcher.match(FNE_GET_AFF_LIST).get(REST_API_BIND(RESTAPI::restAPI_GetAffList, this));
+    m_dispatcher.match(FNE_GET_CALL_LIST).get(REST_API_BIND(RESTAPI::restAPI_GetCallList, this));
+    m_dispatcher.match(FNE_GET_SHARD_STATS).get(REST_API_BIND(RESTAPI::restAPI_GetShardStats, this));
+    m_dispatcher.match(FNE_GET_PEER_NET_STATS).get(REST_API_BIND(RESTAPI::restAPI_GetPeerNetStats, this));
+    m_dispatcher.match(GET_EVENTS).get(REST_API_BIND(RESTAPI::restAPI_GetEvents, this));
 
     /*
     ** Digital Mobile Radio
@@ -828,6 +858,8 @@ void RESTAPI::restAPI_GetPeerQuery(const HTTPPayload& request, HTTPPayload& repl
                     peerObj["lastPing"].set<uint64_t>(lastPing);
                     uint32_t ccPeerId = peer->ccPeerId();
                     peerObj["controlChannel"].set<uint32_t>(ccPeerId);
+                    uint32_t socketShard = peer->socketShard();
+                    peerObj["socketShard"].set<uint32_t>(socketShard);
 
                     json::object peerConfig = peer->config();
                     if (peerConfig["rcon"].is<json::object>())
@@ -1403,6 +1435,178 @@ void RESTAPI::restAPI_GetAffList(const HTTPPayload& request, HTTPPayload& reply,
     reply.payload(response);
 }
 
+/* REST API endpoint; implements get active call list request. */
+
+void RESTAPI::restAPI_GetCallList(const HTTPPayload& request, HTTPPayload& reply, const RequestMatch& match)
+{
+    if (!validateAuth(request, reply)) {
+        return;
+    }
+
+    json::object response = json::object();
+    setResponseDefaultStatus(response);
+
+    json::array calls = json::array();
+    if (m_network != nullptr) {
+        system_clock::hrc::hrc_t now = system_clock::hrc::now();
+        auto addCalls = [&](const std::string& mode, const network::callhandler::CallRegistry& registry) {
+            std::vector<network::callhandler::RxStatus> active = registry.snapshot();
+            for (auto& status : active) {
+                json::object callObj = json::object();
+                callObj["mode"].set<std::string>(mode);
+                callObj["peerId"].set<uint32_t>(status.peerId);
+                callObj["srcId"].set<uint32_t>(status.srcId);
+                callObj["dstId"].set<uint32_t>(status.dstId);
+                uint8_t slotNo = status.slotNo;
+                callObj["slot"].set<uint8_t>(slotNo);
+                callObj["streamId"].set<uint32_t>(status.streamId);
+                uint32_t duration = (uint32_t)(system_clock::hrc::diff(now, status.callStartTime) / 1000U);
+                callObj["duration"].set<uint32_t>(duration);
+                calls.push_back(json::value(callObj));
+            }
+        };
+
+        if (m_network->m_tagDMR != nullptr)
+            addCalls("DMR", m_network->m_tagDMR->activeCalls());
+        if (m_network->m_tagP25 != nullptr)
+            addCalls("P25", m_network->m_tagP25->activeCalls());
+        if (m_network->m_tagNXDN != nullptr)
+            addCalls("NXDN", m_network->m_tagNXDN->activeCalls());
+    }
+
+    response["calls"].set<json::array>(calls);
+    reply.payload(response);
+}
+
+/* REST API endpoint; implements get master socket shard statistics request. */
+
+void RESTAPI::restAPI_GetShardStats(const HTTPPayload& request, HTTPPayload& reply, const RequestMatch& match)
+{
+    if (!validateAuth(request, reply)) {
+        return;
+    }
+
+    json::object response = json::object();
+    setResponseDefaultStatus(response);
+
+    json::array shards = json::array();
+    if (m_network != nullptr) {
+        // count the connected peers last seen on each shard
+        std::vector<uint32_t> peerCount(m_network->m_shards.size(), 0U);
+        {
+            std::lock_guard<std::mutex> lock(m_network->m_peerMutex);
+            for (auto entry : m_network->m_peers) {
+                network::FNEPeerConnection* peer = entry.second;
+                if (peer != nullptr && peer->connected() && peer->socketShard() < peerCount.size()) {
+                    peerCount[peer->socketShard()]++;
+                }
+            }
+        }
+
+        for (uint32_t i = 0U; i < m_network->m_shards.size(); i++) {
+            network::FNESocketShard* shard = m_network->m_shards[i];
+
+            json::object shardObj = json::object();
+            shardObj["shard"].set<uint32_t>(i);
+            uint32_t peers = peerCount[i];
+            shardObj["peers"].set<uint32_t>(peers);
+            uint64_t rxFrames = shard->rxFrames;
+            shardObj["rxFrames"].set<uint64_t>(rxFrames);
+            uint64_t rxBytes = shard->rxBytes;
+            shardObj["rxBytes"].set<uint64_t>(rxBytes);
+            uint64_t rxDropped = shard->rxDropped;
+            shardObj["rxDropped"].set<uint64_t>(rxDropped);
+            uint64_t lastRx = shard->lastRx;
+            shardObj["lastRx"].set<uint64_t>(lastRx);
+            shards.push_back(json::value(shardObj));
+        }
+    }
+
+    response["shards"].set<json::array>(shards);
+    reply.payload(response);
+}
+
+/* REST API endpoint; implements get peer network link statistics request. */
+
+void RESTAPI::restAPI_GetPeerNetStats(const HTTPPayload& request, HTTPPayload& reply, const RequestMatch& match)
+{
+    if (!validateAuth(request, reply)) {
+        return;
+    }
+
+    json::object response = json::object();
+    setResponseDefaultStatus(response);
+
+    json::array peers = json::array();
+    if (m_host != nullptr) {
+        for (auto entry : m_host->m_peerNetworks) {
+            network::PeerNetwork* peerNetwork = entry.second;
+            if (peerNetwork == nullptr)
+                continue;
+
+            network::PeerNetworkStats& stats = peerNetwork->stats();
+
+            json::object peerObj = json::object();
+            peerObj["identity"].set<std::string>(entry.first);
+            uint32_t peerId = peerNetwork->getPeerId();
+            peerObj["peerId"].set<uint32_t>(peerId);
+            bool enabled = peerNetwork->isEnabled();
+            peerObj["enabled"].set<bool>(enabled);
+            bool connected = peerNetwork->getStatus() == NET_STAT_RUNNING;
+            peerObj["connected"].set<bool>(connected);
+
+            uint64_t rxFrames = stats.rxFrames;
+            peerObj["rxFrames"].set<uint64_t>(rxFrames);
+            uint64_t rxBytes = stats.rxBytes;
+            peerObj["rxBytes"].set<uint64_t>(rxBytes);
+            uint32_t rxBacklog = stats.rxBacklog;
+            peerObj["rxBacklog"].set<uint32_t>(rxBacklog);
+            uint32_t rxMaxBacklog = stats.rxMaxBacklog;
+            peerObj["rxMaxBacklog"].set<uint32_t>(rxMaxBacklog);
+
+            // per-frame processing latency (in us)
+            uint64_t procTimeTotal = stats.procTimeTotal;
+            uint32_t procTimeAvg = (rxFrames > 0U) ? (uint32_t)(procTimeTotal / rxFrames) : 0U;
+            peerObj["procTimeAvg"].set<uint32_t>(procTimeAvg);
+            uint32_t procTimeLast = stats.procTimeLast;
+            peerObj["procTimeLast"].set<uint32_t>(procTimeLast);
+            uint32_t procTimeMax = stats.procTimeMax;
+            peerObj["procTimeMax"].set<uint32_t>(procTimeMax);
+            uint64_t lastRx = stats.lastRx;
+            peerObj["lastRx"].set<uint64_t>(lastRx);
+            peers.push_back(json::value(peerObj));
+        }
+    }
+
+    response["peers"].set<json::array>(peers);
+    reply.payload(response);
+}
+
+/* REST API endpoint; implements get event stream request. */
+
+void RESTAPI::restAPI_GetEvents(const HTTPPayload& request, HTTPPayload& reply, const RequestMatch& match)
+{
+    if (!validateAuth(request, reply)) {
+        return;
+    }
+
+    // optional comma separated event type filter (i.e. /events?types=peer-connect,peer-disconnect)
+    std::string types = "";
+    size_t pos = request.uri.find("types=");
+    if (pos != std::string::npos) {
+        types = request.uri.substr(pos + 6U);
+        types = types.substr(0U, types.find('&'));
+    }
+
+    std::shared_ptr<EventStreamSubscriber> subscriber = m_events.subscribe(types);
+    if (subscriber == nullptr) {
+        errorPayload(reply, "too many event stream subscribers", HTTPPayload::SERVICE_UNAVAILABLE);
+        return;
+    }
+
+    reply.stream(subscriber);
+}
+
 /*
 ** Digital Mobile Radio
 */
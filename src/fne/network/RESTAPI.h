@@ -17,12 +17,14 @@
 #define __REST_API_H__
 
 #include "fne/Defines.h"
+#include "common/network/rest/EventStream.h"
 #include "common/network/rest/RequestDispatcher.h"
 #include "common/network/rest/http/HTTPServer.h"
 #include "common/network/rest/http/SecureHTTPServer.h"
 #include "common/lookups/RadioIdLookup.h"
 #include "common/lookups/TalkgroupRulesLookup.h"
 #include "common/Thread.h"
+#include "common/Timer.h"
 #include "fne/network/RESTDefines.h"
 
 #include <vector>
@@ -88,6 +90,12 @@ public:
      */
     void close();
 
+    /**
+     * @brief Updates the timer by the passed number of milliseconds.
+     * @param ms Number of milliseconds.
+     */
+    void clock(uint32_t ms);
+
 private:
     typedef network::rest::RequestDispatcher<network::rest::http::HTTPPayload, network::rest::http::HTTPPayload> RESTDispatcherType;
     typedef network::rest::http::HTTPPayload HTTPPayload;
@@ -114,6 +122,9 @@ private:
     typedef std::unordered_map<std::string, uint64_t>::value_type AuthTokenValueType;
     std::unordered_map<std::string, uint64_t> m_authTokens;
 
+    network::rest::EventStream m_events;
+    Timer m_keepAliveTimer;
+
     /**
      * @brief Thread entry point. This function is provided to run the thread
      *  for the REST API services.
@@ -307,6 +318,34 @@ private:
      * @param match HTTP request matcher.
      */
     void restAPI_GetAffList(const HTTPPayload& request, HTTPPayload& reply, const network::rest::RequestMatch& match);
+    /**
+     * @brief REST API endpoint; implements get active call list request.
+     * @param request HTTP request.
+     * @param reply HTTP reply.
+     * @param match HTTP request matcher.
+     */
+    void restAPI_GetCallList(const HTTPPayload& request, HTTPPayload& reply, const network::rest::RequestMatch& match);
+    /**
+     * @brief REST API endpoint; implements get master socket shard statistics request.
+     * @param request HTTP request.
+     * @param reply HTTP reply.
+     * @param match HTTP request matcher.
+     */
+    void restAPI_GetShardStats(const HTTPPayload& request, HTTPPayload& reply, const network::rest::RequestMatch& match);
+    /**
+     * @brief REST API endpoint; implements get peer network link statistics request.
+     * @param request HTTP request.
+     * @param reply HTTP reply.
+     * @param match HTTP request matcher.
+     */
+    void restAPI_GetPeerNetStats(const HTTPPayload& request, HTTPPayload& reply, const network::rest::RequestMatch& match);
+    /**
+     * @brief REST API endpoint; implements get event stream request.
+     * @param request HTTP request.
+     * @param reply HTTP reply.
+     * @param match HTTP request matcher.
+     */
+    void restAPI_GetEvents(const HTTPPayload& request, HTTPPayload& reply, const network::rest::RequestMatch& match);
 
     /*
     ** Digital Mobile Radio
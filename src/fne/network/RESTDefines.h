@@ -51,5 +51,8 @@
 #define FNE_GET_RELOAD_RIDS             "/reload-rids"
 
 #define FNE_GET_AFF_LIST                "/report-affiliations"
+#define FNE_GET_CALL_LIST               "/report-calls"
+#define FNE_GET_SHARD_STATS             "/report-shards"
+#define FNE_GET_PEER_NET_STATS          "/report-peer-networks"
 
 #endif // __FNE_REST_DEFINES_H__
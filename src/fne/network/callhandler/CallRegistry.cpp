@@ -0,0 +1,200 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "fne/Defines.h"
+#include "network/callhandler/CallRegistry.h"
+
+using namespace system_clock;
+using namespace network::callhandler;
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the CallRegistry class. */
+
+CallRegistry::CallRegistry() :
+    m_calls(),
+    m_streams()
+{
+    /* stub */
+}
+
+/* Finds the active call for the given destination ID and slot. */
+
+bool CallRegistry::find(uint32_t dstId, uint8_t slotNo, RxStatus& status) const
+{
+    const CallShard& shard = callShard(dstId);
+
+    std::lock_guard<std::mutex> lock(shard.lock);
+    auto it = shard.calls.find(callKey(dstId, slotNo));
+    if (it != shard.calls.end()) {
+        status = it->second;
+        return true;
+    }
+
+    return false;
+}
+
+/* Finds the active call for the given stream ID. */
+
+bool CallRegistry::findByStream(uint32_t streamId, RxStatus& status) const
+{
+    uint64_t key = 0U;
+    {
+        const StreamShard& shard = streamShard(streamId);
+
+        std::lock_guard<std::mutex> lock(shard.lock);
+        auto it = shard.streams.find(streamId);
+        if (it == shard.streams.end()) {
+            return false;
+        }
+
+        key = it->second;
+    }
+
+    if (!find((uint32_t)(key >> 8), (uint8_t)(key & 0xFFU), status)) {
+        return false;
+    }
+
+    // the call may have been replaced by a newer stream since the index was read
+    return status.streamId == streamId;
+}
+
+/* Helper to determine if there is an active call for the given destination ID on any slot. */
+
+bool CallRegistry::isActive(uint32_t dstId) const
+{
+    const CallShard& shard = callShard(dstId);
+
+    std::lock_guard<std::mutex> lock(shard.lock);
+    for (uint8_t slotNo = 0U; slotNo <= 2U; slotNo++) {
+        if (shard.calls.find(callKey(dstId, slotNo)) != shard.calls.end()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Helper to determine if there is an active call for the given destination ID and slot. */
+
+bool CallRegistry::isActive(uint32_t dstId, uint8_t slotNo) const
+{
+    const CallShard& shard = callShard(dstId);
+
+    std::lock_guard<std::mutex> lock(shard.lock);
+    return shard.calls.find(callKey(dstId, slotNo)) != shard.calls.end();
+}
+
+/* Adds (or replaces) an active call. */
+
+void CallRegistry::add(const RxStatus& status)
+{
+    uint64_t key = callKey(status.dstId, status.slotNo);
+    CallShard& shard = callShard(status.dstId);
+
+    // lock ordering is always call shard, then stream shard
+    std::lock_guard<std::mutex> lock(shard.lock);
+    auto it = shard.calls.find(key);
+    if (it != shard.calls.end()) {
+        uint32_t oldStreamId = it->second.streamId;
+        if (oldStreamId != status.streamId) {
+            StreamShard& oldStream = streamShard(oldStreamId);
+
+            std::lock_guard<std::mutex> streamLock(oldStream.lock);
+            auto streamIt = oldStream.streams.find(oldStreamId);
+            if (streamIt != oldStream.streams.end() && streamIt->second == key) {
+                oldStream.streams.erase(streamIt);
+            }
+        }
+
+        it->second = status;
+    }
+    else {
+        shard.calls[key] = status;
+    }
+
+    StreamShard& stream = streamShard(status.streamId);
+
+    std::lock_guard<std::mutex> streamLock(stream.lock);
+    stream.streams[status.streamId] = key;
+}
+
+/* Removes the active call for the given destination ID and slot. */
+
+bool CallRegistry::erase(uint32_t dstId, uint8_t slotNo)
+{
+    uint64_t key = callKey(dstId, slotNo);
+    CallShard& shard = callShard(dstId);
+
+    std::lock_guard<std::mutex> lock(shard.lock);
+    auto it = shard.calls.find(key);
+    if (it == shard.calls.end()) {
+        return false;
+    }
+
+    uint32_t streamId = it->second.streamId;
+    shard.calls.erase(it);
+
+    StreamShard& stream = streamShard(streamId);
+
+    std::lock_guard<std::mutex> streamLock(stream.lock);
+    auto streamIt = stream.streams.find(streamId);
+    if (streamIt != stream.streams.end() && streamIt->second == key) {
+        stream.streams.erase(streamIt);
+    }
+
+    return true;
+}
+
+/* Updates the last packet time of the active call for the given destination ID and slot. */
+
+void CallRegistry::touch(uint32_t dstId, uint8_t slotNo, hrc::hrc_t lastPacket)
+{
+    CallShard& shard = callShard(dstId);
+
+    std::lock_guard<std::mutex> lock(shard.lock);
+    auto it = shard.calls.find(callKey(dstId, slotNo));
+    if (it != shard.calls.end()) {
+        it->second.lastPacket = lastPacket;
+    }
+}
+
+/* Gets a snapshot of all active calls. */
+
+std::vector<RxStatus> CallRegistry::snapshot() const
+{
+    std::vector<RxStatus> calls;
+    for (uint32_t i = 0U; i < SHARD_COUNT; i++) {
+        const CallShard& shard = m_calls[i];
+
+        std::lock_guard<std::mutex> lock(shard.lock);
+        for (auto& entry : shard.calls) {
+            calls.push_back(entry.second);
+        }
+    }
+
+    return calls;
+}
+
+/* Gets the count of active calls. */
+
+size_t CallRegistry::size() const
+{
+    size_t size = 0U;
+    for (uint32_t i = 0U; i < SHARD_COUNT; i++) {
+        const CallShard& shard = m_calls[i];
+
+        std::lock_guard<std::mutex> lock(shard.lock);
+        size += shard.calls.size();
+    }
+
+    return size;
+}
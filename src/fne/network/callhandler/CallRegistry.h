@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file CallRegistry.h
+ * @ingroup fne_callhandler
+ * @file CallRegistry.cpp
+ * @ingroup fne_callhandler
+ */
+#if !defined(__CALLHANDLER__CALL_REGISTRY_H__)
+#define __CALLHANDLER__CALL_REGISTRY_H__
+
+#include "fne/Defines.h"
+#include "common/Clock.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace network
+{
+    namespace callhandler
+    {
+        // ---------------------------------------------------------------------------
+        //  Class Declaration
+        // ---------------------------------------------------------------------------
+
+        /**
+         * @brief Represents the receive status of a call.
+         * @ingroup fne_callhandler
+         */
+        class HOST_SW_API RxStatus {
+        public:
+            /**
+             * @brief Initializes a new instance of the RxStatus class.
+             */
+            RxStatus() :
+                callStartTime(),
+                lastPacket(),
+                srcId(0U),
+                dstId(0U),
+                slotNo(0U),
+                streamId(0U),
+                peerId(0U)
+            {
+                /* stub */
+            }
+
+            system_clock::hrc::hrc_t callStartTime;
+            system_clock::hrc::hrc_t lastPacket;
+            uint32_t srcId;
+            uint32_t dstId;
+            uint8_t slotNo;
+            uint32_t streamId;
+            uint32_t peerId;
+        };
+
+        // ---------------------------------------------------------------------------
+        //  Class Declaration
+        // ---------------------------------------------------------------------------
+
+        /**
+         * @brief Implements a thread-safe registry of active calls.
+         * @ingroup fne_callhandler
+         *
+         *  Calls are indexed by destination ID and slot (slot is 0 for modes that do not
+         *  have slots), and by stream ID. Both indexes are split into independently locked
+         *  shards, so concurrent network receive threads only contend when they touch the
+         *  same shard.
+         */
+        class HOST_SW_API CallRegistry {
+        public:
+            /**
+             * @brief Initializes a new instance of the CallRegistry class.
+             */
+            CallRegistry();
+
+            /**
+             * @brief Finds the active call for the given destination ID and slot.
+             * @param dstId Destination ID.
+             * @param slotNo Slot Number (0 for modes without slots).
+             * @param[out] status Receive status of the call.
+             * @returns bool True, if an active call was found, otherwise false.
+             */
+            bool find(uint32_t dstId, uint8_t slotNo, RxStatus& status) const;
+            /**
+             * @brief Finds the active call for the given stream ID.
+             * @param streamId Stream ID.
+             * @param[out] status Receive status of the call.
+             * @returns bool True, if an active call was found, otherwise false.
+             */
+            bool findByStream(uint32_t streamId, RxStatus& status) const;
+            /**
+             * @brief Helper to determine if there is an active call for the given destination ID on any slot.
+             * @param dstId Destination ID.
+             * @returns bool True, if there is an active call, otherwise false.
+             */
+            bool isActive(uint32_t dstId) const;
+            /**
+             * @brief Helper to determine if there is an active call for the given destination ID and slot.
+             * @param dstId Destination ID.
+             * @param slotNo Slot Number (0 for modes without slots).
+             * @returns bool True, if there is an active call, otherwise false.
+             */
+            bool isActive(uint32_t dstId, uint8_t slotNo) const;
+
+            /**
+             * @brief Adds (or replaces) an active call.
+             * @param status Receive status of the call.
+             */
+            void add(const RxStatus& status);
+            /**
+             * @brief Removes the active call for the given destination ID and slot.
+             * @param dstId Destination ID.
+             * @param slotNo Slot Number (0 for modes without slots).
+             * @returns bool True, if an active call was removed, otherwise false.
+             */
+            bool erase(uint32_t dstId, uint8_t slotNo);
+            /**
+             * @brief Updates the last packet time of the active call for the given destination ID and slot.
+             * @param dstId Destination ID.
+             * @param slotNo Slot Number (0 for modes without slots).
+             * @param lastPacket Time of the last received packet.
+             */
+            void touch(uint32_t dstId, uint8_t slotNo, system_clock::hrc::hrc_t lastPacket);
+
+            /**
+             * @brief Gets a snapshot of all active calls. Shards are locked and copied one at a time.
+             * @returns std::vector<RxStatus> List of active calls.
+             */
+            std::vector<RxStatus> snapshot() const;
+            /**
+             * @brief Gets the count of active calls.
+             * @returns size_t Count of active calls.
+             */
+            size_t size() const;
+
+        private:
+            static const uint32_t SHARD_COUNT = 16U;
+
+            /**
+             * @brief Represents a shard of the call index.
+             */
+            class CallShard {
+            public:
+                mutable std::mutex lock;
+                std::unordered_map<uint64_t, RxStatus> calls;
+            };
+            CallShard m_calls[SHARD_COUNT];
+
+            /**
+             * @brief Represents a shard of the stream index.
+             */
+            class StreamShard {
+            public:
+                mutable std::mutex lock;
+                std::unordered_map<uint32_t, uint64_t> streams;
+            };
+            StreamShard m_streams[SHARD_COUNT];
+
+            /**
+             * @brief Helper to generate the call index key.
+             * @param dstId Destination ID.
+             * @param slotNo Slot Number.
+             * @returns uint64_t Call index key.
+             */
+            static uint64_t callKey(uint32_t dstId, uint8_t slotNo) { return ((uint64_t)dstId << 8) | slotNo; }
+            /**
+             * @brief Helper to get the call index shard for a destination ID.
+             * @param dstId Destination ID.
+             * @returns CallShard Call index shard.
+             */
+            CallShard& callShard(uint32_t dstId) { return m_calls[dstId % SHARD_COUNT]; }
+            /**
+             * @brief Helper to get the call index shard for a destination ID.
+             * @param dstId Destination ID.
+             * @returns CallShard Call index shard.
+             */
+            const CallShard& callShard(uint32_t dstId) const { return m_calls[dstId % SHARD_COUNT]; }
+            /**
+             * @brief Helper to get the stream index shard for a stream ID.
+             * @param streamId Stream ID.
+             * @returns StreamShard Stream index shard.
+             */
+            StreamShard& streamShard(uint32_t streamId) { return m_streams[streamId % SHARD_COUNT]; }
+            /**
+             * @brief Helper to get the stream index shard for a stream ID.
+             * @param streamId Stream ID.
+             * @returns StreamShard Stream index shard.
+             */
+            const StreamShard& streamShard(uint32_t streamId) const { return m_streams[streamId % SHARD_COUNT]; }
+        };
+    } // namespace callhandler
+} // namespace network
+
+#endif // __CALLHANDLER__CALL_REGISTRY_H__
@@ -0,0 +1,703 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "fne/Defines.h"
+#include "common/dmr/data/EMB.h"
+#include "common/dmr/data/NetData.h"
+#include "common/dmr/lc/FullLC.h"
+#include "common/dmr/lc/LC.h"
+#include "common/dmr/SlotType.h"
+#include "common/dmr/Sync.h"
+#include "common/p25/data/LowSpeedData.h"
+#include "common/p25/dfsi/DFSIDefines.h"
+#include "common/p25/dfsi/LC.h"
+#include "common/p25/lc/LC.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+#include "network/FNENetwork.h"
+#include "network/callhandler/CrossModeTranscoder.h"
+#include "network/callhandler/TagDMRData.h"
+#include "network/callhandler/TagP25Data.h"
+#include "vocoder/VocoderPool.h"
+
+using namespace network;
+using namespace network::callhandler;
+using namespace vocoder;
+
+#include <cassert>
+#include <chrono>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+// offsets of the DFSI voice frames in a LDU network message (after the 24 byte header)
+const uint32_t DFSI_VOICE_OFFSETS[] = { 0U, 22U, 36U, 53U, 70U, 87U, 104U, 121U, 138U };
+const uint32_t DFSI_LDU_LENGTH_BYTES = 154U;
+
+// offsets of the IMBE codewords in a LDU buffer
+const uint32_t LDU_IMBE_OFFSETS[] = { 10U, 26U, 55U, 80U, 105U, 130U, 155U, 180U, 204U };
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to get the current time in milliseconds. */
+
+static uint64_t now()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/* Helper to get the key of a patched DMR talkgroup. */
+
+static uint32_t dmrPatchKey(uint32_t dstId, uint8_t slotNo)
+{
+    return (dstId << 1) | (slotNo - 1U);
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the CrossModeTranscoder class. */
+
+CrossModeTranscoder::CrossModeTranscoder(FNENetwork* network, uint32_t workers, uint32_t maxCalls, bool parametric, bool debug) :
+    m_network(network),
+    m_pool(nullptr),
+    m_parametric(parametric),
+    m_calls(),
+    m_transcodedStreams(),
+    m_mutex(),
+    m_dmrPatches(),
+    m_p25Patches(),
+    m_debug(debug)
+{
+    assert(network != nullptr);
+    assert(workers > 0U);
+    assert(maxCalls > 0U);
+
+    m_pool = new VocoderPool(workers, maxCalls, TRANSCODE_QUEUE_DEPTH);
+}
+
+/* Finalizes a instance of the CrossModeTranscoder class. */
+
+CrossModeTranscoder::~CrossModeTranscoder()
+{
+    stop();
+
+    for (auto& call : m_calls) {
+        delete call.second;
+    }
+    m_calls.clear();
+
+    delete m_pool;
+}
+
+/* Patches a DMR talkgroup to a P25 talkgroup. */
+
+bool CrossModeTranscoder::addPatch(uint32_t dmrTgId, uint8_t dmrSlot, uint32_t p25TgId)
+{
+    if (dmrTgId == 0U || p25TgId == 0U || dmrSlot < 1U || dmrSlot > 2U) {
+        return false;
+    }
+
+    uint32_t key = dmrPatchKey(dmrTgId, dmrSlot);
+    if (m_dmrPatches.find(key) != m_dmrPatches.end() || m_p25Patches.find(p25TgId) != m_p25Patches.end()) {
+        return false;
+    }
+
+    m_dmrPatches[key] = p25TgId;
+    m_p25Patches[p25TgId] = key;
+    return true;
+}
+
+/* Starts the vocoder workers. */
+
+bool CrossModeTranscoder::start()
+{
+    return m_pool->start();
+}
+
+/* Stops the vocoder workers. */
+
+void CrossModeTranscoder::stop()
+{
+    m_pool->stop();
+}
+
+/* Process a DMR frame routed by the DMR call handler. */
+
+bool CrossModeTranscoder::processDMR(const uint8_t* data, uint32_t len, uint32_t peerId, uint32_t streamId, bool external)
+{
+    assert(data != nullptr);
+    using namespace dmr;
+    using namespace dmr::defines;
+
+    if (len < 20U + DMR_FRAME_LENGTH_BYTES) {
+        return false;
+    }
+
+    uint32_t srcId = __GET_UINT16(data, 5U);
+    uint32_t dstId = __GET_UINT16(data, 8U);
+
+    FLCO::E flco = (data[15U] & 0x40U) == 0x40U ? FLCO::PRIVATE : FLCO::GROUP;
+    uint8_t slotNo = (data[15U] & 0x80U) == 0x80U ? 2U : 1U;
+    if (flco != FLCO::GROUP) {
+        return false;
+    }
+
+    // is this a patched talkgroup?
+    auto patch = m_dmrPatches.find(dmrPatchKey(dstId, slotNo));
+    if (patch == m_dmrPatches.end()) {
+        return false;
+    }
+
+    bool dataSync = (data[15U] & 0x20U) == 0x20U;
+    DataType::E dataType = (dataSync) ? (DataType::E)(data[15U] & 0x0FU) : DataType::VOICE;
+    if (dataSync && (dataType != DataType::VOICE_LC_HEADER) && (dataType != DataType::VOICE_PI_HEADER) &&
+        (dataType != DataType::TERMINATOR_WITH_LC)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // never transcode a call we transcoded
+    if (m_transcodedStreams.find(streamId) != m_transcodedStreams.end()) {
+        return false;
+    }
+
+    // is this the end of the call stream?
+    if (dataType == DataType::TERMINATOR_WITH_LC) {
+        auto it = m_calls.find(streamId);
+        if (it != m_calls.end()) {
+            it->second->ending = true;
+        }
+
+        return true;
+    }
+
+    TranscodeCall* call = findCall(streamId, true, peerId, external, srcId, patch->second, slotNo);
+    if (dataType == DataType::VOICE_PI_HEADER) {
+        if (!call->encrypted) {
+            LogMessage(LOG_NET, "DMR, encrypted call is not transcoded, peer = %u, srcId = %u, dstId = %u, streamId = %u", peerId, srcId, dstId, streamId);
+        }
+
+        call->encrypted = true;
+    }
+
+    if (dataType == DataType::VOICE_LC_HEADER || dataType == DataType::VOICE_PI_HEADER) {
+        return true;
+    }
+
+    // the three AMBE codewords are split around the sync/EMB of the voice burst
+    const uint8_t* frame = data + 20U;
+    uint8_t ambe[AMBE_PER_SLOT * RAW_AMBE_LENGTH_BYTES];
+    ::memcpy(ambe, frame, 14U);
+    ambe[13U] &= 0xF0U;
+    ambe[13U] |= (uint8_t)(frame[19U] & 0x0FU);
+    ::memcpy(ambe + 14U, frame + 20U, 13U);
+
+    queueCodewords(call, ambe, AMBE_PER_SLOT, RAW_AMBE_LENGTH_BYTES);
+    return true;
+}
+
+/* Process a P25 frame routed by the P25 call handler. */
+
+bool CrossModeTranscoder::processP25(const uint8_t* data, uint32_t len, uint32_t peerId, uint32_t streamId, bool external)
+{
+    assert(data != nullptr);
+    using namespace p25;
+    using namespace p25::defines;
+    using namespace p25::dfsi::defines;
+
+    if (len < 24U) {
+        return false;
+    }
+
+    uint8_t lco = data[4U];
+
+    uint32_t srcId = __GET_UINT16(data, 5U);
+    uint32_t dstId = __GET_UINT16(data, 8U);
+
+    DUID::E duid = (DUID::E)data[22U];
+    if (lco != LCO::GROUP) {
+        return false;
+    }
+
+    if ((duid != DUID::LDU1) && (duid != DUID::LDU2) && (duid != DUID::TDU) && (duid != DUID::TDULC)) {
+        return false;
+    }
+
+    // is this a patched talkgroup?
+    auto patch = m_p25Patches.find(dstId);
+    if (patch == m_p25Patches.end()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // never transcode a call we transcoded
+    if (m_transcodedStreams.find(streamId) != m_transcodedStreams.end()) {
+        return false;
+    }
+
+    // is this the end of the call stream?
+    if ((duid == DUID::TDU) || (duid == DUID::TDULC)) {
+        auto it = m_calls.find(streamId);
+        if (it != m_calls.end()) {
+            it->second->ending = true;
+        }
+
+        return true;
+    }
+
+    if (len < 24U + DFSI_LDU_LENGTH_BYTES) {
+        return false;
+    }
+
+    uint8_t firstFrameType = (duid == DUID::LDU1) ? DFSIFrameType::LDU1_VOICE1 : DFSIFrameType::LDU2_VOICE10;
+    for (uint32_t i = 0U; i < 9U; i++) {
+        if (data[24U + DFSI_VOICE_OFFSETS[i]] != firstFrameType + i) {
+            return false;
+        }
+    }
+
+    TranscodeCall* call = findCall(streamId, false, peerId, external, srcId, patch->second >> 1, (patch->second & 0x01U) + 1U);
+
+    // is the call encrypted?
+    uint8_t algId = ALGO_UNENCRYPT;
+    if (duid == DUID::LDU1 && len > 181U && data[180U] == FrameType::HDU_VALID) {
+        algId = data[181U];
+    }
+
+    if (duid == DUID::LDU2) {
+        algId = data[24U + 88U];
+    }
+
+    if (algId != ALGO_UNENCRYPT) {
+        if (!call->encrypted) {
+            LogMessage(LOG_NET, "P25, encrypted call is not transcoded, peer = %u, srcId = %u, dstId = %u, streamId = %u", peerId, srcId, dstId, streamId);
+        }
+
+        call->encrypted = true;
+    }
+
+    lc::LC control;
+    control.setLCO(lco);
+    control.setSrcId(srcId);
+    control.setDstId(dstId);
+
+    data::LowSpeedData lsd;
+    dfsi::LC dfsiLC = dfsi::LC(control, lsd);
+
+    uint8_t imbe[9U * RAW_IMBE_LENGTH_BYTES];
+    for (uint32_t i = 0U; i < 9U; i++) {
+        dfsiLC.setFrameType((DFSIFrameType::E)(firstFrameType + i));
+        if (duid == DUID::LDU1)
+            dfsiLC.decodeLDU1(data + 24U + DFSI_VOICE_OFFSETS[i], imbe + (i * RAW_IMBE_LENGTH_BYTES));
+        else
+            dfsiLC.decodeLDU2(data + 24U + DFSI_VOICE_OFFSETS[i], imbe + (i * RAW_IMBE_LENGTH_BYTES));
+    }
+
+    queueCodewords(call, imbe, 9U, RAW_IMBE_LENGTH_BYTES);
+    return true;
+}
+
+/* Collects transcoded codewords, and routes the transcoded frames. */
+
+void CrossModeTranscoder::clock(uint32_t ms)
+{
+    std::vector<TranscodedFrame> frames;
+    std::vector<uint32_t> endedStreams;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_calls.empty()) {
+            return;
+        }
+
+        uint64_t time = now();
+        for (auto it = m_calls.begin(); it != m_calls.end();) {
+            TranscodeCall* call = it->second;
+            collect(call, frames);
+
+            // a call without a terminator ends once it stops sending traffic
+            if (!call->ending && (time - call->lastPacket) > TRANSCODE_CALL_TIMEOUT) {
+                LogWarning(LOG_NET, "%s, transcoded call timed out, srcId = %u, dstId = %u, streamId = %u", call->toP25 ? "DMR" : "P25",
+                    call->srcId, call->dstId, it->first);
+                call->ending = true;
+            }
+
+            // has the call ended, and have all its codewords been transcoded?
+            if (call->ending && call->pending == 0U) {
+                flush(call, frames);
+
+                if (call->seqNo > 0U) {
+                    if (call->toP25) {
+                        addP25Frame(call, p25::defines::DUID::TDU, frames);
+                    }
+                    else {
+                        using namespace dmr;
+                        using namespace dmr::defines;
+
+                        uint8_t data[DMR_FRAME_LENGTH_BYTES];
+                        ::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES);
+
+                        lc::LC dmrLC = lc::LC();
+                        dmrLC.setFLCO(FLCO::GROUP);
+                        dmrLC.setSrcId(call->srcId);
+                        dmrLC.setDstId(call->dstId);
+
+                        SlotType slotType = SlotType();
+                        slotType.setDataType(DataType::TERMINATOR_WITH_LC);
+                        slotType.encode(data);
+
+                        lc::FullLC fullLC = lc::FullLC();
+                        fullLC.encode(dmrLC, data, DataType::TERMINATOR_WITH_LC);
+
+                        Sync::addDMRDataSync(data, true);
+
+                        addDMRFrame(call, DataType::TERMINATOR_WITH_LC, data, frames);
+                    }
+                }
+
+                endedStreams.push_back(call->streamId);
+
+                if (call->stream >= 0) {
+                    m_pool->close(call->stream);
+                }
+
+                delete call;
+                it = m_calls.erase(it);
+                continue;
+            }
+
+            ++it;
+        }
+    }
+
+    // route the transcoded frames (outside the lock, the call handlers hand the frames back to us)
+    for (TranscodedFrame& frame : frames) {
+        if (frame.p25)
+            m_network->m_tagP25->processFrame(frame.buffer.get(), frame.length, frame.peerId, frame.pktSeq, frame.streamId, frame.external);
+        else
+            m_network->m_tagDMR->processFrame(frame.buffer.get(), frame.length, frame.peerId, frame.pktSeq, frame.streamId, frame.external);
+    }
+
+    if (!endedStreams.empty()) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (uint32_t streamId : endedStreams) {
+            m_transcodedStreams.erase(streamId);
+        }
+    }
+}
+
+/* Gets the number of calls being transcoded. */
+
+uint32_t CrossModeTranscoder::activeCalls()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (uint32_t)m_calls.size();
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to find, or start, the call being transcoded for a source stream. */
+
+CrossModeTranscoder::TranscodeCall* CrossModeTranscoder::findCall(uint32_t streamId, bool toP25, uint32_t peerId, bool external,
+    uint32_t srcId, uint32_t dstId, uint8_t slotNo)
+{
+    auto it = m_calls.find(streamId);
+    if (it != m_calls.end()) {
+        it->second->lastPacket = now();
+        return it->second;
+    }
+
+    TranscodeCall* call = new TranscodeCall();
+    call->toP25 = toP25;
+    call->encrypted = false;
+    call->ending = false;
+    call->pending = 0U;
+    call->peerId = peerId;
+    call->external = external;
+    call->srcId = srcId;
+    call->dstId = dstId;
+    call->slotNo = slotNo;
+    call->streamId = m_network->createStreamId();
+    call->pktSeq = 0U;
+    call->seqNo = 0U;
+    call->n = 0U;
+    ::memset(call->frame, 0x00U, sizeof(call->frame));
+    call->lastPacket = now();
+
+    MBE_TRANSCODE_MODE mode = (m_parametric) ? TRANSCODE_PARAMETRIC : TRANSCODE_PCM;
+    if (toP25)
+        call->stream = m_pool->openTranscoder(DECODE_DMR_AMBE, ENCODE_88BIT_IMBE, mode);
+    else
+        call->stream = m_pool->openTranscoder(DECODE_88BIT_IMBE, ENCODE_DMR_AMBE, mode);
+
+    if (call->stream < 0) {
+        LogWarning(LOG_NET, "%s, no transcoder available, call is not transcoded, peer = %u, srcId = %u, streamId = %u", toP25 ? "DMR" : "P25",
+            peerId, srcId, streamId);
+    }
+    else {
+        LogMessage(LOG_NET, "%s, Transcoded Call Start, peer = %u, srcId = %u, dstId = %u, streamId = %u, transcodedStreamId = %u", toP25 ? "DMR" : "P25",
+            peerId, srcId, dstId, streamId, call->streamId);
+    }
+
+    m_calls[streamId] = call;
+    m_transcodedStreams.insert(call->streamId);
+    return call;
+}
+
+/* Helper to queue the codewords of a source frame for transcoding. */
+
+void CrossModeTranscoder::queueCodewords(TranscodeCall* call, const uint8_t* codewords, uint32_t count, uint32_t length)
+{
+    if (call->stream < 0 || call->encrypted || call->ending) {
+        return;
+    }
+
+    // the codewords of a frame are handed to the vocoder pool as a single batch
+    uint32_t queued = 0U;
+    for (uint32_t i = 0U; i < count; i++) {
+        VocoderFrame* frame = m_pool->reserve(call->stream, i);
+        if (frame == nullptr) {
+            LogWarning(LOG_NET, "%s, transcoder queue full, codewords dropped, srcId = %u, dstId = %u", call->toP25 ? "DMR" : "P25",
+                call->srcId, call->dstId);
+            break;
+        }
+
+        frame->op = VOCODER_TRANSCODE;
+        frame->tag = 0U;
+        ::memset(frame->codeword, 0x00U, VOCODER_CODEWORD_LENGTH);
+        ::memcpy(frame->codeword, codewords + (i * length), length);
+        queued++;
+    }
+
+    if (queued > 0U) {
+        m_pool->submit(call->stream, queued);
+        call->pending += queued;
+    }
+}
+
+/* Helper to collect the transcoded codewords of a call into frames. */
+
+void CrossModeTranscoder::collect(TranscodeCall* call, std::vector<TranscodedFrame>& frames)
+{
+    if (call->stream < 0) {
+        return;
+    }
+
+    VocoderFrame* frame = nullptr;
+    while ((frame = m_pool->front(call->stream)) != nullptr) {
+        if (call->pending > 0U) {
+            call->pending--;
+        }
+
+        addCodeword(call, frame->codeword, frames);
+        m_pool->pop(call->stream);
+    }
+}
+
+/* Helper to pad the partial frame of an ending call with null codewords, and add it. */
+
+void CrossModeTranscoder::flush(TranscodeCall* call, std::vector<TranscodedFrame>& frames)
+{
+    if (call->toP25) {
+        while ((call->n % 9U) != 0U) {
+            addCodeword(call, p25::defines::NULL_IMBE, frames);
+        }
+    }
+    else {
+        while (call->n != 0U) {
+            addCodeword(call, dmr::defines::NULL_AMBE, frames);
+        }
+    }
+}
+
+/* Helper to add a transcoded codeword to the current frame of a call. */
+
+void CrossModeTranscoder::addCodeword(TranscodeCall* call, const uint8_t* codeword, std::vector<TranscodedFrame>& frames)
+{
+    using namespace dmr;
+    using namespace dmr::defines;
+
+    if (call->toP25) {
+        // fill the LDU buffer, a LDU1 is followed by a LDU2
+        if (call->n == 0U || call->n == 9U) {
+            ::memset(call->frame, 0x00U, sizeof(call->frame));
+        }
+
+        ::memcpy(call->frame + LDU_IMBE_OFFSETS[call->n % 9U], codeword, p25::defines::RAW_IMBE_LENGTH_BYTES);
+        call->n++;
+
+        if (call->n == 9U) {
+            addP25Frame(call, p25::defines::DUID::LDU1, frames);
+        }
+
+        if (call->n == 18U) {
+            addP25Frame(call, p25::defines::DUID::LDU2, frames);
+            call->n = 0U;
+        }
+    }
+    else {
+        // is this the start of the call?
+        if (call->seqNo == 0U) {
+            uint8_t data[DMR_FRAME_LENGTH_BYTES];
+            ::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES);
+
+            lc::LC dmrLC = lc::LC();
+            dmrLC.setFLCO(FLCO::GROUP);
+            dmrLC.setSrcId(call->srcId);
+            dmrLC.setDstId(call->dstId);
+            call->embeddedData.setLC(dmrLC);
+
+            SlotType slotType = SlotType();
+            slotType.setDataType(DataType::VOICE_LC_HEADER);
+            slotType.encode(data);
+
+            lc::FullLC fullLC = lc::FullLC();
+            fullLC.encode(dmrLC, data, DataType::VOICE_LC_HEADER);
+
+            Sync::addDMRDataSync(data, true);
+
+            addDMRFrame(call, DataType::VOICE_LC_HEADER, data, frames);
+        }
+
+        ::memcpy(call->frame + (call->n * RAW_AMBE_LENGTH_BYTES), codeword, RAW_AMBE_LENGTH_BYTES);
+        call->n++;
+
+        if (call->n == AMBE_PER_SLOT) {
+            uint8_t data[DMR_FRAME_LENGTH_BYTES];
+            ::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES);
+
+            ::memcpy(data, call->frame, 13U);
+            data[13U] = (uint8_t)(call->frame[13U] & 0xF0U);
+            data[19U] = (uint8_t)(call->frame[13U] & 0x0FU);
+            ::memcpy(data + 20U, call->frame + 14U, 13U);
+
+            // the first burst of every superframe carries the voice sync, the others embedded LC
+            uint8_t n = (uint8_t)((call->seqNo - 1U) % 6U);
+            if (n == 0U) {
+                Sync::addDMRAudioSync(data, true);
+                addDMRFrame(call, DataType::VOICE_SYNC, data, frames);
+            }
+            else {
+                uint8_t lcss = call->embeddedData.getData(data, n);
+
+                data::EMB emb = data::EMB();
+                emb.setColorCode(0U);
+                emb.setLCSS(lcss);
+                emb.encode(data);
+
+                addDMRFrame(call, DataType::VOICE, data, frames);
+            }
+
+            call->n = 0U;
+        }
+    }
+}
+
+/* Helper to add a DMR frame to the frames waiting to be routed. */
+
+void CrossModeTranscoder::addDMRFrame(TranscodeCall* call, dmr::defines::DataType::E dataType, const uint8_t* data, std::vector<TranscodedFrame>& frames)
+{
+    using namespace dmr;
+    using namespace dmr::defines;
+
+    bool voice = (dataType == DataType::VOICE_SYNC) || (dataType == DataType::VOICE);
+
+    data::NetData dmrData;
+    dmrData.setSlotNo(call->slotNo);
+    dmrData.setDataType(dataType);
+    dmrData.setSrcId(call->srcId);
+    dmrData.setDstId(call->dstId);
+    dmrData.setFLCO(FLCO::GROUP);
+    dmrData.setN((voice) ? (uint8_t)((call->seqNo - 1U) % 6U) : 0U);
+    dmrData.setSeqNo((uint8_t)call->seqNo);
+    dmrData.setBER(0U);
+    dmrData.setRSSI(0U);
+
+    dmrData.setData(data);
+
+    TranscodedFrame frame;
+    frame.p25 = false;
+    frame.length = 0U;
+    frame.buffer = m_network->createDMR_Message(frame.length, call->streamId, dmrData);
+    if (frame.buffer == nullptr) {
+        return;
+    }
+
+    frame.peerId = call->peerId;
+    frame.pktSeq = (dataType == DataType::TERMINATOR_WITH_LC) ? RTP_END_OF_CALL_SEQ : call->pktSeq++;
+    frame.streamId = call->streamId;
+    frame.external = call->external;
+    frames.push_back(std::move(frame));
+
+    if (m_debug) {
+        LogDebug(LOG_NET, "DMR, transcoded, dataType = $%02X, srcId = %u, dstId = %u, slotNo = %u, seqNo = %u, streamId = %u",
+            dataType, call->srcId, call->dstId, call->slotNo, call->seqNo, call->streamId);
+    }
+
+    call->seqNo++;
+}
+
+/* Helper to add a P25 frame to the frames waiting to be routed. */
+
+void CrossModeTranscoder::addP25Frame(TranscodeCall* call, p25::defines::DUID::E duid, std::vector<TranscodedFrame>& frames)
+{
+    using namespace p25;
+    using namespace p25::defines;
+
+    lc::LC control = lc::LC();
+    control.setLCO(LCO::GROUP);
+    control.setGroup(true);
+    control.setPriority(4U);
+    control.setSrcId(call->srcId);
+    control.setDstId(call->dstId);
+
+    data::LowSpeedData lsd = data::LowSpeedData();
+
+    TranscodedFrame frame;
+    frame.p25 = true;
+    frame.length = 0U;
+    switch (duid) {
+    case DUID::LDU1:
+        frame.buffer = m_network->createP25_LDU1Message(frame.length, control, lsd, call->frame,
+            (call->seqNo == 0U) ? FrameType::HDU_VALID : FrameType::DATA_UNIT);
+        break;
+    case DUID::LDU2:
+        frame.buffer = m_network->createP25_LDU2Message(frame.length, control, lsd, call->frame);
+        break;
+    default:
+        frame.buffer = m_network->createP25_TDUMessage(frame.length, control, lsd, 0x00U);
+        break;
+    }
+
+    if (frame.buffer == nullptr) {
+        return;
+    }
+
+    frame.peerId = call->peerId;
+    frame.pktSeq = (duid == DUID::TDU) ? RTP_END_OF_CALL_SEQ : call->pktSeq++;
+    frame.streamId = call->streamId;
+    frame.external = call->external;
+    frames.push_back(std::move(frame));
+
+    if (m_debug) {
+        LogDebug(LOG_NET, "P25, transcoded, duid = $%02X, srcId = %u, dstId = %u, seqNo = %u, streamId = %u",
+            duid, call->srcId, call->dstId, call->seqNo, call->streamId);
+    }
+
+    call->seqNo++;
+}
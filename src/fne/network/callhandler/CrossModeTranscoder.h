@@ -0,0 +1,258 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file CrossModeTranscoder.h
+ * @ingroup fne_callhandler
+ * @file CrossModeTranscoder.cpp
+ * @ingroup fne_callhandler
+ */
+#if !defined(__CALLHANDLER__CROSS_MODE_TRANSCODER_H__)
+#define __CALLHANDLER__CROSS_MODE_TRANSCODER_H__
+
+#include "fne/Defines.h"
+#include "common/dmr/DMRDefines.h"
+#include "common/dmr/data/EmbeddedData.h"
+#include "common/p25/P25Defines.h"
+#include "network/FNENetwork.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Class Prototypes
+// ---------------------------------------------------------------------------
+
+namespace vocoder { class HOST_SW_API VocoderPool; }
+
+namespace network
+{
+    namespace callhandler
+    {
+        // ---------------------------------------------------------------------------
+        //  Constants
+        // ---------------------------------------------------------------------------
+
+        /**
+         * @brief Maximum number of codewords queued to, or from, a transcoded call.
+         */
+        const uint32_t TRANSCODE_QUEUE_DEPTH = 36U;
+        /**
+         * @brief Time a transcoded call may go without traffic before it is ended (ms).
+         */
+        const uint32_t TRANSCODE_CALL_TIMEOUT = 2000U;
+
+        // ---------------------------------------------------------------------------
+        //  Class Declaration
+        // ---------------------------------------------------------------------------
+
+        /**
+         * @brief Implements transcoding of voice calls between DMR talkgroups and the P25 talkgroups
+         *  they are patched to.
+         * @ingroup fne_callhandler
+         *
+         *  Voice frames of a call on a patched talkgroup are handed to a pool of vocoder workers (each
+         *  call owns a transcoding stream, holding its codec state), and the transcoded codewords are
+         *  collected on the FNE clock, framed as a new call on the patched talkgroup of the other mode
+         *  and routed through the call handler of that mode, as if received from the source peer.
+         */
+        class HOST_SW_API CrossModeTranscoder {
+        public:
+            /**
+             * @brief Initializes a new instance of the CrossModeTranscoder class.
+             * @param network Instance of the FNENetwork class.
+             * @param workers Number of vocoder worker threads.
+             * @param maxCalls Maximum number of simultaneously transcoded calls.
+             * @param parametric Flag indicating MBE model parameters are mapped directly, instead of
+             *  always transcoding through PCM samples.
+             * @param debug Flag indicating whether network debug is enabled.
+             */
+            CrossModeTranscoder(FNENetwork* network, uint32_t workers, uint32_t maxCalls, bool parametric, bool debug);
+            /**
+             * @brief Finalizes a instance of the CrossModeTranscoder class.
+             */
+            ~CrossModeTranscoder();
+
+            /**
+             * @brief Patches a DMR talkgroup to a P25 talkgroup.
+             * @param dmrTgId DMR Talkgroup ID.
+             * @param dmrSlot DMR Slot.
+             * @param p25TgId P25 Talkgroup ID.
+             * @returns bool True, if the patch was added, otherwise false.
+             */
+            bool addPatch(uint32_t dmrTgId, uint8_t dmrSlot, uint32_t p25TgId);
+            /**
+             * @brief Gets the number of patched talkgroups.
+             * @returns uint32_t Number of patched talkgroups.
+             */
+            uint32_t patches() const { return (uint32_t)m_dmrPatches.size(); }
+
+            /**
+             * @brief Starts the vocoder workers.
+             * @returns bool True, if the workers were started, otherwise false.
+             */
+            bool start();
+            /**
+             * @brief Stops the vocoder workers.
+             */
+            void stop();
+
+            /**
+             * @brief Process a DMR frame routed by the DMR call handler.
+             * @param data Network data buffer.
+             * @param len Length of data.
+             * @param peerId Peer ID.
+             * @param streamId Stream ID.
+             * @param external Flag indicating traffic is from an external peer.
+             * @returns bool True, if the frame was queued for transcoding, otherwise false.
+             */
+            bool processDMR(const uint8_t* data, uint32_t len, uint32_t peerId, uint32_t streamId, bool external);
+            /**
+             * @brief Process a P25 frame routed by the P25 call handler.
+             * @param data Network data buffer.
+             * @param len Length of data.
+             * @param peerId Peer ID.
+             * @param streamId Stream ID.
+             * @param external Flag indicating traffic is from an external peer.
+             * @returns bool True, if the frame was queued for transcoding, otherwise false.
+             */
+            bool processP25(const uint8_t* data, uint32_t len, uint32_t peerId, uint32_t streamId, bool external);
+
+            /**
+             * @brief Collects transcoded codewords, and routes the transcoded frames.
+             * @param ms Number of milliseconds.
+             */
+            void clock(uint32_t ms);
+
+            /**
+             * @brief Gets the number of calls being transcoded.
+             * @returns uint32_t Number of calls being transcoded.
+             */
+            uint32_t activeCalls();
+
+        private:
+            FNENetwork* m_network;
+
+            vocoder::VocoderPool* m_pool;
+            bool m_parametric;
+
+            /**
+             * @brief Represents a call being transcoded.
+             */
+            class TranscodeCall {
+            public:
+                bool toP25;                         //! Flag indicating the call is transcoded from DMR to P25.
+                bool encrypted;                     //! Flag indicating the call is encrypted (and isn't transcoded).
+                bool ending;                        //! Flag indicating the source call has ended.
+
+                int32_t stream;                     //! Vocoder pool stream handle.
+                uint32_t pending;                   //! Number of codewords queued to the vocoder pool.
+
+                uint32_t peerId;                    //! Source Peer ID.
+                bool external;                      //! Flag indicating the source call is from an external peer.
+                uint32_t srcId;                     //! Source Radio ID.
+                uint32_t dstId;                     //! Destination (patched) Talkgroup ID.
+                uint8_t slotNo;                     //! DMR Slot.
+
+                uint32_t streamId;                  //! Stream ID of the transcoded call.
+                uint16_t pktSeq;                    //! RTP packet sequence of the transcoded call.
+                uint32_t seqNo;                     //! Number of frames of the transcoded call.
+                uint32_t n;                         //! Number of codewords collected into the current frame.
+                uint8_t frame[9U * 25U];            //! Current (LDU or DMR voice burst) frame.
+                dmr::data::EmbeddedData embeddedData;
+
+                uint64_t lastPacket;                //! Time the last source frame was received (ms).
+            };
+            std::unordered_map<uint32_t, TranscodeCall*> m_calls;
+            std::unordered_set<uint32_t> m_transcodedStreams;
+            std::mutex m_mutex;
+
+            std::unordered_map<uint32_t, uint32_t> m_dmrPatches;
+            std::unordered_map<uint32_t, uint32_t> m_p25Patches;
+
+            /**
+             * @brief Represents a transcoded frame waiting to be routed.
+             */
+            class TranscodedFrame {
+            public:
+                bool p25;
+                UInt8Array buffer;
+                uint32_t length;
+
+                uint32_t peerId;
+                uint16_t pktSeq;
+                uint32_t streamId;
+                bool external;
+            };
+
+            bool m_debug;
+
+            /**
+             * @brief Helper to find, or start, the call being transcoded for a source stream.
+             * @param streamId Source Stream ID.
+             * @param toP25 Flag indicating the call is transcoded from DMR to P25.
+             * @param peerId Source Peer ID.
+             * @param external Flag indicating the source call is from an external peer.
+             * @param srcId Source Radio ID.
+             * @param dstId Destination (patched) Talkgroup ID.
+             * @param slotNo DMR Slot.
+             * @returns TranscodeCall* Call being transcoded.
+             */
+            TranscodeCall* findCall(uint32_t streamId, bool toP25, uint32_t peerId, bool external, uint32_t srcId,
+                uint32_t dstId, uint8_t slotNo);
+            /**
+             * @brief Helper to queue the codewords of a source frame for transcoding.
+             * @param call Call being transcoded.
+             * @param codewords Codewords.
+             * @param count Number of codewords.
+             * @param length Length of a codeword.
+             */
+            void queueCodewords(TranscodeCall* call, const uint8_t* codewords, uint32_t count, uint32_t length);
+
+            /**
+             * @brief Helper to collect the transcoded codewords of a call into frames.
+             * @param call Call being transcoded.
+             * @param frames Transcoded frames waiting to be routed.
+             */
+            void collect(TranscodeCall* call, std::vector<TranscodedFrame>& frames);
+            /**
+             * @brief Helper to pad the partial frame of an ending call with null codewords, and add it.
+             * @param call Call being transcoded.
+             * @param frames Transcoded frames waiting to be routed.
+             */
+            void flush(TranscodeCall* call, std::vector<TranscodedFrame>& frames);
+            /**
+             * @brief Helper to add a transcoded codeword to the current frame of a call.
+             * @param call Call being transcoded.
+             * @param[in] codeword Transcoded codeword.
+             * @param frames Transcoded frames waiting to be routed.
+             */
+            void addCodeword(TranscodeCall* call, const uint8_t* codeword, std::vector<TranscodedFrame>& frames);
+            /**
+             * @brief Helper to add a DMR frame to the frames waiting to be routed.
+             * @param call Call being transcoded.
+             * @param dataType DMR data type.
+             * @param data DMR frame.
+             * @param frames Transcoded frames waiting to be routed.
+             */
+            void addDMRFrame(TranscodeCall* call, dmr::defines::DataType::E dataType, const uint8_t* data, std::vector<TranscodedFrame>& frames);
+            /**
+             * @brief Helper to add a P25 frame to the frames waiting to be routed.
+             * @param call Call being transcoded.
+             * @param duid P25 DUID.
+             * @param frames Transcoded frames waiting to be routed.
+             */
+            void addP25Frame(TranscodeCall* call, p25::defines::DUID::E duid, std::vector<TranscodedFrame>& frames);
+        };
+    } // namespace callhandler
+} // namespace network
+
+#endif // __CALLHANDLER__CROSS_MODE_TRANSCODER_H__
@@ -17,6 +17,7 @@
 #include "common/Log.h"
 #include "common/Utils.h"
 #include "network/FNENetwork.h"
+#include "network/callhandler/CrossModeTranscoder.h"
 #include "network/callhandler/TagDMRData.h"
 #include "HostFNE.h"
 
@@ -141,19 +142,14 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
             }
 
             RxStatus status;
-            auto it = std::find_if(m_status.begin(), m_status.end(), [&](StatusMapPair x) { return (x.second.dstId == dstId && x.second.slotNo == slotNo); });
-            if (it == m_status.end()) {
+            if (!m_status.find(dstId, slotNo, status)) {
                 LogError(LOG_NET, "DMR, tried to end call for non-existent call in progress?, peer = %u, srcId = %u, dstId = %u, streamId = %u, external = %u",
                     peerId, srcId, dstId, streamId, external);
             }
-            else {
-                status = it->second;
-            }
 
             uint64_t duration = hrc::diff(pktTime, status.callStartTime);
 
-            if (std::find_if(m_status.begin(), m_status.end(), [&](StatusMapPair x) { return (x.second.dstId == dstId && x.second.slotNo == slotNo); }) != m_status.end()) {
-                m_status.erase(dstId);
+            if (m_status.erase(dstId, slotNo)) {
 
                 // is this a parrot talkgroup? if so, clear any remaining frames from the buffer
                 lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
@@ -183,6 +179,7 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                         .request(m_network->m_influxServer);
                 }
 
+                m_network->publishCallEvent(false, "dmr", peerId, srcId, dstId, slotNo, duration);
                 m_network->m_callInProgress = false;
             }
         }
@@ -194,15 +191,14 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                 return false;
             }
 
-            auto it = std::find_if(m_status.begin(), m_status.end(), [&](StatusMapPair x) { return (x.second.dstId == dstId && x.second.slotNo == slotNo); });
-            if (it != m_status.end()) {
-                RxStatus status = it->second;
+            RxStatus status;
+            if (m_status.find(dstId, slotNo, status)) {
                 if (streamId != status.streamId) {
                     if (status.srcId != 0U && status.srcId != srcId) {
                         uint64_t lastPktDuration = hrc::diff(hrc::now(), status.lastPacket);
                         if ((lastPktDuration / 1000) > CALL_COLL_TIMEOUT) {
                             LogWarning(LOG_NET, "DMR, Call Collision, lasted more then %us with no further updates, forcibly ending call");
-                            m_status.erase(dstId);
+                            m_status.erase(dstId, slotNo);
                             m_network->m_callInProgress = false;
                         }
 
@@ -228,17 +224,18 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                 }
 
                 // this is a new call stream
-                RxStatus status = RxStatus();
+                status = RxStatus();
                 status.callStartTime = pktTime;
                 status.srcId = srcId;
                 status.dstId = dstId;
                 status.slotNo = slotNo;
                 status.streamId = streamId;
                 status.peerId = peerId;
-                m_status[dstId] = status; // this *could* be an issue if a dstId appears on both slots somehow...
+                m_status.add(status);
 
                 LogMessage(LOG_NET, "DMR, Call Start, peer = %u, srcId = %u, dstId = %u, streamId = %u, external = %u", peerId, srcId, dstId, streamId, external);
 
+                m_network->publishCallEvent(true, "dmr", peerId, srcId, dstId, slotNo);
                 m_network->m_callInProgress = true;
             }
         }
@@ -274,11 +271,17 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
             return false;
         }
 
-        m_status[dstId].lastPacket = hrc::now();
+        m_status.touch(dstId, slotNo, hrc::now());
+
+        // hand voice on a talkgroup patched to another mode to the cross-mode transcoder
+        if (m_network->m_transcoder != nullptr) {
+            m_network->m_transcoder->processDMR(buffer, len, peerId, streamId, external);
+        }
 
         // repeat traffic to the connected peers
         if (m_network->m_peers.size() > 0U) {
             uint32_t i = 0U;
+            std::vector<uint32_t> groupPeers;
             for (auto peer : m_network->m_peers) {
                 if (peerId != peer.first) {
                     // is this peer ignored?
@@ -299,7 +302,13 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                     // perform TGID route rewrites if configured
                     routeRewrite(outboundPeerBuffer, peer.first, dmrData, dataType, dstId, slotNo);
 
-                    m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, outboundPeerBuffer, len, pktSeq, streamId, true);
+                    // multicast group peers receiving the frame unmodified are written to once, below
+                    if (m_network->isGroupPeer(peer.second) && ::memcmp(outboundPeerBuffer, buffer, len) == 0) {
+                        groupPeers.push_back(peer.first);
+                    }
+                    else {
+                        m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, outboundPeerBuffer, len, pktSeq, streamId, true);
+                    }
                     if (m_network->m_debug) {
                         LogDebug(LOG_NET, "DMR, srcPeer = %u, dstPeer = %u, seqNo = %u, srcId = %u, dstId = %u, flco = $%02X, slotNo = %u, len = %u, pktSeq = %u, stream = %u, external = %u", 
                             peerId, peer.first, seqNo, srcId, dstId, flco, slotNo, len, pktSeq, streamId, external);
@@ -310,6 +319,8 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                     i++;
                 }
             }
+
+            m_network->writeGroup(peerId, groupPeers, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, buffer, len, pktSeq, streamId);
             m_network->m_frameQueue->flushQueue();
         }
 
@@ -367,7 +378,7 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
 bool TagDMRData::processGrantReq(uint32_t srcId, uint32_t dstId, uint8_t slot, bool unitToUnit, uint32_t peerId, uint16_t pktSeq, uint32_t streamId)
 {
     // if we have an Rx status for the destination deny the grant
-    if (std::find_if(m_status.begin(), m_status.end(), [&](StatusMapPair x) { return x.second.dstId == dstId; }) != m_status.end()) {
+    if (m_status.isActive(dstId)) {
         return false;
     }
 
@@ -572,7 +583,8 @@ bool TagDMRData::processCSBK(uint8_t* buffer, uint32_t peerId, dmr::data::NetDat
         uint8_t data[DMR_FRAME_LENGTH_BYTES + 2U];
         dmrData.getData(data + 2U);
 
-        std::unique_ptr<lc::CSBK> csbk = lc::csbk::CSBKFactory::createCSBK(data + 2U, DataType::CSBK);
+        lc::csbk::CSBKStorage csbkStorage;
+        lc::CSBK* csbk = lc::csbk::CSBKFactory::decodeCSBK(data + 2U, DataType::CSBK, csbkStorage);
         if (csbk != nullptr) {
             // report csbk event to InfluxDB
             if (m_network->m_enableInfluxDB && m_network->m_influxLogRawData) {
@@ -598,7 +610,7 @@ bool TagDMRData::processCSBK(uint8_t* buffer, uint32_t peerId, dmr::data::NetDat
             switch (csbk->getCSBKO()) {
             case CSBKO::BROADCAST:
                 {
-                    lc::csbk::CSBK_BROADCAST* osp = static_cast<lc::csbk::CSBK_BROADCAST*>(csbk.get());
+                    lc::csbk::CSBK_BROADCAST* osp = static_cast<lc::csbk::CSBK_BROADCAST*>(csbk);
                     if (osp->getAnncType() == BroadcastAnncType::ANN_WD_TSCC) {
                         if (m_network->m_disallowAdjStsBcast) {
                             // LogWarning(LOG_NET, "PEER %u, passing BroadcastAnncType::ANN_WD_TSCC to internal peers is prohibited, dropping", peerId);
@@ -22,6 +22,7 @@
 #include "common/dmr/lc/CSBK.h"
 #include "common/Clock.h"
 #include "network/FNENetwork.h"
+#include "network/callhandler/CallRegistry.h"
 #include "network/callhandler/packetdata/DMRPacketData.h"
 
 #include <deque>
@@ -109,6 +110,12 @@ namespace network
              */
             packetdata::DMRPacketData* packetData() { return m_packetData; }
 
+            /**
+             * @brief Gets the registry of active calls.
+             * @returns CallRegistry Registry of active calls.
+             */
+            const CallRegistry& activeCalls() const { return m_status; }
+
         private:
             FNENetwork* m_network;
 
@@ -132,21 +139,7 @@ namespace network
             std::deque<ParrotFrame> m_parrotFrames;
             bool m_parrotFramesReady;
 
-            /**
-             * @brief Represents the receive status of a call.
-             */
-            class RxStatus {
-            public:
-                system_clock::hrc::hrc_t callStartTime;
-                system_clock::hrc::hrc_t lastPacket;
-                uint32_t srcId;
-                uint32_t dstId;
-                uint8_t slotNo;
-                uint32_t streamId;
-                uint32_t peerId;
-            };
-            typedef std::pair<const uint32_t, RxStatus> StatusMapPair;
-            std::unordered_map<uint32_t, RxStatus> m_status;
+            CallRegistry m_status;
 
             friend class packetdata::DMRPacketData;
             packetdata::DMRPacketData* m_packetData;
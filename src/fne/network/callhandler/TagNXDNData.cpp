@@ -110,11 +110,11 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
                     return false;
                 }
 
-                RxStatus status = m_status[dstId];
+                RxStatus status;
+                m_status.find(dstId, 0U, status);
                 uint64_t duration = hrc::diff(pktTime, status.callStartTime);
 
-                if (std::find_if(m_status.begin(), m_status.end(), [&](StatusMapPair x) { return x.second.dstId == dstId; }) != m_status.end()) {
-                    m_status.erase(dstId);
+                if (m_status.erase(dstId, 0U)) {
 
                     // is this a parrot talkgroup? if so, clear any remaining frames from the buffer
                     lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
@@ -143,6 +143,7 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
                             .request(m_network->m_influxServer);
                     }
 
+                    m_network->publishCallEvent(false, "nxdn", peerId, srcId, dstId, 0U, duration);
                     m_network->m_callInProgress = false;
                 }
             }
@@ -154,15 +155,14 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
                     return false;
                 }
 
-                auto it = std::find_if(m_status.begin(), m_status.end(), [&](StatusMapPair x) { return x.second.dstId == dstId; });
-                if (it != m_status.end()) {
-                    RxStatus status = m_status[dstId];
+                RxStatus status;
+                if (m_status.find(dstId, 0U, status)) {
                     if (streamId != status.streamId) {
                         if (status.srcId != 0U && status.srcId != srcId) {
                             uint64_t lastPktDuration = hrc::diff(hrc::now(), status.lastPacket);
                             if ((lastPktDuration / 1000) > CALL_COLL_TIMEOUT) {
                                 LogWarning(LOG_NET, "NXDN, Call Collision, lasted more then %us with no further updates, forcibly ending call");
-                                m_status.erase(dstId);
+                                m_status.erase(dstId, 0U);
                                 m_network->m_callInProgress = false;
                             }
 
@@ -188,16 +188,17 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
                     }
 
                     // this is a new call stream
-                    RxStatus status = RxStatus();
+                    status = RxStatus();
                     status.callStartTime = pktTime;
                     status.srcId = srcId;
                     status.dstId = dstId;
                     status.streamId = streamId;
                     status.peerId = peerId;
-                    m_status[dstId] = status;
+                    m_status.add(status);
 
                     LogMessage(LOG_NET, "NXDN, Call Start, peer = %u, srcId = %u, dstId = %u, streamId = %u, external = %u", peerId, srcId, dstId, streamId, external);
 
+                    m_network->publishCallEvent(true, "nxdn", peerId, srcId, dstId);
                     m_network->m_callInProgress = true;
                 }
             }
@@ -227,11 +228,12 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
             }
         }
 
-        m_status[dstId].lastPacket = hrc::now();
+        m_status.touch(dstId, 0U, hrc::now());
 
         // repeat traffic to the connected peers
         if (m_network->m_peers.size() > 0U) {
             uint32_t i = 0U;
+            std::vector<uint32_t> groupPeers;
             for (auto peer : m_network->m_peers) {
                 if (peerId != peer.first) {
                     // is this peer ignored?
@@ -252,7 +254,13 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
                     // perform TGID route rewrites if configured
                     routeRewrite(outboundPeerBuffer, peer.first, messageType, dstId);
 
-                    m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN }, outboundPeerBuffer, len, pktSeq, streamId, true);
+                    // multicast group peers receiving the frame unmodified are written to once, below
+                    if (m_network->isGroupPeer(peer.second) && ::memcmp(outboundPeerBuffer, buffer, len) == 0) {
+                        groupPeers.push_back(peer.first);
+                    }
+                    else {
+                        m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN }, outboundPeerBuffer, len, pktSeq, streamId, true);
+                    }
                     if (m_network->m_debug) {
                         LogDebug(LOG_NET, "NXDN, srcPeer = %u, dstPeer = %u, messageType = $%02X, srcId = %u, dstId = %u, len = %u, pktSeq = %u, streamId = %u, external = %u", 
                             peerId, peer.first, messageType, srcId, dstId, len, pktSeq, streamId, external);
@@ -263,6 +271,8 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
                     i++;
                 }
             }
+
+            m_network->writeGroup(peerId, groupPeers, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN }, buffer, len, pktSeq, streamId);
             m_network->m_frameQueue->flushQueue();
         }
 
@@ -320,7 +330,7 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
 bool TagNXDNData::processGrantReq(uint32_t srcId, uint32_t dstId, bool unitToUnit, uint32_t peerId, uint16_t pktSeq, uint32_t streamId)
 {
     // if we have an Rx status for the destination deny the grant
-    if (std::find_if(m_status.begin(), m_status.end(), [&](StatusMapPair x) { return x.second.dstId == dstId; }) != m_status.end()) {
+    if (m_status.isActive(dstId)) {
         return false;
     }
 
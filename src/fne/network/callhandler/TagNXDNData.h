@@ -22,6 +22,7 @@
 #include "common/nxdn/lc/RTCH.h"
 #include "common/nxdn/lc/RCCH.h"
 #include "network/FNENetwork.h"
+#include "network/callhandler/CallRegistry.h"
 
 #include <deque>
 
@@ -83,6 +84,12 @@ namespace network
              */
             bool hasParrotFrames() const { return m_parrotFramesReady && !m_parrotFrames.empty(); }
 
+            /**
+             * @brief Gets the registry of active calls.
+             * @returns CallRegistry Registry of active calls.
+             */
+            const CallRegistry& activeCalls() const { return m_status; }
+
         private:
             FNENetwork* m_network;
 
@@ -104,20 +111,7 @@ namespace network
             std::deque<ParrotFrame> m_parrotFrames;
             bool m_parrotFramesReady;
 
-            /**
-             * @brief Represents the receive status of a call.
-             */
-            class RxStatus {
-            public:
-                system_clock::hrc::hrc_t callStartTime;
-                system_clock::hrc::hrc_t lastPacket;
-                uint32_t srcId;
-                uint32_t dstId;
-                uint32_t streamId;
-                uint32_t peerId;
-            };
-            typedef std::pair<const uint32_t, RxStatus> StatusMapPair;
-            std::unordered_map<uint32_t, RxStatus> m_status;
+            CallRegistry m_status;
 
             bool m_debug;
 
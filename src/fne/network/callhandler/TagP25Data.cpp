@@ -15,6 +15,7 @@
 #include "common/Thread.h"
 #include "common/Utils.h"
 #include "network/FNENetwork.h"
+#include "network/callhandler/CrossModeTranscoder.h"
 #include "network/callhandler/TagP25Data.h"
 #include "HostFNE.h"
 
@@ -138,20 +139,16 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
     lsd.setLSD1(lsd1);
     lsd.setLSD2(lsd2);
 
-    uint32_t frameLength = buffer[23U];
-
-    // process a TSBK out into a class literal if possible
-    std::unique_ptr<lc::TSBK> tsbk;
+    // process a TSBK out into a class literal if possible (the TSBK is decoded once per frame, and
+    // shared by all the destination peers)
+    lc::tsbk::TSBKStorage tsbkStorage;
+    lc::TSBK* tsbk = nullptr;
     if (duid == DUID::TSDU) {
-        UInt8Array data = std::unique_ptr<uint8_t[]>(new uint8_t[frameLength]);
-        ::memset(data.get(), 0x00U, frameLength);
-        ::memcpy(data.get(), buffer + 24U, frameLength);
-
-        tsbk = lc::tsbk::TSBKFactory::createTSBK(data.get());
+        tsbk = lc::tsbk::TSBKFactory::decodeTSBK(buffer + 24U, tsbkStorage);
     }
 
     // is the stream valid?
-    if (validate(peerId, control, duid, tsbk.get(), streamId)) {
+    if (validate(peerId, control, duid, tsbk, streamId)) {
         // is this peer ignored?
         if (!isPeerPermitted(peerId, control, duid, streamId)) {
             return false;
@@ -166,7 +163,8 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                     return false;
                 }
 
-                RxStatus status = m_status[dstId];
+                RxStatus status;
+                m_status.find(dstId, 0U, status);
                 uint64_t duration = hrc::diff(pktTime, status.callStartTime);
 
                 // perform a test for grant demands, and if the TG isn't valid ignore the demand
@@ -178,8 +176,7 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                     }
                 }
 
-                if (std::find_if(m_status.begin(), m_status.end(), [&](StatusMapPair x) { return x.second.dstId == dstId; }) != m_status.end()) {
-                    m_status.erase(dstId);
+                if (m_status.erase(dstId, 0U)) {
 
                     // is this a parrot talkgroup? if so, clear any remaining frames from the buffer
                     lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
@@ -209,6 +206,7 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                             .request(m_network->m_influxServer);
                     }
 
+                    m_network->publishCallEvent(false, "p25", peerId, srcId, dstId, 0U, duration);
                     m_network->m_callInProgress = false;
                 }
             }
@@ -220,15 +218,14 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                     return false;
                 }
 
-                auto it = std::find_if(m_status.begin(), m_status.end(), [&](StatusMapPair x) { return x.second.dstId == dstId; });
-                if (it != m_status.end()) {
-                    RxStatus status = m_status[dstId];
+                RxStatus status;
+                if (m_status.find(dstId, 0U, status)) {
                     if (streamId != status.streamId && ((duid != DUID::TDU) && (duid != DUID::TDULC))) {
                         if (status.srcId != 0U && status.srcId != srcId) {
                             uint64_t lastPktDuration = hrc::diff(hrc::now(), status.lastPacket);
                             if ((lastPktDuration / 1000) > CALL_COLL_TIMEOUT) {
                                 LogWarning(LOG_NET, "P25, Call Collision, lasted more then %us with no further updates, forcibly ending call");
-                                m_status.erase(dstId);
+                                m_status.erase(dstId, 0U);
                                 m_network->m_callInProgress = false;
                             }
 
@@ -254,16 +251,17 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                     }
 
                     // this is a new call stream
-                    RxStatus status = RxStatus();
+                    status = RxStatus();
                     status.callStartTime = pktTime;
                     status.srcId = srcId;
                     status.dstId = dstId;
                     status.streamId = streamId;
                     status.peerId = peerId;
-                    m_status[dstId] = status;
+                    m_status.add(status);
 
                     LogMessage(LOG_NET, "P25, Call Start, peer = %u, srcId = %u, dstId = %u, streamId = %u, external = %u", peerId, srcId, dstId, streamId, external);
 
+                    m_network->publishCallEvent(true, "p25", peerId, srcId, dstId);
                     m_network->m_callInProgress = true;
                 }
             }
@@ -294,15 +292,25 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
         }
 
         // process TSDU from peer
-        if (!processTSDUFrom(buffer, peerId, duid)) {
+        if (!processTSDUFrom(tsbk, peerId, duid)) {
             return false;
         }
 
-        m_status[dstId].lastPacket = hrc::now();
+        m_status.touch(dstId, 0U, hrc::now());
+
+        // hand voice on a talkgroup patched to another mode to the cross-mode transcoder
+        if (m_network->m_transcoder != nullptr) {
+            m_network->m_transcoder->processP25(buffer, len, peerId, streamId, external);
+        }
+
+        // a TSDU is decoded once above, and is regenerated once per distinct rewrite; the regenerated frames
+        // are shared by all the peers (internal and external) with the same rewrite
+        RewrittenTSDUMap rewrittenTSDUs;
 
         // repeat traffic to the connected peers
         if (m_network->m_peers.size() > 0U) {
             uint32_t i = 0U;
+            std::vector<uint32_t> groupPeers;
             for (auto peer : m_network->m_peers) {
                 if (peerId != peer.first) {
                     // is this peer ignored?
@@ -311,7 +319,7 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                     }
 
                     // process TSDU to peer
-                    if (!processTSDUTo(buffer, peer.first, duid)) {
+                    if (!processTSDUTo(tsbk, peer.first, duid)) {
                         continue;
                     }
 
@@ -326,9 +334,15 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                     ::memcpy(outboundPeerBuffer, buffer, len);
 
                     // perform TGID route rewrites if configured
-                    routeRewrite(outboundPeerBuffer, peer.first, duid, dstId);
+                    routeRewrite(outboundPeerBuffer, peer.first, duid, dstId, true, tsbk, &rewrittenTSDUs);
 
-                    m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, outboundPeerBuffer, len, pktSeq, streamId, true);
+                    // multicast group peers receiving the frame unmodified are written to once, below
+                    if (m_network->isGroupPeer(peer.second) && ::memcmp(outboundPeerBuffer, buffer, len) == 0) {
+                        groupPeers.push_back(peer.first);
+                    }
+                    else {
+                        m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, outboundPeerBuffer, len, pktSeq, streamId, true);
+                    }
                     if (m_network->m_debug) {
                         LogDebug(LOG_NET, "P25, srcPeer = %u, dstPeer = %u, duid = $%02X, lco = $%02X, MFId = $%02X, srcId = %u, dstId = %u, len = %u, pktSeq = %u, streamId = %u, external = %u", 
                             peerId, peer.first, duid, lco, MFId, srcId, dstId, len, pktSeq, streamId, external);
@@ -339,6 +353,8 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                     i++;
                 }
             }
+
+            m_network->writeGroup(peerId, groupPeers, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, buffer, len, pktSeq, streamId);
             m_network->m_frameQueue->flushQueue();
         }
 
@@ -371,10 +387,10 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                     ::memcpy(outboundPeerBuffer, buffer, len);
 
                     // perform TGID route rewrites if configured
-                    routeRewrite(outboundPeerBuffer, dstPeerId, duid, dstId);
+                    routeRewrite(outboundPeerBuffer, dstPeerId, duid, dstId, true, tsbk, &rewrittenTSDUs);
 
                     // process TSDUs going to external peers
-                    if (processTSDUToExternal(outboundPeerBuffer, peerId, dstPeerId, duid)) {
+                    if (processTSDUToExternal(tsbk, peerId, dstPeerId, duid)) {
                         peer.second->writeMaster({ NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, outboundPeerBuffer, len, pktSeq, streamId);
                         if (m_network->m_debug) {
                             LogDebug(LOG_NET, "P25, srcPeer = %u, dstPeer = %u, duid = $%02X, lco = $%02X, MFId = $%02X, srcId = %u, dstId = %u, len = %u, pktSeq = %u, streamId = %u, external = %u", 
@@ -399,7 +415,7 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
 bool TagP25Data::processGrantReq(uint32_t srcId, uint32_t dstId, bool unitToUnit, uint32_t peerId, uint16_t pktSeq, uint32_t streamId)
 {
     // if we have an Rx status for the destination deny the grant
-    if (std::find_if(m_status.begin(), m_status.end(), [&](StatusMapPair x) { return x.second.dstId == dstId; }) != m_status.end()) {
+    if (m_status.isActive(dstId)) {
         return false;
     }
 
@@ -583,10 +599,10 @@ void TagP25Data::write_TSDU_U_Reg_Cmd(uint32_t peerId, uint32_t dstId)
 
 /* Helper to route rewrite the network data buffer. */
 
-void TagP25Data::routeRewrite(uint8_t* buffer, uint32_t peerId, uint8_t duid, uint32_t dstId, bool outbound)
+void TagP25Data::routeRewrite(uint8_t* buffer, uint32_t peerId, uint8_t duid, uint32_t dstId, bool outbound,
+    lc::TSBK* tsbk, RewrittenTSDUMap* rewritten)
 {
     uint32_t srcId = __GET_UINT16(buffer, 5U);
-    uint32_t frameLength = buffer[23U];
 
     uint32_t rewriteDstId = dstId;
 
@@ -597,12 +613,25 @@ void TagP25Data::routeRewrite(uint8_t* buffer, uint32_t peerId, uint8_t duid, ui
 
         // are we receiving a TSDU?
         if (duid == DUID::TSDU) {
-            UInt8Array data = std::unique_ptr<uint8_t[]>(new uint8_t[frameLength]);
-            ::memset(data.get(), 0x00U, frameLength);
-            ::memcpy(data.get(), buffer + 24U, frameLength);
+            // was this TSDU already regenerated for another peer with the same rewrite?
+            if (rewritten != nullptr) {
+                auto it = rewritten->find(rewriteDstId);
+                if (it != rewritten->end()) {
+                    ::memcpy(buffer + 24U, it->second.get(), P25_TSDU_FRAME_LENGTH_BYTES);
+                    return;
+                }
+            }
+
+            lc::tsbk::TSBKStorage tsbkStorage;
+            if (tsbk == nullptr) {
+                tsbk = lc::tsbk::TSBKFactory::decodeTSBK(buffer + 24U, tsbkStorage);
+            }
 
-            std::unique_ptr<lc::TSBK> tsbk = lc::tsbk::TSBKFactory::createTSBK(data.get());
             if (tsbk != nullptr) {
+                // the TSBK may be shared with other peers, the original values are restored after regenerating
+                uint32_t origDstId = tsbk->getDstId();
+                bool origLastBlock = tsbk->getLastBlock();
+
                 // handle standard P25 reference opcodes
                 switch (tsbk->getLCO()) {
                     case TSBKO::IOSP_GRP_VCH:
@@ -634,7 +663,16 @@ void TagP25Data::routeRewrite(uint8_t* buffer, uint32_t peerId, uint8_t duid, ui
                     Utils::dump(1U, "!!! *TSDU (SBF) TSBK Block Data", data + P25_PREAMBLE_LENGTH_BYTES + 2U, P25_TSBK_FEC_LENGTH_BYTES);
                 }
 
+                tsbk->setDstId(origDstId);
+                tsbk->setLastBlock(origLastBlock);
+
                 ::memcpy(buffer + 24U, data + 2U, P25_TSDU_FRAME_LENGTH_BYTES);
+
+                if (rewritten != nullptr) {
+                    UInt8Array frame = std::make_unique<uint8_t[]>(P25_TSDU_FRAME_LENGTH_BYTES);
+                    ::memcpy(frame.get(), data + 2U, P25_TSDU_FRAME_LENGTH_BYTES);
+                    (*rewritten)[rewriteDstId] = std::move(frame);
+                }
             }
         }
     }
@@ -672,17 +710,10 @@ bool TagP25Data::peerRewrite(uint32_t peerId, uint32_t& dstId, bool outbound)
 
 /* Helper to process TSDUs being passed from a peer. */
 
-bool TagP25Data::processTSDUFrom(uint8_t* buffer, uint32_t peerId, uint8_t duid)
+bool TagP25Data::processTSDUFrom(lc::TSBK* tsbk, uint32_t peerId, uint8_t duid)
 {
     // are we receiving a TSDU?
     if (duid == DUID::TSDU) {
-        uint32_t frameLength = buffer[23U];
-
-        UInt8Array data = std::unique_ptr<uint8_t[]>(new uint8_t[frameLength]);
-        ::memset(data.get(), 0x00U, frameLength);
-        ::memcpy(data.get(), buffer + 24U, frameLength);
-
-        std::unique_ptr<lc::TSBK> tsbk = lc::tsbk::TSBKFactory::createTSBK(data.get());
         if (tsbk != nullptr) {
             // report tsbk event to InfluxDB
             if (m_network->m_enableInfluxDB && m_network->m_influxLogRawData) {
@@ -720,7 +751,7 @@ bool TagP25Data::processTSDUFrom(uint8_t* buffer, uint32_t peerId, uint8_t duid)
                         // LogWarning(LOG_NET, "PEER %u, passing ADJ_STS_BCAST to internal peers is prohibited, dropping", peerId);
                         return false;
                     } else {
-                        lc::tsbk::OSP_ADJ_STS_BCAST* osp = static_cast<lc::tsbk::OSP_ADJ_STS_BCAST*>(tsbk.get());
+                        lc::tsbk::OSP_ADJ_STS_BCAST* osp = static_cast<lc::tsbk::OSP_ADJ_STS_BCAST*>(tsbk);
 
                         if (m_network->m_verbose) {
                             LogMessage(LOG_NET, P25_TSDU_STR ", %s, sysId = $%03X, rfss = $%02X, site = $%02X, chId = %u, chNo = %u, svcClass = $%02X, peerId = %u", tsbk->toString().c_str(),
@@ -743,17 +774,11 @@ bool TagP25Data::processTSDUFrom(uint8_t* buffer, uint32_t peerId, uint8_t duid)
 
 /* Helper to process TSDUs being passed to a peer. */
 
-bool TagP25Data::processTSDUTo(uint8_t* buffer, uint32_t peerId, uint8_t duid)
+bool TagP25Data::processTSDUTo(lc::TSBK* tsbk, uint32_t peerId, uint8_t duid)
 {
     // are we receiving a TSDU?
     if (duid == DUID::TSDU) {
-        uint32_t frameLength = buffer[23U];
-
-        UInt8Array data = std::unique_ptr<uint8_t[]>(new uint8_t[frameLength]);
-        ::memset(data.get(), 0x00U, frameLength);
-        ::memcpy(data.get(), buffer + 24U, frameLength);
-
-        std::unique_ptr<lc::TSBK> tsbk = lc::tsbk::TSBKFactory::createTSBK(data.get());
+        // TSBKs that failed to decode were already reported by processTSDUFrom()
         if (tsbk != nullptr) {
             //uint32_t srcId = tsbk->getSrcId();
             uint32_t dstId = tsbk->getDstId();
@@ -799,9 +824,6 @@ bool TagP25Data::processTSDUTo(uint8_t* buffer, uint32_t peerId, uint8_t duid)
             default:
                 break;
             }
-        } else {
-            std::string peerIdentity = m_network->resolvePeerIdentity(peerId);
-            LogWarning(LOG_NET, "PEER %u (%s), passing TSBK that failed to decode? tsbk == nullptr", peerId, peerIdentity.c_str());
         }
     }
 
@@ -810,17 +832,11 @@ bool TagP25Data::processTSDUTo(uint8_t* buffer, uint32_t peerId, uint8_t duid)
 
 /* Helper to process TSDUs being passed to an external peer. */
 
-bool TagP25Data::processTSDUToExternal(uint8_t* buffer, uint32_t srcPeerId, uint32_t dstPeerId, uint8_t duid)
+bool TagP25Data::processTSDUToExternal(lc::TSBK* tsbk, uint32_t srcPeerId, uint32_t dstPeerId, uint8_t duid)
 {
     // are we receiving a TSDU?
     if (duid == DUID::TSDU) {
-        uint32_t frameLength = buffer[23U];
-
-        UInt8Array data = std::unique_ptr<uint8_t[]>(new uint8_t[frameLength]);
-        ::memset(data.get(), 0x00U, frameLength);
-        ::memcpy(data.get(), buffer + 24U, frameLength);
-
-        std::unique_ptr<lc::TSBK> tsbk = lc::tsbk::TSBKFactory::createTSBK(data.get());
+        // TSBKs that failed to decode were already reported by processTSDUFrom()
         if (tsbk != nullptr) {
             // handle standard P25 reference opcodes
             switch (tsbk->getLCO()) {
@@ -830,7 +846,7 @@ bool TagP25Data::processTSDUToExternal(uint8_t* buffer, uint32_t srcPeerId, uint
                         // LogWarning(LOG_NET, "PEER %u, passing ADJ_STS_BCAST to external peers is prohibited, dropping", dstPeerId);
                         return false;
                     } else {
-                        lc::tsbk::OSP_ADJ_STS_BCAST* osp = static_cast<lc::tsbk::OSP_ADJ_STS_BCAST*>(tsbk.get());
+                        lc::tsbk::OSP_ADJ_STS_BCAST* osp = static_cast<lc::tsbk::OSP_ADJ_STS_BCAST*>(tsbk);
 
                         if (m_network->m_verbose) {
                             LogMessage(LOG_NET, P25_TSDU_STR ", %s, sysId = $%03X, rfss = $%02X, site = $%02X, chId = %u, chNo = %u, svcClass = $%02X, peerId = %u", tsbk->toString().c_str(),
@@ -842,9 +858,6 @@ bool TagP25Data::processTSDUToExternal(uint8_t* buffer, uint32_t srcPeerId, uint
             default:
                 break;
             }
-        } else {
-            std::string peerIdentity = m_network->resolvePeerIdentity(srcPeerId);
-            LogWarning(LOG_NET, "PEER %u (%s), passing TSBK that failed to decode? tsbk == nullptr", srcPeerId, peerIdentity.c_str());
         }
     }
 
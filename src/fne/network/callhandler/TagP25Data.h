@@ -27,9 +27,11 @@
 #include "common/p25/lc/TSBK.h"
 #include "common/p25/lc/TDULC.h"
 #include "network/FNENetwork.h"
+#include "network/callhandler/CallRegistry.h"
 #include "network/callhandler/packetdata/P25PacketData.h"
 
 #include <deque>
+#include <unordered_map>
 
 namespace network
 {
@@ -131,6 +133,12 @@ namespace network
              */
             packetdata::P25PacketData* packetData() { return m_packetData; }
 
+            /**
+             * @brief Gets the registry of active calls.
+             * @returns CallRegistry Registry of active calls.
+             */
+            const CallRegistry& activeCalls() const { return m_status; }
+
         private:
             FNENetwork* m_network;
 
@@ -153,26 +161,18 @@ namespace network
             bool m_parrotFramesReady;
             bool m_parrotFirstFrame;
 
-            /**
-             * @brief Represents the receive status of a call.
-             */
-            class RxStatus {
-            public:
-                system_clock::hrc::hrc_t callStartTime;
-                system_clock::hrc::hrc_t lastPacket;
-                uint32_t srcId;
-                uint32_t dstId;
-                uint32_t streamId;
-                uint32_t peerId;
-            };
-            typedef std::pair<const uint32_t, RxStatus> StatusMapPair;
-            std::unordered_map<uint32_t, RxStatus> m_status;
+            CallRegistry m_status;
 
             friend class packetdata::P25PacketData;
             packetdata::P25PacketData *m_packetData;
 
             bool m_debug;
 
+            /**
+             * @brief Regenerated TSDU frames for a single inbound TSDU, keyed by the rewritten destination ID.
+             */
+            typedef std::unordered_map<uint32_t, UInt8Array> RewrittenTSDUMap;
+
             /**
              * @brief Helper to route rewrite the network data buffer.
              * @param buffer Frame buffer.
@@ -180,8 +180,12 @@ namespace network
              * @param duid DUID.
              * @param dstId Destination ID.
              * @param outbound Flag indicating whether or not this is outbound traffic.
+             * @param tsbk Decoded TSBK of the frame buffer (or nullptr to decode the TSBK from the frame buffer).
+             * @param rewritten Regenerated TSDU frames shared by all the peers receiving the same inbound TSDU (or nullptr
+             *  to always regenerate the TSDU).
              */
-            void routeRewrite(uint8_t* buffer, uint32_t peerId, uint8_t duid, uint32_t dstId, bool outbound = true);
+            void routeRewrite(uint8_t* buffer, uint32_t peerId, uint8_t duid, uint32_t dstId, bool outbound = true,
+                p25::lc::TSBK* tsbk = nullptr, RewrittenTSDUMap* rewritten = nullptr);
             /**
              * @brief Helper to route rewrite destination ID.
              * @param peerId Peer ID.
@@ -193,29 +197,29 @@ namespace network
 
             /**
              * @brief Helper to process TSDUs being passed from a peer.
-             * @param buffer Frame buffer.
+             * @param tsbk Decoded TSBK (or nullptr if the TSBK failed to decode).
              * @param peerId Peer ID.
              * @param duid DUID.
              * @returns bool True, if allowed to pass, otherwise false.
              */
-            bool processTSDUFrom(uint8_t* buffer, uint32_t peerId, uint8_t duid);
+            bool processTSDUFrom(p25::lc::TSBK* tsbk, uint32_t peerId, uint8_t duid);
             /**
              * @brief Helper to process TSDUs being passed to a peer.
-             * @param buffer Frame buffer.
+             * @param tsbk Decoded TSBK (or nullptr if the TSBK failed to decode).
              * @param peerId Peer ID.
              * @param duid DUID.
              * @returns bool True, if allowed to pass, otherwise false.
              */
-            bool processTSDUTo(uint8_t* buffer, uint32_t peerId, uint8_t duid);
+            bool processTSDUTo(p25::lc::TSBK* tsbk, uint32_t peerId, uint8_t duid);
             /**
              * @brief Helper to process TSDUs being passed to an external peer.
-             * @param buffer Frame buffer.
+             * @param tsbk Decoded TSBK (or nullptr if the TSBK failed to decode).
              * @param srcPeerId Source Peer ID.
              * @param dstPeerID Destination Peer ID.
              * @param duid DUID.
              * @returns bool True, if allowed to pass, otherwise false.
              */
-            bool processTSDUToExternal(uint8_t* buffer, uint32_t srcPeerId, uint32_t dstPeerId, uint8_t duid);
+            bool processTSDUToExternal(p25::lc::TSBK* tsbk, uint32_t srcPeerId, uint32_t dstPeerId, uint8_t duid);
 
             /**
              * @brief Helper to determine if the peer is permitted for traffic.
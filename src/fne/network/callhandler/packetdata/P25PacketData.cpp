@@ -39,6 +39,8 @@ using namespace p25::sndcp;
 // ---------------------------------------------------------------------------
 
 const uint8_t DATA_CALL_COLL_TIMEOUT = 60U;
+const uint32_t VTUN_FRAME_POOL_SIZE = 128U;
+const uint32_t VTUN_FRAME_LENGTH = P25_PDU_FRAME_LENGTH_BYTES;
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -50,6 +52,7 @@ P25PacketData::P25PacketData(FNENetwork* network, TagP25Data* tag, bool debug) :
     m_network(network),
     m_tag(tag),
     m_dataFrames(),
+    m_dataFramePool(),
     m_status(),
     m_arpTable(),
     m_readyForPkt(),
@@ -58,11 +61,26 @@ P25PacketData::P25PacketData(FNENetwork* network, TagP25Data* tag, bool debug) :
 {
     assert(network != nullptr);
     assert(tag != nullptr);
+
+    // preallocate the buffers for data frames queued from the VTUN
+    m_dataFramePool.reserve(VTUN_FRAME_POOL_SIZE);
+    for (uint32_t i = 0U; i < VTUN_FRAME_POOL_SIZE; i++) {
+        m_dataFramePool.push_back(new uint8_t[VTUN_FRAME_LENGTH]);
+    }
 }
 
 /* Finalizes a instance of the P25PacketData class. */
 
-P25PacketData::~P25PacketData() = default;
+P25PacketData::~P25PacketData()
+{
+    for (auto& dataFrame : m_dataFrames) {
+        delete[] dataFrame.buffer;
+    }
+
+    for (uint8_t* buffer : m_dataFramePool) {
+        delete[] buffer;
+    }
+}
 
 /* Process a data frame from the network. */
 
@@ -326,6 +344,10 @@ bool P25PacketData::processFrame(const uint8_t* data, uint32_t len, uint32_t pee
 void P25PacketData::processPacketFrame(const uint8_t* data, uint32_t len, bool alreadyQueued)
 {
 #if !defined(_WIN32)
+    if (len < sizeof(struct ip)) {
+        return;
+    }
+
     struct ip* ipHeader = (struct ip*)data;
 
     char srcIp[INET_ADDRSTRLEN];
@@ -342,10 +364,21 @@ void P25PacketData::processPacketFrame(const uint8_t* data, uint32_t len, bool a
     Utils::dump(1U, "P25PacketData::processPacketFrame() packet", data, pktLen);
 #endif
 
+    if (pktLen > len || pktLen > VTUN_FRAME_LENGTH) {
+        LogError(LOG_NET, "P25, VTUN -> PDU IP Data, illegal packet length, pktLen = %u, len = %u", pktLen, len);
+        return;
+    }
+
+    if (m_dataFramePool.empty()) {
+        LogWarning(LOG_NET, "P25, VTUN -> PDU IP Data, queue is full, dropping packet, dstIp = %s", dstIp);
+        return;
+    }
+
     VTUNDataFrame dataFrame;
-    dataFrame.buffer = new uint8_t[len];
-    ::memcpy(dataFrame.buffer, data, len);
-    dataFrame.bufferLen = len;
+    dataFrame.buffer = m_dataFramePool.back();
+    m_dataFramePool.pop_back();
+    ::memcpy(dataFrame.buffer, data, pktLen);
+    dataFrame.bufferLen = pktLen;
     dataFrame.pktLen = pktLen;
 
     uint32_t dstLlId = getLLIdAddress(Utils::reverseEndian(ipHeader->ip_dst.s_addr));
@@ -368,27 +401,34 @@ void P25PacketData::processPacketFrame(const uint8_t* data, uint32_t len, bool a
 
 void P25PacketData::clock(uint32_t ms)
 {
-    // transmit queued data frames
-    if (m_dataFrames.size() > 0) {
-        auto& dataFrame = m_dataFrames[0];
+    // release any SUs that have not acknowledged the previous packet in time
+    for (auto& entry : m_suNotReadyTimeout) {
+        Timer& timer = entry.second;
+        timer.clock(ms);
+        if (timer.isRunning() && timer.hasExpired()) {
+            timer.stop();
+            m_readyForPkt[entry.first] = true;
+        }
+    }
 
-        if (dataFrame.tgtHWAddr == 0U) {
-            uint32_t dstLlId = getLLIdAddress(dataFrame.tgtProtoAddr);
-            if (dstLlId == 0U)
-                return;
+    // transmit queued data frames; every SU that is ready receives its oldest queued frame, frames
+    // for SUs still waiting on an ARP reply or an acknowledgement stay queued in order
+    auto it = m_dataFrames.begin();
+    while (it != m_dataFrames.end()) {
+        VTUNDataFrame& dataFrame = *it;
 
-            dataFrame.tgtHWAddr = dstLlId;
+        if (dataFrame.tgtHWAddr == 0U) {
+            dataFrame.tgtHWAddr = getLLIdAddress(dataFrame.tgtProtoAddr);
+            if (dataFrame.tgtHWAddr == 0U) {
+                ++it;
+                continue;
+            }
         }
 
         // don't allow another packet to go out if we haven't acked the previous
         if (!m_readyForPkt[dataFrame.tgtHWAddr]) {
-            m_suNotReadyTimeout[dataFrame.tgtHWAddr].clock(ms);
-            if (m_suNotReadyTimeout[dataFrame.tgtHWAddr].isRunning() && m_suNotReadyTimeout[dataFrame.tgtHWAddr].hasExpired()) {
-                m_suNotReadyTimeout[dataFrame.tgtHWAddr].stop();
-                m_readyForPkt[dataFrame.tgtHWAddr] = true;
-            }
-
-            return;
+            ++it;
+            continue;
         }
 
         m_readyForPkt[dataFrame.tgtHWAddr] = false;
@@ -411,8 +451,7 @@ void P25PacketData::clock(uint32_t ms)
         rspHeader.calculateLength(dataFrame.pktLen);
         uint32_t pduLength = rspHeader.getPDULength();
 
-        UInt8Array __pduUserData = std::make_unique<uint8_t[]>(pduLength);
-        uint8_t* pduUserData = __pduUserData.get();
+        uint8_t pduUserData[P25_MAX_PDU_BLOCKS * P25_PDU_CONFIRMED_LENGTH_BYTES + 2U];
         ::memset(pduUserData, 0x00U, pduLength);
         ::memcpy(pduUserData + 4U, dataFrame.buffer, dataFrame.pktLen);
 #if DEBUG_P25_PDU_DATA
@@ -420,8 +459,8 @@ void P25PacketData::clock(uint32_t ms)
 #endif
         dispatchUserFrameToFNE(rspHeader, true, pduUserData);
 
-        delete[] dataFrame.buffer;
-        m_dataFrames.pop_front();
+        m_dataFramePool.push_back(dataFrame.buffer);
+        it = m_dataFrames.erase(it);
     }
 }
 
@@ -542,10 +581,13 @@ void P25PacketData::dispatch(uint32_t peerId)
 
         LogMessage(LOG_NET, "P25, PDU -> VTUN, IP Data, srcIp = %s, dstIp = %s, pktLen = %u, proto = %02X", srcIp, dstIp, pktLen, proto);
 
-        UInt8Array __ipFrame = std::make_unique<uint8_t[]>(pktLen);
-        uint8_t* ipFrame = __ipFrame.get();
-        ::memset(ipFrame, 0x00U, pktLen);
-        ::memcpy(ipFrame, status->pduUserData + dataPktOffset, pktLen);
+        if ((uint32_t)(pktLen + dataPktOffset) > status->pduUserDataLength) {
+            LogError(LOG_NET, P25_PDU_STR ", illegal IP packet length, pktLen = %u, len %u", pktLen, status->pduUserDataLength);
+            break;
+        }
+
+        // write the IP packet straight from the reassembled PDU user data
+        const uint8_t* ipFrame = status->pduUserData + dataPktOffset;
 #if DEBUG_P25_PDU_DATA
         Utils::dump(1U, "P25PacketData::dispatch() ipFrame", ipFrame, pktLen);
 #endif
@@ -648,6 +690,10 @@ void P25PacketData::dispatchUserFrameToFNE(p25::data::DataHeader& dataHeader, bo
         sendSeqNo = 0U;
     m_suSendSeq[srcId] = sendSeqNo;
 
+    // fragment and encode the PDU once, the same network messages are repeated to every peer
+    PDUMessages messages;
+    encodePDUUser(dataHeader, extendedAddress, pduUserData, messages);
+
     // repeat traffic to the connected peers
     if (m_network->m_peers.size() > 0U) {
         uint32_t i = 0U;
@@ -657,7 +703,7 @@ void P25PacketData::dispatchUserFrameToFNE(p25::data::DataHeader& dataHeader, bo
                 m_network->m_frameQueue->flushQueue();
             }
 
-            write_PDU_User(peer.first, nullptr, dataHeader, extendedAddress, pduUserData, true);
+            writePDUMessages(peer.first, nullptr, dataHeader, messages, true);
             if (m_network->m_debug) {
                 LogDebug(LOG_NET, "P25, dstPeer = %u, duid = $%02X, srcId = %u, dstId = %u", 
                     peer.first, DUID::PDU, srcId, dstId);
@@ -673,7 +719,7 @@ void P25PacketData::dispatchUserFrameToFNE(p25::data::DataHeader& dataHeader, bo
         for (auto peer : m_network->m_host->m_peerNetworks) {
             uint32_t dstPeerId = peer.second->getPeerId();
 
-            write_PDU_User(dstPeerId, peer.second, dataHeader, extendedAddress, pduUserData);
+            writePDUMessages(dstPeerId, peer.second, dataHeader, messages);
             if (m_network->m_debug) {
                 LogDebug(LOG_NET, "P25, dstPeer = %u, duid = $%02X, srcId = %u, dstId = %u", 
                     dstPeerId, DUID::PDU, srcId, dstId);
@@ -864,22 +910,30 @@ void P25PacketData::write_PDU_Ack_Response(uint8_t ackClass, uint8_t ackType, ui
 void P25PacketData::write_PDU_User(uint32_t peerId, network::PeerNetwork* peerNet, data::DataHeader& dataHeader,
     bool extendedAddress, uint8_t* pduUserData, bool queueOnly)
 {
-    uint32_t streamId = m_network->createStreamId();
+    PDUMessages messages;
+    encodePDUUser(dataHeader, extendedAddress, pduUserData, messages);
+    writePDUMessages(peerId, peerNet, dataHeader, messages, queueOnly);
+}
+
+/* Helper to fragment user data into P25 PDU blocks and encode them as network messages. */
+
+void P25PacketData::encodePDUUser(data::DataHeader& dataHeader, bool extendedAddress, uint8_t* pduUserData, PDUMessages& messages)
+{
     uint16_t pktSeq = 0U;
+    messages.count = 0U;
 
     uint8_t buffer[P25_PDU_FEC_LENGTH_BYTES];
     ::memset(buffer, 0x00U, P25_PDU_FEC_LENGTH_BYTES);
 
     uint32_t blocksToFollow = dataHeader.getBlocksToFollow();
-
-    LogMessage(LOG_NET, P25_PDU_STR ", OSP, peerId = %u, ack = %u, outbound = %u, fmt = $%02X, mfId = $%02X, sap = $%02X, fullMessage = %u, blocksToFollow = %u, padLength = %u, packetLength = %u, S = %u, n = %u, seqNo = %u, lastFragment = %u, hdrOffset = %u, llId = %u",
-        peerId, dataHeader.getAckNeeded(), dataHeader.getOutbound(), dataHeader.getFormat(), dataHeader.getMFId(), dataHeader.getSAP(), dataHeader.getFullMessage(),
-        dataHeader.getBlocksToFollow(), dataHeader.getPadLength(), dataHeader.getPacketLength(), dataHeader.getSynchronize(), dataHeader.getNs(), dataHeader.getFSN(), dataHeader.getLastFragment(),
-        dataHeader.getHeaderOffset(), dataHeader.getLLId());
+    if (blocksToFollow > P25_MAX_PDU_BLOCKS) {
+        LogError(LOG_NET, P25_PDU_STR ", OSP, too many PDU blocks, blocksToFollow = %u", blocksToFollow);
+        blocksToFollow = P25_MAX_PDU_BLOCKS;
+    }
 
     // generate the PDU header and 1/2 rate Trellis
     dataHeader.encode(buffer);
-    writeNetwork(peerId, peerNet, dataHeader, 0U, buffer, P25_PDU_FEC_LENGTH_BYTES, pktSeq, streamId, queueOnly);
+    addPDUMessage(messages, dataHeader, 0U, buffer, pktSeq);
 
     if (pduUserData == nullptr)
         return;
@@ -897,7 +951,7 @@ void P25PacketData::write_PDU_User(uint32_t peerId, network::PeerNetwork* peerNe
 
             ::memset(buffer, 0x00U, P25_PDU_FEC_LENGTH_BYTES);
             dataHeader.encodeExtAddr(buffer);
-            writeNetwork(peerId, peerNet, dataHeader, 1U, buffer, P25_PDU_FEC_LENGTH_BYTES, pktSeq, streamId, queueOnly);
+            addPDUMessage(messages, dataHeader, 1U, buffer, pktSeq);
             ++pktSeq;
 
             dataOffset += P25_PDU_HEADER_LENGTH_BYTES;
@@ -932,13 +986,13 @@ void P25PacketData::write_PDU_User(uint32_t peerId, network::PeerNetwork* peerNe
             dataBlock.setSerialNo(i);
             dataBlock.setData(pduUserData + dataOffset);
 
-            LogMessage(LOG_NET, P25_PDU_STR ", OSP, peerId = %u, block %u, fmt = $%02X, lastBlock = %u",
-                peerId, (dataHeader.getFormat() == PDUFormatType::CONFIRMED) ? dataBlock.getSerialNo() : i, dataBlock.getFormat(),
+            LogMessage(LOG_NET, P25_PDU_STR ", OSP, block %u, fmt = $%02X, lastBlock = %u",
+                (dataHeader.getFormat() == PDUFormatType::CONFIRMED) ? dataBlock.getSerialNo() : i, dataBlock.getFormat(),
                 dataBlock.getLastBlock());
 
             ::memset(buffer, 0x00U, P25_PDU_FEC_LENGTH_BYTES);
             dataBlock.encode(buffer);
-            writeNetwork(peerId, peerNet, dataHeader, networkBlock, buffer, P25_PDU_FEC_LENGTH_BYTES, (dataBlock.getLastBlock()) ? RTP_END_OF_CALL_SEQ : pktSeq, streamId);
+            addPDUMessage(messages, dataHeader, networkBlock, buffer, (dataBlock.getLastBlock()) ? RTP_END_OF_CALL_SEQ : pktSeq);
             ++pktSeq;
 
             dataOffset += (dataHeader.getFormat() == PDUFormatType::CONFIRMED) ? P25_PDU_CONFIRMED_DATA_LENGTH_BYTES : P25_PDU_UNCONFIRMED_LENGTH_BYTES;
@@ -948,23 +1002,38 @@ void P25PacketData::write_PDU_User(uint32_t peerId, network::PeerNetwork* peerNe
     }
 }
 
-/* Write data processed to the network. */
+/* Helper to append an encoded PDU block to the list of network messages. */
 
-bool P25PacketData::writeNetwork(uint32_t peerId, network::PeerNetwork* peerNet, const p25::data::DataHeader& dataHeader, const uint8_t currentBlock, 
-    const uint8_t *data, uint32_t len, uint16_t pktSeq, uint32_t streamId, bool queueOnly)
+void P25PacketData::addPDUMessage(PDUMessages& messages, const p25::data::DataHeader& dataHeader, const uint8_t currentBlock,
+    const uint8_t* data, uint16_t pktSeq)
 {
-    assert(data != nullptr);
+    assert(messages.count < PDUMessages::MAX_MESSAGES);
 
-    uint32_t messageLength = 0U;
-    UInt8Array message = m_network->createP25_PDUMessage(messageLength, dataHeader, currentBlock, data, len);
-    if (message == nullptr) {
-        return false;
-    }
+    uint8_t* message = messages.buffer + (messages.count * PDUMessages::MESSAGE_LENGTH);
+    messages.length[messages.count] = m_network->createP25_PDUMessage(message, dataHeader, currentBlock, data, P25_PDU_FEC_LENGTH_BYTES);
+    messages.pktSeq[messages.count] = pktSeq;
+    messages.count++;
+}
 
-    if (peerNet != nullptr) {
-        return peerNet->writeMaster({ NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, pktSeq, streamId);
-    } else {
-        return m_network->writePeer(peerId, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, pktSeq, streamId, false, true);
+/* Helper to write encoded PDU network messages to a peer. */
+
+void P25PacketData::writePDUMessages(uint32_t peerId, network::PeerNetwork* peerNet, const data::DataHeader& dataHeader,
+    const PDUMessages& messages, bool queueOnly)
+{
+    uint32_t streamId = m_network->createStreamId();
+
+    LogMessage(LOG_NET, P25_PDU_STR ", OSP, peerId = %u, ack = %u, outbound = %u, fmt = $%02X, mfId = $%02X, sap = $%02X, fullMessage = %u, blocksToFollow = %u, padLength = %u, packetLength = %u, S = %u, n = %u, seqNo = %u, lastFragment = %u, hdrOffset = %u, llId = %u",
+        peerId, dataHeader.getAckNeeded(), dataHeader.getOutbound(), dataHeader.getFormat(), dataHeader.getMFId(), dataHeader.getSAP(), dataHeader.getFullMessage(),
+        dataHeader.getBlocksToFollow(), dataHeader.getPadLength(), dataHeader.getPacketLength(), dataHeader.getSynchronize(), dataHeader.getNs(), dataHeader.getFSN(), dataHeader.getLastFragment(),
+        dataHeader.getHeaderOffset(), dataHeader.getLLId());
+
+    for (uint32_t i = 0U; i < messages.count; i++) {
+        const uint8_t* message = messages.buffer + (i * PDUMessages::MESSAGE_LENGTH);
+        if (peerNet != nullptr) {
+            peerNet->writeMaster({ NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, message, messages.length[i], messages.pktSeq[i], streamId);
+        } else {
+            m_network->writePeer(peerId, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, message, messages.length[i], messages.pktSeq[i], streamId, queueOnly, !queueOnly);
+        }
     }
 }
 
@@ -26,6 +26,7 @@
 #include "network/callhandler/TagP25Data.h"
 
 #include <deque>
+#include <vector>
 
 namespace network
 {
@@ -81,6 +82,12 @@ namespace network
                  */
                 void clock(uint32_t ms);
 
+                /**
+                 * @brief Helper to determine if there are data frames from the virtual IP network waiting to be sent.
+                 * @returns bool True, if there are queued data frames, otherwise false.
+                 */
+                bool hasQueuedFrames() const { return !m_dataFrames.empty(); }
+
             private:
                 FNENetwork* m_network;
                 TagP25Data *m_tag;
@@ -101,6 +108,21 @@ namespace network
                     uint16_t pktLen;
                 };
                 std::deque<VTUNDataFrame> m_dataFrames;
+                std::vector<uint8_t*> m_dataFramePool;
+
+                /**
+                 * @brief Represents a PDU packet encoded as network messages, ready to be written to any number of peers.
+                 */
+                class PDUMessages {
+                public:
+                    static const uint32_t MAX_MESSAGES = P25DEF::P25_MAX_PDU_BLOCKS + 2U;
+                    static const uint32_t MESSAGE_LENGTH = MSG_HDR_SIZE + P25DEF::P25_PDU_FEC_LENGTH_BYTES + PACKET_PAD;
+
+                    uint8_t buffer[MAX_MESSAGES * MESSAGE_LENGTH];
+                    uint32_t length[MAX_MESSAGES];
+                    uint16_t pktSeq[MAX_MESSAGES];
+                    uint32_t count;
+                };
 
                 /**
                  * @brief Represents the receive status of a call.
@@ -224,23 +246,39 @@ namespace network
                  * @param dataHeader Instance of a PDU data header.
                  * @param extendedAddress Flag indicating whether or not to extended addressing is in use.
                  * @param pduUserData Buffer containing user data to transmit.
+                 * @param queueOnly Flag indicating the messages are only queued (and flushed by the caller).
                  */
                 void write_PDU_User(uint32_t peerId, network::PeerNetwork* peerNet, p25::data::DataHeader& dataHeader,
                     bool extendedAddress, uint8_t* pduUserData, bool queueOnly = false);
 
                 /**
-                 * @brief Write data processed to the network.
-                 * @param peerId Peer ID.
-                 * @param peerNet Instance of PeerNetwork to use to send traffic.
+                 * @brief Helper to fragment user data into P25 PDU blocks and encode them as network messages.
+                 * @param dataHeader Instance of a PDU data header.
+                 * @param extendedAddress Flag indicating whether or not to extended addressing is in use.
+                 * @param pduUserData Buffer containing user data to transmit.
+                 * @param[out] messages Encoded PDU network messages.
+                 */
+                void encodePDUUser(p25::data::DataHeader& dataHeader, bool extendedAddress, uint8_t* pduUserData, PDUMessages& messages);
+                /**
+                 * @brief Helper to append an encoded PDU block to the list of network messages.
+                 * @param messages Encoded PDU network messages.
                  * @param dataHeader Instance of a PDU data header.
                  * @param currentBlock Current Block ID.
-                 * @param data Buffer containing block data.
-                 * @param len Length of buffer.
+                 * @param data Buffer containing the FEC encoded block.
                  * @param pktSeq RTP packet sequence.
-                 * @param streamId Stream ID.
                  */
-                bool writeNetwork(uint32_t peerId, network::PeerNetwork* peerNet, const p25::data::DataHeader& dataHeader, const uint8_t currentBlock, 
-                    const uint8_t* data, uint32_t len, uint16_t pktSeq, uint32_t streamId, bool queueOnly = false);
+                void addPDUMessage(PDUMessages& messages, const p25::data::DataHeader& dataHeader, const uint8_t currentBlock,
+                    const uint8_t* data, uint16_t pktSeq);
+                /**
+                 * @brief Helper to write encoded PDU network messages to a peer.
+                 * @param peerId Peer ID.
+                 * @param peerNet Instance of PeerNetwork to use to send traffic.
+                 * @param dataHeader Instance of a PDU data header.
+                 * @param messages Encoded PDU network messages.
+                 * @param queueOnly Flag indicating the messages are only queued (and flushed by the caller).
+                 */
+                void writePDUMessages(uint32_t peerId, network::PeerNetwork* peerNet, const p25::data::DataHeader& dataHeader,
+                    const PDUMessages& messages, bool queueOnly = false);
 
                 /**
                  * @brief Helper to determine if the logical link ID has an ARP entry.
@@ -13,6 +13,7 @@
 #include "Defines.h"
 #include "common/network/udp/Socket.h"
 #include "modem/port/ModemNullPort.h"
+#include "modem/port/ModemReplayPort.h"
 #include "modem/port/UARTPort.h"
 #include "modem/port/PseudoPTYPort.h"
 #include "modem/port/UDPPort.h"
@@ -602,6 +603,19 @@ bool Host::createModem()
         LogInfo("    UDP Port: %u", g_remotePort);
     }
 
+    // captured modem frames take the place of the configured modem port
+    if (m_modemReplay != nullptr) {
+        if (m_isModemDFSI || g_remoteModemMode) {
+            LogError(LOG_HOST, "Traffic replay is not supported for DFSI or remote modems!");
+            delete modemPort;
+            return false;
+        }
+
+        delete modemPort;
+        modemPort = new port::ModemReplayPort(m_modemReplay);
+        LogInfo("    Replay: %s", g_replayFile.c_str());
+    }
+
     if (!m_modemRemote) {
         LogInfo("    RX Invert: %s", rxInvert ? "yes" : "no");
         LogInfo("    TX Invert: %s", txInvert ? "yes" : "no");
@@ -670,6 +684,12 @@ bool Host::createModem()
             m_modem->setP25NAC(m_p25NAC);
     }
 
+    if (m_capture != nullptr) {
+        if (m_isModemDFSI)
+            LogWarning(LOG_HOST, "Traffic capture does not include DFSI modem frames.");
+        m_modem->setCapture(m_capture);
+    }
+
     if (m_modemRemote) {
         m_modem->setOpenHandler(MODEM_OC_PORT_HANDLER_BIND(Host::rmtPortModemOpen, this));
         m_modem->setCloseHandler(MODEM_OC_PORT_HANDLER_BIND(Host::rmtPortModemClose, this));
@@ -731,6 +751,12 @@ bool Host::createNetwork()
     bool saveLookup = networkConf["saveLookups"].as<bool>(false);
     bool debug = networkConf["debug"].as<bool>(false);
 
+    yaml::Node multicastConf = networkConf["multicast"];
+    bool multicast = multicastConf["enable"].as<bool>(false);
+    std::string multicastAddress = multicastConf["address"].as<std::string>("239.255.62.31");
+    uint16_t multicastPort = (uint16_t)multicastConf["port"].as<uint32_t>(62032U);
+    std::string multicastInterface = multicastConf["interface"].as<std::string>();
+
     m_allowStatusTransfer = allowStatusTransfer;
 
     bool encrypted = networkConf["encrypted"].as<bool>(false);
@@ -819,6 +845,11 @@ bool Host::createNetwork()
         LogInfo("    Save Network Lookups: %s", saveLookup ? "yes" : "no");
 
         LogInfo("    Encrypted: %s", encrypted ? "yes" : "no");
+        LogInfo("    Multicast Group: %s", multicast ? "yes" : "no");
+        if (multicast) {
+            LogInfo("    Multicast Group Address: %s:%u", multicastAddress.c_str(), multicastPort);
+            LogInfo("    Multicast Group Interface: %s", multicastInterface.empty() ? "any" : multicastInterface.c_str());
+        }
 
         if (debug) {
             LogInfo("    Debug: yes");
@@ -857,10 +888,22 @@ bool Host::createNetwork()
             }
         }
 
+        if (multicast) {
+            m_network->setMulticast(multicastAddress, multicastPort, multicastInterface);
+        }
+
         if (encrypted) {
             m_network->setPresharedKey(presharedKey);
         }
 
+        if (m_capture != nullptr) {
+            m_network->getFrameQueue()->setCapture(m_capture);
+        }
+
+        if (m_networkReplay != nullptr) {
+            m_network->getFrameQueue()->setReplay(m_networkReplay);
+        }
+
         m_network->enable(true);
         bool ret = m_network->open();
         if (!ret) {
@@ -67,6 +67,9 @@ Host::Host(const std::string& confFile) :
     m_udpDSFIRemotePort(nullptr),
     m_network(nullptr),
     m_modemRemotePort(nullptr),
+    m_capture(nullptr),
+    m_modemReplay(nullptr),
+    m_networkReplay(nullptr),
     m_state(STATE_IDLE),
     m_isTxCW(false),
     m_modeTimer(1000U),
@@ -247,6 +250,25 @@ int Host::run()
     if (!ret)
         return EXIT_FAILURE;
 
+    // initialize traffic capture (or replay); both replays are opened together so their real-time
+    // replay stays aligned
+    if (!g_captureFile.empty()) {
+        m_capture = new CaptureWriter();
+        if (!m_capture->open(g_captureFile))
+            return EXIT_FAILURE;
+
+        LogInfo("Capturing modem and network traffic to %s", g_captureFile.c_str());
+    }
+
+    if (!g_replayFile.empty()) {
+        m_modemReplay = new CaptureReader(CaptureRecordType::MODEM, g_replayRealtime);
+        m_networkReplay = new CaptureReader(CaptureRecordType::NETWORK, g_replayRealtime);
+        if (!m_modemReplay->open(g_replayFile) || !m_networkReplay->open(g_replayFile))
+            return EXIT_FAILURE;
+
+        LogInfo("Replaying modem and network traffic from %s (%s)", g_replayFile.c_str(), g_replayRealtime ? "real-time" : "maximum speed");
+    }
+
     // initialize modem
     ret = createModem();
     if (!ret)
@@ -1591,6 +1613,18 @@ void Host::setState(uint8_t state)
                     delete m_RESTAPI;
                 }
 
+                if (m_capture != nullptr) {
+                    m_capture->close();
+                    delete m_capture;
+                }
+
+                if (m_modemReplay != nullptr) {
+                    delete m_modemReplay;
+                }
+                if (m_networkReplay != nullptr) {
+                    delete m_networkReplay;
+                }
+
                 if (m_channelLookup != nullptr) {
                     delete m_channelLookup;
                 }
@@ -1928,6 +1962,9 @@ void* Host::threadSiteData(void* arg)
             if (host->m_nxdn != nullptr)
                 host->m_nxdn->clockSiteData(ms);
 
+            if (host->m_RESTAPI != nullptr)
+                host->m_RESTAPI->clock(ms);
+
             if (host->m_allowStatusTransfer && host->m_network != nullptr) {
                 networkPeerStatusNotify.clock(ms);
                 if (networkPeerStatusNotify.isRunning() && networkPeerStatusNotify.hasExpired()) {
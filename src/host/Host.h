@@ -26,6 +26,7 @@
 #define __HOST_H__
 
 #include "Defines.h"
+#include "common/CaptureFile.h"
 #include "common/Timer.h"
 #include "common/lookups/AffiliationLookup.h"
 #include "common/lookups/ChannelLookup.h"
@@ -104,6 +105,10 @@ private:
 
     modem::port::IModemPort* m_modemRemotePort;
 
+    CaptureWriter* m_capture;
+    CaptureReader* m_modemReplay;
+    CaptureReader* m_networkReplay;
+
     uint8_t m_state;
 
     bool m_isTxCW;
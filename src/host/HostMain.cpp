@@ -60,6 +60,10 @@ uint8_t* g_gitHashBytes = nullptr;
 
 bool g_modemDebug = false;
 
+std::string g_captureFile = std::string();
+std::string g_replayFile = std::string();
+bool g_replayRealtime = true;
+
 // ---------------------------------------------------------------------------
 //  Global Functions
 // ---------------------------------------------------------------------------
@@ -115,6 +119,8 @@ void usage(const char* message, const char* arg)
 #endif
         "[-c <configuration file>]"
         "[--remote [-a <address>] [-p <port>]]"
+        "[--capture <file>]"
+        "[--replay <file> [--replay-max]]"
         "\n\n"
         "  -v        show version information\n"
         "  -h        show this screen\n"
@@ -135,6 +141,10 @@ void usage(const char* message, const char* arg)
         "  -a        remote modem command address\n"
         "  -p        remote modem command port\n"
         "\n"
+        "  --capture <file>  capture modem and network traffic to a file\n"
+        "  --replay <file>   replay captured modem and network traffic (instead of the modem and network)\n"
+        "  --replay-max      replay captured traffic at maximum speed, instead of real-time\n"
+        "\n"
         "  --        stop handling options\n",
         g_progExe.c_str());
     exit(EXIT_FAILURE);
@@ -212,6 +222,29 @@ int checkArgs(int argc, char* argv[])
 
             p += 2;
         }
+        else if (IS("--capture")) {
+            if (argc-- <= 0)
+                usage("error: %s", "must specify the capture file to write");
+            g_captureFile = std::string(argv[++i]);
+
+            if (g_captureFile.empty())
+                usage("error: %s", "capture file cannot be blank!");
+
+            p += 2;
+        }
+        else if (IS("--replay")) {
+            if (argc-- <= 0)
+                usage("error: %s", "must specify the capture file to replay");
+            g_replayFile = std::string(argv[++i]);
+
+            if (g_replayFile.empty())
+                usage("error: %s", "replay file cannot be blank!");
+
+            p += 2;
+        }
+        else if (IS("--replay-max")) {
+            g_replayRealtime = false;
+        }
         else if (IS("-v")) {
             ::fprintf(stdout, __PROG_NAME__ " %s (built %s)\r\n", __VER__, __BUILD__);
             ::fprintf(stdout, "Copyright (c) 2017-2024 Bryan Biedenkapp, N2PLL and DVMProject (https://github.com/dvmproject) Authors.\n");
@@ -229,6 +262,10 @@ int checkArgs(int argc, char* argv[])
         }
     }
 
+    if (!g_captureFile.empty() && !g_replayFile.empty()) {
+        usage("error: %s", "cannot capture and replay traffic at the same time");
+    }
+
     if (p < 0 || p > argc) {
         p = 0;
     }
@@ -65,6 +65,13 @@ extern uint8_t* g_gitHashBytes;
 /** @brief (Global) Modem debug flag. Forces modem debug regardless of configuration settings. */
 extern bool g_modemDebug;
 
+/** @brief (Global) Full path to the file modem and network traffic is captured to. */
+extern std::string g_captureFile;
+/** @brief (Global) Full path to the file modem and network traffic is replayed from. */
+extern std::string g_replayFile;
+/** @brief (Global) Flag indicating captured traffic is replayed in real-time (otherwise at maximum speed). */
+extern bool g_replayRealtime;
+
 /**
  * @brief Helper to trigger a fatal error message. This will cause the program to terminate 
  * immediately with an error message.
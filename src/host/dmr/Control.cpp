@@ -576,6 +576,23 @@ bool Control::isBusy() const
         (m_slot2->m_rfState != RS_RF_LISTENING || m_slot2->m_netState != RS_NET_IDLE);
 }
 
+/* Flag indicating whether the given slot is busy or not. */
+
+bool Control::isBusy(uint32_t slotNo) const
+{
+    switch (slotNo) {
+    case 1U:
+        return m_slot1->m_rfState != RS_RF_LISTENING || m_slot1->m_netState != RS_NET_IDLE;
+    case 2U:
+        return m_slot2->m_rfState != RS_RF_LISTENING || m_slot2->m_netState != RS_NET_IDLE;
+    default:
+        LogError(LOG_DMR, "DMR, invalid slot, slotNo = %u", slotNo);
+        break;
+    }
+
+    return false;
+}
+
 /* Helper to change the debug and verbose state. */
 
 void Control::setDebugVerbose(bool debug, bool verbose)
@@ -628,6 +645,28 @@ uint32_t Control::getLastSrcId(uint32_t slotNo) const
     return 0U;
 }
 
+/* Helper to get the signal quality of the current RF transmission. */
+
+bool Control::getRFSignal(uint32_t slotNo, uint8_t& rssi, float& ber) const
+{
+    Slot* slot = nullptr;
+    switch (slotNo) {
+    case 1U:
+        slot = m_slot1;
+        break;
+    case 2U:
+        slot = m_slot2;
+        break;
+    default:
+        LogError(LOG_DMR, "DMR, invalid slot, slotNo = %u", slotNo);
+        return false;
+    }
+
+    rssi = slot->m_rssi;
+    ber = (slot->m_rfBits > 0U) ? float(slot->m_rfErrs * 100U) / float(slot->m_rfBits) : 0.0F;
+    return slot->m_rfState != RS_RF_LISTENING;
+}
+
 // ---------------------------------------------------------------------------
 //  Private Class Members
 // ---------------------------------------------------------------------------
@@ -253,6 +253,12 @@ namespace dmr
          * @returns bool True, if processor is busy, otherwise false.
          */
         bool isBusy() const;
+        /**
+         * @brief Flag indicating whether the given slot is busy or not.
+         * @param slotNo DMR slot number.
+         * @returns bool True, if the slot is busy, otherwise false.
+         */
+        bool isBusy(uint32_t slotNo) const;
 
         /**
          * @brief Flag indicating whether DMR debug is enabled or not.
@@ -293,6 +299,14 @@ namespace dmr
          * @returns uint32_t Last transmitted source radio ID.
          */
         uint32_t getLastSrcId(uint32_t slotNo) const;
+        /**
+         * @brief Helper to get the signal quality of the current RF transmission.
+         * @param slotNo DMR slot number.
+         * @param[out] rssi Last reported RSSI (dBm, reported as positive; 0 if the modem does not report RSSI).
+         * @param[out] ber Bit error rate of the transmission so far (percentage).
+         * @returns bool True, if there is an RF transmission in progress, otherwise false.
+         */
+        bool getRFSignal(uint32_t slotNo, uint8_t& rssi, float& ber) const;
 
     private:
         friend class Slot;
@@ -80,6 +80,8 @@ bool Slot::m_verifyReg = false;
 uint8_t Slot::m_alohaNRandWait = DEFAULT_NRAND_WAIT;
 uint8_t Slot::m_alohaBackOff = 1U;
 
+uint32_t Slot::m_tsccBcastGeneration = 0U;
+
 // ---------------------------------------------------------------------------
 //  Constants
 // ---------------------------------------------------------------------------
@@ -994,6 +996,9 @@ void Slot::setSiteData(::lookups::VoiceChData controlChData, uint32_t netId, uin
     m_controlChData = controlChData;
 
     lc::CSBK::setSiteData(m_siteData);
+
+    // site data has changed, regenerate any cached TSCC broadcasts
+    m_tsccBcastGeneration++;
 }
 
 /* Sets TSCC Aloha configuration. */
@@ -1002,6 +1007,8 @@ void Slot::setAlohaConfig(uint8_t nRandWait, uint8_t backOff)
 {
     m_alohaNRandWait = nRandWait;
     m_alohaBackOff = backOff;
+
+    m_tsccBcastGeneration++;
 }
 
 // ---------------------------------------------------------------------------
@@ -458,6 +458,8 @@ namespace dmr
         static uint8_t m_alohaNRandWait;
         static uint8_t m_alohaBackOff;
 
+        static uint32_t m_tsccBcastGeneration;
+
         /**
          * @brief Add data frame to the data ring buffer.
          * @param data Frame data to add to Tx queue.
@@ -83,6 +83,10 @@ bool DMRAffiliationLookup::grantChSlot(uint32_t dstId, uint32_t srcId, uint8_t s
             m_name.c_str(), chNo, slot, dstId, grp);
     }
 
+    if (m_change != nullptr) {
+        m_change(::lookups::AFF_CHANGE::GRANT, srcId, dstId, chNo);
+    }
+
     return true;
 }
 
@@ -126,6 +130,10 @@ bool DMRAffiliationLookup::releaseGrant(uint32_t dstId, bool releaseAll)
             m_releaseGrant(chNo, dstId, slot);
         }
 
+        if (m_change != nullptr) {
+            m_change(::lookups::AFF_CHANGE::RELEASE, m_grantSrcIdTable[dstId], dstId, chNo);
+        }
+
         m_grantChTable.erase(dstId);
         m_grantSrcIdTable.erase(dstId);
         m_grantChSlotTable.erase(dstId);
@@ -118,6 +118,12 @@ using namespace dmr::packet;
 const uint32_t ADJ_SITE_UPDATE_CNT = 5U;
 const uint32_t GRANT_TIMER_TIMEOUT = 15U;
 
+const ulong64_t TSCC_BCAST_SYS_PARM = 1U;
+const ulong64_t TSCC_BCAST_ALOHA = 2U;
+const ulong64_t TSCC_BCAST_GIT_HASH = 3U;
+const ulong64_t TSCC_BCAST_ANN_WD = 4U;
+const uint32_t TSCC_BCAST_CACHE_MAX = 64U;
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -686,6 +692,8 @@ void ControlSignaling::writeRF_Call_Alrt(uint32_t srcId, uint32_t dstId)
 
 ControlSignaling::ControlSignaling(Slot * slot, network::BaseNetwork * network, bool dumpCSBKData, bool debug, bool verbose) :
     m_slot(slot),
+    m_tsccBcastCache(),
+    m_tsccBcastGeneration(0U),
     m_dumpCSBKData(dumpCSBKData),
     m_verbose(verbose),
     m_debug(debug)
@@ -737,6 +745,69 @@ void ControlSignaling::writeRF_CSBK(lc::CSBK* csbk, bool imm)
         m_slot->addFrame(data, false, imm);
 }
 
+/* Helper to write a cached TSCC broadcast CSBK packet. */
+
+bool ControlSignaling::writeRF_TSCC_Bcast_Cached(ulong64_t key)
+{
+    // site data or Aloha configuration has changed, regenerate the TSCC broadcasts
+    if (m_tsccBcastGeneration != Slot::m_tsccBcastGeneration) {
+        m_tsccBcastCache.clear();
+        m_tsccBcastGeneration = Slot::m_tsccBcastGeneration;
+        return false;
+    }
+
+    auto it = m_tsccBcastCache.find(key);
+    if (it == m_tsccBcastCache.end())
+        return false;
+
+    // don't add any frames if the queue is full
+    uint8_t len = DMR_FRAME_LENGTH_BYTES + 2U;
+    uint32_t space = m_slot->m_txQueue.freeSpace();
+    if (space < (len + 1U)) {
+        return true;
+    }
+
+    m_slot->m_rfSeqNo = 0U;
+
+    if (m_slot->m_duplex)
+        m_slot->addFrame(it->second.get());
+
+    return true;
+}
+
+/* Helper to write a TSCC broadcast CSBK packet, caching the encoded burst. */
+
+void ControlSignaling::writeRF_TSCC_Bcast_CSBK(lc::CSBK* csbk, ulong64_t key)
+{
+    uint8_t data[DMR_FRAME_LENGTH_BYTES + 2U];
+    ::memset(data + 2U, 0x00U, DMR_FRAME_LENGTH_BYTES);
+
+    SlotType slotType;
+    slotType.setColorCode(m_slot->m_colorCode);
+    slotType.setDataType(DataType::CSBK);
+
+    // Regenerate the CSBK data
+    csbk->encode(data + 2U);
+
+    // Regenerate the Slot Type
+    slotType.encode(data + 2U);
+
+    // Convert the Data Sync to be from the BS or MS as needed
+    Sync::addDMRDataSync(data + 2U, m_slot->m_duplex);
+
+    data[0U] = modem::TAG_DATA;
+    data[1U] = 0x00U;
+
+    if (m_tsccBcastCache.size() >= TSCC_BCAST_CACHE_MAX)
+        m_tsccBcastCache.clear();
+
+    UInt8Array cached = std::make_unique<uint8_t[]>(DMR_FRAME_LENGTH_BYTES + 2U);
+    ::memcpy(cached.get(), data, DMR_FRAME_LENGTH_BYTES + 2U);
+    m_tsccBcastCache[key] = std::move(cached);
+
+    writeRF_TSCC_Bcast_Cached(key);
+}
+
 /* Helper to write a network CSBK. */
 
 void ControlSignaling::writeNet_CSBK(lc::CSBK* csbk)
@@ -1437,12 +1508,15 @@ void ControlSignaling::writeRF_CSBK_Payload_Clear(uint32_t dstId, uint32_t srcId
 
 void ControlSignaling::writeRF_TSCC_Aloha()
 {
+    if (writeRF_TSCC_Bcast_Cached(TSCC_BCAST_ALOHA))
+        return;
+
     std::unique_ptr<CSBK_ALOHA> csbk = std::make_unique<CSBK_ALOHA>();
     DEBUG_LOG_CSBK(csbk->toString());
     csbk->setNRandWait(m_slot->m_alohaNRandWait);
     csbk->setBackoffNo(m_slot->m_alohaBackOff);
 
-    writeRF_CSBK(csbk.get());
+    writeRF_TSCC_Bcast_CSBK(csbk.get(), TSCC_BCAST_ALOHA);
 }
 
 /* Helper to write a TSCC Ann-Wd broadcast packet on the RF interface. */
@@ -1451,6 +1525,12 @@ void ControlSignaling::writeRF_TSCC_Bcast_Ann_Wd(uint32_t channelNo, bool annWd,
 {
     m_slot->m_rfSeqNo = 0U;
 
+    // the announcement is cached by its channel and site parameters
+    ulong64_t key = (TSCC_BCAST_ANN_WD << 32) + ((ulong64_t)(channelNo & 0xFFFU) << 18) + ((ulong64_t)(systemIdentity & 0xFFFFU) << 2) +
+        ((annWd) ? 2U : 0U) + ((requireReg) ? 1U : 0U);
+    if (writeRF_TSCC_Bcast_Cached(key))
+        return;
+
     std::unique_ptr<CSBK_BROADCAST> csbk = std::make_unique<CSBK_BROADCAST>();
     csbk->siteIdenEntry(m_slot->m_idenEntry);
     csbk->setCdef(false);
@@ -1465,26 +1545,32 @@ void ControlSignaling::writeRF_TSCC_Bcast_Ann_Wd(uint32_t channelNo, bool annWd,
             m_slot->m_slotNo, csbk->toString().c_str(), channelNo, annWd);
     }
 
-    writeRF_CSBK(csbk.get());
+    writeRF_TSCC_Bcast_CSBK(csbk.get(), key);
 }
 
 /* Helper to write a TSCC Sys_Parm broadcast packet on the RF interface. */
 
 void ControlSignaling::writeRF_TSCC_Bcast_Sys_Parm()
 {
+    if (writeRF_TSCC_Bcast_Cached(TSCC_BCAST_SYS_PARM))
+        return;
+
     std::unique_ptr<CSBK_BROADCAST> csbk = std::make_unique<CSBK_BROADCAST>();
     DEBUG_LOG_CSBK(csbk->toString());
     csbk->setAnncType(BroadcastAnncType::SITE_PARMS);
 
-    writeRF_CSBK(csbk.get());
+    writeRF_TSCC_Bcast_CSBK(csbk.get(), TSCC_BCAST_SYS_PARM);
 }
 
 /* Helper to write a TSCC Git Hash broadcast packet on the RF interface. */
 
 void ControlSignaling::writeRF_TSCC_Git_Hash()
 {
+    if (writeRF_TSCC_Bcast_Cached(TSCC_BCAST_GIT_HASH))
+        return;
+
     std::unique_ptr<CSBK_DVM_GIT_HASH> csbk = std::make_unique<CSBK_DVM_GIT_HASH>();
     DEBUG_LOG_CSBK(csbk->toString());
 
-    writeRF_CSBK(csbk.get());
+    writeRF_TSCC_Bcast_CSBK(csbk.get(), TSCC_BCAST_GIT_HASH);
 }
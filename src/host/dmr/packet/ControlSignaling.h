@@ -5,7 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2015,2016,2017 Jonathan Naylor, G4KLX
- *  Copyright (C) 2017-2022 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2017-2022,2024 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -28,6 +28,7 @@
 #include "common/Timer.h"
 #include "modem/Modem.h"
 
+#include <unordered_map>
 #include <vector>
 
 namespace dmr
@@ -88,6 +89,9 @@ namespace dmr
             friend class dmr::Slot;
             Slot* m_slot;
 
+            std::unordered_map<ulong64_t, UInt8Array> m_tsccBcastCache;
+            uint32_t m_tsccBcastGeneration;
+
             bool m_dumpCSBKData;
             bool m_verbose;
             bool m_debug;
@@ -126,6 +130,18 @@ namespace dmr
              * @param csbk CSBK to write to the network.
              */
             void writeNet_CSBK(lc::CSBK* csbk);
+            /**
+             * @brief Helper to write a cached TSCC broadcast CSBK packet.
+             * @param key TSCC broadcast cache key.
+             * @returns bool True, if the broadcast was cached and written, otherwise false.
+             */
+            bool writeRF_TSCC_Bcast_Cached(ulong64_t key);
+            /**
+             * @brief Helper to write a TSCC broadcast CSBK packet, caching the encoded burst.
+             * @param csbk CSBK to write to the modem.
+             * @param key TSCC broadcast cache key.
+             */
+            void writeRF_TSCC_Bcast_CSBK(lc::CSBK* csbk, ulong64_t key);
 
             /*
             ** Control Signalling Logic
@@ -132,6 +132,7 @@ Modem::Modem(port::IModemPort* port, bool duplex, bool rxInvert, bool txInvert,
     m_rspState(RESP_START),
     m_rspDoubleLength(false),
     m_rspType(CMD_GET_STATUS),
+    m_capture(nullptr),
     m_openPortHandler(nullptr),
     m_closePortHandler(nullptr),
     m_rspHandler(nullptr),
@@ -1695,6 +1696,8 @@ bool Modem::setDMRIgnoreCACH_AT(uint8_t slotNo)
 
 int Modem::write(const uint8_t* data, uint32_t length)
 {
+    // port writes may be partial and are continued, so writes from different threads must not interleave
+    std::lock_guard<std::mutex> lock(m_portWriteLock);
     return m_port->write(data, length);
 }
 
@@ -2080,7 +2083,7 @@ bool Modem::writeRFParams()
 
     buffer[1U] = lengthToWrite;
 
-    int ret = m_port->write(buffer, lengthToWrite);
+    int ret = Modem::write(buffer, lengthToWrite);
     if (ret <= 0)
         return false;
 
@@ -2486,6 +2489,9 @@ RESP_TYPE_DVM Modem::getResponse()
 
         if (m_debug && m_trace)
             Utils::dump(1U, "Modem getResponse()", m_buffer, m_length);
+
+        if (m_capture != nullptr)
+            m_capture->writeModem(m_buffer, m_length);
     }
 
     m_rspState = RESP_START;
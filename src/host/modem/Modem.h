@@ -27,6 +27,7 @@
 #define __MODEM_H__
 
 #include "Defines.h"
+#include "common/CaptureFile.h"
 #include "common/RingBuffer.h"
 #include "common/Timer.h"
 #include "modem/port/IModemPort.h"
@@ -401,6 +402,12 @@ namespace modem
          */
         void setFifoLength(uint16_t dmrLength, uint16_t p25Length, uint16_t nxdnLength);
 
+        /**
+         * @brief Sets the capture file that frames received from the modem are written to.
+         * @param capture Capture file writer (or nullptr to stop capturing).
+         */
+        void setCapture(CaptureWriter* capture) { m_capture = capture; }
+
         /**
          * @brief Sets a custom modem response handler.
          * If the response handler returns true, processing will stop, otherwise it will continue.
@@ -788,6 +795,8 @@ namespace modem
         bool m_rspDoubleLength;
         DVM_COMMANDS m_rspType;
 
+        CaptureWriter* m_capture;
+
         std::function<MODEM_OC_PORT_HANDLER> m_openPortHandler;
         std::function<MODEM_OC_PORT_HANDLER> m_closePortHandler;
         std::function<MODEM_RESP_HANDLER> m_rspHandler;
@@ -814,6 +823,7 @@ namespace modem
         std::mutex m_dmr2ReadLock;
         std::mutex m_p25ReadLock;
         std::mutex m_nxdnReadLock;
+        std::mutex m_portWriteLock;
 
         bool m_ignoreModemConfigArea;
         bool m_flashDisabled;
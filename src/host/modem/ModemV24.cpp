@@ -31,6 +31,68 @@ using namespace p25::dfsi::defines;
 using namespace p25::dfsi::frames;
 
 #include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <ctime>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define V24_TX_FRAME_BYTES 20U          // approximate size of a queued V.24 voice frame
+#define V24_TX_QUEUE_MIN_FRAMES 64U
+#define V24_TX_IDLE_WAIT_US 500U
+
+const uint32_t V24_TX_HIST_BOUNDS[V24_TX_HIST_BUCKETS] = { 100U, 250U, 500U, 1000U, 2000U, 5000U, 10000U, 0U };
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to get the current monotonic time in microseconds. */
+
+static uint64_t monotonicUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* Helper to suspend the current thread until the given monotonic time (in microseconds). */
+
+static void sleepUntilUs(uint64_t deadline)
+{
+#if defined(_WIN32)
+    uint64_t now = monotonicUs();
+    while (now < deadline) {
+        uint64_t remaining = deadline - now;
+        if (remaining >= 2000U)
+            Thread::sleep((uint32_t)(remaining / 1000U) - 1U);
+        else
+            Thread::sleep(0U, 1U);
+        now = monotonicUs();
+    }
+#else
+    // std::chrono::steady_clock is CLOCK_MONOTONIC, sleep against the absolute deadline so
+    // scheduling delays do not accumulate from frame to frame
+    struct timespec ts;
+    ts.tv_sec = (time_t)(deadline / 1000000U);
+    ts.tv_nsec = (long)((deadline % 1000000U) * 1000U);
+    while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+        ;
+#endif // defined(_WIN32)
+}
+
+// ---------------------------------------------------------------------------
+//  V24TxStats Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Gets the upper bound of the given histogram bucket. */
+
+uint32_t V24TxStats::bucketBound(uint32_t bucket)
+{
+    if (bucket >= V24_TX_HIST_BUCKETS)
+        return 0U;
+    return V24_TX_HIST_BOUNDS[bucket];
+}
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -46,7 +108,10 @@ ModemV24::ModemV24(port::IModemPort* port, bool duplex, uint32_t p25QueueSize, u
     m_diu(diu),
     m_audio(),
     m_nid(nullptr),
-    m_txP25Queue(p25TxQueueSize, "TX P25 Queue"),
+    m_txP25Queue(std::max(p25TxQueueSize / V24_TX_FRAME_BYTES, V24_TX_QUEUE_MIN_FRAMES), "TX P25 Queue"),
+    m_txStats(),
+    m_txThread(),
+    m_txThreadRunning(false),
     m_txCall(),
     m_rxCall(),
     m_txCallInProgress(false),
@@ -67,6 +132,8 @@ ModemV24::ModemV24(port::IModemPort* port, bool duplex, uint32_t p25QueueSize, u
 
 ModemV24::~ModemV24()
 {
+    stopTxPacing();
+
     delete m_nid;
     delete m_txCall;
     delete m_rxCall;
@@ -118,13 +185,18 @@ bool ModemV24::open()
             return false;
 
         m_error = false;
-        return true;
+        return startTxPacing();
     }
 
     m_statusTimer.start();
 
     m_error = false;
 
+    if (!startTxPacing()) {
+        m_port->close();
+        return false;
+    }
+
     LogMessage(LOG_MODEM, "Modem Ready [Direct Mode]");
     return true;
 }
@@ -368,14 +440,6 @@ void ModemV24::clock(uint32_t ms)
         reset();
     }
 
-    // write anything waiting to the serial port
-    int len = writeSerial();
-    if (m_debug && len > 0) {
-        LogDebug(LOG_MODEM, "Wrote %u-byte message to the serial V24 device", len);
-    } else if (len < 0) {
-        LogError(LOG_MODEM, "Failed to write to serial port!");
-    }
-
     // clear an RX call in progress flag if we're longer than our timeout value
     now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
     if (m_rxCallInProgress && (now - m_rxLastFrameTime > m_callTimeout)) {
@@ -390,6 +454,7 @@ void ModemV24::clock(uint32_t ms)
 void ModemV24::close()
 {
     LogDebug(LOG_MODEM, "Closing the modem");
+    stopTxPacing();
     m_port->close();
 
     m_gotModemStatus = false;
@@ -437,79 +502,119 @@ int ModemV24::write(const uint8_t* data, uint32_t length)
 //  Private Class Members
 // ---------------------------------------------------------------------------
 
-/* Helper to write data from the P25 Tx queue to the serial interface. */
+/* Entry point to the V.24 transmit pacing thread. */
 
-int ModemV24::writeSerial()
+void* ModemV24::threadTxPacing(void* arg)
 {
-    /*
-     *  Serial TX ringbuffer format:
-     * 
-     *  | 0x01 | 0x02 | 0x03 | 0x04 | 0x05 | 0x06 | 0x07 | 0x08 | 0x09 | 0x0A | 0x0B | 0x0C | ... |
-     *  |   Length    | Tag  |               int64_t timestamp in ms                 |   data     |
-     */
-
-    // check empty
-    if (m_txP25Queue.isEmpty())
-        return 0U;
+    thread_t* th = (thread_t*)arg;
+    if (th != nullptr) {
+        std::string threadName("v24:tx-pacing");
+        ModemV24* modem = static_cast<ModemV24*>(th->obj);
+        if (modem == nullptr) {
+            return nullptr;
+        }
 
-    // get length
-    uint8_t length[2U];
-    ::memset(length, 0x00U, 2U);
-    m_txP25Queue.peek(length, 2U);
+        LogDebug(LOG_HOST, "[ OK ] %s", threadName.c_str());
+#ifdef _GNU_SOURCE
+        ::pthread_setname_np(th->thread, threadName.c_str());
+#endif // _GNU_SOURCE
+
+        while (modem->m_txThreadRunning) {
+            int len = modem->writeSerial();
+            if (modem->m_debug && len > 0) {
+                LogDebug(LOG_MODEM, "Wrote %u-byte message to the serial V24 device", len);
+            } else if (len < 0) {
+                LogError(LOG_MODEM, "Failed to write to serial port!");
+            }
 
-    // convert length byets to int
-    uint16_t len = 0U;
-    len = (length[0U] << 8) + length[1U];
+            if (modem->m_txP25Queue.isEmpty())
+                Thread::sleep(0U, V24_TX_IDLE_WAIT_US);
+        }
 
-    // this ensures we never get in a situation where we have length & type bytes stuck in the queue by themselves
-    if (m_txP25Queue.dataSize() == 2U && len > m_txP25Queue.dataSize()) {
-        m_txP25Queue.get(length, 2U); // ensure we pop bytes off
-        return 0U;
+        LogDebug(LOG_HOST, "[STOP] %s", threadName.c_str());
     }
 
-    // get current timestamp
-    int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    return nullptr;
+}
 
-    // peek the timestamp to see if we should wait
-    if (m_txP25Queue.dataSize() >= 11U) {
-        uint8_t lengthTagTs[11U];
-        ::memset(lengthTagTs, 0x00U, 11U);
-        m_txP25Queue.peek(lengthTagTs, 11U);
+/* Helper to start the V.24 transmit pacing thread. */
 
-        // get the timestamp
-        int64_t ts;
-        assert(sizeof ts == 8);
-        ::memcpy(&ts, lengthTagTs + 3U, 8U);
+bool ModemV24::startTxPacing()
+{
+    if (m_txThreadRunning)
+        return true;
 
-        // if it's not time to send, return
-        if (ts > now) {
-            return 0U;
-        }
+    m_txThreadRunning = true;
+    if (!Thread::runAsThread(this, threadTxPacing, &m_txThread)) {
+        m_txThreadRunning = false;
+        LogError(LOG_MODEM, "Failed to start the V.24 transmit pacing thread");
+        return false;
     }
 
-    // check if we have enough data to get everything - len + 2U (length bytes) + 1U (tag) + 8U (timestamp)
-    if (m_txP25Queue.dataSize() >= len + 11U) {
-        // Get the length, tag and timestamp
-        uint8_t lengthTagTs[11U];
-        m_txP25Queue.get(lengthTagTs, 11U);
-        
-        // Get the actual data
-        UInt8Array __buffer = std::make_unique<uint8_t[]>(len);
-        uint8_t* buffer = __buffer.get();
-        m_txP25Queue.get(buffer, len);
-        
-        // Sanity check on data tag
-        uint8_t tag = lengthTagTs[2U];
-        if (tag != TAG_DATA) {
-            LogError(LOG_MODEM, "Got unexpected data tag from TX P25 ringbuffer! %02X", tag);
+    return true;
+}
+
+/* Helper to stop the V.24 transmit pacing thread. */
+
+void ModemV24::stopTxPacing()
+{
+    if (!m_txThreadRunning)
+        return;
+
+    m_txThreadRunning = false;
+#if defined(_WIN32)
+    ::WaitForSingleObject(m_txThread.thread, INFINITE);
+    ::CloseHandle(m_txThread.thread);
+#else
+    ::pthread_join(m_txThread.thread, NULL);
+#endif // defined(_WIN32)
+}
+
+/* Helper to write the next frame from the P25 Tx queue to the serial interface, once it is due. */
+
+int ModemV24::writeSerial()
+{
+    V24TxFrame* frame = m_txP25Queue.front();
+    if (frame == nullptr)
+        return 0U;
+
+    // wait out the frame deadline; the wait is bounded so a stop request is seen promptly
+    uint64_t now = monotonicUs();
+    if (frame->deadline > now) {
+        if (frame->deadline - now > V24_TX_IDLE_WAIT_US * 2U) {
+            sleepUntilUs(now + V24_TX_IDLE_WAIT_US * 2U);
             return 0U;
         }
 
-        // we already checked the timestamp above, so we just get the data and write it
-        return m_port->write(buffer, len);
+        sleepUntilUs(frame->deadline);
+    }
+
+    int ret = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_portWriteLock);
+        ret = m_port->write(frame->buffer.get(), frame->length);
     }
 
-    return 0U;
+    // record how late the frame went out
+    uint64_t sent = monotonicUs();
+    uint32_t errorUs = (sent > frame->deadline) ? (uint32_t)std::min(sent - frame->deadline, (uint64_t)UINT32_MAX) : 0U;
+
+    m_txStats.errorTotal += errorUs;
+    if (errorUs > m_txStats.errorMax)
+        m_txStats.errorMax = errorUs;
+
+    uint32_t bucket = 0U;
+    while (bucket < V24_TX_HIST_BUCKETS - 1U && errorUs >= V24_TX_HIST_BOUNDS[bucket])
+        bucket++;
+    m_txStats.hist[bucket]++;
+
+    if (ret < 0)
+        m_txStats.txErrors++;
+    else
+        m_txStats.txFrames++;
+
+    m_txP25Queue.pop();
+    return ret;
 }
 
 /* Helper to store converted Rx frames. */
@@ -1090,15 +1195,16 @@ void ModemV24::queueP25Frame(uint8_t* data, uint16_t len, SERIAL_TX_TYPE msgType
     if (m_trace)
         Utils::dump(1U, "ModemV24::queueP25Frame() data", data, len);
 
-    // get current time in ms
-    uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    // get current monotonic time in us
+    uint64_t now = monotonicUs();
+    uint64_t jitter = (uint64_t)m_jitter * 1000U;
 
-    // timestamp for this message (in ms)
+    // deadline for this message (in us)
     uint64_t msgTime = 0U;
 
-    // if this is our first message, timestamp is just now + the jitter buffer offset in ms
+    // if this is our first message, timestamp is just now + the jitter buffer offset
     if (m_lastP25Tx == 0U) {
-        msgTime = now + m_jitter;
+        msgTime = now + jitter;
 
         // if the message type requests no jitter delay -- just set the message time to now
         if (msgType == STT_NON_IMBE_NO_JITTER)
@@ -1107,53 +1213,44 @@ void ModemV24::queueP25Frame(uint8_t* data, uint16_t len, SERIAL_TX_TYPE msgType
     // if we had a message before this, calculate the new timestamp dynamically
     else {
         // if the last message occurred longer than our jitter buffer delay, we restart the sequence and calculate the same as above
-        if ((int64_t)(now - m_lastP25Tx) > m_jitter) {
-            msgTime = now + m_jitter;
+        if ((int64_t)(now - m_lastP25Tx) > (int64_t)jitter) {
+            msgTime = now + jitter;
         }
         // otherwise, we time out messages as required by the message type
         else {
             if (msgType == STT_IMBE) {
                 // IMBEs must go out at 20ms intervals
-                msgTime = m_lastP25Tx + 20U;
+                msgTime = m_lastP25Tx + 20000U;
             } else {
                 // Otherwise we don't care, we use 5ms since that's the theoretical minimum time a 9600 baud message can take
-                msgTime = m_lastP25Tx + 5U;
+                msgTime = m_lastP25Tx + 5000U;
             }
         }
     }
 
     len += 4U;
 
-    // convert 16-bit length to 2 bytes
-    uint8_t length[2U];
-    if (len > 255U)
-        length[0U] = (len >> 8U) & 0xFFU;
-    else
-        length[0U] = 0x00U;
-    length[1U] = len & 0xFFU;
-
-    m_txP25Queue.addData(length, 2U);
-
-    // add the data tag
-    uint8_t tag = TAG_DATA;
-    m_txP25Queue.addData(&tag, 1U);
-
-    // convert 64-bit timestamp to 8 bytes and add
-    uint8_t tsBytes[8U];
-    assert(sizeof msgTime == 8U);
-    ::memcpy(tsBytes, &msgTime, 8U);
-    m_txP25Queue.addData(tsBytes, 8U);
+    V24TxFrame frame;
+    frame.deadline = msgTime;
+    frame.length = len;
+    frame.buffer = std::make_unique<uint8_t[]>(len);
 
     // add the DVM start byte, length byte, CMD byte, and padding 0
-    uint8_t header[4U];
-    header[0U] = DVM_SHORT_FRAME_START;
-    header[1U] = len & 0xFFU;
-    header[2U] = CMD_P25_DATA;
-    header[3U] = 0x00U;
-    m_txP25Queue.addData(header, 4U);
+    uint8_t* buffer = frame.buffer.get();
+    buffer[0U] = DVM_SHORT_FRAME_START;
+    buffer[1U] = len & 0xFFU;
+    buffer[2U] = CMD_P25_DATA;
+    buffer[3U] = 0x00U;
 
     // add the data
-    m_txP25Queue.addData(data, len - 4U);
+    ::memcpy(buffer + 4U, data, len - 4U);
+
+    // hand the frame off to the transmit pacing thread
+    if (!m_txP25Queue.push(std::move(frame))) {
+        LogError(LOG_MODEM, "**** Overflow in %s, %u frames queued, dropping frame", m_txP25Queue.name(), m_txP25Queue.size());
+        m_txStats.txDropped++;
+        return;
+    }
 
     // update the last message time
     m_lastP25Tx = msgTime;
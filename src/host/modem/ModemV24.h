@@ -23,8 +23,12 @@
 #include "common/p25/lc/LC.h"
 #include "common/p25/Audio.h"
 #include "common/p25/NID.h"
+#include "common/SPSCQueue.h"
+#include "common/Thread.h"
 #include "modem/Modem.h"
 
+#include <atomic>
+
 namespace modem
 {
     // ---------------------------------------------------------------------------
@@ -47,8 +51,67 @@ namespace modem
         STT_IMBE                            //! IMBE Voice Frame
     };
 
+    /**
+     * @brief Number of buckets in the V.24 transmit timing error histogram.
+     * @ingroup modem
+     */
+    const uint32_t V24_TX_HIST_BUCKETS = 8U;
+
     /** @} */
 
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents a V.24 frame queued for transmission.
+     * @ingroup modem
+     */
+    struct V24TxFrame {
+        uint64_t deadline;                  //! Monotonic time (in us) the frame is due to be written.
+        uint16_t length;                    //! Length of the frame.
+        UInt8Array buffer;                  //! Frame data.
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents the transmit timing statistics of the V.24 modem.
+     * @ingroup modem
+     */
+    class HOST_SW_API V24TxStats {
+    public:
+        /**
+         * @brief Initializes a new instance of the V24TxStats class.
+         */
+        V24TxStats() :
+            txFrames(0U),
+            txDropped(0U),
+            txErrors(0U),
+            errorTotal(0U),
+            errorMax(0U)
+        {
+            for (uint32_t i = 0U; i < V24_TX_HIST_BUCKETS; i++)
+                hist[i] = 0U;
+        }
+
+        /**
+         * @brief Gets the upper bound of the given histogram bucket.
+         * @param bucket Histogram bucket.
+         * @returns uint32_t Upper bound (in us) of the bucket, or 0 if the bucket is unbounded.
+         */
+        static uint32_t bucketBound(uint32_t bucket);
+
+        std::atomic<uint64_t> txFrames;     //! Count of frames written to the V.24 port.
+        std::atomic<uint64_t> txDropped;    //! Count of frames dropped because the transmit queue was full.
+        std::atomic<uint64_t> txErrors;     //! Count of frames that failed to write to the V.24 port.
+        std::atomic<uint64_t> errorTotal;   //! Total timing error (in us) of the written frames.
+        std::atomic<uint32_t> errorMax;     //! Largest timing error (in us) of a written frame.
+        std::atomic<uint64_t> hist[V24_TX_HIST_BUCKETS]; //! Histogram of the timing error of the written frames.
+    };
+
     // ---------------------------------------------------------------------------
     //  Class Declaration
     // ---------------------------------------------------------------------------
@@ -292,6 +355,12 @@ namespace modem
          */
         int write(const uint8_t* data, uint32_t length) override;
 
+        /**
+         * @brief Gets the transmit timing statistics.
+         * @returns V24TxStats& Transmit timing statistics.
+         */
+        V24TxStats& txStats() { return m_txStats; }
+
     private:
         bool m_rtrt;
         bool m_diu;
@@ -300,7 +369,11 @@ namespace modem
 
         p25::NID* m_nid;
 
-        RingBuffer<uint8_t> m_txP25Queue;
+        SPSCQueue<V24TxFrame> m_txP25Queue;
+        V24TxStats m_txStats;
+
+        thread_t m_txThread;
+        std::atomic<bool> m_txThreadRunning;
 
         DFSICallData* m_txCall;
         DFSICallData* m_rxCall;
@@ -317,7 +390,22 @@ namespace modem
         edac::RS634717 m_rs;
 
         /**
-         * @brief Helper to write data from the P25 Tx queue to the serial interface.
+         * @brief Entry point to the V.24 transmit pacing thread.
+         * @param arg Instance of the thread_t structure.
+         * @returns void* (Ignore)
+         */
+        static void* threadTxPacing(void* arg);
+        /**
+         * @brief Helper to start the V.24 transmit pacing thread.
+         * @returns bool True, if the thread was started, otherwise false.
+         */
+        bool startTxPacing();
+        /**
+         * @brief Helper to stop the V.24 transmit pacing thread.
+         */
+        void stopTxPacing();
+        /**
+         * @brief Helper to write the next frame from the P25 Tx queue to the serial interface, once it is due.
          * @return int Actual number of bytes written to the serial interface.
          */
         int writeSerial();
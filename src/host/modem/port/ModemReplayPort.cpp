@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Modem Host Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "common/Log.h"
+#include "modem/port/ModemReplayPort.h"
+#include "modem/Modem.h"
+
+using namespace modem::port;
+using namespace modem;
+
+#include <cassert>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the ModemReplayPort class. */
+
+ModemReplayPort::ModemReplayPort(CaptureReader* replay) : ModemNullPort(),
+    m_replay(replay),
+    m_frame(nullptr),
+    m_frameLength(0U),
+    m_frameOffset(0U)
+{
+    assert(replay != nullptr);
+
+    m_frame = new uint8_t[CAPTURE_MAX_RECORD_LENGTH];
+}
+
+/* Finalizes a instance of the ModemReplayPort class. */
+
+ModemReplayPort::~ModemReplayPort()
+{
+    delete[] m_frame;
+}
+
+/* Reads data from the port. */
+
+int ModemReplayPort::read(uint8_t* buffer, uint32_t length)
+{
+    // finish the frame being replayed before anything else
+    if (m_frameOffset < m_frameLength) {
+        uint32_t n = m_frameLength - m_frameOffset;
+        if (length > n)
+            length = n;
+
+        ::memcpy(buffer, m_frame + m_frameOffset, length);
+        m_frameOffset += length;
+        return int(length);
+    }
+
+    // responses to commands written to the port
+    int ret = ModemNullPort::read(buffer, length);
+    if (ret > 0)
+        return ret;
+
+    // the next captured frame (if due), skipping captured command responses
+    while (true) {
+        uint32_t len = m_replay->read(m_frame);
+        if (len == 0U)
+            return 0;
+
+        // the frame length must agree with the length of the captured record
+        uint8_t cmd = 0U;
+        if (m_frame[0U] == DVM_LONG_FRAME_START) {
+            if (len < 4U || (uint32_t)((m_frame[1U] << 8) | m_frame[2U]) != len) {
+                LogWarning(LOG_MODEM, "Replayed modem frame is corrupt, len = %u", len);
+                continue;
+            }
+
+            cmd = m_frame[3U];
+        }
+        else if (m_frame[0U] == DVM_SHORT_FRAME_START) {
+            if (len < 3U || m_frame[1U] != len) {
+                LogWarning(LOG_MODEM, "Replayed modem frame is corrupt, len = %u", len);
+                continue;
+            }
+
+            cmd = m_frame[2U];
+        }
+        else {
+            LogWarning(LOG_MODEM, "Replayed modem frame is corrupt, len = %u", len);
+            continue;
+        }
+
+        switch (cmd) {
+        case CMD_GET_VERSION:
+        case CMD_GET_STATUS:
+        case CMD_ACK:
+        case CMD_NAK:
+        case CMD_FLSH_READ:
+            continue;
+        default:
+            break;
+        }
+
+        m_frameLength = len;
+        m_frameOffset = 0U;
+        break;
+    }
+
+    return read(buffer, length);
+}
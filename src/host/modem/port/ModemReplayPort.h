@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Modem Host Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file ModemReplayPort.h
+ * @ingroup port
+ * @file ModemReplayPort.cpp
+ * @ingroup port
+ */
+#if !defined(__MODEM_REPLAY_PORT_H__)
+#define __MODEM_REPLAY_PORT_H__
+
+#include "Defines.h"
+#include "common/CaptureFile.h"
+#include "modem/port/ModemNullPort.h"
+
+namespace modem
+{
+    namespace port
+    {
+        // ---------------------------------------------------------------------------
+        //  Class Declaration
+        // ---------------------------------------------------------------------------
+
+        /**
+         * @brief This class implements low-level routines that represent a modem port
+         *  replaying the modem frames of a capture file.
+         *
+         *  Commands written to the port are answered as the "null" modem port would; the
+         *  captured responses to commands are skipped, and all other captured frames are
+         *  replayed.
+         * @ingroup port
+         */
+        class HOST_SW_API ModemReplayPort : public ModemNullPort {
+        public:
+            /**
+             * @brief Initializes a new instance of the ModemReplayPort class.
+             * @param replay Capture file reader, replaying modem records.
+             */
+            ModemReplayPort(CaptureReader* replay);
+            /**
+             * @brief Finalizes a instance of the ModemReplayPort class.
+             */
+            ~ModemReplayPort() override;
+
+            /**
+             * @brief Reads data from the port.
+             * @param[out] buffer Buffer to read data from the port to.
+             * @param length Length of data to read from the port.
+             * @returns int Actual length of data read from serial port.
+             */
+            int read(uint8_t* buffer, uint32_t length) override;
+
+        private:
+            CaptureReader* m_replay;
+
+            uint8_t* m_frame;
+            uint32_t m_frameLength;
+            uint32_t m_frameOffset;
+        };
+    } // namespace port
+} // namespace modem
+
+#endif // __MODEM_REPLAY_PORT_H__
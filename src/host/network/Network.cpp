@@ -9,7 +9,9 @@
  *
  */
 #include "Defines.h"
+#include "common/edac/CRC.h"
 #include "common/edac/SHA256.h"
+#include "common/network/MulticastHeader.h"
 #include "common/network/RTPHeader.h"
 #include "common/network/RTPFNEHeader.h"
 #include "common/network/json/json.h"
@@ -28,6 +30,10 @@ using namespace network;
 // ---------------------------------------------------------------------------
 
 #define MAX_SERVER_DIFF 250ULL // maximum difference in time between a server timestamp and local timestamp in milliseconds
+#define MAX_MCAST_NAK_FRAMES 32U // maximum number of missed multicast group messages to request retransmission of
+#define MCAST_SEQ_RESYNC 1000U // multicast group sequence regression beyond which the group sequence is resynchronized
+#define RETRY_TIME 10U // time between login retries and stay-alive pings in seconds
+#define MAX_RETRY_BACKOFF 120U // maximum time between master login attempts in seconds
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -51,8 +57,10 @@ Network::Network(const std::string& address, uint16_t port, uint16_t localPort,
     m_ridLookup(nullptr),
     m_tidLookup(nullptr),
     m_salt(nullptr),
-    m_retryTimer(1000U, 10U),
+    m_sessionTicket(0U),
+    m_retryTimer(1000U, RETRY_TIME),
     m_timeoutTimer(1000U, 60U),
+    m_retryAttempts(0U),
     m_pktSeq(0U),
     m_loginStreamId(0U),
     m_identity(),
@@ -70,7 +78,14 @@ Network::Network(const std::string& address, uint16_t port, uint16_t localPort,
     m_restApiPassword(),
     m_restApiPort(0),
     m_conventional(false),
-    m_remotePeerId(0U)
+    m_remotePeerId(0U),
+    m_mcastAddress(),
+    m_mcastPort(0U),
+    m_mcastInterface(),
+    m_mcastSocket(nullptr),
+    m_mcastJoined(false),
+    m_mcastGroupId(0U),
+    m_mcastLastSeq(0U)
 {
     assert(!address.empty());
     assert(port > 0U);
@@ -91,6 +106,10 @@ Network::~Network()
 {
     delete[] m_salt;
     delete[] m_rxDMRStreamId;
+
+    if (m_mcastSocket != nullptr) {
+        delete m_mcastSocket;
+    }
 }
 
 /* Resets the DMR ring buffer for the given slot. */
@@ -161,11 +180,30 @@ void Network::setRESTAPIData(const std::string& password, uint16_t port)
     m_restApiPort = port;
 }
 
+/* Sets the multicast group to receive traffic from, for peers co-located with the FNE. */
+
+void Network::setMulticast(const std::string& address, uint16_t port, const std::string& iface)
+{
+    assert(!address.empty());
+    assert(port > 0U);
+
+    m_mcastAddress = address;
+    m_mcastPort = port;
+    m_mcastInterface = iface;
+
+    if (m_mcastSocket == nullptr) {
+        m_mcastSocket = new udp::Socket(port);
+    }
+}
+
 /* Sets endpoint preshared encryption key. */
 
 void Network::setPresharedKey(const uint8_t* presharedKey)
 {
     m_socket->setPresharedKey(presharedKey);
+    if (m_mcastSocket != nullptr) {
+        m_mcastSocket->setPresharedKey(presharedKey);
+    }
 }
 
 /* Updates the timer by the passed number of milliseconds. */
@@ -176,11 +214,13 @@ void Network::clock(uint32_t ms)
         m_retryTimer.clock(ms);
         if (m_retryTimer.isRunning() && m_retryTimer.hasExpired()) {
             if (m_enabled) {
-                bool ret = m_socket->open(m_addr.ss_family);
+                // a replaying network never opens its socket; the frames it writes are discarded, and
+                // the master responses are replayed
+                bool ret = m_frameQueue->isReplaying() || m_socket->open(m_addr.ss_family);
                 if (ret) {
                     ret = writeLogin();
                     if (!ret) {
-                        m_retryTimer.start();
+                        startRetryBackoff();
                         return;
                     }
 
@@ -189,7 +229,7 @@ void Network::clock(uint32_t ms)
                 }
             }
 
-            m_retryTimer.start();
+            startRetryBackoff();
         }
 
         return;
@@ -258,96 +298,7 @@ void Network::clock(uint32_t ms)
         // process incoming message frame opcodes
         switch (fneHeader.getFunction()) {
         case NET_FUNC::PROTOCOL:
-            {
-                if (fneHeader.getSubFunction() == NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR) {              // Encapsulated DMR data frame
-                    if (m_enabled && m_dmrEnabled) {
-                        uint32_t slotNo = (buffer[15U] & 0x80U) == 0x80U ? 2U : 1U;
-                        if (m_rxDMRStreamId[slotNo] == 0U) {
-                            m_rxDMRStreamId[slotNo] = streamId;
-                            m_pktLastSeq = m_pktSeq;
-                        }
-                        else {
-                            if (m_rxDMRStreamId[slotNo] == streamId) {
-                                if (m_pktSeq != 0U && m_pktLastSeq != 0U) {
-                                    if (m_pktSeq >= 1U && ((m_pktSeq != m_pktLastSeq + 1) && (m_pktSeq - 1 != m_pktLastSeq + 1))) {
-                                        LogWarning(LOG_NET, "DMR Stream %u out-of-sequence; %u != %u", streamId, m_pktSeq, m_pktLastSeq + 1);
-                                    }
-                                }
-        
-                                m_pktLastSeq = m_pktSeq;
-                            }
-                        }
-                       
-                        if (m_debug)
-                            Utils::dump(1U, "Network Received, DMR", buffer.get(), length);
-                        if (length > 255)
-                            LogError(LOG_NET, "DMR Stream %u, frame oversized? this shouldn't happen, pktSeq = %u, len = %u", streamId, m_pktSeq, length);
-
-                        uint8_t len = length;
-                        m_rxDMRData.addData(&len, 1U);
-                        m_rxDMRData.addData(buffer.get(), len);
-                    }
-                }
-                else if (fneHeader.getSubFunction() == NET_SUBFUNC::PROTOCOL_SUBFUNC_P25) {         // Encapsulated P25 data frame
-                    if (m_enabled && m_p25Enabled) {
-                        if (m_rxP25StreamId == 0U) {
-                            m_rxP25StreamId = streamId;
-                            m_pktLastSeq = m_pktSeq;
-                        }
-                        else {
-                            if (m_rxP25StreamId == streamId) {
-                                if (m_pktSeq != 0U && m_pktLastSeq != 0U) {
-                                    if (m_pktSeq >= 1U && ((m_pktSeq != m_pktLastSeq + 1) && (m_pktSeq - 1 != m_pktLastSeq + 1))) {
-                                        LogWarning(LOG_NET, "P25 Stream %u out-of-sequence; %u != %u", streamId, m_pktSeq, m_pktLastSeq + 1);
-                                    }
-                                }
-        
-                                m_pktLastSeq = m_pktSeq;
-                            }
-                        }
-
-                        if (m_debug)
-                            Utils::dump(1U, "Network Received, P25", buffer.get(), length);
-                        if (length > 255)
-                            LogError(LOG_NET, "P25 Stream %u, frame oversized? this shouldn't happen, pktSeq = %u, len = %u", streamId, m_pktSeq, length);
-
-                        uint8_t len = length;
-                        m_rxP25Data.addData(&len, 1U);
-                        m_rxP25Data.addData(buffer.get(), len);
-                    }
-                }
-                else if (fneHeader.getSubFunction() == NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN) {        // Encapsulated NXDN data frame
-                    if (m_enabled && m_nxdnEnabled) {
-                        if (m_rxNXDNStreamId == 0U) {
-                            m_rxNXDNStreamId = streamId;
-                            m_pktLastSeq = m_pktSeq;
-                        }
-                        else {
-                            if (m_rxNXDNStreamId == streamId) {
-                                if (m_pktSeq != 0U && m_pktLastSeq != 0U) {
-                                    if (m_pktSeq >= 1U && ((m_pktSeq != m_pktLastSeq + 1) && (m_pktSeq - 1 != m_pktLastSeq + 1))) {
-                                        LogWarning(LOG_NET, "NXDN Stream %u out-of-sequence; %u != %u", streamId, m_pktSeq, m_pktLastSeq + 1);
-                                    }
-                                }
-        
-                                m_pktLastSeq = m_pktSeq;
-                            }
-                        }
-
-                        if (m_debug)
-                            Utils::dump(1U, "Network Received, NXDN", buffer.get(), length);
-                        if (length > 255)
-                            LogError(LOG_NET, "NXDN Stream %u, frame oversized? this shouldn't happen, pktSeq = %u, len = %u", streamId, m_pktSeq, length);
-
-                        uint8_t len = length;
-                        m_rxNXDNData.addData(&len, 1U);
-                        m_rxNXDNData.addData(buffer.get(), len);
-                    }
-                }
-                else {
-                    Utils::dump("unknown protocol opcode from the master", buffer.get(), length);
-                }
-            }
+            processProtocol(fneHeader, buffer.get(), length);
             break;
 
         case NET_FUNC::MASTER:
@@ -509,6 +460,9 @@ void Network::clock(uint32_t ms)
                     case NET_CONN_NAK_FNE_MAX_CONN:
                         LogWarning(LOG_NET, "PEER %u master NAK; FNE has reached maximum permitted connections, remotePeerId = %u", m_peerId, rtpHeader.getSSRC());
                         break;
+                    case NET_CONN_NAK_FNE_BUSY:
+                        LogWarning(LOG_NET, "PEER %u master NAK; FNE is busy accepting logins, remotePeerId = %u", m_peerId, rtpHeader.getSSRC());
+                        break;
                     case NET_CONN_NAK_PEER_RESET:
                         LogWarning(LOG_NET, "PEER %u master NAK; FNE demanded connection reset, remotePeerId = %u", m_peerId, rtpHeader.getSSRC());
                         break;
@@ -525,11 +479,14 @@ void Network::clock(uint32_t ms)
                     }
                 }
 
-                if (m_status == NET_STAT_RUNNING || (reason == NET_CONN_NAK_FNE_MAX_CONN)) {
+                // any login session is abandoned, the next login performs the full configuration exchange
+                m_sessionTicket = 0U;
+
+                if (m_status == NET_STAT_RUNNING || (reason == NET_CONN_NAK_FNE_MAX_CONN) || (reason == NET_CONN_NAK_FNE_BUSY)) {
                     LogWarning(LOG_NET, "PEER %u master NAK; attemping to relogin, remotePeerId = %u", m_peerId, rtpHeader.getSSRC());
                     m_status = NET_STAT_WAITING_LOGIN;
                     m_timeoutTimer.start();
-                    m_retryTimer.start();
+                    startRetryBackoff();
                 }
                 else {
                     if (m_enabled) {
@@ -552,34 +509,28 @@ void Network::clock(uint32_t ms)
 
                         m_status = NET_STAT_WAITING_AUTHORISATION;
                         m_timeoutTimer.start();
-                        m_retryTimer.start();
+                        m_retryTimer.start(RETRY_TIME);
                         break;
                     case NET_STAT_WAITING_AUTHORISATION:
+                        // the master resumed the login session presented with the authorisation (the ACK carries
+                        // the same data as the RPTC ACK), the configuration exchange is skipped
+                        if (m_sessionTicket != 0U && length > 18 && (buffer[6U] & 0x20U) == 0x20U) {
+                            LogMessage(LOG_NET, "PEER %u RPTK ACK, resumed login session, logged into the master successfully, remotePeerId = %u", m_peerId, rtpHeader.getSSRC());
+                            loginCompleted(rtpHeader.getSSRC(), buffer.get(), length);
+                            break;
+                        }
+
                         LogDebug(LOG_NET, "PEER %u RPTK ACK, performing configuration exchange, remotePeerId = %u", m_peerId, rtpHeader.getSSRC());
 
                         writeConfig();
 
                         m_status = NET_STAT_WAITING_CONFIG;
                         m_timeoutTimer.start();
-                        m_retryTimer.start();
+                        m_retryTimer.start(RETRY_TIME);
                         break;
                     case NET_STAT_WAITING_CONFIG:
                         LogMessage(LOG_NET, "PEER %u RPTC ACK, logged into the master successfully, remotePeerId = %u", m_peerId, rtpHeader.getSSRC());
-                        m_loginStreamId = 0U;
-                        m_remotePeerId = rtpHeader.getSSRC();
-
-                        pktSeq(true);
-
-                        m_status = NET_STAT_RUNNING;
-                        m_timeoutTimer.start();
-                        m_retryTimer.start();
-
-                        if (length > 6) {
-                            m_useAlternatePortForDiagnostics = (buffer[6U] & 0x80U) == 0x80U;
-                            if (m_useAlternatePortForDiagnostics) {
-                                LogMessage(LOG_NET, "PEER %u RPTC ACK, master commanded alternate port for diagnostics and activity logging, remotePeerId = %u", m_peerId, rtpHeader.getSSRC());
-                            }
-                        }
+                        loginCompleted(rtpHeader.getSSRC(), buffer.get(), length);
                         break;
                     default:
                         break;
@@ -643,7 +594,16 @@ void Network::clock(uint32_t ms)
                 break;
         }
 
-        m_retryTimer.start();
+        if (m_status == NET_STAT_RUNNING)
+            m_retryTimer.start();
+        else
+            startRetryBackoff();
+    }
+
+    // read multicast group messages (until the socket is drained)
+    if (m_status == NET_STAT_RUNNING && m_mcastGroupId != 0U) {
+        while (readGroup())
+            ;
     }
 
     m_timeoutTimer.clock(ms);
@@ -654,6 +614,18 @@ void Network::clock(uint32_t ms)
     }
 }
 
+/* Helper to block until data is available from the master or the multicast group. */
+
+bool Network::wait(uint32_t timeout)
+{
+    std::vector<udp::Socket*> sockets;
+    sockets.push_back(m_socket);
+    if (m_mcastGroupId != 0U && m_mcastSocket != nullptr)
+        sockets.push_back(m_mcastSocket);
+
+    return udp::Socket::wait(sockets, (int)timeout);
+}
+
 /* Opens connection to the network. */
 
 bool Network::open()
@@ -670,7 +642,21 @@ bool Network::open()
 
     m_status = NET_STAT_WAITING_CONNECT;
     m_timeoutTimer.start();
-    m_retryTimer.start();
+    startRetryBackoff();
+
+    // join the multicast group (traffic is received by unicast if this fails)
+    m_mcastJoined = false;
+    m_mcastGroupId = 0U;
+    if (m_mcastSocket != nullptr && !m_frameQueue->isReplaying()) {
+        if (m_mcastSocket->open(AF_INET) && m_mcastSocket->joinMulticastGroup(m_mcastAddress, m_mcastInterface)) {
+            LogMessage(LOG_NET, "PEER %u joined multicast group %s:%u", m_peerId, m_mcastAddress.c_str(), m_mcastPort);
+            m_mcastJoined = true;
+        }
+        else {
+            LogError(LOG_NET, "PEER %u failed to join multicast group %s:%u, traffic will be received by unicast", m_peerId, m_mcastAddress.c_str(), m_mcastPort);
+            m_mcastSocket->close();
+        }
+    }
 
     return true;
 }
@@ -690,6 +676,12 @@ void Network::close()
     }
 
     m_socket->close();
+    if (m_mcastSocket != nullptr) {
+        m_mcastSocket->close();
+    }
+
+    m_mcastJoined = false;
+    m_mcastGroupId = 0U;
 
     m_retryTimer.stop();
     m_timeoutTimer.stop();
@@ -708,6 +700,273 @@ void Network::enable(bool enabled)
 //  Protected Class Members
 // ---------------------------------------------------------------------------
 
+/* Helper to process an encapsulated protocol message. */
+
+void Network::processProtocol(const frame::RTPFNEHeader& fneHeader, const uint8_t* buffer, int length)
+{
+    uint32_t streamId = fneHeader.getStreamId();
+
+    if (fneHeader.getSubFunction() == NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR) {              // Encapsulated DMR data frame
+        if (m_enabled && m_dmrEnabled) {
+            uint32_t slotNo = (buffer[15U] & 0x80U) == 0x80U ? 2U : 1U;
+            if (m_rxDMRStreamId[slotNo] == 0U) {
+                m_rxDMRStreamId[slotNo] = streamId;
+                m_pktLastSeq = m_pktSeq;
+            }
+            else {
+                if (m_rxDMRStreamId[slotNo] == streamId) {
+                    if (m_pktSeq != 0U && m_pktLastSeq != 0U) {
+                        if (m_pktSeq >= 1U && ((m_pktSeq != m_pktLastSeq + 1) && (m_pktSeq - 1 != m_pktLastSeq + 1))) {
+                            LogWarning(LOG_NET, "DMR Stream %u out-of-sequence; %u != %u", streamId, m_pktSeq, m_pktLastSeq + 1);
+                        }
+                    }
+        
+                    m_pktLastSeq = m_pktSeq;
+                }
+            }
+           
+            if (m_debug)
+                Utils::dump(1U, "Network Received, DMR", buffer, length);
+            if (length > 255)
+                LogError(LOG_NET, "DMR Stream %u, frame oversized? this shouldn't happen, pktSeq = %u, len = %u", streamId, m_pktSeq, length);
+
+            uint8_t len = length;
+            m_rxDMRData.addData(&len, 1U);
+            m_rxDMRData.addData(buffer, len);
+        }
+    }
+    else if (fneHeader.getSubFunction() == NET_SUBFUNC::PROTOCOL_SUBFUNC_P25) {         // Encapsulated P25 data frame
+        if (m_enabled && m_p25Enabled) {
+            if (m_rxP25StreamId == 0U) {
+                m_rxP25StreamId = streamId;
+                m_pktLastSeq = m_pktSeq;
+            }
+            else {
+                if (m_rxP25StreamId == streamId) {
+                    if (m_pktSeq != 0U && m_pktLastSeq != 0U) {
+                        if (m_pktSeq >= 1U && ((m_pktSeq != m_pktLastSeq + 1) && (m_pktSeq - 1 != m_pktLastSeq + 1))) {
+                            LogWarning(LOG_NET, "P25 Stream %u out-of-sequence; %u != %u", streamId, m_pktSeq, m_pktLastSeq + 1);
+                        }
+                    }
+        
+                    m_pktLastSeq = m_pktSeq;
+                }
+            }
+
+            if (m_debug)
+                Utils::dump(1U, "Network Received, P25", buffer, length);
+            if (length > 255)
+                LogError(LOG_NET, "P25 Stream %u, frame oversized? this shouldn't happen, pktSeq = %u, len = %u", streamId, m_pktSeq, length);
+
+            uint8_t len = length;
+            m_rxP25Data.addData(&len, 1U);
+            m_rxP25Data.addData(buffer, len);
+        }
+    }
+    else if (fneHeader.getSubFunction() == NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN) {        // Encapsulated NXDN data frame
+        if (m_enabled && m_nxdnEnabled) {
+            if (m_rxNXDNStreamId == 0U) {
+                m_rxNXDNStreamId = streamId;
+                m_pktLastSeq = m_pktSeq;
+            }
+            else {
+                if (m_rxNXDNStreamId == streamId) {
+                    if (m_pktSeq != 0U && m_pktLastSeq != 0U) {
+                        if (m_pktSeq >= 1U && ((m_pktSeq != m_pktLastSeq + 1) && (m_pktSeq - 1 != m_pktLastSeq + 1))) {
+                            LogWarning(LOG_NET, "NXDN Stream %u out-of-sequence; %u != %u", streamId, m_pktSeq, m_pktLastSeq + 1);
+                        }
+                    }
+        
+                    m_pktLastSeq = m_pktSeq;
+                }
+            }
+
+            if (m_debug)
+                Utils::dump(1U, "Network Received, NXDN", buffer, length);
+            if (length > 255)
+                LogError(LOG_NET, "NXDN Stream %u, frame oversized? this shouldn't happen, pktSeq = %u, len = %u", streamId, m_pktSeq, length);
+
+            uint8_t len = length;
+            m_rxNXDNData.addData(&len, 1U);
+            m_rxNXDNData.addData(buffer, len);
+        }
+    }
+    else {
+        Utils::dump("unknown protocol opcode from the master", buffer, length);
+    }
+}
+
+/* Helper to read and process a message from the multicast group. */
+
+bool Network::readGroup()
+{
+    const uint32_t headerLen = MULTICAST_HEADER_LENGTH_BYTES + RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES;
+
+    sockaddr_storage address;
+    uint32_t addrLen;
+
+    uint8_t buffer[DATA_PACKET_LENGTH];
+    int length = (int)m_mcastSocket->read(buffer, DATA_PACKET_LENGTH, address, addrLen);
+    if (length <= 0) {
+        return false;
+    }
+
+    if (m_debug)
+        Utils::dump(1U, "Network Received, Multicast Group", buffer, length);
+
+    if (length < (int)headerLen) {
+        LogError(LOG_NET, "Multicast group message received from network is malformed! %u bytes < %u bytes", length, headerLen);
+        return true;
+    }
+
+    frame::MulticastHeader groupHeader;
+    if (!groupHeader.decode(buffer)) {
+        LogError(LOG_NET, "Invalid multicast group message received from network");
+        return true;
+    }
+
+    if (groupHeader.getGroupId() != m_mcastGroupId) {
+        return true;
+    }
+
+    // check the group sequence, and request retransmission of any missed group messages
+    uint32_t groupSeq = groupHeader.getGroupSequence();
+    if (m_mcastLastSeq != 0U) {
+        if (groupSeq <= m_mcastLastSeq) {
+            if (m_mcastLastSeq - groupSeq < MCAST_SEQ_RESYNC) {
+                return true; // duplicate or late message
+            }
+
+            LogWarning(LOG_NET, "PEER %u multicast group %u sequence resynchronized; %u != %u", m_peerId, m_mcastGroupId, groupSeq, m_mcastLastSeq + 1U);
+        }
+        else if (groupSeq != m_mcastLastSeq + 1U) {
+            uint32_t firstMissed = m_mcastLastSeq + 1U;
+            uint32_t missed = groupSeq - firstMissed;
+            if (missed <= MAX_MCAST_NAK_FRAMES) {
+                uint8_t nak[10U];
+                __SET_UINT32(m_mcastGroupId, nak, 0U);                              // Group ID
+                __SET_UINT32(firstMissed, nak, 4U);                                 // First Missed Group Sequence
+                __SET_UINT16B(missed, nak, 8U);                                     // Missed Count
+
+                writeMaster({ NET_FUNC::MCAST_NAK, NET_SUBFUNC::NOP }, nak, 10U, RTP_END_OF_CALL_SEQ, createStreamId());
+            }
+            else {
+                LogWarning(LOG_NET, "PEER %u multicast group %u missed %u messages, too many to retransmit", m_peerId, m_mcastGroupId, missed);
+            }
+        }
+    }
+
+    m_mcastLastSeq = groupSeq;
+
+    // group messages are never repeated back to the peer they were received from
+    if (groupHeader.getSrcPeerId() == m_peerId) {
+        return true;
+    }
+
+    frame::RTPHeader rtpHeader;
+    if (!rtpHeader.decode(buffer + MULTICAST_HEADER_LENGTH_BYTES) || !rtpHeader.getExtension()) {
+        LogError(LOG_NET, "Invalid RTP header in multicast group message received from network");
+        return true;
+    }
+
+    frame::RTPFNEHeader fneHeader;
+    if (!fneHeader.decode(buffer + MULTICAST_HEADER_LENGTH_BYTES + RTP_HEADER_LENGTH_BYTES)) {
+        LogError(LOG_NET, "Invalid RTP FNE header in multicast group message received from network");
+        return true;
+    }
+
+    // ensure the RTP synchronization source ID matches the FNE peer ID
+    if (m_remotePeerId != 0U && rtpHeader.getSSRC() != m_remotePeerId) {
+        LogWarning(LOG_NET, "Multicast group RTP header and traffic session do not agree on remote peer ID? %u != %u", rtpHeader.getSSRC(), m_remotePeerId);
+        return true;
+    }
+
+    uint32_t messageLength = fneHeader.getMessageLength();
+    if (messageLength == 0U || messageLength > (uint32_t)length - headerLen) {
+        LogError(LOG_NET, "Multicast group message received from network is malformed! message length %u", messageLength);
+        return true;
+    }
+
+    const uint8_t* message = buffer + headerLen;
+    uint16_t calc = edac::CRC::createCRC16(message, messageLength * 8U);
+    if (calc != fneHeader.getCRC()) {
+        LogError(LOG_NET, "Multicast group message failed CRC CCITT-162 check");
+        return true;
+    }
+
+    if (fneHeader.getFunction() != NET_FUNC::PROTOCOL) {
+        Utils::dump("unknown opcode from the multicast group", message, messageLength);
+        return true;
+    }
+
+    m_pktSeq = rtpHeader.getSequence();
+    if (m_pktSeq == RTP_END_OF_CALL_SEQ) {
+        m_pktSeq = 0U;
+        m_pktLastSeq = 0U;
+    }
+
+    processProtocol(fneHeader, message, (int)messageLength);
+    return true;
+}
+
+/* Helper to complete the login to the master. */
+
+void Network::loginCompleted(uint32_t remotePeerId, const uint8_t* buffer, int length)
+{
+    m_loginStreamId = 0U;
+    m_remotePeerId = remotePeerId;
+
+    pktSeq(true);
+
+    m_status = NET_STAT_RUNNING;
+    m_timeoutTimer.start();
+    m_retryTimer.start(RETRY_TIME);
+    m_retryAttempts = 0U;
+
+    if (length > 6) {
+        m_useAlternatePortForDiagnostics = (buffer[6U] & 0x80U) == 0x80U;
+        if (m_useAlternatePortForDiagnostics) {
+            LogMessage(LOG_NET, "PEER %u RPTC ACK, master commanded alternate port for diagnostics and activity logging, remotePeerId = %u", m_peerId, remotePeerId);
+        }
+    }
+
+    m_mcastGroupId = 0U;
+    m_mcastLastSeq = 0U;
+    if (length > 10 && (buffer[6U] & 0x40U) == 0x40U && m_mcastJoined) {
+        m_mcastGroupId = __GET_UINT32(buffer, 7U);
+        LogMessage(LOG_NET, "PEER %u RPTC ACK, master commanded traffic from multicast group %u, remotePeerId = %u", m_peerId, m_mcastGroupId, remotePeerId);
+    }
+
+    // store the session ticket (if any) issued by the master, it is presented on the next login to resume
+    // the login session without repeating the configuration exchange
+    m_sessionTicket = 0U;
+    if (length > 18 && (buffer[6U] & 0x20U) == 0x20U) {
+        uint32_t ticketHi = __GET_UINT32(buffer, 11U);
+        uint32_t ticketLo = __GET_UINT32(buffer, 15U);
+        m_sessionTicket = ((uint64_t)ticketHi << 32) | ticketLo;
+    }
+}
+
+/* Helper to start the retry timer with a jittered exponential backoff. */
+
+void Network::startRetryBackoff()
+{
+    // the backoff window doubles for every failed attempt (up to the maximum) and the retry is scheduled
+    // at a random point in the later half of the window, this keeps peers dropped at the same instant (master
+    // restart, WAN outage) from logging back into the master in lockstep
+    uint32_t window = RETRY_TIME * 1000U;
+    for (uint32_t i = 0U; i < m_retryAttempts && window < MAX_RETRY_BACKOFF * 1000U; i++)
+        window *= 2U;
+    if (window > MAX_RETRY_BACKOFF * 1000U)
+        window = MAX_RETRY_BACKOFF * 1000U;
+
+    std::uniform_int_distribution<uint32_t> dist(window / 2U, window);
+    m_retryTimer.start(0U, dist(m_random));
+
+    if (m_retryAttempts < 32U)
+        m_retryAttempts++;
+}
+
 /* Writes login request to the network. */
 
 bool Network::writeLogin()
@@ -744,7 +1003,8 @@ bool Network::writeAuthorisation()
     for (size_t i = 0U; i < size; i++)
         in[i + sizeof(uint32_t)] = m_password.at(i);
 
-    uint8_t out[40U];
+    uint8_t out[52U];
+    ::memset(out, 0x00U, 52U);
     ::memcpy(out + 0U, TAG_REPEATER_AUTH, 4U);
     __SET_UINT32(m_peerId, out, 4U);                                                // Peer ID
 
@@ -753,10 +1013,23 @@ bool Network::writeAuthorisation()
 
     delete[] in;
 
+    // present the session ticket of the previous login (and the hash of the configuration that would be sent), the
+    // master may then resume the login session without the configuration exchange
+    uint32_t len = 40U;
+    if (m_sessionTicket != 0U) {
+        json::value v = json::value(createConfig());
+        std::string json = v.serialize();
+
+        __SET_UINT32((uint32_t)(m_sessionTicket >> 32), out, 40U);                  // Session Ticket
+        __SET_UINT32((uint32_t)(m_sessionTicket & 0xFFFFFFFFU), out, 44U);
+        __SET_UINT32(configHash((const uint8_t*)json.c_str(), (uint32_t)json.length()), out, 48U); // Configuration Hash
+        len = 52U;
+    }
+
     if (m_debug)
-        Utils::dump(1U, "Network Message, Authorisation", out, 40U);
+        Utils::dump(1U, "Network Message, Authorisation", out, len);
 
-    return writeMaster({ NET_FUNC::RPTK, NET_SUBFUNC::NOP }, out, 40U, pktSeq(), m_loginStreamId);
+    return writeMaster({ NET_FUNC::RPTK, NET_SUBFUNC::NOP }, out, len, pktSeq(), m_loginStreamId);
 }
 
 /* Writes modem configuration to the network. */
@@ -768,6 +1041,26 @@ bool Network::writeConfig()
         return false;
     }
 
+    json::value v = json::value(createConfig());
+    std::string json = v.serialize();
+
+    CharArray __buffer = std::make_unique<char[]>(json.length() + 9U);
+    char* buffer = __buffer.get();
+
+    ::memcpy(buffer + 0U, TAG_REPEATER_CONFIG, 4U);
+    ::snprintf(buffer + 8U, json.length() + 1U, "%s", json.c_str());
+
+    if (m_debug) {
+        Utils::dump(1U, "Network Message, Configuration", (uint8_t*)buffer, json.length() + 8U);
+    }
+
+    return writeMaster({ NET_FUNC::RPTC, NET_SUBFUNC::NOP }, (uint8_t*)buffer, json.length() + 8U, RTP_END_OF_CALL_SEQ, m_loginStreamId);
+}
+
+/* Helper to create the modem configuration sent to the network. */
+
+json::object Network::createConfig()
+{
     const char* software = __NETVER__;
 
     json::object config = json::object();
@@ -802,22 +1095,10 @@ bool Network::writeConfig()
     config["rcon"].set<json::object>(rcon);
 
     config["conventionalPeer"].set<bool>(m_conventional);                           // Conventional Peer Marker
+    config["multicast"].set<bool>(m_mcastJoined);                                   // Multicast Group Peer Marker
     config["software"].set<std::string>(std::string(software));                     // Software ID
 
-    json::value v = json::value(config);
-    std::string json = v.serialize();
-
-    CharArray __buffer = std::make_unique<char[]>(json.length() + 9U);
-    char* buffer = __buffer.get();
-
-    ::memcpy(buffer + 0U, TAG_REPEATER_CONFIG, 4U);
-    ::snprintf(buffer + 8U, json.length() + 1U, "%s", json.c_str());
-
-    if (m_debug) {
-        Utils::dump(1U, "Network Message, Configuration", (uint8_t*)buffer, json.length() + 8U);
-    }
-
-    return writeMaster({ NET_FUNC::RPTC, NET_SUBFUNC::NOP }, (uint8_t*)buffer, json.length() + 8U, RTP_END_OF_CALL_SEQ, m_loginStreamId);
+    return config;
 }
 
 /* Writes a network stay-alive ping. */
@@ -9,7 +9,7 @@
 * @license GPLv2 License (https://opensource.org/licenses/GPL-2.0)
 *
 *  Copyright (C) 2015,2016,2017,2018 Jonathan Naylor, G4KLX
-*  Copyright (C) 2017-2023 Bryan Biedenkapp, N2PLL
+*  Copyright (C) 2017-2024 Bryan Biedenkapp, N2PLL
 *
 */
 /**
@@ -118,6 +118,13 @@ namespace network
          * @param conv Flag indicating conventional operation.
          */
         void setConventional(bool conv) { m_conventional = conv; }
+        /**
+         * @brief Sets the multicast group to receive traffic from, for peers co-located with the FNE.
+         * @param address Multicast group address.
+         * @param port Multicast group port number.
+         * @param iface Address of the local interface to join the group on (blank for any).
+         */
+        void setMulticast(const std::string& address, uint16_t port, const std::string& iface);
         /**
          * @brief Sets endpoint preshared encryption key.
          * @param presharedKey Encryption preshared key for networking.
@@ -129,6 +136,12 @@ namespace network
          * @param ms Number of milliseconds.
          */
         void clock(uint32_t ms) override;
+        /**
+         * @brief Helper to block until data is available from the master or the multicast group.
+         * @param timeout Maximum time to wait (in ms).
+         * @returns bool True, if data is available to read, otherwise false.
+         */
+        bool wait(uint32_t timeout);
 
         /**
          * @brief Opens connection to the network.
@@ -177,9 +190,11 @@ namespace network
         lookups::TalkgroupRulesLookup* m_tidLookup;
 
         uint8_t* m_salt;
+        uint64_t m_sessionTicket;
 
         Timer m_retryTimer;
         Timer m_timeoutTimer;
+        uint32_t m_retryAttempts;
 
         uint32_t* m_rxDMRStreamId;
         uint32_t m_rxP25StreamId;
@@ -211,6 +226,39 @@ namespace network
 
         uint32_t m_remotePeerId;
 
+        std::string m_mcastAddress;
+        uint16_t m_mcastPort;
+        std::string m_mcastInterface;
+        udp::Socket* m_mcastSocket;
+        bool m_mcastJoined;
+        uint32_t m_mcastGroupId;
+        uint32_t m_mcastLastSeq;
+
+        /**
+         * @brief Helper to process an encapsulated protocol message.
+         * @param fneHeader RTP FNE Header.
+         * @param[in] buffer Buffer containing the message.
+         * @param length Length of the message.
+         */
+        void processProtocol(const frame::RTPFNEHeader& fneHeader, const uint8_t* buffer, int length);
+        /**
+         * @brief Helper to read and process a message from the multicast group.
+         * @returns bool True, if a message was read from the multicast group, otherwise false.
+         */
+        bool readGroup();
+
+        /**
+         * @brief Helper to complete the login to the master.
+         * @param remotePeerId Peer ID of the master.
+         * @param[in] buffer Buffer containing the login ACK.
+         * @param length Length of the buffer.
+         */
+        void loginCompleted(uint32_t remotePeerId, const uint8_t* buffer, int length);
+        /**
+         * @brief Helper to start the retry timer with a jittered exponential backoff.
+         */
+        void startRetryBackoff();
+
         /**
          * @brief Writes login request to the network.
          * @returns bool True, if login request was sent, otherwise false.
@@ -225,7 +273,12 @@ namespace network
          * @brief Writes modem configuration to the network.
          * @returns bool True, if configuration response was sent, otherwise false.
          */
-        virtual bool writeConfig();
+        bool writeConfig();
+        /**
+         * @brief Helper to create the modem configuration sent to the network.
+         * @returns json::object Modem configuration.
+         */
+        virtual json::object createConfig();
         /**
          * @brief Writes a network stay-alive ping.
          * @returns bool True, if stay-alive ping was sent, otherwise false.
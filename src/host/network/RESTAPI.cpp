@@ -11,12 +11,14 @@
 #include "common/edac/SHA256.h"
 #include "common/lookups/AffiliationLookup.h"
 #include "common/network/json/json.h"
+#include "common/Clock.h"
 #include "common/Log.h"
 #include "common/Utils.h"
 #include "dmr/Control.h"
 #include "p25/Control.h"
 #include "nxdn/Control.h"
 #include "modem/Modem.h"
+#include "modem/ModemV24.h"
 #include "network/RESTAPI.h"
 #include "Host.h"
 #include "HostMain.h"
@@ -25,6 +27,7 @@ using namespace network;
 using namespace network::rest;
 using namespace network::rest::http;
 using namespace modem;
+using namespace system_clock;
 
 #include <cstdio>
 #include <cstdlib>
@@ -41,6 +44,13 @@ using namespace modem;
 
 #define REST_API_BIND(funcAddr, classInstance) std::bind(&funcAddr, classInstance, std::placeholders::_1,  std::placeholders::_2, std::placeholders::_3)
 
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t EVENT_SIGNAL_INTERVAL = 1U;
+const uint32_t EVENT_KEEP_ALIVE_INTERVAL = 15U;
+
 // ---------------------------------------------------------------------------
 //  Global Functions
 // ---------------------------------------------------------------------------
@@ -155,7 +165,10 @@ RESTAPI::RESTAPI(const std::string& address, uint16_t port, const std::string& p
     m_nxdn(nullptr),
     m_ridLookup(nullptr),
     m_tidLookup(nullptr),
-    m_authTokens()
+    m_authTokens(),
+    m_events(),
+    m_signalTimer(1000U, EVENT_SIGNAL_INTERVAL),
+    m_keepAliveTimer(1000U, EVENT_KEEP_ALIVE_INTERVAL)
 {
     assert(!address.empty());
     assert(port > 0U);
@@ -212,6 +225,25 @@ void RESTAPI::setProtocols(dmr::Control* dmr, p25::Control* p25, nxdn::Control*
     m_dmr = dmr;
     m_p25 = p25;
     m_nxdn = nxdn;
+
+    // report registration, affiliation and grant changes to event stream subscribers
+    if (m_dmr != nullptr && m_dmr->affiliations() != nullptr) {
+        m_dmr->affiliations()->setChangeCallback([this](::lookups::AFF_CHANGE::ENUM change, uint32_t srcId, uint32_t dstId, uint32_t chNo) {
+            publishAffChange("dmr", change, srcId, dstId, chNo);
+        });
+    }
+
+    if (m_p25 != nullptr) {
+        m_p25->affiliations().setChangeCallback([this](::lookups::AFF_CHANGE::ENUM change, uint32_t srcId, uint32_t dstId, uint32_t chNo) {
+            publishAffChange("p25", change, srcId, dstId, chNo);
+        });
+    }
+
+    if (m_nxdn != nullptr) {
+        m_nxdn->affiliations().setChangeCallback([this](::lookups::AFF_CHANGE::ENUM change, uint32_t srcId, uint32_t dstId, uint32_t chNo) {
+            publishAffChange("nxdn", change, srcId, dstId, chNo);
+        });
+    }
 }
 
 /* Opens connection to the network. */
@@ -231,6 +263,9 @@ bool RESTAPI::open()
     }
 #endif // ENABLE_TCP_SSL
 
+    m_signalTimer.start();
+    m_keepAliveTimer.start();
+
     return run();
 }
 
@@ -238,6 +273,17 @@ bool RESTAPI::open()
 
 void RESTAPI::close()
 {
+    // the protocols outlive the REST API, stop them from reporting changes to it
+    if (m_dmr != nullptr && m_dmr->affiliations() != nullptr) {
+        m_dmr->affiliations()->setChangeCallback(nullptr);
+    }
+    if (m_p25 != nullptr) {
+        m_p25->affiliations().setChangeCallback(nullptr);
+    }
+    if (m_nxdn != nullptr) {
+        m_nxdn->affiliations().setChangeCallback(nullptr);
+    }
+
 #if defined(ENABLE_TCP_SSL)
     if (m_enableSSL) {
         m_restSecureServer.stop();
@@ -248,6 +294,62 @@ void RESTAPI::close()
     }
 #endif // ENABLE_TCP_SSL
     wait();
+
+    m_events.closeAll();
+}
+
+/* Updates the event stream by the passed number of milliseconds. */
+
+void RESTAPI::clock(uint32_t ms)
+{
+    m_keepAliveTimer.clock(ms);
+    if (m_keepAliveTimer.isRunning() && m_keepAliveTimer.hasExpired()) {
+        m_events.keepAlive();
+        m_keepAliveTimer.start();
+    }
+
+    // without subscribers forget the published call state, a new subscriber is then told about
+    // calls already in progress
+    if (!m_events.hasSubscribers()) {
+        for (CallState& call : m_calls) {
+            call = CallState();
+        }
+        return;
+    }
+
+    m_signalTimer.clock(ms);
+    bool sampleSignal = m_signalTimer.isRunning() && m_signalTimer.hasExpired();
+    if (sampleSignal) {
+        m_signalTimer.start();
+    }
+
+    uint8_t rssi = 0U;
+    float ber = 0.0F;
+    if (m_dmr != nullptr) {
+        for (uint32_t slotNo = 1U; slotNo <= 2U; slotNo++) {
+            CallState& call = m_calls[slotNo - 1U];
+            clockCall(call, "dmr", slotNo, m_dmr->isBusy(slotNo), m_dmr->getLastSrcId(slotNo), m_dmr->getLastDstId(slotNo));
+            if (sampleSignal && m_dmr->getRFSignal(slotNo, rssi, ber)) {
+                publishSignal(call, "dmr", slotNo, rssi, ber);
+            }
+        }
+    }
+
+    if (m_p25 != nullptr) {
+        CallState& call = m_calls[2U];
+        clockCall(call, "p25", 0U, m_p25->isBusy(), m_p25->getLastSrcId(), m_p25->getLastDstId());
+        if (sampleSignal && m_p25->getRFSignal(rssi, ber)) {
+            publishSignal(call, "p25", 0U, rssi, ber);
+        }
+    }
+
+    if (m_nxdn != nullptr) {
+        CallState& call = m_calls[3U];
+        clockCall(call, "nxdn", 0U, m_nxdn->isBusy(), m_nxdn->getLastSrcId(), m_nxdn->getLastDstId());
+        if (sampleSignal && m_nxdn->getRFSignal(rssi, ber)) {
+            publishSignal(call, "nxdn", 0U, rssi, ber);
+        }
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -278,9 +380,11 @@ void RESTAPI::initializeEndpoints()
     m_dispatcher.match(GET_VERSION).get(REST_API_BIND(RESTAPI::restAPI_GetVersion, this));
     m_dispatcher.match(GET_STATUS).get(REST_API_BIND(RESTAPI::restAPI_GetStatus, this));
     m_dispatcher.match(GET_VOICE_CH).get(REST_API_BIND(RESTAPI::restAPI_GetVoiceCh, this));
+    m_dispatcher.match(GET_EVENTS).get(REST_API_BIND(RESTAPI::restAPI_GetEvents, this));
 
     m_dispatcher.match(PUT_MDM_MODE).put(REST_API_BIND(RESTAPI::restAPI_PutModemMode, this));
     m_dispatcher.match(PUT_MDM_KILL).put(REST_API_BIND(RESTAPI::restAPI_PutModemKill, this));
+    m_dispatcher.match(GET_MDM_V24_STATS).get(REST_API_BIND(RESTAPI::restAPI_GetModemV24Stats, this));
 
     m_dispatcher.match(PUT_SET_SUPERVISOR).put(REST_API_BIND(RESTAPI::restAPI_PutSetSupervisor, this));
     m_dispatcher.match(PUT_PERMIT_TG).put(REST_API_BIND(RESTAPI::restAPI_PutPermitTG, this));
@@ -332,6 +436,83 @@ void RESTAPI::initializeEndpoints()
     m_dispatcher.match(GET_NXDN_AFFILIATIONS).get(REST_API_BIND(RESTAPI::restAPI_GetNXDNAffList, this));
 }
 
+/* Helper to publish call start and end events for a protocol (or DMR slot). */
+
+void RESTAPI::clockCall(CallState& call, const char* mode, uint32_t slotNo, bool busy, uint32_t srcId, uint32_t dstId)
+{
+    // a new call can follow directly on from the last one without the protocol going idle
+    if (call.active && (!busy || srcId != call.srcId || dstId != call.dstId)) {
+        json::object event = json::object();
+        event["mode"].set<std::string>(std::string(mode));
+        if (slotNo > 0U) {
+            event["slot"].set<uint32_t>(slotNo);
+        }
+        event["srcId"].set<uint32_t>(call.srcId);
+        event["dstId"].set<uint32_t>(call.dstId);
+        uint64_t duration = hrc::diffNow(call.startTime);
+        event["duration"].set<uint64_t>(duration);
+        m_events.publish(EVENT_CALL_END, event);
+
+        call.active = false;
+    }
+
+    if (!call.active && busy && dstId != 0U) {
+        call.active = true;
+        call.srcId = srcId;
+        call.dstId = dstId;
+        call.startTime = hrc::now();
+
+        json::object event = json::object();
+        event["mode"].set<std::string>(std::string(mode));
+        if (slotNo > 0U) {
+            event["slot"].set<uint32_t>(slotNo);
+        }
+        event["srcId"].set<uint32_t>(srcId);
+        event["dstId"].set<uint32_t>(dstId);
+        m_events.publish(EVENT_CALL_START, event);
+    }
+}
+
+/* Helper to publish a signal quality sample. */
+
+void RESTAPI::publishSignal(const CallState& call, const char* mode, uint32_t slotNo, uint8_t rssi, float ber)
+{
+    json::object event = json::object();
+    event["mode"].set<std::string>(std::string(mode));
+    if (slotNo > 0U) {
+        event["slot"].set<uint32_t>(slotNo);
+    }
+    event["srcId"].set<uint32_t>(call.srcId);
+    event["dstId"].set<uint32_t>(call.dstId);
+    if (rssi > 0U) {
+        event["rssi"].set<uint8_t>(rssi);
+    }
+    event["ber"].set<float>(ber);
+
+    // only the latest sample matters to a slow subscriber
+    m_events.publish(EVENT_SIGNAL, event, std::string(mode) + std::to_string(slotNo));
+}
+
+/* Helper to publish a unit registration, affiliation or grant change. */
+
+void RESTAPI::publishAffChange(const char* mode, ::lookups::AFF_CHANGE::ENUM change, uint32_t srcId, uint32_t dstId, uint32_t chNo)
+{
+    if (!m_events.hasSubscribers()) {
+        return;
+    }
+
+    json::object event = json::object();
+    event["mode"].set<std::string>(std::string(mode));
+    event["srcId"].set<uint32_t>(srcId);
+    if (dstId != 0U) {
+        event["dstId"].set<uint32_t>(dstId);
+    }
+    if (chNo != 0U) {
+        event["chNo"].set<uint32_t>(chNo);
+    }
+    m_events.publish(::lookups::AffiliationLookup::changeToString(change), event);
+}
+
 /* Helper to invalidate a host token. */
 
 void RESTAPI::invalidateHostToken(const std::string host)
@@ -524,6 +705,31 @@ void RESTAPI::restAPI_GetVoiceCh(const HTTPPayload& request, HTTPPayload& reply,
     reply.payload(response);
 }
 
+/* REST API endpoint; implements get event stream request. */
+
+void RESTAPI::restAPI_GetEvents(const HTTPPayload& request, HTTPPayload& reply, const RequestMatch& match)
+{
+    if (!validateAuth(request, reply)) {
+        return;
+    }
+
+    // optional comma separated event type filter (i.e. /events?types=call-start,call-end)
+    std::string types = "";
+    size_t pos = request.uri.find("types=");
+    if (pos != std::string::npos) {
+        types = request.uri.substr(pos + 6U);
+        types = types.substr(0U, types.find('&'));
+    }
+
+    std::shared_ptr<EventStreamSubscriber> subscriber = m_events.subscribe(types);
+    if (subscriber == nullptr) {
+        errorPayload(reply, "too many event stream subscribers", HTTPPayload::SERVICE_UNAVAILABLE);
+        return;
+    }
+
+    reply.stream(subscriber);
+}
+
 /* REST API endpoint; implements put/set modem mode request. */
 
 void RESTAPI::restAPI_PutModemMode(const HTTPPayload& request, HTTPPayload& reply, const RequestMatch& match)
@@ -649,6 +855,54 @@ void RESTAPI::restAPI_PutModemKill(const HTTPPayload& request, HTTPPayload& repl
     }
 }
 
+/* REST API endpoint; implements get V.24 modem transmit timing statistics request. */
+
+void RESTAPI::restAPI_GetModemV24Stats(const HTTPPayload& request, HTTPPayload& reply, const RequestMatch& match)
+{
+    if (!validateAuth(request, reply)) {
+        return;
+    }
+
+    modem::ModemV24* modem = dynamic_cast<modem::ModemV24*>(m_host->m_modem);
+    if (modem == nullptr) {
+        errorPayload(reply, "modem is not a V.24 modem");
+        return;
+    }
+
+    json::object response = json::object();
+    setResponseDefaultStatus(response);
+
+    modem::V24TxStats& stats = modem->txStats();
+
+    uint64_t txFrames = stats.txFrames;
+    response["txFrames"].set<uint64_t>(txFrames);
+    uint64_t txDropped = stats.txDropped;
+    response["txDropped"].set<uint64_t>(txDropped);
+    uint64_t txErrors = stats.txErrors;
+    response["txErrors"].set<uint64_t>(txErrors);
+
+    // transmit timing error (in us), how late each frame was written past its deadline
+    uint64_t written = txFrames + txErrors;
+    uint64_t errorTotal = stats.errorTotal;
+    uint32_t errorAvg = (written > 0U) ? (uint32_t)(errorTotal / written) : 0U;
+    response["errorAvg"].set<uint32_t>(errorAvg);
+    uint32_t errorMax = stats.errorMax;
+    response["errorMax"].set<uint32_t>(errorMax);
+
+    json::array hist = json::array();
+    for (uint32_t i = 0U; i < modem::V24_TX_HIST_BUCKETS; i++) {
+        json::object bucket = json::object();
+        uint32_t bound = modem::V24TxStats::bucketBound(i);
+        bucket["lessThan"].set<uint32_t>(bound);
+        uint64_t count = stats.hist[i];
+        bucket["count"].set<uint64_t>(count);
+        hist.push_back(json::value(bucket));
+    }
+
+    response["errorHist"].set<json::array>(hist);
+    reply.payload(response);
+}
+
 /* REST API endpoint; implements set supervisory mode request. */
 
 void RESTAPI::restAPI_PutSetSupervisor(const HTTPPayload& request, HTTPPayload& reply, const RequestMatch& match)
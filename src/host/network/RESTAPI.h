@@ -17,12 +17,16 @@
 #define __REST_API_H__
 
 #include "Defines.h"
+#include "common/network/rest/EventStream.h"
 #include "common/network/rest/RequestDispatcher.h"
 #include "common/network/rest/http/HTTPServer.h"
 #include "common/network/rest/http/SecureHTTPServer.h"
+#include "common/lookups/AffiliationLookup.h"
 #include "common/lookups/RadioIdLookup.h"
 #include "common/lookups/TalkgroupRulesLookup.h"
+#include "common/Clock.h"
 #include "common/Thread.h"
+#include "common/Timer.h"
 #include "network/RESTDefines.h"
 
 #include <vector>
@@ -91,6 +95,13 @@ public:
      */
     void close();
 
+    /**
+     * @brief Updates the event stream by the passed number of milliseconds. This samples the protocol
+     *  call state and signal quality, and publishes changes to event stream subscribers.
+     * @param ms Number of milliseconds.
+     */
+    void clock(uint32_t ms);
+
 private:
     typedef network::rest::RequestDispatcher<network::rest::http::HTTPPayload, network::rest::http::HTTPPayload> RESTDispatcherType;
     typedef network::rest::http::HTTPPayload HTTPPayload;
@@ -120,6 +131,34 @@ private:
     typedef std::unordered_map<std::string, uint64_t>::value_type AuthTokenValueType;
     std::unordered_map<std::string, uint64_t> m_authTokens;
 
+    /**
+     * @brief Represents the call state of a protocol (or DMR slot) last published to event stream subscribers.
+     */
+    class CallState {
+    public:
+        /**
+         * @brief Initializes a new instance of the CallState class.
+         */
+        CallState() :
+            active(false),
+            srcId(0U),
+            dstId(0U),
+            startTime()
+        {
+            /* stub */
+        }
+
+        bool active;
+        uint32_t srcId;
+        uint32_t dstId;
+        system_clock::hrc::hrc_t startTime;
+    };
+
+    network::rest::EventStream m_events;
+    CallState m_calls[4U];
+    Timer m_signalTimer;
+    Timer m_keepAliveTimer;
+
     /**
      * @brief Thread entry point. This function is provided to run the thread
      *  for the REST API services.
@@ -131,6 +170,35 @@ private:
      */
     void initializeEndpoints();
 
+    /**
+     * @brief Helper to publish call start and end events for a protocol (or DMR slot).
+     * @param call Call state last published.
+     * @param mode Digital mode.
+     * @param slotNo DMR slot number (0 for modes without slots).
+     * @param busy Flag indicating whether the protocol (or DMR slot) is busy.
+     * @param srcId Last source ID.
+     * @param dstId Last destination ID.
+     */
+    void clockCall(CallState& call, const char* mode, uint32_t slotNo, bool busy, uint32_t srcId, uint32_t dstId);
+    /**
+     * @brief Helper to publish a signal quality sample.
+     * @param call Call state last published.
+     * @param mode Digital mode.
+     * @param slotNo DMR slot number (0 for modes without slots).
+     * @param rssi RSSI.
+     * @param ber Bit error rate.
+     */
+    void publishSignal(const CallState& call, const char* mode, uint32_t slotNo, uint8_t rssi, float ber);
+    /**
+     * @brief Helper to publish a unit registration, affiliation or grant change.
+     * @param mode Digital mode.
+     * @param change Change type.
+     * @param srcId Source ID.
+     * @param dstId Destination ID.
+     * @param chNo Channel number.
+     */
+    void publishAffChange(const char* mode, ::lookups::AFF_CHANGE::ENUM change, uint32_t srcId, uint32_t dstId, uint32_t chNo);
+
     /**
      * @brief Helper to invalidate a host token.
      * @param host Host.
@@ -173,6 +241,13 @@ private:
      * @param match HTTP request matcher.
      */
     void restAPI_GetVoiceCh(const HTTPPayload& request, HTTPPayload& reply, const network::rest::RequestMatch& match);
+    /**
+     * @brief REST API endpoint; implements get event stream request.
+     * @param request HTTP request.
+     * @param reply HTTP reply.
+     * @param match HTTP request matcher.
+     */
+    void restAPI_GetEvents(const HTTPPayload& request, HTTPPayload& reply, const network::rest::RequestMatch& match);
 
     /**
      * @brief REST API endpoint; implements put/set modem mode request.
@@ -188,6 +263,13 @@ private:
      * @param match HTTP request matcher.
      */
     void restAPI_PutModemKill(const HTTPPayload& request, HTTPPayload& reply, const network::rest::RequestMatch& match);
+    /**
+     * @brief REST API endpoint; implements get V.24 modem transmit timing statistics request.
+     * @param request HTTP request.
+     * @param reply HTTP reply.
+     * @param match HTTP request matcher.
+     */
+    void restAPI_GetModemV24Stats(const HTTPPayload& request, HTTPPayload& reply, const network::rest::RequestMatch& match);
 
     /**
      * @brief REST API endpoint; implements set supervisory mode request.
@@ -36,6 +36,13 @@
 #define GET_VERSION                     "/version"
 #define GET_STATUS                      "/status"
 #define GET_VOICE_CH                    "/voice-ch"
+#define GET_EVENTS                      "/events"
+
+#define EVENT_CALL_START                "call-start"
+#define EVENT_CALL_END                  "call-end"
+#define EVENT_SIGNAL                    "signal"
+#define EVENT_PEER_CONNECT              "peer-connect"
+#define EVENT_PEER_DISCONNECT           "peer-disconnect"
 
 #define PUT_MDM_MODE                    "/mdm/mode"
 #define MODE_OPT_IDLE                   "idle"
@@ -58,6 +65,7 @@
 #define RID_CMD_EMERG                   "emerg"
 
 #define PUT_MDM_KILL                    "/mdm/kill"
+#define GET_MDM_V24_STATS               "/mdm/v24-stats"
 
 #define PUT_SET_SUPERVISOR              "/set-supervisor"
 #define PUT_PERMIT_TG                   "/permit-tg"
@@ -285,6 +285,9 @@ void Control::setOptions(yaml::Node& conf, bool supervisor, const std::string cw
     lc::RCCH::setSiteData(m_siteData);
     lc::RCCH::setCallsign(cwCallsign);
 
+    // site data has changed, regenerate any cached CC broadcasts
+    m_control->invalidateCCCache();
+
     std::vector<lookups::IdenTable> entries = m_idenTable->list();
     for (auto entry : entries) {
         if (entry.channelId() == channelId) {
@@ -846,6 +849,15 @@ uint32_t Control::getLastSrcId() const
     return 0U;
 }
 
+/* Helper to get the signal quality of the current RF transmission. */
+
+bool Control::getRFSignal(uint8_t& rssi, float& ber) const
+{
+    rssi = m_rssi;
+    ber = (m_voice->m_rfBits > 0U) ? float(m_voice->m_rfErrs * 100U) / float(m_voice->m_rfBits) : 0.0F;
+    return m_rfState != RS_RF_LISTENING;
+}
+
 // ---------------------------------------------------------------------------
 //  Private Class Members
 // ---------------------------------------------------------------------------
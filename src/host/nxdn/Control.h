@@ -207,9 +207,9 @@ namespace nxdn
 
         /**
          * @brief Gets instance of the AffiliationLookup class.
-         * @returns AffiliationLookup Instance of the AffiliationLookup class.
+         * @returns AffiliationLookup& Instance of the AffiliationLookup class.
          */
-        lookups::AffiliationLookup affiliations() { return m_affiliations; }
+        lookups::AffiliationLookup& affiliations() { return m_affiliations; }
 
         /**
          * @brief Flag indicating whether the processor or is busy or not.
@@ -254,6 +254,13 @@ namespace nxdn
          * @returns uint32_t Last transmitted source radio ID.
          */
         uint32_t getLastSrcId() const;
+        /**
+         * @brief Helper to get the signal quality of the current RF transmission.
+         * @param[out] rssi Last reported RSSI (dBm, reported as positive; 0 if the modem does not report RSSI).
+         * @param[out] ber Bit error rate of the transmission so far (percentage).
+         * @returns bool True, if there is an RF transmission in progress, otherwise false.
+         */
+        bool getRFSignal(uint8_t& rssi, float& ber) const;
 
     private:
         friend class packet::Voice;
@@ -291,6 +291,8 @@ ControlSignaling::ControlSignaling(Control* nxdn, bool debug, bool verbose) :
     m_ccchPagingCnt(2U),
     m_ccchMultiCnt(2U),
     m_rcchIterateCnt(2U),
+    m_ccSiteInfo(nullptr),
+    m_ccSrvInfo(nullptr),
     m_verifyAff(false),
     m_verifyReg(false),
     m_disableGrantSrcIdCheck(false),
@@ -722,6 +724,14 @@ void ControlSignaling::writeRF_Message_U_Reg_Rsp(uint32_t srcId, uint32_t locId)
 
 void ControlSignaling::writeRF_CC_Message_Site_Info()
 {
+    // the broadcast only changes with the site data, reuse the previously generated frame
+    if (m_ccSiteInfo != nullptr) {
+        if (m_nxdn->m_duplex) {
+            m_nxdn->addFrame(m_ccSiteInfo.get());
+        }
+        return;
+    }
+
     uint8_t data[NXDN_FRAME_LENGTH_BYTES + 2U];
     ::memset(data + 2U, 0x00U, NXDN_FRAME_LENGTH_BYTES);
 
@@ -761,6 +771,9 @@ void ControlSignaling::writeRF_CC_Message_Site_Info()
     NXDNUtils::scrambler(data + 2U);
     NXDNUtils::addPostBits(data + 2U);
 
+    m_ccSiteInfo = std::make_unique<uint8_t[]>(NXDN_FRAME_LENGTH_BYTES + 2U);
+    ::memcpy(m_ccSiteInfo.get(), data, NXDN_FRAME_LENGTH_BYTES + 2U);
+
     if (m_nxdn->m_duplex) {
         m_nxdn->addFrame(data);
     }
@@ -770,6 +783,14 @@ void ControlSignaling::writeRF_CC_Message_Site_Info()
 
 void ControlSignaling::writeRF_CC_Message_Service_Info()
 {
+    // the broadcast only changes with the site data, reuse the previously generated frame
+    if (m_ccSrvInfo != nullptr) {
+        if (m_nxdn->m_duplex) {
+            m_nxdn->addFrame(m_ccSrvInfo.get());
+        }
+        return;
+    }
+
     uint8_t data[NXDN_FRAME_LENGTH_BYTES + 2U];
     ::memset(data + 2U, 0x00U, NXDN_FRAME_LENGTH_BYTES);
 
@@ -804,7 +825,18 @@ void ControlSignaling::writeRF_CC_Message_Service_Info()
     NXDNUtils::scrambler(data + 2U);
     NXDNUtils::addPostBits(data + 2U);
 
+    m_ccSrvInfo = std::make_unique<uint8_t[]>(NXDN_FRAME_LENGTH_BYTES + 2U);
+    ::memcpy(m_ccSrvInfo.get(), data, NXDN_FRAME_LENGTH_BYTES + 2U);
+
     if (m_nxdn->m_duplex) {
         m_nxdn->addFrame(data);
     }
 }
+
+/* Helper to invalidate the cached encoded CC broadcast packets. */
+
+void ControlSignaling::invalidateCCCache()
+{
+    m_ccSiteInfo = nullptr;
+    m_ccSrvInfo = nullptr;
+}
@@ -79,6 +79,9 @@ namespace nxdn
             uint8_t m_ccchMultiCnt;
             uint8_t m_rcchIterateCnt;
 
+            UInt8Array m_ccSiteInfo;
+            UInt8Array m_ccSrvInfo;
+
             bool m_verifyAff;
             bool m_verifyReg;
 
@@ -180,6 +183,11 @@ namespace nxdn
              * @brief Helper to write a CC SRV_INFO broadcast packet on the RF interface.
              */
             void writeRF_CC_Message_Service_Info();
+
+            /**
+             * @brief Helper to invalidate the cached encoded CC broadcast packets.
+             */
+            void invalidateCCCache();
         };
     } // namespace packet
 } // namespace nxdn
@@ -398,6 +398,9 @@ void Control::setOptions(yaml::Node& conf, bool supervisor, const std::string cw
 
     m_siteData.setChCnt((uint8_t)m_affiliations.rfCh()->rfChSize());
 
+    // site data has changed, regenerate any cached control channel broadcasts
+    m_control->invalidateCtrlCache();
+
     m_controlChData = controlChData;
 
     bool disableUnitRegTimeout = p25Protocol["disableUnitRegTimeout"].as<bool>(false);
@@ -796,6 +799,7 @@ void Control::clock()
     if (m_network != nullptr) {
         processNetwork();
 
+        bool netActive = m_siteData.netActive();
         if (m_network->getStatus() == network::NET_STAT_RUNNING) {
             m_siteData.setNetActive(true);
         }
@@ -803,6 +807,11 @@ void Control::clock()
             m_siteData.setNetActive(false);
         }
 
+        // network active state is broadcast in the RFSS status, regenerate any cached control channel broadcasts
+        if (netActive != m_siteData.netActive()) {
+            m_control->invalidateCtrlCache();
+        }
+
         lc::TDULC::setSiteData(m_siteData);
         lc::TSBK::setSiteData(m_siteData);
     }
@@ -994,6 +1003,11 @@ void Control::clockSiteData(uint32_t ms)
                         }
 
                         if (updateCnt == 0U) {
+                            // adjacent site is now broadcast as failed
+                            if (entry.second > 0U) {
+                                m_control->invalidateCtrlCache(true);
+                            }
+
                             SiteData siteData = m_control->m_adjSiteTable[siteId];
                             LogWarning(LOG_NET, "P25, Adjacent Site Status Expired, no data [FAILED], sysId = $%03X, rfss = $%02X, site = $%02X, chId = %u, chNo = %u, svcClass = $%02X",
                                 siteData.sysId(), siteData.rfssId(), siteData.siteId(), siteData.channelId(), siteData.channelNo(), siteData.serviceClass());
@@ -1155,6 +1169,15 @@ uint32_t Control::getLastSrcId() const
     return 0U;
 }
 
+/* Helper to get the signal quality of the current RF transmission. */
+
+bool Control::getRFSignal(uint8_t& rssi, float& ber) const
+{
+    rssi = m_rssi;
+    ber = (m_voice->m_rfBits > 0U) ? float(m_voice->m_rfErrs * 100U) / float(m_voice->m_rfBits) : 0.0F;
+    return m_rfState != RS_RF_LISTENING;
+}
+
 // ---------------------------------------------------------------------------
 //  Private Class Members
 // ---------------------------------------------------------------------------
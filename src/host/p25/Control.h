@@ -234,9 +234,9 @@ namespace p25
         packet::ControlSignaling* control() { return m_control; }
         /**
          * @brief Gets instance of the P25AffiliationLookup class.
-         * @returns P25AffiliationLookup Instance of the P25AffiliationLookup class.
+         * @returns P25AffiliationLookup& Instance of the P25AffiliationLookup class.
          */
-        lookups::P25AffiliationLookup affiliations() { return m_affiliations; }
+        lookups::P25AffiliationLookup& affiliations() { return m_affiliations; }
 
         /**
          * @brief Flag indicating whether the processor or is busy or not.
@@ -271,6 +271,13 @@ namespace p25
          * @returns uint32_t Last transmitted source radio ID.
          */
         uint32_t getLastSrcId() const;
+        /**
+         * @brief Helper to get the signal quality of the current RF transmission.
+         * @param[out] rssi Last reported RSSI (dBm, reported as positive; 0 if the modem does not report RSSI).
+         * @param[out] ber Bit error rate of the transmission so far (percentage).
+         * @returns bool True, if there is an RF transmission in progress, otherwise false.
+         */
+        bool getRFSignal(uint8_t& rssi, float& ber) const;
 
     private:
         friend class packet::Voice;
@@ -150,6 +150,8 @@ const uint32_t ADJ_SITE_TIMER_TIMEOUT = 60U;
 const uint32_t ADJ_SITE_UPDATE_CNT = 5U;
 const uint32_t TSDU_CTRL_BURST_COUNT = 2U;
 const uint32_t TSBK_MBF_CNT = 3U;
+const uint32_t CTRL_CACHE_KEY_BITS = 17U;
+const uint32_t CTRL_FRAME_CACHE_MAX = 256U;
 const uint32_t GRANT_TIMER_TIMEOUT = 15U;
 const uint8_t CONV_FALLBACK_PACKET_DELAY = 8U;
 
@@ -737,6 +739,7 @@ bool ControlSignaling::processNetwork(uint8_t* data, uint32_t len, lc::LC& contr
 
                         m_adjSiteTable[site.siteId()] = site;
                         m_adjSiteUpdateCnt[site.siteId()] = ADJ_SITE_UPDATE_CNT;
+                        invalidateCtrlCache(true);
                     } else {
                         /*
                         ** treat same site adjacent site broadcast as a SCCB for this site
@@ -759,6 +762,7 @@ bool ControlSignaling::processNetwork(uint8_t* data, uint32_t len, lc::LC& contr
 
                         m_sccbTable[site.rfssId()] = site;
                         m_sccbUpdateCnt[site.rfssId()] = ADJ_SITE_UPDATE_CNT;
+                        invalidateCtrlCache(true);
                     }
 
                     return true;
@@ -1249,6 +1253,12 @@ ControlSignaling::ControlSignaling(Control* p25, bool dumpTSBKData, bool debug,
     m_mbfAdjSSCnt(0U),
     m_mbfSCCBCnt(0U),
     m_mbfGrpGrntCnt(0U),
+    m_mbfFrameKey(0U),
+    m_mbfFrameCacheable(false),
+    m_ctrlBlockCache(),
+    m_ctrlFrameCache(),
+    m_ctrlIdenEntries(),
+    m_ctrlIdenGeneration(0U),
     m_adjSiteTable(),
     m_adjSiteUpdateCnt(),
     m_sccbTable(),
@@ -1548,11 +1558,6 @@ void ControlSignaling::writeRF_TSDU_MBF(lc::TSBK* tsbk)
 
     assert(tsbk != nullptr);
 
-    uint8_t frame[P25_TSBK_FEC_LENGTH_BYTES];
-    ::memset(frame, 0x00U, P25_TSBK_FEC_LENGTH_BYTES);
-
-    // LogDebug(LOG_P25, "writeRF_TSDU_MBF, mbfCnt = %u", m_mbfCnt);
-
     // trunking data is unsupported in simplex operation
     if (!m_p25->m_duplex) {
         ::memset(m_rfMBF, 0x00U, P25_PDU_FRAME_LENGTH_BYTES + 2U);
@@ -1560,91 +1565,150 @@ void ControlSignaling::writeRF_TSDU_MBF(lc::TSBK* tsbk)
         return;
     }
 
+    uint8_t frame[P25_TSBK_FEC_LENGTH_BYTES];
+    ::memset(frame, 0x00U, P25_TSBK_FEC_LENGTH_BYTES);
+
+    // Generate TSBK block (the last block of the MBF has the last block flag set)
+    tsbk->setLastBlock(m_mbfCnt + 1U == TSBK_MBF_CNT);
+    tsbk->encode(frame, true);
+
+    if (m_debug) {
+        LogDebug(LOG_RF, P25_TSDU_STR " (MBF), lco = $%02X, mfId = $%02X, lastBlock = %u, AIV = %u, EX = %u, srcId = %u, dstId = %u, sysId = $%03X, netId = $%05X",
+            tsbk->getLCO(), tsbk->getMFId(), tsbk->getLastBlock(), tsbk->getAIV(), tsbk->getEX(), tsbk->getSrcId(), tsbk->getDstId(),
+            tsbk->getSysId(), tsbk->getNetId());
+
+        Utils::dump(1U, "!!! *TSDU MBF Block Data", frame, P25_TSBK_FEC_LENGTH_BYTES);
+    }
+
+    writeRF_TSDU_MBF_Block(frame);
+}
+
+/* Helper to write a Trellis encoded TSBK block into the multi-block (3-block) P25 TSDU packet. */
+
+void ControlSignaling::writeRF_TSDU_MBF_Block(const uint8_t* block, uint32_t key)
+{
+    assert(block != nullptr);
+
+    // LogDebug(LOG_P25, "writeRF_TSDU_MBF_Block, mbfCnt = %u, key = $%05X", m_mbfCnt, key);
+
     if (m_mbfCnt == 0U) {
         ::memset(m_rfMBF, 0x00U, P25_TSBK_FEC_LENGTH_BYTES * TSBK_MBF_CNT);
+        m_mbfFrameKey = 0U;
+        m_mbfFrameCacheable = true;
     }
 
-    // trigger encoding of last block and write to queue
-    if (m_mbfCnt + 1U == TSBK_MBF_CNT) {
-        // Generate TSBK block
-        tsbk->setLastBlock(true); // set last block
-        tsbk->encode(frame, true);
+    // the MBF is only cacheable if every block in it is
+    if (key == 0U)
+        m_mbfFrameCacheable = false;
+    else
+        m_mbfFrameKey |= (ulong64_t)key << (m_mbfCnt * CTRL_CACHE_KEY_BITS);
 
-        if (m_debug) {
-            LogDebug(LOG_RF, P25_TSDU_STR " (MBF), lco = $%02X, mfId = $%02X, lastBlock = %u, AIV = %u, EX = %u, srcId = %u, dstId = %u, sysId = $%03X, netId = $%05X",
-                tsbk->getLCO(), tsbk->getMFId(), tsbk->getLastBlock(), tsbk->getAIV(), tsbk->getEX(), tsbk->getSrcId(), tsbk->getDstId(),
-                tsbk->getSysId(), tsbk->getNetId());
+    Utils::setBitRange(block, m_rfMBF, (m_mbfCnt * P25_TSBK_FEC_LENGTH_BITS), P25_TSBK_FEC_LENGTH_BITS);
+    m_mbfCnt++;
 
-            Utils::dump(1U, "!!! *TSDU MBF Last TSBK Block", frame, P25_TSBK_FEC_LENGTH_BYTES);
-        }
+    if (m_mbfCnt < TSBK_MBF_CNT)
+        return;
 
-        Utils::setBitRange(frame, m_rfMBF, (m_mbfCnt * P25_TSBK_FEC_LENGTH_BITS), P25_TSBK_FEC_LENGTH_BITS);
+    // have we already generated this TSDU frame?
+    if (m_mbfFrameCacheable) {
+        auto it = m_ctrlFrameCache.find(m_mbfFrameKey);
+        if (it != m_ctrlFrameCache.end()) {
+            m_p25->addFrame(it->second.get(), P25_TSDU_TRIPLE_FRAME_LENGTH_BYTES + 2U);
 
-        // Generate TSDU frame
-        uint8_t tsdu[P25_TSDU_TRIPLE_FRAME_LENGTH_BYTES];
-        ::memset(tsdu, 0x00U, P25_TSDU_TRIPLE_FRAME_LENGTH_BYTES);
+            ::memset(m_rfMBF, 0x00U, P25_PDU_FRAME_LENGTH_BYTES + 2U);
+            m_mbfCnt = 0U;
+            return;
+        }
+    }
 
-        uint32_t offset = 0U;
-        for (uint8_t i = 0U; i < m_mbfCnt + 1U; i++) {
-            ::memset(frame, 0x00U, P25_TSBK_FEC_LENGTH_BYTES);
-            Utils::getBitRange(m_rfMBF, frame, offset, P25_TSBK_FEC_LENGTH_BITS);
+    if (m_debug) {
+        Utils::dump(1U, "!!! *TSDU (MBF) TSBK Blocks", m_rfMBF, P25_TSBK_FEC_LENGTH_BYTES * TSBK_MBF_CNT);
+    }
 
-            if (m_debug) {
-                LogDebug(LOG_RF, P25_TSDU_STR " (MBF), lco = $%02X, mfId = $%02X, lastBlock = %u, AIV = %u, EX = %u, srcId = %u, dstId = %u, sysId = $%03X, netId = $%05X",
-                    tsbk->getLCO(), tsbk->getMFId(), tsbk->getLastBlock(), tsbk->getAIV(), tsbk->getEX(), tsbk->getSrcId(), tsbk->getDstId(),
-                    tsbk->getSysId(), tsbk->getNetId());
+    uint8_t data[P25_TSDU_TRIPLE_FRAME_LENGTH_BYTES + 2U];
+    ::memset(data + 2U, 0x00U, P25_TSDU_TRIPLE_FRAME_LENGTH_BYTES);
 
-                Utils::dump(1U, "!!! *TSDU (MBF) TSBK Block", frame, P25_TSBK_FEC_LENGTH_BYTES);
-            }
+    // Generate Sync
+    Sync::addP25Sync(data + 2U);
 
-            // Add TSBK data
-            Utils::setBitRange(frame, tsdu, offset, P25_TSBK_FEC_LENGTH_BITS);
+    // Generate NID
+    m_p25->m_nid.encode(data + 2U, DUID::TSDU);
 
-            offset += P25_TSBK_FEC_LENGTH_BITS;
-        }
+    // interleave
+    P25Utils::encode(m_rfMBF, data + 2U, 114U, 720U);
 
-        // Utils::dump(2U, "!!! *TSDU DEBUG - tsdu", tsdu, P25_TSDU_TRIPLE_FRAME_LENGTH_BYTES);
+    // Add busy bits
+    P25Utils::addStatusBits(data + 2U, P25_TSDU_TRIPLE_FRAME_LENGTH_BITS, m_inbound, true);
+    P25Utils::addTrunkSlotStatusBits(data + 2U, P25_TSDU_TRIPLE_FRAME_LENGTH_BITS);
 
-        uint8_t data[P25_TSDU_TRIPLE_FRAME_LENGTH_BYTES + 2U];
-        ::memset(data + 2U, 0x00U, P25_TSDU_TRIPLE_FRAME_LENGTH_BYTES);
+    data[0U] = modem::TAG_DATA;
+    data[1U] = 0x00U;
 
-        // Generate Sync
-        Sync::addP25Sync(data + 2U);
+    if (m_mbfFrameCacheable) {
+        if (m_ctrlFrameCache.size() >= CTRL_FRAME_CACHE_MAX)
+            m_ctrlFrameCache.clear();
 
-        // Generate NID
-        m_p25->m_nid.encode(data + 2U, DUID::TSDU);
+        UInt8Array cached = std::make_unique<uint8_t[]>(P25_TSDU_TRIPLE_FRAME_LENGTH_BYTES + 2U);
+        ::memcpy(cached.get(), data, P25_TSDU_TRIPLE_FRAME_LENGTH_BYTES + 2U);
+        m_ctrlFrameCache[m_mbfFrameKey] = std::move(cached);
+    }
 
-        // interleave
-        P25Utils::encode(tsdu, data + 2U, 114U, 720U);
+    m_p25->addFrame(data, P25_TSDU_TRIPLE_FRAME_LENGTH_BYTES + 2U);
 
-        // Add busy bits
-        P25Utils::addStatusBits(data + 2U, P25_TSDU_TRIPLE_FRAME_LENGTH_BITS, m_inbound, true);
-        P25Utils::addTrunkSlotStatusBits(data + 2U, P25_TSDU_TRIPLE_FRAME_LENGTH_BITS);
+    ::memset(m_rfMBF, 0x00U, P25_PDU_FRAME_LENGTH_BYTES + 2U);
+    m_mbfCnt = 0U;
+}
 
-        data[0U] = modem::TAG_DATA;
-        data[1U] = 0x00U;
+/* Helper to write a Trellis encoded TSBK block as a single-block P25 TSDU packet. */
 
-        m_p25->addFrame(data, P25_TSDU_TRIPLE_FRAME_LENGTH_BYTES + 2U);
+void ControlSignaling::writeRF_TSDU_SBF_Block(const uint8_t* block, uint32_t key)
+{
+    assert(block != nullptr);
 
-        ::memset(m_rfMBF, 0x00U, P25_PDU_FRAME_LENGTH_BYTES + 2U);
-        m_mbfCnt = 0U;
+    if (!m_p25->m_duplex)
         return;
+
+    // have we already generated this TSDU frame?
+    if (key != 0U) {
+        auto it = m_ctrlFrameCache.find(key);
+        if (it != m_ctrlFrameCache.end()) {
+            m_p25->addFrame(it->second.get(), P25_TSDU_FRAME_LENGTH_BYTES + 2U);
+            return;
+        }
     }
 
-    // Generate TSBK block
-    tsbk->setLastBlock(false); // clear last block
-    tsbk->encode(frame, true);
+    uint8_t data[P25_TSDU_FRAME_LENGTH_BYTES + 2U];
+    ::memset(data + 2U, 0x00U, P25_TSDU_FRAME_LENGTH_BYTES);
 
-    if (m_debug) {
-        LogDebug(LOG_RF, P25_TSDU_STR " (MBF), lco = $%02X, mfId = $%02X, lastBlock = %u, AIV = %u, EX = %u, srcId = %u, dstId = %u, sysId = $%03X, netId = $%05X",
-            tsbk->getLCO(), tsbk->getMFId(), tsbk->getLastBlock(), tsbk->getAIV(), tsbk->getEX(), tsbk->getSrcId(), tsbk->getDstId(),
-            tsbk->getSysId(), tsbk->getNetId());
+    // Generate Sync
+    Sync::addP25Sync(data + 2U);
 
-        Utils::dump(1U, "!!! *TSDU MBF Block Data", frame, P25_TSBK_FEC_LENGTH_BYTES);
+    // Generate NID
+    m_p25->m_nid.encode(data + 2U, DUID::TSDU);
+
+    // interleave
+    P25Utils::encode(block, data + 2U, 114U, 318U);
+
+    // Add busy bits
+    P25Utils::addStatusBits(data + 2U, P25_TSDU_FRAME_LENGTH_BITS, m_inbound, true);
+    P25Utils::addTrunkSlotStatusBits(data + 2U, P25_TSDU_FRAME_LENGTH_BITS);
+
+    // Set first busy bits to 1,1
+    P25Utils::setStatusBits(data + 2U, P25_SS0_START, true, true);
+
+    data[0U] = modem::TAG_DATA;
+    data[1U] = 0x00U;
+
+    if (key != 0U) {
+        if (m_ctrlFrameCache.size() >= CTRL_FRAME_CACHE_MAX)
+            m_ctrlFrameCache.clear();
+
+        UInt8Array cached = std::make_unique<uint8_t[]>(P25_TSDU_FRAME_LENGTH_BYTES + 2U);
+        ::memcpy(cached.get(), data, P25_TSDU_FRAME_LENGTH_BYTES + 2U);
+        m_ctrlFrameCache[key] = std::move(cached);
     }
 
-    Utils::setBitRange(frame, m_rfMBF, (m_mbfCnt * P25_TSBK_FEC_LENGTH_BITS), P25_TSBK_FEC_LENGTH_BITS);
-    m_mbfCnt++;
+    m_p25->addFrame(data, P25_TSDU_FRAME_LENGTH_BYTES + 2U);
 }
 
 /* Helper to write a alternate multi-block trunking PDU packet. */
@@ -1778,6 +1842,14 @@ void ControlSignaling::writeRF_ControlData(uint8_t frameCnt, uint8_t n, bool adj
     if (m_microslotCount > 7999U)
         m_microslotCount = 0;
 
+    // refresh the channel identity entries if the identity table was reloaded
+    uint32_t idenGeneration = m_p25->m_idenTable->generation();
+    if (idenGeneration != m_ctrlIdenGeneration) {
+        m_ctrlIdenEntries = m_p25->m_idenTable->list();
+        m_ctrlIdenGeneration = idenGeneration;
+        invalidateCtrlCache();
+    }
+
     bool forcePad = false;
     bool alt = (frameCnt % 2U) > 0U;
     switch (n)
@@ -1869,8 +1941,7 @@ void ControlSignaling::writeRF_ControlData(uint8_t frameCnt, uint8_t n, bool adj
 
         // pad MBF if we have 2 queued TSDUs
         if (m_mbfCnt == 2U) {
-            std::vector<::lookups::IdenTable> entries = m_p25->m_idenTable->list();
-            if (entries.size() > 1U) {
+            if (m_ctrlIdenEntries.size() > 1U) {
                 queueRF_TSBK_Ctrl(TSBKO::OSP_IDEN_UP);
             }
             else {
@@ -1896,17 +1967,64 @@ void ControlSignaling::queueRF_TSBK_Ctrl(uint8_t lco)
     if (!m_p25->m_enableControl)
         return;
 
+    // trunking data is unsupported in simplex operation
+    if (!m_p25->m_duplex)
+        return;
+
+    // broadcasts only change with the site data, identity table or adjacent sites; these are encoded
+    // once and cached by LCO, table entry and last block flag
+    bool lastBlock = (m_ctrlTSDUMBF) ? (m_mbfCnt + 1U == TSBK_MBF_CNT) : true;
+    uint8_t* entryCnt = nullptr;
+    bool cacheable = true;
+    switch (lco) {
+        case TSBKO::OSP_IDEN_UP:
+            if (m_mbfIdenCnt >= m_ctrlIdenEntries.size())
+                m_mbfIdenCnt = 0U;
+            entryCnt = &m_mbfIdenCnt;
+            break;
+        case TSBKO::OSP_ADJ_STS_BCAST:
+            if (m_mbfAdjSSCnt >= m_adjSiteTable.size())
+                m_mbfAdjSSCnt = 0U;
+            entryCnt = &m_mbfAdjSSCnt;
+            break;
+        case TSBKO::OSP_SCCB_EXP:
+            if (m_mbfSCCBCnt >= m_sccbTable.size())
+                m_mbfSCCBCnt = 0U;
+            entryCnt = &m_mbfSCCBCnt;
+            break;
+        case TSBKO::OSP_SYNC_BCAST:
+        case TSBKO::OSP_TIME_DATE_ANN:
+            cacheable = false;
+            break;
+        default:
+            break;
+    }
+
+    uint32_t key = 0U;
+    if (cacheable) {
+        uint8_t entry = (entryCnt != nullptr) ? *entryCnt : 0U;
+        key = ((uint32_t)lco << 9) | ((uint32_t)entry << 1) | ((lastBlock) ? 1U : 0U);
+
+        auto it = m_ctrlBlockCache.find(key);
+        if (it != m_ctrlBlockCache.end()) {
+            if (entryCnt != nullptr)
+                (*entryCnt)++;
+
+            if (m_ctrlTSDUMBF)
+                writeRF_TSDU_MBF_Block(it->second.get(), key);
+            else
+                writeRF_TSDU_SBF_Block(it->second.get(), key);
+            return;
+        }
+    }
+
     std::unique_ptr<lc::TSBK> tsbk;
 
     switch (lco) {
         case TSBKO::OSP_IDEN_UP:
             {
-                std::vector<::lookups::IdenTable> entries = m_p25->m_idenTable->list();
-                if (m_mbfIdenCnt >= entries.size())
-                    m_mbfIdenCnt = 0U;
-
                 uint8_t i = 0U;
-                for (auto entry : entries) {
+                for (auto entry : m_ctrlIdenEntries) {
                     // no good very bad way of skipping entries...
                     if (i != m_mbfIdenCnt) {
                         i++;
@@ -2088,6 +2206,22 @@ void ControlSignaling::queueRF_TSBK_Ctrl(uint8_t lco)
     }
 
     if (tsbk != nullptr) {
+        if (key != 0U) {
+            tsbk->setLastBlock(lastBlock);
+
+            UInt8Array block = std::make_unique<uint8_t[]>(P25_TSBK_FEC_LENGTH_BYTES);
+            ::memset(block.get(), 0x00U, P25_TSBK_FEC_LENGTH_BYTES);
+            tsbk->encode(block.get(), true);
+
+            if (m_ctrlTSDUMBF)
+                writeRF_TSDU_MBF_Block(block.get(), key);
+            else
+                writeRF_TSDU_SBF_Block(block.get(), key);
+
+            m_ctrlBlockCache[key] = std::move(block);
+            return;
+        }
+
         tsbk->setLastBlock(true); // always set last block
 
         // are we transmitting CC as a multi-block?
@@ -2100,6 +2234,28 @@ void ControlSignaling::queueRF_TSBK_Ctrl(uint8_t lco)
     }
 }
 
+/* Helper to invalidate the cached encoded control channel broadcasts. */
+
+void ControlSignaling::invalidateCtrlCache(bool adjSiteOnly)
+{
+    if (!adjSiteOnly) {
+        m_ctrlBlockCache.clear();
+        m_ctrlFrameCache.clear();
+        return;
+    }
+
+    for (auto it = m_ctrlBlockCache.begin(); it != m_ctrlBlockCache.end(); ) {
+        uint8_t lco = (uint8_t)(it->first >> 9);
+        if (lco == TSBKO::OSP_ADJ_STS_BCAST || lco == TSBKO::OSP_SCCB_EXP)
+            it = m_ctrlBlockCache.erase(it);
+        else
+            ++it;
+    }
+
+    // any TSDU frame could contain an adjacent site block
+    m_ctrlFrameCache.clear();
+}
+
 /* Helper to write a grant packet. */
 
 bool ControlSignaling::writeRF_TSDU_Grant(uint32_t srcId, uint32_t dstId, uint8_t serviceOptions, bool grp, bool net, bool skip, uint32_t chNo)
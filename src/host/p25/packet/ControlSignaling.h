@@ -28,6 +28,7 @@
 #include <cstdio>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <algorithm>
 
 namespace p25
@@ -175,6 +176,14 @@ namespace p25
             uint8_t m_mbfSCCBCnt;
             uint8_t m_mbfGrpGrntCnt;
 
+            ulong64_t m_mbfFrameKey;
+            bool m_mbfFrameCacheable;
+
+            std::unordered_map<uint32_t, UInt8Array> m_ctrlBlockCache;
+            std::unordered_map<ulong64_t, UInt8Array> m_ctrlFrameCache;
+            std::vector<::lookups::IdenTable> m_ctrlIdenEntries;
+            uint32_t m_ctrlIdenGeneration;
+
             std::unordered_map<uint8_t, SiteData> m_adjSiteTable;
             std::unordered_map<uint8_t, uint8_t> m_adjSiteUpdateCnt;
 
@@ -280,6 +289,18 @@ namespace p25
              * @param tsbk TSBK to write to the multi-block queue.
              */
             void writeRF_TSDU_MBF(lc::TSBK* tsbk);
+            /**
+             * @brief Helper to write a Trellis encoded TSBK block into the multi-block (3-block) P25 TSDU packet.
+             * @param block Trellis encoded TSBK block.
+             * @param key Control broadcast cache key of the block (0 if the block is not cacheable).
+             */
+            void writeRF_TSDU_MBF_Block(const uint8_t* block, uint32_t key = 0U);
+            /**
+             * @brief Helper to write a Trellis encoded TSBK block as a single-block P25 TSDU packet.
+             * @param block Trellis encoded TSBK block.
+             * @param key Control broadcast cache key of the block (0 if the block is not cacheable).
+             */
+            void writeRF_TSDU_SBF_Block(const uint8_t* block, uint32_t key = 0U);
             /**
              * @brief Helper to write a alternate multi-block PDU packet.
              * @param tsbk AMBT to write to the modem.
@@ -312,6 +333,11 @@ namespace p25
              * @param lco TSBK LCO to queue into the frame queue.
              */
             void queueRF_TSBK_Ctrl(uint8_t lco);
+            /**
+             * @brief Helper to invalidate the cached encoded control channel broadcasts.
+             * @param adjSiteOnly Flag indicating only the adjacent site and secondary control channel broadcasts are invalidated.
+             */
+            void invalidateCtrlCache(bool adjSiteOnly = false);
 
             /**
              * @brief Helper to write a grant packet.
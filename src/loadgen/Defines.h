@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @defgroup loadgen Load Generator
+ * @brief Digital Voice Modem - Load Generator
+ * @details Synthetic FNE load generator, this provides a large number of virtual peers that log into
+ *  a FNE and generate calls and control traffic, measuring traffic fan-out latency and loss.
+ * @ingroup loadgen
+ * 
+ * @file Defines.h
+ * @ingroup loadgen
+ */
+#if !defined(__DEFINES_H__)
+#define __DEFINES_H__
+
+#include "common/Defines.h"
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#undef __PROG_NAME__
+#define __PROG_NAME__ "Digital Voice Modem (DVM) Load Generator"
+#undef __EXE_NAME__ 
+#define __EXE_NAME__ "loadgen"
+
+#undef __NETVER__
+#define __NETVER__ "LOADGEN_R" VERSION_MAJOR VERSION_REV VERSION_MINOR
+
+#undef DEFAULT_CONF_FILE
+#define DEFAULT_CONF_FILE "loadgen-config.yml"
+#undef DEFAULT_LOCK_FILE
+#define DEFAULT_LOCK_FILE "/tmp/dvmloadgen.lock"
+
+#endif // __DEFINES_H__
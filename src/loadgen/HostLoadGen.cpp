@@ -0,0 +1,1202 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "common/Log.h"
+#include "common/StopWatch.h"
+#include "common/Thread.h"
+#include "common/Utils.h"
+#include "HostLoadGen.h"
+#include "LoadGenMain.h"
+
+using namespace network;
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/** @brief Maximum number of received messages processed for a single peer, per clock. */
+const uint32_t MAX_PEER_DRAIN = 64U;
+/** @brief Maximum amount of time (ms) a shard waits for received traffic. */
+const uint32_t SHARD_WAIT_MS = 2U;
+
+const uint32_t CONTROL_AFFILIATION = 0U;
+const uint32_t CONTROL_REGISTRATION = 1U;
+const uint32_t CONTROL_GRANT = 2U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to get the current monotonic time in microseconds. */
+
+static uint64_t nowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* Helper to read the CPU time (user and system, in clock ticks) used by a process (0 for this process). */
+
+static bool readProcessTicks(pid_t pid, uint64_t& ticks)
+{
+    char path[64U];
+    if (pid == 0)
+        ::snprintf(path, sizeof(path), "/proc/self/stat");
+    else
+        ::snprintf(path, sizeof(path), "/proc/%d/stat", (int)pid);
+
+    FILE* fp = ::fopen(path, "r");
+    if (fp == nullptr)
+        return false;
+
+    char buffer[1024U];
+    size_t len = ::fread(buffer, 1U, sizeof(buffer) - 1U, fp);
+    ::fclose(fp);
+    buffer[len] = '\0';
+
+    // the process name may contain spaces, so the fields are counted from its closing parenthesis
+    char* p = ::strrchr(buffer, ')');
+    if (p == nullptr)
+        return false;
+
+    unsigned long long utime = 0U, stime = 0U;
+    if (::sscanf(p + 1, " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu", &utime, &stime) != 2)
+        return false;
+
+    ticks = utime + stime;
+    return true;
+}
+
+/* Helper to find the process ID of a running process, by name. */
+
+static pid_t findProcess(const char* name)
+{
+    DIR* dir = ::opendir("/proc");
+    if (dir == nullptr)
+        return 0;
+
+    pid_t pid = 0;
+    struct dirent* entry = nullptr;
+    while ((entry = ::readdir(dir)) != nullptr) {
+        if (entry->d_name[0] < '0' || entry->d_name[0] > '9')
+            continue;
+
+        char path[300U];
+        ::snprintf(path, sizeof(path), "/proc/%s/comm", entry->d_name);
+
+        FILE* fp = ::fopen(path, "r");
+        if (fp == nullptr)
+            continue;
+
+        char comm[64U];
+        ::memset(comm, 0x00U, sizeof(comm));
+        if (::fgets(comm, sizeof(comm), fp) != nullptr) {
+            comm[::strcspn(comm, "\n")] = '\0';
+            if (::strcmp(comm, name) == 0)
+                pid = (pid_t)::atoi(entry->d_name);
+        }
+        ::fclose(fp);
+
+        if (pid != 0)
+            break;
+    }
+
+    ::closedir(dir);
+    return pid;
+}
+
+/* Helper to get a percentile (in milliseconds) from a latency histogram. */
+
+static double percentile(const std::vector<uint64_t>& histogram, uint64_t count, double p)
+{
+    if (count == 0U)
+        return 0.0;
+
+    uint64_t rank = (uint64_t)std::ceil(p * (double)count);
+    if (rank == 0U)
+        rank = 1U;
+
+    uint64_t seen = 0U;
+    for (uint32_t i = 0U; i < LATENCY_BUCKETS; i++) {
+        seen += histogram[i];
+        if (seen >= rank)
+            return LatencyHistogram::upperBound(i) / 1000.0;
+    }
+
+    return LatencyHistogram::upperBound(LATENCY_BUCKETS - 1U) / 1000.0;
+}
+
+/* Helper to get the largest latency (in milliseconds) from a latency histogram. */
+
+static double maximum(const std::vector<uint64_t>& histogram)
+{
+    for (uint32_t i = LATENCY_BUCKETS; i > 0U; i--) {
+        if (histogram[i - 1U] > 0U)
+            return LatencyHistogram::upperBound(i - 1U) / 1000.0;
+    }
+
+    return 0.0;
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the HostLoadGen class. */
+
+HostLoadGen::HostLoadGen(const std::string& confFile) :
+    m_confFile(confFile),
+    m_conf(),
+    m_address("127.0.0.1"),
+    m_port(TRAFFIC_DEFAULT_PORT),
+    m_password(),
+    m_encrypted(false),
+    m_debug(false),
+    m_peerCount(100U),
+    m_peerIdBase(9100000U),
+    m_threadCount(4U),
+    m_loginRate(50.0f),
+    m_unitsPerPeer(4U),
+    m_srcIdBase(1000000U),
+    m_affiliateOnLogin(true),
+    m_tgBase(10000U),
+    m_tgCount(50U),
+    m_tgDistribution(TG_DIST_ZIPF),
+    m_zipfExponent(1.0f),
+    m_affiliatedOnly(false),
+    m_callRate(1.0f),
+    m_callDuration(5.0f),
+    m_callMinDuration(1.0f),
+    m_callMaxDuration(30.0f),
+    m_affiliationRate(0.0f),
+    m_registrationRate(0.0f),
+    m_grantRate(0.0f),
+    m_reportInterval(10U),
+    m_statsFile(),
+    m_fnePid(0),
+    m_duration(0U),
+    m_peers(),
+    m_shards(),
+    m_peersRunning(0U),
+    m_shardsRunning(0U),
+    m_running(false),
+    m_calls(nullptr),
+    m_freeCalls(),
+    m_activeCalls(),
+    m_tgBusy(),
+    m_tgAffPeers(nullptr),
+    m_tgWeights(),
+    m_random(std::random_device()()),
+    m_interval(),
+    m_total(),
+    m_lastTxFrames(0U),
+    m_lastRxFrames(0U),
+    m_lastLateFrames(0U),
+    m_lastControlMsgs(0U),
+    m_lastLatency(LATENCY_BUCKETS, 0U),
+    m_fneTicks(0U),
+    m_ownTicks(0U),
+    m_fneCpuSum(0.0),
+    m_fneCpuSamples(0U),
+    m_statsFp(nullptr)
+{
+    ::memset(m_presharedKey, 0x00U, AES_WRAPPED_PCKT_KEY_LEN);
+
+    m_modeWeight[0U] = 1U;
+    m_modeWeight[1U] = 1U;
+    m_modeWeight[2U] = 1U;
+
+    m_calls = new CallSlot[LOADGEN_MAX_CALLS];
+    for (uint32_t i = LOADGEN_MAX_CALLS; i > 0U; i--)
+        m_freeCalls.push_back(i - 1U);
+}
+
+/* Finalizes a instance of the HostLoadGen class. */
+
+HostLoadGen::~HostLoadGen()
+{
+    for (LoadGenPeer* peer : m_peers) {
+        if (peer->network != nullptr) {
+            peer->network->close();
+            delete peer->network;
+        }
+        delete peer;
+    }
+    m_peers.clear();
+
+    for (LoadGenShard* shard : m_shards)
+        delete shard;
+    m_shards.clear();
+
+    delete[] m_calls;
+    if (m_tgAffPeers != nullptr)
+        delete[] m_tgAffPeers;
+
+    if (m_statsFp != nullptr)
+        ::fclose(m_statsFp);
+}
+
+/* Executes the main load generator processing loop. */
+
+int HostLoadGen::run()
+{
+    bool ret = false;
+    try {
+        ret = yaml::Parse(m_conf, m_confFile.c_str());
+        if (!ret) {
+            ::fatal("cannot read the configuration file, %s\n", m_confFile.c_str());
+        }
+    }
+    catch (yaml::OperationException const& e) {
+        ::fatal("cannot read the configuration file - %s (%s)", m_confFile.c_str(), e.message());
+    }
+
+    bool m_daemon = m_conf["daemon"].as<bool>(false);
+    if (m_daemon && g_foreground)
+        m_daemon = false;
+
+    // initialize system logging
+    yaml::Node logConf = m_conf["log"];
+    ret = ::LogInitialise(logConf["filePath"].as<std::string>(), logConf["fileRoot"].as<std::string>(),
+        logConf["fileLevel"].as<uint32_t>(0U), logConf["displayLevel"].as<uint32_t>(0U));
+    if (!ret) {
+        ::fatal("unable to open the log file\n");
+    }
+
+    // handle POSIX process forking
+    if (m_daemon) {
+        // create new process
+        pid_t pid = ::fork();
+        if (pid == -1) {
+            ::fprintf(stderr, "%s: Couldn't fork() , exiting\n", g_progExe.c_str());
+            ::LogFinalise();
+            return EXIT_FAILURE;
+        }
+        else if (pid != 0) {
+            ::LogFinalise();
+            exit(EXIT_SUCCESS);
+        }
+
+        // create new session and process group
+        if (::setsid() == -1) {
+            ::fprintf(stderr, "%s: Couldn't setsid(), exiting\n", g_progExe.c_str());
+            ::LogFinalise();
+            return EXIT_FAILURE;
+        }
+
+        // set the working directory to the root directory
+        if (::chdir("/") == -1) {
+            ::fprintf(stderr, "%s: Couldn't cd /, exiting\n", g_progExe.c_str());
+            ::LogFinalise();
+            return EXIT_FAILURE;
+        }
+
+        ::close(STDIN_FILENO);
+        ::close(STDOUT_FILENO);
+        ::close(STDERR_FILENO);
+    }
+
+    ::LogInfo(__BANNER__ "\r\n" __PROG_NAME__ " " __VER__ " (built " __BUILD__ ")\r\n" \
+        "Copyright (c) 2017-2024 Bryan Biedenkapp, N2PLL and DVMProject (https://github.com/dvmproject) Authors.\r\n" \
+        "Portions Copyright (c) 2015-2021 by Jonathan Naylor, G4KLX and others\r\n" \
+        ">> Load Generator\r\n");
+
+    // read base parameters from configuration
+    ret = readParams();
+    if (!ret)
+        return EXIT_FAILURE;
+
+    // every peer has its own socket
+    struct rlimit limit;
+    if (::getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+        rlim_t needed = (rlim_t)m_peerCount + 64U;
+        if (limit.rlim_cur < needed) {
+            limit.rlim_cur = std::min(needed, limit.rlim_max);
+            if (::setrlimit(RLIMIT_NOFILE, &limit) != 0 || limit.rlim_cur < needed) {
+                ::LogError(LOG_HOST, "Open file limit is too low for %u peers, raise it with ulimit -n %u", m_peerCount, (uint32_t)needed);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    if (!m_statsFile.empty()) {
+        m_statsFp = ::fopen(m_statsFile.c_str(), "w");
+        if (m_statsFp == nullptr) {
+            ::LogError(LOG_HOST, "Unable to open the statistics file, %s", m_statsFile.c_str());
+            return EXIT_FAILURE;
+        }
+
+        ::fprintf(m_statsFp, "elapsed,peers,activeCalls,callsStarted,callsBlocked,callsFailed,txFps,rxFps,expectedFrames,receivedFrames,lossPct,lateFrames,"
+            "latencyP50Ms,latencyP95Ms,latencyP99Ms,latencyMaxMs,controlMsgs,fneCpuPct,fneCpuPerPeerPct,ownCpuPct\n");
+        ::fflush(m_statsFp);
+    }
+
+    // initialize the virtual peers
+    ret = createPeers();
+    if (!ret)
+        return EXIT_FAILURE;
+
+    ::LogInfoEx(LOG_HOST, "Load generator is up and running");
+
+    uint64_t start = nowUs() / 1000U;
+    uint64_t lastReport = start;
+
+    std::exponential_distribution<double> callDist((m_callRate > 0.0f) ? m_callRate : 1.0f);
+    uint64_t nextCall = start + (uint64_t)(callDist(m_random) * 1000.0);
+
+    // main execution loop
+    uint64_t now = start;
+    while (!g_killed) {
+        now = nowUs() / 1000U;
+        if (m_duration > 0U && (now - start) >= (m_duration * 1000U))
+            break;
+
+        // start new calls, as a Poisson process
+        if (m_callRate > 0.0f) {
+            while (now >= nextCall) {
+                startCall();
+                nextCall += (uint64_t)(callDist(m_random) * 1000.0);
+            }
+        }
+
+        retireCalls(now, false);
+
+        if ((now - lastReport) >= (m_reportInterval * 1000U)) {
+            report(now - lastReport, false);
+            lastReport = now;
+        }
+
+        Thread::sleep(5U);
+    }
+
+    // stop the shards (and wait for calls in flight to arrive) before the final report
+    m_running = false;
+    while (m_shardsRunning > 0U)
+        Thread::sleep(1U);
+
+    Thread::sleep(CALL_RETIRE_GRACE_MS);
+    now = nowUs() / 1000U;
+    retireCalls(now, true);
+    report(now - lastReport, true);
+
+    return EXIT_SUCCESS;
+}
+
+/* Writes the talkgroup rules for the configured talkgroups, for use by the FNE under test. */
+
+int HostLoadGen::writeTalkgroupRules(const std::string& rulesFile)
+{
+    try {
+        if (!yaml::Parse(m_conf, m_confFile.c_str())) {
+            ::fatal("cannot read the configuration file, %s\n", m_confFile.c_str());
+        }
+    }
+    catch (yaml::OperationException const& e) {
+        ::fatal("cannot read the configuration file - %s (%s)", m_confFile.c_str(), e.message());
+    }
+
+    yaml::Node tgConf = m_conf["talkgroups"];
+    m_tgBase = tgConf["base"].as<uint32_t>(10000U);
+    m_tgCount = tgConf["count"].as<uint32_t>(50U);
+    m_affiliatedOnly = tgConf["affiliated"].as<bool>(false);
+
+    FILE* fp = ::fopen(rulesFile.c_str(), "w");
+    if (fp == nullptr) {
+        ::fprintf(stderr, "%s: unable to open the talkgroup rules file, %s\n", g_progExe.c_str(), rulesFile.c_str());
+        return EXIT_FAILURE;
+    }
+
+    ::fprintf(fp, "#\n# Digital Voice Modem - Talkgroup Rules\n#\n# Generated by dvmloadgen for talkgroups %u - %u.\n#\n", m_tgBase, m_tgBase + m_tgCount - 1U);
+    ::fprintf(fp, "groupVoice:\n");
+    for (uint32_t i = 0U; i < m_tgCount; i++) {
+        ::fprintf(fp, "  - name: LOADGEN %u\n", m_tgBase + i);
+        ::fprintf(fp, "    config:\n");
+        ::fprintf(fp, "      active: true\n");
+        ::fprintf(fp, "      affiliated: %s\n", m_affiliatedOnly ? "true" : "false");
+        ::fprintf(fp, "      inclusion: []\n");
+        ::fprintf(fp, "      exclusion: []\n");
+        ::fprintf(fp, "      rewrite: []\n");
+        ::fprintf(fp, "      always: []\n");
+        ::fprintf(fp, "      preferred: []\n");
+        ::fprintf(fp, "    source:\n");
+        ::fprintf(fp, "      tgid: %u\n", m_tgBase + i);
+        ::fprintf(fp, "      slot: %u\n", talkgroupSlot(i));
+    }
+
+    ::fclose(fp);
+    ::fprintf(stdout, "%s: wrote %u talkgroup rules to %s\n", g_progExe.c_str(), m_tgCount, rulesFile.c_str());
+    return EXIT_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Reads basic configuration parameters from the YAML configuration file. */
+
+bool HostLoadGen::readParams()
+{
+    yaml::Node networkConf = m_conf["network"];
+    m_address = networkConf["address"].as<std::string>("127.0.0.1");
+    m_port = (uint16_t)networkConf["port"].as<uint32_t>(TRAFFIC_DEFAULT_PORT);
+    m_password = networkConf["password"].as<std::string>();
+    m_debug = networkConf["debug"].as<bool>(false);
+
+    m_encrypted = networkConf["encrypted"].as<bool>(false);
+    std::string key = networkConf["presharedKey"].as<std::string>();
+    if (m_encrypted && !key.empty()) {
+        if (key.size() == 32) {
+            // since the key is 32 characters (16 hex pairs), double it on itself for 64 characters (32 hex pairs)
+            key = key.append(key);
+            LogWarning(LOG_HOST, "Half-length network preshared encryption key detected, doubling key on itself.");
+        }
+
+        if (key.size() == 64 && key.find_first_not_of("0123456789abcdefABCDEF") == std::string::npos) {
+            const char* keyPtr = key.c_str();
+            for (uint8_t i = 0; i < AES_WRAPPED_PCKT_KEY_LEN; i++) {
+                char t[4] = { keyPtr[0], keyPtr[1], 0 };
+                m_presharedKey[i] = (uint8_t)::strtoul(t, NULL, 16);
+                keyPtr += 2 * sizeof(char);
+            }
+        }
+        else {
+            LogWarning(LOG_HOST, "Invalid network preshared encryption key, key should be 32 hex pairs, or 64 characters. Encryption disabled.");
+            m_encrypted = false;
+        }
+    }
+
+    yaml::Node peersConf = m_conf["peers"];
+    m_peerCount = peersConf["count"].as<uint32_t>(100U);
+    m_peerIdBase = peersConf["peerIdBase"].as<uint32_t>(9100000U);
+    m_threadCount = peersConf["threads"].as<uint32_t>(4U);
+    m_loginRate = peersConf["loginRate"].as<float>(50.0f);
+    m_unitsPerPeer = peersConf["unitsPerPeer"].as<uint32_t>(4U);
+    m_srcIdBase = peersConf["srcIdBase"].as<uint32_t>(1000000U);
+    m_affiliateOnLogin = peersConf["affiliateOnLogin"].as<bool>(true);
+
+    yaml::Node tgConf = m_conf["talkgroups"];
+    m_tgBase = tgConf["base"].as<uint32_t>(10000U);
+    m_tgCount = tgConf["count"].as<uint32_t>(50U);
+    std::string distribution = tgConf["distribution"].as<std::string>("zipf");
+    m_zipfExponent = tgConf["zipfExponent"].as<float>(1.0f);
+    m_affiliatedOnly = tgConf["affiliated"].as<bool>(false);
+
+    yaml::Node callConf = m_conf["calls"];
+    m_callRate = callConf["rate"].as<float>(1.0f);
+    m_callDuration = callConf["duration"].as<float>(5.0f);
+    m_callMinDuration = callConf["minDuration"].as<float>(1.0f);
+    m_callMaxDuration = callConf["maxDuration"].as<float>(30.0f);
+    m_modeWeight[0U] = callConf["dmr"].as<uint32_t>(1U);
+    m_modeWeight[1U] = callConf["p25"].as<uint32_t>(1U);
+    m_modeWeight[2U] = callConf["nxdn"].as<uint32_t>(1U);
+
+    yaml::Node controlConf = m_conf["control"];
+    m_affiliationRate = controlConf["affiliationRate"].as<float>(0.0f);
+    m_registrationRate = controlConf["registrationRate"].as<float>(0.0f);
+    m_grantRate = controlConf["grantRate"].as<float>(0.0f);
+
+    yaml::Node reportConf = m_conf["report"];
+    m_reportInterval = reportConf["interval"].as<uint32_t>(10U);
+    m_statsFile = reportConf["statsFile"].as<std::string>();
+    m_fnePid = (pid_t)reportConf["fnePid"].as<uint32_t>(0U);
+    m_duration = m_conf["duration"].as<uint32_t>(0U);
+
+    if (m_password.empty()) {
+        ::LogError(LOG_HOST, "A network password is required.");
+        return false;
+    }
+
+    if (m_peerCount == 0U) {
+        ::LogError(LOG_HOST, "At least one peer is required.");
+        return false;
+    }
+
+    if (m_peerIdBase + m_peerCount - 1U > 999999999U) {
+        ::LogError(LOG_HOST, "Network Peer ID cannot be greater then 999999999.");
+        return false;
+    }
+
+    if (m_unitsPerPeer == 0U)
+        m_unitsPerPeer = 1U;
+    if ((uint64_t)m_srcIdBase + ((uint64_t)m_peerCount * m_unitsPerPeer) - 1U > 16777215U) {
+        ::LogError(LOG_HOST, "Unit radio IDs cannot be greater then 16777215.");
+        return false;
+    }
+
+    if (m_tgCount == 0U || m_tgBase == 0U) {
+        ::LogError(LOG_HOST, "At least one talkgroup, with a non-zero ID, is required.");
+        return false;
+    }
+
+    if (m_modeWeight[0U] + m_modeWeight[1U] + m_modeWeight[2U] == 0U) {
+        ::LogError(LOG_HOST, "At least one digital mode must have a non-zero weight.");
+        return false;
+    }
+
+    if (m_modeWeight[2U] > 0U && m_tgBase + m_tgCount - 1U > 0xFFFFU) {
+        ::LogError(LOG_HOST, "NXDN talkgroup IDs cannot be greater then 65535.");
+        return false;
+    }
+
+    if (m_threadCount == 0U)
+        m_threadCount = 1U;
+    if (m_threadCount > m_peerCount)
+        m_threadCount = m_peerCount;
+    if (m_reportInterval == 0U)
+        m_reportInterval = 1U;
+    if (m_callMaxDuration < m_callMinDuration)
+        m_callMaxDuration = m_callMinDuration;
+
+    // talkgroup popularity, as cumulative weights
+    m_tgDistribution = (distribution == "uniform") ? TG_DIST_UNIFORM : TG_DIST_ZIPF;
+    m_tgWeights.clear();
+    double weight = 0.0;
+    for (uint32_t i = 0U; i < m_tgCount; i++) {
+        weight += (m_tgDistribution == TG_DIST_UNIFORM) ? 1.0 : 1.0 / std::pow((double)(i + 1U), (double)m_zipfExponent);
+        m_tgWeights.push_back(weight);
+    }
+
+    LogInfo("Network Parameters");
+    LogInfo("    Address: %s", m_address.c_str());
+    LogInfo("    Port: %u", m_port);
+    LogInfo("    Encrypted: %s", m_encrypted ? "yes" : "no");
+    LogInfo("    Debug: %s", m_debug ? "yes" : "no");
+
+    LogInfo("Peer Parameters");
+    LogInfo("    Peers: %u (Peer IDs %u - %u)", m_peerCount, m_peerIdBase, m_peerIdBase + m_peerCount - 1U);
+    LogInfo("    Threads: %u", m_threadCount);
+    LogInfo("    Login Rate: %.1f peers/s", m_loginRate);
+    LogInfo("    Units: %u per peer (Radio IDs %u - %u)", m_unitsPerPeer, m_srcIdBase, m_srcIdBase + (m_peerCount * m_unitsPerPeer) - 1U);
+    LogInfo("    Affiliate On Login: %s", m_affiliateOnLogin ? "yes" : "no");
+
+    LogInfo("Talkgroup Parameters");
+    LogInfo("    Talkgroups: %u (%u - %u)", m_tgCount, m_tgBase, m_tgBase + m_tgCount - 1U);
+    if (m_tgDistribution == TG_DIST_ZIPF)
+        LogInfo("    Distribution: zipf (s = %.2f)", m_zipfExponent);
+    else
+        LogInfo("    Distribution: uniform");
+    LogInfo("    Affiliated Only: %s", m_affiliatedOnly ? "yes" : "no");
+
+    LogInfo("Call Parameters");
+    LogInfo("    Rate: %.2f calls/s", m_callRate);
+    LogInfo("    Duration: %.1fs mean (%.1fs - %.1fs)", m_callDuration, m_callMinDuration, m_callMaxDuration);
+    LogInfo("    Mode Weights: DMR %u, P25 %u, NXDN %u", m_modeWeight[0U], m_modeWeight[1U], m_modeWeight[2U]);
+
+    LogInfo("Control Parameters");
+    LogInfo("    Affiliation Rate: %.2f/s", m_affiliationRate);
+    LogInfo("    Registration Rate: %.2f/s", m_registrationRate);
+    LogInfo("    Grant Request Rate: %.2f/s", m_grantRate);
+
+    LogInfo("Report Parameters");
+    LogInfo("    Interval: %us", m_reportInterval);
+    LogInfo("    Statistics File: %s", m_statsFile.empty() ? "none" : m_statsFile.c_str());
+    if (m_fnePid != 0)
+        LogInfo("    FNE PID: %d", (int)m_fnePid);
+    else
+        LogInfo("    FNE PID: auto");
+    if (m_duration > 0U)
+        LogInfo("    Duration: %us", m_duration);
+
+    return true;
+}
+
+/* Initializes the virtual peers, and the threads that clock them. */
+
+bool HostLoadGen::createPeers()
+{
+    m_tgBusy.assign(m_tgCount, false);
+    m_tgAffPeers = new std::atomic<uint32_t>[m_tgCount];
+    for (uint32_t i = 0U; i < m_tgCount; i++)
+        m_tgAffPeers[i] = 0U;
+
+    for (uint32_t i = 0U; i < m_threadCount; i++) {
+        LoadGenShard* shard = new LoadGenShard();
+        shard->host = this;
+        shard->index = i;
+        shard->random.seed(m_random());
+        m_shards.push_back(shard);
+    }
+
+    for (uint32_t i = 0U; i < m_peerCount; i++) {
+        LoadGenPeer* peer = new LoadGenPeer();
+        peer->network = new VirtualPeer(m_address, m_port, m_peerIdBase + i, m_password, m_debug);
+
+        char identity[16U];
+        ::snprintf(identity, sizeof(identity), "LG%06u", i);
+        peer->network->setMetadata(std::string(identity), 0U, 0U, 0.0f, 0.0f, 0U, 0U, 0U, 0.0f, 0.0f, 0, "Load Generator");
+        if (m_encrypted) {
+            peer->network->setPresharedKey(m_presharedKey);
+        }
+
+        peer->network->enable(true);
+        peer->unitTG.assign(m_unitsPerPeer, ~0U);
+
+        m_peers.push_back(peer);
+        m_shards[i % m_threadCount]->peers.push_back(i);
+    }
+
+    m_running = true;
+    for (LoadGenShard* shard : m_shards) {
+        m_shardsRunning++;
+        if (!Thread::runAsThread(shard, threadShard)) {
+            m_shardsRunning--;
+            m_running = false;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Helper to pick a talkgroup, from the configured distribution. */
+
+uint32_t HostLoadGen::pickTalkgroup(std::mt19937& random)
+{
+    std::uniform_real_distribution<double> dist(0.0, m_tgWeights.back());
+    auto it = std::upper_bound(m_tgWeights.begin(), m_tgWeights.end(), dist(random));
+    uint32_t tgIndex = (uint32_t)(it - m_tgWeights.begin());
+    return (tgIndex < m_tgCount) ? tgIndex : m_tgCount - 1U;
+}
+
+/* Helper to pick a digital mode, from the configured mode weights. */
+
+uint8_t HostLoadGen::pickMode(std::mt19937& random)
+{
+    uint32_t total = m_modeWeight[0U] + m_modeWeight[1U] + m_modeWeight[2U];
+    uint32_t n = random() % total;
+    if (n < m_modeWeight[0U])
+        return LOADGEN_MODE_DMR;
+    if (n < m_modeWeight[0U] + m_modeWeight[1U])
+        return LOADGEN_MODE_P25;
+    return LOADGEN_MODE_NXDN;
+}
+
+/* Starts a new call, on a randomly chosen talkgroup and peer. */
+
+void HostLoadGen::startCall()
+{
+    // a talkgroup carries a single call at a time, as it would on a real system
+    uint32_t tgIndex = pickTalkgroup(m_random);
+    if (m_tgBusy[tgIndex] || m_freeCalls.empty()) {
+        m_interval.callsBlocked++;
+        m_total.callsBlocked++;
+        return;
+    }
+
+    // pick an idle peer that is logged in
+    std::uniform_int_distribution<uint32_t> peerDist(0U, m_peerCount - 1U);
+    uint32_t peerIndex = ~0U;
+    for (uint32_t i = 0U; i < 16U; i++) {
+        uint32_t n = peerDist(m_random);
+        if (m_peers[n]->running && !m_peers[n]->busy) {
+            peerIndex = n;
+            break;
+        }
+    }
+
+    if (peerIndex == ~0U) {
+        m_interval.callsBlocked++;
+        m_total.callsBlocked++;
+        return;
+    }
+
+    uint32_t callSlot = m_freeCalls.back();
+    m_freeCalls.pop_back();
+
+    CallSlot& call = m_calls[callSlot];
+    call.txFrames = 0U;
+    call.rxFrames = 0U;
+    call.receivers = 0U;
+    call.endTime = 0U;
+    uint32_t generation = call.generation.fetch_add(1U) + 1U;
+    call.peer = peerIndex;
+    call.tgIndex = tgIndex;
+    call.active = true;
+    m_activeCalls.push_back(callSlot);
+
+    m_tgBusy[tgIndex] = true;
+    m_peers[peerIndex]->busy = true;
+
+    // call duration is exponentially distributed, and clamped
+    std::exponential_distribution<double> durationDist(1.0 / ((m_callDuration > 0.0f) ? m_callDuration : 1.0f));
+    double duration = std::max((double)m_callMinDuration, std::min((double)m_callMaxDuration, durationDist(m_random)));
+
+    CallRequest request;
+    request.callSlot = callSlot;
+    request.generation = (uint16_t)generation;
+    request.peer = peerIndex;
+    request.mode = pickMode(m_random);
+    request.srcId = unitId(peerIndex, m_random() % m_unitsPerPeer);
+    request.tgIndex = tgIndex;
+    request.dstId = m_tgBase + tgIndex;
+    request.slot = talkgroupSlot(tgIndex);
+    request.duration = (uint32_t)(duration * 1000.0);
+
+    // NXDN radio IDs are 16-bit
+    if (request.mode == LOADGEN_MODE_NXDN)
+        request.srcId = 1U + (request.srcId % 0xFFFEU);
+
+    LoadGenShard* shard = m_shards[peerIndex % m_threadCount];
+    {
+        std::lock_guard<std::mutex> lock(shard->queueLock);
+        shard->queue.push_back(request);
+    }
+
+    m_interval.callsStarted++;
+    m_total.callsStarted++;
+}
+
+/* Retires calls that ended, counting the frames received. */
+
+void HostLoadGen::retireCalls(uint64_t now, bool force)
+{
+    auto it = m_activeCalls.begin();
+    while (it != m_activeCalls.end()) {
+        CallSlot& call = m_calls[*it];
+        uint64_t endTime = call.endTime;
+
+        // calls still in progress when stopping are not counted
+        if (endTime == 0U && !force) {
+            ++it;
+            continue;
+        }
+
+        if (endTime != 0U) {
+            if (!force && now < endTime + CALL_RETIRE_GRACE_MS) {
+                ++it;
+                continue;
+            }
+
+            uint32_t txFrames = call.txFrames;
+            if (txFrames == 0U) {
+                m_interval.callsFailed++;
+                m_total.callsFailed++;
+            }
+            else {
+                // affiliation churn can grow the set of receivers during a call
+                uint64_t expected = (uint64_t)txFrames * call.receivers;
+                uint64_t received = std::min((uint64_t)call.rxFrames, expected);
+
+                m_interval.callsCompleted++;
+                m_interval.expectedFrames += expected;
+                m_interval.receivedFrames += received;
+                m_total.callsCompleted++;
+                m_total.expectedFrames += expected;
+                m_total.receivedFrames += received;
+            }
+        }
+
+        m_tgBusy[call.tgIndex] = false;
+        m_peers[call.peer]->busy = false;
+        call.active = false;
+        m_freeCalls.push_back(*it);
+        it = m_activeCalls.erase(it);
+    }
+}
+
+/* Writes the statistics of a reporting interval. */
+
+void HostLoadGen::report(uint64_t elapsed, bool last)
+{
+    uint64_t txFrames = 0U, rxFrames = 0U, lateFrames = 0U, controlMsgs = 0U;
+    std::vector<uint64_t> latency(LATENCY_BUCKETS, 0U);
+    for (LoadGenShard* shard : m_shards) {
+        txFrames += shard->txFrames;
+        rxFrames += shard->rxFrames;
+        lateFrames += shard->lateFrames;
+        controlMsgs += shard->controlMsgs;
+        for (uint32_t i = 0U; i < LATENCY_BUCKETS; i++)
+            latency[i] += shard->latency.buckets[i].load(std::memory_order_relaxed);
+    }
+
+    std::vector<uint64_t> interval(LATENCY_BUCKETS, 0U);
+    uint64_t count = 0U;
+    for (uint32_t i = 0U; i < LATENCY_BUCKETS; i++) {
+        interval[i] = latency[i] - m_lastLatency[i];
+        count += interval[i];
+    }
+
+    double seconds = (elapsed > 0U) ? elapsed / 1000.0 : 1.0;
+    uint32_t peers = m_peersRunning;
+
+    // FNE and load generator CPU usage, over the interval
+    double hz = (double)::sysconf(_SC_CLK_TCK);
+    double fneCpu = -1.0, ownCpu = -1.0;
+    if (m_fnePid == 0) {
+        m_fnePid = findProcess("dvmfne");
+        if (m_fnePid != 0)
+            LogMessage(LOG_HOST, "Found dvmfne, pid = %d", (int)m_fnePid);
+    }
+
+    uint64_t ticks = 0U;
+    if (m_fnePid != 0 && readProcessTicks(m_fnePid, ticks)) {
+        if (m_fneTicks != 0U) {
+            fneCpu = ((ticks - m_fneTicks) / hz) / seconds * 100.0;
+            m_fneCpuSum += fneCpu;
+            m_fneCpuSamples++;
+        }
+        m_fneTicks = ticks;
+    }
+
+    if (readProcessTicks(0, ticks)) {
+        if (m_ownTicks != 0U)
+            ownCpu = ((ticks - m_ownTicks) / hz) / seconds * 100.0;
+        m_ownTicks = ticks;
+    }
+
+    double fneCpuPerPeer = (fneCpu >= 0.0 && peers > 0U) ? fneCpu / peers : -1.0;
+    double loss = (m_interval.expectedFrames > 0U) ?
+        (1.0 - ((double)m_interval.receivedFrames / (double)m_interval.expectedFrames)) * 100.0 : 0.0;
+
+    LogMessage(LOG_HOST, "Peers %u/%u, calls %u active %" PRIu64 " started %" PRIu64 " blocked %" PRIu64 " failed, tx %.0f/s, rx %.0f/s, loss %.3f%%, late %" PRIu64 ", latency p50 %.2fms p95 %.2fms p99 %.2fms max %.2fms, control %.0f/s",
+        peers, m_peerCount, (uint32_t)m_activeCalls.size(), m_interval.callsStarted, m_interval.callsBlocked, m_interval.callsFailed,
+        (txFrames - m_lastTxFrames) / seconds, (rxFrames - m_lastRxFrames) / seconds, loss, lateFrames - m_lastLateFrames,
+        percentile(interval, count, 0.50), percentile(interval, count, 0.95), percentile(interval, count, 0.99), maximum(interval),
+        (controlMsgs - m_lastControlMsgs) / seconds);
+    if (fneCpu >= 0.0) {
+        LogMessage(LOG_HOST, "FNE CPU %.1f%% (%.4f%% per peer), load generator CPU %.1f%%", fneCpu, fneCpuPerPeer, ownCpu);
+    }
+
+    if (m_statsFp != nullptr) {
+        ::fprintf(m_statsFp, "%.1f,%u,%u,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%.1f,%.1f,%" PRIu64 ",%" PRIu64 ",%.4f,%" PRIu64 ",%.3f,%.3f,%.3f,%.3f,%" PRIu64 ",%.2f,%.5f,%.2f\n",
+            seconds, peers, (uint32_t)m_activeCalls.size(), m_interval.callsStarted, m_interval.callsBlocked, m_interval.callsFailed,
+            (txFrames - m_lastTxFrames) / seconds, (rxFrames - m_lastRxFrames) / seconds, m_interval.expectedFrames, m_interval.receivedFrames,
+            loss, lateFrames - m_lastLateFrames, percentile(interval, count, 0.50), percentile(interval, count, 0.95),
+            percentile(interval, count, 0.99), maximum(interval), controlMsgs - m_lastControlMsgs, fneCpu, fneCpuPerPeer, ownCpu);
+        ::fflush(m_statsFp);
+    }
+
+    m_lastTxFrames = txFrames;
+    m_lastRxFrames = rxFrames;
+    m_lastLateFrames = lateFrames;
+    m_lastControlMsgs = controlMsgs;
+    m_lastLatency = latency;
+    m_interval = LoadGenTotals();
+
+    if (last) {
+        count = 0U;
+        for (uint32_t i = 0U; i < LATENCY_BUCKETS; i++)
+            count += latency[i];
+
+        loss = (m_total.expectedFrames > 0U) ?
+            (1.0 - ((double)m_total.receivedFrames / (double)m_total.expectedFrames)) * 100.0 : 0.0;
+
+        LogInfoEx(LOG_HOST, "Summary");
+        LogInfoEx(LOG_HOST, "    Calls: %" PRIu64 " started, %" PRIu64 " completed, %" PRIu64 " blocked, %" PRIu64 " failed", m_total.callsStarted, m_total.callsCompleted,
+            m_total.callsBlocked, m_total.callsFailed);
+        LogInfoEx(LOG_HOST, "    Frames: %" PRIu64 " sent, %" PRIu64 " expected, %" PRIu64 " received, %" PRIu64 " late, loss %.4f%%", txFrames, m_total.expectedFrames,
+            m_total.receivedFrames, lateFrames, loss);
+        LogInfoEx(LOG_HOST, "    Latency: p50 %.2fms, p95 %.2fms, p99 %.2fms, max %.2fms", percentile(latency, count, 0.50),
+            percentile(latency, count, 0.95), percentile(latency, count, 0.99), maximum(latency));
+        if (m_fneCpuSamples > 0U) {
+            double avgCpu = m_fneCpuSum / m_fneCpuSamples;
+            LogInfoEx(LOG_HOST, "    FNE CPU: %.1f%% average (%.4f%% per peer)", avgCpu, (m_peerCount > 0U) ? avgCpu / m_peerCount : 0.0);
+        }
+    }
+}
+
+/* Processes a peer of a shard; clocking the network, reading the received frames and sending the frames of the peers call. */
+
+void HostLoadGen::clockPeer(LoadGenShard* shard, uint32_t peerIndex, uint32_t ms, bool drain, std::vector<FrameTag>& tags)
+{
+    LoadGenPeer* peer = m_peers[peerIndex];
+    VirtualPeer* network = peer->network;
+    if (!peer->opened)
+        return;
+
+    // clock the network, then process any further waiting messages
+    network->clock(ms);
+    if (drain) {
+        for (uint32_t i = 0U; i < MAX_PEER_DRAIN && network->wait(0U); i++)
+            network->clock(0U);
+    }
+
+    bool running = network->getStatus() == NET_STAT_RUNNING;
+    if (running != peer->running) {
+        peer->running = running;
+        if (running) {
+            m_peersRunning++;
+            if (m_affiliateOnLogin) {
+                for (uint32_t unit = 0U; unit < m_unitsPerPeer; unit++)
+                    affiliate(peerIndex, unit, pickTalkgroup(shard->random));
+            }
+        }
+        else {
+            // the FNE drops the affiliations of a peer that disconnects
+            m_peersRunning--;
+            for (auto entry : peer->affCount)
+                m_tgAffPeers[entry.first]--;
+            peer->affCount.clear();
+            peer->unitTG.assign(m_unitsPerPeer, ~0U);
+        }
+    }
+
+    // count the received voice frames, by call
+    tags.clear();
+    uint32_t frames = network->readTags(tags);
+    if (frames > 0U) {
+        shard->rxFrames += frames;
+
+        uint32_t now = (uint32_t)nowUs();
+        for (const FrameTag& tag : tags) {
+            if (tag.callSlot >= LOADGEN_MAX_CALLS)
+                continue;
+
+            CallSlot& call = m_calls[tag.callSlot];
+            if ((uint16_t)call.generation.load(std::memory_order_relaxed) != tag.generation) {
+                shard->lateFrames++;
+                continue;
+            }
+
+            call.rxFrames++;
+            shard->rxTagged++;
+            shard->latency.add(now - tag.timestamp);
+        }
+    }
+
+    if (!peer->inCall)
+        return;
+
+    // send the voice frames of the call as they come due
+    uint32_t interval = DMR_FRAME_INTERVAL_MS;
+    if (peer->call.mode == LOADGEN_MODE_P25)
+        interval = P25_FRAME_INTERVAL_MS;
+    else if (peer->call.mode == LOADGEN_MODE_NXDN)
+        interval = NXDN_FRAME_INTERVAL_MS;
+
+    CallSlot& call = m_calls[peer->call.callSlot];
+    uint64_t now = nowUs();
+    while (now >= peer->nextFrame) {
+        if (now >= peer->callEnd || !peer->running) {
+            network->writeCallEnd();
+            call.endTime = now / 1000U;
+            peer->inCall = false;
+            break;
+        }
+
+        FrameTag tag;
+        tag.callSlot = (uint16_t)peer->call.callSlot;
+        tag.generation = peer->call.generation;
+        tag.seqNo = peer->seqNo++;
+        tag.timestamp = (uint32_t)nowUs();
+        if (network->writeCallVoice(tag)) {
+            call.txFrames++;
+            shard->txFrames++;
+        }
+
+        // a stalled thread resumes the frame cadence, rather than bursting to catch up
+        peer->nextFrame += interval * 1000U;
+        if (peer->nextFrame + (interval * 1000U) < now)
+            peer->nextFrame = now + (interval * 1000U);
+    }
+}
+
+/* Sends a random control message (affiliation, registration or grant request) from a random peer of a shard. */
+
+void HostLoadGen::sendControl(LoadGenShard* shard, uint32_t type)
+{
+    if (shard->peers.empty())
+        return;
+
+    uint32_t peerIndex = shard->peers[shard->random() % shard->peers.size()];
+    LoadGenPeer* peer = m_peers[peerIndex];
+    if (!peer->running)
+        return;
+
+    uint32_t unit = shard->random() % m_unitsPerPeer;
+    switch (type) {
+    case CONTROL_AFFILIATION:
+        affiliate(peerIndex, unit, pickTalkgroup(shard->random));
+        break;
+    case CONTROL_REGISTRATION:
+        peer->network->announceUnitRegistration(unitId(peerIndex, unit));
+        break;
+    case CONTROL_GRANT:
+        {
+            // the load generator modes match the DVM mode states of a grant request
+            uint32_t tgIndex = pickTalkgroup(shard->random);
+            uint8_t mode = pickMode(shard->random);
+            peer->network->writeGrantReq(mode, unitId(peerIndex, unit), m_tgBase + tgIndex,
+                (mode == LOADGEN_MODE_DMR) ? talkgroupSlot(tgIndex) : 0U, false);
+        }
+        break;
+    default:
+        return;
+    }
+
+    shard->controlMsgs++;
+}
+
+/* Helper to (re-)affiliate a unit of a peer to the given talkgroup. */
+
+void HostLoadGen::affiliate(uint32_t peerIndex, uint32_t unit, uint32_t tgIndex)
+{
+    LoadGenPeer* peer = m_peers[peerIndex];
+
+    // the number of peers with affiliations to a talkgroup, is the number of peers an affiliated only
+    // talkgroup repeats to
+    uint32_t prev = peer->unitTG[unit];
+    if (prev != ~0U) {
+        auto it = peer->affCount.find(prev);
+        if (it != peer->affCount.end() && --it->second == 0U) {
+            peer->affCount.erase(it);
+            m_tgAffPeers[prev]--;
+        }
+    }
+
+    peer->unitTG[unit] = tgIndex;
+    if (peer->affCount[tgIndex]++ == 0U)
+        m_tgAffPeers[tgIndex]++;
+
+    peer->network->announceGroupAffiliation(unitId(peerIndex, unit), m_tgBase + tgIndex);
+}
+
+/* Entry point to a shard thread, that clocks a group of peers. */
+
+void* HostLoadGen::threadShard(void* arg)
+{
+    thread_t* th = (thread_t*)arg;
+    if (th != nullptr) {
+        ::pthread_detach(th->thread);
+
+        LoadGenShard* shard = static_cast<LoadGenShard*>(th->obj);
+        if (shard == nullptr) {
+            g_killed = true;
+            LogDebug(LOG_HOST, "[FAIL] loadgen:shard");
+            delete th;
+            return nullptr;
+        }
+
+        HostLoadGen* host = shard->host;
+        std::string threadName("loadgen:shard-" + std::to_string(shard->index));
+
+        if (g_killed) {
+            host->m_shardsRunning--;
+            delete th;
+            return nullptr;
+        }
+
+        LogDebug(LOG_HOST, "[ OK ] %s", threadName.c_str());
+#ifdef _GNU_SOURCE
+        ::pthread_setname_np(th->thread, threadName.c_str());
+#endif // _GNU_SOURCE
+
+        // the sockets are created with the peers, and opened as the peers log in
+        std::vector<udp::Socket*> sockets;
+        for (uint32_t peerIndex : shard->peers)
+            sockets.push_back(host->m_peers[peerIndex]->network->socket());
+
+        // login and control rates are split evenly across the shards
+        double share = (double)shard->peers.size() / (double)host->m_peerCount;
+        double loginRate = host->m_loginRate * share;
+        double loginCredit = 1.0;
+        uint32_t opened = 0U;
+
+        float controlRate[3U] = { host->m_affiliationRate, host->m_registrationRate, host->m_grantRate };
+        uint64_t nextControl[3U];
+        for (uint32_t i = 0U; i < 3U; i++) {
+            nextControl[i] = 0U;
+            if (controlRate[i] > 0.0f) {
+                std::exponential_distribution<double> dist(controlRate[i] * share);
+                nextControl[i] = nowUs() + (uint64_t)(dist(shard->random) * 1000000.0);
+            }
+        }
+
+        std::vector<FrameTag> tags;
+        std::vector<CallRequest> requests;
+        bool drain = false;
+
+        StopWatch stopWatch;
+        stopWatch.start();
+
+        while (!g_killed && host->m_running) {
+            uint32_t ms = stopWatch.elapsed();
+            stopWatch.start();
+
+            // log the peers in, at the configured rate
+            if (opened < shard->peers.size()) {
+                loginCredit += (loginRate * ms) / 1000.0;
+                while (opened < shard->peers.size() && (loginRate <= 0.0 || loginCredit >= 1.0)) {
+                    LoadGenPeer* peer = host->m_peers[shard->peers[opened++]];
+                    peer->opened = peer->network->open();
+                    loginCredit -= 1.0;
+                }
+            }
+
+            // start the calls requested by the call scheduler
+            {
+                std::lock_guard<std::mutex> lock(shard->queueLock);
+                requests.swap(shard->queue);
+            }
+
+            for (const CallRequest& request : requests) {
+                LoadGenPeer* peer = host->m_peers[request.peer];
+                CallSlot& call = host->m_calls[request.callSlot];
+
+                // the peer disconnected since the call was scheduled
+                if (!peer->running || peer->inCall) {
+                    call.endTime = nowUs() / 1000U;
+                    continue;
+                }
+
+                uint32_t receivers = host->m_peersRunning - 1U;
+                if (host->m_affiliatedOnly) {
+                    receivers = host->m_tgAffPeers[request.tgIndex];
+                    if (peer->affCount.find(request.tgIndex) != peer->affCount.end())
+                        receivers--;
+                }
+                call.receivers = receivers;
+
+                peer->network->writeCallStart(request.mode, request.srcId, request.dstId, request.slot);
+                peer->call = request;
+                peer->inCall = true;
+                peer->seqNo = 0U;
+                peer->nextFrame = nowUs();
+                peer->callEnd = peer->nextFrame + (request.duration * 1000ULL);
+            }
+            requests.clear();
+
+            for (uint32_t peerIndex : shard->peers)
+                host->clockPeer(shard, peerIndex, ms, drain, tags);
+
+            // control traffic, as Poisson processes
+            uint64_t now = nowUs();
+            for (uint32_t i = 0U; i < 3U; i++) {
+                if (controlRate[i] <= 0.0f)
+                    continue;
+
+                std::exponential_distribution<double> dist(controlRate[i] * share);
+                while (now >= nextControl[i]) {
+                    host->sendControl(shard, i);
+                    nextControl[i] += (uint64_t)(dist(shard->random) * 1000000.0);
+                }
+            }
+
+            // sleep until traffic arrives (or the next frames are due)
+            drain = udp::Socket::wait(sockets, (int)SHARD_WAIT_MS);
+        }
+
+        LogDebug(LOG_HOST, "[STOP] %s", threadName.c_str());
+        host->m_shardsRunning--;
+        delete th;
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,481 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file HostLoadGen.h
+ * @ingroup loadgen
+ * @file HostLoadGen.cpp
+ * @ingroup loadgen
+ */
+#if !defined(__HOST_LOADGEN_H__)
+#define __HOST_LOADGEN_H__
+
+#include "Defines.h"
+#include "common/yaml/Yaml.h"
+#include "network/VirtualPeer.h"
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/types.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/** @brief Maximum number of calls in progress (or awaiting retirement) at once. */
+const uint32_t LOADGEN_MAX_CALLS = 4096U;
+/** @brief Number of buckets in a latency histogram. */
+const uint32_t LATENCY_BUCKETS = 371U;
+/**
+ * @brief Amount of time (ms) after a call ends before its frames are counted.
+ *  (Frames arriving after this are counted as late, rather than received.)
+ */
+const uint32_t CALL_RETIRE_GRACE_MS = 2000U;
+
+const uint8_t TG_DIST_UNIFORM = 0U;
+const uint8_t TG_DIST_ZIPF = 1U;
+
+/** @brief Interval (ms) between DMR voice bursts (on a single slot). */
+const uint32_t DMR_FRAME_INTERVAL_MS = 60U;
+/** @brief Interval (ms) between P25 LDUs. */
+const uint32_t P25_FRAME_INTERVAL_MS = 180U;
+/** @brief Interval (ms) between NXDN voice frames. */
+const uint32_t NXDN_FRAME_INTERVAL_MS = 80U;
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Represents a histogram of fan-out latencies.
+ *
+ *  Buckets are 10us wide below 1ms, 100us below 10ms, 1ms below 100ms and 10ms below 1s, with a
+ *  single overflow bucket above that; so each bucket is at most ~10% of the latency it counts.
+ *
+ * @ingroup loadgen
+ */
+struct LatencyHistogram {
+    /**
+     * @brief Initializes a new instance of the LatencyHistogram struct.
+     */
+    LatencyHistogram()
+    {
+        for (uint32_t i = 0U; i < LATENCY_BUCKETS; i++)
+            buckets[i] = 0U;
+    }
+
+    /**
+     * @brief Adds a latency to the histogram.
+     * @param us Latency (microseconds).
+     */
+    void add(uint32_t us) { buckets[bucket(us)].fetch_add(1U, std::memory_order_relaxed); }
+
+    /**
+     * @brief Gets the bucket the given latency is counted in.
+     * @param us Latency (microseconds).
+     * @returns uint32_t Bucket.
+     */
+    static uint32_t bucket(uint32_t us)
+    {
+        if (us < 1000U)
+            return us / 10U;
+        if (us < 10000U)
+            return 100U + ((us - 1000U) / 100U);
+        if (us < 100000U)
+            return 190U + ((us - 10000U) / 1000U);
+        if (us < 1000000U)
+            return 280U + ((us - 100000U) / 10000U);
+        return LATENCY_BUCKETS - 1U;
+    }
+
+    /**
+     * @brief Gets the upper bound of the given bucket.
+     * @param bucket Bucket.
+     * @returns uint32_t Upper bound of the bucket (microseconds).
+     */
+    static uint32_t upperBound(uint32_t bucket)
+    {
+        if (bucket < 100U)
+            return (bucket + 1U) * 10U;
+        if (bucket < 190U)
+            return 1000U + ((bucket - 99U) * 100U);
+        if (bucket < 280U)
+            return 10000U + ((bucket - 189U) * 1000U);
+        if (bucket < LATENCY_BUCKETS - 1U)
+            return 100000U + ((bucket - 279U) * 10000U);
+        return 1000000U;
+    }
+
+    std::atomic<uint64_t> buckets[LATENCY_BUCKETS];
+};
+
+/**
+ * @brief Represents a call; shared by the call scheduler, the sending peer and the receiving peers.
+ * @ingroup loadgen
+ */
+struct CallSlot {
+    /**
+     * @brief Initializes a new instance of the CallSlot struct.
+     */
+    CallSlot() :
+        generation(0U),
+        txFrames(0U),
+        rxFrames(0U),
+        receivers(0U),
+        endTime(0U),
+        peer(0U),
+        tgIndex(0U),
+        active(false)
+    {
+        /* stub */
+    }
+
+    std::atomic<uint32_t> generation;               //! Generation, incremented each time the slot is reused.
+    std::atomic<uint32_t> txFrames;                 //! Number of voice frames sent.
+    std::atomic<uint32_t> rxFrames;                 //! Number of voice frames received (by all peers).
+    std::atomic<uint32_t> receivers;                //! Number of peers the FNE should repeat the call to.
+    std::atomic<uint64_t> endTime;                  //! Time the call ended (ms, 0 while in progress).
+
+    // the following are only used by the call scheduler
+    uint32_t peer;                                  //! Index of the sending peer.
+    uint32_t tgIndex;                               //! Index of the talkgroup.
+    bool active;                                    //! Flag indicating the slot is in use.
+};
+
+/**
+ * @brief Represents a request for a peer to start a call.
+ * @ingroup loadgen
+ */
+struct CallRequest {
+    uint32_t callSlot;                              //! Call slot.
+    uint16_t generation;                            //! Generation of the call slot.
+    uint32_t peer;                                  //! Index of the sending peer.
+    uint8_t mode;                                   //! Digital mode.
+    uint32_t srcId;                                 //! Source radio ID.
+    uint32_t tgIndex;                               //! Index of the talkgroup.
+    uint32_t dstId;                                 //! Destination talkgroup ID.
+    uint8_t slot;                                   //! DMR slot.
+    uint32_t duration;                              //! Call duration (ms).
+};
+
+/**
+ * @brief Represents a virtual peer, and the state of its current call and affiliations.
+ * @ingroup loadgen
+ */
+struct LoadGenPeer {
+    /**
+     * @brief Initializes a new instance of the LoadGenPeer struct.
+     */
+    LoadGenPeer() :
+        network(nullptr),
+        running(false),
+        busy(false),
+        opened(false),
+        inCall(false),
+        call(),
+        seqNo(0U),
+        nextFrame(0U),
+        callEnd(0U),
+        unitTG(),
+        affCount()
+    {
+        /* stub */
+    }
+
+    network::VirtualPeer* network;                  //! Peer network connection.
+    std::atomic<bool> running;                      //! Flag indicating the peer is logged in.
+    std::atomic<bool> busy;                         //! Flag indicating the peer has been given a call.
+
+    // the following are only used by the thread owning the peer
+    bool opened;                                    //! Flag indicating the network was opened.
+    bool inCall;                                    //! Flag indicating a call is in progress.
+    CallRequest call;                               //! Call in progress.
+    uint16_t seqNo;                                 //! Frame sequence number of the call.
+    uint64_t nextFrame;                             //! Time the next voice frame is due (us).
+    uint64_t callEnd;                               //! Time the call ends (us).
+
+    std::vector<uint32_t> unitTG;                   //! Talkgroup index each unit is affiliated to (or ~0U).
+    std::unordered_map<uint32_t, uint32_t> affCount; //! Number of units affiliated, by talkgroup index.
+};
+
+class HOST_SW_API HostLoadGen;
+
+/**
+ * @brief Represents a group of peers clocked by a single thread.
+ * @ingroup loadgen
+ */
+struct LoadGenShard {
+    /**
+     * @brief Initializes a new instance of the LoadGenShard struct.
+     */
+    LoadGenShard() :
+        host(nullptr),
+        index(0U),
+        peers(),
+        queueLock(),
+        queue(),
+        latency(),
+        txFrames(0U),
+        rxFrames(0U),
+        rxTagged(0U),
+        lateFrames(0U),
+        controlMsgs(0U),
+        random()
+    {
+        /* stub */
+    }
+
+    HostLoadGen* host;                              //! Load generator.
+    uint32_t index;                                 //! Index of the shard.
+    std::vector<uint32_t> peers;                    //! Indexes of the peers clocked by this shard.
+
+    std::mutex queueLock;                           //! Lock for the call request queue.
+    std::vector<CallRequest> queue;                 //! Call requests, for peers of this shard.
+
+    LatencyHistogram latency;                       //! Fan-out latency of received voice frames.
+    std::atomic<uint64_t> txFrames;                 //! Number of voice frames sent.
+    std::atomic<uint64_t> rxFrames;                 //! Number of frames received.
+    std::atomic<uint64_t> rxTagged;                 //! Number of tagged voice frames received.
+    std::atomic<uint64_t> lateFrames;               //! Number of tagged voice frames received for retired calls.
+    std::atomic<uint64_t> controlMsgs;              //! Number of control messages (affiliations, etc) sent.
+
+    std::mt19937 random;                            //! Random number generator.
+};
+
+/**
+ * @brief Represents the traffic totals for a reporting interval (or the whole run).
+ * @ingroup loadgen
+ */
+struct LoadGenTotals {
+    /**
+     * @brief Initializes a new instance of the LoadGenTotals struct.
+     */
+    LoadGenTotals() :
+        callsStarted(0U),
+        callsCompleted(0U),
+        callsBlocked(0U),
+        callsFailed(0U),
+        expectedFrames(0U),
+        receivedFrames(0U)
+    {
+        /* stub */
+    }
+
+    uint64_t callsStarted;                          //! Number of calls started.
+    uint64_t callsCompleted;                        //! Number of calls retired.
+    uint64_t callsBlocked;                          //! Number of calls not started (talkgroup busy or no free peer).
+    uint64_t callsFailed;                           //! Number of calls the sending peer could not start.
+    uint64_t expectedFrames;                        //! Number of frames the receiving peers should have received.
+    uint64_t receivedFrames;                        //! Number of frames the receiving peers received.
+};
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief This class implements the core load generator logic.
+ *
+ *  A number of virtual peers log into a FNE; a Poisson process starts group calls on randomly
+ *  chosen talkgroups and peers, and every voice frame sent is tagged (see network::FrameTag), so
+ *  the receiving peers can measure the fan-out latency through the FNE and count the frames lost.
+ *
+ * @ingroup loadgen
+ */
+class HOST_SW_API HostLoadGen {
+public:
+    /**
+     * @brief Initializes a new instance of the HostLoadGen class.
+     * @param confFile Full-path to the configuration file.
+     */
+    HostLoadGen(const std::string& confFile);
+    /**
+     * @brief Finalizes a instance of the HostLoadGen class.
+     */
+    ~HostLoadGen();
+
+    /**
+     * @brief Executes the main load generator processing loop.
+     * @returns int Zero if successful, otherwise error occurred.
+     */
+    int run();
+
+    /**
+     * @brief Writes the talkgroup rules for the configured talkgroups, for use by the FNE under test.
+     * @param rulesFile Full-path to the talkgroup rules file to write.
+     * @returns int Zero if successful, otherwise error occurred.
+     */
+    int writeTalkgroupRules(const std::string& rulesFile);
+
+private:
+    const std::string& m_confFile;
+    yaml::Node m_conf;
+
+    std::string m_address;
+    uint16_t m_port;
+    std::string m_password;
+    bool m_encrypted;
+    uint8_t m_presharedKey[AES_WRAPPED_PCKT_KEY_LEN];
+    bool m_debug;
+
+    uint32_t m_peerCount;
+    uint32_t m_peerIdBase;
+    uint32_t m_threadCount;
+    float m_loginRate;
+    uint32_t m_unitsPerPeer;
+    uint32_t m_srcIdBase;
+    bool m_affiliateOnLogin;
+
+    uint32_t m_tgBase;
+    uint32_t m_tgCount;
+    uint8_t m_tgDistribution;
+    float m_zipfExponent;
+    bool m_affiliatedOnly;
+
+    float m_callRate;
+    float m_callDuration;
+    float m_callMinDuration;
+    float m_callMaxDuration;
+    uint32_t m_modeWeight[3U];
+
+    float m_affiliationRate;
+    float m_registrationRate;
+    float m_grantRate;
+
+    uint32_t m_reportInterval;
+    std::string m_statsFile;
+    pid_t m_fnePid;
+    uint32_t m_duration;
+
+    std::vector<LoadGenPeer*> m_peers;
+    std::vector<LoadGenShard*> m_shards;
+    std::atomic<uint32_t> m_peersRunning;
+    std::atomic<uint32_t> m_shardsRunning;
+    std::atomic<bool> m_running;
+
+    CallSlot* m_calls;
+    std::vector<uint32_t> m_freeCalls;
+    std::vector<uint32_t> m_activeCalls;
+
+    std::vector<bool> m_tgBusy;
+    std::atomic<uint32_t>* m_tgAffPeers;
+    std::vector<double> m_tgWeights;
+
+    std::mt19937 m_random;
+
+    LoadGenTotals m_interval;
+    LoadGenTotals m_total;
+
+    uint64_t m_lastTxFrames;
+    uint64_t m_lastRxFrames;
+    uint64_t m_lastLateFrames;
+    uint64_t m_lastControlMsgs;
+    std::vector<uint64_t> m_lastLatency;
+
+    uint64_t m_fneTicks;
+    uint64_t m_ownTicks;
+    double m_fneCpuSum;
+    uint32_t m_fneCpuSamples;
+
+    FILE* m_statsFp;
+
+    /**
+     * @brief Reads basic configuration parameters from the YAML configuration file.
+     * @returns bool True, if configuration was read, otherwise false.
+     */
+    bool readParams();
+    /**
+     * @brief Initializes the virtual peers, and the threads that clock them.
+     * @returns bool True, if the peers were initialized, otherwise false.
+     */
+    bool createPeers();
+
+    /**
+     * @brief Helper to pick a talkgroup, from the configured distribution.
+     * @param random Random number generator.
+     * @returns uint32_t Index of the talkgroup.
+     */
+    uint32_t pickTalkgroup(std::mt19937& random);
+    /**
+     * @brief Helper to pick a digital mode, from the configured mode weights.
+     * @param random Random number generator.
+     * @returns uint8_t Digital mode.
+     */
+    uint8_t pickMode(std::mt19937& random);
+    /**
+     * @brief Helper to get the DMR slot carrying the given talkgroup.
+     * @param tgIndex Index of the talkgroup.
+     * @returns uint8_t DMR slot.
+     */
+    uint8_t talkgroupSlot(uint32_t tgIndex) const { return (uint8_t)(((m_tgBase + tgIndex) % 2U) + 1U); }
+    /**
+     * @brief Helper to get the radio ID of the given unit of a peer.
+     * @param peer Index of the peer.
+     * @param unit Index of the unit.
+     * @returns uint32_t Radio ID.
+     */
+    uint32_t unitId(uint32_t peer, uint32_t unit) const { return m_srcIdBase + (peer * m_unitsPerPeer) + unit; }
+
+    /**
+     * @brief Starts a new call, on a randomly chosen talkgroup and peer.
+     */
+    void startCall();
+    /**
+     * @brief Retires calls that ended, counting the frames received.
+     * @param now Current time (ms).
+     * @param force Flag indicating all calls are retired (when stopping).
+     */
+    void retireCalls(uint64_t now, bool force);
+    /**
+     * @brief Writes the statistics of a reporting interval.
+     * @param elapsed Length of the interval (ms).
+     * @param last Flag indicating this is the final report.
+     */
+    void report(uint64_t elapsed, bool last);
+
+    /**
+     * @brief Processes a peer of a shard; clocking the network, reading the received frames and
+     *  sending the frames of the peers call.
+     * @param shard Shard owning the peer.
+     * @param peer Index of the peer.
+     * @param ms Time (ms) since the last clock.
+     * @param drain Flag indicating the network has received data waiting.
+     * @param tags Scratch list of frame tags.
+     */
+    void clockPeer(LoadGenShard* shard, uint32_t peer, uint32_t ms, bool drain, std::vector<network::FrameTag>& tags);
+    /**
+     * @brief Sends a random control message (affiliation, registration or grant request) from a
+     *  random peer of a shard.
+     * @param shard Shard owning the peer.
+     * @param type Control message type (0 affiliation, 1 registration, 2 grant request).
+     */
+    void sendControl(LoadGenShard* shard, uint32_t type);
+    /**
+     * @brief Helper to (re-)affiliate a unit of a peer to the given talkgroup.
+     * @param peer Index of the peer.
+     * @param unit Index of the unit.
+     * @param tgIndex Index of the talkgroup.
+     */
+    void affiliate(uint32_t peer, uint32_t unit, uint32_t tgIndex);
+
+    /**
+     * @brief Entry point to a shard thread, that clocks a group of peers.
+     * @param arg Instance of the thread_t structure.
+     * @returns void* (Ignore)
+     */
+    static void* threadShard(void* arg);
+};
+
+#endif // __HOST_LOADGEN_H__
@@ -0,0 +1,427 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "loadgen/Defines.h"
+#include "common/dmr/data/EMB.h"
+#include "common/dmr/data/NetData.h"
+#include "common/dmr/lc/FullLC.h"
+#include "common/dmr/SlotType.h"
+#include "common/network/json/json.h"
+#include "common/nxdn/NXDNDefines.h"
+#include "common/Utils.h"
+#include "network/VirtualPeer.h"
+
+using namespace network;
+
+#include <cassert>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/** @brief Offset of the DMR burst in a received DMR message. */
+const uint32_t DMR_MSG_DATA_OFFSET = 20U;
+/** @brief Offset of the IMBE of the first DFSI voice frame in a received P25 LDU1/LDU2 message. */
+const uint32_t P25_MSG_IMBE_OFFSET = 24U + 10U;
+/** @brief Offset of the NXDN frame in a received NXDN message. */
+const uint32_t NXDN_MSG_DATA_OFFSET = 24U;
+
+/** @brief Offset of the voice payload in a NXDN frame (past the leading tag bytes, FSW, LICH and SACCH). */
+const uint32_t NXDN_VOICE_OFFSET = 2U + nxdn::defines::NXDN_FSW_LICH_SACCH_LENGTH_BYTES;
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the VirtualPeer class. */
+
+VirtualPeer::VirtualPeer(const std::string& address, uint16_t port, uint32_t peerId, const std::string& password, bool debug) :
+    Network(address, port, 0U, peerId, password, true, debug, true, true, true, true, true, false, false, false, false),
+    m_txMode(0U),
+    m_txSrcId(0U),
+    m_txDstId(0U),
+    m_txSlot(1U),
+    m_txFrames(0U),
+    m_dmrSeqNo(0U),
+    m_dmrEmbeddedData(),
+    m_p25LC(),
+    m_p25LSD(),
+    m_p25Audio(),
+    m_p25LDU(nullptr),
+    m_nxdnLC()
+{
+    assert(!address.empty());
+    assert(port > 0U);
+    assert(!password.empty());
+
+    using namespace p25::defines;
+
+    // only the first IMBE codeword of a LDU carries the tag, the rest are always null IMBE
+    m_p25LDU = new uint8_t[P25_LDU_FRAME_LENGTH_BYTES];
+    ::memset(m_p25LDU, 0x00U, P25_LDU_FRAME_LENGTH_BYTES);
+    for (uint32_t n = 0U; n < 9U; n++)
+        m_p25Audio.encode(m_p25LDU, NULL_IMBE, n);
+}
+
+/* Finalizes a instance of the VirtualPeer class. */
+
+VirtualPeer::~VirtualPeer()
+{
+    delete[] m_p25LDU;
+}
+
+/* Starts a new call, writing the voice header (for DMR). */
+
+void VirtualPeer::writeCallStart(uint8_t mode, uint32_t srcId, uint32_t dstId, uint8_t slot)
+{
+    m_txMode = mode;
+    m_txSrcId = srcId;
+    m_txDstId = dstId;
+    m_txSlot = slot;
+    m_txFrames = 0U;
+    m_dmrSeqNo = 0U;
+
+    switch (mode) {
+    case LOADGEN_MODE_DMR:
+        {
+            using namespace dmr;
+            using namespace dmr::defines;
+
+            uint8_t data[DMR_FRAME_LENGTH_BYTES];
+            ::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES);
+
+            // generate DMR LC
+            lc::LC dmrLC = lc::LC();
+            dmrLC.setFLCO(FLCO::GROUP);
+            dmrLC.setSrcId(srcId);
+            dmrLC.setDstId(dstId);
+            m_dmrEmbeddedData.setLC(dmrLC);
+
+            // generate the Slot Type
+            SlotType slotType = SlotType();
+            slotType.setDataType(DataType::VOICE_LC_HEADER);
+            slotType.encode(data);
+
+            lc::FullLC fullLC = lc::FullLC();
+            fullLC.encode(dmrLC, data, DataType::VOICE_LC_HEADER);
+
+            writeDMRFrame(DataType::VOICE_LC_HEADER, data);
+        }
+        break;
+    case LOADGEN_MODE_P25:
+        {
+            using namespace p25::defines;
+
+            m_p25LC = p25::lc::LC();
+            m_p25LC.setLCO(LCO::GROUP);
+            m_p25LC.setGroup(true);
+            m_p25LC.setPriority(4U);
+            m_p25LC.setSrcId(srcId);
+            m_p25LC.setDstId(dstId);
+
+            m_p25LSD = p25::data::LowSpeedData();
+        }
+        break;
+    case LOADGEN_MODE_NXDN:
+        {
+            using namespace nxdn::defines;
+
+            m_nxdnLC = nxdn::lc::RTCH();
+            m_nxdnLC.setMessageType(MessageType::RTCH_VCALL);
+            m_nxdnLC.setSrcId((uint16_t)srcId);
+            m_nxdnLC.setDstId((uint16_t)dstId);
+            m_nxdnLC.setGroup(true);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/* Writes a single tagged voice frame for the current call. */
+
+bool VirtualPeer::writeCallVoice(const FrameTag& tag)
+{
+    bool ret = false;
+    switch (m_txMode) {
+    case LOADGEN_MODE_DMR:
+        {
+            using namespace dmr;
+            using namespace dmr::defines;
+
+            uint8_t data[DMR_FRAME_LENGTH_BYTES];
+            ::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES);
+            encodeTag(tag, data);
+
+            // the tag sits in the first AMBE frame, clear of the sync/embedded signalling
+            uint8_t n = (uint8_t)(m_txFrames % 6U);
+            DataType::E dataType = DataType::VOICE_SYNC;
+            if (n > 0U) {
+                dataType = DataType::VOICE;
+
+                uint8_t lcss = m_dmrEmbeddedData.getData(data, n);
+
+                // generated embedded signalling
+                data::EMB emb = data::EMB();
+                emb.setColorCode(0U);
+                emb.setLCSS(lcss);
+                emb.encode(data);
+            }
+
+            ret = writeDMRFrame(dataType, data);
+        }
+        break;
+    case LOADGEN_MODE_P25:
+        {
+            using namespace p25::defines;
+
+            uint8_t imbe[RAW_IMBE_LENGTH_BYTES];
+            encodeTag(tag, imbe);
+            m_p25Audio.encode(m_p25LDU, imbe, 0U);
+
+            // LDU1 and LDU2 alternate, the first LDU1 of the call carries the call start
+            if ((m_txFrames % 2U) == 0U) {
+                ret = writeP25LDU1(m_p25LC, m_p25LSD, m_p25LDU, (m_txFrames == 0U) ? FrameType::HDU_VALID : FrameType::DATA_UNIT);
+            }
+            else {
+                ret = writeP25LDU2(m_p25LC, m_p25LSD, m_p25LDU);
+            }
+        }
+        break;
+    case LOADGEN_MODE_NXDN:
+        {
+            using namespace nxdn::defines;
+
+            uint8_t data[NXDN_FRAME_LENGTH_BYTES + 2U];
+            ::memset(data, 0x00U, NXDN_FRAME_LENGTH_BYTES + 2U);
+            encodeTag(tag, data + NXDN_VOICE_OFFSET);
+
+            ret = writeNXDN(m_nxdnLC, data, NXDN_FRAME_LENGTH_BYTES + 2U);
+        }
+        break;
+    default:
+        break;
+    }
+
+    m_txFrames++;
+    return ret;
+}
+
+/* Ends the current call, writing the call terminator. */
+
+void VirtualPeer::writeCallEnd()
+{
+    switch (m_txMode) {
+    case LOADGEN_MODE_DMR:
+        {
+            using namespace dmr;
+            using namespace dmr::defines;
+
+            uint8_t data[DMR_FRAME_LENGTH_BYTES];
+            ::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES);
+
+            // generate DMR LC
+            lc::LC dmrLC = lc::LC();
+            dmrLC.setFLCO(FLCO::GROUP);
+            dmrLC.setSrcId(m_txSrcId);
+            dmrLC.setDstId(m_txDstId);
+
+            // generate the Slot Type
+            SlotType slotType = SlotType();
+            slotType.setDataType(DataType::TERMINATOR_WITH_LC);
+            slotType.encode(data);
+
+            lc::FullLC fullLC = lc::FullLC();
+            fullLC.encode(dmrLC, data, DataType::TERMINATOR_WITH_LC);
+
+            writeDMRFrame(DataType::TERMINATOR_WITH_LC, data);
+            resetDMR(m_txSlot);
+        }
+        break;
+    case LOADGEN_MODE_P25:
+        writeP25TDU(m_p25LC, m_p25LSD);
+        resetP25();
+        break;
+    case LOADGEN_MODE_NXDN:
+        {
+            using namespace nxdn::defines;
+
+            uint8_t data[NXDN_FRAME_LENGTH_BYTES + 2U];
+            ::memset(data, 0x00U, NXDN_FRAME_LENGTH_BYTES + 2U);
+
+            nxdn::lc::RTCH lc = m_nxdnLC;
+            lc.setMessageType(MessageType::RTCH_TX_REL);
+            writeNXDN(lc, data, NXDN_FRAME_LENGTH_BYTES + 2U);
+            resetNXDN();
+        }
+        break;
+    default:
+        break;
+    }
+
+    m_txMode = 0U;
+}
+
+/* Reads all received traffic, and decodes the tags of the received voice frames. */
+
+uint32_t VirtualPeer::readTags(std::vector<FrameTag>& tags)
+{
+    uint32_t frames = 0U;
+    FrameTag tag;
+
+    // DMR voice bursts (data sync frames carry no tag)
+    while (true) {
+        bool ret = false;
+        uint32_t length = 0U;
+        UInt8Array buffer = readDMR(ret, length);
+        if (!ret)
+            break;
+
+        frames++;
+        if (length >= DMR_MSG_DATA_OFFSET + FRAME_TAG_LENGTH_BYTES && (buffer[15U] & 0x20U) == 0x00U &&
+            decodeTag(buffer.get() + DMR_MSG_DATA_OFFSET, tag))
+            tags.push_back(tag);
+    }
+
+    // P25 LDU1 and LDU2
+    while (true) {
+        bool ret = false;
+        uint32_t length = 0U;
+        UInt8Array buffer = readP25(ret, length);
+        if (!ret)
+            break;
+
+        frames++;
+        uint8_t duid = buffer[22U];
+        if ((duid == p25::defines::DUID::LDU1 || duid == p25::defines::DUID::LDU2) &&
+            length >= P25_MSG_IMBE_OFFSET + FRAME_TAG_LENGTH_BYTES && decodeTag(buffer.get() + P25_MSG_IMBE_OFFSET, tag))
+            tags.push_back(tag);
+    }
+
+    // NXDN voice frames
+    while (true) {
+        bool ret = false;
+        uint32_t length = 0U;
+        UInt8Array buffer = readNXDN(ret, length);
+        if (!ret)
+            break;
+
+        frames++;
+        if (buffer[4U] == nxdn::defines::MessageType::RTCH_VCALL &&
+            length >= NXDN_MSG_DATA_OFFSET + NXDN_VOICE_OFFSET + FRAME_TAG_LENGTH_BYTES &&
+            decodeTag(buffer.get() + NXDN_MSG_DATA_OFFSET + NXDN_VOICE_OFFSET, tag))
+            tags.push_back(tag);
+    }
+
+    return frames;
+}
+
+/* Helper to encode a frame tag. */
+
+void VirtualPeer::encodeTag(const FrameTag& tag, uint8_t* data)
+{
+    assert(data != nullptr);
+
+    data[0U] = FRAME_TAG_MAGIC;
+    __SET_UINT16B(tag.callSlot, data, 1U);
+    __SET_UINT16B(tag.generation, data, 3U);
+    __SET_UINT16B(tag.seqNo, data, 5U);
+    __SET_UINT32(tag.timestamp, data, 7U);
+}
+
+/* Helper to decode a frame tag. */
+
+bool VirtualPeer::decodeTag(const uint8_t* data, FrameTag& tag)
+{
+    assert(data != nullptr);
+
+    if (data[0U] != FRAME_TAG_MAGIC)
+        return false;
+
+    tag.callSlot = __GET_UINT16B(data, 1U);
+    tag.generation = __GET_UINT16B(data, 3U);
+    tag.seqNo = __GET_UINT16B(data, 5U);
+    tag.timestamp = __GET_UINT32(data, 7U);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+//  Protected Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to create the configuration sent to the network. */
+
+json::object VirtualPeer::createConfig()
+{
+    const char* software = __NETVER__;
+
+    json::object config = json::object();
+
+    // identity and frequency
+    config["identity"].set<std::string>(m_identity);                                // Identity
+    config["rxFrequency"].set<uint32_t>(m_rxFrequency);                             // Rx Frequency
+    config["txFrequency"].set<uint32_t>(m_txFrequency);                             // Tx Frequency
+
+    // system info
+    json::object sysInfo = json::object();
+    sysInfo["latitude"].set<float>(m_latitude);                                     // Latitude
+    sysInfo["longitude"].set<float>(m_longitude);                                   // Longitude
+
+    sysInfo["height"].set<int>(m_height);                                           // Height
+    sysInfo["location"].set<std::string>(m_location);                               // Location
+    config["info"].set<json::object>(sysInfo);
+
+    // channel data
+    json::object channel = json::object();
+    channel["txPower"].set<uint32_t>(m_power);                                      // Tx Power
+    channel["txOffsetMhz"].set<float>(m_txOffsetMhz);                               // Tx Offset (Mhz)
+    channel["chBandwidthKhz"].set<float>(m_chBandwidthKhz);                         // Ch. Bandwidth (khz)
+    channel["channelId"].set<uint8_t>(m_channelId);                                 // Channel ID
+    channel["channelNo"].set<uint32_t>(m_channelNo);                                // Channel No
+    config["channel"].set<json::object>(channel);
+
+    // RCON
+    json::object rcon = json::object();
+    rcon["password"].set<std::string>(m_restApiPassword);                           // REST API Password
+    rcon["port"].set<uint16_t>(m_restApiPort);                                      // REST API Port
+    config["rcon"].set<json::object>(rcon);
+
+    config["software"].set<std::string>(std::string(software));                 // Software ID
+
+    return config;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to write a DMR frame for the current call. */
+
+bool VirtualPeer::writeDMRFrame(dmr::defines::DataType::E dataType, const uint8_t* data)
+{
+    using namespace dmr;
+    using namespace dmr::defines;
+
+    // generate DMR network frame
+    data::NetData dmrData;
+    dmrData.setSlotNo(m_txSlot);
+    dmrData.setDataType(dataType);
+    dmrData.setSrcId(m_txSrcId);
+    dmrData.setDstId(m_txDstId);
+    dmrData.setFLCO(FLCO::GROUP);
+    dmrData.setN((dataType == DataType::VOICE) ? (uint8_t)(m_txFrames % 6U) : 0U);
+    dmrData.setSeqNo((uint8_t)m_dmrSeqNo);
+    dmrData.setBER(0U);
+    dmrData.setRSSI(0U);
+
+    dmrData.setData(data);
+
+    m_dmrSeqNo++;
+    return writeDMR(dmrData, false);
+}
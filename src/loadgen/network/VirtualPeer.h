@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @defgroup loadgen_network Networking
+ * @brief Implementation for the load generator networking.
+ * @ingroup loadgen
+ *
+ * @file VirtualPeer.h
+ * @ingroup loadgen_network
+ * @file VirtualPeer.cpp
+ * @ingroup loadgen_network
+ */
+#if !defined(__VIRTUAL_PEER_H__)
+#define __VIRTUAL_PEER_H__
+
+#include "Defines.h"
+#include "common/dmr/data/EmbeddedData.h"
+#include "common/p25/P25Defines.h"
+#include "common/p25/Audio.h"
+#include "common/p25/lc/LC.h"
+#include "common/p25/data/LowSpeedData.h"
+#include "common/nxdn/lc/RTCH.h"
+#include "host/network/Network.h"
+
+#include <string>
+#include <cstdint>
+#include <vector>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    const uint8_t   FRAME_TAG_MAGIC = 0xA5U;
+    const uint32_t  FRAME_TAG_LENGTH_BYTES = 11U;
+
+    const uint8_t   LOADGEN_MODE_DMR = 1U;
+    const uint8_t   LOADGEN_MODE_P25 = 2U;
+    const uint8_t   LOADGEN_MODE_NXDN = 3U;
+
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents the tag carried in the voice payload of every generated voice frame.
+     *
+     *  The tag takes the place of one vocoder frame (the first IMBE codeword of a P25 LDU, the first
+     *  11 bytes of a DMR voice burst or the start of the NXDN voice payload). The FNE never touches the
+     *  voice payload, so the tag arrives at every receiving peer as it was sent.
+     *
+     * @ingroup loadgen_network
+     */
+    struct FrameTag {
+        uint16_t callSlot;                  //! Call slot the frame belongs to.
+        uint16_t generation;                //! Generation of the call slot (low 16 bits).
+        uint16_t seqNo;                     //! Frame sequence number within the call.
+        uint32_t timestamp;                 //! Transmit time (microseconds, wraps).
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements a virtual peer, that generates tagged voice traffic for a single call at a time.
+     * @ingroup loadgen_network
+     */
+    class HOST_SW_API VirtualPeer : public Network {
+    public:
+        /**
+         * @brief Initializes a new instance of the VirtualPeer class.
+         * @param address Network Hostname/IP address to connect to.
+         * @param port Network port number.
+         * @param peerId Unique ID on the network.
+         * @param password Network authentication password.
+         * @param debug Flag indicating whether network debug is enabled.
+         */
+        VirtualPeer(const std::string& address, uint16_t port, uint32_t peerId, const std::string& password, bool debug);
+        /**
+         * @brief Finalizes a instance of the VirtualPeer class.
+         */
+        ~VirtualPeer() override;
+
+        /**
+         * @brief Gets the network socket.
+         * @returns udp::Socket* Network socket.
+         */
+        udp::Socket* socket() const { return m_socket; }
+
+        /**
+         * @brief Starts a new call, writing the voice header (for DMR).
+         * @param mode Digital mode of the call.
+         * @param srcId Source radio ID.
+         * @param dstId Destination talkgroup ID.
+         * @param slot DMR slot.
+         */
+        void writeCallStart(uint8_t mode, uint32_t srcId, uint32_t dstId, uint8_t slot);
+        /**
+         * @brief Writes a single tagged voice frame for the current call.
+         *  (A DMR voice burst, a P25 LDU1 or LDU2, or a NXDN voice frame.)
+         * @param tag Frame tag.
+         * @returns bool True, if the frame was written, otherwise false.
+         */
+        bool writeCallVoice(const FrameTag& tag);
+        /**
+         * @brief Ends the current call, writing the call terminator.
+         */
+        void writeCallEnd();
+
+        /**
+         * @brief Reads all received traffic, and decodes the tags of the received voice frames.
+         * @param[out] tags List of received frame tags.
+         * @returns uint32_t Number of frames received (tagged or not).
+         */
+        uint32_t readTags(std::vector<FrameTag>& tags);
+
+        /**
+         * @brief Helper to encode a frame tag.
+         * @param tag Frame tag.
+         * @param[out] data Buffer to encode the tag to.
+         */
+        static void encodeTag(const FrameTag& tag, uint8_t* data);
+        /**
+         * @brief Helper to decode a frame tag.
+         * @param[in] data Buffer containing the tag.
+         * @param[out] tag Frame tag.
+         * @returns bool True, if the buffer contained a frame tag, otherwise false.
+         */
+        static bool decodeTag(const uint8_t* data, FrameTag& tag);
+
+    protected:
+        /**
+         * @brief Helper to create the configuration sent to the network.
+         * @returns json::object Configuration.
+         */
+        json::object createConfig() override;
+
+    private:
+        uint8_t m_txMode;
+        uint32_t m_txSrcId;
+        uint32_t m_txDstId;
+        uint8_t m_txSlot;
+        uint32_t m_txFrames;
+
+        uint32_t m_dmrSeqNo;
+        dmr::data::EmbeddedData m_dmrEmbeddedData;
+
+        p25::lc::LC m_p25LC;
+        p25::data::LowSpeedData m_p25LSD;
+        p25::Audio m_p25Audio;
+        uint8_t* m_p25LDU;
+
+        nxdn::lc::RTCH m_nxdnLC;
+
+        /**
+         * @brief Helper to write a DMR frame for the current call.
+         * @param dataType DMR data type.
+         * @param data Buffer containing the DMR frame.
+         * @returns bool True, if the frame was written, otherwise false.
+         */
+        bool writeDMRFrame(dmr::defines::DataType::E dataType, const uint8_t* data);
+    };
+} // namespace network
+
+#endif // __VIRTUAL_PEER_H__
@@ -10,6 +10,7 @@
 #include "Defines.h"
 #include "common/yaml/Yaml.h"
 #include "common/Log.h"
+#include "remote/RESTClient.h"
 #include "MonitorMain.h"
 #include "MonitorApplication.h"
 #include "MonitorMainWnd.h"
@@ -239,6 +240,7 @@ int main(int argc, char** argv)
     app.redraw();
     
     int _errno = app.exec();
+    RESTClient::closeConnections();
     ::LogFinalise();
     return _errno;
 }
@@ -60,6 +60,8 @@ public:
     {
         __InternalOutputStream(m_logWnd);
 
+        m_statusTimerId = addTimer(250); // starts the timer every 250 milliseconds
+
         // file menu
         m_quitItem.addAccelerator(FKey::Meta_x); // Meta/Alt + X
         m_quitItem.addCallback("clicked", getFApplication(), &FApplication::cb_exitApp, this);
@@ -124,6 +126,8 @@ private:
     std::vector<NodeStatusWnd*> m_nodes;
     uint32_t m_activeNodeId = 0U;
 
+    int m_statusTimerId;
+
     lookups::VoiceChData m_selectedCh;
 
     FString m_line{13, UniChar::BoxDrawingsHorizontal};
@@ -256,6 +260,39 @@ private:
         }
     }
 
+    /**
+     * @brief Event that occurs on interval by timer.
+     * @param timer Timer Event
+     */
+    void onTimer(FTimerEvent* timer) override
+    {
+        if (timer != nullptr && timer->getTimerId() == m_statusTimerId) {
+            // callback REST API to get the status of every responding node at once, rather than
+            // each node window polling (and waiting) on its own
+            std::vector<NodeStatusWnd*> nodes;
+            std::vector<RESTClient::BatchRequest> requests;
+            for (auto* wnd : m_nodes) {
+                if (wnd->isFailed()) {
+                    continue;
+                }
+
+                lookups::VoiceChData chData = wnd->getChData();
+                requests.push_back(RESTClient::BatchRequest { chData.address(), chData.port(), chData.password(), chData.ssl(),
+                    HTTP_GET, GET_STATUS, json::object(), json::object(), EXIT_SUCCESS });
+                nodes.push_back(wnd);
+            }
+
+            if (requests.empty()) {
+                return;
+            }
+
+            RESTClient::sendBatch(requests, REST_DEFAULT_WAIT, g_debug);
+            for (size_t i = 0U; i < nodes.size(); i++) {
+                nodes[i]->updateStatus(requests[i].ret, requests[i].response);
+            }
+        }
+    }
+
     /**
      * @brief Event that occurs when the window is shown.
      * @param e Show Event
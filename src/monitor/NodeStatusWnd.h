@@ -48,7 +48,6 @@ public:
      */
     explicit NodeStatusWnd(FWidget* widget = nullptr) : FDialog{widget}
     {
-        m_timerId = addTimer(250); // starts the timer every 250 milliseconds
         m_reconnectTimerId = addTimer(15000); // starts the timer every 10 seconds
     }
     /**
@@ -112,8 +111,145 @@ public:
      */
     uint32_t getPeerId() const { return m_peerId; }
 
+    /**
+     * @brief Updates the node status from a GET_STATUS response.
+     * @param ret REST API status (or error code) of the status request.
+     * @param rsp REST API status response.
+     */
+    void updateStatus(int ret, json::object& rsp)
+    {
+        if (m_failed) {
+            return;
+        }
+
+        if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
+            ::LogError(LOG_HOST, "failed to get status for %s:%u, chNo = %u", m_chData.address().c_str(), m_chData.port(), m_channelNo);
+            ++m_failCnt;
+            if (m_failCnt > NODE_UPDATE_FAIL_CNT) {
+                m_failed = true;
+                setText("FAILED");
+            }
+        }
+        else {
+            try {
+                m_failCnt = 0U;
+
+                uint8_t mode = rsp["state"].get<uint8_t>();
+                switch (mode) {
+                case modem::STATE_DMR:
+                    m_modeStr.setText("DMR");
+                    break;
+                case modem::STATE_P25:
+                    m_modeStr.setText("P25");
+                    break;
+                case modem::STATE_NXDN:
+                    m_modeStr.setText("NXDN");
+                    break;
+                default:
+                    m_modeStr.setText("");
+                    break;
+                }
+
+                if (rsp["peerId"].is<uint32_t>()) {
+                    m_peerId = rsp["peerId"].get<uint32_t>();
+                    m_peerIdStr.setText(__INT_STR(m_peerId));
+                }
+
+                // get remote node state
+                if (rsp["dmrTSCCEnable"].is<bool>() && rsp["p25CtrlEnable"].is<bool>() &&
+                    rsp["nxdnCtrlEnable"].is<bool>()) {
+                    bool dmrTSCCEnable = rsp["dmrTSCCEnable"].get<bool>();
+                    bool dmrCC = rsp["dmrCC"].get<bool>();
+                    bool p25CtrlEnable = rsp["p25CtrlEnable"].get<bool>();
+                    bool p25CC = rsp["p25CC"].get<bool>();
+                    bool nxdnCtrlEnable = rsp["nxdnCtrlEnable"].get<bool>();
+                    bool nxdnCC = rsp["nxdnCC"].get<bool>();
+
+                    // are we a dedicated control channel?
+                    if (dmrCC || p25CC || nxdnCC) {
+                        m_control = true;
+                        setText("CONTROL");
+                    }
+
+                    // if we aren't a dedicated control channel; set our
+                    // title bar appropriately and set Tx state
+                    if (!m_control) {
+                        if (dmrTSCCEnable || p25CtrlEnable || nxdnCtrlEnable) {
+                            setText("ENH. VOICE/CONV");
+                        }
+                        else {
+                            setText("VOICE/CONV");
+                        }
+
+                        // are we transmitting?
+                        if (rsp["tx"].is<bool>()) {
+                            m_tx = rsp["tx"].get<bool>();
+                        }
+                        else {
+                            ::LogWarning(LOG_HOST, "%s:%u, does not report Tx status");
+                            m_tx = false;
+                        }
+                    }
+                }
+
+                // get the remote node channel information
+                if (rsp["channelId"].is<uint8_t>() && rsp["channelNo"].is<uint32_t>()) {
+                    uint8_t channelId = rsp["channelId"].get<uint8_t>();
+                    uint32_t channelNo = rsp["channelNo"].get<uint32_t>();
+
+                    if (m_channelId != channelId && m_channelNo != channelNo) {
+                        m_channelId = channelId;
+                        m_channelNo = channelNo;
+
+                        calculateRxTx();
+                    }
+                }
+                else {
+                    ::LogWarning(LOG_HOST, "%s:%u, does not report channel information");
+                }
+
+                // report last known transmitted destination ID
+                if (rsp["lastDstId"].is<uint32_t>()) {
+                    uint32_t lastDstId = rsp["lastDstId"].get<uint32_t>();
+                    if (lastDstId == 0) {
+                        m_lastDst.setText("None");
+                    }
+                    else {
+                        m_lastDst.setText(__INT_STR(lastDstId));
+                    }
+                }
+                else {
+                    ::LogWarning(LOG_HOST, "%s:%u, does not report last TG information");
+                }
+
+                // report last known transmitted source ID
+                if (rsp["lastSrcId"].is<uint32_t>()) {
+                    uint32_t lastSrcId = rsp["lastSrcId"].get<uint32_t>();
+                    if (lastSrcId == 0) {
+                        m_lastSrc.setText("None");
+                    }
+                    else {
+                        m_lastSrc.setText(__INT_STR(lastSrcId));
+                    }
+                }
+                else {
+                    ::LogWarning(LOG_HOST, "%s:%u, does not report last source information");
+                }
+            }
+            catch (std::exception& e) {
+                ::LogWarning(LOG_HOST, "%s:%u, failed to properly handle status, %s", m_chData.address().c_str(), m_chData.port(), e.what());
+            }
+        }
+
+        redraw();
+    }
+    /**
+     * @brief Helper to determine if the node has failed to respond and is waiting to reconnect.
+     * @returns bool True, if the node has failed, otherwise false.
+     */
+    bool isFailed() const { return m_failed; }
+
 private:
-    int m_timerId;
     int m_reconnectTimerId;
 
     uint8_t m_failCnt = 0U;
@@ -291,138 +427,6 @@ private:
     void onTimer(FTimerEvent* timer) override
     {
         if (timer != nullptr) {
-            // update timer
-            if (timer->getTimerId() == m_timerId) {
-                if (!m_failed) {
-                    // callback REST API to get status of the channel we represent
-                    json::object req = json::object();
-                    json::object rsp = json::object();
-                
-                    int ret = RESTClient::send(m_chData.address(), m_chData.port(), m_chData.password(),
-                        HTTP_GET, GET_STATUS, req, rsp, m_chData.ssl(), g_debug);
-                    if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
-                        ::LogError(LOG_HOST, "failed to get status for %s:%u, chNo = %u", m_chData.address().c_str(), m_chData.port(), m_channelNo);
-                        ++m_failCnt;
-                        if (m_failCnt > NODE_UPDATE_FAIL_CNT) {
-                            m_failed = true;
-                            setText("FAILED");
-                        }
-                    }
-                    else {
-                        try {
-                            m_failCnt = 0U;
-
-                            uint8_t mode = rsp["state"].get<uint8_t>();
-                            switch (mode) {
-                            case modem::STATE_DMR:
-                                m_modeStr.setText("DMR");
-                                break;
-                            case modem::STATE_P25:
-                                m_modeStr.setText("P25");
-                                break;
-                            case modem::STATE_NXDN:
-                                m_modeStr.setText("NXDN");
-                                break;
-                            default:
-                                m_modeStr.setText("");
-                                break;
-                            }
-
-                            if (rsp["peerId"].is<uint32_t>()) {
-                                m_peerId = rsp["peerId"].get<uint32_t>();
-                                m_peerIdStr.setText(__INT_STR(m_peerId));
-                            }
-
-                            // get remote node state
-                            if (rsp["dmrTSCCEnable"].is<bool>() && rsp["p25CtrlEnable"].is<bool>() &&
-                                rsp["nxdnCtrlEnable"].is<bool>()) {
-                                bool dmrTSCCEnable = rsp["dmrTSCCEnable"].get<bool>();
-                                bool dmrCC = rsp["dmrCC"].get<bool>();
-                                bool p25CtrlEnable = rsp["p25CtrlEnable"].get<bool>();
-                                bool p25CC = rsp["p25CC"].get<bool>();
-                                bool nxdnCtrlEnable = rsp["nxdnCtrlEnable"].get<bool>();
-                                bool nxdnCC = rsp["nxdnCC"].get<bool>();
-
-                                // are we a dedicated control channel?
-                                if (dmrCC || p25CC || nxdnCC) {
-                                    m_control = true;
-                                    setText("CONTROL");
-                                }
-
-                                // if we aren't a dedicated control channel; set our
-                                // title bar appropriately and set Tx state
-                                if (!m_control) {
-                                    if (dmrTSCCEnable || p25CtrlEnable || nxdnCtrlEnable) {
-                                        setText("ENH. VOICE/CONV");
-                                    }
-                                    else {
-                                        setText("VOICE/CONV");
-                                    }
-
-                                    // are we transmitting?
-                                    if (rsp["tx"].is<bool>()) {
-                                        m_tx = rsp["tx"].get<bool>();
-                                    }
-                                    else {
-                                        ::LogWarning(LOG_HOST, "%s:%u, does not report Tx status");
-                                        m_tx = false;
-                                    }
-                                }
-                            }
-
-                            // get the remote node channel information
-                            if (rsp["channelId"].is<uint8_t>() && rsp["channelNo"].is<uint32_t>()) {
-                                uint8_t channelId = rsp["channelId"].get<uint8_t>();
-                                uint32_t channelNo = rsp["channelNo"].get<uint32_t>();
-
-                                if (m_channelId != channelId && m_channelNo != channelNo) {
-                                    m_channelId = channelId;
-                                    m_channelNo = channelNo;
-
-                                    calculateRxTx();
-                                }
-                            }
-                            else {
-                                ::LogWarning(LOG_HOST, "%s:%u, does not report channel information");
-                            }
-
-                            // report last known transmitted destination ID
-                            if (rsp["lastDstId"].is<uint32_t>()) {
-                                uint32_t lastDstId = rsp["lastDstId"].get<uint32_t>();
-                                if (lastDstId == 0) {
-                                    m_lastDst.setText("None");
-                                }
-                                else {
-                                    m_lastDst.setText(__INT_STR(lastDstId));
-                                }
-                            }
-                            else {
-                                ::LogWarning(LOG_HOST, "%s:%u, does not report last TG information");
-                            }
-
-                            // report last known transmitted source ID
-                            if (rsp["lastSrcId"].is<uint32_t>()) {
-                                uint32_t lastSrcId = rsp["lastSrcId"].get<uint32_t>();
-                                if (lastSrcId == 0) {
-                                    m_lastSrc.setText("None");
-                                }
-                                else {
-                                    m_lastSrc.setText(__INT_STR(lastSrcId));
-                                }
-                            }
-                            else {
-                                ::LogWarning(LOG_HOST, "%s:%u, does not report last source information");
-                            }
-                        }
-                        catch (std::exception& e) {
-                            ::LogWarning(LOG_HOST, "%s:%u, failed to properly handle status, %s", m_chData.address().c_str(), m_chData.port(), e.what());
-                        }
-                    }
-                }
-
-                redraw();
-            }
-
             // reconnect timer
             if (timer->getTimerId() == m_reconnectTimerId) {
                 if (m_failed) {
@@ -430,7 +434,7 @@ private:
                     // callback REST API to get status of the channel we represent
                     json::object req = json::object();
                     int ret = RESTClient::send(m_chData.address(), m_chData.port(), m_chData.password(),
-                        HTTP_GET, GET_STATUS, req, m_chData.ssl(), g_debug);
+                        HTTP_GET, GET_STATUS, req, m_chData.ssl(), REST_DEFAULT_WAIT, g_debug);
                     if (ret == network::rest::http::HTTPPayload::StatusType::OK) {
                         m_failed = false;
                         m_failCnt = 0U;
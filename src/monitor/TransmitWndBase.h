@@ -104,7 +104,7 @@ protected:
         json::object rsp = json::object();
     
         int ret = RESTClient::send(m_selectedCh.address(), m_selectedCh.port(), m_selectedCh.password(),
-            HTTP_GET, GET_STATUS, req, rsp, m_selectedCh.ssl(), g_debug);
+            HTTP_GET, GET_STATUS, req, rsp, m_selectedCh.ssl(), REST_DEFAULT_WAIT, g_debug);
         if (ret != network::rest::http::HTTPPayload::StatusType::OK) {
             ::LogError(LOG_HOST, "failed to get status for %s:%u", m_selectedCh.address().c_str(), m_selectedCh.port());
         }
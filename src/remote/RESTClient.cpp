@@ -24,6 +24,8 @@ using namespace network::rest::http;
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
+#include <chrono>
+#include <condition_variable>
 #include <iomanip>
 #include <sstream>
 
@@ -40,14 +42,245 @@ using namespace network::rest::http;
 #define ERRNO_NO_ADDRESS 404
 #define ERRNO_NO_PASSWORD 403
 
+// idle pooled connections older than this are closed rather than reused
+const uint32_t POOL_IDLE_TIMEOUT_MS = 30000U;
+// maximum number of idle pooled connections kept per endpoint
+const size_t POOL_MAX_IDLE = 4U;
+// minimum wait for the first response on a new connection (includes the connect and TLS handshake)
+const int CONNECT_WAIT = REST_DEFAULT_WAIT;
+
+typedef network::rest::BasicRequestDispatcher<HTTPPayload, HTTPPayload> RESTDispatcherType;
+typedef std::chrono::steady_clock clock_type;
+
 // ---------------------------------------------------------------------------
-//  Static Class Members
+//  Class Declaration
 // ---------------------------------------------------------------------------
 
-bool RESTClient::m_responseAvailable = false;
-HTTPPayload RESTClient::m_response;
+/**
+ * @brief Represents the pooled connections and cached authentication for a REST API endpoint.
+ */
+struct RESTClient::PoolEndpoint {
+    std::vector<PooledConnection*> idle;    //! Idle Connections
+
+    std::string hash;                       //! Password Hash the Token was Issued For
+    std::string token;                      //! Authentication Token
+#if defined(ENABLE_TCP_SSL)
+    SSL_SESSION* session = nullptr;         //! TLS Session to Resume
+#endif // ENABLE_TCP_SSL
+};
+
+/**
+ * @brief Represents a persistent connection to a REST API endpoint.
+ */
+class RESTClient::PooledConnection {
+public:
+    /**
+     * @brief Initializes a new instance of the PooledConnection class.
+     * @param address Network Hostname/IP address to connect to.
+     * @param port Network port number.
+     * @param enableSSL Flag indicating whether or not HTTPS is enabled.
+     * @param endpoint Pool endpoint this connection belongs to.
+     */
+    PooledConnection(const std::string& address, uint32_t port, bool enableSSL, PoolEndpoint* endpoint) :
+        endpoint(endpoint),
+        reused(false),
+        lastUsed(clock_type::now()),
+        m_dispatcher([this](const HTTPPayload& request, HTTPPayload& reply) { responseHandler(request, reply); }),
+        m_client(nullptr),
+#if defined(ENABLE_TCP_SSL)
+        m_sslClient(nullptr),
+#endif // ENABLE_TCP_SSL
+        m_lock(),
+        m_cond(),
+        m_responseAvailable(false),
+        m_response()
+    {
+#if defined(ENABLE_TCP_SSL)
+        if (enableSSL) {
+            m_sslClient = new SecureHTTPClient<RESTDispatcherType>(address, port);
+            m_sslClient->setHandler(m_dispatcher);
+            return;
+        }
+#endif // ENABLE_TCP_SSL
+        m_client = new HTTPClient<RESTDispatcherType>(address, port);
+        m_client->setHandler(m_dispatcher);
+    }
+    /**
+     * @brief Finalizes a instance of the PooledConnection class.
+     */
+    ~PooledConnection()
+    {
+#if defined(ENABLE_TCP_SSL)
+        if (m_sslClient != nullptr) {
+            m_sslClient->close();
+            delete m_sslClient;
+        }
+#endif // ENABLE_TCP_SSL
+        if (m_client != nullptr) {
+            m_client->close();
+            delete m_client;
+        }
+    }
+
+    /**
+     * @brief Opens the connection.
+     * @returns bool True, if the connection was opened, otherwise false.
+     */
+    bool open()
+    {
+#if defined(ENABLE_TCP_SSL)
+        if (m_sslClient != nullptr) {
+            return m_sslClient->open();
+        }
+#endif // ENABLE_TCP_SSL
+        return m_client->open();
+    }
+
+    /**
+     * @brief Helper to determine if the connection is still open.
+     * @returns bool True, if the connection is open, otherwise false.
+     */
+    bool isOpen()
+    {
+#if defined(ENABLE_TCP_SSL)
+        if (m_sslClient != nullptr) {
+            return m_sslClient->isOpen();
+        }
+#endif // ENABLE_TCP_SSL
+        return m_client->isOpen();
+    }
+
+#if defined(ENABLE_TCP_SSL)
+    /**
+     * @brief Sets the TLS session to resume when the connection is opened.
+     * @param session TLS session.
+     */
+    void setSession(SSL_SESSION* session)
+    {
+        if (m_sslClient != nullptr) {
+            m_sslClient->setSession(session);
+        }
+    }
+
+    /**
+     * @brief Gets the TLS session negotiated by the connection.
+     * @returns SSL_SESSION* TLS session, the caller must release it with SSL_SESSION_free().
+     */
+    SSL_SESSION* getSession()
+    {
+        if (m_sslClient != nullptr) {
+            return m_sslClient->getSession();
+        }
+
+        return nullptr;
+    }
+#endif // ENABLE_TCP_SSL
+
+    /**
+     * @brief Sends a HTTP request.
+     * @param request HTTP request.
+     * @returns bool True, if the request was sent, otherwise false.
+     */
+    bool request(HTTPPayload& request)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_responseAvailable = false;
+        }
+
+#if defined(ENABLE_TCP_SSL)
+        if (m_sslClient != nullptr) {
+            return m_sslClient->request(request);
+        }
+#endif // ENABLE_TCP_SSL
+        return m_client->request(request);
+    }
+
+    /**
+     * @brief Waits for the response to the last HTTP request.
+     * @param deadline Time to wait until.
+     * @param[out] response HTTP response.
+     * @returns bool True, if a response was received, otherwise false (timed out or the connection closed).
+     */
+    bool wait(clock_type::time_point deadline, HTTPPayload& response)
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        while (!m_responseAvailable) {
+            // a pooled connection the server has since closed will never answer, don't wait out the timeout
+            if (reused && !isOpen()) {
+                return false;
+            }
+
+            clock_type::time_point now = clock_type::now();
+            if (now >= deadline) {
+                return false;
+            }
+
+            m_cond.wait_until(lock, std::min(deadline, now + std::chrono::milliseconds(10)));
+        }
+
+        response = m_response;
+        return true;
+    }
+
+public:
+    PoolEndpoint* endpoint;
+    bool reused;
+    clock_type::time_point lastUsed;
+
+private:
+    /**
+     * @brief HTTP response handler.
+     * @param request HTTP request.
+     * @param reply HTTP reply.
+     */
+    void responseHandler(const HTTPPayload& request, HTTPPayload& reply)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_response = request;
+        m_responseAvailable = true;
+        m_cond.notify_all();
+    }
+
+    RESTDispatcherType m_dispatcher;
+    HTTPClient<RESTDispatcherType>* m_client;
+#if defined(ENABLE_TCP_SSL)
+    SecureHTTPClient<RESTDispatcherType>* m_sslClient;
+#endif // ENABLE_TCP_SSL
+
+    std::mutex m_lock;
+    std::condition_variable m_cond;
+    bool m_responseAvailable;
+    HTTPPayload m_response;
+};
+
+/**
+ * @brief Represents the state of a single remote control command of a batch.
+ */
+struct RESTClient::Exchange {
+    BatchRequest* request;                  //! Remote Control Command
+    PooledConnection* connection;           //! Connection
+
+    std::string hash;                       //! Password Hash
+    HTTPPayload payload;                    //! Pending HTTP Request
+    bool auth;                              //! Flag indicating the pending request is the authentication request
+    bool retried;                           //! Flag indicating the command has already re-authenticated
+    bool reconnected;                       //! Flag indicating the command has already replaced a stale connection
+
+    int timeout;                            //! Response Timeout
+    clock_type::time_point deadline;        //! Response Deadline
+    bool done;                              //! Flag indicating the command is complete
+};
+
+// ---------------------------------------------------------------------------
+//  Static Class Members
+// ---------------------------------------------------------------------------
 
 bool RESTClient::m_console = false;
+
+std::mutex RESTClient::m_poolLock;
+std::unordered_map<std::string, RESTClient::PoolEndpoint*> RESTClient::m_pool;
+
 bool RESTClient::m_enableSSL = false;
 bool RESTClient::m_debug = false;
 
@@ -80,6 +313,33 @@ bool parseResponseBody(const HTTPPayload& response, json::object& obj)
     return true;
 }
 
+/* Helper to generate the SHA256 hash of the authentication password. */
+
+std::string passwordHash(const std::string& password)
+{
+    size_t size = password.size();
+
+    uint8_t* in = new uint8_t[size];
+    for (size_t i = 0U; i < size; i++)
+        in[i] = password.at(i);
+
+    uint8_t out[32U];
+    ::memset(out, 0x00U, 32U);
+
+    edac::SHA256 sha256;
+    sha256.buffer(in, (uint32_t)(size), out);
+
+    delete[] in;
+
+    std::stringstream ss;
+    ss << std::hex;
+
+    for (uint8_t i = 0; i < 32U; i++)
+        ss << std::setw(2) << std::setfill('0') << (int)out[i];
+
+    return ss.str();
+}
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -101,7 +361,10 @@ RESTClient::RESTClient(const std::string& address, uint32_t port, const std::str
 
 /* Finalizes a instance of the RESTClient class. */
 
-RESTClient::~RESTClient() = default;
+RESTClient::~RESTClient()
+{
+    closeConnections();
+}
 
 /* Sends remote control command to the specified modem. */
 
@@ -115,7 +378,7 @@ int RESTClient::send(const std::string method, const std::string endpoint, json:
 
 int RESTClient::send(const std::string method, const std::string endpoint, json::object payload, json::object& response)
 {
-    return send(m_address, m_port, m_password, method, endpoint, payload, response, m_enableSSL, m_debug);
+    return send(m_address, m_port, m_password, method, endpoint, payload, response, m_enableSSL, REST_DEFAULT_WAIT, m_debug);
 }
 
 /* Sends remote control command to the specified modem. */
@@ -132,269 +395,347 @@ int RESTClient::send(const std::string& address, uint32_t port, const std::strin
 int RESTClient::send(const std::string& address, uint32_t port, const std::string& password, const std::string method,
     const std::string endpoint, json::object payload, json::object& response, bool enableSSL, int timeout, bool debug)
 {
-    if (address.empty()) {
-        return ERRNO_NO_ADDRESS;
-    }
-    if (address == "0.0.0.0") {
-        return ERRNO_NO_ADDRESS;
-    }
-    if (port <= 0U) {
-        return ERRNO_NO_ADDRESS;
-    }
-    if (password.empty()) {
-        return ERRNO_NO_PASSWORD;
-    }
+    std::vector<BatchRequest> requests;
+    requests.push_back(BatchRequest { address, port, password, enableSSL, method, endpoint, payload, json::object(), EXIT_SUCCESS });
 
-    int ret = EXIT_SUCCESS;
-    m_enableSSL = enableSSL;
-    m_debug = debug;
+    sendBatch(requests, timeout, debug);
 
-    typedef network::rest::BasicRequestDispatcher<network::rest::http::HTTPPayload, network::rest::http::HTTPPayload> RESTDispatcherType;
-    RESTDispatcherType m_dispatcher(RESTClient::responseHandler);
-    HTTPClient<RESTDispatcherType>* client = nullptr;
-#if defined(ENABLE_TCP_SSL)
-    SecureHTTPClient<RESTDispatcherType>* sslClient = nullptr;
-#endif // ENABLE_TCP_SSL
-
-    try {
-        // setup HTTP client for authentication payload
-#if defined(ENABLE_TCP_SSL)
-        if (m_enableSSL) {
-            sslClient = new SecureHTTPClient<RESTDispatcherType>(address, port);
-            if (!sslClient->open()) {
-                delete sslClient;
-                return ERRNO_SOCK_OPEN;
-            }
-            sslClient->setHandler(m_dispatcher);
-        } else {
-#endif // ENABLE_TCP_SSL
-            client = new HTTPClient<RESTDispatcherType>(address, port);
-            if (!client->open()) {
-                delete client;
-                return ERRNO_SOCK_OPEN;
-            }
-            client->setHandler(m_dispatcher);
-#if defined(ENABLE_TCP_SSL)
-        }
-#endif // ENABLE_TCP_SSL
+    response = requests[0U].response;
+    if (m_console && !response.empty()) {
+        fprintf(stdout, "%s\r\n", json::value(response).serialize().c_str());
+    }
 
-        // generate password SHA hash
-        size_t size = password.size();
+    return requests[0U].ret;
+}
 
-        uint8_t* in = new uint8_t[size];
-        for (size_t i = 0U; i < size; i++)
-            in[i] = password.at(i);
+/* Sends a batch of remote control commands. */
 
-        uint8_t out[32U];
-        ::memset(out, 0x00U, 32U);
+void RESTClient::sendBatch(std::vector<BatchRequest>& requests, int timeout, bool debug)
+{
+    std::vector<Exchange> exchanges(requests.size());
+
+    // send the first request of every command before waiting on any of them
+    for (size_t i = 0U; i < requests.size(); i++) {
+        BatchRequest& request = requests[i];
+        Exchange& exchange = exchanges[i];
+
+        exchange.request = &request;
+        exchange.connection = nullptr;
+        exchange.auth = false;
+        exchange.retried = false;
+        exchange.reconnected = false;
+        exchange.timeout = timeout;
+        exchange.done = true;
+
+        request.response = json::object();
+        if (request.address.empty() || request.address == "0.0.0.0" || request.port <= 0U) {
+            request.ret = ERRNO_NO_ADDRESS;
+            continue;
+        }
+        if (request.password.empty()) {
+            request.ret = ERRNO_NO_PASSWORD;
+            continue;
+        }
 
-        edac::SHA256 sha256;
-        sha256.buffer(in, (uint32_t)(size), out);
+        try {
+            exchange.connection = acquire(request.address, request.port, request.enableSSL);
+            if (exchange.connection == nullptr) {
+                request.ret = ERRNO_SOCK_OPEN;
+                continue;
+            }
 
-        delete[] in;
+            exchange.hash = passwordHash(request.password);
+            exchange.done = false;
 
-        std::stringstream ss;
-        ss << std::hex;
+            // authenticate only if this endpoint has no token for this password yet
+            bool auth = true;
+            {
+                std::lock_guard<std::mutex> lock(m_poolLock);
+                PoolEndpoint* endpoint = exchange.connection->endpoint;
+                auth = endpoint->token.empty() || endpoint->hash != exchange.hash;
+            }
 
-        for (uint8_t i = 0; i < 32U; i++)
-            ss << std::setw(2) << std::setfill('0') << (int)out[i];
+            post(exchange, auth, debug);
+        }
+        catch (std::exception&) {
+            if (exchange.connection != nullptr) {
+                delete exchange.connection;
+                exchange.connection = nullptr;
+            }
 
-        std::string hash = ss.str();
+            request.ret = ERRNO_INTERNAL_ERROR;
+            exchange.done = true;
+        }
+    }
 
-        // send authentication API
-        json::object request = json::object();
-        request["auth"].set<std::string>(hash);
+    // collect responses, commands that need another round trip (authentication) are sent again and
+    // picked up by the next pass
+    bool pending = true;
+    while (pending) {
+        pending = false;
+        for (Exchange& exchange : exchanges) {
+            if (exchange.done) {
+                continue;
+            }
 
-        HTTPPayload httpPayload = HTTPPayload::requestPayload(HTTP_PUT, "/auth");
-        httpPayload.payload(request);
-#if defined(ENABLE_TCP_SSL)
-        if (m_enableSSL) {
-            sslClient->request(httpPayload);
-        } else {
-#endif // ENABLE_TCP_SSL
-            client->request(httpPayload);
-#if defined(ENABLE_TCP_SSL)
+            complete(exchange, debug);
+            pending = pending || !exchange.done;
         }
-#endif // ENABLE_TCP_SSL
+    }
+}
 
-        // wait for response and parse
-        if (wait()) {
-#if defined(ENABLE_TCP_SSL)
-            if (m_enableSSL) {
-                sslClient->close();
-                delete sslClient;
-            } else {
-#endif // ENABLE_TCP_SSL
-                client->close();
-                delete client;
+/* Closes all pooled connections and discards cached authentication. */
+
+void RESTClient::closeConnections()
+{
+    std::vector<PooledConnection*> connections;
+    {
+        std::lock_guard<std::mutex> lock(m_poolLock);
+        for (auto& entry : m_pool) {
+            PoolEndpoint* endpoint = entry.second;
+            connections.insert(connections.end(), endpoint->idle.begin(), endpoint->idle.end());
+            endpoint->idle.clear();
+            endpoint->token.clear();
 #if defined(ENABLE_TCP_SSL)
+            if (endpoint->session != nullptr) {
+                SSL_SESSION_free(endpoint->session);
+                endpoint->session = nullptr;
             }
 #endif // ENABLE_TCP_SSL
-            return ERRNO_API_CALL_TIMEOUT;
         }
+    }
 
-        json::object rsp = json::object();
-        if (!parseResponseBody(m_response, rsp)) {
-            return ERRNO_BAD_API_RESPONSE;
-        }
+    for (PooledConnection* connection : connections) {
+        delete connection;
+    }
+}
 
-        std::string token = "";
-        int status = rsp["status"].get<int>();
-        if (status == HTTPPayload::StatusType::OK) {
-            token = rsp["token"].get<std::string>();
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to get a connection to a REST API endpoint, reusing a pooled connection if one is idle. */
+
+RESTClient::PooledConnection* RESTClient::acquire(const std::string& address, uint32_t port, bool enableSSL)
+{
+    std::string key = address + ":" + std::to_string(port) + (enableSSL ? ":ssl" : "");
+    clock_type::time_point now = clock_type::now();
+
+    PooledConnection* connection = nullptr;
+    PoolEndpoint* endpoint = nullptr;
+    std::vector<PooledConnection*> expired;
+    {
+        std::lock_guard<std::mutex> lock(m_poolLock);
+        auto it = m_pool.find(key);
+        if (it == m_pool.end()) {
+            it = m_pool.emplace(key, new PoolEndpoint()).first;
         }
-        else {
-#if defined(ENABLE_TCP_SSL)
-            if (m_enableSSL) {
-                sslClient->close();
-                delete sslClient;
-            } else {
-#endif // ENABLE_TCP_SSL
-                client->close();
-                delete client;
-#if defined(ENABLE_TCP_SSL)
+
+        endpoint = it->second;
+        while (!endpoint->idle.empty()) {
+            PooledConnection* idle = endpoint->idle.back();
+            endpoint->idle.pop_back();
+
+            if (now - idle->lastUsed < std::chrono::milliseconds(POOL_IDLE_TIMEOUT_MS) && idle->isOpen()) {
+                connection = idle;
+                break;
             }
-#endif // ENABLE_TCP_SSL
-            return ERRNO_BAD_AUTH_RESPONSE;
+
+            expired.push_back(idle);
         }
+    }
+
+    for (PooledConnection* idle : expired) {
+        delete idle;
+    }
 
+    if (connection != nullptr) {
+        connection->reused = true;
+        return connection;
+    }
+
+    connection = new PooledConnection(address, port, enableSSL, endpoint);
 #if defined(ENABLE_TCP_SSL)
-        if (m_enableSSL) {
-            sslClient->close();
-            delete sslClient;
-        } else {
+    {
+        std::lock_guard<std::mutex> lock(m_poolLock);
+        connection->setSession(endpoint->session);
+    }
 #endif // ENABLE_TCP_SSL
-            client->close();
-            delete client;
+
+    if (!connection->open()) {
+        delete connection;
+        return nullptr;
+    }
+
+    return connection;
+}
+
+/* Helper to return a connection to the pool once its exchange is complete. */
+
+void RESTClient::release(PooledConnection* connection)
+{
+    if (connection == nullptr) {
+        return;
+    }
+
+    if (!connection->isOpen()) {
+        delete connection;
+        return;
+    }
+
+    connection->lastUsed = clock_type::now();
+
 #if defined(ENABLE_TCP_SSL)
-        }
+    // remember the negotiated session, new connections to this endpoint will resume it
+    SSL_SESSION* session = nullptr;
+    if (!connection->reused) {
+        session = connection->getSession();
+    }
 #endif // ENABLE_TCP_SSL
 
-        // reset the HTTP client and setup for actual payload request
+    {
+        std::lock_guard<std::mutex> lock(m_poolLock);
+        PoolEndpoint* endpoint = connection->endpoint;
 #if defined(ENABLE_TCP_SSL)
-        if (m_enableSSL) {
-            sslClient = new SecureHTTPClient<RESTDispatcherType>(address, port);
-            if (!sslClient->open()) {
-                delete sslClient;
-                return ERRNO_SOCK_OPEN;
+        if (session != nullptr) {
+            if (endpoint->session != nullptr) {
+                SSL_SESSION_free(endpoint->session);
             }
-            sslClient->setHandler(m_dispatcher);
-        } else {
-#endif // ENABLE_TCP_SSL
-            client = new HTTPClient<RESTDispatcherType>(address, port);
-            if (!client->open()) {
-                delete client;
-                return ERRNO_SOCK_OPEN;
-            }
-            client->setHandler(m_dispatcher);
-#if defined(ENABLE_TCP_SSL)
+            endpoint->session = session;
         }
 #endif // ENABLE_TCP_SSL
 
-        // send actual API request
-        httpPayload = HTTPPayload::requestPayload(method, endpoint);
-        httpPayload.headers.add("X-DVM-Auth-Token", token);
-        httpPayload.payload(payload);
-#if defined(ENABLE_TCP_SSL)
-        if (m_enableSSL) {
-            sslClient->request(httpPayload);
-        } else {
-#endif // ENABLE_TCP_SSL
-            client->request(httpPayload);
-#if defined(ENABLE_TCP_SSL)
+        if (endpoint->idle.size() < POOL_MAX_IDLE) {
+            endpoint->idle.push_back(connection);
+            return;
         }
-#endif // ENABLE_TCP_SSL
+    }
 
-        // wait for response and parse
-        if (wait()) {
-#if defined(ENABLE_TCP_SSL)
-            if (m_enableSSL) {
-                sslClient->close();
-                delete sslClient;
-            } else {
-#endif // ENABLE_TCP_SSL
-                client->close();
-                delete client;
-#if defined(ENABLE_TCP_SSL)
-            }
-#endif // ENABLE_TCP_SSL
-            return ERRNO_API_CALL_TIMEOUT;
-        }
+    delete connection;
+}
 
-        response = json::object();
-        if (!parseResponseBody(m_response, response)) {
-            return ERRNO_BAD_API_RESPONSE;
-        }
+/* Helper to send the next request of an exchange. */
 
-        ret = response["status"].get<int>();
-        if (m_console) {
-            fprintf(stdout, "%s\r\n", m_response.content.c_str());
-        }
-        else {
-            if (m_debug) {
-                ::LogDebug(LOG_REST, "REST Response: %s", m_response.content.c_str());
-            }
-        }
+void RESTClient::post(Exchange& exchange, bool auth, bool debug)
+{
+    BatchRequest* request = exchange.request;
 
-#if defined(ENABLE_TCP_SSL)
-        if (m_enableSSL) {
-            sslClient->close();
-            delete sslClient;
-        } else {
-#endif // ENABLE_TCP_SSL
-            client->close();
-            delete client;
-#if defined(ENABLE_TCP_SSL)
+    exchange.auth = auth;
+    if (auth) {
+        json::object req = json::object();
+        req["auth"].set<std::string>(exchange.hash);
+
+        exchange.payload = HTTPPayload::requestPayload(HTTP_PUT, "/auth");
+        exchange.payload.headers.add("Connection", "keep-alive");
+        exchange.payload.payload(req);
+    }
+    else {
+        std::string token;
+        {
+            std::lock_guard<std::mutex> lock(m_poolLock);
+            token = exchange.connection->endpoint->token;
         }
-#endif // ENABLE_TCP_SSL
+
+        exchange.payload = HTTPPayload::requestPayload(request->method, request->endpoint);
+        exchange.payload.headers.add("Connection", "keep-alive");
+        exchange.payload.headers.add("X-DVM-Auth-Token", token);
+        exchange.payload.payload(request->payload);
     }
-    catch (std::exception&) {
-#if defined(ENABLE_TCP_SSL)
-        if (m_enableSSL) {
-            if (sslClient != nullptr) {
-                delete sslClient;
-            }
-        } else {
-#endif // ENABLE_TCP_SSL
-            if (client != nullptr) {
-                delete client;
+
+    if (debug) {
+        ::LogDebug(LOG_REST, "REST Request: %s:%u %s %s, reused = %u", request->address.c_str(), request->port,
+            exchange.payload.method.c_str(), exchange.payload.uri.c_str(), exchange.connection->reused);
+    }
+
+    // a new connection has to connect (and handshake) before it can answer
+    int timeout = exchange.timeout;
+    if (!exchange.connection->reused && timeout < CONNECT_WAIT) {
+        timeout = CONNECT_WAIT;
+    }
+
+    exchange.deadline = clock_type::now() + std::chrono::milliseconds(timeout);
+    exchange.connection->request(exchange.payload);
+}
+
+/* Helper to wait for and process the response to the pending request of an exchange. */
+
+void RESTClient::complete(Exchange& exchange, bool debug)
+{
+    BatchRequest* request = exchange.request;
+    PooledConnection* connection = exchange.connection;
+
+    HTTPPayload response;
+    if (!connection->wait(exchange.deadline, response)) {
+        bool stale = connection->reused && !connection->isOpen();
+        delete connection;
+        exchange.connection = nullptr;
+
+        // the server closed an idle pooled connection, resend once on a new connection
+        if (stale && !exchange.reconnected) {
+            exchange.reconnected = true;
+            exchange.connection = acquire(request->address, request->port, request->enableSSL);
+            if (exchange.connection != nullptr) {
+                post(exchange, exchange.auth, debug);
+                return;
             }
-#if defined(ENABLE_TCP_SSL)
+
+            request->ret = ERRNO_SOCK_OPEN;
+            exchange.done = true;
+            return;
         }
-#endif // ENABLE_TCP_SSL
-        return ERRNO_INTERNAL_ERROR;
+
+        request->ret = ERRNO_API_CALL_TIMEOUT;
+        exchange.done = true;
+        return;
     }
 
-    return ret;
-}
+    json::object rsp = json::object();
+    if (!parseResponseBody(response, rsp)) {
+        release(connection);
+        exchange.connection = nullptr;
 
-// ---------------------------------------------------------------------------
-//  Private Class Members
-// ---------------------------------------------------------------------------
+        request->ret = (exchange.auth) ? ERRNO_BAD_AUTH_RESPONSE : ERRNO_BAD_API_RESPONSE;
+        exchange.done = true;
+        return;
+    }
 
-/* HTTP response handler. */
+    int status = rsp["status"].get<int>();
+    if (exchange.auth) {
+        if (status != HTTPPayload::StatusType::OK) {
+            release(connection);
+            exchange.connection = nullptr;
 
-void RESTClient::responseHandler(const HTTPPayload& request, HTTPPayload& reply)
-{
-    m_responseAvailable = true;
-    m_response = request;
-}
+            request->ret = ERRNO_BAD_AUTH_RESPONSE;
+            exchange.done = true;
+            return;
+        }
 
-/* Helper to wait for a HTTP response. */
+        {
+            std::lock_guard<std::mutex> lock(m_poolLock);
+            connection->endpoint->hash = exchange.hash;
+            connection->endpoint->token = rsp["token"].get<std::string>();
+        }
 
-bool RESTClient::wait(const int t)
-{
-    m_responseAvailable = false;
+        post(exchange, false, debug);
+        return;
+    }
 
-    int timeout = t;
-    while (!m_responseAvailable && timeout > 0) {
-        timeout--;
-        Thread::sleep(1);
+    // the cached token was invalidated (the endpoint restarted, or another client from this host
+    // authenticated), authenticate again and retry once
+    if (status == HTTPPayload::StatusType::UNAUTHORIZED && !exchange.retried) {
+        exchange.retried = true;
+        post(exchange, true, debug);
+        return;
     }
 
-    if (timeout == 0) {
-        return true;
+    if (debug && !m_console) {
+        ::LogDebug(LOG_REST, "REST Response: %s", response.content.c_str());
     }
 
-    return false;
+    release(connection);
+    exchange.connection = nullptr;
+
+    request->response = rsp;
+    request->ret = status;
+    exchange.done = true;
 }
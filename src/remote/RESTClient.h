@@ -27,7 +27,10 @@
 #include "common/network/json/json.h"
 #include "common/network/rest/http/HTTPPayload.h"
 
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #define REST_DEFAULT_WAIT 500
 #define REST_QUICK_WAIT 150
@@ -106,20 +109,69 @@ public:
     static int send(const std::string& address, uint32_t port, const std::string& password, const std::string method,
         const std::string endpoint, json::object payload, json::object& response, bool enableSSL, int timeout, bool debug = false);
 
+    /**
+     * @brief Represents a single remote control command of a batch.
+     */
+    struct BatchRequest {
+        std::string address;        //! Network Hostname/IP address to connect to.
+        uint32_t port;              //! Network port number.
+        std::string password;       //! Authentication password.
+        bool enableSSL;             //! Flag indicating whether or not HTTPS is enabled.
+
+        std::string method;         //! REST API method.
+        std::string endpoint;       //! REST API endpoint.
+        json::object payload;       //! REST API endpoint payload.
+
+        json::object response;      //! REST API endpoint response.
+        int ret;                    //! REST API status (or error code) of the command.
+    };
+
+    /**
+     * @brief Sends a batch of remote control commands. All commands are sent before any response is
+     *  waited on, so the batch completes in roughly the time of its slowest endpoint.
+     * @param requests Remote control commands, the response and status of each is filled in.
+     * @param timeout REST response wait timeout.
+     * @param debug Flag indicating whether debug is enabled.
+     */
+    static void sendBatch(std::vector<BatchRequest>& requests, int timeout = REST_DEFAULT_WAIT, bool debug = false);
+
+    /**
+     * @brief Closes all pooled connections and discards cached authentication.
+     */
+    static void closeConnections();
+
 private:
-    typedef network::rest::http::HTTPPayload HTTPPayload;
+    class PooledConnection;
+    struct PoolEndpoint;
+    struct Exchange;
+
     /**
-     * @brief HTTP response handler.
-     * @param request HTTP request.
-     * @param reply HTTP reply.
+     * @brief Helper to get a connection to a REST API endpoint, reusing a pooled connection if one is idle.
+     * @param address Network Hostname/IP address to connect to.
+     * @param port Network port number.
+     * @param enableSSL Flag indicating whether or not HTTPS is enabled.
+     * @returns PooledConnection* Connection, or nullptr if the connection could not be opened.
      */
-    static void responseHandler(const HTTPPayload& request, HTTPPayload& reply);
+    static PooledConnection* acquire(const std::string& address, uint32_t port, bool enableSSL);
+    /**
+     * @brief Helper to return a connection to the pool once its exchange is complete.
+     * @param connection Connection.
+     */
+    static void release(PooledConnection* connection);
 
     /**
-     * @brief Helper to wait for a HTTP response.
-     * @returns True, if timed out, otherwise false.
+     * @brief Helper to send the next request of an exchange.
+     * @param exchange Exchange.
+     * @param auth Flag indicating whether the authentication request should be sent.
+     * @param debug Flag indicating whether debug is enabled.
+     */
+    static void post(Exchange& exchange, bool auth, bool debug);
+    /**
+     * @brief Helper to wait for and process the response to the pending request of an exchange.
+     * @param exchange Exchange.
+     * @param debug Flag indicating whether debug is enabled.
      */
-    static bool wait(const int t = REST_DEFAULT_WAIT);
+    static void complete(Exchange& exchange, bool debug);
 
     std::string m_address;
     uint32_t m_port;
@@ -127,8 +179,8 @@ private:
 
     static bool m_console;
 
-    static bool m_responseAvailable;
-    static HTTPPayload m_response;
+    static std::mutex m_poolLock;
+    static std::unordered_map<std::string, PoolEndpoint*> m_pool;
 
     static bool m_enableSSL;
     static bool m_debug;
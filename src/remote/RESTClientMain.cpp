@@ -42,6 +42,8 @@
 #define RCD_FNE_GET_TGIDLIST            "fne-tgidlist"
 #define RCD_FNE_GET_FORCEUPDATE         "fne-force-update"
 #define RCD_FNE_GET_AFFLIST             "fne-affs"
+#define RCD_FNE_GET_CALLLIST            "fne-calls"
+#define RCD_FNE_GET_SHARDSTATS          "fne-shards"
 #define RCD_FNE_GET_RELOADTGS           "fne-reload-tgs"
 #define RCD_FNE_GET_RELOADRIDS          "fne-reload-rids"
 
@@ -62,6 +64,7 @@
 
 #define RCD_KILL                        "mdm-kill"
 #define RCD_FORCE_KILL                  "mdm-force-kill"
+#define RCD_MDM_V24_STATS               "mdm-v24-stats"
 
 #define RCD_PERMIT_TG                   "permit-tg"
 #define RCD_GRANT_TG                    "grant-tg"
@@ -210,6 +213,8 @@ void usage(const char* message, const char* arg)
     reply += "  fne-tgidlist                Retrieves the list of configured TGIDs (Converged FNE only)\r\n";
     reply += "  fne-force-update            Forces the FNE to send list update (Converged FNE only)\r\n";
     reply += "  fne-affs                    Retrieves the list of currently affiliated SUs (Converged FNE only)\r\n";
+    reply += "  fne-calls                   Retrieves the list of currently active calls (Converged FNE only)\r\n";
+    reply += "  fne-shards                  Retrieves the master socket shard statistics (Converged FNE only)\r\n";
     reply += "  fne-reload-tgs              Forces the FNE to reload its TGID list from disk (Converged FNE only)\r\n";
     reply += "  fne-reload-rids             Forces the FNE to reload its RID list from disk (Converged FNE only)\r\n";
     reply += "\r\n";
@@ -224,6 +229,7 @@ void usage(const char* message, const char* arg)
     reply += "  mdm-mode <mode>             Set current mode of host (idle, lockout, dmr, p25, nxdn)\r\n";
     reply += "  mdm-kill                    Causes the host to quit\r\n";
     reply += "  mdm-force-kill              Causes the host to quit immediately\r\n";
+    reply += "  mdm-v24-stats               Retrieves the V.24 modem transmit timing statistics\r\n";
     reply += "\r\n";
     reply += "  permit-tg <state> <dstid>   Causes the host to permit the specified destination ID if non-authoritative\r\n";
     reply += "  grant-tg <state> <dstid> <uu> Causes the host to grant the specified destination ID if non-authoritative\r\n";
@@ -505,6 +511,9 @@ int main(int argc, char** argv)
 
             retCode = client->send(HTTP_PUT, PUT_MDM_KILL, req, response);
         }
+        else if (rcom == RCD_MDM_V24_STATS) {
+            retCode = client->send(HTTP_GET, GET_MDM_V24_STATS, json::object(), response);
+        }
         else if (rcom == RCD_PERMIT_TG && argCnt >= 1U) {
             json::object req = json::object();
             int state = getArgInt32(args, 0U);
@@ -897,6 +906,12 @@ int main(int argc, char** argv)
         else if (rcom == RCD_FNE_GET_AFFLIST) {
             retCode = client->send(HTTP_GET, FNE_GET_AFF_LIST, json::object(), response);
         }
+        else if (rcom == RCD_FNE_GET_CALLLIST) {
+            retCode = client->send(HTTP_GET, FNE_GET_CALL_LIST, json::object(), response);
+        }
+        else if (rcom == RCD_FNE_GET_SHARDSTATS) {
+            retCode = client->send(HTTP_GET, FNE_GET_SHARD_STATS, json::object(), response);
+        }
         else if (rcom == RCD_FNE_GET_RELOADTGS) {
             retCode = client->send(HTTP_GET, FNE_GET_RELOAD_TGS, json::object(), response);
         }
@@ -939,6 +954,8 @@ int main(int argc, char** argv)
         }
     }
 
+    delete client;
+
     ::LogFinalise();
     return retCode;
 }
@@ -13,6 +13,7 @@
 #include <math.h>
 
 #include "common/edac/Golay24128.h"
+#include "common/Utils.h"
 #include "vocoder/MBEDecoder.h"
 
 using namespace edac;
@@ -63,6 +64,132 @@ const int MBEDecoder::rZ[36] = {
     13, 2, 12, 1, 11, 0
 };
 
+/*
+** beyond this many errors the decoder repeats or mutes frames, rather than using their parameters
+*/
+const int32_t MAX_PARAMS_ERRS = 3;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helper to unpack 88-bit IMBE bytes into IMBE frame vectors (u0 - u7).
+ * @param[in] codeword 88-bit IMBE bytes.
+ * @param[out] frame_vector IMBE frame vectors.
+ */
+static void decodeIMBE(const uint8_t* codeword, int16_t* frame_vector)
+{
+    const uint32_t VECTOR_BITS[8U] = { 12U, 12U, 12U, 12U, 11U, 11U, 11U, 7U };
+
+    uint32_t offset = 0U;
+    for (uint32_t n = 0U; n < 8U; n++) {
+        frame_vector[n] = 0;
+        for (uint32_t i = 0U; i < VECTOR_BITS[n]; i++, offset++)
+            frame_vector[n] = (frame_vector[n] << 1) | (READ_BIT(codeword, offset) ? 1 : 0);
+    }
+}
+
+/**
+ * @brief Helper to advance the mbelib decoder state past a frame that was only dequantized to its
+ *  model parameters, as the PCM decoder would after synthesizing it.
+ * @param cur_mp Dequantized model parameters of the frame.
+ * @param prev_mp Model parameters of the previous frame.
+ * @param prev_mp_enhanced Enhanced model parameters of the previous frame.
+ */
+static void advanceMbeParms(mbe_parms* cur_mp, mbe_parms* prev_mp, mbe_parms* prev_mp_enhanced)
+{
+    cur_mp->repeat = 0;
+    mbe_moveMbeParms(cur_mp, prev_mp);
+    mbe_spectralAmpEnhance(cur_mp);
+    mbe_moveMbeParms(cur_mp, prev_mp_enhanced);
+}
+
+/**
+ * @brief Helper to map dequantized AMBE model parameters onto the IMBE model (pitch grid, band
+ *  voicing and spectral amplitudes), which both encoder modes quantize from.
+ * @param[in] mp Dequantized AMBE model parameters.
+ * @param[out] params MBE model parameters.
+ */
+static void ambeToImbeParams(const mbe_parms* mp, IMBE_PARAM* params)
+{
+    ::memset(params, 0x00U, sizeof(IMBE_PARAM));
+
+    // quantize the fundamental frequency to the IMBE pitch grid, w0 = 4 * pi / (b0 + 39.5)
+    int b0 = (int)floorf(((4.0f * (float)M_PI) / mp->w0) - 39.0f);
+    b0 = (b0 < 0) ? 0 : ((b0 > 207) ? 207 : b0);
+
+    float w0 = (4.0f * (float)M_PI) / ((float)b0 + 39.5f);
+    params->b_vec[0] = b0;
+    params->ref_pitch = (b0 << 7) + 0x13C0;                                 // Q8.8 (b0 + 39.5) / 2
+    params->ref_pitch = (params->ref_pitch < 0x13E0) ? 0x13E0 : ((params->ref_pitch > 0x7B20) ? 0x7B20 : params->ref_pitch);
+    params->fund_freq = (int32_t)((w0 / (float)M_PI) * 2147483648.0f);
+
+    // harmonic and band counts, exactly as the IMBE decoder derives them from b0
+    int tmp = ((b0 << 1) + 0x4F + 2) >> 3;
+    int numHarms = (int)((60647U * (uint32_t)tmp) >> 16);
+    int numBands = (numHarms <= 36) ? (int)(((uint32_t)(numHarms + 2) * 0x5556U) >> 16) : NUM_BANDS_MAX;
+    params->num_harms = numHarms;
+    params->num_bands = numBands;
+
+    /*
+    ** undo the AMBE log amplitude offsets (the inverse of the AMBE encoder, less the 0.5 * log2(L)
+    ** the decoder already removes with the gain), so the amplitudes are in the speech analysis domain
+    */
+    int L = mp->L;
+    float logW0 = (0.5f * log2f(mp->w0)) + 2.289f;
+    float lsa[57U];
+    for (int l = 1; l <= L; l++)
+        lsa[l] = mp->log2Ml[l] - ((mp->Vl[l] == 1) ? 0.0f : logW0);
+
+    // band voicing by majority of the AMBE harmonics nearest the IMBE harmonics of the band
+    int b1 = 0, uvCount = 0;
+    for (int band = 0; band < numBands; band++) {
+        int first = (band * 3) + 1;
+        int last = (band == numBands - 1) ? numHarms : first + 2;
+
+        int voiced = 0;
+        for (int l = first; l <= last; l++) {
+            int k = (int)lrintf(((float)l * w0) / mp->w0);
+            k = (k < 1) ? 1 : ((k > L) ? L : k);
+            voiced += (mp->Vl[k] == 1) ? 1 : 0;
+        }
+
+        int v = ((voiced * 2) > (last - first + 1)) ? 1 : 0;
+        b1 = (b1 << 1) | v;
+        for (int l = first; l <= last; l++) {
+            params->v_uv_dsn[l - 1] = v;
+            uvCount += (v == 0) ? 1 : 0;
+        }
+    }
+
+    params->b_vec[1] = b1;
+    params->l_uv = uvCount;
+
+    // spectral amplitudes, interpolated in the log domain at the IMBE harmonic frequencies
+    for (int l = 1; l <= numHarms; l++) {
+        float k = ((float)l * w0) / mp->w0;
+        int kl = (int)k;
+        float frac = k - (float)kl;
+        if (kl < 1) {
+            kl = 1;
+            frac = 0.0f;
+        }
+        if (kl >= L) {
+            kl = L;
+            frac = 0.0f;
+        }
+
+        float lm = (1.0f - frac) * lsa[kl];
+        if (frac > 0.0f)
+            lm += frac * lsa[kl + 1];
+
+        float sa = exp2f(lm);
+        sa = (sa < 1.0f) ? 1.0f : ((sa > 32767.0f) ? 32767.0f : sa);
+        params->sa[l - 1] = (int16_t)lrintf(sa);
+    }
+}
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -72,7 +199,8 @@ const int MBEDecoder::rZ[36] = {
 MBEDecoder::MBEDecoder(MBE_DECODER_MODE mode) :
     m_mbelibParms(NULL),
     m_mbeMode(mode),
-    m_gainAdjust(1.0f)
+    m_gainAdjust(1.0f),
+    m_autoGain(false)
 {
     m_mbelibParms = new mbelibParms();
     mbe_initMbeParms(m_mbelibParms->m_cur_mp, m_mbelibParms->m_prev_mp, m_mbelibParms->m_prev_mp_enhanced);
@@ -207,7 +335,16 @@ int32_t MBEDecoder::decodeF(uint8_t* codeword, float samples[])
         char ambeErrStr[64U];
         ::memset(ambeErrStr, 0x20U, 64U);
 
+        // the parametric decoder predicts from the previous frame as well; keep it in step
+        int16_t frame_vector[8U];
+        decodeIMBE(codeword, frame_vector);
+        bool valid = (m_vocoder.imbe_decode_params(frame_vector) != nullptr);
+
         mbe_processImbe4400DataF(samples, &ambeErrs, &errs, ambeErrStr, imbe_d, m_mbelibParms->m_cur_mp, m_mbelibParms->m_prev_mp, m_mbelibParms->m_prev_mp_enhanced, 3);
+
+        // after too many repeated frames the PCM decoder mutes, and starts over
+        if (!valid && m_mbelibParms->m_cur_mp->repeat == 0)
+            m_vocoder.imbe_decode_reset();
     }
     break;
     }
@@ -314,3 +451,65 @@ int32_t MBEDecoder::decode(uint8_t* codeword, int16_t samples[])
 
     return errs;
 }
+
+/* Decodes the given MBE codewords to MBE model parameters using the decoder mode. */
+
+int32_t MBEDecoder::decodeParams(uint8_t* codeword, IMBE_PARAM* params)
+{
+    switch (m_mbeMode)
+    {
+    case DECODE_DMR_AMBE:
+    {
+        char ambe_d[49U];
+        ::memset(ambe_d, 0x00U, 49U);
+
+        int32_t errs = decodeBits(codeword, ambe_d);
+        if (errs > MAX_PARAMS_ERRS)
+            return -1;
+
+        // erasure (120 - 123) and tone (126, 127) frames carry no speech parameters
+        int b0 = (ambe_d[0] << 6) | (ambe_d[1] << 5) | (ambe_d[2] << 4) | (ambe_d[3] << 3) |
+            (ambe_d[37] << 2) | (ambe_d[38] << 1) | ambe_d[39];
+        if ((b0 >= 120 && b0 <= 123) || b0 >= 126)
+            return -1;
+
+        mbe_parms* cur_mp = m_mbelibParms->m_cur_mp;
+        if (mbe_decodeAmbe2450Parms(ambe_d, cur_mp, m_mbelibParms->m_prev_mp) != 0)
+            return -1;
+
+        ambeToImbeParams(cur_mp, params);
+        advanceMbeParms(cur_mp, m_mbelibParms->m_prev_mp, m_mbelibParms->m_prev_mp_enhanced);
+        return errs;
+    }
+
+    case DECODE_88BIT_IMBE:
+    {
+        int16_t frame_vector[8U];
+        decodeIMBE(codeword, frame_vector);
+
+        const IMBE_PARAM* decoded = m_vocoder.imbe_decode_params(frame_vector);
+        if (decoded == nullptr)
+            return -1;
+
+        ::memcpy(params, decoded, sizeof(IMBE_PARAM));
+
+        // the PCM decoder predicts from the previous frame as well; keep it in step
+        char imbe_d[88U];
+        ::memset(imbe_d, 0x00U, 88U);
+
+        for (int i = 0; i < 11; ++i) {
+            for (int j = 0; j < 8; j++) {
+                imbe_d[j + (8 * i)] = (1 & (codeword[i] >> (7 - j)));
+            }
+        }
+
+        mbe_parms* cur_mp = m_mbelibParms->m_cur_mp;
+        if (mbe_decodeImbe4400Parms(imbe_d, cur_mp, m_mbelibParms->m_prev_mp) == 0)
+            advanceMbeParms(cur_mp, m_mbelibParms->m_prev_mp, m_mbelibParms->m_prev_mp_enhanced);
+
+        return 0;
+    }
+    }
+
+    return -1;
+}
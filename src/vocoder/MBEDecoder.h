@@ -22,6 +22,7 @@ extern "C" {
 }
 
 #include "common/Defines.h"
+#include "imbe/imbe_vocoder.h"
 
 #include <stdlib.h>
 #include <queue>
@@ -110,8 +111,20 @@ namespace vocoder
          */
         int32_t decode(uint8_t* codeword, int16_t samples[]);
 
+        /**
+         * @brief Decodes the given MBE codewords to MBE model parameters using the decoder mode,
+         *  skipping speech synthesis (for transcoding between MBE modes).
+         * @param[in] codeword MBE codeword.
+         * @param[out] params MBE model parameters.
+         * @returns int32_t Number of errors, or -1 if the codeword carries no speech parameters
+         *  (tone, erasure, or too many errors); the decoder state is then left untouched, and the
+         *  codeword may still be decoded to PCM samples.
+         */
+        int32_t decodeParams(uint8_t* codeword, IMBE_PARAM* params);
+
     private:
         mbelibParms* m_mbelibParms;
+        imbe_vocoder m_vocoder;
 
         MBE_DECODER_MODE m_mbeMode;
 
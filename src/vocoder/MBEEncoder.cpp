@@ -573,6 +573,48 @@ static void encodeDmrAMBE(const uint8_t* in, uint8_t* out)
     }
 }
 
+/**
+ * @brief Helper to pack IMBE frame vectors (u0 - u7) into 88-bit IMBE bytes.
+ * @param[in] frame_vector IMBE frame vectors.
+ * @param[out] codeword 88-bit IMBE bytes.
+ */
+static void encodeIMBE(const int16_t* frame_vector, uint8_t* codeword)
+{
+    uint32_t offset = 0U;
+    int16_t mask = 0x0800;
+
+    for (uint32_t i = 0U; i < 12U; i++, mask >>= 1, offset++)
+        WRITE_BIT(codeword, offset, (frame_vector[0U] & mask) != 0);
+
+    mask = 0x0800;
+    for (uint32_t i = 0U; i < 12U; i++, mask >>= 1, offset++)
+        WRITE_BIT(codeword, offset, (frame_vector[1U] & mask) != 0);
+
+    mask = 0x0800;
+    for (uint32_t i = 0U; i < 12U; i++, mask >>= 1, offset++)
+        WRITE_BIT(codeword, offset, (frame_vector[2U] & mask) != 0);
+
+    mask = 0x0800;
+    for (uint32_t i = 0U; i < 12U; i++, mask >>= 1, offset++)
+        WRITE_BIT(codeword, offset, (frame_vector[3U] & mask) != 0);
+
+    mask = 0x0400;
+    for (uint32_t i = 0U; i < 11U; i++, mask >>= 1, offset++)
+        WRITE_BIT(codeword, offset, (frame_vector[4U] & mask) != 0);
+
+    mask = 0x0400;
+    for (uint32_t i = 0U; i < 11U; i++, mask >>= 1, offset++)
+        WRITE_BIT(codeword, offset, (frame_vector[5U] & mask) != 0);
+
+    mask = 0x0400;
+    for (uint32_t i = 0U; i < 11U; i++, mask >>= 1, offset++)
+        WRITE_BIT(codeword, offset, (frame_vector[6U] & mask) != 0);
+
+    mask = 0x0040;
+    for (uint32_t i = 0U; i < 7U; i++, mask >>= 1, offset++)
+        WRITE_BIT(codeword, offset, (frame_vector[7U] & mask) != 0);
+}
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -653,48 +695,37 @@ void MBEEncoder::encode(int16_t* samples, uint8_t* codeword)
             m_vocoder.set_gain_adjust(m_gainAdjust);
         }
 
-        uint32_t offset = 0U;
-        int16_t mask = 0x0800;
-
-        for (uint32_t i = 0U; i < 12U; i++, mask >>= 1, offset++)
-            WRITE_BIT(codeword, offset, (frame_vector[0U] & mask) != 0);
-
-        mask = 0x0800;
-        for (uint32_t i = 0U; i < 12U; i++, mask >>= 1, offset++)
-            WRITE_BIT(codeword, offset, (frame_vector[1U] & mask) != 0);
-
-        mask = 0x0800;
-        for (uint32_t i = 0U; i < 12U; i++, mask >>= 1, offset++)
-            WRITE_BIT(codeword, offset, (frame_vector[2U] & mask) != 0);
-
-        mask = 0x0800;
-        for (uint32_t i = 0U; i < 12U; i++, mask >>= 1, offset++)
-            WRITE_BIT(codeword, offset, (frame_vector[3U] & mask) != 0);
+        encodeIMBE(frame_vector, codeword);
+    }
+    else {
+        encodeParams(m_vocoder.param(), codeword);
+    }
+}
 
-        mask = 0x0400;
-        for (uint32_t i = 0U; i < 11U; i++, mask >>= 1, offset++)
-            WRITE_BIT(codeword, offset, (frame_vector[4U] & mask) != 0);
+/* Encodes the given MBE model parameters using the encoder mode to MBE codewords. */
 
-        mask = 0x0400;
-        for (uint32_t i = 0U; i < 11U; i++, mask >>= 1, offset++)
-            WRITE_BIT(codeword, offset, (frame_vector[5U] & mask) != 0);
+void MBEEncoder::encodeParams(const IMBE_PARAM* params, uint8_t* codeword)
+{
+    assert(params != nullptr);
+    assert(codeword != nullptr);
 
-        mask = 0x0400;
-        for (uint32_t i = 0U; i < 11U; i++, mask >>= 1, offset++)
-            WRITE_BIT(codeword, offset, (frame_vector[6U] & mask) != 0);
+    if (m_mbeMode == ENCODE_88BIT_IMBE) {
+        int16_t frame_vector[8];
 
-        mask = 0x0040;
-        for (uint32_t i = 0U; i < 7U; i++, mask >>= 1, offset++)
-            WRITE_BIT(codeword, offset, (frame_vector[7U] & mask) != 0);
+        // quantize the parameters directly, skipping speech analysis
+        m_vocoder.imbe_encode_params(frame_vector, params);
+        encodeIMBE(frame_vector, codeword);
     }
     else {
         int b[9];
+        ::memset(b, 0x00, sizeof(b));
 
         // halfrate audio encoding - output rate is 2450 (49 bits)
-        encodeAMBE(m_vocoder.param(), b, &m_curMBEParms, &m_prevMBEParms, m_gainAdjust);
+        encodeAMBE(params, b, &m_curMBEParms, &m_prevMBEParms, m_gainAdjust);
 
-        uint8_t bits[49U];
-        ::memset(bits, 0x00U, 49U);
+        // padded to whole bytes; only the first 49 bits are used
+        uint8_t bits[72U];
+        ::memset(bits, 0x00U, 72U);
 
         encode49bit(bits, b);
 
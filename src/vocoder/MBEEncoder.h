@@ -65,6 +65,13 @@ namespace vocoder
          * @param[out] codeword MBE codewords.
          */
         void encode(int16_t* samples, uint8_t* codeword);
+        /**
+         * @brief Encodes the given MBE model parameters using the encoder mode to MBE codewords,
+         *  skipping speech analysis (for transcoding between MBE modes).
+         * @param[in] params MBE model parameters.
+         * @param[out] codeword MBE codewords.
+         */
+        void encodeParams(const IMBE_PARAM* params, uint8_t* codeword);
 
     private:
         imbe_vocoder m_vocoder;
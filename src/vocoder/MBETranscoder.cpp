@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - MBE Vocoder
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "vocoder/MBETranscoder.h"
+
+using namespace vocoder;
+
+#include <cassert>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the MBETranscoder class. */
+
+MBETranscoder::MBETranscoder(MBE_DECODER_MODE inputMode, MBE_ENCODER_MODE outputMode, MBE_TRANSCODE_MODE mode) :
+    m_inputMode(inputMode),
+    m_outputMode(outputMode),
+    m_mode(mode),
+    m_decoder(inputMode),
+    m_encoder(outputMode),
+    m_parametricFrames(0U),
+    m_pcmFrames(0U)
+{
+    /* stub */
+}
+
+/* Transcodes the given MBE codeword. */
+
+int32_t MBETranscoder::transcode(uint8_t* input, uint8_t* output)
+{
+    assert(input != nullptr);
+    assert(output != nullptr);
+
+    uint8_t codeword[11U];
+    ::memset(codeword, 0x00U, 11U);
+    ::memcpy(codeword, input, getInputLength());
+
+    if (m_mode == TRANSCODE_PARAMETRIC) {
+        IMBE_PARAM params;
+        int32_t errs = m_decoder.decodeParams(codeword, &params);
+        if (errs >= 0) {
+            ::memset(output, 0x00U, getOutputLength());
+            m_encoder.encodeParams(&params, output);
+            m_parametricFrames++;
+            return errs;
+        }
+    }
+
+    int16_t samples[160U];
+    ::memset(samples, 0x00U, sizeof(samples));
+    int32_t errs = m_decoder.decode(codeword, samples);
+
+    ::memset(output, 0x00U, getOutputLength());
+    m_encoder.encode(samples, output);
+    m_pcmFrames++;
+    return errs;
+}
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - MBE Vocoder
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file MBETranscoder.h
+ * @ingroup vocoder
+ * @file MBETranscoder.cpp
+ * @ingroup vocoder
+ */
+#if !defined(__MBE_TRANSCODER_H__)
+#define __MBE_TRANSCODER_H__
+
+#include "common/Defines.h"
+#include "vocoder/MBEDecoder.h"
+#include "vocoder/MBEEncoder.h"
+
+#include <stdint.h>
+
+namespace vocoder
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Vocoder Transcoding Mode
+     */
+    enum MBE_TRANSCODE_MODE {
+        TRANSCODE_PARAMETRIC,   //! Map MBE model parameters directly, falling back to PCM per frame
+        TRANSCODE_PCM           //! Always decode to PCM samples and re-encode
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements MBE transcoding between DMR AMBE and P25 IMBE codewords.
+     * @ingroup vocoder
+     *
+     *  In parametric mode the input codeword is only dequantized to its model parameters (pitch,
+     *  voicing and spectral amplitudes), which are requantized by the output encoder; speech
+     *  synthesis and analysis are skipped entirely. Frames that carry no speech parameters (tones,
+     *  erasures, or too many errors) fall back to full PCM transcoding, which repeats or mutes them
+     *  like a decoder would. Both paths share the same encoder; the parametric and PCM decoders
+     *  keep separate prediction state, but each frame decoded by either path advances both, so
+     *  the state always matches the far end.
+     */
+    class HOST_SW_API MBETranscoder {
+    public:
+        /**
+         * @brief Initializes a new instance of the MBETranscoder class.
+         * @param inputMode Input (decoder) mode.
+         * @param outputMode Output (encoder) mode.
+         * @param mode Transcoding mode.
+         */
+        MBETranscoder(MBE_DECODER_MODE inputMode, MBE_ENCODER_MODE outputMode, MBE_TRANSCODE_MODE mode = TRANSCODE_PARAMETRIC);
+
+        /**
+         * @brief Transcodes the given MBE codeword.
+         * @param[in] input MBE codeword, in the input mode.
+         * @param[out] output MBE codeword, in the output mode (may be the same buffer as the input).
+         * @returns int32_t Number of errors in the input codeword.
+         */
+        int32_t transcode(uint8_t* input, uint8_t* output);
+
+        /**
+         * @brief Gets the length of an input codeword.
+         * @returns uint32_t Length of an input codeword.
+         */
+        uint32_t getInputLength() const { return (m_inputMode == DECODE_DMR_AMBE) ? 9U : 11U; }
+        /**
+         * @brief Gets the length of an output codeword.
+         * @returns uint32_t Length of an output codeword.
+         */
+        uint32_t getOutputLength() const { return (m_outputMode == ENCODE_DMR_AMBE) ? 9U : 11U; }
+
+        /**
+         * @brief Gets the number of frames transcoded at the parameter level.
+         * @returns uint32_t Number of frames.
+         */
+        uint32_t getParametricFrames() const { return m_parametricFrames; }
+        /**
+         * @brief Gets the number of frames transcoded through PCM samples.
+         * @returns uint32_t Number of frames.
+         */
+        uint32_t getPCMFrames() const { return m_pcmFrames; }
+
+    private:
+        MBE_DECODER_MODE m_inputMode;
+        MBE_ENCODER_MODE m_outputMode;
+        MBE_TRANSCODE_MODE m_mode;
+
+        MBEDecoder m_decoder;
+        MBEEncoder m_encoder;
+
+        uint32_t m_parametricFrames;
+        uint32_t m_pcmFrames;
+    };
+} // namespace vocoder
+
+#endif // __MBE_TRANSCODER_H__
@@ -0,0 +1,493 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - MBE Vocoder
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "common/Log.h"
+#include "vocoder/VocoderPool.h"
+
+using namespace vocoder;
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <string>
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helper to get a monotonic timestamp.
+ * @returns uint64_t Timestamp (us).
+ */
+static uint64_t monotonicUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Helper to release the codec state of a closing stream. Whichever thread wins the state
+ *  change does the release.
+ * @param stream Stream.
+ */
+static void releaseStream(VocoderStream* stream)
+{
+    uint8_t expected = VocoderStream::STREAM_CLOSING;
+    if (!stream->state.compare_exchange_strong(expected, VocoderStream::STREAM_OPENING, std::memory_order_acq_rel))
+        return;
+
+    if (stream->decoder != nullptr) {
+        delete stream->decoder;
+        stream->decoder = nullptr;
+    }
+
+    if (stream->encoder != nullptr) {
+        delete stream->encoder;
+        stream->encoder = nullptr;
+    }
+
+    if (stream->transcoder != nullptr) {
+        delete stream->transcoder;
+        stream->transcoder = nullptr;
+    }
+
+    stream->input.clear();
+    stream->state.store(VocoderStream::STREAM_FREE, std::memory_order_release);
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the VocoderPool class. */
+
+VocoderPool::VocoderPool(uint32_t workers, uint32_t maxStreams, uint32_t depth) :
+    m_workerCount(workers),
+    m_workers(nullptr),
+    m_startedWorkers(0U),
+    m_streamCount(maxStreams),
+    m_streams(nullptr),
+    m_running(false)
+{
+    assert(workers > 0U);
+    assert(maxStreams > 0U);
+    assert(depth > 0U);
+
+    m_workers = new VocoderWorker[m_workerCount];
+    for (uint32_t i = 0U; i < m_workerCount; i++) {
+        m_workers[i].pool = this;
+        m_workers[i].index = i;
+        m_workers[i].idle.store(false);
+        m_workers[i].processed.store(0U);
+        m_workers[i].maxLatency.store(0U);
+    }
+
+    m_streams = new VocoderStream*[m_streamCount];
+    for (uint32_t i = 0U; i < m_streamCount; i++)
+        m_streams[i] = new VocoderStream(depth);
+}
+
+/* Finalizes a instance of the VocoderPool class. */
+
+VocoderPool::~VocoderPool()
+{
+    stop();
+
+    for (uint32_t i = 0U; i < m_streamCount; i++) {
+        if (m_streams[i]->decoder != nullptr)
+            delete m_streams[i]->decoder;
+        if (m_streams[i]->encoder != nullptr)
+            delete m_streams[i]->encoder;
+        if (m_streams[i]->transcoder != nullptr)
+            delete m_streams[i]->transcoder;
+        delete m_streams[i];
+    }
+
+    delete[] m_streams;
+    delete[] m_workers;
+}
+
+/* Starts the worker threads. */
+
+bool VocoderPool::start()
+{
+    if (m_running)
+        return true;
+
+    m_running = true;
+    for (uint32_t i = 0U; i < m_workerCount; i++) {
+        if (!Thread::runAsThread(&m_workers[i], threadWorker, &m_workers[i].thread)) {
+            LogError(LOG_HOST, "Failed to start vocoder worker %u", i);
+            stop();
+            return false;
+        }
+
+        m_startedWorkers++;
+    }
+
+    return true;
+}
+
+/* Stops the worker threads, waiting for them to exit. */
+
+void VocoderPool::stop()
+{
+    if (!m_running)
+        return;
+
+    m_running = false;
+    for (uint32_t i = 0U; i < m_startedWorkers; i++) {
+        {
+            std::lock_guard<std::mutex> lock(m_workers[i].mutex);
+            m_workers[i].wakeup.notify_one();
+        }
+#if defined(_WIN32)
+        ::WaitForSingleObject(m_workers[i].thread.thread, INFINITE);
+        ::CloseHandle(m_workers[i].thread.thread);
+#else
+        ::pthread_join(m_workers[i].thread.thread, NULL);
+#endif // defined(_WIN32)
+    }
+
+    m_startedWorkers = 0U;
+
+    // release streams closed after their worker stopped servicing them
+    for (uint32_t i = 0U; i < m_streamCount; i++)
+        releaseStream(m_streams[i]);
+}
+
+/* Opens a stream. */
+
+int32_t VocoderPool::open(MBE_DECODER_MODE decodeMode, MBE_ENCODER_MODE encodeMode, float decoderGain,
+    bool decoderAutoGain, float encoderGain)
+{
+    int32_t handle = claim();
+    if (handle < 0)
+        return -1;
+
+    // the slot belongs to this thread until it is marked open
+    VocoderStream* stream = m_streams[handle];
+    stream->decoder = new MBEDecoder(decodeMode);
+    stream->decoder->setGainAdjust(decoderGain);
+    stream->decoder->setAutoGain(decoderAutoGain);
+    stream->encoder = new MBEEncoder(encodeMode);
+    stream->encoder->setGainAdjust(encoderGain);
+
+    stream->output.clear();
+    stream->state.store(VocoderStream::STREAM_OPEN, std::memory_order_release);
+    return handle;
+}
+
+/* Opens a transcoding stream. */
+
+int32_t VocoderPool::openTranscoder(MBE_DECODER_MODE inputMode, MBE_ENCODER_MODE outputMode, MBE_TRANSCODE_MODE mode)
+{
+    int32_t handle = claim();
+    if (handle < 0)
+        return -1;
+
+    // the slot belongs to this thread until it is marked open
+    VocoderStream* stream = m_streams[handle];
+    stream->transcoder = new MBETranscoder(inputMode, outputMode, mode);
+
+    stream->output.clear();
+    stream->state.store(VocoderStream::STREAM_OPEN, std::memory_order_release);
+    return handle;
+}
+
+/* Closes a stream. */
+
+void VocoderPool::close(int32_t stream)
+{
+    if (stream < 0 || (uint32_t)stream >= m_streamCount)
+        return;
+
+    VocoderStream* s = m_streams[stream];
+    uint8_t expected = VocoderStream::STREAM_OPEN;
+    if (!s->state.compare_exchange_strong(expected, VocoderStream::STREAM_CLOSING, std::memory_order_acq_rel))
+        return;
+
+    // the owning worker releases the stream; without running workers, release it here
+    if (!m_running)
+        releaseStream(s);
+    else
+        wake(stream);
+}
+
+/* Gets a free frame at the end of the stream input queue, to be filled in place. */
+
+VocoderFrame* VocoderPool::reserve(int32_t stream, uint32_t n)
+{
+    assert(stream >= 0 && (uint32_t)stream < m_streamCount);
+    return m_streams[stream]->input.reserve(n);
+}
+
+/* Submits previously reserved frames to the stream worker. */
+
+void VocoderPool::submit(int32_t stream, uint32_t count)
+{
+    assert(stream >= 0 && (uint32_t)stream < m_streamCount);
+
+    VocoderStream* s = m_streams[stream];
+    uint64_t now = monotonicUs();
+    for (uint32_t i = 0U; i < count; i++)
+        s->input.reserve(i)->submitted = now;
+
+    s->input.commit(count);
+    wake(stream);
+}
+
+/* Queues a codeword to be decoded. */
+
+bool VocoderPool::decode(int32_t stream, const uint8_t* codeword, uint32_t length, uint64_t tag)
+{
+    assert(codeword != nullptr);
+    assert(length <= VOCODER_CODEWORD_LENGTH);
+
+    VocoderFrame* frame = reserve(stream);
+    if (frame == nullptr)
+        return false;
+
+    frame->op = VOCODER_DECODE;
+    frame->tag = tag;
+    ::memset(frame->codeword, 0x00U, VOCODER_CODEWORD_LENGTH);
+    ::memcpy(frame->codeword, codeword, length);
+
+    submit(stream);
+    return true;
+}
+
+/* Queues PCM samples to be encoded. */
+
+bool VocoderPool::encode(int32_t stream, const int16_t* samples, uint64_t tag)
+{
+    assert(samples != nullptr);
+
+    VocoderFrame* frame = reserve(stream);
+    if (frame == nullptr)
+        return false;
+
+    frame->op = VOCODER_ENCODE;
+    frame->tag = tag;
+    ::memcpy(frame->samples, samples, sizeof(frame->samples));
+
+    submit(stream);
+    return true;
+}
+
+/* Queues a codeword to be transcoded, on a transcoding stream. */
+
+bool VocoderPool::transcode(int32_t stream, const uint8_t* codeword, uint32_t length, uint64_t tag)
+{
+    assert(codeword != nullptr);
+    assert(length <= VOCODER_CODEWORD_LENGTH);
+
+    VocoderFrame* frame = reserve(stream);
+    if (frame == nullptr)
+        return false;
+
+    frame->op = VOCODER_TRANSCODE;
+    frame->tag = tag;
+    ::memset(frame->codeword, 0x00U, VOCODER_CODEWORD_LENGTH);
+    ::memcpy(frame->codeword, codeword, length);
+
+    submit(stream);
+    return true;
+}
+
+/* Gets the oldest processed frame of the stream, leaving it in the queue. */
+
+VocoderFrame* VocoderPool::front(int32_t stream)
+{
+    assert(stream >= 0 && (uint32_t)stream < m_streamCount);
+    return m_streams[stream]->output.front();
+}
+
+/* Removes the oldest processed frame of the stream. */
+
+void VocoderPool::pop(int32_t stream)
+{
+    assert(stream >= 0 && (uint32_t)stream < m_streamCount);
+
+    VocoderStream* s = m_streams[stream];
+    s->output.pop();
+
+    // a full output queue holds back the worker, let it know there is room again
+    if (!s->input.isEmpty())
+        wake(stream);
+}
+
+/* Gets the number of frames processed by the workers. */
+
+uint32_t VocoderPool::getProcessed() const
+{
+    uint32_t processed = 0U;
+    for (uint32_t i = 0U; i < m_workerCount; i++)
+        processed += m_workers[i].processed.load(std::memory_order_relaxed);
+
+    return processed;
+}
+
+/* Gets the longest time a frame has spent between being submitted and processed. */
+
+uint32_t VocoderPool::getMaxLatency() const
+{
+    uint32_t latency = 0U;
+    for (uint32_t i = 0U; i < m_workerCount; i++)
+        latency = std::max(latency, m_workers[i].maxLatency.load(std::memory_order_relaxed));
+
+    return latency;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to claim a free stream slot. */
+
+int32_t VocoderPool::claim()
+{
+    for (uint32_t i = 0U; i < m_streamCount; i++) {
+        uint8_t expected = VocoderStream::STREAM_FREE;
+        if (m_streams[i]->state.compare_exchange_strong(expected, VocoderStream::STREAM_OPENING, std::memory_order_acq_rel))
+            return (int32_t)i;
+    }
+
+    return -1;
+}
+
+/* Helper to process queued frames of the streams owned by a worker. */
+
+uint32_t VocoderPool::process(VocoderWorker* worker)
+{
+    uint32_t processed = 0U;
+    uint32_t maxLatency = 0U;
+
+    for (uint32_t i = worker->index; i < m_streamCount; i += m_workerCount) {
+        VocoderStream* stream = m_streams[i];
+
+        uint8_t state = stream->state.load(std::memory_order_acquire);
+        if (state == VocoderStream::STREAM_CLOSING) {
+            releaseStream(stream);
+            continue;
+        }
+
+        if (state != VocoderStream::STREAM_OPEN)
+            continue;
+
+        for (uint32_t n = 0U; n < VOCODER_WORKER_BURST; n++) {
+            VocoderFrame* frame = stream->input.front();
+            if (frame == nullptr)
+                break;
+
+            // an unread output queue holds back the stream, rather than dropping processed frames
+            VocoderFrame* result = stream->output.reserve();
+            if (result == nullptr)
+                break;
+
+            result->op = frame->op;
+            result->tag = frame->tag;
+            result->submitted = frame->submitted;
+            result->errs = 0;
+            if (frame->op == VOCODER_DECODE) {
+                ::memcpy(result->codeword, frame->codeword, VOCODER_CODEWORD_LENGTH);
+                result->errs = stream->decoder->decode(result->codeword, result->samples);
+            }
+            else if (frame->op == VOCODER_TRANSCODE) {
+                ::memcpy(result->codeword, frame->codeword, VOCODER_CODEWORD_LENGTH);
+                result->errs = stream->transcoder->transcode(result->codeword, result->codeword);
+            }
+            else {
+                ::memcpy(result->samples, frame->samples, sizeof(result->samples));
+                ::memset(result->codeword, 0x00U, VOCODER_CODEWORD_LENGTH);
+                stream->encoder->encode(result->samples, result->codeword);
+            }
+
+            uint64_t latency = monotonicUs() - frame->submitted;
+            if (latency > maxLatency)
+                maxLatency = (uint32_t)latency;
+
+            stream->input.pop();
+            stream->output.commit();
+            processed++;
+        }
+    }
+
+    if (processed > 0U) {
+        worker->processed.fetch_add(processed, std::memory_order_relaxed);
+        if (maxLatency > worker->maxLatency.load(std::memory_order_relaxed))
+            worker->maxLatency.store(maxLatency, std::memory_order_relaxed);
+    }
+
+    return processed;
+}
+
+/* Helper to wake the worker owning the given stream, if it is idle. */
+
+void VocoderPool::wake(int32_t stream)
+{
+    VocoderWorker* worker = &m_workers[(uint32_t)stream % m_workerCount];
+
+    // the queued frames must be visible before the worker's idle flag is checked (the worker
+    // checks its streams again after setting it, so one side always sees the other)
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // the lock is only taken when the worker is (about to be) asleep
+    if (worker->idle.exchange(false, std::memory_order_acq_rel)) {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->wakeup.notify_one();
+    }
+}
+
+/* Entry point to a worker thread. */
+
+void* VocoderPool::threadWorker(void* arg)
+{
+    thread_t* th = (thread_t*)arg;
+    if (th != nullptr) {
+        VocoderWorker* worker = static_cast<VocoderWorker*>(th->obj);
+        if (worker == nullptr) {
+            return nullptr;
+        }
+
+        VocoderPool* pool = worker->pool;
+        std::string threadName = "vocoder:worker-" + std::to_string(worker->index);
+
+        LogDebug(LOG_HOST, "[ OK ] %s", threadName.c_str());
+#ifdef _GNU_SOURCE
+        ::pthread_setname_np(th->thread, threadName.c_str());
+#endif // _GNU_SOURCE
+
+        while (pool->m_running) {
+            if (pool->process(worker) > 0U)
+                continue;
+
+            // announce we're going idle, then check once more so a frame submitted in between
+            // isn't missed (there is no timeout to pick it up later)
+            worker->idle.store(true, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (pool->process(worker) > 0U) {
+                worker->idle.store(false, std::memory_order_relaxed);
+                continue;
+            }
+
+            // sleep until a stream is submitted to, closed or has room in its output queue (any of
+            // which clears the idle flag), or the pool is stopped
+            std::unique_lock<std::mutex> lock(worker->mutex);
+            worker->wakeup.wait(lock, [worker, pool]() {
+                return !worker->idle.load(std::memory_order_acquire) || !pool->m_running;
+            });
+            worker->idle.store(false, std::memory_order_relaxed);
+        }
+
+        LogDebug(LOG_HOST, "[STOP] %s", threadName.c_str());
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,314 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - MBE Vocoder
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file VocoderPool.h
+ * @ingroup vocoder
+ * @file VocoderPool.cpp
+ * @ingroup vocoder
+ */
+#if !defined(__VOCODER_POOL_H__)
+#define __VOCODER_POOL_H__
+
+#include "common/Defines.h"
+#include "common/SPSCQueue.h"
+#include "common/Thread.h"
+#include "vocoder/MBEDecoder.h"
+#include "vocoder/MBEEncoder.h"
+#include "vocoder/MBETranscoder.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace vocoder
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Number of PCM samples in a vocoder frame (20ms at 8kHz).
+     */
+    const uint32_t VOCODER_SAMPLES_LENGTH = 160U;
+    /**
+     * @brief Maximum length of a vocoder codeword (9 byte DMR AMBE, 11 byte P25 IMBE).
+     */
+    const uint32_t VOCODER_CODEWORD_LENGTH = 11U;
+    /**
+     * @brief Maximum number of frames a worker processes from a stream, before moving on to the
+     *  next stream it owns.
+     */
+    const uint32_t VOCODER_WORKER_BURST = 9U;
+
+    /**
+     * @brief Vocoder Frame Operation
+     */
+    enum VOCODER_OPERATION {
+        VOCODER_DECODE,     //! Decode a codeword to PCM samples
+        VOCODER_ENCODE,     //! Encode PCM samples to a codeword
+        VOCODER_TRANSCODE   //! Transcode a codeword to another MBE mode (in place)
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents a frame queued to, or returned from, the vocoder pool.
+     * @ingroup vocoder
+     */
+    struct VocoderFrame {
+        VOCODER_OPERATION op;                               //! Operation to perform.
+        uint64_t tag;                                       //! Caller tag, returned with the result.
+        uint8_t codeword[VOCODER_CODEWORD_LENGTH];          //! MBE codeword.
+        int16_t samples[VOCODER_SAMPLES_LENGTH];            //! PCM samples.
+        int32_t errs;                                       //! Number of errors corrected while decoding.
+        uint64_t submitted;                                 //! Time the frame was submitted (us).
+    };
+
+    class HOST_SW_API VocoderPool;
+
+    /**
+     * @brief Represents the codec state of a single vocoder stream.
+     * @ingroup vocoder
+     */
+    struct VocoderStream {
+        /**
+         * @brief Initializes a new instance of the VocoderStream struct.
+         * @param depth Maximum number of frames queued in either direction.
+         */
+        VocoderStream(uint32_t depth) :
+            state(STREAM_FREE),
+            decoder(nullptr),
+            encoder(nullptr),
+            transcoder(nullptr),
+            input(depth, "Vocoder Input"),
+            output(depth, "Vocoder Output")
+        {
+            /* stub */
+        }
+
+        /**
+         * @brief Stream state.
+         */
+        enum STATE : uint8_t {
+            STREAM_FREE,                                    //! Slot is unused.
+            STREAM_OPENING,                                 //! Slot is being set up by the opening thread.
+            STREAM_OPEN,                                    //! Slot is serviced by its worker.
+            STREAM_CLOSING                                  //! Slot is waiting for its worker to release it.
+        };
+        std::atomic<uint8_t> state;
+
+        MBEDecoder* decoder;
+        MBEEncoder* encoder;
+        MBETranscoder* transcoder;
+
+        SPSCQueue<VocoderFrame> input;                      //! Owner -> worker.
+        SPSCQueue<VocoderFrame> output;                     //! Worker -> owner.
+    };
+
+    /**
+     * @brief Represents a vocoder pool worker thread.
+     * @ingroup vocoder
+     */
+    struct VocoderWorker {
+        VocoderPool* pool;
+        uint32_t index;
+        thread_t thread;
+
+        std::mutex mutex;
+        std::condition_variable wakeup;
+        std::atomic<bool> idle;
+
+        std::atomic<uint32_t> processed;
+        std::atomic<uint32_t> maxLatency;
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements a pool of vocoder worker threads, holding the codec state of many streams.
+     * @ingroup vocoder
+     *
+     *  Each stream (one leg of a call) owns its own decoder and encoder, or transcoder, and is
+     *  serviced by exactly one worker (stream slot modulo worker count), so codec state is never
+     *  shared between threads and frames of a stream are processed in order. Frames are handed to
+     *  and from the worker on per-stream single producer/single consumer lock-free queues; the
+     *  thread that opened a stream is its sole producer and consumer.
+     *
+     *  Workers service their streams round-robin, at most VOCODER_WORKER_BURST frames at a time, so
+     *  a busy stream can't starve the others; the latency of a frame is bounded by the queue depth
+     *  and the number of streams per worker. A full input queue is reported to the caller rather
+     *  than growing the backlog.
+     */
+    class HOST_SW_API VocoderPool {
+    public:
+        /**
+         * @brief Initializes a new instance of the VocoderPool class.
+         * @param workers Number of worker threads.
+         * @param maxStreams Maximum number of open streams.
+         * @param depth Maximum number of frames queued to, or from, a stream.
+         */
+        VocoderPool(uint32_t workers, uint32_t maxStreams, uint32_t depth);
+        /**
+         * @brief Finalizes a instance of the VocoderPool class.
+         */
+        ~VocoderPool();
+
+        /**
+         * @brief Starts the worker threads.
+         * @returns bool True, if the workers were started, otherwise false.
+         */
+        bool start();
+        /**
+         * @brief Stops the worker threads, waiting for them to exit.
+         */
+        void stop();
+
+        /**
+         * @brief Opens a stream.
+         * @param decodeMode Decoder mode.
+         * @param encodeMode Encoder mode.
+         * @param decoderGain Decoder gain adjustment.
+         * @param decoderAutoGain Flag indicating automatic decoder gain adjustment is enabled.
+         * @param encoderGain Encoder gain adjustment.
+         * @returns int32_t Stream handle, or -1 if no stream is available.
+         */
+        int32_t open(MBE_DECODER_MODE decodeMode, MBE_ENCODER_MODE encodeMode, float decoderGain = 1.0f,
+            bool decoderAutoGain = false, float encoderGain = 1.0f);
+        /**
+         * @brief Opens a transcoding stream.
+         * @param inputMode Input (decoder) mode.
+         * @param outputMode Output (encoder) mode.
+         * @param mode Transcoding mode.
+         * @returns int32_t Stream handle, or -1 if no stream is available.
+         */
+        int32_t openTranscoder(MBE_DECODER_MODE inputMode, MBE_ENCODER_MODE outputMode, MBE_TRANSCODE_MODE mode = TRANSCODE_PARAMETRIC);
+        /**
+         * @brief Closes a stream. Frames still queued to, or from, the stream are discarded.
+         * @param stream Stream handle.
+         */
+        void close(int32_t stream);
+
+        /**
+         * @brief Gets a free frame at the end of the stream input queue, to be filled in place. The
+         *  frame isn't visible to the worker until it is submitted.
+         * @param stream Stream handle.
+         * @param n Offset of the frame past the end of the queue (for batching frames).
+         * @returns VocoderFrame* Free frame, or nullptr if the queue is full.
+         */
+        VocoderFrame* reserve(int32_t stream, uint32_t n = 0U);
+        /**
+         * @brief Submits previously reserved frames to the stream worker.
+         * @param stream Stream handle.
+         * @param count Number of frames.
+         */
+        void submit(int32_t stream, uint32_t count = 1U);
+
+        /**
+         * @brief Queues a codeword to be decoded.
+         * @param stream Stream handle.
+         * @param[in] codeword MBE codeword.
+         * @param length Length of the codeword.
+         * @param tag Caller tag, returned with the result.
+         * @returns bool True, if the codeword was queued, otherwise false.
+         */
+        bool decode(int32_t stream, const uint8_t* codeword, uint32_t length, uint64_t tag = 0U);
+        /**
+         * @brief Queues PCM samples to be encoded.
+         * @param stream Stream handle.
+         * @param[in] samples PCM samples (VOCODER_SAMPLES_LENGTH samples).
+         * @param tag Caller tag, returned with the result.
+         * @returns bool True, if the samples were queued, otherwise false.
+         */
+        bool encode(int32_t stream, const int16_t* samples, uint64_t tag = 0U);
+        /**
+         * @brief Queues a codeword to be transcoded, on a transcoding stream.
+         * @param stream Stream handle.
+         * @param[in] codeword MBE codeword.
+         * @param length Length of the codeword.
+         * @param tag Caller tag, returned with the result.
+         * @returns bool True, if the codeword was queued, otherwise false.
+         */
+        bool transcode(int32_t stream, const uint8_t* codeword, uint32_t length, uint64_t tag = 0U);
+
+        /**
+         * @brief Gets the oldest processed frame of the stream, leaving it in the queue.
+         * @param stream Stream handle.
+         * @returns VocoderFrame* Processed frame, or nullptr if there are none.
+         */
+        VocoderFrame* front(int32_t stream);
+        /**
+         * @brief Removes the oldest processed frame of the stream.
+         * @param stream Stream handle.
+         */
+        void pop(int32_t stream);
+
+        /**
+         * @brief Gets the number of frames processed by the workers.
+         * @returns uint32_t Number of frames processed.
+         */
+        uint32_t getProcessed() const;
+        /**
+         * @brief Gets the longest time a frame has spent between being submitted and processed.
+         * @returns uint32_t Latency (us).
+         */
+        uint32_t getMaxLatency() const;
+
+        /**
+         * @brief Gets the number of worker threads.
+         * @returns uint32_t Number of worker threads.
+         */
+        uint32_t getWorkers() const { return m_workerCount; }
+        /**
+         * @brief Gets the maximum number of open streams.
+         * @returns uint32_t Maximum number of open streams.
+         */
+        uint32_t getMaxStreams() const { return m_streamCount; }
+
+    private:
+        uint32_t m_workerCount;
+        VocoderWorker* m_workers;
+        uint32_t m_startedWorkers;
+
+        uint32_t m_streamCount;
+        VocoderStream** m_streams;
+
+        std::atomic<bool> m_running;
+
+        /**
+         * @brief Helper to claim a free stream slot.
+         * @returns int32_t Stream handle, or -1 if no stream is available.
+         */
+        int32_t claim();
+        /**
+         * @brief Helper to process queued frames of the streams owned by a worker.
+         * @param worker Worker.
+         * @returns uint32_t Number of frames processed.
+         */
+        uint32_t process(VocoderWorker* worker);
+        /**
+         * @brief Helper to wake the worker owning the given stream, if it is idle.
+         * @param stream Stream handle.
+         */
+        void wake(int32_t stream);
+
+        /**
+         * @brief Entry point to a worker thread.
+         * @param arg Instance of the thread_t structure.
+         * @returns void* (Ignore)
+         */
+        static void* threadWorker(void* arg);
+    };
+} // namespace vocoder
+
+#endif // __VOCODER_POOL_H__
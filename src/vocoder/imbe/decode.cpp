@@ -63,3 +63,28 @@ void imbe_vocoder::decode(IMBE_PARAM* imbe_param, Word16* frame_vector, Word16*
     for (j = 0; j < FRAME; j++)
         snd[j] = add(snd[j], snd_tmp[j]);
 }
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+const IMBE_PARAM* imbe_vocoder::imbe_decode_params(Word16* frame_vector)
+{
+    // frames with an invalid fundamental frequency (silence, tones) carry no speech parameters
+    Word16 b0 = (shr(frame_vector[0], 4) & 0xFC) | (shr(frame_vector[7], 1) & 0x3);
+    if (b0 < 0 || b0 > 207)
+        return nullptr;
+
+    decode_frame_vector(&my_imbe_param, frame_vector);
+    v_uv_decode(&my_imbe_param);
+    sa_decode(&my_imbe_param);
+
+    // the decoder only carries the quantized pitch; reconstruct the refined pitch from it, within
+    // the range of the pitch estimator (19.875 - 123.125)
+    my_imbe_param.ref_pitch = shl(b0, 7) + 0x13C0;                         // Q8.8 (b0 + 39.5) / 2
+    if (my_imbe_param.ref_pitch < 0x13E0)
+        my_imbe_param.ref_pitch = 0x13E0;
+    if (my_imbe_param.ref_pitch > 0x7B20)
+        my_imbe_param.ref_pitch = 0x7B20;
+    return &my_imbe_param;
+}
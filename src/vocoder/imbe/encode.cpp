@@ -89,3 +89,16 @@ void imbe_vocoder::encode(IMBE_PARAM* imbe_param, Word16* frame_vector, Word16*
     sa_encode(imbe_param);
     encode_frame_vector(imbe_param, frame_vector);
 }
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+void imbe_vocoder::imbe_encode_params(Word16* frame_vector, const IMBE_PARAM* param)
+{
+    if (param != &my_imbe_param)
+        memcpy(&my_imbe_param, param, sizeof(IMBE_PARAM));
+
+    sa_encode(&my_imbe_param);
+    encode_frame_vector(&my_imbe_param, frame_vector);
+}
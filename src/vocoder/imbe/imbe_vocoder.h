@@ -56,6 +56,18 @@ public:
         decode(&my_imbe_param, frame_vector, snd);
     }
     
+    // imbe_decode_params decodes IMBE codewords (frame_vector) to speech parameters,
+    // without synthesis (returns nullptr for frames that carry no speech parameters)
+    const IMBE_PARAM* imbe_decode_params(int16_t *frame_vector);
+
+    // imbe_decode_reset resets the spectral amplitude prediction of the decoder
+    // (as the first frame of a call decodes)
+    void imbe_decode_reset(void) { sa_decode_init(); }
+
+    // imbe_encode_params quantizes the given speech parameters to IMBE codewords
+    // (frame_vector), without analysis
+    void imbe_encode_params(int16_t *frame_vector, const IMBE_PARAM *param);
+
     // hack to enable ambe encoder read access to speech parameters
     const IMBE_PARAM* param(void) { return &my_imbe_param; }
     void set_gain_adjust(float gain_adjust) { d_gain_adjust = gain_adjust; }
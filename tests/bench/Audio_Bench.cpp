@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/Resampler.h"
+#include "bench/BenchCorpus.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <cmath>
+#include <string>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const double AUDIO_BENCH_PI = 3.14159265358979323846;
+const double AUDIO_BENCH_AMPLITUDE = 10000.0;
+
+const uint32_t AUDIO_BENCH_FRAME_MS = 20U;
+
+TEST_CASE("Resampler", "[bench][audio]") {
+    const uint32_t rates[][2] = { { 16000U, 8000U }, { 48000U, 8000U }, { 8000U, 16000U }, { 8000U, 48000U } };
+    for (auto& pair : rates) {
+        uint32_t frameLength = (pair[0] * AUDIO_BENCH_FRAME_MS) / 1000U;
+
+        // a continuous 1kHz tone, walked a 20ms frame at a time (as the bridge feeds the resampler)
+        std::vector<short> input(frameLength * BENCH_CORPUS_FRAMES);
+        for (uint32_t i = 0U; i < input.size(); i++)
+            input[i] = (short)::lrint(AUDIO_BENCH_AMPLITUDE * ::sin(2.0 * AUDIO_BENCH_PI * 1000.0 * i / pair[0]));
+
+        Resampler resampler(pair[0], pair[1]);
+        std::vector<short> output(resampler.maxOutput(frameLength));
+
+        std::string name = "Resampler " + std::to_string(pair[0]) + " -> " + std::to_string(pair[1]);
+        BENCHMARK_ADVANCED(name.c_str())(Catch::Benchmark::Chronometer meter) {
+            meter.measure([&](int i) {
+                const short* frame = input.data() + ((i % BENCH_CORPUS_FRAMES) * frameLength);
+                return resampler.process(frame, frameLength, output.data());
+            });
+        };
+    }
+}
@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#if !defined(__BENCH_CORPUS_H__)
+#define __BENCH_CORPUS_H__
+
+#include "common/Defines.h"
+#include "common/Utils.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Number of frames in a benchmark corpus.
+ *
+ *  Benchmarks walk the corpus frame by frame, so the timed loop sees varying frame content (and
+ *  error patterns) rather than the same, branch predictor friendly, frame over and over.
+ */
+const uint32_t BENCH_CORPUS_FRAMES = 256U;
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Represents a corpus of equally sized frames a benchmark is run over.
+ */
+class BenchCorpus {
+public:
+    /**
+     * @brief Initializes a new instance of the BenchCorpus class.
+     * @param length Length of a frame.
+     * @param frames Number of frames.
+     */
+    BenchCorpus(uint32_t length, uint32_t frames = BENCH_CORPUS_FRAMES) :
+        m_length(length),
+        m_frames(frames),
+        m_data(length * frames, 0x00U)
+    {
+        /* stub */
+    }
+
+    /**
+     * @brief Gets the given frame, wrapping around the end of the corpus.
+     * @param n Frame number.
+     * @returns uint8_t* Frame.
+     */
+    uint8_t* operator[](uint32_t n) { return m_data.data() + ((n % m_frames) * m_length); }
+    /**
+     * @brief Gets the given frame, wrapping around the end of the corpus.
+     * @param n Frame number.
+     * @returns const uint8_t* Frame.
+     */
+    const uint8_t* operator[](uint32_t n) const { return m_data.data() + ((n % m_frames) * m_length); }
+
+    /**
+     * @brief Gets the length of a frame.
+     * @returns uint32_t Length of a frame.
+     */
+    uint32_t length() const { return m_length; }
+    /**
+     * @brief Gets the number of frames.
+     * @returns uint32_t Number of frames.
+     */
+    uint32_t frames() const { return m_frames; }
+
+    /**
+     * @brief Helper to fill the given buffer with random bytes.
+     * @param rng Random number generator.
+     * @param[out] data Buffer.
+     * @param length Length of buffer.
+     */
+    static void random(std::mt19937& rng, uint8_t* data, uint32_t length)
+    {
+        for (uint32_t i = 0U; i < length; i++)
+            data[i] = (uint8_t)rng();
+    }
+
+    /**
+     * @brief Helper to flip random bits, from the given range of bits. The same bit may be picked
+     *  more than once, so at most the given number of bits are flipped.
+     * @param rng Random number generator.
+     * @param[in,out] data Buffer.
+     * @param start First bit of the range.
+     * @param bits Number of bits in the range.
+     * @param errors Number of bits to flip.
+     */
+    static void flipBits(std::mt19937& rng, uint8_t* data, uint32_t start, uint32_t bits, uint32_t errors)
+    {
+        for (uint32_t i = 0U; i < errors; i++) {
+            uint32_t pos = start + (rng() % bits);
+            bool b = READ_BIT(data, pos) != 0x00U;
+            WRITE_BIT(data, pos, !b);
+        }
+    }
+
+private:
+    uint32_t m_length;
+    uint32_t m_frames;
+    std::vector<uint8_t> m_data;
+};
+
+#endif // __BENCH_CORPUS_H__
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/AESCrypto.h"
+#include "bench/BenchCorpus.h"
+
+using namespace crypto;
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Length of an encrypted DMR network frame (RTP and FNE headers with a 55 byte DMR message,
+ *  padded to the AES block length).
+ */
+const uint32_t AES_DMR_FRAME_BYTES = 96U;
+/**
+ * @brief Length of an encrypted P25 LDU network frame (RTP and FNE headers with a 225 byte LDU
+ *  message, padded to the AES block length).
+ */
+const uint32_t AES_LDU_FRAME_BYTES = 272U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helper to benchmark AES-ECB over a corpus of network frames, as the network socket
+ *  encrypts them with the preshared key.
+ * @param meter Benchmark chronometer.
+ * @param aes Instance of the AES class.
+ * @param corpus Corpus of frames.
+ * @param key Encryption key.
+ * @param encrypt Flag indicating frames are encrypted (otherwise decrypted).
+ */
+static void measureECB(Catch::Benchmark::Chronometer& meter, AES& aes, const BenchCorpus& corpus, const uint8_t* key,
+    bool encrypt)
+{
+    meter.measure([&](int i) {
+        uint8_t* out = encrypt ? aes.encryptECB(corpus[i], corpus.length(), key) :
+            aes.decryptECB(corpus[i], corpus.length(), key);
+        uint8_t ret = out[0U];
+        delete[] out;
+        return ret;
+    });
+}
+
+TEST_CASE("AESCrypto", "[bench][crypto]") {
+    std::mt19937 rng(0x41455343U);
+
+    uint8_t key[32U];
+    BenchCorpus::random(rng, key, 32U);
+    uint8_t iv[AES::BLOCK_BYTES_LEN];
+    BenchCorpus::random(rng, iv, AES::BLOCK_BYTES_LEN);
+
+    BenchCorpus dmr(AES_DMR_FRAME_BYTES), ldu(AES_LDU_FRAME_BYTES), block(AES::BLOCK_BYTES_LEN);
+    for (uint32_t n = 0U; n < dmr.frames(); n++) {
+        BenchCorpus::random(rng, dmr[n], AES_DMR_FRAME_BYTES);
+        BenchCorpus::random(rng, ldu[n], AES_LDU_FRAME_BYTES);
+        BenchCorpus::random(rng, block[n], AES::BLOCK_BYTES_LEN);
+    }
+
+    AES aes(AESKeyLength::AES_256);
+
+    BENCHMARK_ADVANCED("AES-256 ECB encrypt DMR frame")(Catch::Benchmark::Chronometer meter) {
+        measureECB(meter, aes, dmr, key, true);
+    };
+
+    BENCHMARK_ADVANCED("AES-256 ECB decrypt DMR frame")(Catch::Benchmark::Chronometer meter) {
+        measureECB(meter, aes, dmr, key, false);
+    };
+
+    BENCHMARK_ADVANCED("AES-256 ECB encrypt P25 LDU frame")(Catch::Benchmark::Chronometer meter) {
+        measureECB(meter, aes, ldu, key, true);
+    };
+
+    BENCHMARK_ADVANCED("AES-256 ECB decrypt P25 LDU frame")(Catch::Benchmark::Chronometer meter) {
+        measureECB(meter, aes, ldu, key, false);
+    };
+
+    // a single block, as link layer authentication expands its keys and responses
+    BENCHMARK_ADVANCED("AES-128 ECB encrypt block")(Catch::Benchmark::Chronometer meter) {
+        AES aes128(AESKeyLength::AES_128);
+        measureECB(meter, aes128, block, key, true);
+    };
+
+    BENCHMARK_ADVANCED("AES-256 CFB encrypt P25 LDU frame")(Catch::Benchmark::Chronometer meter) {
+        meter.measure([&](int i) {
+            uint8_t* out = aes.encryptCFB(ldu[i], AES_LDU_FRAME_BYTES, key, iv);
+            uint8_t ret = out[0U];
+            delete[] out;
+            return ret;
+        });
+    };
+}
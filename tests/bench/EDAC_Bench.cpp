@@ -0,0 +1,317 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/edac/AMBEFEC.h"
+#include "common/edac/BPTC19696.h"
+#include "common/edac/Golay24128.h"
+#include "common/edac/RS634717.h"
+#include "common/edac/Trellis.h"
+#include "common/dmr/DMRDefines.h"
+#include "common/p25/P25Defines.h"
+#include "bench/BenchCorpus.h"
+
+using namespace edac;
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t GOLAY_MSG_BYTES = 9U;
+const uint32_t GOLAY_CODED_BYTES = GOLAY_MSG_BYTES * 2U;
+
+const uint32_t TRELLIS_PAYLOAD_BYTES = 18U;
+const uint32_t TRELLIS_CODED_BYTES = 25U;
+
+const uint32_t BPTC_DATA_BYTES = 12U;
+const uint32_t BPTC_BURST_BYTES = 33U;
+
+const uint32_t RS_HDU_BYTES = 27U;
+const uint32_t IMBE_FEC_BYTES = 18U;
+
+TEST_CASE("Golay24128", "[bench][edac]") {
+    std::mt19937 rng(0x474F4C41U);
+
+    BenchCorpus raw(GOLAY_MSG_BYTES), coded(GOLAY_CODED_BYTES);
+    for (uint32_t n = 0U; n < raw.frames(); n++) {
+        BenchCorpus::random(rng, raw[n], GOLAY_MSG_BYTES);
+        Golay24128::encode24128(coded[n], raw[n], GOLAY_MSG_BYTES);
+
+        // a single bit error in each (24,12,8) codeword
+        for (uint32_t i = 0U; i < GOLAY_CODED_BYTES / 3U; i++)
+            BenchCorpus::flipBits(rng, coded[n], i * 24U, 24U, 1U);
+    }
+
+    BENCHMARK_ADVANCED("Golay24128 encode")(Catch::Benchmark::Chronometer meter) {
+        uint8_t data[GOLAY_CODED_BYTES];
+        meter.measure([&](int i) {
+            Golay24128::encode24128(data, raw[i], GOLAY_MSG_BYTES);
+            return data[0U];
+        });
+    };
+
+    BENCHMARK_ADVANCED("Golay24128 decode")(Catch::Benchmark::Chronometer meter) {
+        uint8_t data[GOLAY_MSG_BYTES];
+        meter.measure([&](int i) {
+            Golay24128::decode24128(data, coded[i], GOLAY_MSG_BYTES);
+            return data[0U];
+        });
+    };
+}
+
+TEST_CASE("Trellis", "[bench][edac]") {
+    std::mt19937 rng(0x5452454CU);
+    Trellis trellis;
+
+    BenchCorpus payloads(TRELLIS_PAYLOAD_BYTES), coded34(TRELLIS_CODED_BYTES), coded12(TRELLIS_CODED_BYTES);
+    BenchCorpus clean34(TRELLIS_CODED_BYTES), clean12(TRELLIS_CODED_BYTES), noise(TRELLIS_CODED_BYTES);
+    for (uint32_t n = 0U; n < payloads.frames(); n++) {
+        BenchCorpus::random(rng, payloads[n], TRELLIS_PAYLOAD_BYTES);
+        trellis.encode34(payloads[n], clean34[n]);
+        trellis.encode12(payloads[n], clean12[n]);
+
+        ::memcpy(coded34[n], clean34[n], TRELLIS_CODED_BYTES);
+        ::memcpy(coded12[n], clean12[n], TRELLIS_CODED_BYTES);
+        BenchCorpus::flipBits(rng, coded34[n], 0U, 196U, 2U);
+        BenchCorpus::flipBits(rng, coded12[n], 0U, 196U, 2U);
+
+        // bursts that aren't trellis coded at all (the worst case, every decode fails)
+        BenchCorpus::random(rng, noise[n], TRELLIS_CODED_BYTES);
+    }
+
+    BENCHMARK_ADVANCED("Trellis 3/4 encode")(Catch::Benchmark::Chronometer meter) {
+        uint8_t data[TRELLIS_CODED_BYTES];
+        meter.measure([&](int i) {
+            trellis.encode34(payloads[i], data);
+            return data[0U];
+        });
+    };
+
+    BENCHMARK_ADVANCED("Trellis 3/4 decode clean")(Catch::Benchmark::Chronometer meter) {
+        uint8_t payload[TRELLIS_PAYLOAD_BYTES];
+        meter.measure([&](int i) {
+            return trellis.decode34(clean34[i], payload);
+        });
+    };
+
+    BENCHMARK_ADVANCED("Trellis 3/4 decode")(Catch::Benchmark::Chronometer meter) {
+        uint8_t payload[TRELLIS_PAYLOAD_BYTES];
+        meter.measure([&](int i) {
+            return trellis.decode34(coded34[i], payload);
+        });
+    };
+
+    BENCHMARK_ADVANCED("Trellis 3/4 decode noise")(Catch::Benchmark::Chronometer meter) {
+        uint8_t payload[TRELLIS_PAYLOAD_BYTES];
+        meter.measure([&](int i) {
+            return trellis.decode34(noise[i], payload);
+        });
+    };
+
+    BENCHMARK_ADVANCED("Trellis 1/2 decode clean")(Catch::Benchmark::Chronometer meter) {
+        uint8_t payload[TRELLIS_PAYLOAD_BYTES];
+        meter.measure([&](int i) {
+            return trellis.decode12(clean12[i], payload);
+        });
+    };
+
+    BENCHMARK_ADVANCED("Trellis 1/2 decode")(Catch::Benchmark::Chronometer meter) {
+        uint8_t payload[TRELLIS_PAYLOAD_BYTES];
+        meter.measure([&](int i) {
+            return trellis.decode12(coded12[i], payload);
+        });
+    };
+
+    BENCHMARK_ADVANCED("Trellis 1/2 decode noise")(Catch::Benchmark::Chronometer meter) {
+        uint8_t payload[TRELLIS_PAYLOAD_BYTES];
+        meter.measure([&](int i) {
+            return trellis.decode12(noise[i], payload);
+        });
+    };
+}
+
+TEST_CASE("BPTC19696", "[bench][edac]") {
+    std::mt19937 rng(0x42505443U);
+    BPTC19696 bptc;
+
+    BenchCorpus payloads(BPTC_DATA_BYTES), bursts(BPTC_BURST_BYTES);
+    for (uint32_t n = 0U; n < payloads.frames(); n++) {
+        BenchCorpus::random(rng, payloads[n], BPTC_DATA_BYTES);
+        bptc.encode(payloads[n], bursts[n]);
+
+        // errors land in the first payload half, clear of the sync
+        BenchCorpus::flipBits(rng, bursts[n], 0U, 98U, 2U);
+    }
+
+    BENCHMARK_ADVANCED("BPTC19696 encode")(Catch::Benchmark::Chronometer meter) {
+        uint8_t burst[BPTC_BURST_BYTES];
+        ::memset(burst, 0x00U, BPTC_BURST_BYTES);
+        meter.measure([&](int i) {
+            bptc.encode(payloads[i], burst);
+            return burst[0U];
+        });
+    };
+
+    BENCHMARK_ADVANCED("BPTC19696 decode")(Catch::Benchmark::Chronometer meter) {
+        uint8_t data[BPTC_DATA_BYTES];
+        meter.measure([&](int i) {
+            bptc.decode(bursts[i], data);
+            return data[0U];
+        });
+    };
+}
+
+TEST_CASE("RS634717", "[bench][edac]") {
+    using namespace p25::defines;
+
+    std::mt19937 rng(0x52533633U);
+    RS634717 rs;
+
+    BenchCorpus ldu1(P25_LDU_LC_FEC_LENGTH_BYTES), ldu2(P25_LDU_LC_FEC_LENGTH_BYTES), hdu(RS_HDU_BYTES);
+    BenchCorpus cleanLdu1(P25_LDU_LC_FEC_LENGTH_BYTES), cleanLdu2(P25_LDU_LC_FEC_LENGTH_BYTES), cleanHdu(RS_HDU_BYTES);
+    for (uint32_t n = 0U; n < ldu1.frames(); n++) {
+        BenchCorpus::random(rng, ldu1[n], 9U);
+        rs.encode241213(ldu1[n]);
+        BenchCorpus::random(rng, ldu2[n], 12U);
+        rs.encode24169(ldu2[n]);
+        BenchCorpus::random(rng, hdu[n], 15U);
+        rs.encode362017(hdu[n]);
+
+        ::memcpy(cleanLdu1[n], ldu1[n], P25_LDU_LC_FEC_LENGTH_BYTES);
+        ::memcpy(cleanLdu2[n], ldu2[n], P25_LDU_LC_FEC_LENGTH_BYTES);
+        ::memcpy(cleanHdu[n], hdu[n], RS_HDU_BYTES);
+
+        // a few hexbit errors, well inside what each code corrects
+        BenchCorpus::flipBits(rng, ldu1[n], 0U, 144U, 3U);
+        BenchCorpus::flipBits(rng, ldu2[n], 0U, 144U, 2U);
+        BenchCorpus::flipBits(rng, hdu[n], 0U, 216U, 4U);
+
+        uint8_t data[RS_HDU_BYTES];
+        ::memcpy(data, ldu1[n], P25_LDU_LC_FEC_LENGTH_BYTES);
+        REQUIRE(rs.decode241213(data));
+        ::memcpy(data, ldu2[n], P25_LDU_LC_FEC_LENGTH_BYTES);
+        REQUIRE(rs.decode24169(data));
+        ::memcpy(data, hdu[n], RS_HDU_BYTES);
+        REQUIRE(rs.decode362017(data));
+    }
+
+    BENCHMARK_ADVANCED("RS634717 (24,12,13) encode")(Catch::Benchmark::Chronometer meter) {
+        uint8_t data[P25_LDU_LC_FEC_LENGTH_BYTES];
+        meter.measure([&](int i) {
+            ::memcpy(data, ldu1[i], P25_LDU_LC_FEC_LENGTH_BYTES);
+            rs.encode241213(data);
+            return data[9U];
+        });
+    };
+
+    BENCHMARK_ADVANCED("RS634717 (24,16,9) encode")(Catch::Benchmark::Chronometer meter) {
+        uint8_t data[P25_LDU_LC_FEC_LENGTH_BYTES];
+        meter.measure([&](int i) {
+            ::memcpy(data, cleanLdu2[i], P25_LDU_LC_FEC_LENGTH_BYTES);
+            rs.encode24169(data);
+            return data[12U];
+        });
+    };
+
+    BENCHMARK_ADVANCED("RS634717 (36,20,17) encode")(Catch::Benchmark::Chronometer meter) {
+        uint8_t data[RS_HDU_BYTES];
+        meter.measure([&](int i) {
+            ::memcpy(data, cleanHdu[i], RS_HDU_BYTES);
+            rs.encode362017(data);
+            return data[15U];
+        });
+    };
+
+    // decoding corrects in place, so each frame is decoded from a copy
+    BENCHMARK_ADVANCED("RS634717 (24,12,13) decode clean")(Catch::Benchmark::Chronometer meter) {
+        uint8_t data[P25_LDU_LC_FEC_LENGTH_BYTES];
+        meter.measure([&](int i) {
+            ::memcpy(data, cleanLdu1[i], P25_LDU_LC_FEC_LENGTH_BYTES);
+            return rs.decode241213(data);
+        });
+    };
+
+    BENCHMARK_ADVANCED("RS634717 (24,16,9) decode clean")(Catch::Benchmark::Chronometer meter) {
+        uint8_t data[P25_LDU_LC_FEC_LENGTH_BYTES];
+        meter.measure([&](int i) {
+            ::memcpy(data, cleanLdu2[i], P25_LDU_LC_FEC_LENGTH_BYTES);
+            return rs.decode24169(data);
+        });
+    };
+
+    BENCHMARK_ADVANCED("RS634717 (36,20,17) decode clean")(Catch::Benchmark::Chronometer meter) {
+        uint8_t data[RS_HDU_BYTES];
+        meter.measure([&](int i) {
+            ::memcpy(data, cleanHdu[i], RS_HDU_BYTES);
+            return rs.decode362017(data);
+        });
+    };
+
+    BENCHMARK_ADVANCED("RS634717 (24,12,13) decode")(Catch::Benchmark::Chronometer meter) {
+        uint8_t data[P25_LDU_LC_FEC_LENGTH_BYTES];
+        meter.measure([&](int i) {
+            ::memcpy(data, ldu1[i], P25_LDU_LC_FEC_LENGTH_BYTES);
+            return rs.decode241213(data);
+        });
+    };
+
+    BENCHMARK_ADVANCED("RS634717 (24,16,9) decode")(Catch::Benchmark::Chronometer meter) {
+        uint8_t data[P25_LDU_LC_FEC_LENGTH_BYTES];
+        meter.measure([&](int i) {
+            ::memcpy(data, ldu2[i], P25_LDU_LC_FEC_LENGTH_BYTES);
+            return rs.decode24169(data);
+        });
+    };
+
+    BENCHMARK_ADVANCED("RS634717 (36,20,17) decode")(Catch::Benchmark::Chronometer meter) {
+        uint8_t data[RS_HDU_BYTES];
+        meter.measure([&](int i) {
+            ::memcpy(data, hdu[i], RS_HDU_BYTES);
+            return rs.decode362017(data);
+        });
+    };
+}
+
+TEST_CASE("AMBEFEC", "[bench][edac]") {
+    using namespace dmr::defines;
+
+    std::mt19937 rng(0x414D4245U);
+    AMBEFEC fec;
+
+    // regenerating random bursts yields valid FEC, which the errors are then added to
+    BenchCorpus dmr(DMR_FRAME_LENGTH_BYTES), imbe(IMBE_FEC_BYTES);
+    for (uint32_t n = 0U; n < dmr.frames(); n++) {
+        BenchCorpus::random(rng, dmr[n], DMR_FRAME_LENGTH_BYTES);
+        fec.regenerateDMR(dmr[n]);
+        BenchCorpus::flipBits(rng, dmr[n], 0U, 108U, 2U);
+
+        BenchCorpus::random(rng, imbe[n], IMBE_FEC_BYTES);
+        fec.regenerateIMBE(imbe[n]);
+        BenchCorpus::flipBits(rng, imbe[n], 0U, 144U, 2U);
+    }
+
+    BENCHMARK_ADVANCED("AMBEFEC DMR regenerate")(Catch::Benchmark::Chronometer meter) {
+        uint8_t data[DMR_FRAME_LENGTH_BYTES];
+        meter.measure([&](int i) {
+            ::memcpy(data, dmr[i], DMR_FRAME_LENGTH_BYTES);
+            return fec.regenerateDMR(data);
+        });
+    };
+
+    BENCHMARK_ADVANCED("AMBEFEC P25 IMBE regenerate")(Catch::Benchmark::Chronometer meter) {
+        uint8_t data[IMBE_FEC_BYTES];
+        meter.measure([&](int i) {
+            ::memcpy(data, imbe[i], IMBE_FEC_BYTES);
+            return fec.regenerateIMBE(data);
+        });
+    };
+}
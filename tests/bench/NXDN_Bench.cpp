@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/nxdn/edac/Convolution.h"
+#include "bench/BenchCorpus.h"
+
+using namespace nxdn::edac;
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+// long inbound CAC, the longest block decoded for every frame on a control channel
+const uint32_t CONV_BENCH_BITS = 160U;
+const uint32_t CONV_BENCH_BYTES = CONV_BENCH_BITS / 8U + 1U;
+const uint32_t CONV_BENCH_SYMBOLS = (CONV_BENCH_BITS + 4U) * 2U;
+
+TEST_CASE("NXDN Convolution", "[bench][nxdn]") {
+    std::mt19937 rng(0x4E58444EU);
+
+    // soft symbols (0 or 2) of random payloads, with a few bit errors and erasures each
+    BenchCorpus symbols(CONV_BENCH_SYMBOLS);
+    for (uint32_t n = 0U; n < symbols.frames(); n++) {
+        uint8_t payload[CONV_BENCH_BYTES];
+        ::memset(payload, 0x00U, CONV_BENCH_BYTES);
+        for (uint32_t i = 0U; i < CONV_BENCH_BITS - 4U; i++)
+            WRITE_BIT(payload, i, (rng() & 1U) != 0U);
+
+        uint8_t coded[(CONV_BENCH_BITS * 2U) / 8U + 1U];
+        ::memset(coded, 0x00U, sizeof(coded));
+
+        Convolution conv;
+        conv.encode(payload, coded, CONV_BENCH_BITS);
+
+        for (uint32_t i = 0U; i < CONV_BENCH_BITS * 2U; i++)
+            symbols[n][i] = READ_BIT(coded, i) ? 2U : 0U;
+        for (uint32_t i = 0U; i < 8U; i++)
+            symbols[n][rng() % (CONV_BENCH_BITS * 2U)] = (uint8_t)(rng() % 3U);
+    }
+
+    BENCHMARK_ADVANCED("NXDN Convolution symbol pair decode")(Catch::Benchmark::Chronometer meter) {
+        uint8_t out[CONV_BENCH_BYTES];
+        meter.measure([&](int i) {
+            const uint8_t* s = symbols[i];
+
+            Convolution conv;
+            conv.start();
+            for (uint32_t j = 0U; j < CONV_BENCH_BITS + 4U; j++)
+                conv.decode(s[j * 2U], s[j * 2U + 1U]);
+
+            return conv.chainback(out, CONV_BENCH_BITS);
+        });
+    };
+
+    BENCHMARK_ADVANCED("NXDN Convolution block decode")(Catch::Benchmark::Chronometer meter) {
+        uint8_t out[CONV_BENCH_BYTES];
+        meter.measure([&](int i) {
+            Convolution conv;
+            return conv.decode(symbols[i], out, CONV_BENCH_BITS);
+        });
+    };
+}
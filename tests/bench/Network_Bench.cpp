@@ -0,0 +1,476 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/json/json.h"
+#include "common/network/rest/http/HTTPServer.h"
+#include "common/network/rest/RequestDispatcher.h"
+#include "common/network/udp/Socket.h"
+#include "common/network/viface/VIFace.h"
+#include "host/network/RESTDefines.h"
+#include "bridge/PCMConvert.h"
+#include "remote/RESTClient.h"
+#include "bench/BenchCorpus.h"
+
+using namespace network;
+using namespace network::rest;
+using namespace network::rest::http;
+using namespace network::udp;
+using namespace network::viface;
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#if !defined(_WIN32)
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/ip.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t PCM_BENCH_SAMPLES = 160U;
+const uint32_t PCM_BENCH_DATAGRAM_LENGTH = (PCM_BENCH_SAMPLES * 2U) + 12U;
+const uint32_t PCM_BENCH_LDU_FRAMES = 9U;
+
+const char* REST_BENCH_PASSWORD = "PASSWORD";
+
+const uint32_t TUN_BENCH_MTU = 496U;
+const uint32_t TUN_BENCH_PAYLOAD_LEN = 64U;
+const uint32_t TUN_BENCH_READ_BATCH = 32U;
+const uint16_t TUN_BENCH_PORT = 47777U;
+
+const char* TUN_BENCH_ADDR = "10.254.77.1";
+const char* TUN_BENCH_PEER_ADDR = "10.254.77.2";
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements a minimal REST API endpoint (authentication and status) on the loopback address.
+ */
+class BenchRESTServer {
+public:
+    typedef RequestDispatcher<HTTPPayload, HTTPPayload> DispatcherType;
+
+    /**
+     * @brief Initializes a new instance of the BenchRESTServer class.
+     * @param port Port to listen on.
+     */
+    BenchRESTServer(uint16_t port) :
+        m_dispatcher(false),
+        m_server("127.0.0.1", port, false)
+    {
+        m_dispatcher.match(PUT_AUTHENTICATE).put([](const HTTPPayload& request, HTTPPayload& reply, const RequestMatch&) {
+            json::object response = json::object();
+            int status = HTTPPayload::OK;
+            response["status"].set<int>(status);
+            std::string token = "1";
+            response["token"].set<std::string>(token);
+            reply.payload(response);
+        });
+
+        m_dispatcher.match(GET_STATUS).get([](const HTTPPayload& request, HTTPPayload& reply, const RequestMatch&) {
+            json::object response = json::object();
+            int status = HTTPPayload::OK;
+            response["status"].set<int>(status);
+            reply.payload(response);
+        });
+
+        m_server.setHandler(m_dispatcher);
+        m_server.open();
+        m_thread = std::thread([this]() { m_server.run(); });
+    }
+    /**
+     * @brief Finalizes a instance of the BenchRESTServer class.
+     */
+    ~BenchRESTServer()
+    {
+        m_server.stop();
+        m_thread.join();
+    }
+
+private:
+    DispatcherType m_dispatcher;
+    HTTPServer<DispatcherType> m_server;
+    std::thread m_thread;
+};
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helper to find a free port on the loopback address.
+ * @param type Socket type (SOCK_DGRAM or SOCK_STREAM).
+ * @returns uint16_t Free port, or zero if none could be bound.
+ */
+static uint16_t freePort(int type)
+{
+    int fd = ::socket(AF_INET, type, 0);
+    if (fd < 0)
+        return 0U;
+
+    struct sockaddr_in addr;
+    ::memset(&addr, 0x00U, sizeof(struct sockaddr_in));
+    addr.sin_family = AF_INET;
+    addr.sin_port = 0U;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    socklen_t addrLen = sizeof(struct sockaddr_in);
+    uint16_t port = 0U;
+    if (::bind(fd, (struct sockaddr*)&addr, addrLen) == 0 && ::getsockname(fd, (struct sockaddr*)&addr, &addrLen) == 0)
+        port = ntohs(addr.sin_port);
+
+    ::close(fd);
+    return port;
+}
+
+/**
+ * @brief Helper to calculate the IPv4 header checksum.
+ * @param data IPv4 header.
+ * @param len Length of IPv4 header.
+ * @returns uint16_t IPv4 header checksum.
+ */
+static uint16_t ipChecksum(const uint8_t* data, uint32_t len)
+{
+    uint32_t sum = 0U;
+    for (uint32_t i = 0U; i < len; i += 2U) {
+        sum += (data[i] << 8) | data[i + 1U];
+    }
+
+    while (sum >> 16)
+        sum = (sum & 0xFFFFU) + (sum >> 16);
+
+    return (uint16_t)~sum;
+}
+
+/**
+ * @brief Helper to build an IPv4/UDP packet from the peer address to the TUN address.
+ * @param[out] packet Buffer to build the packet in.
+ * @param seq Sequence number written into the payload.
+ * @returns uint32_t Length of the packet.
+ */
+static uint32_t buildPacket(uint8_t* packet, uint32_t seq)
+{
+    uint32_t len = sizeof(struct ip) + sizeof(struct udphdr) + TUN_BENCH_PAYLOAD_LEN;
+    ::memset(packet, 0x00U, len);
+
+    struct ip* ipHeader = (struct ip*)packet;
+    ipHeader->ip_v = 4U;
+    ipHeader->ip_hl = 5U;
+    ipHeader->ip_len = htons(len);
+    ipHeader->ip_ttl = 64U;
+    ipHeader->ip_p = IPPROTO_UDP;
+    ::inet_pton(AF_INET, TUN_BENCH_PEER_ADDR, &ipHeader->ip_src);
+    ::inet_pton(AF_INET, TUN_BENCH_ADDR, &ipHeader->ip_dst);
+    ipHeader->ip_sum = htons(ipChecksum(packet, sizeof(struct ip)));
+
+    // UDP checksum is optional for IPv4 and is left zero
+    struct udphdr* udpHeader = (struct udphdr*)(packet + sizeof(struct ip));
+    udpHeader->uh_sport = htons(TUN_BENCH_PORT);
+    udpHeader->uh_dport = htons(TUN_BENCH_PORT);
+    udpHeader->uh_ulen = htons(sizeof(struct udphdr) + TUN_BENCH_PAYLOAD_LEN);
+
+    __SET_UINT32(seq, packet, sizeof(struct ip) + sizeof(struct udphdr));
+    return len;
+}
+
+/**
+ * @brief Helper to create and bring up the benchmark TUN device.
+ * @returns VIFace* Instance of the VIFace class, or nullptr if the TUN device could not be created.
+ */
+static VIFace* createTun()
+{
+    try {
+        VIFace* tun = new VIFace("dvmbench%d", false);
+        tun->setIPv4(TUN_BENCH_ADDR);
+        tun->setIPv4Netmask("255.255.255.0");
+        tun->setIPv4Broadcast("10.254.77.255");
+        tun->setMTU(TUN_BENCH_MTU);
+        tun->up();
+        return tun;
+    }
+    catch (std::exception& e) {
+        return nullptr;
+    }
+}
+
+/**
+ * @brief Helper to send UDP datagrams to the peer address (routed into the TUN device), until stopped.
+ * @param done Flag set when the benchmarks have finished.
+ */
+static void sendDatagrams(std::atomic<bool>& done)
+{
+    int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0)
+        return;
+
+    sockaddr_in addr;
+    ::memset(&addr, 0x00U, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(TUN_BENCH_PORT);
+    ::inet_pton(AF_INET, TUN_BENCH_PEER_ADDR, &addr.sin_addr);
+
+    uint8_t payload[TUN_BENCH_PAYLOAD_LEN];
+    ::memset(payload, 0xA5U, TUN_BENCH_PAYLOAD_LEN);
+
+    for (uint32_t i = 0U; !done; i++) {
+        __SET_UINT32(i, payload, 0U);
+        while (::sendto(fd, payload, TUN_BENCH_PAYLOAD_LEN, 0, (sockaddr*)&addr, sizeof(addr)) < 0 && !done) {
+            // the TUN transmit queue is full, let the reader catch up
+            std::this_thread::yield();
+        }
+    }
+
+    ::close(fd);
+}
+
+TEST_CASE("UDP Audio", "[bench][network]") {
+    uint16_t port = freePort(SOCK_DGRAM);
+    REQUIRE(port != 0U);
+
+    Socket rx("127.0.0.1", port);
+    REQUIRE(rx.open());
+    Socket tx(0U);
+    REQUIRE(tx.open(AF_INET));
+
+    sockaddr_storage addr;
+    uint32_t addrLen = 0U;
+    REQUIRE(Socket::lookup("127.0.0.1", port, addr, addrLen) == 0);
+
+    // UDP audio datagrams (4 bytes PCM length, PCM, dstId, srcId)
+    std::mt19937 rng(0x55445041U);
+    BenchCorpus datagrams(PCM_BENCH_DATAGRAM_LENGTH);
+    for (uint32_t n = 0U; n < datagrams.frames(); n++) {
+        __SET_UINT32(PCM_BENCH_SAMPLES * 2U, datagrams[n], 0U);
+        BenchCorpus::random(rng, datagrams[n] + 4U, PCM_BENCH_SAMPLES * 2U);
+        __SET_UINT32(9999U, datagrams[n], (PCM_BENCH_SAMPLES * 2U) + 4U);
+        __SET_UINT32(n, datagrams[n], (PCM_BENCH_SAMPLES * 2U) + 8U);
+    }
+
+    uint8_t buffers[PCM_BENCH_LDU_FRAMES][512U];
+    short samples[PCM_BENCH_SAMPLES];
+
+    // per datagram lookup, write, read, with per sample conversion and gain
+    BENCHMARK_ADVANCED("UDP audio LDU loopback, per datagram")(Catch::Benchmark::Chronometer meter) {
+        meter.measure([&](int i) {
+            for (uint32_t n = 0U; n < PCM_BENCH_LDU_FRAMES; n++) {
+                sockaddr_storage sendAddr;
+                uint32_t sendAddrLen = 0U;
+                if (Socket::lookup("127.0.0.1", port, sendAddr, sendAddrLen) == 0)
+                    tx.write(datagrams[(i * PCM_BENCH_LDU_FRAMES) + n], PCM_BENCH_DATAGRAM_LENGTH, sendAddr, sendAddrLen);
+            }
+
+            short check = 0;
+            for (uint32_t n = 0U; n < PCM_BENCH_LDU_FRAMES; n++) {
+                sockaddr_storage recvAddr;
+                uint32_t recvAddrLen = 0U;
+                if (rx.read(buffers[n], 512U, recvAddr, recvAddrLen) <= 0)
+                    continue;
+
+                const uint8_t* pcm = buffers[n] + 4U;
+                for (uint32_t s = 0U; s < PCM_BENCH_SAMPLES; s++) {
+                    float sample = (short)((pcm[(s * 2U) + 1U] << 8) + pcm[s * 2U]) * 1.5f;
+                    if (sample > 32767)
+                        sample = 32767;
+                    else if (sample < -32767)
+                        sample = -32767;
+                    samples[s] = (short)sample;
+                }
+
+                check += samples[n];
+            }
+
+            return check;
+        });
+    };
+
+    // batched sendmmsg/recvmmsg, with block conversion and gain
+    BENCHMARK_ADVANCED("UDP audio LDU loopback, batched")(Catch::Benchmark::Chronometer meter) {
+        meter.measure([&](int i) {
+            UDPDatagram out[PCM_BENCH_LDU_FRAMES];
+            BufferVector vector;
+            for (uint32_t n = 0U; n < PCM_BENCH_LDU_FRAMES; n++) {
+                out[n].buffer = datagrams[(i * PCM_BENCH_LDU_FRAMES) + n];
+                out[n].length = PCM_BENCH_DATAGRAM_LENGTH;
+                out[n].address = addr;
+                out[n].addrLen = addrLen;
+                vector.push_back(&out[n]);
+            }
+
+            tx.write(vector);
+
+            UDPDatagram in[PCM_BENCH_LDU_FRAMES];
+            uint32_t received = 0U;
+            while (received < PCM_BENCH_LDU_FRAMES) {
+                for (uint32_t n = received; n < PCM_BENCH_LDU_FRAMES; n++) {
+                    in[n].buffer = buffers[n];
+                    in[n].length = 512U;
+                }
+
+                int read = rx.read(in + received, PCM_BENCH_LDU_FRAMES - received);
+                if (read <= 0)
+                    break;
+                received += read;
+            }
+
+            short check = 0;
+            for (uint32_t n = 0U; n < received; n++) {
+                PCMConvert::toSamples(buffers[n] + 4U, samples, PCM_BENCH_SAMPLES);
+                PCMConvert::applyGain(samples, PCM_BENCH_SAMPLES, 1.5f);
+                check += samples[n];
+            }
+
+            return check;
+        });
+    };
+
+    rx.close();
+    tx.close();
+}
+
+TEST_CASE("RESTClient", "[bench][network]") {
+    uint16_t port = freePort(SOCK_STREAM);
+    REQUIRE(port != 0U);
+
+    BenchRESTServer server(port);
+
+    // the first request authenticates, later requests reuse the pooled connection and token
+    json::object rsp = json::object();
+    REQUIRE(RESTClient::send("127.0.0.1", port, REST_BENCH_PASSWORD, HTTP_GET, GET_STATUS, json::object(), rsp, false, REST_DEFAULT_WAIT) == HTTPPayload::OK);
+
+    BENCHMARK_ADVANCED("RESTClient status request")(Catch::Benchmark::Chronometer meter) {
+        meter.measure([&]() {
+            return RESTClient::send("127.0.0.1", port, REST_BENCH_PASSWORD, HTTP_GET, GET_STATUS, json::object(), rsp, false, REST_DEFAULT_WAIT);
+        });
+    };
+
+    RESTClient::closeConnections();
+}
+
+TEST_CASE("VTUN", "[bench][network]") {
+    VIFace* tun = createTun();
+    if (tun == nullptr) {
+        WARN("Unable to create a TUN device (requires CAP_NET_ADMIN), skipping VTUN benchmarks");
+        return;
+    }
+
+    // let the kernel finish configuring the interface (and drain any router solicitations)
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+
+    uint8_t* packets = new uint8_t[TUN_BENCH_READ_BATCH * TUN_BENCH_MTU];
+    ssize_t lengths[TUN_BENCH_READ_BATCH];
+    while (tun->read(packets, TUN_BENCH_MTU, lengths, TUN_BENCH_READ_BATCH, 0) > 0)
+        ;
+
+    // each read iteration takes a batch worth of packets, sent into the device by another thread;
+    // an iteration gives up if the batch hasn't arrived within a second
+    {
+        std::atomic<bool> done(false);
+        std::thread sender(sendDatagrams, std::ref(done));
+
+        BENCHMARK_ADVANCED("VTUN read, single packet")(Catch::Benchmark::Chronometer meter) {
+            meter.measure([&]() {
+                uint32_t read = 0U;
+                auto start = std::chrono::steady_clock::now();
+                while (read < TUN_BENCH_READ_BATCH) {
+                    if (tun->read(packets) > 0) {
+                        read++;
+                        continue;
+                    }
+
+                    auto now = std::chrono::steady_clock::now();
+                    if (std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() > 1000)
+                        break;
+                }
+
+                return read;
+            });
+        };
+
+        BENCHMARK_ADVANCED("VTUN read, batched")(Catch::Benchmark::Chronometer meter) {
+            meter.measure([&]() {
+                uint32_t read = 0U;
+                auto start = std::chrono::steady_clock::now();
+                while (read < TUN_BENCH_READ_BATCH) {
+                    int n = tun->read(packets, TUN_BENCH_MTU, lengths, TUN_BENCH_READ_BATCH - read, 10);
+                    if (n > 0) {
+                        read += n;
+                        continue;
+                    }
+
+                    auto now = std::chrono::steady_clock::now();
+                    if (std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() > 1000)
+                        break;
+                }
+
+                return read;
+            });
+        };
+
+        done = true;
+        sender.join();
+    }
+
+    // written packets are routed to a local socket, which is drained by another thread
+    {
+        int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+        REQUIRE(fd >= 0);
+
+        int rcvBuf = 4 * 1024 * 1024;
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvBuf, sizeof(rcvBuf));
+
+        timeval tv = { 0, 100000 };
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+        sockaddr_in addr;
+        ::memset(&addr, 0x00U, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(TUN_BENCH_PORT);
+        ::inet_pton(AF_INET, TUN_BENCH_ADDR, &addr.sin_addr);
+        REQUIRE(::bind(fd, (sockaddr*)&addr, sizeof(addr)) == 0);
+
+        std::atomic<bool> done(false);
+        std::thread receiver([&]() {
+            uint8_t buffer[TUN_BENCH_MTU];
+            while (!done)
+                ::recv(fd, buffer, TUN_BENCH_MTU, 0);
+        });
+
+        BenchCorpus corpus(TUN_BENCH_MTU);
+        uint32_t len = 0U;
+        for (uint32_t n = 0U; n < corpus.frames(); n++)
+            len = buildPacket(corpus[n], n);
+
+        BENCHMARK_ADVANCED("VTUN write")(Catch::Benchmark::Chronometer meter) {
+            meter.measure([&](int i) {
+                return tun->write(corpus[i], len);
+            });
+        };
+
+        done = true;
+        receiver.join();
+        ::close(fd);
+    }
+
+    delete[] packets;
+    tun->down();
+    delete tun;
+}
+#endif // !defined(_WIN32)
@@ -0,0 +1,232 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/p25/P25Defines.h"
+#include "common/p25/P25Utils.h"
+#include "common/p25/lc/LC.h"
+#include "common/p25/lc/tsbk/TSBKFactory.h"
+#include "common/p25/Sync.h"
+#include "bench/BenchCorpus.h"
+
+using namespace p25;
+using namespace p25::defines;
+using namespace p25::lc;
+using namespace p25::lc::tsbk;
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint8_t LC_BENCH_ALGO_AES_256 = 0x84U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helper to generate the link control of a voice call, from a corpus of group and private
+ *  calls, a quarter of them encrypted.
+ * @param rng Random number generator.
+ * @returns LC Link control.
+ */
+static LC voiceLC(std::mt19937& rng)
+{
+    LC lc;
+    bool group = (rng() % 4U) != 0U;
+    lc.setLCO(group ? LCO::GROUP : LCO::PRIVATE);
+    lc.setGroup(group);
+    lc.setSrcId(1U + (rng() % 0xFFFFFEU));
+    lc.setDstId(group ? 1U + (rng() % 0xFFFEU) : 1U + (rng() % 0xFFFFFEU));
+    lc.setEmergency((rng() % 32U) == 0U);
+
+    uint8_t mi[MI_LENGTH_BYTES];
+    ::memset(mi, 0x00U, MI_LENGTH_BYTES);
+    if ((rng() % 4U) == 0U) {
+        lc.setEncrypted(true);
+        lc.setAlgId(LC_BENCH_ALGO_AES_256);
+        lc.setKId(1U + (rng() % 0xFFFEU));
+        BenchCorpus::random(rng, mi, MI_LENGTH_BYTES);
+    }
+    else {
+        lc.setAlgId(ALGO_UNENCRYPT);
+        lc.setKId(0U);
+    }
+    lc.setMI(mi);
+
+    return lc;
+}
+
+TEST_CASE("LC", "[bench][p25]") {
+    std::mt19937 rng(0x50323543U);
+
+    std::vector<LC> lcs;
+    BenchCorpus hdu(P25_HDU_FRAME_LENGTH_BYTES), ldu1(P25_LDU_FRAME_LENGTH_BYTES), ldu2(P25_LDU_FRAME_LENGTH_BYTES);
+    for (uint32_t n = 0U; n < hdu.frames(); n++) {
+        LC lc = voiceLC(rng);
+        lcs.push_back(lc);
+
+        Sync::addP25Sync(hdu[n]);
+        lc.encodeHDU(hdu[n]);
+        Sync::addP25Sync(ldu1[n]);
+        lc.encodeLDU1(ldu1[n]);
+        Sync::addP25Sync(ldu2[n]);
+        lc.encodeLDU2(ldu2[n]);
+    }
+
+    // the corpus must decode, or the benchmarks would only time the failure paths
+    for (uint32_t n = 0U; n < hdu.frames(); n++) {
+        LC lc;
+        REQUIRE(lc.decodeHDU(hdu[n]));
+        REQUIRE(lc.decodeLDU1(ldu1[n]));
+        REQUIRE(lc.decodeLDU2(ldu2[n]));
+        REQUIRE(lc.getDstId() == lcs[n].getDstId());
+    }
+
+    BENCHMARK_ADVANCED("LC encode HDU")(Catch::Benchmark::Chronometer meter) {
+        uint8_t data[P25_HDU_FRAME_LENGTH_BYTES];
+        ::memset(data, 0x00U, P25_HDU_FRAME_LENGTH_BYTES);
+        meter.measure([&](int i) {
+            lcs[i % lcs.size()].encodeHDU(data);
+            return data[P25_PREAMBLE_LENGTH_BYTES];
+        });
+    };
+
+    BENCHMARK_ADVANCED("LC decode HDU")(Catch::Benchmark::Chronometer meter) {
+        LC lc;
+        meter.measure([&](int i) {
+            return lc.decodeHDU(hdu[i]);
+        });
+    };
+
+    BENCHMARK_ADVANCED("LC encode LDU1")(Catch::Benchmark::Chronometer meter) {
+        uint8_t data[P25_LDU_FRAME_LENGTH_BYTES];
+        ::memset(data, 0x00U, P25_LDU_FRAME_LENGTH_BYTES);
+        meter.measure([&](int i) {
+            lcs[i % lcs.size()].encodeLDU1(data);
+            return data[P25_PREAMBLE_LENGTH_BYTES];
+        });
+    };
+
+    BENCHMARK_ADVANCED("LC decode LDU1")(Catch::Benchmark::Chronometer meter) {
+        LC lc;
+        meter.measure([&](int i) {
+            return lc.decodeLDU1(ldu1[i]);
+        });
+    };
+
+    BENCHMARK_ADVANCED("LC encode LDU2")(Catch::Benchmark::Chronometer meter) {
+        uint8_t data[P25_LDU_FRAME_LENGTH_BYTES];
+        ::memset(data, 0x00U, P25_LDU_FRAME_LENGTH_BYTES);
+        meter.measure([&](int i) {
+            lcs[i % lcs.size()].encodeLDU2(data);
+            return data[P25_PREAMBLE_LENGTH_BYTES];
+        });
+    };
+
+    BENCHMARK_ADVANCED("LC decode LDU2")(Catch::Benchmark::Chronometer meter) {
+        LC lc;
+        meter.measure([&](int i) {
+            return lc.decodeLDU2(ldu2[i]);
+        });
+    };
+}
+
+TEST_CASE("TSBKFactory", "[bench][p25]") {
+    std::mt19937 rng(0x5453424BU);
+
+    // a control channel mix of grants, registrations and affiliations
+    BenchCorpus tsdu(P25_TSDU_FRAME_LENGTH_BYTES);
+    for (uint32_t n = 0U; n < tsdu.frames(); n++) {
+        std::unique_ptr<TSBK> tsbk;
+        switch (n % 4U) {
+        case 0U:
+            tsbk = std::unique_ptr<TSBK>(new IOSP_GRP_VCH());
+            tsbk->setGrpVchNo(rng() % 0xFFFU);
+            break;
+        case 1U:
+            tsbk = std::unique_ptr<TSBK>(new IOSP_U_REG());
+            break;
+        case 2U:
+            tsbk = std::unique_ptr<TSBK>(new IOSP_GRP_AFF());
+            break;
+        default:
+            tsbk = std::unique_ptr<TSBK>(new IOSP_UU_VCH());
+            tsbk->setGrpVchNo(rng() % 0xFFFU);
+            break;
+        }
+
+        tsbk->setSrcId(1U + (rng() % 0xFFFFFEU));
+        tsbk->setDstId(1U + (rng() % 0xFFFEU));
+
+        Sync::addP25Sync(tsdu[n]);
+        tsbk->setLastBlock(true);
+        tsbk->encode(tsdu[n]);
+
+        TSBKStorage storage;
+        REQUIRE(TSBKFactory::decodeTSBK(tsdu[n], storage) != nullptr);
+    }
+
+    BENCHMARK_ADVANCED("TSBKFactory createTSBK")(Catch::Benchmark::Chronometer meter) {
+        meter.measure([&](int i) {
+            std::unique_ptr<TSBK> tsbk = TSBKFactory::createTSBK(tsdu[i]);
+            return tsbk->getDstId();
+        });
+    };
+
+    BENCHMARK_ADVANCED("TSBKFactory decodeTSBK")(Catch::Benchmark::Chronometer meter) {
+        TSBKStorage storage;
+        meter.measure([&](int i) {
+            TSBK* tsbk = TSBKFactory::decodeTSBK(tsdu[i], storage);
+            return tsbk->getDstId();
+        });
+    };
+}
+
+TEST_CASE("P25Utils", "[bench][p25]") {
+    std::mt19937 rng(0x50323555U);
+
+    // frame types, and the bit range their payload is (de)interleaved over
+    struct FrameType {
+        const char* name;
+        uint32_t stop;
+    };
+    const FrameType types[] = {
+        { "HDU", P25_HDU_FRAME_LENGTH_BITS },
+        { "LDU", P25_LDU_FRAME_LENGTH_BITS },
+        { "TSDU", P25_TSDU_FRAME_LENGTH_BITS },
+        { "TDULC", P25_TDULC_FRAME_LENGTH_BITS },
+        { "PDU", P25_PDU_FRAME_LENGTH_BITS }
+    };
+    const uint32_t start = P25_SYNC_LENGTH_BITS + P25_NID_LENGTH_BITS;
+
+    BenchCorpus frames(P25_PDU_FRAME_LENGTH_BYTES);
+    for (uint32_t n = 0U; n < frames.frames(); n++)
+        BenchCorpus::random(rng, frames[n], P25_PDU_FRAME_LENGTH_BYTES);
+
+    for (const FrameType& type : types) {
+        BENCHMARK_ADVANCED(std::string("P25Utils decode ") + type.name)(Catch::Benchmark::Chronometer meter) {
+            uint8_t data[P25_PDU_FRAME_LENGTH_BYTES];
+            meter.measure([&](int i) {
+                return P25Utils::decode(frames[i], data, start, type.stop);
+            });
+        };
+
+        BENCHMARK_ADVANCED(std::string("P25Utils encode ") + type.name)(Catch::Benchmark::Chronometer meter) {
+            uint8_t frame[P25_PDU_FRAME_LENGTH_BYTES];
+            ::memset(frame, 0x00U, P25_PDU_FRAME_LENGTH_BYTES);
+            meter.measure([&](int i) {
+                return P25Utils::encode(frames[i], frame, start, type.stop);
+            });
+        };
+    }
+}
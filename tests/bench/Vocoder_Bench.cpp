@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/Thread.h"
+#include "vocoder/MBEEncoder.h"
+#include "vocoder/MBETranscoder.h"
+#include "vocoder/VocoderPool.h"
+#include "bench/BenchCorpus.h"
+
+using namespace vocoder;
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <cmath>
+#include <string>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const double VOCODER_BENCH_PI = 3.14159265358979323846;
+
+const uint32_t AMBE_BENCH_BYTES = 9U;
+const uint32_t IMBE_BENCH_BYTES = 11U;
+
+const uint32_t POOL_BENCH_STREAMS = 16U;
+const uint32_t POOL_BENCH_DEPTH = 16U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helper to encode a voiced sound, with a gliding pitch, into a corpus of MBE codewords.
+ * @param mode Encoder mode.
+ * @param[out] corpus Corpus of codewords.
+ */
+static void encodeVoiced(MBE_ENCODER_MODE mode, BenchCorpus& corpus)
+{
+    MBEEncoder encoder(mode);
+
+    double phase = 0.0;
+    for (uint32_t n = 0U; n < corpus.frames(); n++) {
+        int16_t samples[VOCODER_SAMPLES_LENGTH];
+        for (uint32_t i = 0U; i < VOCODER_SAMPLES_LENGTH; i++) {
+            uint32_t t = (n * VOCODER_SAMPLES_LENGTH) + i;
+            double f0 = 120.0 + 40.0 * ::sin(2.0 * VOCODER_BENCH_PI * 0.5 * t / 8000.0);
+            phase += 2.0 * VOCODER_BENCH_PI * f0 / 8000.0;
+
+            double sample = 0.0;
+            for (uint32_t k = 1U; k * f0 < 3600.0; k++)
+                sample += ::sin(k * phase) / k;
+
+            samples[i] = (int16_t)::lrint(4000.0 * sample);
+        }
+
+        encoder.encode(samples, corpus[n]);
+    }
+}
+
+/**
+ * @brief Helper to wait for the next processed frame of a stream.
+ * @param pool Instance of the VocoderPool class.
+ * @param stream Stream handle.
+ * @returns VocoderFrame* Processed frame, or nullptr if none arrived within a second.
+ */
+static VocoderFrame* waitFront(VocoderPool& pool, int32_t stream)
+{
+    for (uint32_t i = 0U; i < 10000U; i++) {
+        VocoderFrame* frame = pool.front(stream);
+        if (frame != nullptr)
+            return frame;
+
+        Thread::sleep(0U, 100U);
+    }
+
+    return nullptr;
+}
+
+TEST_CASE("MBETranscoder", "[bench][vocoder]") {
+    BenchCorpus ambe(AMBE_BENCH_BYTES), imbe(IMBE_BENCH_BYTES);
+    encodeVoiced(ENCODE_DMR_AMBE, ambe);
+    encodeVoiced(ENCODE_88BIT_IMBE, imbe);
+
+    const MBE_TRANSCODE_MODE modes[] = { TRANSCODE_PARAMETRIC, TRANSCODE_PCM };
+    for (MBE_TRANSCODE_MODE mode : modes) {
+        std::string name = (mode == TRANSCODE_PARAMETRIC) ? "parametric" : "PCM";
+
+        BENCHMARK_ADVANCED(("MBETranscoder DMR -> P25 " + name).c_str())(Catch::Benchmark::Chronometer meter) {
+            MBETranscoder transcoder(DECODE_DMR_AMBE, ENCODE_88BIT_IMBE, mode);
+            uint8_t output[IMBE_BENCH_BYTES];
+            meter.measure([&](int i) {
+                transcoder.transcode(ambe[i], output);
+                return output[0U];
+            });
+        };
+
+        BENCHMARK_ADVANCED(("MBETranscoder P25 -> DMR " + name).c_str())(Catch::Benchmark::Chronometer meter) {
+            MBETranscoder transcoder(DECODE_88BIT_IMBE, ENCODE_DMR_AMBE, mode);
+            uint8_t output[IMBE_BENCH_BYTES];
+            meter.measure([&](int i) {
+                transcoder.transcode(imbe[i], output);
+                return output[0U];
+            });
+        };
+    }
+}
+
+TEST_CASE("VocoderPool", "[bench][vocoder]") {
+    BenchCorpus imbe(IMBE_BENCH_BYTES);
+    encodeVoiced(ENCODE_88BIT_IMBE, imbe);
+
+    const uint32_t workers[] = { 1U, 2U, 4U };
+    for (uint32_t count : workers) {
+        VocoderPool pool(count, POOL_BENCH_STREAMS, POOL_BENCH_DEPTH);
+        REQUIRE(pool.start());
+
+        int32_t streams[POOL_BENCH_STREAMS];
+        for (uint32_t s = 0U; s < POOL_BENCH_STREAMS; s++) {
+            streams[s] = pool.open(DECODE_88BIT_IMBE, ENCODE_88BIT_IMBE);
+            REQUIRE(streams[s] >= 0);
+        }
+
+        // every stream receives a LDU at a time, as a FNE transcoding many calls would
+        std::string name = "VocoderPool LDU decode, " + std::to_string(count) + " workers, " +
+            std::to_string(POOL_BENCH_STREAMS) + " streams";
+        BENCHMARK_ADVANCED(name.c_str())(Catch::Benchmark::Chronometer meter) {
+            meter.measure([&](int i) {
+                for (uint32_t s = 0U; s < POOL_BENCH_STREAMS; s++) {
+                    for (uint32_t n = 0U; n < 9U; n++) {
+                        VocoderFrame* frame = pool.reserve(streams[s], n);
+                        frame->op = VOCODER_DECODE;
+                        frame->tag = n;
+                        ::memcpy(frame->codeword, imbe[(i * 9U) + n], IMBE_BENCH_BYTES);
+                    }
+
+                    pool.submit(streams[s], 9U);
+                }
+
+                int16_t check = 0;
+                for (uint32_t s = 0U; s < POOL_BENCH_STREAMS; s++) {
+                    for (uint32_t n = 0U; n < 9U; n++) {
+                        VocoderFrame* frame = waitFront(pool, streams[s]);
+                        if (frame == nullptr)
+                            return check;
+
+                        check += frame->samples[n];
+                        pool.pop(streams[s]);
+                    }
+                }
+
+                return check;
+            });
+        };
+
+        pool.stop();
+    }
+}
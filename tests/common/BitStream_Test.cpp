@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/BitStream.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t BITSTREAM_TEST_BYTES = 64U;
+const uint32_t BITSTREAM_MAX_LENGTH = 256U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Reference bit at a time copy.
+ * @param[in] in Input buffer.
+ * @param inOffset Bit offset in the input buffer.
+ * @param[out] out Output buffer.
+ * @param outOffset Bit offset in the output buffer.
+ * @param length Number of bits to copy.
+ */
+static void referenceCopy(const uint8_t* in, uint32_t inOffset, uint8_t* out, uint32_t outOffset, uint32_t length)
+{
+    for (uint32_t i = 0U; i < length; i++) {
+        bool b = READ_BIT(in, inOffset + i);
+        WRITE_BIT(out, outOffset + i, b);
+    }
+}
+
+/**
+ * @brief Helper to fill a buffer with random bytes.
+ * @param rng Random number generator.
+ * @param[out] data Buffer to fill.
+ * @param len Length of buffer.
+ */
+static void fillRandom(std::mt19937& rng, uint8_t* data, uint32_t len)
+{
+    for (uint32_t i = 0U; i < len; i++)
+        data[i] = (uint8_t)rng();
+}
+
+TEST_CASE("BitStream", "[Bit Field Test]") {
+    std::mt19937 rng(72U);
+
+    SECTION("Read_Write_Test") {
+        INFO("BitStream Read/Write Equivalence Test");
+
+        bool failed = false;
+        for (uint32_t offset = 0U; offset < 24U && !failed; offset++) {
+            for (uint32_t length = 0U; length <= BitStream::MAX_FIELD_BITS; length++) {
+                uint8_t in[16U], expected[16U], out[16U];
+                fillRandom(rng, in, 16U);
+                fillRandom(rng, out, 16U);
+                ::memcpy(expected, out, 16U);
+
+                uint64_t value = 0U;
+                for (uint32_t i = 0U; i < length; i++)
+                    value = (value << 1) | (READ_BIT(in, offset + i) ? 1U : 0U);
+
+                if (BitStream::read(in, offset, length) != value) {
+                    ::LogDebug("T", "Read_Write_Test, read mismatch at offset %u, length %u", offset, length);
+                    failed = true;
+                    break;
+                }
+
+                referenceCopy(in, offset, expected, offset, length);
+                BitStream::write(out, offset, value, length);
+                if (::memcmp(expected, out, 16U) != 0) {
+                    ::LogDebug("T", "Read_Write_Test, write mismatch at offset %u, length %u", offset, length);
+                    failed = true;
+                    break;
+                }
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Extract_Insert_Test") {
+        INFO("BitStream Fixed Offset Extract/Insert Test");
+
+        uint8_t in[16U], out[16U], expected[16U];
+        fillRandom(rng, in, 16U);
+        fillRandom(rng, out, 16U);
+        ::memcpy(expected, out, 16U);
+
+        REQUIRE(BitStream::extract<0U, 8U>(in) == BitStream::read(in, 0U, 8U));
+        REQUIRE(BitStream::extract<3U, 12U>(in) == BitStream::read(in, 3U, 12U));
+        REQUIRE(BitStream::extract<7U, 57U>(in) == BitStream::read(in, 7U, 57U));
+        REQUIRE(BitStream::extract<61U, 1U>(in) == BitStream::read(in, 61U, 1U));
+
+        BitStream::insert<5U, 24U>(out, 0xA5C3E1U);
+        BitStream::write(expected, 5U, 0xA5C3E1U, 24U);
+        REQUIRE(::memcmp(expected, out, 16U) == 0);
+
+        BitStream::insert<71U, 57U>(out, 0x0123456789ABCDEFULL);
+        BitStream::write(expected, 71U, 0x0123456789ABCDEFULL, 57U);
+        REQUIRE(::memcmp(expected, out, 16U) == 0);
+    }
+
+    SECTION("Copy_Test") {
+        INFO("BitStream Copy Equivalence Test");
+
+        bool failed = false;
+        for (uint32_t inOffset = 0U; inOffset < 16U && !failed; inOffset++) {
+            for (uint32_t outOffset = 0U; outOffset < 16U && !failed; outOffset++) {
+                for (uint32_t length = 0U; length <= BITSTREAM_MAX_LENGTH; length++) {
+                    uint8_t in[BITSTREAM_TEST_BYTES], expected[BITSTREAM_TEST_BYTES], out[BITSTREAM_TEST_BYTES];
+                    fillRandom(rng, in, BITSTREAM_TEST_BYTES);
+                    fillRandom(rng, out, BITSTREAM_TEST_BYTES);
+                    ::memcpy(expected, out, BITSTREAM_TEST_BYTES);
+
+                    referenceCopy(in, inOffset, expected, outOffset, length);
+                    BitStream::copy(in, inOffset, out, outOffset, length);
+                    if (::memcmp(expected, out, BITSTREAM_TEST_BYTES) != 0) {
+                        ::LogDebug("T", "Copy_Test, mismatch in offset %u, out offset %u, length %u", inOffset, outOffset, length);
+                        failed = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Utils_Bits_Test") {
+        INFO("Utils getBits/setBits Equivalence Test");
+
+        bool failed = false;
+        for (uint32_t start = 0U; start < 64U && !failed; start++) {
+            for (uint32_t length = 0U; length <= BITSTREAM_MAX_LENGTH; length++) {
+                uint8_t in[BITSTREAM_TEST_BYTES], expected[BITSTREAM_TEST_BYTES], out[BITSTREAM_TEST_BYTES];
+                fillRandom(rng, in, BITSTREAM_TEST_BYTES);
+                fillRandom(rng, out, BITSTREAM_TEST_BYTES);
+
+                ::memcpy(expected, out, BITSTREAM_TEST_BYTES);
+                referenceCopy(in, start, expected, 0U, length);
+                uint32_t n = Utils::getBitRange(in, out, start, length);
+                if (n != length || ::memcmp(expected, out, BITSTREAM_TEST_BYTES) != 0) {
+                    ::LogDebug("T", "Utils_Bits_Test, getBitRange() mismatch at start %u, length %u", start, length);
+                    failed = true;
+                    break;
+                }
+
+                ::memcpy(expected, out, BITSTREAM_TEST_BYTES);
+                referenceCopy(in, 0U, expected, start, length);
+                n = Utils::setBits(in, out, start, start + length);
+                if (n != length || ::memcmp(expected, out, BITSTREAM_TEST_BYTES) != 0) {
+                    ::LogDebug("T", "Utils_Bits_Test, setBits() mismatch at start %u, length %u", start, length);
+                    failed = true;
+                    break;
+                }
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+}
@@ -0,0 +1,295 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/CaptureFile.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+#include "modem/Modem.h"
+#include "modem/port/ModemReplayPort.h"
+#include "network/Network.h"
+
+using namespace modem;
+using namespace modem::port;
+using namespace network;
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to get a temporary capture file path. */
+
+static std::string captureTestFile(const char* name)
+{
+    return std::string("/tmp/dvm_capture_test_") + name + ".cap";
+}
+
+TEST_CASE("CaptureFile", "[Capture File Test]") {
+    SECTION("Round_Trip") {
+        std::string file = captureTestFile("round_trip");
+
+        uint8_t modemFrame[36U];
+        for (uint32_t i = 0U; i < 36U; i++)
+            modemFrame[i] = (uint8_t)i;
+
+        uint8_t netFrame[300U];
+        for (uint32_t i = 0U; i < 300U; i++)
+            netFrame[i] = (uint8_t)(0xFFU - (i & 0xFFU));
+
+        sockaddr_storage address;
+        ::memset(&address, 0x00U, sizeof(sockaddr_storage));
+        struct sockaddr_in* in = (struct sockaddr_in*)&address;
+        in->sin_family = AF_INET;
+        in->sin_port = htons(62031U);
+        in->sin_addr.s_addr = htonl(0x7F000001U);
+
+        CaptureWriter writer;
+        REQUIRE(writer.open(file));
+        writer.writeModem(modemFrame, 36U);
+        writer.writeNetwork(netFrame, 300U, address, sizeof(struct sockaddr_in));
+        writer.writeModem(modemFrame, 10U);
+        REQUIRE(writer.getCount() == 3U);
+        writer.close();
+
+        uint8_t buffer[CAPTURE_MAX_RECORD_LENGTH];
+
+        // each reader only sees its own record type
+        CaptureReader modemReader(CaptureRecordType::MODEM, false);
+        REQUIRE(modemReader.open(file));
+        REQUIRE(modemReader.read(buffer) == 36U);
+        REQUIRE(::memcmp(buffer, modemFrame, 36U) == 0);
+        REQUIRE(modemReader.read(buffer) == 10U);
+        REQUIRE(::memcmp(buffer, modemFrame, 10U) == 0);
+        REQUIRE(modemReader.read(buffer) == 0U);
+        REQUIRE(modemReader.isEOF());
+        REQUIRE(modemReader.getCount() == 2U);
+
+        CaptureReader netReader(CaptureRecordType::NETWORK, false);
+        REQUIRE(netReader.open(file));
+
+        sockaddr_storage readAddress;
+        uint32_t readAddrLen = 0U;
+        REQUIRE(netReader.read(buffer, &readAddress, &readAddrLen) == 300U);
+        REQUIRE(::memcmp(buffer, netFrame, 300U) == 0);
+        REQUIRE(readAddrLen == sizeof(struct sockaddr_in));
+        REQUIRE(udp::Socket::match(address, readAddress));
+        REQUIRE(netReader.read(buffer) == 0U);
+        REQUIRE(netReader.isEOF());
+
+        ::remove(file.c_str());
+    }
+
+    SECTION("Realtime_Holds_Records") {
+        std::string file = captureTestFile("realtime");
+
+        uint8_t frame[4U] = { 0x01U, 0x02U, 0x03U, 0x04U };
+
+        CaptureWriter writer;
+        REQUIRE(writer.open(file));
+        ::usleep(200000);
+        writer.writeModem(frame, 4U);
+        writer.close();
+
+        uint8_t buffer[CAPTURE_MAX_RECORD_LENGTH];
+
+        // the record was captured 200ms in, and is not due immediately
+        CaptureReader reader(CaptureRecordType::MODEM, true);
+        REQUIRE(reader.open(file));
+        REQUIRE(reader.read(buffer) == 0U);
+        REQUIRE_FALSE(reader.isEOF());
+
+        ::usleep(250000);
+        REQUIRE(reader.read(buffer) == 4U);
+
+        ::remove(file.c_str());
+    }
+
+    SECTION("Periodic_Flush") {
+        std::string file = captureTestFile("flush");
+
+        uint8_t frame[4U] = { 0x01U, 0x02U, 0x03U, 0x04U };
+
+        CaptureWriter writer;
+        REQUIRE(writer.open(file));
+        writer.writeModem(frame, 4U);
+        ::usleep(1100000);
+        writer.writeModem(frame, 4U);
+
+        // the records are readable while the capture is still open
+        uint8_t buffer[CAPTURE_MAX_RECORD_LENGTH];
+        CaptureReader reader(CaptureRecordType::MODEM, false);
+        REQUIRE(reader.open(file));
+        REQUIRE(reader.read(buffer) == 4U);
+        REQUIRE(reader.read(buffer) == 4U);
+
+        writer.close();
+        ::remove(file.c_str());
+    }
+
+    SECTION("Stops_On_Write_Failure") {
+        uint8_t frame[512U];
+        ::memset(frame, 0x55U, 512U);
+
+        // every write to /dev/full fails once the stream buffer is written out
+        CaptureWriter writer;
+        if (writer.open("/dev/full")) {
+            for (uint32_t i = 0U; i < 64U; i++)
+                writer.writeModem(frame, 512U);
+
+            REQUIRE(writer.getCount() < 64U);
+            writer.close();
+        }
+    }
+
+    SECTION("Rejects_Invalid_File") {
+        std::string file = captureTestFile("invalid");
+
+        FILE* fp = ::fopen(file.c_str(), "wb");
+        REQUIRE(fp != nullptr);
+        ::fprintf(fp, "this is not a capture file");
+        ::fclose(fp);
+
+        CaptureReader reader(CaptureRecordType::MODEM, false);
+        REQUIRE_FALSE(reader.open(file));
+
+        ::remove(file.c_str());
+    }
+
+    SECTION("Modem_Replay_Port") {
+        std::string file = captureTestFile("replay_port");
+
+        // a captured status response, and a captured P25 frame
+        uint8_t status[4U] = { DVM_SHORT_FRAME_START, 4U, CMD_GET_STATUS, 0x00U };
+        uint8_t p25[8U] = { DVM_SHORT_FRAME_START, 8U, CMD_P25_DATA, 0x01U, 0x02U, 0x03U, 0x04U, 0x05U };
+
+        CaptureWriter writer;
+        REQUIRE(writer.open(file));
+        writer.writeModem(status, 4U);
+        writer.writeModem(p25, 8U);
+        writer.close();
+
+        CaptureReader reader(CaptureRecordType::MODEM, false);
+        REQUIRE(reader.open(file));
+
+        ModemReplayPort port(&reader);
+        REQUIRE(port.open());
+
+        // commands are answered by the port
+        uint8_t setMode[4U] = { DVM_SHORT_FRAME_START, 4U, CMD_SET_MODE, 0x00U };
+        REQUIRE(port.write(setMode, 4U) == 4);
+
+        uint8_t buffer[16U];
+        REQUIRE(port.read(buffer, 4U) == 4);
+        REQUIRE(buffer[2U] == CMD_ACK);
+        REQUIRE(buffer[3U] == CMD_SET_MODE);
+
+        // the captured status response is skipped, and the P25 frame replayed (as the modem reads it)
+        REQUIRE(port.read(buffer, 1U) == 1);
+        REQUIRE(buffer[0U] == DVM_SHORT_FRAME_START);
+        REQUIRE(port.read(buffer + 1U, 1U) == 1);
+        REQUIRE(port.read(buffer + 2U, 6U) == 6);
+        REQUIRE(::memcmp(buffer, p25, 8U) == 0);
+
+        REQUIRE(port.read(buffer, 1U) == 0);
+
+        ::remove(file.c_str());
+    }
+
+    SECTION("Modem_Replay_Port_Skips_Corrupt") {
+        std::string file = captureTestFile("replay_corrupt");
+
+        // a truncated long frame, frames whose length disagrees with the record, and a valid P25 frame
+        uint8_t truncated[3U] = { DVM_LONG_FRAME_START, 0x00U, 3U };
+        uint8_t shortBadLen[6U] = { DVM_SHORT_FRAME_START, 8U, CMD_P25_DATA, 0x01U, 0x02U, 0x03U };
+        uint8_t longBadLen[6U] = { DVM_LONG_FRAME_START, 0x01U, 6U, CMD_P25_DATA, 0x01U, 0x02U };
+        uint8_t noStart[4U] = { 0x00U, 4U, CMD_P25_DATA, 0x01U };
+        uint8_t p25[6U] = { DVM_LONG_FRAME_START, 0x00U, 6U, CMD_P25_DATA, 0x01U, 0x02U };
+
+        CaptureWriter writer;
+        REQUIRE(writer.open(file));
+        writer.writeModem(truncated, 3U);
+        writer.writeModem(shortBadLen, 6U);
+        writer.writeModem(longBadLen, 6U);
+        writer.writeModem(noStart, 4U);
+        writer.writeModem(p25, 6U);
+        writer.close();
+
+        CaptureReader reader(CaptureRecordType::MODEM, false);
+        REQUIRE(reader.open(file));
+
+        ModemReplayPort port(&reader);
+        REQUIRE(port.open());
+
+        uint8_t buffer[16U];
+        REQUIRE(port.read(buffer, 6U) == 6);
+        REQUIRE(::memcmp(buffer, p25, 6U) == 0);
+        REQUIRE(port.read(buffer, 1U) == 0);
+
+        ::remove(file.c_str());
+    }
+
+    SECTION("Network_Replay_Sends_Nothing") {
+        std::string file = captureTestFile("replay_network");
+
+        CaptureWriter writer;
+        REQUIRE(writer.open(file));
+        writer.close();
+
+        // stand in for the FNE, on an ephemeral port
+        int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+        REQUIRE(fd >= 0);
+
+        struct sockaddr_in fneAddr;
+        ::memset(&fneAddr, 0x00U, sizeof(struct sockaddr_in));
+        fneAddr.sin_family = AF_INET;
+        fneAddr.sin_port = 0U;
+        fneAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        REQUIRE(::bind(fd, (struct sockaddr*)&fneAddr, sizeof(struct sockaddr_in)) == 0);
+
+        socklen_t fneAddrLen = sizeof(struct sockaddr_in);
+        REQUIRE(::getsockname(fd, (struct sockaddr*)&fneAddr, &fneAddrLen) == 0);
+        uint16_t fnePort = ntohs(fneAddr.sin_port);
+
+        CaptureReader reader(CaptureRecordType::NETWORK, false);
+        REQUIRE(reader.open(file));
+
+        network::Network net("127.0.0.1", fnePort, 0U, 1001U, "PASSWORD", true, false, true, true, true, true, true,
+            false, false, false, false);
+        net.getFrameQueue()->setReplay(&reader);
+        net.enable(true);
+        REQUIRE(net.open());
+
+        // expire the login retry (and time out the login) several times over; every login is discarded
+        bool loginWritten = false;
+        for (uint32_t i = 0U; i < 8U; i++) {
+            net.clock(150000U);
+            if (net.getStatus() == NET_STAT_WAITING_LOGIN)
+                loginWritten = true;
+        }
+        REQUIRE(loginWritten);
+
+        net.writeActLog("replay");
+        net.close();
+
+        uint8_t buffer[DATA_PACKET_LENGTH];
+        REQUIRE(::recv(fd, buffer, DATA_PACKET_LENGTH, MSG_DONTWAIT) < 0);
+
+        ::close(fd);
+        ::remove(file.c_str());
+    }
+}
@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/Resampler.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const double TEST_PI = 3.14159265358979323846;
+const double TONE_AMPLITUDE = 10000.0;
+
+const uint32_t FRAME_MS = 20U;
+const uint32_t TEST_FRAMES = 50U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helper to generate a sine tone.
+ * @param rate Sample rate (Hz).
+ * @param freq Tone frequency (Hz).
+ * @param count Number of samples.
+ * @returns std::vector<short> Tone samples.
+ */
+static std::vector<short> tone(uint32_t rate, double freq, uint32_t count)
+{
+    std::vector<short> samples(count);
+    for (uint32_t i = 0U; i < count; i++)
+        samples[i] = (short)::lrint(TONE_AMPLITUDE * ::sin(2.0 * TEST_PI * freq * i / rate));
+
+    return samples;
+}
+
+/**
+ * @brief Helper to resample a tone, a 20ms frame at a time.
+ * @param resampler Instance of the Resampler class.
+ * @param input Input samples.
+ * @param[out] frameSizes Number of output samples of each frame.
+ * @returns std::vector<short> Output samples.
+ */
+static std::vector<short> resampleFrames(Resampler& resampler, const std::vector<short>& input, std::vector<uint32_t>& frameSizes)
+{
+    uint32_t frameLength = (resampler.getInputRate() * FRAME_MS) / 1000U;
+
+    std::vector<short> output;
+    std::vector<short> frame(resampler.maxOutput(frameLength));
+    for (uint32_t offset = 0U; offset + frameLength <= input.size(); offset += frameLength) {
+        uint32_t written = resampler.process(input.data() + offset, frameLength, frame.data());
+        frameSizes.push_back(written);
+        output.insert(output.end(), frame.begin(), frame.begin() + written);
+    }
+
+    return output;
+}
+
+/**
+ * @brief Helper to measure the signal to error ratio of a resampled tone against the ideal tone,
+ *  delayed by the resampler delay.
+ * @param output Output samples.
+ * @param rate Output sample rate (Hz).
+ * @param freq Tone frequency (Hz).
+ * @param delay Resampler delay (ms).
+ * @returns double Signal to error ratio (dB).
+ */
+static double toneSNR(const std::vector<short>& output, uint32_t rate, double freq, double delay)
+{
+    double signal = 0.0, error = 0.0;
+
+    // skip the filter warm-up
+    for (uint32_t i = rate / 100U; i < output.size(); i++) {
+        double t = ((double)i / rate) - (delay / 1000.0);
+        double expected = TONE_AMPLITUDE * ::sin(2.0 * TEST_PI * freq * t);
+        signal += expected * expected;
+        error += (output[i] - expected) * (output[i] - expected);
+    }
+
+    return 10.0 * ::log10(signal / error);
+}
+
+TEST_CASE("Resampler", "[Resampler Test]") {
+    SECTION("Passthrough") {
+        Resampler resampler(8000U, 8000U);
+        REQUIRE(resampler.getDelay() == 0.0f);
+
+        std::vector<short> input = tone(8000U, 1000.0, 160U);
+        std::vector<short> output(resampler.maxOutput(160U));
+        REQUIRE(resampler.process(input.data(), 160U, output.data()) == 160U);
+        REQUIRE(::memcmp(input.data(), output.data(), 160U * sizeof(short)) == 0);
+    }
+
+    SECTION("Frame_Sizes") {
+        const uint32_t rates[] = { 16000U, 32000U, 44100U, 48000U };
+        for (uint32_t rate : rates) {
+            INFO("rate " << rate);
+
+            // every 20ms frame is exactly 160 samples at 8kHz, in both directions
+            Resampler down(rate, 8000U);
+            std::vector<uint32_t> frameSizes;
+            resampleFrames(down, tone(rate, 1000.0, (rate * FRAME_MS * TEST_FRAMES) / 1000U), frameSizes);
+            REQUIRE(frameSizes.size() == TEST_FRAMES);
+            for (uint32_t size : frameSizes)
+                REQUIRE(size == 160U);
+
+            Resampler up(8000U, rate);
+            frameSizes.clear();
+            resampleFrames(up, tone(8000U, 1000.0, 160U * TEST_FRAMES), frameSizes);
+            REQUIRE(frameSizes.size() == TEST_FRAMES);
+            for (uint32_t size : frameSizes)
+                REQUIRE(size == (rate * FRAME_MS) / 1000U);
+        }
+    }
+
+    SECTION("Tone_Fidelity") {
+        const uint32_t rates[] = { 16000U, 44100U, 48000U };
+        for (uint32_t rate : rates) {
+            INFO("rate " << rate);
+
+            Resampler down(rate, 8000U);
+            std::vector<uint32_t> frameSizes;
+            std::vector<short> output = resampleFrames(down, tone(rate, 1000.0, (rate * FRAME_MS * TEST_FRAMES) / 1000U), frameSizes);
+            REQUIRE(toneSNR(output, 8000U, 1000.0, down.getDelay()) > 50.0);
+
+            Resampler up(8000U, rate);
+            output = resampleFrames(up, tone(8000U, 1000.0, 160U * TEST_FRAMES), frameSizes);
+            REQUIRE(toneSNR(output, rate, 1000.0, up.getDelay()) > 50.0);
+        }
+    }
+
+    SECTION("Alias_Rejection") {
+        // a 6kHz tone can't be represented at 8kHz, and must not fold back into the voice band
+        Resampler down(48000U, 8000U);
+        std::vector<uint32_t> frameSizes;
+        std::vector<short> output = resampleFrames(down, tone(48000U, 6000.0, 48000U), frameSizes);
+
+        double power = 0.0;
+        for (uint32_t i = 80U; i < output.size(); i++)
+            power += (double)output[i] * output[i];
+        double rms = ::sqrt(power / (output.size() - 80U));
+        REQUIRE(20.0 * ::log10(rms / (TONE_AMPLITUDE / ::sqrt(2.0))) < -50.0);
+    }
+
+    SECTION("Reset") {
+        Resampler up(8000U, 48000U);
+        std::vector<short> input = tone(8000U, 1000.0, 160U);
+
+        std::vector<short> first(up.maxOutput(160U));
+        std::vector<short> second(up.maxOutput(160U));
+        up.process(input.data(), 160U, first.data());
+        up.reset();
+        up.process(input.data(), 160U, second.data());
+        REQUIRE(first == second);
+    }
+}
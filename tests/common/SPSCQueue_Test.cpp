@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/SPSCQueue.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <thread>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t THREADED_ITEMS = 1000000U;
+
+TEST_CASE("SPSCQueue", "[SPSC Queue Test]") {
+    SECTION("Capacity_Rounded") {
+        SPSCQueue<uint32_t> queue(100U, "Test Queue");
+        REQUIRE(queue.capacity() == 128U);
+        REQUIRE(queue.isEmpty());
+        REQUIRE(queue.front() == nullptr);
+    }
+
+    SECTION("Fill_And_Drain") {
+        SPSCQueue<uint32_t> queue(8U, "Test Queue");
+        for (uint32_t i = 0U; i < 8U; i++)
+            REQUIRE(queue.push(i));
+
+        // a full queue rejects the item
+        REQUIRE_FALSE(queue.push(8U));
+        REQUIRE(queue.size() == 8U);
+
+        for (uint32_t i = 0U; i < 8U; i++) {
+            uint32_t item = 0U;
+            REQUIRE(queue.pop(item));
+            REQUIRE(item == i);
+        }
+
+        uint32_t item = 0U;
+        REQUIRE_FALSE(queue.pop(item));
+        REQUIRE(queue.isEmpty());
+    }
+
+    SECTION("Wraps") {
+        SPSCQueue<uint32_t> queue(4U, "Test Queue");
+        for (uint32_t i = 0U; i < 100U; i++) {
+            REQUIRE(queue.push(i));
+            REQUIRE(queue.push(i + 1000U));
+
+            REQUIRE(*queue.front() == i);
+            queue.pop();
+            REQUIRE(*queue.front() == i + 1000U);
+            queue.pop();
+        }
+
+        REQUIRE(queue.isEmpty());
+    }
+
+    SECTION("Move_Only") {
+        SPSCQueue<std::unique_ptr<uint32_t>> queue(4U, "Test Queue");
+        REQUIRE(queue.push(std::make_unique<uint32_t>(1234U)));
+
+        std::unique_ptr<uint32_t> item;
+        REQUIRE(queue.pop(item));
+        REQUIRE(item != nullptr);
+        REQUIRE(*item == 1234U);
+    }
+
+    SECTION("Reserve_Commit") {
+        SPSCQueue<uint32_t> queue(4U, "Test Queue");
+        REQUIRE(queue.push(1U));
+
+        // only the free slots may be reserved
+        for (uint32_t n = 0U; n < 3U; n++) {
+            uint32_t* slot = queue.reserve(n);
+            REQUIRE(slot != nullptr);
+            *slot = 100U + n;
+        }
+        REQUIRE(queue.reserve(3U) == nullptr);
+
+        // reserved slots aren't visible until committed
+        REQUIRE(queue.size() == 1U);
+        queue.commit(2U);
+        REQUIRE(queue.size() == 3U);
+
+        uint32_t item = 0U;
+        REQUIRE(queue.pop(item));
+        REQUIRE(item == 1U);
+        REQUIRE(queue.pop(item));
+        REQUIRE(item == 100U);
+        REQUIRE(queue.pop(item));
+        REQUIRE(item == 101U);
+        REQUIRE_FALSE(queue.pop(item));
+    }
+
+    SECTION("Threaded") {
+        SPSCQueue<uint32_t> queue(256U, "Test Queue");
+
+        std::thread producer([&queue]() {
+            for (uint32_t i = 0U; i < THREADED_ITEMS; i++) {
+                while (!queue.push(i))
+                    std::this_thread::yield();
+            }
+        });
+
+        // every item arrives, in order
+        bool ordered = true;
+        uint32_t expected = 0U;
+        while (expected < THREADED_ITEMS) {
+            uint32_t item = 0U;
+            if (!queue.pop(item)) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            if (item != expected)
+                ordered = false;
+            expected++;
+        }
+
+        producer.join();
+        REQUIRE(ordered);
+        REQUIRE(queue.isEmpty());
+    }
+}
@@ -0,0 +1,222 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/edac/BPTC19696.h"
+#include "common/edac/Hamming.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace edac;
+
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t BPTC_DATA_BYTES = 12U;
+const uint32_t BPTC_BURST_BYTES = 33U;
+
+const uint32_t RANDOM_FRAMES = 20000U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helper to return the burst bit position of the given code block bit (skipping the sync/embedded signalling).
+ * @param n Code block bit.
+ * @returns uint32_t Burst bit position.
+ */
+static uint32_t burstBit(uint32_t n)
+{
+    return (n < 98U) ? n : n + 68U;
+}
+
+/**
+ * @brief Reference BPTC (196,96) decoder, a bit per bool as originally implemented.
+ * @param[in] in Input burst.
+ * @param[out] out Decoded data.
+ */
+static void referenceDecode(const uint8_t* in, uint8_t* out)
+{
+    bool raw[196U], d[196U];
+    for (uint32_t i = 0U; i < 196U; i++)
+        raw[i] = READ_BIT(in, burstBit(i)) != 0U;
+    for (uint32_t a = 0U; a < 196U; a++)
+        d[a] = raw[(a * 181U) % 196U];
+
+    bool fixing;
+    uint32_t count = 0U;
+    do {
+        fixing = false;
+
+        bool col[13U];
+        for (uint32_t c = 0U; c < 15U; c++) {
+            for (uint32_t a = 0U; a < 13U; a++)
+                col[a] = d[c + 1U + a * 15U];
+
+            if (Hamming::decode1393(col)) {
+                for (uint32_t a = 0U; a < 13U; a++)
+                    d[c + 1U + a * 15U] = col[a];
+                fixing = true;
+            }
+        }
+
+        for (uint32_t r = 0U; r < 9U; r++) {
+            if (Hamming::decode15113_2(d + (r * 15U) + 1U))
+                fixing = true;
+        }
+
+        count++;
+    } while (fixing && count < 5U);
+
+    ::memset(out, 0x00U, BPTC_DATA_BYTES);
+    uint32_t pos = 0U;
+    for (uint32_t a = 4U; a <= 11U; a++, pos++)
+        WRITE_BIT(out, pos, d[a]);
+    for (uint32_t r = 1U; r < 9U; r++) {
+        for (uint32_t c = 0U; c < 11U; c++, pos++)
+            WRITE_BIT(out, pos, d[(r * 15U) + 1U + c]);
+    }
+}
+
+/**
+ * @brief Reference BPTC (196,96) encoder, a bit per bool as originally implemented.
+ * @param[in] in Input data.
+ * @param[out] out Encoded burst (only the BPTC bits are changed).
+ */
+static void referenceEncode(const uint8_t* in, uint8_t* out)
+{
+    bool d[196U];
+    for (uint32_t i = 0U; i < 196U; i++)
+        d[i] = false;
+
+    uint32_t pos = 0U;
+    for (uint32_t a = 4U; a <= 11U; a++, pos++)
+        d[a] = READ_BIT(in, pos) != 0U;
+    for (uint32_t r = 1U; r < 9U; r++) {
+        for (uint32_t c = 0U; c < 11U; c++, pos++)
+            d[(r * 15U) + 1U + c] = READ_BIT(in, pos) != 0U;
+    }
+
+    for (uint32_t r = 0U; r < 9U; r++)
+        Hamming::encode15113_2(d + (r * 15U) + 1U);
+
+    bool col[13U];
+    for (uint32_t c = 0U; c < 15U; c++) {
+        for (uint32_t a = 0U; a < 13U; a++)
+            col[a] = d[c + 1U + a * 15U];
+        Hamming::encode1393(col);
+        for (uint32_t a = 0U; a < 13U; a++)
+            d[c + 1U + a * 15U] = col[a];
+    }
+
+    for (uint32_t a = 0U; a < 196U; a++)
+        WRITE_BIT(out, burstBit((a * 181U) % 196U), d[a]);
+}
+
+/**
+ * @brief Helper to fill a buffer with random bytes.
+ * @param rng Random number generator.
+ * @param[out] data Buffer to fill.
+ * @param len Length of buffer.
+ */
+static void randomBytes(std::mt19937& rng, uint8_t* data, uint32_t len)
+{
+    for (uint32_t i = 0U; i < len; i++)
+        data[i] = (uint8_t)rng();
+}
+
+TEST_CASE("BPTC19696", "[BPTC (196,96) Test]") {
+    std::mt19937 rng(0x42505443U);
+
+    SECTION("Round_Trip") {
+        uint8_t payload[BPTC_DATA_BYTES];
+        randomBytes(rng, payload, BPTC_DATA_BYTES);
+
+        uint8_t burst[BPTC_BURST_BYTES];
+        ::memset(burst, 0x00U, BPTC_BURST_BYTES);
+
+        BPTC19696 bptc;
+        bptc.encode(payload, burst);
+
+        uint8_t data[BPTC_DATA_BYTES];
+        bptc.decode(burst, data);
+        REQUIRE(::memcmp(payload, data, BPTC_DATA_BYTES) == 0);
+    }
+
+    SECTION("Preserves_Sync") {
+        uint8_t payload[BPTC_DATA_BYTES];
+        randomBytes(rng, payload, BPTC_DATA_BYTES);
+
+        uint8_t burst[BPTC_BURST_BYTES];
+        ::memset(burst, 0xFFU, BPTC_BURST_BYTES);
+
+        BPTC19696 bptc;
+        bptc.encode(payload, burst);
+
+        // the 68 bits of sync/embedded signalling are left untouched
+        for (uint32_t i = 98U; i < 166U; i++)
+            REQUIRE(READ_BIT(burst, i) != 0U);
+    }
+
+    SECTION("Corrects_Single_Errors") {
+        uint8_t payload[BPTC_DATA_BYTES];
+        randomBytes(rng, payload, BPTC_DATA_BYTES);
+
+        uint8_t burst[BPTC_BURST_BYTES];
+        ::memset(burst, 0x00U, BPTC_BURST_BYTES);
+
+        BPTC19696 bptc;
+        bptc.encode(payload, burst);
+
+        // every single bit error of the code block is corrected
+        for (uint32_t i = 0U; i < 196U; i++) {
+            uint8_t errored[BPTC_BURST_BYTES];
+            ::memcpy(errored, burst, BPTC_BURST_BYTES);
+            uint32_t n = burstBit(i);
+            WRITE_BIT(errored, n, !READ_BIT(errored, n));
+
+            uint8_t data[BPTC_DATA_BYTES];
+            bptc.decode(errored, data);
+            REQUIRE(::memcmp(payload, data, BPTC_DATA_BYTES) == 0);
+        }
+    }
+
+    SECTION("Matches_Reference") {
+        BPTC19696 bptc;
+        for (uint32_t n = 0U; n < RANDOM_FRAMES; n++) {
+            uint8_t payload[BPTC_DATA_BYTES];
+            randomBytes(rng, payload, BPTC_DATA_BYTES);
+
+            uint8_t burst[BPTC_BURST_BYTES], expected[BPTC_BURST_BYTES];
+            randomBytes(rng, burst, BPTC_BURST_BYTES);
+            ::memcpy(expected, burst, BPTC_BURST_BYTES);
+
+            bptc.encode(payload, burst);
+            referenceEncode(payload, expected);
+            REQUIRE(::memcmp(expected, burst, BPTC_BURST_BYTES) == 0);
+
+            // random bit errors, up to completely random bursts
+            uint32_t errors = (n < RANDOM_FRAMES / 2U) ? (rng() % 12U) : 196U;
+            for (uint32_t i = 0U; i < errors; i++) {
+                uint32_t bit = burstBit(rng() % 196U);
+                WRITE_BIT(burst, bit, !READ_BIT(burst, bit));
+            }
+
+            uint8_t data[BPTC_DATA_BYTES], expectedData[BPTC_DATA_BYTES];
+            bptc.decode(burst, data);
+            referenceDecode(burst, expectedData);
+            REQUIRE(::memcmp(expectedData, data, BPTC_DATA_BYTES) == 0);
+        }
+    }
+}
@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/edac/RS634717.h"
+#include "common/edac/rs/RS.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace edac;
+
+#include <catch2/catch_test_macros.hpp>
+#include <functional>
+#include <random>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t RS_MAX_BYTES = 27U;
+
+const uint32_t RANDOM_BLOCKS = 20000U;
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Reference decoder, the generic 63 symbol Reed-Solomon codec as originally used by RS634717.
+ * @tparam PAYLOAD Number of non-parity symbols of the full 63 symbol block.
+ */
+template <int PAYLOAD>
+class ReferenceRS : public edac::rs::reed_solomon<uint8_t, 6, 63 - PAYLOAD, 1, 1, edac::rs::gfpoly<6, 0x43>> {
+public:
+    /**
+     * @brief Decodes the given shortened codeword.
+     * @param data Reed-Solomon FEC encoded data to decode.
+     * @param n Number of codeword symbols.
+     * @param k Number of data symbols.
+     * @param t Number of correctable symbols.
+     * @returns bool True, if data was decoded, otherwise false.
+     */
+    bool decode(uint8_t* data, uint32_t n, uint32_t k, int t)
+    {
+        std::vector<uint8_t> codeword(63, 0);
+
+        uint32_t offset = 0U;
+        for (uint32_t i = 0U; i < n; i++, offset += 6)
+            codeword[63U - n + i] = Utils::bin2Hex(data, offset);
+
+        int ec = edac::rs::reed_solomon_base::decode(codeword);
+
+        offset = 0U;
+        for (uint32_t i = 0U; i < k; i++, offset += 6)
+            Utils::hex2Bin(codeword[63U - n + i], data, offset);
+
+        return !((ec == -1) || (ec >= t));
+    }
+};
+
+/**
+ * @brief Represents one of the three RS (63,47,17) based code shapes.
+ */
+struct CodeShape {
+    const char* name;
+    uint32_t n;
+    uint32_t k;
+    bool (RS634717::*decode)(uint8_t*);
+    void (RS634717::*encode)(uint8_t*);
+    std::function<bool(uint8_t*)> reference;
+};
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helper to return the code shapes under test.
+ * @returns std::vector<CodeShape> Code shapes.
+ */
+static std::vector<CodeShape> codeShapes()
+{
+    static ReferenceRS<51> rs241213;
+    static ReferenceRS<55> rs24169;
+    static ReferenceRS<47> rs362017;
+
+    std::vector<CodeShape> shapes;
+    shapes.push_back({ "RS (24,12,13)", 24U, 12U, &RS634717::decode241213, &RS634717::encode241213,
+        [](uint8_t* data) { return rs241213.decode(data, 24U, 12U, 6); } });
+    shapes.push_back({ "RS (24,16,9)", 24U, 16U, &RS634717::decode24169, &RS634717::encode24169,
+        [](uint8_t* data) { return rs24169.decode(data, 24U, 16U, 4); } });
+    shapes.push_back({ "RS (36,20,17)", 36U, 20U, &RS634717::decode362017, &RS634717::encode362017,
+        [](uint8_t* data) { return rs362017.decode(data, 36U, 20U, 8); } });
+    return shapes;
+}
+
+/**
+ * @brief Helper to encode a random payload.
+ * @param rng Random number generator.
+ * @param rs Instance of the RS634717 class.
+ * @param shape Code shape.
+ * @param[out] data Encoded codeword.
+ */
+static void encodeRandom(std::mt19937& rng, RS634717& rs, const CodeShape& shape, uint8_t* data)
+{
+    ::memset(data, 0x00U, RS_MAX_BYTES);
+    for (uint32_t i = 0U; i < shape.k; i++)
+        Utils::hex2Bin((uint8_t)(rng() & 0x3FU), data, i * 6U);
+
+    (rs.*shape.encode)(data);
+}
+
+/**
+ * @brief Helper to inject random symbol errors.
+ * @param rng Random number generator.
+ * @param shape Code shape.
+ * @param data Codeword.
+ * @param errors Number of symbol errors.
+ */
+static void injectErrors(std::mt19937& rng, const CodeShape& shape, uint8_t* data, uint32_t errors)
+{
+    for (uint32_t i = 0U; i < errors; i++) {
+        uint32_t offset = (rng() % shape.n) * 6U;
+        uint8_t symbol = Utils::bin2Hex(data, offset) ^ (uint8_t)((rng() % 63U) + 1U);
+        Utils::hex2Bin(symbol, data, offset);
+    }
+}
+
+TEST_CASE("RS634717", "[Reed-Soloman 63,47,17 Test]") {
+    std::mt19937 rng(0x52533633U);
+    RS634717 rs;
+
+    for (const CodeShape& shape : codeShapes()) {
+        INFO(shape.name);
+        uint32_t t = (shape.n - shape.k) / 2U;
+
+        // up to (but not including) the maximum symbol errors accepted by decode are corrected
+        for (uint32_t errors = 0U; errors < t; errors++) {
+            uint8_t data[RS_MAX_BYTES];
+            encodeRandom(rng, rs, shape, data);
+
+            uint8_t expected[RS_MAX_BYTES];
+            ::memcpy(expected, data, RS_MAX_BYTES);
+
+            // errors at distinct symbols
+            for (uint32_t i = 0U; i < errors; i++) {
+                uint32_t offset = ((i * 5U) % shape.n) * 6U;
+                Utils::hex2Bin(Utils::bin2Hex(data, offset) ^ 0x2AU, data, offset);
+            }
+
+            REQUIRE((rs.*shape.decode)(data));
+            REQUIRE(::memcmp(expected, data, (shape.k * 6U) / 8U) == 0);
+        }
+
+        // the encoded codeword is valid for the reference decoder
+        for (uint32_t n = 0U; n < 100U; n++) {
+            uint8_t data[RS_MAX_BYTES];
+            encodeRandom(rng, rs, shape, data);
+
+            uint8_t expected[RS_MAX_BYTES];
+            ::memcpy(expected, data, RS_MAX_BYTES);
+            REQUIRE(shape.reference(data));
+            REQUIRE(::memcmp(expected, data, RS_MAX_BYTES) == 0);
+        }
+
+        // random symbol errors, well beyond the correction capability, match the reference decoder
+        for (uint32_t n = 0U; n < RANDOM_BLOCKS; n++) {
+            uint8_t data[RS_MAX_BYTES];
+            encodeRandom(rng, rs, shape, data);
+            injectErrors(rng, shape, data, rng() % (t * 2U + 2U));
+
+            uint8_t expected[RS_MAX_BYTES];
+            ::memcpy(expected, data, RS_MAX_BYTES);
+
+            bool ret = (rs.*shape.decode)(data);
+            bool expectedRet = shape.reference(expected);
+            REQUIRE(ret == expectedRet);
+            REQUIRE(::memcmp(expected, data, RS_MAX_BYTES) == 0);
+        }
+    }
+}
@@ -0,0 +1,356 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/edac/Trellis.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace edac;
+
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t TRELLIS_CODED_BITS = 196U;
+const uint32_t TRELLIS_CODED_BYTES = 25U;
+const uint32_t TRELLIS_DMR_CODED_BYTES = 33U;
+const uint32_t TRELLIS_SYMBOLS = 98U;
+
+const uint32_t BER_FRAMES = 10000U;
+const uint32_t BER_MAX_ERRORS = 16U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helper to encode a payload at the given rate.
+ * @param trellis Instance of the Trellis class.
+ * @param rate34 Flag indicating 3/4 rate (otherwise 1/2 rate).
+ * @param[in] payload Payload bytes.
+ * @param[out] data Trellis symbol bytes.
+ */
+static void encode(Trellis& trellis, bool rate34, const uint8_t* payload, uint8_t* data)
+{
+    ::memset(data, 0x00U, TRELLIS_CODED_BYTES);
+    if (rate34)
+        trellis.encode34(payload, data);
+    else
+        trellis.encode12(payload, data);
+}
+
+/**
+ * @brief Helper to decode a payload at the given rate.
+ * @param trellis Instance of the Trellis class.
+ * @param rate34 Flag indicating 3/4 rate (otherwise 1/2 rate).
+ * @param[in] data Trellis symbol bytes.
+ * @param[out] payload Payload bytes.
+ * @returns bool True, if Trellis decoded, otherwise false.
+ */
+static bool decode(Trellis& trellis, bool rate34, const uint8_t* data, uint8_t* payload)
+{
+    return rate34 ? trellis.decode34(data, payload) : trellis.decode12(data, payload);
+}
+
+/**
+ * @brief Helper to convert Trellis symbol bytes into nominal symbol values.
+ * @param[in] data Trellis symbol bytes.
+ * @param[out] symbols Symbol values (+3, +1, -1 or -3).
+ */
+static void toSymbols(const uint8_t* data, float* symbols)
+{
+    for (uint32_t i = 0U; i < TRELLIS_SYMBOLS; i++) {
+        bool b1 = READ_BIT(data, i * 2U + 0U) != 0x00U;
+        bool b2 = READ_BIT(data, i * 2U + 1U) != 0x00U;
+
+        if (!b1 && b2)
+            symbols[i] = +3.0F;
+        else if (!b1 && !b2)
+            symbols[i] = +1.0F;
+        else if (b1 && !b2)
+            symbols[i] = -1.0F;
+        else
+            symbols[i] = -3.0F;
+    }
+}
+
+/**
+ * @brief Helper to slice symbol values into Trellis symbol bytes.
+ * @param[in] symbols Symbol values.
+ * @param[out] data Trellis symbol bytes.
+ */
+static void fromSymbols(const float* symbols, uint8_t* data)
+{
+    ::memset(data, 0x00U, TRELLIS_CODED_BYTES);
+    for (uint32_t i = 0U; i < TRELLIS_SYMBOLS; i++) {
+        bool b1 = symbols[i] < 0.0F;
+        bool b2 = symbols[i] > 2.0F || symbols[i] < -2.0F;
+
+        WRITE_BIT(data, i * 2U + 0U, b1);
+        WRITE_BIT(data, i * 2U + 1U, b2);
+    }
+}
+
+/**
+ * @brief Helper to flip the given number of unique random bits.
+ * @param rng Random number generator.
+ * @param[in,out] data Trellis symbol bytes.
+ * @param errors Number of bits to flip.
+ */
+static void injectErrors(std::mt19937& rng, uint8_t* data, uint32_t errors)
+{
+    uint32_t pos[TRELLIS_CODED_BITS];
+    for (uint32_t i = 0U; i < TRELLIS_CODED_BITS; i++)
+        pos[i] = i;
+
+    for (uint32_t i = 0U; i < errors; i++) {
+        uint32_t j = i + (rng() % (TRELLIS_CODED_BITS - i));
+        std::swap(pos[i], pos[j]);
+
+        bool b = READ_BIT(data, pos[i]) != 0x00U;
+        WRITE_BIT(data, pos[i], !b);
+    }
+}
+
+TEST_CASE("Trellis 3/4", "[3/4 Rate Test]") {
+    Trellis trellis;
+    std::mt19937 rng(34U);
+
+    SECTION("34_Sanity_Test") {
+        INFO("Trellis 3/4 Rate Round Trip Test");
+
+        for (uint32_t n = 0U; n < 100U; n++) {
+            uint8_t payload[18U], data[TRELLIS_CODED_BYTES], decoded[18U];
+            for (uint32_t i = 0U; i < 18U; i++)
+                payload[i] = (uint8_t)rng();
+
+            encode(trellis, true, payload, data);
+            REQUIRE(trellis.decode34(data, decoded));
+            REQUIRE(::memcmp(payload, decoded, 18U) == 0);
+        }
+    }
+
+    SECTION("34_DMR_Sanity_Test") {
+        INFO("Trellis 3/4 Rate DMR Round Trip Test");
+
+        uint8_t payload[18U], data[TRELLIS_DMR_CODED_BYTES], decoded[18U];
+        for (uint32_t i = 0U; i < 18U; i++)
+            payload[i] = (uint8_t)rng();
+
+        // the sync/slot type bits between the two payload halves are left untouched
+        ::memset(data, 0xA5U, TRELLIS_DMR_CODED_BYTES);
+        trellis.encode34(payload, data, true);
+        REQUIRE(trellis.decode34(data, decoded, true));
+        REQUIRE(::memcmp(payload, decoded, 18U) == 0);
+    }
+
+    SECTION("34_Single_Error_Test") {
+        INFO("Trellis 3/4 Rate Single Bit Error Correction Test");
+
+        uint8_t payload[18U], data[TRELLIS_CODED_BYTES];
+        for (uint32_t i = 0U; i < 18U; i++)
+            payload[i] = (uint8_t)rng();
+        encode(trellis, true, payload, data);
+
+        for (uint32_t pos = 0U; pos < TRELLIS_CODED_BITS; pos++) {
+            uint8_t errored[TRELLIS_CODED_BYTES], decoded[18U];
+            ::memcpy(errored, data, TRELLIS_CODED_BYTES);
+
+            bool b = READ_BIT(errored, pos) != 0x00U;
+            WRITE_BIT(errored, pos, !b);
+
+            REQUIRE(trellis.decode34(errored, decoded));
+            REQUIRE(::memcmp(payload, decoded, 18U) == 0);
+        }
+    }
+
+    SECTION("34_Soft_Test") {
+        INFO("Trellis 3/4 Rate Soft Decision Test");
+
+        std::normal_distribution<float> noise(0.0F, 0.4F);
+        for (uint32_t n = 0U; n < 100U; n++) {
+            uint8_t payload[18U], data[TRELLIS_CODED_BYTES], decoded[18U];
+            for (uint32_t i = 0U; i < 18U; i++)
+                payload[i] = (uint8_t)rng();
+            encode(trellis, true, payload, data);
+
+            float symbols[TRELLIS_SYMBOLS];
+            toSymbols(data, symbols);
+            for (uint32_t i = 0U; i < TRELLIS_SYMBOLS; i++)
+                symbols[i] += noise(rng);
+
+            REQUIRE(trellis.decode34(symbols, decoded));
+            REQUIRE(::memcmp(payload, decoded, 18U) == 0);
+        }
+    }
+}
+
+TEST_CASE("Trellis 1/2", "[1/2 Rate Test]") {
+    Trellis trellis;
+    std::mt19937 rng(12U);
+
+    SECTION("12_Sanity_Test") {
+        INFO("Trellis 1/2 Rate Round Trip Test");
+
+        for (uint32_t n = 0U; n < 100U; n++) {
+            uint8_t payload[12U], data[TRELLIS_CODED_BYTES], decoded[12U];
+            for (uint32_t i = 0U; i < 12U; i++)
+                payload[i] = (uint8_t)rng();
+
+            encode(trellis, false, payload, data);
+            REQUIRE(trellis.decode12(data, decoded));
+            REQUIRE(::memcmp(payload, decoded, 12U) == 0);
+        }
+    }
+
+    SECTION("12_Double_Error_Test") {
+        INFO("Trellis 1/2 Rate Double Bit Error Correction Test");
+
+        uint8_t payload[12U], data[TRELLIS_CODED_BYTES];
+        for (uint32_t i = 0U; i < 12U; i++)
+            payload[i] = (uint8_t)rng();
+        encode(trellis, false, payload, data);
+
+        bool failed = false;
+        for (uint32_t pos1 = 0U; pos1 < TRELLIS_CODED_BITS && !failed; pos1++) {
+            for (uint32_t pos2 = pos1 + 1U; pos2 < TRELLIS_CODED_BITS; pos2++) {
+                uint8_t errored[TRELLIS_CODED_BYTES], decoded[12U];
+                ::memcpy(errored, data, TRELLIS_CODED_BYTES);
+
+                bool b = READ_BIT(errored, pos1) != 0x00U;
+                WRITE_BIT(errored, pos1, !b);
+                b = READ_BIT(errored, pos2) != 0x00U;
+                WRITE_BIT(errored, pos2, !b);
+
+                if (!trellis.decode12(errored, decoded) || ::memcmp(payload, decoded, 12U) != 0) {
+                    ::LogDebug("T", "12_Double_Error_Test, failed to correct errors at %u, %u", pos1, pos2);
+                    failed = true;
+                    break;
+                }
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("12_Soft_Test") {
+        INFO("Trellis 1/2 Rate Soft Decision Test");
+
+        std::normal_distribution<float> noise(0.0F, 0.5F);
+        for (uint32_t n = 0U; n < 100U; n++) {
+            uint8_t payload[12U], data[TRELLIS_CODED_BYTES], decoded[12U];
+            for (uint32_t i = 0U; i < 12U; i++)
+                payload[i] = (uint8_t)rng();
+            encode(trellis, false, payload, data);
+
+            float symbols[TRELLIS_SYMBOLS];
+            toSymbols(data, symbols);
+            for (uint32_t i = 0U; i < TRELLIS_SYMBOLS; i++)
+                symbols[i] += noise(rng);
+
+            REQUIRE(trellis.decode12(symbols, decoded));
+            REQUIRE(::memcmp(payload, decoded, 12U) == 0);
+        }
+    }
+
+    SECTION("12_Noise_Reject_Test") {
+        INFO("Trellis 1/2 Rate Noise Rejection Test");
+
+        uint32_t accepted = 0U;
+        for (uint32_t n = 0U; n < 1000U; n++) {
+            uint8_t data[TRELLIS_CODED_BYTES], decoded[12U];
+            for (uint32_t i = 0U; i < TRELLIS_CODED_BYTES; i++)
+                data[i] = (uint8_t)rng();
+
+            if (trellis.decode12(data, decoded))
+                accepted++;
+        }
+
+        ::LogDebug("T", "12_Noise_Reject_Test, accepted %u of 1000 random frames", accepted);
+        REQUIRE(accepted < 10U);
+    }
+}
+
+TEST_CASE("Trellis BER", "[.][trellis][ber]") {
+    Trellis trellis;
+    std::mt19937 rng(196U);
+
+    for (uint32_t r = 0U; r < 2U; r++) {
+        bool rate34 = (r == 0U);
+        uint32_t payloadLen = rate34 ? 18U : 12U;
+
+        // frame success rate and residual (undetected) payload bit errors per injected bit error count
+        for (uint32_t errors = 0U; errors <= BER_MAX_ERRORS; errors++) {
+            uint32_t decoded = 0U, rejected = 0U, residualBits = 0U;
+            for (uint32_t n = 0U; n < BER_FRAMES; n++) {
+                uint8_t payload[18U], data[TRELLIS_CODED_BYTES], output[18U];
+                for (uint32_t i = 0U; i < payloadLen; i++)
+                    payload[i] = (uint8_t)rng();
+                encode(trellis, rate34, payload, data);
+                injectErrors(rng, data, errors);
+
+                if (!decode(trellis, rate34, data, output)) {
+                    rejected++;
+                    continue;
+                }
+
+                uint32_t bitErrors = 0U;
+                for (uint32_t i = 0U; i < payloadLen; i++)
+                    bitErrors += Utils::countBits8(payload[i] ^ output[i]);
+
+                if (bitErrors == 0U)
+                    decoded++;
+                residualBits += bitErrors;
+            }
+
+            double residualBer = (double)residualBits / (double)(BER_FRAMES * payloadLen * 8U);
+            ::LogInfoEx("T", "Trellis %s, %2u errors, decoded %6.2f%%, rejected %6.2f%%, residual BER %.5f", rate34 ? "3/4" : "1/2", errors,
+                100.0 * decoded / BER_FRAMES, 100.0 * rejected / BER_FRAMES, residualBer);
+        }
+    }
+
+    // soft decision against hard decision decoding of the same noisy symbols
+    const float sigmas[] = { 0.4F, 0.5F, 0.6F, 0.7F, 0.8F };
+    for (uint32_t r = 0U; r < 2U; r++) {
+        bool rate34 = (r == 0U);
+        uint32_t payloadLen = rate34 ? 18U : 12U;
+
+        for (float sigma : sigmas) {
+            std::normal_distribution<float> noise(0.0F, sigma);
+
+            uint32_t hardDecoded = 0U, softDecoded = 0U;
+            for (uint32_t n = 0U; n < BER_FRAMES; n++) {
+                uint8_t payload[18U], data[TRELLIS_CODED_BYTES], output[18U];
+                for (uint32_t i = 0U; i < payloadLen; i++)
+                    payload[i] = (uint8_t)rng();
+                encode(trellis, rate34, payload, data);
+
+                float symbols[TRELLIS_SYMBOLS];
+                toSymbols(data, symbols);
+                for (uint32_t i = 0U; i < TRELLIS_SYMBOLS; i++)
+                    symbols[i] += noise(rng);
+
+                fromSymbols(symbols, data);
+                if (decode(trellis, rate34, data, output) && ::memcmp(payload, output, payloadLen) == 0)
+                    hardDecoded++;
+
+                bool ret = rate34 ? trellis.decode34(symbols, output) : trellis.decode12(symbols, output);
+                if (ret && ::memcmp(payload, output, payloadLen) == 0)
+                    softDecoded++;
+            }
+
+            ::LogInfoEx("T", "Trellis %s, sigma %.1f, hard decoded %6.2f%%, soft decoded %6.2f%%", rate34 ? "3/4" : "1/2", sigma,
+                100.0 * hardDecoded / BER_FRAMES, 100.0 * softDecoded / BER_FRAMES);
+        }
+    }
+}
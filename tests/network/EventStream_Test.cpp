@@ -0,0 +1,234 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/json/json.h"
+#include "common/network/rest/EventStream.h"
+#include "common/network/rest/http/HTTPServer.h"
+#include "common/network/rest/RequestDispatcher.h"
+#include "common/Log.h"
+#include "host/network/RESTDefines.h"
+
+using namespace network;
+using namespace network::rest;
+using namespace network::rest::http;
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint16_t TEST_EVENT_PORT = 47795U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helper to connect a raw socket to the loopback address.
+ * @param port Port to connect to.
+ * @returns int Socket descriptor, or -1 on failure.
+ */
+static int connectLoopback(uint16_t port)
+{
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+
+    struct timeval tv;
+    tv.tv_sec = 2;
+    tv.tv_usec = 0;
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    sockaddr_in addr;
+    ::memset(&addr, 0x00U, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+/**
+ * @brief Helper to read from a socket until the buffer contains the given string.
+ * @param fd Socket descriptor.
+ * @param buffer Buffer of received data.
+ * @param what String to wait for.
+ * @returns bool True, if the string was received before the read timed out, otherwise false.
+ */
+static bool readUntil(int fd, std::string& buffer, const std::string& what)
+{
+    char data[1024U];
+    while (buffer.find(what) == std::string::npos) {
+        ssize_t len = ::recv(fd, data, sizeof(data), 0);
+        if (len <= 0)
+            return false;
+        buffer.append(data, (size_t)len);
+    }
+
+    return true;
+}
+
+TEST_CASE("EventStream", "[rest][events]") {
+    SECTION("Coalescing") {
+        EventStreamSubscriber subscriber("", 8U);
+
+        subscriber.push("A", "");
+        subscriber.push("B1", "signal");
+        subscriber.push("C", "");
+        subscriber.push("B2", "signal");
+
+        // the keyed event keeps its position, only the latest value is delivered
+        std::string frames;
+        REQUIRE(subscriber.take(frames));
+        REQUIRE(frames == "AB2C");
+
+        REQUIRE_FALSE(subscriber.take(frames));
+        REQUIRE(frames.empty());
+    }
+
+    SECTION("Overflow") {
+        EventStreamSubscriber subscriber("", 4U);
+        for (uint32_t i = 0U; i < 5U; i++) {
+            subscriber.push(std::to_string(i), "");
+        }
+
+        std::string frames;
+        REQUIRE(subscriber.take(frames));
+        REQUIRE(frames == "event: resync\ndata: {\"dropped\":4}\n\n4");
+        REQUIRE(subscriber.dropped() == 4U);
+    }
+
+    SECTION("Type_Filter") {
+        EventStream events;
+        std::shared_ptr<EventStreamSubscriber> all = events.subscribe();
+        std::shared_ptr<EventStreamSubscriber> calls = events.subscribe(std::string(EVENT_CALL_START) + "," + EVENT_CALL_END);
+
+        json::object data = json::object();
+        uint32_t srcId = 1234U;
+        data["srcId"].set<uint32_t>(srcId);
+        events.publish(EVENT_CALL_START, data);
+        events.publish("grant", data);
+        events.keepAlive();
+
+        std::string frames;
+        REQUIRE(calls->take(frames));
+        REQUIRE(frames == "event: call-start\ndata: {\"srcId\":1234}\n\n: keep-alive\n\n");
+
+        REQUIRE(all->take(frames));
+        REQUIRE(frames.find("event: grant\n") != std::string::npos);
+    }
+
+    SECTION("Subscriber_Limit") {
+        EventStream events(EVENT_STREAM_MAX_QUEUED, 2U);
+        std::shared_ptr<EventStreamSubscriber> s1 = events.subscribe();
+        std::shared_ptr<EventStreamSubscriber> s2 = events.subscribe();
+        REQUIRE(events.subscribe() == nullptr);
+
+        // closed subscribers free their slot
+        s1->close();
+        REQUIRE(events.subscribe() != nullptr);
+    }
+
+    SECTION("Publish_Without_Subscribers") {
+        EventStream events;
+        REQUIRE_FALSE(events.hasSubscribers());
+
+        json::object data = json::object();
+        events.publish(EVENT_CALL_END, data);
+
+        std::shared_ptr<EventStreamSubscriber> subscriber = events.subscribe();
+        REQUIRE(events.hasSubscribers());
+
+        // events published before subscribing are not delivered
+        std::string frames;
+        REQUIRE_FALSE(subscriber->take(frames));
+    }
+}
+
+TEST_CASE("EventStream HTTP", "[rest][events]") {
+    typedef RequestDispatcher<HTTPPayload, HTTPPayload> DispatcherType;
+
+    EventStream events;
+    DispatcherType dispatcher(false);
+    dispatcher.match(GET_EVENTS).get([&](const HTTPPayload& request, HTTPPayload& reply, const RequestMatch&) {
+        std::string types = "";
+        size_t pos = request.uri.find("types=");
+        if (pos != std::string::npos) {
+            types = request.uri.substr(pos + 6U);
+        }
+
+        std::shared_ptr<EventStreamSubscriber> subscriber = events.subscribe(types);
+        if (subscriber == nullptr) {
+            reply = HTTPPayload::statusPayload(HTTPPayload::SERVICE_UNAVAILABLE);
+            return;
+        }
+
+        reply.stream(subscriber);
+    });
+
+    HTTPServer<DispatcherType> server("127.0.0.1", TEST_EVENT_PORT, false);
+    server.setHandler(dispatcher);
+    server.open();
+    std::thread thread([&]() { server.run(); });
+
+    int fd = connectLoopback(TEST_EVENT_PORT);
+    REQUIRE(fd >= 0);
+
+    std::string request = "GET /events?types=call-start HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+    REQUIRE(::send(fd, request.c_str(), request.length(), 0) == (ssize_t)request.length());
+
+    // the headers are sent as soon as the subscriber is registered
+    std::string buffer;
+    REQUIRE(readUntil(fd, buffer, "\r\n\r\n"));
+    REQUIRE(buffer.find("200") != std::string::npos);
+    REQUIRE(buffer.find("text/event-stream") != std::string::npos);
+    REQUIRE(buffer.find("Content-Length") == std::string::npos);
+    REQUIRE(events.hasSubscribers());
+
+    // events are pushed to the open connection, filtered by type
+    for (uint32_t i = 1U; i <= 3U; i++) {
+        json::object data = json::object();
+        data["dstId"].set<uint32_t>(i);
+        events.publish(EVENT_CALL_END, data);
+        events.publish(EVENT_CALL_START, data);
+    }
+
+    REQUIRE(readUntil(fd, buffer, "{\"dstId\":3}\n\n"));
+    REQUIRE(buffer.find("event: call-start\ndata: {\"dstId\":1}\n\n") != std::string::npos);
+    REQUIRE(buffer.find("event: call-end") == std::string::npos);
+
+    // closing the client closes the subscriber, which is pruned on the next publish
+    ::close(fd);
+    for (uint32_t i = 0U; i < 100U && events.hasSubscribers(); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        json::object data = json::object();
+        events.publish(EVENT_CALL_START, data);
+    }
+    REQUIRE_FALSE(events.hasSubscribers());
+
+    server.stop();
+    thread.join();
+}
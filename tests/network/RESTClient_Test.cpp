@@ -0,0 +1,242 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/json/json.h"
+#include "common/network/rest/http/HTTPServer.h"
+#include "common/network/rest/RequestDispatcher.h"
+#include "common/Log.h"
+#include "host/network/RESTDefines.h"
+#include "remote/RESTClient.h"
+
+using namespace network;
+using namespace network::rest;
+using namespace network::rest::http;
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const char* TEST_REST_PASSWORD = "PASSWORD";
+// larger than the client connection read buffer, so the response body spans several reads
+const size_t TEST_REST_BODY_LEN = 20000U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helper to find a free TCP port on the loopback address.
+ * @returns uint16_t Free port, or zero if none could be bound.
+ */
+static uint16_t freeRESTPort()
+{
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+        return 0U;
+
+    struct sockaddr_in addr;
+    ::memset(&addr, 0x00U, sizeof(struct sockaddr_in));
+    addr.sin_family = AF_INET;
+    addr.sin_port = 0U;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    socklen_t addrLen = sizeof(struct sockaddr_in);
+    uint16_t port = 0U;
+    if (::bind(fd, (struct sockaddr*)&addr, addrLen) == 0 && ::getsockname(fd, (struct sockaddr*)&addr, &addrLen) == 0)
+        port = ntohs(addr.sin_port);
+
+    ::close(fd);
+    return port;
+}
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements a minimal REST API endpoint (authentication and status) on the loopback address.
+ */
+class TestRESTServer {
+public:
+    typedef RequestDispatcher<HTTPPayload, HTTPPayload> DispatcherType;
+
+    /**
+     * @brief Initializes a new instance of the TestRESTServer class.
+     * @param port Port to listen on.
+     */
+    TestRESTServer(uint16_t port) :
+        auths(0U),
+        requests(0U),
+        m_dispatcher(false),
+        m_server("127.0.0.1", port, false),
+        m_token(1U)
+    {
+        m_dispatcher.match(PUT_AUTHENTICATE).put([this](const HTTPPayload& request, HTTPPayload& reply, const RequestMatch&) {
+            auths++;
+
+            json::object response = json::object();
+            int status = HTTPPayload::OK;
+            response["status"].set<int>(status);
+            std::string token = std::to_string(m_token);
+            response["token"].set<std::string>(token);
+            reply.payload(response);
+        });
+
+        m_dispatcher.match(GET_STATUS).get([this](const HTTPPayload& request, HTTPPayload& reply, const RequestMatch&) {
+            requests++;
+
+            json::object response = json::object();
+            if (request.headers.find("X-DVM-Auth-Token") != std::to_string(m_token)) {
+                int status = HTTPPayload::UNAUTHORIZED;
+                response["status"].set<int>(status);
+                reply.payload(response);
+                reply.status = HTTPPayload::UNAUTHORIZED;
+                return;
+            }
+
+            int status = HTTPPayload::OK;
+            response["status"].set<int>(status);
+            std::string body = std::string(TEST_REST_BODY_LEN, 'A');
+            response["body"].set<std::string>(body);
+            reply.payload(response);
+        });
+
+        m_server.setHandler(m_dispatcher);
+        m_server.open();
+        m_thread = std::thread([this]() { m_server.run(); });
+    }
+    /**
+     * @brief Finalizes a instance of the TestRESTServer class.
+     */
+    ~TestRESTServer()
+    {
+        m_server.stop();
+        m_thread.join();
+    }
+
+    /**
+     * @brief Invalidates the issued authentication token (as if the endpoint restarted).
+     */
+    void invalidateToken() { m_token++; }
+
+    std::atomic<uint32_t> auths;
+    std::atomic<uint32_t> requests;
+
+private:
+    DispatcherType m_dispatcher;
+    HTTPServer<DispatcherType> m_server;
+    std::thread m_thread;
+
+    std::atomic<uint32_t> m_token;
+};
+
+TEST_CASE("RESTClient", "[rest][client]") {
+    uint16_t port = freeRESTPort();
+    REQUIRE(port != 0U);
+
+    SECTION("Persistent_Connection") {
+        TestRESTServer server(port);
+
+        for (uint32_t i = 0U; i < 10U; i++) {
+            json::object rsp = json::object();
+            int ret = RESTClient::send("127.0.0.1", port, TEST_REST_PASSWORD, HTTP_GET, GET_STATUS, json::object(), rsp, false, REST_DEFAULT_WAIT);
+            REQUIRE(ret == HTTPPayload::OK);
+
+            // the whole body arrives even though it spans several reads
+            REQUIRE(rsp["body"].is<std::string>());
+            REQUIRE(rsp["body"].get<std::string>().length() == TEST_REST_BODY_LEN);
+        }
+
+        // the token is cached with the pooled connection, so authentication happens once
+        REQUIRE(server.auths == 1U);
+        REQUIRE(server.requests == 10U);
+
+        RESTClient::closeConnections();
+    }
+
+    SECTION("Token_Invalidated") {
+        TestRESTServer server(port);
+
+        json::object rsp = json::object();
+        int ret = RESTClient::send("127.0.0.1", port, TEST_REST_PASSWORD, HTTP_GET, GET_STATUS, json::object(), rsp, false, REST_DEFAULT_WAIT);
+        REQUIRE(ret == HTTPPayload::OK);
+
+        // the rejected request is retried once after authenticating again
+        server.invalidateToken();
+        ret = RESTClient::send("127.0.0.1", port, TEST_REST_PASSWORD, HTTP_GET, GET_STATUS, json::object(), rsp, false, REST_DEFAULT_WAIT);
+        REQUIRE(ret == HTTPPayload::OK);
+        REQUIRE(server.auths == 2U);
+        REQUIRE(server.requests == 3U);
+
+        RESTClient::closeConnections();
+    }
+
+    SECTION("Server_Restarted") {
+        json::object rsp = json::object();
+        {
+            TestRESTServer server(port);
+            int ret = RESTClient::send("127.0.0.1", port, TEST_REST_PASSWORD, HTTP_GET, GET_STATUS, json::object(), rsp, false, REST_DEFAULT_WAIT);
+            REQUIRE(ret == HTTPPayload::OK);
+        }
+
+        // the pooled connection is now closed, the request is sent again on a new connection
+        TestRESTServer server(port);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        int ret = RESTClient::send("127.0.0.1", port, TEST_REST_PASSWORD, HTTP_GET, GET_STATUS, json::object(), rsp, false, REST_DEFAULT_WAIT);
+        REQUIRE(ret == HTTPPayload::OK);
+
+        RESTClient::closeConnections();
+    }
+
+    SECTION("Batch") {
+        TestRESTServer server1(port);
+
+        // each port is found while the servers before it are listening, so they are all different
+        uint16_t port2 = freeRESTPort();
+        REQUIRE(port2 != 0U);
+        TestRESTServer server2(port2);
+
+        uint16_t unusedPort = freeRESTPort();
+        REQUIRE(unusedPort != 0U);
+
+        std::vector<RESTClient::BatchRequest> requests;
+        requests.push_back(RESTClient::BatchRequest { "127.0.0.1", port, TEST_REST_PASSWORD, false, HTTP_GET, GET_STATUS, json::object(), json::object(), EXIT_SUCCESS });
+        requests.push_back(RESTClient::BatchRequest { "127.0.0.1", port2, TEST_REST_PASSWORD, false, HTTP_GET, GET_STATUS, json::object(), json::object(), EXIT_SUCCESS });
+        // nothing is listening here, the other commands must still complete
+        requests.push_back(RESTClient::BatchRequest { "127.0.0.1", unusedPort, TEST_REST_PASSWORD, false, HTTP_GET, GET_STATUS, json::object(), json::object(), EXIT_SUCCESS });
+        requests.push_back(RESTClient::BatchRequest { "", port, TEST_REST_PASSWORD, false, HTTP_GET, GET_STATUS, json::object(), json::object(), EXIT_SUCCESS });
+
+        for (uint32_t i = 0U; i < 5U; i++) {
+            RESTClient::sendBatch(requests, REST_DEFAULT_WAIT);
+
+            REQUIRE(requests[0U].ret == HTTPPayload::OK);
+            REQUIRE(requests[0U].response["body"].get<std::string>().length() == TEST_REST_BODY_LEN);
+            REQUIRE(requests[1U].ret == HTTPPayload::OK);
+            REQUIRE(requests[2U].ret != HTTPPayload::OK);
+            REQUIRE(requests[3U].ret != HTTPPayload::OK);
+        }
+
+        REQUIRE(server1.auths == 1U);
+        REQUIRE(server2.auths == 1U);
+
+        RESTClient::closeConnections();
+    }
+}
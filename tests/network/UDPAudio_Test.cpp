@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/udp/Socket.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+#include "bridge/PCMConvert.h"
+
+using namespace network::udp;
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t PCM_SAMPLES = 160U;
+const uint32_t PCM_DATAGRAM_LENGTH = (PCM_SAMPLES * 2U) + 12U;
+const uint32_t LDU_FRAMES = 9U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helper to find a free UDP port on the loopback address.
+ * @returns uint16_t Free port, or zero if none could be bound.
+ */
+static uint16_t freeAudioPort()
+{
+    int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0)
+        return 0U;
+
+    struct sockaddr_in addr;
+    ::memset(&addr, 0x00U, sizeof(struct sockaddr_in));
+    addr.sin_family = AF_INET;
+    addr.sin_port = 0U;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    socklen_t addrLen = sizeof(struct sockaddr_in);
+    uint16_t port = 0U;
+    if (::bind(fd, (struct sockaddr*)&addr, addrLen) == 0 && ::getsockname(fd, (struct sockaddr*)&addr, &addrLen) == 0)
+        port = ntohs(addr.sin_port);
+
+    ::close(fd);
+    return port;
+}
+
+/**
+ * @brief Helper to build a UDP audio datagram (4 bytes PCM length, PCM, dstId, srcId).
+ * @param[out] data Buffer to build the datagram in.
+ * @param seq Sequence number written as the source ID.
+ */
+static void buildDatagram(uint8_t* data, uint32_t seq)
+{
+    __SET_UINT32(PCM_SAMPLES * 2U, data, 0U);
+    for (uint32_t i = 0U; i < PCM_SAMPLES * 2U; i++)
+        data[4U + i] = (uint8_t)(seq + i);
+
+    __SET_UINT32(9999U, data, (PCM_SAMPLES * 2U) + 4U);
+    __SET_UINT32(seq, data, (PCM_SAMPLES * 2U) + 8U);
+}
+
+/**
+ * @brief Helper to send a LDU worth of UDP audio datagrams, with a single sendmmsg.
+ * @param socket Sending socket.
+ * @param data Buffer containing the datagrams (LDU_FRAMES * PCM_DATAGRAM_LENGTH).
+ * @param address Destination address.
+ * @param addrLen Length of destination address.
+ * @returns bool True, if the datagrams were sent, otherwise false.
+ */
+static bool writeBatch(Socket& socket, uint8_t* data, const sockaddr_storage& address, uint32_t addrLen)
+{
+    UDPDatagram datagrams[LDU_FRAMES];
+    BufferVector buffers;
+    for (uint32_t i = 0U; i < LDU_FRAMES; i++) {
+        datagrams[i].buffer = data + (i * PCM_DATAGRAM_LENGTH);
+        datagrams[i].length = PCM_DATAGRAM_LENGTH;
+        datagrams[i].address = address;
+        datagrams[i].addrLen = addrLen;
+        buffers.push_back(&datagrams[i]);
+    }
+
+    return socket.write(buffers);
+}
+
+TEST_CASE("UDPAudio", "[UDP Audio Test]") {
+    SECTION("PCM_Convert") {
+        std::mt19937 rng(0x50434DU);
+
+        uint8_t pcm[PCM_SAMPLES * 2U];
+        for (uint32_t i = 0U; i < PCM_SAMPLES * 2U; i++)
+            pcm[i] = (uint8_t)rng();
+
+        short samples[PCM_SAMPLES];
+        PCMConvert::toSamples(pcm, samples, PCM_SAMPLES);
+        for (uint32_t i = 0U; i < PCM_SAMPLES; i++)
+            REQUIRE(samples[i] == (short)((pcm[(i * 2U) + 1U] << 8) + pcm[i * 2U]));
+
+        uint8_t out[PCM_SAMPLES * 2U];
+        PCMConvert::toPCM(samples, out, PCM_SAMPLES);
+        REQUIRE(::memcmp(pcm, out, PCM_SAMPLES * 2U) == 0);
+    }
+
+    SECTION("PCM_Gain") {
+        short samples[6] = { 0, 1000, -1000, 20000, -20000, -32768 };
+
+        short scaled[6];
+        ::memcpy(scaled, samples, sizeof(samples));
+        PCMConvert::applyGain(scaled, 6U, 0.5f);
+        REQUIRE(scaled[1] == 500);
+        REQUIRE(scaled[2] == -500);
+        REQUIRE(scaled[5] == -16384);
+
+        // amplified samples are clipped
+        ::memcpy(scaled, samples, sizeof(samples));
+        PCMConvert::applyGain(scaled, 6U, 2.0f);
+        REQUIRE(scaled[0] == 0);
+        REQUIRE(scaled[1] == 2000);
+        REQUIRE(scaled[3] == 32767);
+        REQUIRE(scaled[4] == -32767);
+        REQUIRE(scaled[5] == -32767);
+
+        // unity gain leaves the samples untouched
+        ::memcpy(scaled, samples, sizeof(samples));
+        PCMConvert::applyGain(scaled, 6U, 1.0f);
+        REQUIRE(::memcmp(scaled, samples, sizeof(samples)) == 0);
+    }
+
+    SECTION("Batch_Read") {
+        uint16_t port = freeAudioPort();
+        REQUIRE(port != 0U);
+
+        Socket rx("127.0.0.1", port);
+        REQUIRE(rx.open());
+        Socket tx(0U);
+        REQUIRE(tx.open(AF_INET));
+
+        sockaddr_storage addr;
+        uint32_t addrLen = 0U;
+        REQUIRE(Socket::lookup("127.0.0.1", port, addr, addrLen) == 0);
+
+        std::vector<uint8_t> data(LDU_FRAMES * PCM_DATAGRAM_LENGTH);
+        for (uint32_t i = 0U; i < LDU_FRAMES; i++)
+            buildDatagram(data.data() + (i * PCM_DATAGRAM_LENGTH), i);
+        REQUIRE(writeBatch(tx, data.data(), addr, addrLen));
+
+        // nothing is read into more datagrams than were sent
+        uint8_t buffers[LDU_FRAMES + 4U][512U];
+        UDPDatagram datagrams[LDU_FRAMES + 4U];
+        for (uint32_t i = 0U; i < LDU_FRAMES + 4U; i++) {
+            datagrams[i].buffer = buffers[i];
+            datagrams[i].length = 512U;
+        }
+
+        int read = rx.read(datagrams, LDU_FRAMES + 4U);
+        REQUIRE(read == (int)LDU_FRAMES);
+        for (uint32_t i = 0U; i < LDU_FRAMES; i++) {
+            REQUIRE(datagrams[i].length == PCM_DATAGRAM_LENGTH);
+            REQUIRE(::memcmp(buffers[i], data.data() + (i * PCM_DATAGRAM_LENGTH), PCM_DATAGRAM_LENGTH) == 0);
+        }
+
+        // an empty socket doesn't block
+        REQUIRE(rx.read(datagrams, LDU_FRAMES) == 0);
+
+        rx.close();
+        tx.close();
+    }
+}
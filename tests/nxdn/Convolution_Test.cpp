@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/nxdn/NXDNDefines.h"
+#include "common/nxdn/NXDNUtils.h"
+#include "common/nxdn/channel/FACCH1.h"
+#include "common/nxdn/channel/SACCH.h"
+#include "common/nxdn/edac/Convolution.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace nxdn;
+using namespace nxdn::defines;
+
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+// long inbound CAC, the longest block decoded for every frame on a control channel
+const uint32_t CONV_BITS = 160U;
+const uint32_t CONV_SYMBOLS = (CONV_BITS + 4U) * 2U;
+
+const uint32_t RANDOM_BLOCKS = 5000U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helper to convolution encode a random payload (with the 4 zero flush bits) into soft symbols.
+ * @param rng Random number generator.
+ * @param[out] payload Payload bytes.
+ * @param[out] symbols Soft symbols (0 or 2).
+ */
+static void encodeRandom(std::mt19937& rng, uint8_t* payload, uint8_t* symbols)
+{
+    ::memset(payload, 0x00U, CONV_BITS / 8U + 1U);
+    for (uint32_t i = 0U; i < CONV_BITS - 4U; i++)
+        WRITE_BIT(payload, i, (rng() & 1U) != 0U);
+
+    uint8_t coded[(CONV_BITS * 2U) / 8U + 1U];
+    ::memset(coded, 0x00U, sizeof(coded));
+
+    nxdn::edac::Convolution conv;
+    conv.encode(payload, coded, CONV_BITS);
+
+    ::memset(symbols, 0x00U, CONV_SYMBOLS);
+    for (uint32_t i = 0U; i < CONV_BITS * 2U; i++)
+        symbols[i] = READ_BIT(coded, i) ? 2U : 0U;
+}
+
+/**
+ * @brief Helper to decode soft symbols a symbol pair at a time.
+ * @param[in] symbols Soft symbols.
+ * @param[out] out Decoded bits.
+ */
+static void decodeSymbols(const uint8_t* symbols, uint8_t* out)
+{
+    nxdn::edac::Convolution conv;
+    conv.start();
+    for (uint32_t i = 0U; i < CONV_BITS + 4U; i++)
+        conv.decode(symbols[i * 2U], symbols[i * 2U + 1U]);
+
+    conv.chainback(out, CONV_BITS);
+}
+
+TEST_CASE("NXDN Convolution", "[NXDN Convolution Test]") {
+    std::mt19937 rng(0x4E58444EU);
+
+    SECTION("Clean_Block") {
+        uint8_t payload[CONV_BITS / 8U + 1U];
+        uint8_t symbols[CONV_SYMBOLS];
+        encodeRandom(rng, payload, symbols);
+
+        uint8_t out[CONV_BITS / 8U + 1U];
+        ::memset(out, 0x00U, sizeof(out));
+
+        nxdn::edac::Convolution conv;
+        REQUIRE(conv.decode(symbols, out, CONV_BITS));
+        REQUIRE(::memcmp(payload, out, CONV_BITS / 8U) == 0);
+    }
+
+    SECTION("Block_Matches_Symbol_Decoder") {
+        // random bit errors and erasures, and completely random symbols
+        for (uint32_t n = 0U; n < RANDOM_BLOCKS; n++) {
+            uint8_t payload[CONV_BITS / 8U + 1U];
+            uint8_t symbols[CONV_SYMBOLS];
+            encodeRandom(rng, payload, symbols);
+
+            uint32_t errors = (n < RANDOM_BLOCKS / 2U) ? (rng() % 24U) : CONV_SYMBOLS;
+            for (uint32_t i = 0U; i < errors; i++)
+                symbols[rng() % (CONV_BITS * 2U)] = (uint8_t)(rng() % 3U);
+
+            uint8_t expected[CONV_BITS / 8U + 1U];
+            ::memset(expected, 0x00U, sizeof(expected));
+            decodeSymbols(symbols, expected);
+
+            uint8_t out[CONV_BITS / 8U + 1U];
+            ::memset(out, 0x00U, sizeof(out));
+
+            nxdn::edac::Convolution conv;
+            REQUIRE(conv.decode(symbols, out, CONV_BITS));
+            REQUIRE(::memcmp(expected, out, sizeof(out)) == 0);
+        }
+    }
+
+    SECTION("Corrects_Errors") {
+        uint8_t payload[CONV_BITS / 8U + 1U];
+        uint8_t symbols[CONV_SYMBOLS];
+        encodeRandom(rng, payload, symbols);
+
+        // isolated errors, well over the constraint length apart
+        for (uint32_t i = 10U; i < CONV_BITS * 2U; i += 40U)
+            symbols[i] = (symbols[i] == 0U) ? 2U : 0U;
+
+        uint8_t out[CONV_BITS / 8U + 1U];
+        ::memset(out, 0x00U, sizeof(out));
+
+        nxdn::edac::Convolution conv;
+        REQUIRE(conv.decode(symbols, out, CONV_BITS));
+        REQUIRE(::memcmp(payload, out, CONV_BITS / 8U) == 0);
+    }
+
+    SECTION("Too_Long") {
+        uint8_t symbols[700U];
+        ::memset(symbols, 0x00U, sizeof(symbols));
+        uint8_t out[40U];
+
+        nxdn::edac::Convolution conv;
+        REQUIRE_FALSE(conv.decode(symbols, out, 300U));
+    }
+
+    SECTION("Captured_SACCH") {
+        // voice frame captured from a radio (see AMBE_FEC_Test.cpp)
+        uint8_t testData[] = {
+            0xCDU, 0xF5U, 0x9DU, 0x5DU, 0xFCU, 0xFAU, 0x0AU, 0x6EU, 0x8AU, 0x23U, 0x56U, 0xE8U,
+            0x17U, 0x49U, 0xC6U, 0x58U, 0x89U, 0x30U, 0x1AU, 0xA5U, 0xF5U, 0xACU, 0x5AU, 0x6EU, 0xF8U, 0x09U, 0x3CU, 0x48U,
+            0x0FU, 0x4FU, 0xFDU, 0xCFU, 0x80U, 0xD5U, 0x77U, 0x0CU, 0xFEU, 0xE9U, 0x05U, 0xCEU, 0xE6U, 0x20U, 0xDFU, 0xFFU,
+            0x18U, 0x9CU, 0x2DU, 0xA9U
+        };
+
+        NXDNUtils::scrambler(testData);
+
+        channel::SACCH sacch;
+        REQUIRE(sacch.decode(testData));
+        REQUIRE(sacch.getRAN() == 1U);
+        REQUIRE(sacch.getStructure() == ChStructure::SR_1_4);
+
+        uint8_t expected[NXDN_SACCH_CRC_LENGTH_BYTES];
+        ::memset(expected, 0x00U, NXDN_SACCH_CRC_LENGTH_BYTES);
+        sacch.getData(expected);
+
+        // a single bit error in the SACCH is corrected
+        uint32_t n = NXDN_FSW_LENGTH_BITS + NXDN_LICH_LENGTH_BITS + 17U;
+        WRITE_BIT(testData, n, !READ_BIT(testData, n));
+
+        channel::SACCH corrected;
+        REQUIRE(corrected.decode(testData));
+
+        uint8_t data[NXDN_SACCH_CRC_LENGTH_BYTES];
+        ::memset(data, 0x00U, NXDN_SACCH_CRC_LENGTH_BYTES);
+        corrected.getData(data);
+        REQUIRE(::memcmp(expected, data, NXDN_SACCH_CRC_LENGTH_BYTES) == 0);
+    }
+
+    SECTION("FACCH1_Round_Trip") {
+        uint8_t payload[NXDN_FACCH1_LENGTH_BITS / 8U];
+        for (uint32_t i = 0U; i < NXDN_FACCH1_LENGTH_BITS / 8U; i++)
+            payload[i] = (uint8_t)rng();
+
+        channel::FACCH1 facch;
+        facch.setData(payload);
+
+        uint8_t frame[NXDN_FRAME_LENGTH_BYTES];
+        ::memset(frame, 0x00U, NXDN_FRAME_LENGTH_BYTES);
+        facch.encode(frame, NXDN_FSW_LENGTH_BITS + NXDN_LICH_LENGTH_BITS + NXDN_SACCH_FEC_LENGTH_BITS);
+
+        uint32_t n = NXDN_FSW_LENGTH_BITS + NXDN_LICH_LENGTH_BITS + NXDN_SACCH_FEC_LENGTH_BITS + 33U;
+        WRITE_BIT(frame, n, !READ_BIT(frame, n));
+
+        channel::FACCH1 decoded;
+        REQUIRE(decoded.decode(frame, NXDN_FSW_LENGTH_BITS + NXDN_LICH_LENGTH_BITS + NXDN_SACCH_FEC_LENGTH_BITS));
+
+        uint8_t data[NXDN_FACCH1_LENGTH_BITS / 8U];
+        decoded.getData(data);
+        REQUIRE(::memcmp(payload, data, NXDN_FACCH1_LENGTH_BITS / 8U) == 0);
+    }
+}
@@ -0,0 +1,220 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/p25/P25Defines.h"
+#include "common/p25/P25Utils.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace p25;
+using namespace p25::defines;
+
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t P25UTILS_TEST_BYTES = 128U;
+const uint32_t P25UTILS_MAX_START = 220U;
+const uint32_t P25UTILS_MAX_LENGTH = 400U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Reference bit at a time status symbol decode.
+ * @param[in] in Input buffer.
+ * @param[out] out Output buffer.
+ * @param start Start bit offset.
+ * @param stop Stop bit offset.
+ * @returns uint32_t Count of data bits.
+ */
+static uint32_t referenceDecode(const uint8_t* in, uint8_t* out, uint32_t start, uint32_t stop)
+{
+    uint32_t ss0Pos = P25_SS0_START;
+    uint32_t ss1Pos = P25_SS1_START;
+    while (ss0Pos < start) {
+        ss0Pos += P25_SS_INCREMENT;
+        ss1Pos += P25_SS_INCREMENT;
+    }
+
+    uint32_t n = 0U;
+    for (uint32_t i = start; i < stop; i++) {
+        if (i == ss0Pos) {
+            ss0Pos += P25_SS_INCREMENT;
+        }
+        else if (i == ss1Pos) {
+            ss1Pos += P25_SS_INCREMENT;
+        }
+        else {
+            bool b = READ_BIT(in, i);
+            WRITE_BIT(out, n, b);
+            n++;
+        }
+    }
+
+    return n;
+}
+
+/**
+ * @brief Reference bit at a time status symbol encode.
+ * @param[in] in Input buffer.
+ * @param[out] out Output buffer.
+ * @param start Start bit offset.
+ * @param stop Stop bit offset.
+ * @returns uint32_t Count of data bits.
+ */
+static uint32_t referenceEncode(const uint8_t* in, uint8_t* out, uint32_t start, uint32_t stop)
+{
+    uint32_t ss0Pos = P25_SS0_START;
+    uint32_t ss1Pos = P25_SS1_START;
+    while (ss0Pos < start) {
+        ss0Pos += P25_SS_INCREMENT;
+        ss1Pos += P25_SS_INCREMENT;
+    }
+
+    uint32_t n = 0U;
+    for (uint32_t i = start; i < stop; i++) {
+        if (i == ss0Pos) {
+            ss0Pos += P25_SS_INCREMENT;
+        }
+        else if (i == ss1Pos) {
+            ss1Pos += P25_SS_INCREMENT;
+        }
+        else {
+            bool b = READ_BIT(in, n);
+            WRITE_BIT(out, i, b);
+            n++;
+        }
+    }
+
+    return n;
+}
+
+/**
+ * @brief Reference bit at a time status symbol encode for a given length.
+ * @param[in] in Input buffer.
+ * @param[out] out Output buffer.
+ * @param length Count of data bits.
+ * @returns uint32_t Bit offset after the last data bit.
+ */
+static uint32_t referenceEncode(const uint8_t* in, uint8_t* out, uint32_t length)
+{
+    uint32_t ss0Pos = P25_SS0_START;
+    uint32_t ss1Pos = P25_SS1_START;
+
+    uint32_t n = 0U;
+    uint32_t pos = 0U;
+    while (n < length) {
+        if (pos == ss0Pos) {
+            ss0Pos += P25_SS_INCREMENT;
+        }
+        else if (pos == ss1Pos) {
+            ss1Pos += P25_SS_INCREMENT;
+        }
+        else {
+            bool b = READ_BIT(in, n);
+            WRITE_BIT(out, pos, b);
+            n++;
+        }
+        pos++;
+    }
+
+    return pos;
+}
+
+/**
+ * @brief Helper to fill a buffer with random bytes.
+ * @param rng Random number generator.
+ * @param[out] data Buffer to fill.
+ * @param len Length of buffer.
+ */
+static void fillRandom(std::mt19937& rng, uint8_t* data, uint32_t len)
+{
+    for (uint32_t i = 0U; i < len; i++)
+        data[i] = (uint8_t)rng();
+}
+
+TEST_CASE("P25Utils", "[Status Symbol Test]") {
+    std::mt19937 rng(25U);
+
+    SECTION("Decode_Test") {
+        INFO("P25Utils Decode Equivalence Test");
+
+        bool failed = false;
+        for (uint32_t start = 0U; start < P25UTILS_MAX_START && !failed; start++) {
+            for (uint32_t stop = start; stop <= start + P25UTILS_MAX_LENGTH; stop++) {
+                uint8_t in[P25UTILS_TEST_BYTES], expected[P25UTILS_TEST_BYTES], out[P25UTILS_TEST_BYTES];
+                fillRandom(rng, in, P25UTILS_TEST_BYTES);
+                fillRandom(rng, out, P25UTILS_TEST_BYTES);
+                ::memcpy(expected, out, P25UTILS_TEST_BYTES);
+
+                uint32_t n1 = referenceDecode(in, expected, start, stop);
+                uint32_t n2 = P25Utils::decode(in, out, start, stop);
+                if (n1 != n2 || ::memcmp(expected, out, P25UTILS_TEST_BYTES) != 0) {
+                    ::LogDebug("T", "Decode_Test, mismatch at start %u, stop %u", start, stop);
+                    failed = true;
+                    break;
+                }
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Encode_Test") {
+        INFO("P25Utils Encode Equivalence Test");
+
+        bool failed = false;
+        for (uint32_t start = 0U; start < P25UTILS_MAX_START && !failed; start++) {
+            for (uint32_t stop = start; stop <= start + P25UTILS_MAX_LENGTH; stop++) {
+                uint8_t in[P25UTILS_TEST_BYTES], expected[P25UTILS_TEST_BYTES], out[P25UTILS_TEST_BYTES];
+                fillRandom(rng, in, P25UTILS_TEST_BYTES);
+                fillRandom(rng, out, P25UTILS_TEST_BYTES);
+                ::memcpy(expected, out, P25UTILS_TEST_BYTES);
+
+                uint32_t n1 = referenceEncode(in, expected, start, stop);
+                uint32_t n2 = P25Utils::encode(in, out, start, stop);
+                if (n1 != n2 || ::memcmp(expected, out, P25UTILS_TEST_BYTES) != 0) {
+                    ::LogDebug("T", "Encode_Test, mismatch at start %u, stop %u", start, stop);
+                    failed = true;
+                    break;
+                }
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Encode_Length_Test") {
+        INFO("P25Utils Encode Length Equivalence Test");
+
+        bool failed = false;
+        for (uint32_t length = 0U; length <= P25UTILS_MAX_LENGTH * 2U; length++) {
+            uint8_t in[P25UTILS_TEST_BYTES], expected[P25UTILS_TEST_BYTES], out[P25UTILS_TEST_BYTES];
+            fillRandom(rng, in, P25UTILS_TEST_BYTES);
+            fillRandom(rng, out, P25UTILS_TEST_BYTES);
+            ::memcpy(expected, out, P25UTILS_TEST_BYTES);
+
+            uint32_t pos1 = referenceEncode(in, expected, length);
+            uint32_t pos2 = P25Utils::encode(in, out, length);
+            if (pos1 != pos2 || ::memcmp(expected, out, P25UTILS_TEST_BYTES) != 0) {
+                ::LogDebug("T", "Encode_Length_Test, mismatch at length %u", length);
+                failed = true;
+                break;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+}
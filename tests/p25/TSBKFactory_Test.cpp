@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/p25/P25Defines.h"
+#include "common/p25/lc/tsbk/TSBKFactory.h"
+#include "common/p25/Sync.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace p25;
+using namespace p25::defines;
+using namespace p25::lc;
+using namespace p25::lc::tsbk;
+
+#include <catch2/catch_test_macros.hpp>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helper to encode a TSBK into a single block TSDU frame.
+ * @param tsbk Instance of a TSBK.
+ * @param[out] data TSDU frame.
+ */
+static void encodeTSDU(TSBK& tsbk, uint8_t* data)
+{
+    ::memset(data, 0x00U, P25_TSDU_FRAME_LENGTH_BYTES);
+    Sync::addP25Sync(data);
+
+    tsbk.setLastBlock(true);
+    tsbk.encode(data);
+}
+
+TEST_CASE("TSBKFactory", "[P25 TSBK Factory Test]") {
+    uint8_t grpVch[P25_TSDU_FRAME_LENGTH_BYTES];
+    {
+        IOSP_GRP_VCH tsbk;
+        tsbk.setSrcId(1234U);
+        tsbk.setDstId(9999U);
+        tsbk.setGrpVchNo(0x123U);
+        tsbk.setEmergency(true);
+        encodeTSDU(tsbk, grpVch);
+    }
+
+    uint8_t uReg[P25_TSDU_FRAME_LENGTH_BYTES];
+    {
+        IOSP_U_REG tsbk;
+        tsbk.setSrcId(5678U);
+        tsbk.setDstId(5678U);
+        encodeTSDU(tsbk, uReg);
+    }
+
+    SECTION("Matches_CreateTSBK") {
+        std::unique_ptr<TSBK> created = TSBKFactory::createTSBK(grpVch);
+        REQUIRE(created != nullptr);
+
+        TSBKStorage storage;
+        TSBK* decoded = TSBKFactory::decodeTSBK(grpVch, storage);
+        REQUIRE(decoded != nullptr);
+        REQUIRE(decoded == storage.get());
+        REQUIRE(dynamic_cast<IOSP_GRP_VCH*>(decoded) != nullptr);
+
+        REQUIRE(decoded->getLCO() == created->getLCO());
+        REQUIRE(decoded->getLCO() == TSBKO::IOSP_GRP_VCH);
+        REQUIRE(decoded->getSrcId() == 1234U);
+        REQUIRE(decoded->getDstId() == 9999U);
+        REQUIRE(decoded->getGrpVchNo() == created->getGrpVchNo());
+        REQUIRE(decoded->getEmergency());
+
+        REQUIRE(decoded->getDecodedRaw() != nullptr);
+        REQUIRE(::memcmp(decoded->getDecodedRaw(), created->getDecodedRaw(), P25_TSBK_LENGTH_BYTES) == 0);
+    }
+
+    SECTION("Storage_Reuse") {
+        TSBKStorage storage;
+        REQUIRE(storage.get() == nullptr);
+
+        TSBK* decoded = TSBKFactory::decodeTSBK(grpVch, storage);
+        REQUIRE(dynamic_cast<IOSP_GRP_VCH*>(decoded) != nullptr);
+
+        // decoding again replaces the held TSBK, of a different type
+        decoded = TSBKFactory::decodeTSBK(uReg, storage);
+        REQUIRE(dynamic_cast<IOSP_U_REG*>(decoded) != nullptr);
+        REQUIRE(decoded->getSrcId() == 5678U);
+
+        storage.reset();
+        REQUIRE(storage.get() == nullptr);
+    }
+
+    SECTION("Corrupt_Frame") {
+        uint8_t data[P25_TSDU_FRAME_LENGTH_BYTES];
+        ::memcpy(data, grpVch, P25_TSDU_FRAME_LENGTH_BYTES);
+        for (uint32_t i = P25_PREAMBLE_LENGTH_BYTES; i < P25_TSDU_FRAME_LENGTH_BYTES; i++)
+            data[i] ^= 0x5AU;
+
+        // a failed decode leaves the storage empty
+        TSBKStorage storage;
+        REQUIRE(TSBKFactory::decodeTSBK(data, storage) == nullptr);
+        REQUIRE(storage.get() == nullptr);
+    }
+
+    SECTION("Raw_TSBK") {
+        TSBKStorage storage;
+        TSBK* decoded = TSBKFactory::decodeTSBK(grpVch, storage);
+        REQUIRE(decoded != nullptr);
+
+        uint8_t raw[P25_TSBK_LENGTH_BYTES];
+        ::memcpy(raw, decoded->getDecodedRaw(), P25_TSBK_LENGTH_BYTES);
+
+        TSBKStorage rawStorage;
+        TSBK* rawDecoded = TSBKFactory::decodeTSBK(raw, rawStorage, true);
+        REQUIRE(rawDecoded != nullptr);
+        REQUIRE(rawDecoded->getDstId() == 9999U);
+        REQUIRE(::memcmp(rawDecoded->getDecodedRaw(), raw, P25_TSBK_LENGTH_BYTES) == 0);
+    }
+
+    SECTION("Not_Decoded") {
+        // a created TSBK has no decoded raw bytes
+        IOSP_GRP_VCH tsbk;
+        REQUIRE(tsbk.getDecodedRaw() == nullptr);
+    }
+}
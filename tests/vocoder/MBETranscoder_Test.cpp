@@ -0,0 +1,251 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/Log.h"
+#include "common/Thread.h"
+#include "common/Utils.h"
+#include "vocoder/MBETranscoder.h"
+#include "vocoder/VocoderPool.h"
+
+using namespace vocoder;
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const double TRANSCODE_PI = 3.14159265358979323846;
+
+const uint32_t TRANSCODE_FRAMES = 100U;
+const uint32_t TRANSCODE_WARMUP = 5U;
+const uint32_t TRANSCODE_DEPTH = 18U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helper to generate 8kHz PCM frames of a voiced sound, with a gliding pitch.
+ * @param frames Number of frames.
+ * @returns std::vector<int16_t> PCM samples.
+ */
+static std::vector<int16_t> voiced(uint32_t frames)
+{
+    std::vector<int16_t> samples(frames * 160U);
+
+    double phase = 0.0;
+    for (uint32_t i = 0U; i < samples.size(); i++) {
+        double f0 = 120.0 + 40.0 * ::sin(2.0 * TRANSCODE_PI * 0.5 * i / 8000.0);
+        phase += 2.0 * TRANSCODE_PI * f0 / 8000.0;
+
+        double sample = 0.0;
+        for (uint32_t k = 1U; k * f0 < 3600.0; k++)
+            sample += ::sin(k * phase) / k;
+
+        samples[i] = (int16_t)::lrint(4000.0 * sample);
+    }
+
+    return samples;
+}
+
+/**
+ * @brief Helper to calculate the mean log2 spectral amplitude of MBE model parameters.
+ * @param params MBE model parameters.
+ * @returns double Mean log2 spectral amplitude.
+ */
+static double logGain(const IMBE_PARAM& params)
+{
+    double gain = 0.0;
+    for (int i = 0; i < params.num_harms; i++)
+        gain += ::log2((params.sa[i] < 1) ? 1.0 : (double)params.sa[i]);
+
+    return gain / params.num_harms;
+}
+
+/**
+ * @brief Helper to transcode a voiced sound, and measure how far the model parameters of the
+ *  output stray from those of the input.
+ * @param inputMode Input mode.
+ * @param outputMode Output mode.
+ * @param mode Transcoding mode.
+ * @param[out] pitchErr Mean absolute pitch error (samples).
+ * @param[out] gainErr Mean absolute log2 gain error.
+ * @returns uint32_t Number of frames transcoded at the parameter level.
+ */
+static uint32_t transcodeError(MBE_DECODER_MODE inputMode, MBE_ENCODER_MODE outputMode, MBE_TRANSCODE_MODE mode,
+    double& pitchErr, double& gainErr)
+{
+    std::vector<int16_t> samples = voiced(TRANSCODE_FRAMES);
+
+    MBEEncoder encoder((inputMode == DECODE_DMR_AMBE) ? ENCODE_DMR_AMBE : ENCODE_88BIT_IMBE);
+    MBETranscoder transcoder(inputMode, outputMode, mode);
+    MBEDecoder inputDecoder(inputMode);
+    MBEDecoder outputDecoder((outputMode == ENCODE_DMR_AMBE) ? DECODE_DMR_AMBE : DECODE_88BIT_IMBE);
+
+    pitchErr = gainErr = 0.0;
+    uint32_t count = 0U;
+    for (uint32_t n = 0U; n < TRANSCODE_FRAMES; n++) {
+        uint8_t input[11U], output[11U];
+        ::memset(input, 0x00U, 11U);
+        encoder.encode(samples.data() + (n * 160U), input);
+        transcoder.transcode(input, output);
+
+        IMBE_PARAM in, out;
+        int32_t inErrs = inputDecoder.decodeParams(input, &in);
+        int32_t outErrs = outputDecoder.decodeParams(output, &out);
+        REQUIRE(inErrs == 0);
+        REQUIRE(outErrs == 0);
+
+        if (n < TRANSCODE_WARMUP)
+            continue;
+
+        pitchErr += ::fabs(out.ref_pitch - in.ref_pitch) / 256.0;
+        gainErr += ::fabs(logGain(out) - logGain(in));
+        count++;
+    }
+
+    pitchErr /= count;
+    gainErr /= count;
+    return transcoder.getParametricFrames();
+}
+
+TEST_CASE("MBETranscoder", "[Vocoder Transcoder Test]") {
+    SECTION("Parametric_Fidelity") {
+        const MBE_DECODER_MODE inputs[] = { DECODE_88BIT_IMBE, DECODE_DMR_AMBE };
+        const MBE_ENCODER_MODE outputs[] = { ENCODE_DMR_AMBE, ENCODE_88BIT_IMBE };
+        for (uint32_t i = 0U; i < 2U; i++) {
+            INFO("direction " << i);
+
+            // mapping the model parameters directly keeps closer to the input than re-analysing
+            // synthesized speech
+            double paramPitch, paramGain, pcmPitch, pcmGain;
+            REQUIRE(transcodeError(inputs[i], outputs[i], TRANSCODE_PARAMETRIC, paramPitch, paramGain) == TRANSCODE_FRAMES);
+            REQUIRE(transcodeError(inputs[i], outputs[i], TRANSCODE_PCM, pcmPitch, pcmGain) == 0U);
+
+            REQUIRE(paramPitch < 1.0);
+            REQUIRE(paramGain < 0.5);
+            REQUIRE(paramPitch < pcmPitch);
+            REQUIRE(paramGain < pcmGain);
+        }
+    }
+
+    SECTION("PCM_Fallback") {
+        MBEEncoder encoder(ENCODE_DMR_AMBE);
+        MBETranscoder transcoder(DECODE_DMR_AMBE, ENCODE_88BIT_IMBE);
+
+        std::vector<int16_t> samples = voiced(1U);
+        uint8_t codeword[11U], output[11U];
+        encoder.encode(samples.data(), codeword);
+        transcoder.transcode(codeword, output);
+
+        // an erasure frame (b0 = 120) carries no speech parameters
+        uint8_t bits[72U];
+        ::memset(bits, 0x00U, 72U);
+        bits[0U] = bits[1U] = bits[2U] = bits[3U] = 1U;
+        encoder.encodeBits(bits, codeword);
+        transcoder.transcode(codeword, output);
+
+        REQUIRE(transcoder.getParametricFrames() == 1U);
+        REQUIRE(transcoder.getPCMFrames() == 1U);
+    }
+
+    SECTION("Mixed_Fallback_State") {
+        std::vector<int16_t> samples = voiced(11U);
+        MBEEncoder encoder(ENCODE_88BIT_IMBE);
+
+        uint8_t codewords[11U][11U];
+        for (uint32_t n = 0U; n < 11U; n++)
+            encoder.encode(samples.data() + (n * 160U), codewords[n]);
+
+        // a frame with an invalid fundamental frequency carries no speech parameters
+        uint8_t invalid[11U];
+        ::memset(invalid, 0xFFU, 11U);
+
+        // one decoder takes the parametric path (as the transcoder does), the other only decodes PCM
+        MBEDecoder paramDecoder(DECODE_88BIT_IMBE);
+        MBEDecoder pcmDecoder(DECODE_88BIT_IMBE);
+
+        IMBE_PARAM params;
+        int16_t paramPCM[160U], pcm[160U];
+        for (uint32_t n = 0U; n < 10U; n++) {
+            REQUIRE(paramDecoder.decodeParams(codewords[n], &params) == 0);
+            pcmDecoder.decode(codewords[n], pcm);
+        }
+
+        // the PCM fallback repeats the last parametric frame, rather than the initial (silent) state
+        for (uint32_t n = 0U; n < 3U; n++) {
+            paramDecoder.decode(invalid, paramPCM);
+            pcmDecoder.decode(invalid, pcm);
+
+            double paramLevel = 0.0, level = 0.0;
+            for (uint32_t i = 0U; i < 160U; i++) {
+                paramLevel += ::fabs((double)paramPCM[i]);
+                level += ::fabs((double)pcm[i]);
+            }
+
+            REQUIRE(level > 0.0);
+            REQUIRE(::fabs(paramLevel - level) < (0.25 * level));
+        }
+
+        // once the PCM decoder mutes and starts over, the parametric decoder starts over with it
+        for (uint32_t n = 0U; n < 2U; n++)
+            paramDecoder.decode(invalid, paramPCM);
+
+        MBEDecoder freshDecoder(DECODE_88BIT_IMBE);
+
+        IMBE_PARAM expected;
+        REQUIRE(paramDecoder.decodeParams(codewords[10U], &params) == 0);
+        REQUIRE(freshDecoder.decodeParams(codewords[10U], &expected) == 0);
+        REQUIRE(params.num_harms == expected.num_harms);
+        REQUIRE(::memcmp(params.sa, expected.sa, expected.num_harms * sizeof(Word16)) == 0);
+    }
+
+    SECTION("Pool_Transcode") {
+        std::vector<int16_t> samples = voiced(18U);
+        MBEEncoder encoder(ENCODE_DMR_AMBE);
+        MBETranscoder transcoder(DECODE_DMR_AMBE, ENCODE_88BIT_IMBE);
+
+        std::vector<uint8_t> ambe(18U * 9U), imbe(18U * 11U);
+        for (uint32_t n = 0U; n < 18U; n++) {
+            encoder.encode(samples.data() + (n * 160U), ambe.data() + (n * 9U));
+            transcoder.transcode(ambe.data() + (n * 9U), imbe.data() + (n * 11U));
+        }
+
+        VocoderPool pool(1U, 2U, TRANSCODE_DEPTH);
+        REQUIRE(pool.start());
+        int32_t stream = pool.openTranscoder(DECODE_DMR_AMBE, ENCODE_88BIT_IMBE);
+        REQUIRE(stream >= 0);
+
+        // pooled results match a dedicated transcoder, in order
+        for (uint32_t n = 0U; n < 18U; n++)
+            REQUIRE(pool.transcode(stream, ambe.data() + (n * 9U), 9U, n));
+
+        for (uint32_t n = 0U; n < 18U; n++) {
+            VocoderFrame* frame = nullptr;
+            for (uint32_t i = 0U; i < 10000U && frame == nullptr; i++) {
+                frame = pool.front(stream);
+                if (frame == nullptr)
+                    Thread::sleep(0U, 100U);
+            }
+
+            REQUIRE(frame != nullptr);
+            REQUIRE(frame->op == VOCODER_TRANSCODE);
+            REQUIRE(frame->tag == n);
+            REQUIRE(::memcmp(frame->codeword, imbe.data() + (n * 11U), 11U) == 0);
+            pool.pop(stream);
+        }
+
+        pool.stop();
+    }
+}
@@ -0,0 +1,225 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/Log.h"
+#include "common/Thread.h"
+#include "common/Utils.h"
+#include "vocoder/VocoderPool.h"
+
+using namespace vocoder;
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const double TEST_PI = 3.14159265358979323846;
+
+const uint32_t IMBE_LENGTH = 11U;
+const uint32_t TEST_FRAMES = 45U;
+const uint32_t TEST_STREAMS = 4U;
+const uint32_t TEST_DEPTH = 16U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Helper to generate 8kHz PCM frames of a tone.
+ * @param freq Tone frequency (Hz).
+ * @param frames Number of frames.
+ * @returns std::vector<int16_t> PCM samples.
+ */
+static std::vector<int16_t> tone(double freq, uint32_t frames)
+{
+    std::vector<int16_t> samples(frames * VOCODER_SAMPLES_LENGTH);
+    for (uint32_t i = 0U; i < samples.size(); i++)
+        samples[i] = (int16_t)::lrint(8000.0 * ::sin(2.0 * TEST_PI * freq * i / 8000.0));
+
+    return samples;
+}
+
+/**
+ * @brief Helper to encode PCM frames to IMBE codewords, with a dedicated encoder.
+ * @param samples PCM samples.
+ * @returns std::vector<uint8_t> IMBE codewords.
+ */
+static std::vector<uint8_t> encodeDirect(std::vector<int16_t> samples)
+{
+    MBEEncoder encoder(ENCODE_88BIT_IMBE);
+    encoder.setGainAdjust(1.0f);
+
+    uint32_t frames = samples.size() / VOCODER_SAMPLES_LENGTH;
+    std::vector<uint8_t> codewords(frames * IMBE_LENGTH);
+    for (uint32_t n = 0U; n < frames; n++)
+        encoder.encode(samples.data() + (n * VOCODER_SAMPLES_LENGTH), codewords.data() + (n * IMBE_LENGTH));
+
+    return codewords;
+}
+
+/**
+ * @brief Helper to decode IMBE codewords to PCM frames, with a dedicated decoder.
+ * @param codewords IMBE codewords.
+ * @returns std::vector<int16_t> PCM samples.
+ */
+static std::vector<int16_t> decodeDirect(std::vector<uint8_t> codewords)
+{
+    MBEDecoder decoder(DECODE_88BIT_IMBE);
+
+    uint32_t frames = codewords.size() / IMBE_LENGTH;
+    std::vector<int16_t> samples(frames * VOCODER_SAMPLES_LENGTH);
+    for (uint32_t n = 0U; n < frames; n++)
+        decoder.decode(codewords.data() + (n * IMBE_LENGTH), samples.data() + (n * VOCODER_SAMPLES_LENGTH));
+
+    return samples;
+}
+
+/**
+ * @brief Helper to wait for the next processed frame of a stream.
+ * @param pool Instance of the VocoderPool class.
+ * @param stream Stream handle.
+ * @returns VocoderFrame* Processed frame, or nullptr if none arrived within a second.
+ */
+static VocoderFrame* waitFront(VocoderPool& pool, int32_t stream)
+{
+    for (uint32_t i = 0U; i < 10000U; i++) {
+        VocoderFrame* frame = pool.front(stream);
+        if (frame != nullptr)
+            return frame;
+
+        Thread::sleep(0U, 100U);
+    }
+
+    return nullptr;
+}
+
+TEST_CASE("VocoderPool", "[Vocoder Pool Test]") {
+    SECTION("Open_Close") {
+        VocoderPool pool(2U, TEST_STREAMS, TEST_DEPTH);
+
+        int32_t streams[TEST_STREAMS];
+        for (uint32_t i = 0U; i < TEST_STREAMS; i++) {
+            streams[i] = pool.open(DECODE_88BIT_IMBE, ENCODE_88BIT_IMBE);
+            REQUIRE(streams[i] == (int32_t)i);
+        }
+
+        // all streams are in use
+        REQUIRE(pool.open(DECODE_DMR_AMBE, ENCODE_DMR_AMBE) == -1);
+
+        pool.close(streams[2U]);
+        REQUIRE(pool.open(DECODE_DMR_AMBE, ENCODE_DMR_AMBE) == streams[2U]);
+
+        // a full input queue is reported, not grown
+        uint8_t codeword[IMBE_LENGTH] = { 0U };
+        for (uint32_t i = 0U; i < TEST_DEPTH; i++)
+            REQUIRE(pool.decode(streams[0U], codeword, IMBE_LENGTH));
+        REQUIRE(!pool.decode(streams[0U], codeword, IMBE_LENGTH));
+    }
+
+    SECTION("Decode_Encode") {
+        // unvoiced bands are synthesized with rand(), so both decodes start from the same seed
+        std::vector<int16_t> samples = tone(1000.0, TEST_FRAMES);
+        std::vector<uint8_t> codewords = encodeDirect(samples);
+        ::srand(1U);
+        std::vector<int16_t> decoded = decodeDirect(codewords);
+        ::srand(1U);
+
+        VocoderPool pool(1U, 1U, TEST_DEPTH);
+        REQUIRE(pool.start());
+        int32_t stream = pool.open(DECODE_88BIT_IMBE, ENCODE_88BIT_IMBE);
+        REQUIRE(stream >= 0);
+
+        // pooled results match a dedicated decoder and encoder, in order, with the caller tag
+        for (uint32_t n = 0U; n < TEST_FRAMES; n++) {
+            REQUIRE(pool.decode(stream, codewords.data() + (n * IMBE_LENGTH), IMBE_LENGTH, n));
+            REQUIRE(pool.encode(stream, samples.data() + (n * VOCODER_SAMPLES_LENGTH), n));
+
+            VocoderFrame* frame = waitFront(pool, stream);
+            REQUIRE(frame != nullptr);
+            REQUIRE(frame->op == VOCODER_DECODE);
+            REQUIRE(frame->tag == n);
+            REQUIRE(::memcmp(frame->samples, decoded.data() + (n * VOCODER_SAMPLES_LENGTH), sizeof(frame->samples)) == 0);
+            pool.pop(stream);
+
+            frame = waitFront(pool, stream);
+            REQUIRE(frame != nullptr);
+            REQUIRE(frame->op == VOCODER_ENCODE);
+            REQUIRE(frame->tag == n);
+            REQUIRE(::memcmp(frame->codeword, codewords.data() + (n * IMBE_LENGTH), IMBE_LENGTH) == 0);
+            pool.pop(stream);
+        }
+
+        REQUIRE(pool.getProcessed() == TEST_FRAMES * 2U);
+        pool.stop();
+    }
+
+    SECTION("Stream_Isolation") {
+        // each stream carries a different tone, interleaved a LDU at a time across fewer workers
+        // than streams; codec state must not leak between them (a LDU is decoded before the next
+        // is submitted, so rand() is consumed in the same order as the dedicated decoders)
+        std::vector<uint8_t> codewords[TEST_STREAMS];
+        std::vector<int16_t> decoded[TEST_STREAMS];
+        std::vector<MBEDecoder*> decoders;
+        for (uint32_t s = 0U; s < TEST_STREAMS; s++) {
+            codewords[s] = encodeDirect(tone(400.0 + (s * 350.0), TEST_FRAMES));
+            decoded[s].resize(TEST_FRAMES * VOCODER_SAMPLES_LENGTH);
+            decoders.push_back(new MBEDecoder(DECODE_88BIT_IMBE));
+        }
+
+        ::srand(2U);
+        for (uint32_t ldu = 0U; ldu < TEST_FRAMES / 9U; ldu++) {
+            for (uint32_t s = 0U; s < TEST_STREAMS; s++) {
+                for (uint32_t n = ldu * 9U; n < (ldu + 1U) * 9U; n++)
+                    decoders[s]->decode(codewords[s].data() + (n * IMBE_LENGTH), decoded[s].data() + (n * VOCODER_SAMPLES_LENGTH));
+            }
+        }
+
+        for (MBEDecoder* decoder : decoders)
+            delete decoder;
+
+        VocoderPool pool(2U, TEST_STREAMS, TEST_DEPTH);
+        REQUIRE(pool.start());
+
+        int32_t streams[TEST_STREAMS];
+        for (uint32_t s = 0U; s < TEST_STREAMS; s++)
+            streams[s] = pool.open(DECODE_88BIT_IMBE, ENCODE_88BIT_IMBE);
+
+        ::srand(2U);
+        for (uint32_t ldu = 0U; ldu < TEST_FRAMES / 9U; ldu++) {
+            for (uint32_t s = 0U; s < TEST_STREAMS; s++) {
+                // submit the LDU as a single batch
+                for (uint32_t i = 0U; i < 9U; i++) {
+                    VocoderFrame* frame = pool.reserve(streams[s], i);
+                    REQUIRE(frame != nullptr);
+                    frame->op = VOCODER_DECODE;
+                    frame->tag = (ldu * 9U) + i;
+                    ::memcpy(frame->codeword, codewords[s].data() + (((ldu * 9U) + i) * IMBE_LENGTH), IMBE_LENGTH);
+                }
+
+                pool.submit(streams[s], 9U);
+
+                for (uint32_t i = 0U; i < 9U; i++) {
+                    uint32_t n = (ldu * 9U) + i;
+                    VocoderFrame* frame = waitFront(pool, streams[s]);
+                    REQUIRE(frame != nullptr);
+                    REQUIRE(frame->tag == n);
+                    REQUIRE(::memcmp(frame->samples, decoded[s].data() + (n * VOCODER_SAMPLES_LENGTH), sizeof(frame->samples)) == 0);
+                    pool.pop(streams[s]);
+                }
+            }
+        }
+
+        pool.stop();
+    }
+}
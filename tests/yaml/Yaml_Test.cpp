@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/yaml/Yaml.h"
+
+using namespace yaml;
+using namespace yaml::impl;
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <string>
+
+TEST_CASE("Yaml", "[YAML Parser Test]") {
+    SECTION("Scalars") {
+        Node root;
+        REQUIRE(Parse(root, std::string(
+            "plain: hello world\n"
+            "number: 1234\n"
+            "negative: -42\n"
+            "real: 2.5\n"
+            "flag: true\n"
+            "single: 'quoted - text'\n"
+            "double: \"quoted: text\"\n")));
+
+        REQUIRE(root.isMap());
+        REQUIRE(root["plain"].as<std::string>() == "hello world");
+        REQUIRE(root["number"].as<uint32_t>() == 1234U);
+        REQUIRE(root["negative"].as<int32_t>() == -42);
+        REQUIRE(root["real"].as<double>() == 2.5);
+        REQUIRE(root["flag"].as<bool>());
+        REQUIRE(root["single"].as<std::string>() == "quoted - text");
+        REQUIRE(root["double"].as<std::string>() == "quoted: text");
+
+        // a missing key is None, and uses the default
+        REQUIRE(root["missing"].isNone());
+        REQUIRE(root["missing"].as<uint32_t>(7U) == 7U);
+    }
+
+    SECTION("Sequences") {
+        Node root;
+        REQUIRE(Parse(root, std::string(
+            "list:\n"
+            "  - 1\n"
+            "  - 2\n"
+            "  - name: three\n"
+            "    value: 3\n")));
+
+        REQUIRE(root["list"].isSequence());
+        REQUIRE(root["list"].size() == 3U);
+        REQUIRE(root["list"][0].as<uint32_t>() == 1U);
+        REQUIRE(root["list"][1].as<uint32_t>() == 2U);
+        REQUIRE(root["list"][2]["name"].as<std::string>() == "three");
+        REQUIRE(root["list"][2]["value"].as<uint32_t>() == 3U);
+    }
+
+    SECTION("Block_Scalars") {
+        Node root;
+        REQUIRE(Parse(root, std::string(
+            "literal: |\n"
+            "  line one\n"
+            "  line two\n"
+            "folded: >\n"
+            "  line one\n"
+            "  line two\n"
+            "after: value\n")));
+
+        REQUIRE(root["literal"].as<std::string>() == "line one\nline two\n");
+        REQUIRE(root["folded"].as<std::string>() == "line one line two\n");
+        REQUIRE(root["after"].as<std::string>() == "value");
+    }
+
+    SECTION("Empty_Block_Scalars") {
+        Node root;
+        REQUIRE(Parse(root, std::string(
+            "empty: |\n"
+            "list:\n"
+            "  - >\n"
+            "  - value\n"
+            "after: value\n")));
+
+        // an empty block scalar is a None node (and not an empty scalar)
+        REQUIRE(root["empty"].isNone());
+        REQUIRE(root["empty"].as<std::string>("def") == "def");
+
+        REQUIRE(root["list"].size() == 2U);
+        REQUIRE(root["list"][0].isNone());
+        REQUIRE(root["list"][1].as<std::string>() == "value");
+        REQUIRE(root["after"].as<std::string>() == "value");
+    }
+
+    SECTION("Number_Converter_Overflow") {
+        REQUIRE(StringConverter<uint16_t>::get("65535", 1U) == 65535U);
+        REQUIRE(StringConverter<uint16_t>::get("65536", 1U) == 1U);
+        REQUIRE(StringConverter<int16_t>::get("-32768", 1) == -32768);
+        REQUIRE(StringConverter<int16_t>::get("-32769", 1) == 1);
+        REQUIRE(StringConverter<int32_t>::get("2147483647", 1) == 2147483647);
+        REQUIRE(StringConverter<int32_t>::get("2147483648", 1) == 1);
+        REQUIRE(StringConverter<uint32_t>::get("4294967296", 1U) == 1U);
+
+        // out of range of the intermediate type (ERANGE)
+        REQUIRE(StringConverter<uint64_t>::get("18446744073709551615", 1U) == UINT64_MAX);
+        REQUIRE(StringConverter<uint64_t>::get("18446744073709551616", 1U) == 1U);
+        REQUIRE(StringConverter<int64_t>::get("9223372036854775808", 1) == 1);
+        REQUIRE(StringConverter<double>::get("1e999", 1.0) == 1.0);
+    }
+
+    SECTION("Number_Converter_Sign") {
+        REQUIRE(StringConverter<int32_t>::get("-1") == -1);
+        REQUIRE(StringConverter<int32_t>::get("+12") == 12);
+        REQUIRE(StringConverter<double>::get("-0.5") == -0.5);
+
+        // negative values are wrapped for unsigned types, as operator>> does
+        REQUIRE(StringConverter<uint16_t>::get("-1", 1U) == 65535U);
+        REQUIRE(StringConverter<uint32_t>::get("-1", 1U) == 4294967295U);
+        REQUIRE(StringConverter<uint32_t>::get("-4294967296", 1U) == 1U);
+    }
+
+    SECTION("Number_Converter_Hex") {
+        // values are decimal; a hexadecimal value reads as the leading zero, as operator>> does
+        REQUIRE(StringConverter<uint32_t>::get("0x10", 1U) == 0U);
+        REQUIRE(StringConverter<int32_t>::get("0x10", 1) == 0);
+        REQUIRE(StringConverter<double>::get("0x10", 1.0) == 0.0);
+        REQUIRE(StringConverter<uint32_t>::get("010", 1U) == 10U);
+    }
+
+    SECTION("Number_Converter_Invalid") {
+        REQUIRE(StringConverter<uint32_t>::get("", 5U) == 5U);
+        REQUIRE(StringConverter<uint32_t>::get("abc", 5U) == 5U);
+        REQUIRE(StringConverter<double>::get("", 5.0) == 5.0);
+        REQUIRE(StringConverter<uint32_t>::get("") == 0U);
+
+        // leading whitespace is skipped and trailing characters are ignored
+        REQUIRE(StringConverter<uint32_t>::get("  42", 5U) == 42U);
+        REQUIRE(StringConverter<uint32_t>::get("42abc", 5U) == 42U);
+        REQUIRE(StringConverter<double>::get("1.5s", 5.0) == 1.5);
+    }
+}
@@ -0,0 +1,166 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+Name: DVM Benchmark Comparison
+Date Created: 2024
+
+This script reads the XML report of a dvmbench run, and prints the throughput (ops/s) of
+each benchmark. The results can be saved as a JSON baseline (one per release and machine),
+and a later run compared against a baseline; benchmarks that have slowed down by more than
+the threshold are reported as regressions, and the script exits with a non-zero status.
+
+Example usages:
+
+1. Run the benchmarks and save the results as a baseline:
+
+`dvmbench -r xml -o bench.xml`
+`python bench_compare.py bench.xml -s baseline-x86_64.json`
+
+2. Compare a later run against the baseline, failing on a slowdown of more than 10%:
+
+`python bench_compare.py bench.xml -b baseline-x86_64.json -t 10`
+"""
+import argparse
+import json
+import platform
+import sys
+import xml.etree.ElementTree as ET
+from pathlib import Path
+from typing import Dict
+
+
+def parse_arguments() -> argparse.Namespace:
+    """
+    parse command line arguments
+
+    :return: parsed arguments in an argparse namespace object
+    """
+    parser = argparse.ArgumentParser(
+        description="Compare dvmbench results against a baseline."
+    )
+    parser.add_argument(
+        "report", help="dvmbench XML report (dvmbench -r xml -o <file>)", type=Path
+    )
+    parser.add_argument(
+        "-b", "--baseline", help="JSON baseline to compare against", type=Path
+    )
+    parser.add_argument(
+        "-s", "--save", help="save the results as a JSON baseline", type=Path
+    )
+    parser.add_argument(
+        "-t",
+        "--threshold",
+        help="slowdown, in percent, reported as a regression (default: 5)",
+        type=float,
+        default=5.0,
+    )
+    return parser.parse_args()
+
+
+def read_report(path: Path) -> Dict[str, Dict[str, float]]:
+    """
+    read the benchmark results from a Catch2 XML report
+
+    :param path: path to the XML report
+    :return: results keyed by "<test case>/<benchmark>"
+    """
+    results = {}
+    root = ET.parse(path).getroot()
+    for test_case in root.iter("TestCase"):
+        for benchmark in test_case.iter("BenchmarkResults"):
+            mean = benchmark.find("mean")
+            if mean is None:
+                continue
+
+            # all Catch2 benchmark values are in nanoseconds
+            mean_ns = float(mean.get("value"))
+            name = "{}/{}".format(test_case.get("name"), benchmark.get("name"))
+            results[name] = {
+                "mean_ns": mean_ns,
+                "lower_ns": float(mean.get("lowerBound", mean_ns)),
+                "upper_ns": float(mean.get("upperBound", mean_ns)),
+                "ops": 1e9 / mean_ns if mean_ns > 0 else 0.0,
+            }
+
+    return results
+
+
+def main() -> int:
+    """
+    command line entry point
+
+    :return: exit status (1 if any benchmark regressed)
+    """
+    args = parse_arguments()
+
+    results = read_report(args.report)
+    if not results:
+        print("Error: no benchmark results in {}".format(args.report), file=sys.stderr)
+        return 2
+
+    if args.save is not None:
+        baseline = {
+            "machine": platform.machine(),
+            "system": platform.system(),
+            "processor": platform.processor(),
+            "benchmarks": results,
+        }
+        args.save.write_text(json.dumps(baseline, indent=2, sort_keys=True) + "\n")
+        print("Saved {} results to {}".format(len(results), args.save))
+
+    if args.baseline is None:
+        width = max(len(name) for name in results)
+        for name, result in sorted(results.items()):
+            print("{:<{}}  {:>14.0f} ops/s".format(name, width, result["ops"]))
+        return 0
+
+    baseline = json.loads(args.baseline.read_text())
+    if baseline.get("machine") != platform.machine():
+        print(
+            "Warning: baseline is from {}, this machine is {}".format(
+                baseline.get("machine"), platform.machine()
+            ),
+            file=sys.stderr,
+        )
+
+    regressions = 0
+    reference = baseline.get("benchmarks", {})
+    width = max(len(name) for name in set(results) | set(reference))
+    print(
+        "{:<{}}  {:>14}  {:>14}  {:>8}".format(
+            "benchmark", width, "baseline ops/s", "current ops/s", "change"
+        )
+    )
+    for name in sorted(set(results) | set(reference)):
+        if name not in reference:
+            print("{:<{}}  {:>14}  {:>14.0f}  {:>8}".format(name, width, "-", results[name]["ops"], "new"))
+            continue
+        if name not in results:
+            print("{:<{}}  {:>14.0f}  {:>14}  {:>8}".format(name, width, reference[name]["ops"], "-", "missing"))
+            continue
+
+        before = reference[name]["ops"]
+        after = results[name]["ops"]
+        change = ((after - before) / before) * 100.0 if before > 0 else 0.0
+
+        # a slowdown only counts when it is outside the confidence interval of this run
+        flag = ""
+        if change < -args.threshold and results[name]["lower_ns"] > reference[name]["mean_ns"]:
+            flag = "  REGRESSION"
+            regressions += 1
+
+        print(
+            "{:<{}}  {:>14.0f}  {:>14.0f}  {:>+7.1f}%{}".format(
+                name, width, before, after, change, flag
+            )
+        )
+
+    if regressions > 0:
+        print("{} benchmark(s) regressed by more than {}%".format(regressions, args.threshold))
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())